@@ -5,6 +5,7 @@
 #include <nanobind/stl/unique_ptr.h>
 #include <nanobind/stl/optional.h>
 #include <nanobind/stl/tuple.h>
+#include <nanobind/make_iterator.h>
 #include <nanobind/trampoline.h>          // <-- needed for NB_TRAMPOLINE/NB_OVERRIDE*
 
 #include "debugger.h"
@@ -18,6 +19,8 @@ public:
 
     // Expose protected base methods as public so binding lambdas can call them.
     using RoboDBG::Debugger::setBreakpoint;
+    using RoboDBG::Debugger::setBreakpoints;
+    using RoboDBG::Debugger::removeBreakpoints;
     using RoboDBG::Debugger::setHardwareBreakpoint;
     using RoboDBG::Debugger::setHardwareBreakpointOnThread;
     using RoboDBG::Debugger::getHardwareBreakpoints;
@@ -27,17 +30,52 @@ public:
     using RoboDBG::Debugger::clearHardwareBreakpointOnThread;
     using RoboDBG::Debugger::getBreakpointByReg;
     using RoboDBG::Debugger::getMemoryPages;
+    using RoboDBG::Debugger::getAddressSpace;
+    using RoboDBG::Debugger::refreshAddressSpace;
+    using RoboDBG::Debugger::getModuleByAddress;
     using RoboDBG::Debugger::changeMemoryProtection;
     using RoboDBG::Debugger::searchInMemory;
+    using RoboDBG::Debugger::searchInMemoryMulti;
+    using RoboDBG::Debugger::extractStrings;
+    using RoboDBG::Debugger::createValueScanner;
+    using RoboDBG::Debugger::pointerScan;
+    using RoboDBG::Debugger::resolvePointerChains;
+    using RoboDBG::Debugger::setPointerResolverOptions;
+    using RoboDBG::Debugger::getPointerResolverStats;
+    using RoboDBG::Debugger::invalidatePointerCache;
+    using RoboDBG::Debugger::dumpMemory;
+    using RoboDBG::Debugger::setReaderOptions;
+    using RoboDBG::Debugger::setMemoryCache;
+    using RoboDBG::Debugger::isMemoryCacheEnabled;
+    using RoboDBG::Debugger::getMemoryCacheStats;
+    using RoboDBG::Debugger::invalidateMemoryCache;
     using RoboDBG::Debugger::writeMemory;
     using RoboDBG::Debugger::readMemory;
+    using RoboDBG::Debugger::readMany;
+    using RoboDBG::Debugger::readCString;
+    using RoboDBG::Debugger::readWString;
     using RoboDBG::Debugger::ASLR;
+    using RoboDBG::Debugger::setEventMask;
+    using RoboDBG::Debugger::getEventMask;
+    using RoboDBG::Debugger::setExceptionSubscribed;
+    using RoboDBG::Debugger::isExceptionSubscribed;
+    using RoboDBG::Debugger::setAsyncEvents;
+    using RoboDBG::Debugger::getAsyncEvents;
+    using RoboDBG::Debugger::getEventPumpStats;
+    using RoboDBG::Debugger::setMetrics;
+    using RoboDBG::Debugger::getMetricsEnabled;
+    using RoboDBG::Debugger::getMetrics;
+    using RoboDBG::Debugger::resetMetrics;
+    using RoboDBG::Debugger::setTracing;
+    using RoboDBG::Debugger::getTracingEnabled;
+    using RoboDBG::Debugger::writeTrace;
+    using RoboDBG::Debugger::getTraceDropped;
     using RoboDBG::Debugger::hideDebugger;
     using RoboDBG::Debugger::printIP;
     using RoboDBG::Debugger::actualizeThreadList;
 
-    // Mark this as a trampoline for 14 Python-overridable virtuals
-    NB_TRAMPOLINE(RoboDBG::Debugger, 14);
+    // Mark this as a trampoline for 21 Python-overridable virtuals
+    NB_TRAMPOLINE(RoboDBG::Debugger, 21);
 
     // === Virtual Callbacks (C++ -> Python) ===
     void onStart(uintptr_t imageBase, uintptr_t entryPoint) override {
@@ -101,11 +139,57 @@ public:
         NB_OVERRIDE_NAME("on_unknown_debug_event", onUnknownDebugEvent, code);
     }
 
+    void onMetrics(const RoboDBG::MetricsSnapshot_t& snapshot) override {
+        NB_OVERRIDE_NAME("on_metrics", onMetrics, snapshot);
+    }
+
+    // === Event objects ===
+    // A Python on_*_event override gets the EventInfo; otherwise the payloads are only read when the
+    // matching plain callback is overridden in Python, so an unhandled event costs no target reads.
+    bool py_overrides(const char* name) {
+        nanobind::detail::ticket nb_ticket(nb_trampoline, name, false);
+        return nb_ticket.key.is_valid();
+    }
+
+    // The ticket holds the GIL: the call and everything done with its result stay in its scope, and
+    // only a C++ value leaves it (loop() runs without the GIL). nullopt when not overridden.
+    std::optional<bool> py_event_override(const char* name, RoboDBG::EventInfo& event, bool convert = false) {
+        nanobind::detail::ticket nb_ticket(nb_trampoline, name, false);
+        if (!nb_ticket.key.is_valid()) return std::nullopt;
+        nb::object result = nb_trampoline.base().attr(nb_ticket.key)(nb::cast(&event, nb::rv_policy::reference));
+        return !convert || result.is_none() || nb::cast<bool>(result);
+    }
+
+    void onStartEvent(RoboDBG::EventInfo& event) override {
+        if (py_event_override("on_start_event", event)) return;
+        if (py_overrides("on_start")) RoboDBG::Debugger::onStartEvent(event);
+    }
+
+    bool onDLLLoadEvent(RoboDBG::EventInfo& event) override {
+        if (std::optional<bool> result = py_event_override("on_dll_load_event", event, true)) return *result;
+        return py_overrides("on_dll_load") ? RoboDBG::Debugger::onDLLLoadEvent(event) : true;
+    }
+
+    void onDLLUnloadEvent(RoboDBG::EventInfo& event) override {
+        if (py_event_override("on_dll_unload_event", event)) return;
+        if (py_overrides("on_dll_unload")) RoboDBG::Debugger::onDLLUnloadEvent(event);
+    }
+
+    void onDebugStringEvent(RoboDBG::EventInfo& event) override {
+        if (py_event_override("on_debug_string_event", event)) return;
+        if (py_overrides("on_debug_string")) RoboDBG::Debugger::onDebugStringEvent(event);
+    }
+
+    void onExceptionEvent(RoboDBG::EventInfo& event) override {
+        if (py_event_override("on_exception_event", event)) return;
+        RoboDBG::Debugger::onExceptionEvent(event); // no reads; the default handlers print
+    }
+
     // --- read-only views for Python (need access to protected members) ---
     nb::dict py_get_breakpoints() const {
         nb::dict d;
-        for (const auto& [addr, byte] : breakpoints) {
-            d[nb::int_(reinterpret_cast<uintptr_t>(addr))] = nb::int_(static_cast<unsigned int>(byte));
+        for (uintptr_t addr : breakpoints.addresses()) {
+            d[nb::int_(addr)] = nb::int_(static_cast<unsigned int>(breakpoints.find(addr)->original));
         }
         return d;
     }
@@ -126,14 +210,6 @@ public:
         return out;
     }
 
-    nb::list py_get_threads() const {
-        nb::list out;
-        for (const auto& t : threads) {
-            out.append(t);
-        }
-        return out;
-    }
-
     int py_get_debugged_pid() const { return debuggedPid; }
 
     uintptr_t py_get_process_handle() {
@@ -144,7 +220,7 @@ public:
         return this->getPageByAddress(reinterpret_cast<LPVOID>(address));
     }
 
-    #ifdef _WIN64
+    #ifdef ROBODBG_X64
     bool py_get_flag(HANDLE hThread, RoboDBG::Flags64 flag) { return this->getFlag(hThread, flag); }
     void py_set_flag(HANDLE hThread, RoboDBG::Flags64 flag, bool enabled) { this->setFlag(hThread, flag, enabled); }
     int64_t py_get_register(HANDLE hThread, RoboDBG::Register64 reg) { return this->getRegister(hThread, reg); }
@@ -182,7 +258,7 @@ NB_MODULE(dbg, m) {
     .value("DWORD", RoboDBG::BreakpointLength::DWORD)
     .value("QWORD", RoboDBG::BreakpointLength::QWORD);
 
-    #ifdef _WIN64
+    #ifdef ROBODBG_X64
     nb::enum_<RoboDBG::Flags64>(m, "Flags64")
     .value("CF", RoboDBG::Flags64::CF).value("PF", RoboDBG::Flags64::PF)
     .value("AF", RoboDBG::Flags64::AF).value("ZF", RoboDBG::Flags64::ZF)
@@ -216,12 +292,89 @@ NB_MODULE(dbg, m) {
     .value("EIP", RoboDBG::Register32::EIP);
     #endif
 
+    // Bits combine with |; set_event_mask takes the resulting int
+    nb::enum_<RoboDBG::EventMask>(m, "EventMask", nb::is_arithmetic())
+    .value("START", RoboDBG::EVENT_START)
+    .value("END", RoboDBG::EVENT_END)
+    .value("THREAD_CREATE", RoboDBG::EVENT_THREAD_CREATE)
+    .value("THREAD_EXIT", RoboDBG::EVENT_THREAD_EXIT)
+    .value("DLL_LOAD", RoboDBG::EVENT_DLL_LOAD)
+    .value("DLL_UNLOAD", RoboDBG::EVENT_DLL_UNLOAD)
+    .value("EXCEPTION", RoboDBG::EVENT_EXCEPTION)
+    .value("DEBUG_STRING", RoboDBG::EVENT_DEBUG_STRING)
+    .value("RIP_ERROR", RoboDBG::EVENT_RIP_ERROR)
+    .value("UNKNOWN", RoboDBG::EVENT_UNKNOWN)
+    .value("MODULES", RoboDBG::EVENT_MODULES)
+    .value("NONE", RoboDBG::EVENT_NONE)
+    .value("ALL", RoboDBG::EVENT_ALL)
+    .value("INFORMATIONAL", RoboDBG::EVENT_INFORMATIONAL);
+
+    nb::enum_<RoboDBG::OverflowPolicy>(m, "OverflowPolicy")
+    .value("BLOCK", RoboDBG::OverflowPolicy::BLOCK)
+    .value("DROP", RoboDBG::OverflowPolicy::DROP);
+
+    nb::enum_<RoboDBG::TraceFormat>(m, "TraceFormat")
+    .value("CHROME_JSON", RoboDBG::TraceFormat::CHROME_JSON)
+    .value("PERFETTO", RoboDBG::TraceFormat::PERFETTO);
+
     // === PODs / structs ===
-    nb::class_<RoboDBG::thread_t>(m, "ThreadInfo")
-    .def_rw("h_thread", &RoboDBG::thread_t::hThread)
-    .def_rw("thread_id", &RoboDBG::thread_t::threadId)
-    .def_rw("thread_base", &RoboDBG::thread_t::threadBase)
-    .def_rw("start_address", &RoboDBG::thread_t::startAddress);
+    nb::class_<RoboDBG::PeHeaders_t>(m, "PeHeaders")
+    .def_ro("machine", &RoboDBG::PeHeaders_t::machine)
+    .def_ro("sections", &RoboDBG::PeHeaders_t::sections)
+    .def_ro("time_date_stamp", &RoboDBG::PeHeaders_t::timeDateStamp)
+    .def_ro("characteristics", &RoboDBG::PeHeaders_t::characteristics)
+    .def_ro("magic", &RoboDBG::PeHeaders_t::magic)
+    .def_ro("entry_point", &RoboDBG::PeHeaders_t::entryPoint)
+    .def_ro("image_base", &RoboDBG::PeHeaders_t::imageBase)
+    .def_ro("size_of_image", &RoboDBG::PeHeaders_t::sizeOfImage)
+    .def_ro("size_of_headers", &RoboDBG::PeHeaders_t::sizeOfHeaders)
+    .def_ro("subsystem", &RoboDBG::PeHeaders_t::subsystem)
+    .def_ro("dll_characteristics", &RoboDBG::PeHeaders_t::dllCharacteristics)
+    .def("is64", &RoboDBG::PeHeaders_t::is64);
+
+    nb::class_<RoboDBG::ExceptionRecord_t>(m, "ExceptionRecord")
+    .def_ro("code", &RoboDBG::ExceptionRecord_t::code)
+    .def_ro("address", &RoboDBG::ExceptionRecord_t::address)
+    .def_prop_ro("info", [](const RoboDBG::ExceptionRecord_t& r) { return nb::make_tuple(r.info[0], r.info[1]); })
+    .def_ro("first_chance", &RoboDBG::ExceptionRecord_t::firstChance);
+
+    // Handed to the on_*_event callbacks; only valid during the callback. Payloads are read on first access.
+    nb::class_<RoboDBG::EventInfo>(m, "EventInfo")
+    .def_prop_ro("process_id", &RoboDBG::EventInfo::processId)
+    .def_prop_ro("thread_id", &RoboDBG::EventInfo::threadId)
+    .def_prop_ro("image_base", &RoboDBG::EventInfo::imageBase)
+    .def_prop_ro("module_name", &RoboDBG::EventInfo::moduleName)
+    .def_prop_ro("pe_headers", &RoboDBG::EventInfo::peHeaders, nb::rv_policy::copy)
+    .def_prop_ro("entry_point", &RoboDBG::EventInfo::entryPoint)
+    .def_prop_ro("debug_string", &RoboDBG::EventInfo::debugString)
+    .def_prop_ro("exception", &RoboDBG::EventInfo::exception);
+
+    nb::enum_<RoboDBG::ThreadStatus>(m, "ThreadStatus")
+    .value("RUNNING", RoboDBG::ThreadStatus::RUNNING)
+    .value("STOPPED", RoboDBG::ThreadStatus::STOPPED);
+
+    nb::class_<RoboDBG::ThreadInfo_t>(m, "ThreadInfo")
+    .def_ro("h_thread", &RoboDBG::ThreadInfo_t::hThread)
+    .def_ro("thread_id", &RoboDBG::ThreadInfo_t::threadId)
+    .def_ro("thread_base", &RoboDBG::ThreadInfo_t::threadBase)
+    .def_ro("start_address", &RoboDBG::ThreadInfo_t::startAddress)
+    .def_ro("status", &RoboDBG::ThreadInfo_t::status);
+
+    // Live view of Debugger.threads; entries are only valid until the debugger continues
+    nb::class_<RoboDBG::ThreadRegistry>(m, "ThreadRegistry")
+    .def("__len__", &RoboDBG::ThreadRegistry::size)
+    .def("__contains__", &RoboDBG::ThreadRegistry::contains, "thread_id"_a)
+    .def("__getitem__",
+         [](const RoboDBG::ThreadRegistry& self, DWORD threadId) -> const RoboDBG::ThreadInfo_t& {
+             const RoboDBG::ThreadInfo_t* thread = self.find(threadId);
+             if (!thread) throw nb::key_error();
+             return *thread;
+         }, "thread_id"_a, nb::rv_policy::reference_internal)
+    .def("__iter__",
+         [](const RoboDBG::ThreadRegistry& self) {
+             return nb::make_iterator(nb::type<RoboDBG::ThreadRegistry>(), "ThreadIterator", self.begin(), self.end());
+         }, nb::keep_alive<0, 1>())
+    .def("ids", &RoboDBG::ThreadRegistry::threadIds);
 
     nb::class_<RoboDBG::hwBp_t>(m, "HardwareBreakpoint")
     .def_rw("h_thread", &RoboDBG::hwBp_t::hThread)
@@ -237,12 +390,180 @@ NB_MODULE(dbg, m) {
     .def_rw("protect", &RoboDBG::MemoryRegion_t::Protect)
     .def_rw("type", &RoboDBG::MemoryRegion_t::Type);
 
+    nb::class_<RoboDBG::EventPumpStats_t>(m, "EventPumpStats")
+    .def_ro("queued", &RoboDBG::EventPumpStats_t::queued)
+    .def_ro("delivered", &RoboDBG::EventPumpStats_t::delivered)
+    .def_ro("dropped", &RoboDBG::EventPumpStats_t::dropped)
+    .def_ro("blocked", &RoboDBG::EventPumpStats_t::blocked)
+    .def_ro("max_depth", &RoboDBG::EventPumpStats_t::maxDepth);
+
+    nb::class_<RoboDBG::LatencySummary_t>(m, "LatencySummary")
+    .def_ro("count", &RoboDBG::LatencySummary_t::count)
+    .def_ro("total_ns", &RoboDBG::LatencySummary_t::totalNs)
+    .def_ro("min_ns", &RoboDBG::LatencySummary_t::minNs)
+    .def_ro("max_ns", &RoboDBG::LatencySummary_t::maxNs)
+    .def_ro("p50_ns", &RoboDBG::LatencySummary_t::p50Ns)
+    .def_ro("p90_ns", &RoboDBG::LatencySummary_t::p90Ns)
+    .def_ro("p99_ns", &RoboDBG::LatencySummary_t::p99Ns)
+    .def_ro("p999_ns", &RoboDBG::LatencySummary_t::p999Ns)
+    .def_prop_ro("mean_ns", &RoboDBG::LatencySummary_t::meanNs);
+
+    // Keyed by name ("load_dll", "onBreakpoint", "read_memory"); rows without a count are left out
+    nb::class_<RoboDBG::MetricsSnapshot_t>(m, "Metrics")
+    .def_ro("seconds", &RoboDBG::MetricsSnapshot_t::seconds)
+    .def_prop_ro("events", [](const RoboDBG::MetricsSnapshot_t& self) {
+        nb::dict d;
+        for (size_t i = 0; i < RoboDBG::EVENT_TYPE_COUNT; ++i) {
+            if (self.stopped[i].count) d[RoboDBG::eventTypeName(static_cast<RoboDBG::DebugEventType>(i))] = self.stopped[i].count;
+        }
+        return d;
+    })
+    .def_prop_ro("stopped", [](const RoboDBG::MetricsSnapshot_t& self) {
+        nb::dict d;
+        for (size_t i = 0; i < RoboDBG::EVENT_TYPE_COUNT; ++i) {
+            if (self.stopped[i].count) d[RoboDBG::eventTypeName(static_cast<RoboDBG::DebugEventType>(i))] = self.stopped[i];
+        }
+        return d;
+    })
+    .def_prop_ro("callbacks", [](const RoboDBG::MetricsSnapshot_t& self) {
+        nb::dict d;
+        for (size_t i = 0; i < RoboDBG::METRIC_CALLBACK_COUNT; ++i) {
+            if (self.callbacks[i].count) d[RoboDBG::metricCallbackName(static_cast<RoboDBG::MetricCallback>(i))] = self.callbacks[i];
+        }
+        return d;
+    })
+    .def_prop_ro("remote_calls", [](const RoboDBG::MetricsSnapshot_t& self) {
+        nb::dict d;
+        for (size_t i = 0; i < RoboDBG::REMOTE_CALL_COUNT; ++i) {
+            if (self.remote.calls[i]) d[RoboDBG::remoteCallName(static_cast<RoboDBG::RemoteCall>(i))] = self.remote.calls[i];
+        }
+        return d;
+    })
+    .def_prop_ro("remote_bytes", [](const RoboDBG::MetricsSnapshot_t& self) {
+        nb::dict d;
+        for (size_t i = 0; i < RoboDBG::REMOTE_CALL_COUNT; ++i) {
+            if (self.remote.bytes[i]) d[RoboDBG::remoteCallName(static_cast<RoboDBG::RemoteCall>(i))] = self.remote.bytes[i];
+        }
+        return d;
+    })
+    .def("__str__", &RoboDBG::formatMetrics);
+
+    nb::class_<RoboDBG::PageCacheStats_t>(m, "MemoryCacheStats")
+    .def_ro("hits", &RoboDBG::PageCacheStats_t::hits)
+    .def_ro("misses", &RoboDBG::PageCacheStats_t::misses)
+    .def_ro("uncached", &RoboDBG::PageCacheStats_t::uncached)
+    .def_ro("writes", &RoboDBG::PageCacheStats_t::writes)
+    .def_ro("flushes", &RoboDBG::PageCacheStats_t::flushes);
+
+    nb::class_<RoboDBG::PointerScanner>(m, "PointerScanner")
+    .def("scan",
+         [](RoboDBG::PointerScanner &self, uintptr_t address, const std::vector<RoboDBG::Module_t>& modules) {
+             return self.scan(address, modules);
+         }, "address"_a, "modules"_a)
+    .def("results",
+         [](const RoboDBG::PointerScanner &self, size_t first, size_t count) {
+             // (module name, [module offset, offset per level]) per path
+             nb::list out;
+             const auto& results = self.results();
+             for (size_t i = first; i < results.size() && i - first < count; ++i) {
+                 out.append(nb::make_tuple(self.modules()[results[i].module].name, results[i].offsets));
+             }
+             return out;
+         }, "first"_a = 0, "count"_a = SIZE_MAX)
+    .def("path",
+         [](const RoboDBG::PointerScanner &self, size_t index, const std::vector<RoboDBG::Module_t>& modules) {
+             const RoboDBG::PointerPath_t path = self.path(index, 0, modules);
+             return nb::make_tuple(path.base, path.offsets);
+         }, "index"_a, "modules"_a = std::vector<RoboDBG::Module_t>{})
+    .def("save", &RoboDBG::PointerScanner::save, "path"_a)
+    .def("load", &RoboDBG::PointerScanner::load, "path"_a)
+    .def("clear_map", &RoboDBG::PointerScanner::clearMap)
+    .def("map_size", &RoboDBG::PointerScanner::mapSize)
+    .def("memory_usage", &RoboDBG::PointerScanner::memoryUsage)
+    .def("__len__", [](const RoboDBG::PointerScanner &self) { return self.results().size(); });
+
+    nb::class_<RoboDBG::PointerResolverStats_t>(m, "PointerResolverStats")
+    .def_ro("passes", &RoboDBG::PointerResolverStats_t::passes)
+    .def_ro("reads", &RoboDBG::PointerResolverStats_t::reads)
+    .def_ro("ranges", &RoboDBG::PointerResolverStats_t::ranges)
+    .def_ro("cache_hits", &RoboDBG::PointerResolverStats_t::cacheHits);
+
+    nb::class_<RoboDBG::Module_t>(m, "Module")
+    .def_ro("base", &RoboDBG::Module_t::base)
+    .def_ro("size", &RoboDBG::Module_t::size)
+    .def_ro("name", &RoboDBG::Module_t::name);
+
+    nb::class_<RoboDBG::SignatureSet>(m, "SignatureSet")
+    .def(nb::init<>())
+    .def("add",
+         [](RoboDBG::SignatureSet &self, const std::string& signature, const std::string& name) {
+             return self.add(std::string_view(signature), name);
+         }, "signature"_a, "name"_a = "")
+    .def("compile", &RoboDBG::SignatureSet::compile)
+    .def("save", &RoboDBG::SignatureSet::save, "path"_a)
+    .def("load", &RoboDBG::SignatureSet::load, "path"_a)
+    .def("name", &RoboDBG::SignatureSet::name, "id"_a)
+    .def_prop_ro("compiled", &RoboDBG::SignatureSet::compiled)
+    .def("__len__", &RoboDBG::SignatureSet::size);
+
+    nb::enum_<RoboDBG::ValueType>(m, "ValueType")
+    .value("INT8", RoboDBG::ValueType::INT8)
+    .value("INT16", RoboDBG::ValueType::INT16)
+    .value("INT32", RoboDBG::ValueType::INT32)
+    .value("INT64", RoboDBG::ValueType::INT64)
+    .value("FLOAT", RoboDBG::ValueType::FLOAT)
+    .value("DOUBLE", RoboDBG::ValueType::DOUBLE);
+
+    nb::enum_<RoboDBG::StringEncoding>(m, "StringEncoding")
+    .value("ASCII", RoboDBG::StringEncoding::ASCII)
+    .value("UTF16", RoboDBG::StringEncoding::UTF16);
+
+    nb::enum_<RoboDBG::ScanCompare>(m, "ScanCompare")
+    .value("EXACT", RoboDBG::ScanCompare::EXACT)
+    .value("RANGE", RoboDBG::ScanCompare::RANGE)
+    .value("UNKNOWN", RoboDBG::ScanCompare::UNKNOWN)
+    .value("CHANGED", RoboDBG::ScanCompare::CHANGED)
+    .value("UNCHANGED", RoboDBG::ScanCompare::UNCHANGED)
+    .value("INCREASED", RoboDBG::ScanCompare::INCREASED)
+    .value("DECREASED", RoboDBG::ScanCompare::DECREASED);
+
+    // Python ints and floats both work as scan values; results come back as int or float by value type
+    auto toScanValue = [](nb::handle v) {
+        return nb::isinstance<nb::float_>(v) ? RoboDBG::ScanValue_t::of(nb::cast<double>(v))
+                                             : RoboDBG::ScanValue_t::of(nb::cast<int64_t>(v));
+    };
+
+    nb::class_<RoboDBG::ValueScanner>(m, "ValueScanner")
+    .def("first_scan",
+         [toScanValue](RoboDBG::ValueScanner &self, RoboDBG::ScanCompare compare, nb::handle value, nb::handle high) {
+             return self.firstScan(compare, toScanValue(value), toScanValue(high));
+         }, "compare"_a, "value"_a = 0, "high"_a = 0)
+    .def("next_scan",
+         [toScanValue](RoboDBG::ValueScanner &self, RoboDBG::ScanCompare compare, nb::handle value, nb::handle high) {
+             return self.nextScan(compare, toScanValue(value), toScanValue(high));
+         }, "compare"_a, "value"_a = 0, "high"_a = 0)
+    .def("results",
+         [](const RoboDBG::ValueScanner &self, size_t first, size_t count) {
+             const bool real = self.type() == RoboDBG::ValueType::FLOAT || self.type() == RoboDBG::ValueType::DOUBLE;
+             nb::list out;
+             for (const RoboDBG::ValueHit_t& hit : self.results(first, count)) {
+                 out.append(nb::make_tuple(hit.address, real ? nb::object(nb::float_(hit.value.real)) : nb::object(nb::int_(hit.value.integer))));
+             }
+             return out;
+         }, "first"_a = 0, "count"_a = 1000)
+    .def("reset", &RoboDBG::ValueScanner::reset)
+    .def("memory_usage", &RoboDBG::ValueScanner::memoryUsage)
+    .def_prop_ro("type", &RoboDBG::ValueScanner::type)
+    .def_prop_ro("alignment", &RoboDBG::ValueScanner::alignment)
+    .def("__len__", &RoboDBG::ValueScanner::count);
+
     // === Main class (note trampoline as 2nd template arg) ===
     nb::class_<RoboDBG::Debugger, PyDebugger>(m, "Debugger")
     .def(nb::init<>())
     .def(nb::init<bool>(), "verbose"_a=false)
 
-    .def("loop", &RoboDBG::Debugger::loop, "Starts the debugging loop")
+    // Callbacks take the GIL themselves, so the event pump's thread can run Python while the loop waits
+    .def("loop", &RoboDBG::Debugger::loop, nb::call_guard<nb::gil_scoped_release>(), "Starts the debugging loop")
     .def("start",
          nb::overload_cast<std::string>(&RoboDBG::Debugger::start),
          "exe_name"_a)
@@ -267,6 +588,16 @@ NB_MODULE(dbg, m) {
              static_cast<PyDebugger&>(self).setBreakpoint(reinterpret_cast<LPVOID>(address));
          }, "address"_a)
 
+    .def("set_breakpoints",
+         [](RoboDBG::Debugger &self, const std::vector<uintptr_t>& addresses) {
+             return static_cast<PyDebugger&>(self).setBreakpoints(addresses);
+         }, "addresses"_a, "Sets many breakpoints with one read/write per page; returns the number set")
+
+    .def("remove_breakpoints",
+         [](RoboDBG::Debugger &self, const std::vector<uintptr_t>& addresses) {
+             return static_cast<PyDebugger&>(self).removeBreakpoints(addresses);
+         }, "addresses"_a, "Removes breakpoints and restores the original bytes; returns the number removed")
+
     .def("set_hardware_breakpoint",
          [](RoboDBG::Debugger &self, const RoboDBG::hwBp_t& bp) {
              return static_cast<PyDebugger&>(self).setHardwareBreakpoint(bp);
@@ -323,15 +654,108 @@ NB_MODULE(dbg, m) {
          },
          "address"_a)
 
+    .def("get_module_by_address",
+         [](RoboDBG::Debugger &self, uintptr_t address) -> std::optional<RoboDBG::Module_t> {
+             const RoboDBG::Module_t* module = static_cast<PyDebugger&>(self).getModuleByAddress(address);
+             if (!module) return std::nullopt;
+             return *module;
+         }, "address"_a)
+
+    .def("get_modules",
+         [](RoboDBG::Debugger &self) {
+             const auto modules = static_cast<PyDebugger&>(self).getAddressSpace().modules();
+             return std::vector<RoboDBG::Module_t>(modules.begin(), modules.end());
+         })
+
+    .def("refresh_address_space",
+         [](RoboDBG::Debugger &self) {
+             static_cast<PyDebugger&>(self).refreshAddressSpace();
+         })
+
     .def("change_memory_protection",
          [](RoboDBG::Debugger &self, RoboDBG::MemoryRegion_t page, DWORD newProtect) {
              return static_cast<PyDebugger&>(self).changeMemoryProtection(page, newProtect);
          }, "page"_a, "new_protect"_a)
 
     .def("search_in_memory",
-         [](RoboDBG::Debugger &self, const std::vector<uint8_t>& pattern) {
-             return static_cast<PyDebugger&>(self).searchInMemory(pattern);
-         }, "pattern"_a)
+         [](RoboDBG::Debugger &self, const std::string& signature, unsigned threads, size_t chunkSize, size_t maxHits) {
+             return static_cast<PyDebugger&>(self).searchInMemory(std::string_view(signature),
+                                                                  RoboDBG::ScanOptions_t{ threads, chunkSize, maxHits });
+         }, "signature"_a, "threads"_a = 1, "chunk_size"_a = 0, "max_hits"_a = 0)
+
+    .def("search_in_memory",
+         [](RoboDBG::Debugger &self, const std::vector<uint8_t>& pattern, unsigned threads, size_t chunkSize, size_t maxHits) {
+             return static_cast<PyDebugger&>(self).searchInMemory(pattern, RoboDBG::ScanOptions_t{ threads, chunkSize, maxHits });
+         }, "pattern"_a, "threads"_a = 1, "chunk_size"_a = 0, "max_hits"_a = 0)
+
+    .def("search_in_memory_multi",
+         [](RoboDBG::Debugger &self, const RoboDBG::SignatureSet& signatures, unsigned threads, size_t chunkSize, size_t maxHits) {
+             std::vector<std::tuple<uint32_t, uintptr_t>> out;
+             for (const auto& match : static_cast<PyDebugger&>(self).searchInMemoryMulti(signatures, RoboDBG::ScanOptions_t{ threads, chunkSize, maxHits }))
+                 out.emplace_back(match.id, match.address);
+             return out;
+         }, "signatures"_a, "threads"_a = 1, "chunk_size"_a = 0, "max_hits"_a = 0)
+
+    .def("extract_strings",
+         [](RoboDBG::Debugger &self, size_t minLength, size_t maxLength, bool ascii, bool utf16,
+            unsigned threads, size_t chunkSize, size_t maxHits) {
+             std::vector<std::tuple<uintptr_t, RoboDBG::StringEncoding, std::string>> out;
+             for (auto& hit : static_cast<PyDebugger&>(self).extractStrings(
+                      RoboDBG::StringScanOptions_t{ minLength, maxLength, ascii, utf16 },
+                      RoboDBG::ScanOptions_t{ threads, chunkSize, maxHits }))
+                 out.emplace_back(hit.address, hit.encoding, std::move(hit.text));
+             return out;
+         }, "min_length"_a = 4, "max_length"_a = 1024, "ascii"_a = true, "utf16"_a = true,
+            "threads"_a = 0, "chunk_size"_a = 0, "max_hits"_a = 0)
+
+    .def("for_each_string",
+         [](RoboDBG::Debugger &self, nb::callable fn, size_t minLength, size_t maxLength, bool ascii, bool utf16,
+            unsigned threads, size_t chunkSize, size_t maxHits) {
+             // fn(address, encoding, text) per string in address order; returning False stops the scan
+             return static_cast<PyDebugger&>(self).extractStrings(
+                 [&](const RoboDBG::StringHit_t& hit) {
+                     nb::object keepGoing = fn(hit.address, hit.encoding, hit.text);
+                     return keepGoing.is_none() || nb::cast<bool>(keepGoing);
+                 },
+                 RoboDBG::StringScanOptions_t{ minLength, maxLength, ascii, utf16 },
+                 RoboDBG::ScanOptions_t{ threads, chunkSize, maxHits });
+         }, "fn"_a, "min_length"_a = 4, "max_length"_a = 1024, "ascii"_a = true, "utf16"_a = true,
+            "threads"_a = 0, "chunk_size"_a = 0, "max_hits"_a = 0)
+
+    .def("create_value_scanner",
+         [](RoboDBG::Debugger &self, RoboDBG::ValueType type, size_t alignment) {
+             return static_cast<PyDebugger&>(self).createValueScanner(type, alignment);
+         }, "type"_a, "alignment"_a = 0, nb::keep_alive<0, 1>())
+
+    .def("dump_memory",
+         [](RoboDBG::Debugger &self, uintptr_t address, size_t size, const std::string& path) {
+             return static_cast<PyDebugger&>(self).dumpMemory(address, size, path);
+         }, "address"_a, "size"_a, "path"_a)
+
+    .def("set_reader_options",
+         [](RoboDBG::Debugger &self, size_t chunkSize, size_t memoryLimit, bool prefetch) {
+             static_cast<PyDebugger&>(self).setReaderOptions(RoboDBG::RegionReaderOptions_t{ chunkSize, memoryLimit, prefetch });
+         }, "chunk_size"_a = 1 << 20, "memory_limit"_a = 4 << 20, "prefetch"_a = true)
+
+    .def("set_memory_cache",
+         [](RoboDBG::Debugger &self, bool enabled, size_t maxPages) {
+             static_cast<PyDebugger&>(self).setMemoryCache(enabled, maxPages);
+         }, "enabled"_a = true, "max_pages"_a = RoboDBG::PageCache::DEFAULT_MAX_PAGES)
+
+    .def("is_memory_cache_enabled",
+         [](RoboDBG::Debugger &self) {
+             return static_cast<PyDebugger&>(self).isMemoryCacheEnabled();
+         })
+
+    .def("get_memory_cache_stats",
+         [](RoboDBG::Debugger &self) {
+             return static_cast<PyDebugger&>(self).getMemoryCacheStats();
+         })
+
+    .def("invalidate_memory_cache",
+         [](RoboDBG::Debugger &self) {
+             static_cast<PyDebugger&>(self).invalidateMemoryCache();
+         })
 
     .def("change_memory_protection_raw",
          [](RoboDBG::Debugger &self, uintptr_t address, size_t size, DWORD newProtect) {
@@ -351,6 +775,149 @@ NB_MODULE(dbg, m) {
              return buffer;
          }, "address"_a, "size"_a)
 
+    .def("read_many",
+         [](RoboDBG::Debugger &self, const std::vector<std::tuple<uintptr_t, nb::bytearray>>& requests, size_t maxGap) {
+             // Each bytearray is filled in place over its full length
+             std::vector<RoboDBG::ReadRequest_t> batch;
+             batch.reserve(requests.size());
+             for (const auto& [address, buffer] : requests) {
+                 nb::bytearray target = buffer;
+                 batch.push_back(RoboDBG::ReadRequest_t{ address, target.data(), target.size() });
+             }
+             static_cast<PyDebugger&>(self).readMany(batch, maxGap);
+             std::vector<bool> ok;
+             ok.reserve(batch.size());
+             for (const auto& r : batch) ok.push_back(r.ok);
+             return ok;
+         }, "requests"_a, "max_gap"_a = 0)
+
+    .def("read_cstring",
+         [](RoboDBG::Debugger &self, uintptr_t address, size_t maxLength) {
+             // Bytes map 1:1 to code points (Latin-1), so binary data never fails to decode
+             const std::string bytes = static_cast<PyDebugger&>(self).readCString(address, maxLength);
+             return nb::steal<nb::str>(PyUnicode_DecodeLatin1(bytes.data(), static_cast<Py_ssize_t>(bytes.size()), nullptr));
+         }, "address"_a, "max_length"_a = RoboDBG::DEFAULT_STRING_LENGTH)
+
+    .def("read_wstring",
+         [](RoboDBG::Debugger &self, uintptr_t address, size_t maxLength) {
+             return RoboDBG::toUtf8(static_cast<PyDebugger&>(self).readWString(address, maxLength));
+         }, "address"_a, "max_length"_a = RoboDBG::DEFAULT_STRING_LENGTH)
+
+    .def("pointer_scan",
+         [](RoboDBG::Debugger &self, uintptr_t address, size_t maxDepth, size_t maxOffset, size_t maxResults,
+            unsigned threads, size_t pointerSize) {
+             return static_cast<PyDebugger&>(self).pointerScan(address,
+                 RoboDBG::PointerScanOptions_t{ maxDepth, maxOffset, pointerSize, 0, maxResults, threads });
+         }, "address"_a, "max_depth"_a = 4, "max_offset"_a = 0x800, "max_results"_a = 0, "threads"_a = 0,
+            "pointer_size"_a = sizeof(uintptr_t))
+
+    .def("resolve_pointer_chains",
+         [](RoboDBG::Debugger &self, const std::vector<std::tuple<uintptr_t, std::vector<int64_t>>>& paths, uint8_t valueSize) {
+             // One entry per path: (address, value), or None if a level could not be read
+             std::vector<RoboDBG::PointerPath_t> batch;
+             batch.reserve(paths.size());
+             for (const auto& [base, offsets] : paths) batch.push_back(RoboDBG::PointerPath_t{ base, offsets, valueSize });
+             nb::list out;
+             for (const auto& r : static_cast<PyDebugger&>(self).resolvePointerChains(batch)) {
+                 if (r.ok()) out.append(nb::make_tuple(r.address, r.value));
+                 else out.append(nb::none());
+             }
+             return out;
+         }, "paths"_a, "value_size"_a = 0)
+
+    .def("set_pointer_resolver_options",
+         [](RoboDBG::Debugger &self, size_t stableLevels, unsigned revalidateEvery, size_t maxGap, size_t pointerSize) {
+             static_cast<PyDebugger&>(self).setPointerResolverOptions(
+                 RoboDBG::PointerResolverOptions_t{ pointerSize, stableLevels, revalidateEvery, maxGap });
+         }, "stable_levels"_a = 0, "revalidate_every"_a = 0, "max_gap"_a = 0, "pointer_size"_a = sizeof(uintptr_t))
+
+    .def("get_pointer_resolver_stats",
+         [](RoboDBG::Debugger &self) {
+             return static_cast<PyDebugger&>(self).getPointerResolverStats();
+         })
+
+    .def("invalidate_pointer_cache",
+         [](RoboDBG::Debugger &self) {
+             static_cast<PyDebugger&>(self).invalidatePointerCache();
+         })
+
+    .def("set_event_mask",
+         [](RoboDBG::Debugger &self, uint32_t mask) {
+             static_cast<PyDebugger&>(self).setEventMask(mask);
+         }, "mask"_a)
+
+    .def("get_event_mask",
+         [](RoboDBG::Debugger &self) {
+             return static_cast<PyDebugger&>(self).getEventMask();
+         })
+
+    .def("set_exception_subscribed",
+         [](RoboDBG::Debugger &self, DWORD code, bool subscribed) {
+             static_cast<PyDebugger&>(self).setExceptionSubscribed(code, subscribed);
+         }, "code"_a, "subscribed"_a = true)
+
+    .def("is_exception_subscribed",
+         [](RoboDBG::Debugger &self, DWORD code) {
+             return static_cast<PyDebugger&>(self).isExceptionSubscribed(code);
+         }, "code"_a)
+
+    // Callbacks of these events run on a worker thread while the target continues
+    .def("set_async_events",
+         [](RoboDBG::Debugger &self, uint32_t events, size_t capacity, RoboDBG::OverflowPolicy overflow) {
+             static_cast<PyDebugger&>(self).setAsyncEvents(events, RoboDBG::EventPumpOptions_t{ capacity, overflow });
+         }, "events"_a, "capacity"_a = 1024, "overflow"_a = RoboDBG::OverflowPolicy::BLOCK)
+
+    .def("get_async_events",
+         [](RoboDBG::Debugger &self) {
+             return static_cast<PyDebugger&>(self).getAsyncEvents();
+         })
+
+    .def("get_event_pump_stats",
+         [](RoboDBG::Debugger &self) {
+             return static_cast<PyDebugger&>(self).getEventPumpStats();
+         })
+
+    // Latency histograms and remote call counters; on_metrics is called every dump_interval_ms
+    .def("set_metrics",
+         [](RoboDBG::Debugger &self, bool enabled, DWORD dumpIntervalMs) {
+             static_cast<PyDebugger&>(self).setMetrics(enabled, dumpIntervalMs);
+         }, "enabled"_a, "dump_interval_ms"_a = 0)
+
+    .def("get_metrics_enabled",
+         [](RoboDBG::Debugger &self) {
+             return static_cast<PyDebugger&>(self).getMetricsEnabled();
+         })
+
+    .def("get_metrics",
+         [](RoboDBG::Debugger &self) {
+             return static_cast<PyDebugger&>(self).getMetrics();
+         })
+
+    .def("reset_metrics",
+         [](RoboDBG::Debugger &self) {
+             static_cast<PyDebugger&>(self).resetMetrics();
+         })
+
+    .def("set_tracing",
+         [](RoboDBG::Debugger &self, bool enabled, const std::string& path, RoboDBG::TraceFormat format, size_t maxEvents) {
+             static_cast<PyDebugger&>(self).setTracing(enabled, path, RoboDBG::TraceOptions_t{ format, maxEvents });
+         }, "enabled"_a, "path"_a = "", "format"_a = RoboDBG::TraceFormat::CHROME_JSON, "max_events"_a = size_t(1) << 18)
+
+    .def("get_tracing_enabled",
+         [](RoboDBG::Debugger &self) {
+             return static_cast<PyDebugger&>(self).getTracingEnabled();
+         })
+
+    .def("write_trace",
+         [](RoboDBG::Debugger &self, const std::string& path, RoboDBG::TraceFormat format) {
+             return static_cast<PyDebugger&>(self).writeTrace(path, format);
+         }, "path"_a, "format"_a = RoboDBG::TraceFormat::CHROME_JSON)
+
+    .def("get_trace_dropped",
+         [](RoboDBG::Debugger &self) {
+             return static_cast<PyDebugger&>(self).getTraceDropped();
+         })
+
     .def("aslr",
          [](RoboDBG::Debugger &self, uintptr_t address) {
              return static_cast<PyDebugger&>(self).ASLR(address);
@@ -381,9 +948,9 @@ NB_MODULE(dbg, m) {
     .def_prop_ro("dlls", [](RoboDBG::Debugger& self) {
         return static_cast<PyDebugger&>(self).py_get_ddls();
     })
-    .def_prop_ro("threads", [](RoboDBG::Debugger& self) {
-        return static_cast<PyDebugger&>(self).py_get_threads();
-    })
+    .def_prop_ro("threads", [](RoboDBG::Debugger& self) -> const RoboDBG::ThreadRegistry& {
+        return self.getThreads();
+    }, nb::rv_policy::reference_internal)
     .def_prop_ro("debugged_pid", [](RoboDBG::Debugger& self) {
         return static_cast<PyDebugger&>(self).py_get_debugged_pid();
     })
@@ -393,7 +960,7 @@ NB_MODULE(dbg, m) {
              static_cast<PyDebugger&>(self).actualizeThreadList();
          })
 
-    #ifdef _WIN64
+    #ifdef ROBODBG_X64
     .def("get_flag",
          [](RoboDBG::Debugger &self, HANDLE hThread, RoboDBG::Flags64 flag) {
              return static_cast<PyDebugger&>(self).py_get_flag(hThread, flag);
@@ -55,17 +55,6 @@ class CrackMeSolver(Debugger):
             self.set_flag(hThread, Flags64.ZF, True)
         return BreakpointAction.BREAK
 
-    def read_cstring(self, addr):
-        result_bytes = []
-        offset = 0
-        while True:
-            b = self.read_memory(addr + offset, 1)[0]  # read 1 byte
-            if b == 0:
-                break
-            result_bytes.append(b)
-            offset += 1
-        return "".join(chr(i) for i in result_bytes)
-
 
 if __name__ == "__main__":
     dbg = CrackMeSolver()
@@ -0,0 +1,144 @@
+#include "addressSpace.h"
+
+#include <algorithm>
+
+namespace RoboDBG {
+
+namespace {
+    inline uintptr_t baseOf(const MemoryRegion_t& r) { return reinterpret_cast<uintptr_t>(r.BaseAddress); }
+    inline uintptr_t endOf(const MemoryRegion_t& r) { return baseOf(r) + r.RegionSize; }
+
+    // Part of r inside [from, to)
+    MemoryRegion_t clip(const MemoryRegion_t& r, uintptr_t from, uintptr_t to) {
+        MemoryRegion_t out = r;
+        const uintptr_t begin = std::max(baseOf(r), from);
+        out.BaseAddress = reinterpret_cast<LPVOID>(begin);
+        out.RegionSize = std::min(endOf(r), to) - begin;
+        return out;
+    }
+}
+
+void AddressSpace::assign(std::vector<MemoryRegion_t> regions) {
+    std::sort(regions.begin(), regions.end(),
+              [](const MemoryRegion_t& a, const MemoryRegion_t& b) { return baseOf(a) < baseOf(b); });
+    regions.erase(std::remove_if(regions.begin(), regions.end(), [](const MemoryRegion_t& r) { return r.RegionSize == 0; }),
+                  regions.end());
+    regions_ = std::move(regions);
+    built_ = true;
+    ++generation_;
+}
+
+void AddressSpace::update(uintptr_t address, SIZE_T size, std::span<const MemoryRegion_t> regions) {
+    // The refreshed range grows to cover every fresh region
+    uintptr_t from = address, to = address + size;
+    for (const MemoryRegion_t& r : regions) {
+        if (!r.RegionSize) continue;
+        from = std::min(from, baseOf(r));
+        to = std::max(to, endOf(r));
+    }
+
+    // Old regions overlapping [from, to) give way, except for their parts outside it
+    auto first = std::upper_bound(regions_.begin(), regions_.end(), from,
+                                  [](uintptr_t a, const MemoryRegion_t& r) { return a < endOf(r); });
+    auto last = std::lower_bound(first, regions_.end(), to,
+                                 [](const MemoryRegion_t& r, uintptr_t a) { return baseOf(r) < a; });
+
+    std::vector<MemoryRegion_t> fresh;
+    for (const MemoryRegion_t& r : regions) {
+        if (r.RegionSize) fresh.push_back(r);
+    }
+    std::sort(fresh.begin(), fresh.end(),
+              [](const MemoryRegion_t& a, const MemoryRegion_t& b) { return baseOf(a) < baseOf(b); });
+
+    std::vector<MemoryRegion_t> merged;
+    merged.reserve(fresh.size() + 2);
+    if (first != last && baseOf(*first) < from) merged.push_back(clip(*first, 0, from));
+    merged.insert(merged.end(), fresh.begin(), fresh.end());
+    if (first != last && endOf(*(last - 1)) > to) merged.push_back(clip(*(last - 1), to, UINTPTR_MAX));
+
+    const auto at = regions_.erase(first, last);
+    regions_.insert(at, merged.begin(), merged.end());
+    ++generation_;
+}
+
+const MemoryRegion_t* AddressSpace::find(uintptr_t address) const {
+    auto it = std::upper_bound(regions_.begin(), regions_.end(), address,
+                               [](uintptr_t a, const MemoryRegion_t& r) { return a < baseOf(r); });
+    if (it == regions_.begin()) return nullptr;
+    --it;
+    return address < endOf(*it) ? &*it : nullptr;
+}
+
+std::span<const MemoryRegion_t> AddressSpace::overlapping(uintptr_t address, SIZE_T size) const {
+    auto first = std::upper_bound(regions_.begin(), regions_.end(), address,
+                                  [](uintptr_t a, const MemoryRegion_t& r) { return a < endOf(r); });
+    auto last = std::lower_bound(first, regions_.end(), address + size,
+                                 [](const MemoryRegion_t& r, uintptr_t a) { return baseOf(r) < a; });
+    return std::span<const MemoryRegion_t>(regions_.data() + (first - regions_.begin()), static_cast<size_t>(last - first));
+}
+
+bool AddressSpace::matches(const MemoryRegion_t& region, uint32_t filter) {
+    const DWORD protect = region.Protect & 0xFF;
+    const bool committed = region.State == MEM_COMMIT;
+    const bool readable = committed && !(region.Protect & PAGE_GUARD) && protect != PAGE_NOACCESS;
+    const bool writable = readable && (protect & (PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY));
+    const bool executable = protect & (PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY);
+
+    if ((filter & REGION_COMMITTED) && !committed) return false;
+    if ((filter & REGION_READABLE) && !readable) return false;
+    if ((filter & REGION_WRITABLE) && !writable) return false;
+    if ((filter & REGION_EXECUTABLE) && !executable) return false;
+    if ((filter & REGION_IMAGE) && region.Type != MEM_IMAGE) return false;
+    return true;
+}
+
+std::vector<MemoryRegion_t> AddressSpace::select(uint32_t filter) const {
+    std::vector<MemoryRegion_t> out;
+    for (const MemoryRegion_t& r : regions_) {
+        if (matches(r, filter)) out.push_back(r);
+    }
+    return out;
+}
+
+void AddressSpace::addModule(Module_t module) {
+    if (!module.size) return;
+    auto first = std::upper_bound(modules_.begin(), modules_.end(), module.base,
+                                  [](uintptr_t a, const Module_t& m) { return a < m.end(); });
+    auto last = std::lower_bound(first, modules_.end(), module.end(),
+                                 [](const Module_t& m, uintptr_t a) { return m.base < a; });
+    modules_.insert(modules_.erase(first, last), std::move(module));
+    ++generation_;
+}
+
+bool AddressSpace::removeModule(uintptr_t base) {
+    auto it = std::lower_bound(modules_.begin(), modules_.end(), base,
+                               [](const Module_t& m, uintptr_t a) { return m.base < a; });
+    if (it == modules_.end() || it->base != base) return false;
+    modules_.erase(it);
+    ++generation_;
+    return true;
+}
+
+const Module_t* AddressSpace::findModule(uintptr_t address) const {
+    auto it = std::upper_bound(modules_.begin(), modules_.end(), address,
+                               [](uintptr_t a, const Module_t& m) { return a < m.base; });
+    if (it == modules_.begin()) return nullptr;
+    --it;
+    return address < it->end() ? &*it : nullptr;
+}
+
+void AddressSpace::clear() {
+    regions_.clear();
+    modules_.clear();
+    built_ = false;
+    ++generation_;
+}
+
+void AddressSpace::invalidateRegions() {
+    if (!built_) return;
+    regions_.clear();
+    built_ = false;
+    ++generation_;
+}
+
+} // namespace RoboDBG
@@ -0,0 +1,146 @@
+/**
+ * @file addressSpace.h
+ * @brief Sorted index of the regions and modules of the target address space
+ * @author Milkshake
+ */
+
+#ifndef ADDRESSSPACE_H
+#define ADDRESSSPACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "platform.h"
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    /**
+     * @enum RegionFilter
+     * @brief Properties a region must have to be selected; combine with |.
+     */
+    enum RegionFilter : uint32_t {
+        REGION_ANY        = 0,      ///< Every region, free and reserved ones included.
+        REGION_COMMITTED  = 1 << 0, ///< MEM_COMMIT.
+        REGION_READABLE   = 1 << 1, ///< Committed, neither PAGE_NOACCESS nor PAGE_GUARD.
+        REGION_WRITABLE   = 1 << 2, ///< Readable and writable (or copy-on-write).
+        REGION_EXECUTABLE = 1 << 3, ///< Any PAGE_EXECUTE* protection.
+        REGION_IMAGE      = 1 << 4  ///< MEM_IMAGE (mapped from an executable file).
+    };
+
+    /**
+     * @struct Module_t
+     * @brief A module (EXE / DLL image) loaded in the target.
+     */
+    struct Module_t {
+        uintptr_t base = 0; ///< Image base.
+        SIZE_T size = 0;    ///< Bytes from the image base.
+        std::string name;   ///< Module name or path as reported by the backend.
+
+        inline uintptr_t end() const { return base + size; }
+    };
+
+    /**
+     * @class AddressSpace
+     * @brief Regions and modules kept sorted by address, so lookups are a binary search.
+     *
+     * The index does not talk to the target: the owner feeds it a full region list (assign()) or the
+     * regions of a range that changed (update()), and adds / removes modules as they load. Regions never
+     * overlap; update() keeps the parts of old regions that stick out of the refreshed range. Every change
+     * bumps generation(), so callers can tell whether something they derived from the index is stale.
+     */
+    class AddressSpace {
+    public:
+        /**
+         * @brief Replaces all regions.
+         * @param regions Regions in any order; must not overlap.
+         */
+        void assign(std::vector<MemoryRegion_t> regions);
+
+        /**
+         * @brief Replaces the regions of a range with freshly queried ones.
+         * @param address Start of the range that changed.
+         * @param size Size of the range.
+         * @param regions Current regions of the range (may start before or end after it).
+         */
+        void update(uintptr_t address, SIZE_T size, std::span<const MemoryRegion_t> regions);
+
+        /**
+         * @brief Returns the region containing an address, or nullptr. O(log n).
+         * @param address Address to look up.
+         */
+        const MemoryRegion_t* find(uintptr_t address) const;
+
+        /**
+         * @brief Returns the regions overlapping a range, ascending. O(log n).
+         * @param address Start of the range.
+         * @param size Size of the range.
+         */
+        std::span<const MemoryRegion_t> overlapping(uintptr_t address, SIZE_T size) const;
+
+        /**
+         * @brief Returns the regions that have every property in filter, ascending.
+         * @param filter RegionFilter bits.
+         */
+        std::vector<MemoryRegion_t> select(uint32_t filter) const;
+
+        /**
+         * @brief Returns true if a region has every property in filter.
+         */
+        static bool matches(const MemoryRegion_t& region, uint32_t filter);
+
+        /**
+         * @brief Adds a module, replacing any module it overlaps.
+         * @param module Module; ignored if its size is 0.
+         */
+        void addModule(Module_t module);
+
+        /**
+         * @brief Removes the module loaded at a base address.
+         * @param base Image base.
+         * @return false if no module starts there.
+         */
+        bool removeModule(uintptr_t base);
+
+        /**
+         * @brief Returns the module containing an address, or nullptr. O(log n).
+         * @param address Address to look up.
+         */
+        const Module_t* findModule(uintptr_t address) const;
+
+        /**
+         * @brief Drops all regions and modules.
+         */
+        void clear();
+
+        /**
+         * @brief Drops the regions but keeps the modules; built() is false until the next assign().
+         */
+        void invalidateRegions();
+
+        inline std::span<const MemoryRegion_t> regions() const { return regions_; }
+        inline std::span<const Module_t> modules() const { return modules_; }
+
+        /**
+         * @brief Returns true once regions were assigned.
+         */
+        inline bool built() const { return built_; }
+
+        /**
+         * @brief Returns a counter incremented by every change of regions or modules.
+         */
+        inline uint64_t generation() const { return generation_; }
+
+    private:
+        std::vector<MemoryRegion_t> regions_; ///< Ascending, non-overlapping.
+        std::vector<Module_t> modules_;       ///< Ascending, non-overlapping.
+        uint64_t generation_ = 0;
+        bool built_ = false;
+    };
+
+} // namespace RoboDBG
+
+#endif
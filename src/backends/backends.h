@@ -0,0 +1,15 @@
+#ifndef BACKENDS_H
+#define BACKENDS_H
+
+#include "targetBackend.h"
+#include "simulatedBackend.h"
+
+#ifdef _WIN32
+#include "win32Backend.h"
+#endif
+
+#ifdef __linux__
+#include "ptraceBackend.h"
+#endif
+
+#endif
@@ -0,0 +1,903 @@
+#ifdef __linux__
+
+#include "ptraceBackend.h"
+
+#include <sys/ptrace.h>
+#include <sys/wait.h>
+#include <sys/uio.h>
+#include <sys/user.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <dirent.h>
+#include <elf.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+namespace RoboDBG {
+
+namespace {
+    constexpr DWORD64 TRAP_FLAG = 0x100;
+
+    /**
+     * @struct MapsEntry_t
+     * @brief One line of /proc/<pid>/maps.
+     */
+    struct MapsEntry_t {
+        uintptr_t start;
+        uintptr_t end;
+        DWORD protect;
+        unsigned long inode;
+        std::string path;
+    };
+
+    DWORD toProtect(const std::string& perms) {
+        const bool r = perms.size() > 0 && perms[0] == 'r';
+        const bool w = perms.size() > 1 && perms[1] == 'w';
+        const bool x = perms.size() > 2 && perms[2] == 'x';
+        if (x) return w ? PAGE_EXECUTE_READWRITE : (r ? PAGE_EXECUTE_READ : PAGE_EXECUTE);
+        if (w) return PAGE_READWRITE;
+        if (r) return PAGE_READONLY;
+        return PAGE_NOACCESS;
+    }
+
+    std::vector<MapsEntry_t> readMaps(pid_t pid) {
+        std::vector<MapsEntry_t> entries;
+        std::ifstream maps("/proc/" + std::to_string(pid) + "/maps");
+        std::string line;
+        while (std::getline(maps, line)) {
+            std::istringstream ss(line);
+            std::string range, perms, offset, dev, path;
+            unsigned long inode = 0;
+            ss >> range >> perms >> offset >> dev >> inode;
+            std::getline(ss >> std::ws, path);
+
+            const size_t dash = range.find('-');
+            if (dash == std::string::npos) continue;
+            MapsEntry_t e;
+            e.start   = std::stoull(range.substr(0, dash), nullptr, 16);
+            e.end     = std::stoull(range.substr(dash + 1), nullptr, 16);
+            e.protect = toProtect(perms);
+            e.inode   = inode;
+            e.path    = path;
+            entries.push_back(e);
+        }
+        return entries;
+    }
+
+    std::string baseName(const std::string& path) {
+        const size_t p = path.find_last_of('/');
+        return (p == std::string::npos) ? path : path.substr(p + 1);
+    }
+
+    std::vector<pid_t> listTasks(pid_t pid) {
+        std::vector<pid_t> tids;
+        const std::string dir = "/proc/" + std::to_string(pid) + "/task";
+        DIR* d = opendir(dir.c_str());
+        if (!d) return tids;
+        while (dirent* ent = readdir(d)) {
+            if (ent->d_name[0] < '0' || ent->d_name[0] > '9') continue;
+            tids.push_back(static_cast<pid_t>(std::atoi(ent->d_name)));
+        }
+        closedir(d);
+        return tids;
+    }
+
+    int toProt(DWORD protect) {
+        switch (protect & 0xFF) {
+            case PAGE_READONLY:          return PROT_READ;
+            case PAGE_READWRITE:
+            case PAGE_WRITECOPY:         return PROT_READ | PROT_WRITE;
+            case PAGE_EXECUTE:           return PROT_EXEC;
+            case PAGE_EXECUTE_READ:      return PROT_READ | PROT_EXEC;
+            case PAGE_EXECUTE_READWRITE:
+            case PAGE_EXECUTE_WRITECOPY: return PROT_READ | PROT_WRITE | PROT_EXEC;
+            default:                     return PROT_NONE;
+        }
+    }
+
+    long debugRegOffset(int index) {
+        return static_cast<long>(offsetof(struct user, u_debugreg) + index * sizeof(long));
+    }
+}
+
+PtraceBackend::PtraceBackend(bool verbose) : verbose_(verbose) {
+}
+
+PtraceBackend::~PtraceBackend() {
+    if (memFd_ >= 0) ::close(memFd_);
+}
+
+// ==================================================
+// LIFECYCLE
+// ==================================================
+
+bool PtraceBackend::start(const std::string& exeName, const std::vector<std::string>& args) {
+    // Build argv before forking; the child must not allocate.
+    std::vector<std::string> argStrings;
+    argStrings.push_back(exeName);
+    argStrings.insert(argStrings.end(), args.begin(), args.end());
+    std::vector<char*> argv;
+    for (auto& a : argStrings) argv.push_back(a.data());
+    argv.push_back(nullptr);
+
+    pid_t child = fork();
+    if (child < 0) {
+        std::cerr << "[-] fork failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (child == 0) {
+        ptrace(PTRACE_TRACEME, 0, nullptr, nullptr);
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int status = 0;
+    if (waitpid(child, &status, 0) != child || !WIFSTOPPED(status)) {
+        std::cerr << "[-] Failed to start " << exeName << std::endl;
+        return false;
+    }
+    ptrace(PTRACE_SETOPTIONS, child, nullptr, reinterpret_cast<void*>(PTRACE_O_TRACECLONE | PTRACE_O_EXITKILL));
+
+    pid_ = child;
+    threads_[child].stopped = true;
+    memFd_ = open(("/proc/" + std::to_string(pid_) + "/mem").c_str(), O_RDWR | O_CLOEXEC);
+
+    DebugEvent_t event;
+    makeCreateProcessEvent(event);
+    pending_.push_back(event);
+    return true;
+}
+
+bool PtraceBackend::attach(DWORD pid) {
+    pid_ = static_cast<pid_t>(pid);
+
+    // Threads may be spawned while we attach; repeat until the task list is stable.
+    bool added = true;
+    while (added) {
+        added = false;
+        for (pid_t tid : listTasks(pid_)) {
+            if (threads_.count(tid)) continue;
+            if (ptrace(PTRACE_ATTACH, tid, nullptr, nullptr) != 0) {
+                if (tid == pid_) {
+                    std::cerr << "[-] Failed to attach to process: " << std::strerror(errno) << std::endl;
+                    return false;
+                }
+                continue;
+            }
+            int status = 0;
+            if (waitpid(tid, &status, __WALL) != tid || !WIFSTOPPED(status)) continue;
+            ptrace(PTRACE_SETOPTIONS, tid, nullptr, reinterpret_cast<void*>(PTRACE_O_TRACECLONE));
+            threads_[tid].stopped = true;
+            added = true;
+        }
+    }
+    if (threads_.empty()) return false;
+
+    attached_ = true;
+    memFd_ = open(("/proc/" + std::to_string(pid_) + "/mem").c_str(), O_RDWR | O_CLOEXEC);
+
+    // Windows reports CREATE_PROCESS followed by CREATE_THREAD for every existing thread on attach.
+    DebugEvent_t event;
+    makeCreateProcessEvent(event);
+    pending_.push_back(event);
+    for (const auto& [tid, thread] : threads_) {
+        if (tid == pid_) continue;
+        DebugEvent_t created;
+        created.type      = DebugEventType::CREATE_THREAD;
+        created.processId = static_cast<DWORD>(pid_);
+        created.threadId  = static_cast<DWORD>(tid);
+        created.hThread   = toHandle(tid);
+        pending_.push_back(created);
+    }
+    return true;
+}
+
+bool PtraceBackend::detach() {
+    stopAll(0);
+    pending_.clear();
+
+    bool ok = true;
+    for (auto& [tid, thread] : threads_) {
+        // Swallow SIGSTOPs we sent but never consumed, otherwise the thread stops again after detaching.
+        for (int tries = 0; thread.stopPending && tries < 16; ++tries) {
+            int status = 0;
+            if (ptrace(PTRACE_CONT, tid, nullptr, nullptr) != 0 || waitpid(tid, &status, __WALL) != tid) break;
+            if (WIFSTOPPED(status) && WSTOPSIG(status) == SIGSTOP) thread.stopPending = false;
+        }
+        if (ptrace(PTRACE_DETACH, tid, nullptr, nullptr) != 0 && errno != ESRCH) {
+            std::cerr << "[-] Failed to detach from TID=" << tid << ": " << std::strerror(errno) << std::endl;
+            ok = false;
+        }
+    }
+    threads_.clear();
+    attached_ = false;
+    return ok;
+}
+
+bool PtraceBackend::terminate(DWORD exitCode) {
+    (void)exitCode; // a killed process has no exit code of its own choosing
+    if (pid_ <= 0) return false;
+    if (kill(pid_, SIGKILL) != 0) {
+        std::cerr << "[-] kill failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    // Reap the process if it is our child; no-op (ECHILD) otherwise.
+    int status = 0;
+    waitpid(pid_, &status, __WALL);
+    threads_.clear();
+    return true;
+}
+
+void PtraceBackend::close() {
+    if (memFd_ >= 0) ::close(memFd_);
+    memFd_ = -1;
+}
+
+DWORD PtraceBackend::findProcessId(const std::string& exeName) {
+    DIR* d = opendir("/proc");
+    if (!d) return 0;
+
+    DWORD found = 0;
+    while (dirent* ent = readdir(d)) {
+        if (ent->d_name[0] < '0' || ent->d_name[0] > '9') continue;
+        const std::string dir = std::string("/proc/") + ent->d_name;
+
+        std::string comm;
+        std::ifstream(dir + "/comm") >> comm;
+
+        char exe[PATH_MAX] = {};
+        ssize_t len = readlink((dir + "/exe").c_str(), exe, sizeof(exe) - 1);
+        std::string exeBase = len > 0 ? baseName(std::string(exe, len)) : std::string();
+
+        if (comm == exeName || exeBase == exeName) {
+            found = static_cast<DWORD>(std::atoi(ent->d_name));
+            break;
+        }
+    }
+    closedir(d);
+    return found;
+}
+
+std::string PtraceBackend::exePath() const {
+    char exe[PATH_MAX] = {};
+    ssize_t len = readlink(("/proc/" + std::to_string(pid_) + "/exe").c_str(), exe, sizeof(exe) - 1);
+    return len > 0 ? std::string(exe, len) : std::string();
+}
+
+void PtraceBackend::makeCreateProcessEvent(DebugEvent_t& event) {
+    event = DebugEvent_t{};
+    event.type      = DebugEventType::CREATE_PROCESS;
+    event.processId = static_cast<DWORD>(pid_);
+    event.threadId  = static_cast<DWORD>(pid_);
+    event.hThread   = toHandle(pid_);
+
+    const std::string exe = exePath();
+    for (const auto& e : readMaps(pid_)) {
+        if (e.path == exe) {
+            event.imageBase = e.start;
+            break;
+        }
+    }
+    event.startAddress = getEntryPoint(event.imageBase);
+}
+
+// ==================================================
+// EVENTS
+// ==================================================
+
+bool PtraceBackend::resume(pid_t tid, PtraceThread_t& thread, int signal) {
+    const auto request = thread.singleStep ? PTRACE_SINGLESTEP : PTRACE_CONT;
+    if (ptrace(request, tid, nullptr, reinterpret_cast<void*>(static_cast<uintptr_t>(signal))) != 0) {
+        if (verbose_) std::cerr << "[-] Failed to resume TID=" << tid << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    thread.stopped = false;
+    thread.signal = 0;
+    return true;
+}
+
+bool PtraceBackend::decodeStop(pid_t tid, int status, DebugEvent_t& event) {
+    event = DebugEvent_t{};
+    event.processId = static_cast<DWORD>(pid_);
+    event.threadId  = static_cast<DWORD>(tid);
+    event.rawCode   = static_cast<DWORD>(status);
+
+    if (WIFEXITED(status) || WIFSIGNALED(status)) {
+        const DWORD code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+        const bool known = threads_.erase(tid) > 0;
+        if (tid == pid_) {
+            event.type = DebugEventType::EXIT_PROCESS;
+            event.exitCode = code;
+            return true;
+        }
+        if (!known) return false;
+        event.type = DebugEventType::EXIT_THREAD;
+        event.exitCode = code;
+        return true;
+    }
+    if (!WIFSTOPPED(status)) return false;
+
+    const int sig = WSTOPSIG(status);
+    const int ptraceEvent = status >> 16;
+
+    auto it = threads_.find(tid);
+    if (it == threads_.end()) {
+        // Initial stop of a new thread that arrived before its parent's clone event; keep it stopped.
+        threads_[tid].stopped = true;
+        return false;
+    }
+    it->second.stopped = true;
+
+    if (sig == SIGTRAP && ptraceEvent == PTRACE_EVENT_CLONE) {
+        unsigned long msg = 0;
+        ptrace(PTRACE_GETEVENTMSG, tid, nullptr, &msg);
+        const pid_t newTid = static_cast<pid_t>(msg);
+        if (!threads_.count(newTid)) {
+            int st = 0;
+            while (waitpid(newTid, &st, __WALL) < 0 && errno == EINTR) {}
+            threads_[newTid].stopped = true;
+        }
+
+        struct user_regs_struct regs = {};
+        ptrace(PTRACE_GETREGS, newTid, nullptr, &regs);
+        event.type     = DebugEventType::CREATE_THREAD;
+        event.threadId = static_cast<DWORD>(newTid);
+        event.hThread  = toHandle(newTid);
+        #ifdef __x86_64__
+        event.threadBase   = regs.fs_base;
+        event.startAddress = regs.rip;
+        #else
+        event.startAddress = regs.eip;
+        #endif
+        return true;
+    }
+
+    PtraceThread_t& thread = it->second;
+    if (sig == SIGTRAP && ptraceEvent != 0) {
+        resume(tid, thread, 0);
+        return false;
+    }
+    if (sig == SIGSTOP && thread.stopPending) {
+        // Our own stop request, delivered after the thread already reported something else.
+        thread.stopPending = false;
+        resume(tid, thread, 0);
+        return false;
+    }
+
+    siginfo_t si = {};
+    ptrace(PTRACE_GETSIGINFO, tid, nullptr, &si);
+    struct user_regs_struct regs = {};
+    ptrace(PTRACE_GETREGS, tid, nullptr, &regs);
+    #ifdef __x86_64__
+    const uintptr_t ip = regs.rip;
+    #else
+    const uintptr_t ip = regs.eip;
+    #endif
+
+    event.type = DebugEventType::EXCEPTION;
+    event.exceptionAddress = ip;
+    switch (sig) {
+        case SIGTRAP:
+            if (si.si_code == SI_USER || si.si_code == SI_TKILL) {
+                resume(tid, thread, sig);
+                return false;
+            }
+            if (si.si_code == SI_KERNEL || si.si_code == TRAP_BRKPT) {
+                event.exceptionCode = EXCEPTION_BREAKPOINT;
+                event.exceptionAddress = ip - 1; // int3 leaves IP behind the 0xCC
+            } else {
+                event.exceptionCode = EXCEPTION_SINGLE_STEP; // TRAP_TRACE / TRAP_HWBKPT
+            }
+            break;
+        case SIGSEGV:
+            event.exceptionCode = EXCEPTION_ACCESS_VIOLATION;
+            event.exceptionInfo[1] = reinterpret_cast<uintptr_t>(si.si_addr);
+            event.exceptionInfo[0] = (event.exceptionInfo[1] == ip) ? 8 : 0; // execute / read
+            break;
+        case SIGBUS:
+            event.exceptionCode = EXCEPTION_IN_PAGE_ERROR;
+            event.exceptionInfo[1] = reinterpret_cast<uintptr_t>(si.si_addr);
+            break;
+        case SIGILL:
+            event.exceptionCode = EXCEPTION_ILLEGAL_INSTRUCTION;
+            break;
+        case SIGFPE:
+            event.exceptionCode = EXCEPTION_INT_DIVIDE_BY_ZERO;
+            break;
+        default:
+            // Not an exception; hand it to the debuggee.
+            resume(tid, thread, sig);
+            return false;
+    }
+
+    thread.singleStep = false;
+    thread.signal = sig;
+    return true;
+}
+
+void PtraceBackend::stopAll(pid_t except) {
+    std::vector<pid_t> waitFor;
+    for (auto& [tid, thread] : threads_) {
+        if (tid == except || thread.stopped || thread.stopPending) continue;
+        if (syscall(SYS_tgkill, pid_, tid, SIGSTOP) == 0) {
+            thread.stopPending = true;
+            waitFor.push_back(tid);
+        }
+    }
+
+    for (pid_t tid : waitFor) {
+        for (;;) {
+            int status = 0;
+            if (waitpid(tid, &status, __WALL) < 0) {
+                if (errno == EINTR) continue;
+                threads_.erase(tid);
+                break;
+            }
+            auto it = threads_.find(tid);
+            if (it == threads_.end()) break;
+
+            if (WIFSTOPPED(status) && WSTOPSIG(status) == SIGSTOP && (status >> 16) == 0) {
+                it->second.stopPending = false;
+                it->second.stopped = true;
+                break;
+            }
+
+            // Something else happened first; report it later. Our SIGSTOP is swallowed when it arrives.
+            DebugEvent_t event;
+            if (decodeStop(tid, status, event)) {
+                if (event.type == DebugEventType::EXCEPTION) threads_[tid].hasEvent = true;
+                pending_.push_back(event);
+                break;
+            }
+            if (!threads_.count(tid) || threads_[tid].stopped) break;
+        }
+    }
+}
+
+bool PtraceBackend::waitForEvent(DebugEvent_t& event, DWORD timeoutMs) {
+    if (!pending_.empty()) {
+        event = pending_.front();
+        pending_.pop_front();
+        auto it = threads_.find(static_cast<pid_t>(event.threadId));
+        if (it != threads_.end()) it->second.hasEvent = false;
+        stopAll(static_cast<pid_t>(event.threadId));
+        return true;
+    }
+    if (pid_ <= 0 || threads_.empty()) return false;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    for (;;) {
+        int status = 0;
+        pid_t tid = waitpid(-1, &status, __WALL | (timeoutMs == INFINITE ? 0 : WNOHANG));
+        if (tid == 0) {
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        if (tid < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (decodeStop(tid, status, event)) {
+            stopAll(tid);
+            return true;
+        }
+    }
+}
+
+bool PtraceBackend::continueEvent(const DebugEvent_t& event, bool handled) {
+    auto it = threads_.find(static_cast<pid_t>(event.threadId));
+    if (it != threads_.end() && handled) it->second.signal = 0;
+
+    // The next queued event is reported while the process is still frozen.
+    if (!pending_.empty()) return true;
+
+    bool ok = true;
+    for (auto& [tid, thread] : threads_) {
+        if (!thread.stopped || thread.hasEvent) continue;
+        ok &= resume(tid, thread, thread.signal);
+    }
+    return ok;
+}
+
+std::string PtraceBackend::getModuleName(const DebugEvent_t& event) {
+    RemoteScope call(*this, RemoteCall::EVENT_PAYLOAD);
+    if (event.type == DebugEventType::CREATE_PROCESS) return baseName(exePath());
+    for (const auto& e : readMaps(pid_)) {
+        if (event.imageBase >= e.start && event.imageBase < e.end) return baseName(e.path);
+    }
+    return "<unknown>";
+}
+
+std::string PtraceBackend::getDebugString(const DebugEvent_t&) {
+    return std::string();
+}
+
+uintptr_t PtraceBackend::getEntryPoint(uintptr_t imageBase) {
+    RemoteScope call(*this, RemoteCall::EVENT_PAYLOAD);
+    unsigned char ident[EI_NIDENT] = {};
+    if (!imageBase || !readMemory(imageBase, ident, sizeof(ident)) || std::memcmp(ident, ELFMAG, SELFMAG) != 0)
+        return 0;
+
+    if (ident[EI_CLASS] == ELFCLASS64) {
+        Elf64_Ehdr hdr;
+        if (!readMemory(imageBase, &hdr, sizeof(hdr))) return 0;
+        return static_cast<uintptr_t>(hdr.e_type == ET_DYN ? imageBase + hdr.e_entry : hdr.e_entry);
+    }
+    Elf32_Ehdr hdr;
+    if (!readMemory(imageBase, &hdr, sizeof(hdr))) return 0;
+    return static_cast<uintptr_t>(hdr.e_type == ET_DYN ? imageBase + hdr.e_entry : hdr.e_entry);
+}
+
+// ==================================================
+// MEMORY
+// ==================================================
+
+bool PtraceBackend::readMemory(uintptr_t address, void* buffer, SIZE_T size, SIZE_T* bytesRead) {
+    RemoteScope call(*this, RemoteCall::READ_MEMORY);
+    struct iovec local  = { buffer, size };
+    struct iovec remote = { reinterpret_cast<void*>(address), size };
+    ssize_t n = process_vm_readv(pid_, &local, 1, &remote, 1, 0);
+    SIZE_T total = n > 0 ? static_cast<SIZE_T>(n) : 0;
+
+    // process_vm_readv stops at the first inaccessible page; /proc/<pid>/mem can still read e.g. PROT_NONE guard areas
+    if (total < size && memFd_ >= 0) {
+        ssize_t m = pread64(memFd_, static_cast<char*>(buffer) + total, size - total, static_cast<off64_t>(address + total));
+        if (m > 0) total += static_cast<SIZE_T>(m);
+    }
+    call.setBytes(total);
+    if (bytesRead) *bytesRead = total;
+    return total == size;
+}
+
+bool PtraceBackend::writeMemory(uintptr_t address, const void* buffer, SIZE_T size) {
+    RemoteScope call(*this, RemoteCall::WRITE_MEMORY);
+    // /proc/<pid>/mem writes ignore page protection (needed for breakpoints in .text)
+    if (memFd_ >= 0) {
+        ssize_t n = pwrite64(memFd_, buffer, size, static_cast<off64_t>(address));
+        if (n == static_cast<ssize_t>(size)) {
+            call.setBytes(size);
+            return true;
+        }
+    }
+    struct iovec local  = { const_cast<void*>(buffer), size };
+    struct iovec remote = { reinterpret_cast<void*>(address), size };
+    const ssize_t n = process_vm_writev(pid_, &local, 1, &remote, 1, 0);
+    call.setBytes(n > 0 ? static_cast<uint64_t>(n) : 0);
+    return n == static_cast<ssize_t>(size);
+}
+
+size_t PtraceBackend::readMemoryScatter(MemoryIo_t* ios, size_t count) {
+    size_t complete = 0;
+    size_t i = 0;
+    std::vector<struct iovec> local, remote;
+
+    while (i < count) {
+        const size_t batch = std::min<size_t>(count - i, IOV_MAX);
+        local.resize(batch);
+        remote.resize(batch);
+        for (size_t j = 0; j < batch; ++j) {
+            local[j]  = { ios[i + j].buffer, ios[i + j].size };
+            remote[j] = { reinterpret_cast<void*>(ios[i + j].address), ios[i + j].size };
+        }
+
+        SIZE_T left = 0;
+        {
+            RemoteScope call(*this, RemoteCall::READ_MEMORY);
+            ssize_t n = process_vm_readv(pid_, local.data(), batch, remote.data(), batch, 0);
+            left = n > 0 ? static_cast<SIZE_T>(n) : 0;
+            call.setBytes(left);
+        }
+
+        size_t j = i;
+        for (; j < i + batch && left >= ios[j].size; ++j) {
+            ios[j].transferred = ios[j].size;
+            left -= ios[j].size;
+            ++complete;
+        }
+        if (j == i + batch) {
+            i = j;
+            continue;
+        }
+
+        // The kernel stops at the first failing element; retry that one alone and go on behind it.
+        SIZE_T got = 0;
+        readMemory(ios[j].address, ios[j].buffer, ios[j].size, &got);
+        ios[j].transferred = got;
+        if (got == ios[j].size) ++complete;
+        i = j + 1;
+    }
+    return complete;
+}
+
+bool PtraceBackend::flushInstructionCache(uintptr_t, SIZE_T) {
+    return true; // x86 keeps instruction caches coherent
+}
+
+bool PtraceBackend::protectMemory(uintptr_t, SIZE_T, DWORD, DWORD*) {
+    if (verbose_) std::cerr << "[-] Changing remote page protection is not supported by the ptrace backend\n";
+    return false;
+}
+
+bool PtraceBackend::remoteSyscall(long number, const uintptr_t (&args)[6], long& result) {
+    pid_t tid = 0;
+    for (const auto& [t, thread] : threads_) {
+        if (thread.stopped) {
+            tid = t;
+            break;
+        }
+    }
+    if (!tid) return false;
+
+    struct user_regs_struct saved = {};
+    if (ptrace(PTRACE_GETREGS, tid, nullptr, &saved) != 0) return false;
+    struct user_regs_struct regs = saved;
+
+    // Borrow two bytes at the thread's IP for the syscall instruction
+    #ifdef __x86_64__
+    const uintptr_t ip = regs.rip;
+    static const BYTE insn[2] = { 0x0F, 0x05 }; // syscall
+    regs.rax = number;
+    regs.orig_rax = -1; // no syscall restart for the interrupted call
+    regs.rdi = args[0]; regs.rsi = args[1]; regs.rdx = args[2];
+    regs.r10 = args[3]; regs.r8 = args[4];  regs.r9 = args[5];
+    #else
+    const uintptr_t ip = regs.eip;
+    static const BYTE insn[2] = { 0xCD, 0x80 }; // int 0x80
+    regs.eax = number;
+    regs.orig_eax = -1;
+    regs.ebx = args[0]; regs.ecx = args[1]; regs.edx = args[2];
+    regs.esi = args[3]; regs.edi = args[4]; regs.ebp = args[5];
+    #endif
+
+    BYTE original[2] = {};
+    if (!readMemory(ip, original, sizeof(original)) || !writeMemory(ip, insn, sizeof(insn))) return false;
+
+    bool ok = ptrace(PTRACE_SETREGS, tid, nullptr, &regs) == 0;
+    int status = 0;
+    if (ok) {
+        // Signals that arrive during the step are dropped; the process is frozen, so this is rare
+        for (int tries = 0; tries < 16; ++tries) {
+            ok = ptrace(PTRACE_SINGLESTEP, tid, nullptr, nullptr) == 0
+              && waitpid(tid, &status, __WALL) == tid && WIFSTOPPED(status);
+            if (!ok || WSTOPSIG(status) == SIGTRAP) break;
+        }
+        ok = ok && WSTOPSIG(status) == SIGTRAP && ptrace(PTRACE_GETREGS, tid, nullptr, &regs) == 0;
+    }
+    if (!ok && (WIFEXITED(status) || WIFSIGNALED(status))) {
+        threads_.erase(tid);
+        return false;
+    }
+
+    writeMemory(ip, original, sizeof(original));
+    ptrace(PTRACE_SETREGS, tid, nullptr, &saved);
+    #ifdef __x86_64__
+    result = static_cast<long>(regs.rax);
+    #else
+    result = static_cast<long>(regs.eax);
+    #endif
+    return ok;
+}
+
+uintptr_t PtraceBackend::allocateMemory(uintptr_t address, SIZE_T size, DWORD protect) {
+    RemoteScope call(*this, RemoteCall::ALLOCATE_MEMORY);
+    #ifdef __x86_64__
+    const long number = SYS_mmap;
+    const uintptr_t offset = 0;
+    #else
+    const long number = SYS_mmap2;
+    const uintptr_t offset = 0; // in pages
+    #endif
+    const uintptr_t args[6] = {
+        address, size, static_cast<uintptr_t>(toProt(protect)),
+        static_cast<uintptr_t>(MAP_PRIVATE | MAP_ANONYMOUS), static_cast<uintptr_t>(-1), offset
+    };
+    long result = 0;
+    if (!remoteSyscall(number, args, result) || (result < 0 && result >= -4095)) {
+        if (verbose_) std::cerr << "[-] Remote mmap failed: " << std::strerror(result < 0 ? static_cast<int>(-result) : EIO) << "\n";
+        return 0;
+    }
+    return static_cast<uintptr_t>(result);
+}
+
+bool PtraceBackend::freeMemory(uintptr_t address, SIZE_T size) {
+    RemoteScope call(*this, RemoteCall::FREE_MEMORY);
+    const uintptr_t args[6] = { address, size, 0, 0, 0, 0 };
+    long result = 0;
+    return remoteSyscall(SYS_munmap, args, result) && result == 0;
+}
+
+std::vector<MemoryRegion_t> PtraceBackend::getMemoryRegions() {
+    RemoteScope call(*this, RemoteCall::QUERY_MEMORY);
+    std::vector<MemoryRegion_t> regions;
+    for (const auto& e : readMaps(pid_)) {
+        MemoryRegion_t region;
+        region.BaseAddress = reinterpret_cast<LPVOID>(e.start);
+        region.RegionSize  = e.end - e.start;
+        region.State       = MEM_COMMIT;
+        region.Protect     = e.protect;
+        region.Type        = e.inode != 0 ? MEM_IMAGE : MEM_PRIVATE;
+        regions.push_back(region);
+    }
+    return regions;
+}
+
+// ==================================================
+// THREADS
+// ==================================================
+
+std::vector<DWORD> PtraceBackend::enumerateThreads() {
+    std::vector<DWORD> tids;
+    tids.reserve(threads_.size());
+    for (const auto& [tid, thread] : threads_) tids.push_back(static_cast<DWORD>(tid));
+    std::sort(tids.begin(), tids.end());
+    return tids;
+}
+
+HANDLE PtraceBackend::openThread(DWORD threadId) {
+    return threads_.count(static_cast<pid_t>(threadId)) ? toHandle(static_cast<pid_t>(threadId)) : nullptr;
+}
+
+void PtraceBackend::closeThread(HANDLE) {
+}
+
+bool PtraceBackend::suspendThread(HANDLE) {
+    return true; // all threads are stopped while an event is being handled
+}
+
+bool PtraceBackend::resumeThread(HANDLE) {
+    return true;
+}
+
+bool PtraceBackend::getContext(HANDLE hThread, ThreadContext_t& ctx, DWORD parts) {
+    const pid_t tid = toTid(hThread);
+    RemoteScope call(*this, RemoteCall::GET_CONTEXT);
+
+    if (parts & (CONTEXT_PART_CONTROL | CONTEXT_PART_INTEGER)) {
+        struct user_regs_struct regs = {};
+        if (ptrace(PTRACE_GETREGS, tid, nullptr, &regs) != 0) {
+            if (verbose_) std::cerr << "[-] PTRACE_GETREGS failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+        #ifdef __x86_64__
+        if (parts & CONTEXT_PART_CONTROL) {
+            ctx.ip = regs.rip;
+            ctx.flags = regs.eflags;
+            ctx.gpr[6] = regs.rbp;
+            ctx.gpr[7] = regs.rsp;
+            ctx.segCs = static_cast<DWORD>(regs.cs);
+            ctx.segSs = static_cast<DWORD>(regs.ss);
+        }
+        if (parts & CONTEXT_PART_INTEGER) {
+            const DWORD64 gpr[16] = {
+                regs.rax, regs.rbx, regs.rcx, regs.rdx, regs.rsi, regs.rdi, regs.rbp, regs.rsp,
+                regs.r8, regs.r9, regs.r10, regs.r11, regs.r12, regs.r13, regs.r14, regs.r15
+            };
+            std::copy(std::begin(gpr), std::end(gpr), ctx.gpr);
+        }
+        #else
+        if (parts & CONTEXT_PART_CONTROL) {
+            ctx.ip = static_cast<DWORD>(regs.eip);
+            ctx.flags = static_cast<DWORD>(regs.eflags);
+            ctx.gpr[6] = static_cast<DWORD>(regs.ebp);
+            ctx.gpr[7] = static_cast<DWORD>(regs.esp);
+            ctx.segCs = static_cast<DWORD>(regs.xcs);
+            ctx.segSs = static_cast<DWORD>(regs.xss);
+        }
+        if (parts & CONTEXT_PART_INTEGER) {
+            ctx.gpr[0] = static_cast<DWORD>(regs.eax); ctx.gpr[1] = static_cast<DWORD>(regs.ebx);
+            ctx.gpr[2] = static_cast<DWORD>(regs.ecx); ctx.gpr[3] = static_cast<DWORD>(regs.edx);
+            ctx.gpr[4] = static_cast<DWORD>(regs.esi); ctx.gpr[5] = static_cast<DWORD>(regs.edi);
+            ctx.gpr[6] = static_cast<DWORD>(regs.ebp); ctx.gpr[7] = static_cast<DWORD>(regs.esp);
+        }
+        #endif
+        auto it = threads_.find(tid);
+        if ((parts & CONTEXT_PART_CONTROL) && it != threads_.end() && it->second.singleStep)
+            ctx.flags |= TRAP_FLAG;
+    }
+
+    if (parts & CONTEXT_PART_DEBUG) {
+        for (int i : { 0, 1, 2, 3, 6, 7 }) {
+            errno = 0;
+            long value = ptrace(PTRACE_PEEKUSER, tid, reinterpret_cast<void*>(debugRegOffset(i)), nullptr);
+            if (errno != 0) return false;
+            ctx.dr[i] = static_cast<unsigned long>(value);
+        }
+    }
+    return true;
+}
+
+bool PtraceBackend::setContext(HANDLE hThread, const ThreadContext_t& ctx, DWORD parts) {
+    const pid_t tid = toTid(hThread);
+    RemoteScope call(*this, RemoteCall::SET_CONTEXT);
+
+    if (parts & (CONTEXT_PART_CONTROL | CONTEXT_PART_INTEGER)) {
+        struct user_regs_struct regs = {};
+        if (ptrace(PTRACE_GETREGS, tid, nullptr, &regs) != 0) {
+            std::cerr << "[-] PTRACE_GETREGS failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+        // TF is not written to the thread; the thread is resumed with PTRACE_SINGLESTEP instead so the
+        // kernel clears it after one instruction the same way Windows does.
+        const DWORD64 flags = ctx.flags & ~TRAP_FLAG;
+        #ifdef __x86_64__
+        if (parts & CONTEXT_PART_CONTROL) {
+            regs.rip = ctx.ip;
+            regs.eflags = flags;
+            regs.rbp = ctx.gpr[6];
+            regs.rsp = ctx.gpr[7];
+        }
+        if (parts & CONTEXT_PART_INTEGER) {
+            regs.rax = ctx.gpr[0];  regs.rbx = ctx.gpr[1];  regs.rcx = ctx.gpr[2];  regs.rdx = ctx.gpr[3];
+            regs.rsi = ctx.gpr[4];  regs.rdi = ctx.gpr[5];  regs.rbp = ctx.gpr[6];
+            regs.r8  = ctx.gpr[8];  regs.r9  = ctx.gpr[9];  regs.r10 = ctx.gpr[10]; regs.r11 = ctx.gpr[11];
+            regs.r12 = ctx.gpr[12]; regs.r13 = ctx.gpr[13]; regs.r14 = ctx.gpr[14]; regs.r15 = ctx.gpr[15];
+        }
+        #else
+        if (parts & CONTEXT_PART_CONTROL) {
+            regs.eip = static_cast<long>(ctx.ip);
+            regs.eflags = static_cast<long>(flags);
+            regs.ebp = static_cast<long>(ctx.gpr[6]);
+            regs.esp = static_cast<long>(ctx.gpr[7]);
+        }
+        if (parts & CONTEXT_PART_INTEGER) {
+            regs.eax = static_cast<long>(ctx.gpr[0]); regs.ebx = static_cast<long>(ctx.gpr[1]);
+            regs.ecx = static_cast<long>(ctx.gpr[2]); regs.edx = static_cast<long>(ctx.gpr[3]);
+            regs.esi = static_cast<long>(ctx.gpr[4]); regs.edi = static_cast<long>(ctx.gpr[5]);
+        }
+        #endif
+        if (ptrace(PTRACE_SETREGS, tid, nullptr, &regs) != 0) {
+            std::cerr << "[-] PTRACE_SETREGS failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+        auto it = threads_.find(tid);
+        if ((parts & CONTEXT_PART_CONTROL) && it != threads_.end())
+            it->second.singleStep = (ctx.flags & TRAP_FLAG) != 0;
+    }
+
+    if (parts & CONTEXT_PART_DEBUG) {
+        errno = 0;
+        const long oldDr7 = ptrace(PTRACE_PEEKUSER, tid, reinterpret_cast<void*>(debugRegOffset(7)), nullptr);
+        const long newDr7 = static_cast<long>(ctx.dr[7]);
+        // Disable removed slots first, then move the addresses, then enable the new slots.
+        bool ok = ptrace(PTRACE_POKEUSER, tid, reinterpret_cast<void*>(debugRegOffset(7)), reinterpret_cast<void*>(oldDr7 & newDr7)) == 0;
+        for (int i = 0; i < 4; ++i)
+            ok &= ptrace(PTRACE_POKEUSER, tid, reinterpret_cast<void*>(debugRegOffset(i)), reinterpret_cast<void*>(static_cast<uintptr_t>(ctx.dr[i]))) == 0;
+        ok &= ptrace(PTRACE_POKEUSER, tid, reinterpret_cast<void*>(debugRegOffset(6)), reinterpret_cast<void*>(static_cast<uintptr_t>(ctx.dr[6]))) == 0;
+        ok &= ptrace(PTRACE_POKEUSER, tid, reinterpret_cast<void*>(debugRegOffset(7)), reinterpret_cast<void*>(newDr7)) == 0;
+        if (!ok) {
+            std::cerr << "[-] Setting debug registers failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// ==================================================
+// MISC
+// ==================================================
+
+bool PtraceBackend::hideDebugger() {
+    if (verbose_) std::cerr << "[-] hideDebugger is not supported by the ptrace backend\n";
+    return false;
+}
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * @file ptraceBackend.h
+ * @brief TargetBackend for Linux x86 / x86-64 targets using ptrace
+ * @author Milkshake
+ */
+
+#ifndef PTRACEBACKEND_H
+#define PTRACEBACKEND_H
+
+#ifdef __linux__
+
+#include "targetBackend.h"
+
+#include <sys/types.h>
+#include <deque>
+#include <unordered_map>
+
+namespace RoboDBG {
+
+/**
+ * @class PtraceBackend
+ * @brief Linux backend (ptrace, waitpid, process_vm_readv/writev).
+ *
+ * Runs the debuggee in all-stop mode: when one thread reports an event all other threads are stopped
+ * with SIGSTOP, so the Debugger sees the same "whole process is frozen" state as on Windows.
+ * Events that other threads raise while being stopped are queued and reported one at a time.
+ *
+ * Signals are translated to exceptions: int3 -> EXCEPTION_BREAKPOINT, trace / debug register traps ->
+ * EXCEPTION_SINGLE_STEP, SIGSEGV -> EXCEPTION_ACCESS_VIOLATION, SIGILL / SIGFPE / SIGBUS to their
+ * closest Win32 code. Other signals are passed to the debuggee without reporting them.
+ * Thread handles are the thread IDs. No LOAD_DLL / DEBUG_STRING events are generated.
+ * allocateMemory() / freeMemory() run mmap / munmap in the debuggee on a stopped thread.
+ */
+class PtraceBackend : public TargetBackend {
+public:
+    explicit PtraceBackend(bool verbose);
+    ~PtraceBackend() override;
+
+    bool start(const std::string& exeName, const std::vector<std::string>& args) override;
+    bool attach(DWORD pid) override;
+    bool detach() override;
+    bool terminate(DWORD exitCode) override;
+    void close() override;
+    DWORD findProcessId(const std::string& exeName) override;
+    DWORD getProcessId() const override { return static_cast<DWORD>(pid_); }
+    HANDLE getProcessHandle() const override { return toHandle(pid_); }
+    HANDLE getMainThreadHandle() const override { return toHandle(pid_); }
+
+    bool waitForEvent(DebugEvent_t& event, DWORD timeoutMs) override;
+    bool continueEvent(const DebugEvent_t& event, bool handled) override;
+    std::string getModuleName(const DebugEvent_t& event) override;
+    std::string getDebugString(const DebugEvent_t& event) override;
+    uintptr_t getEntryPoint(uintptr_t imageBase) override;
+
+    bool readMemory(uintptr_t address, void* buffer, SIZE_T size, SIZE_T* bytesRead = nullptr) override;
+    bool writeMemory(uintptr_t address, const void* buffer, SIZE_T size) override;
+    size_t readMemoryScatter(MemoryIo_t* ios, size_t count) override;
+    bool flushInstructionCache(uintptr_t address, SIZE_T size) override;
+    bool protectMemory(uintptr_t address, SIZE_T size, DWORD newProtect, DWORD* oldProtect) override;
+    uintptr_t allocateMemory(uintptr_t address, SIZE_T size, DWORD protect) override;
+    bool freeMemory(uintptr_t address, SIZE_T size) override;
+    std::vector<MemoryRegion_t> getMemoryRegions() override;
+
+    std::vector<DWORD> enumerateThreads() override;
+    HANDLE openThread(DWORD threadId) override;
+    void closeThread(HANDLE hThread) override;
+    bool suspendThread(HANDLE hThread) override;
+    bool resumeThread(HANDLE hThread) override;
+    bool getContext(HANDLE hThread, ThreadContext_t& ctx, DWORD parts) override;
+    bool setContext(HANDLE hThread, const ThreadContext_t& ctx, DWORD parts) override;
+
+    bool hideDebugger() override;
+
+private:
+    /**
+     * @struct PtraceThread_t
+     * @brief Bookkeeping for one traced thread.
+     */
+    struct PtraceThread_t {
+        bool stopped = false;     ///< Thread is in a ptrace-stop.
+        bool stopPending = false; ///< We sent a SIGSTOP that has not been consumed yet.
+        bool singleStep = false;  ///< Resume with PTRACE_SINGLESTEP.
+        bool hasEvent = false;    ///< A queued event belongs to this thread; keep it stopped.
+        int signal = 0;           ///< Signal to deliver on resume (unless handled).
+    };
+
+    static HANDLE toHandle(pid_t tid) { return reinterpret_cast<HANDLE>(static_cast<uintptr_t>(tid)); }
+    static pid_t toTid(HANDLE hThread) { return static_cast<pid_t>(reinterpret_cast<uintptr_t>(hThread)); }
+
+    bool decodeStop(pid_t tid, int status, DebugEvent_t& event);
+    void stopAll(pid_t except);
+    bool resume(pid_t tid, PtraceThread_t& thread, int signal);
+    bool remoteSyscall(long number, const uintptr_t (&args)[6], long& result);
+    void makeCreateProcessEvent(DebugEvent_t& event);
+    std::string exePath() const;
+
+    bool verbose_;
+    pid_t pid_ = 0;
+    int memFd_ = -1;
+    bool attached_ = false;
+    std::unordered_map<pid_t, PtraceThread_t> threads_;
+    std::deque<DebugEvent_t> pending_;
+};
+
+} // namespace RoboDBG
+
+#endif
+
+#endif
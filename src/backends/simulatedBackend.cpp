@@ -0,0 +1,673 @@
+#include "simulatedBackend.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+
+namespace RoboDBG {
+
+namespace {
+    constexpr DWORD64 TRAP_FLAG = 0x100;
+    constexpr DWORD64 DR6_BS    = 1ULL << 14; // Single-step trap
+
+    // DR7 LEN encoding -> byte count
+    constexpr SIZE_T DR7_LEN_BYTES[4] = { 1, 2, 8, 4 };
+
+    uintptr_t pageBase(uintptr_t address) {
+        return address & ~(uintptr_t)(SimulatedBackend::PAGE_SIZE_SIM - 1);
+    }
+
+    void copyContext(ThreadContext_t& dst, const ThreadContext_t& src, DWORD parts) {
+        if (parts & CONTEXT_PART_CONTROL) {
+            dst.ip = src.ip;
+            dst.flags = src.flags;
+            dst.gpr[6] = src.gpr[6];
+            dst.gpr[7] = src.gpr[7];
+            dst.segCs = src.segCs;
+            dst.segSs = src.segSs;
+        }
+        if (parts & CONTEXT_PART_INTEGER) {
+            std::copy(std::begin(src.gpr), std::end(src.gpr), dst.gpr);
+        }
+        if (parts & CONTEXT_PART_DEBUG) {
+            std::copy(std::begin(src.dr), std::end(src.dr), dst.dr);
+        }
+    }
+}
+
+SimulatedBackend::SimulatedBackend(bool verbose) : verbose_(verbose) {
+}
+
+SimulatedBackend::~SimulatedBackend() = default;
+
+// ==================================================
+// SETUP
+// ==================================================
+
+void SimulatedBackend::setImage(const std::string& name, uintptr_t imageBase, uintptr_t entryPoint) {
+    imageName_  = name;
+    imageBase_  = imageBase;
+    entryPoint_ = entryPoint;
+}
+
+void SimulatedBackend::mapMemory(uintptr_t address, SIZE_T size, DWORD protect, BYTE fill) {
+    const uintptr_t end = address + size;
+    for (uintptr_t page = pageBase(address); page < end; page += PAGE_SIZE_SIM) {
+        auto& slot = pages_[page];
+        if (!slot) {
+            slot = std::make_unique<SimPage_t>();
+            slot->data.fill(fill);
+        }
+        slot->protect = protect;
+    }
+}
+
+void SimulatedBackend::unmapMemory(uintptr_t address, SIZE_T size) {
+    const uintptr_t end = address + size;
+    for (uintptr_t page = pageBase(address); page < end; page += PAGE_SIZE_SIM) {
+        pages_.erase(page);
+    }
+    lastPageBase_ = ~uintptr_t(0);
+    lastPage_ = nullptr;
+}
+
+void SimulatedBackend::setScript(std::vector<SimEvent_t> script, size_t repeat, DWORD exitCode) {
+    script_   = std::move(script);
+    repeat_   = repeat;
+    exitCode_ = exitCode;
+    cursor_   = 0;
+    pass_     = 0;
+}
+
+ThreadContext_t* SimulatedBackend::threadContext(DWORD threadId) {
+    auto it = threads_.find(threadId);
+    return it != threads_.end() ? &it->second.ctx : nullptr;
+}
+
+SimulatedBackend::SimPage_t* SimulatedBackend::findPage(uintptr_t address) {
+    const uintptr_t base = pageBase(address);
+    if (base == lastPageBase_) return lastPage_;
+
+    auto it = pages_.find(base);
+    if (it == pages_.end()) return nullptr;
+    lastPageBase_ = base;
+    lastPage_ = it->second.get();
+    return lastPage_;
+}
+
+const SimulatedBackend::SimPage_t* SimulatedBackend::lookupPage(uintptr_t address) const {
+    auto it = pages_.find(pageBase(address));
+    return it != pages_.end() ? it->second.get() : nullptr;
+}
+
+SimulatedBackend::SimThread_t* SimulatedBackend::findThread(HANDLE hThread) {
+    auto it = threads_.find(toTid(hThread));
+    return it != threads_.end() ? &it->second : nullptr;
+}
+
+// ==================================================
+// LIFECYCLE
+// ==================================================
+
+void SimulatedBackend::makeCreateProcessEvent(DebugEvent_t& event) {
+    event = DebugEvent_t{};
+    event.type         = DebugEventType::CREATE_PROCESS;
+    event.processId    = pid_;
+    event.threadId     = MAIN_THREAD_ID;
+    event.imageBase    = imageBase_;
+    event.imageName    = imageBase_;
+    event.hThread      = toHandle(MAIN_THREAD_ID);
+    event.startAddress = entryPoint_;
+}
+
+bool SimulatedBackend::start(const std::string& exeName, const std::vector<std::string>& /*args*/) {
+    if (running_) {
+        std::cerr << "[-] Simulated target is already running" << std::endl;
+        return false;
+    }
+    if (!exeName.empty()) imageName_ = exeName;
+
+    SimThread_t main;
+    main.ctx.ip = entryPoint_;
+    main.ctx.segCs = 0x33;
+    main.ctx.segSs = 0x2B;
+    main.ctx.flags = 0x202;
+    threads_[MAIN_THREAD_ID] = main;
+    modules_[imageBase_] = SimModule_t{ imageName_, entryPoint_ };
+
+    running_ = true;
+    exited_  = false;
+    cursor_  = 0;
+    pass_    = 0;
+
+    DebugEvent_t event;
+    makeCreateProcessEvent(event);
+    pending_.push_back(event);
+    return true;
+}
+
+bool SimulatedBackend::attach(DWORD pid) {
+    if (pid != pid_) {
+        std::cerr << "[-] Failed to attach to process: no simulated process " << pid << std::endl;
+        return false;
+    }
+    return start(std::string(), {});
+}
+
+bool SimulatedBackend::detach() {
+    running_ = false;
+    pending_.clear();
+    return true;
+}
+
+bool SimulatedBackend::terminate(DWORD exitCode) {
+    if (!running_) return false;
+    exitCode_ = exitCode;
+    cursor_   = script_.size();
+    pass_     = repeat_;
+    return true;
+}
+
+void SimulatedBackend::close() {
+    running_ = false;
+    pending_.clear();
+}
+
+DWORD SimulatedBackend::findProcessId(const std::string& exeName) {
+    return exeName == imageName_ ? pid_ : 0;
+}
+
+// ==================================================
+// EVENTS
+// ==================================================
+
+void SimulatedBackend::makeException(DebugEvent_t& event, DWORD threadId, DWORD code, uintptr_t address) {
+    event = DebugEvent_t{};
+    event.type             = DebugEventType::EXCEPTION;
+    event.processId        = pid_;
+    event.threadId         = threadId;
+    event.exceptionCode    = code;
+    event.exceptionAddress = address;
+}
+
+bool SimulatedBackend::stepExecute(const SimEvent_t& step, SimThread_t& thread, DebugEvent_t& event) {
+    ThreadContext_t& ctx = thread.ctx;
+    const uintptr_t address = step.address;
+    ctx.ip = address;
+
+    // Execute breakpoints fire before the instruction, unless RF is set
+    if (!thread.resumeFlag) {
+        const DWORD64 dr7 = ctx.dr[7];
+        for (int i = 0; i < 4; ++i) {
+            if (!(dr7 & (1ULL << (i * 2)))) continue;
+            if (((dr7 >> (16 + i * 4)) & 0b11) != 0) continue; // not an execute breakpoint
+            if (ctx.dr[i] != address) continue;
+
+            ctx.dr[6] = 1ULL << i;
+            thread.resumeFlag = true;
+            thread.replay = true;
+            thread.replayAddress = address;
+            thread.replayLength = step.length;
+            ++stats_.hardwareBreakpoints;
+            makeException(event, step.threadId, EXCEPTION_SINGLE_STEP, address);
+            return true;
+        }
+    }
+    thread.resumeFlag = false;
+
+    SimPage_t* page = findPage(address);
+    if (!page) {
+        makeException(event, step.threadId, EXCEPTION_ACCESS_VIOLATION, address);
+        event.exceptionInfo[0] = 8; // DEP / execute
+        event.exceptionInfo[1] = address;
+        return true;
+    }
+
+    if (page->data[address & (PAGE_SIZE_SIM - 1)] == 0xCC) {
+        ctx.ip = address + 1;
+        thread.replay = true;
+        thread.replayAddress = address;
+        thread.replayLength = step.length;
+        ++stats_.breakpoints;
+        makeException(event, step.threadId, EXCEPTION_BREAKPOINT, address);
+        return true;
+    }
+
+    // Retire
+    ctx.ip = address + step.length;
+    ++stats_.instructions;
+
+    if (ctx.flags & TRAP_FLAG) {
+        ctx.flags &= ~TRAP_FLAG;
+        ctx.dr[6] = DR6_BS;
+        ++stats_.singleSteps;
+        makeException(event, step.threadId, EXCEPTION_SINGLE_STEP, static_cast<uintptr_t>(ctx.ip));
+        return true;
+    }
+    return false;
+}
+
+bool SimulatedBackend::stepReplay(DWORD threadId, SimThread_t& thread, DebugEvent_t& event) {
+    thread.replay = false;
+    return stepExecute(SimEvent_t::execute(threadId, thread.replayAddress, thread.replayLength), thread, event);
+}
+
+void SimulatedBackend::dropReplay(SimThread_t& thread) {
+    thread.replay = false;
+
+    // The debugger moved the IP away. Code in allocated memory is a displaced copy of the stopped
+    // instruction that jumps back behind it; anything else skips the instruction.
+    if (isAllocated(thread.ctx.ip)) {
+        ++stats_.instructions;
+        ++stats_.displacedSteps;
+    }
+}
+
+bool SimulatedBackend::stepAccess(const SimEvent_t& step, SimThread_t& thread, DebugEvent_t& event) {
+    ThreadContext_t& ctx = thread.ctx;
+    const bool write = step.value != 0;
+
+    // Data breakpoints trap after the access
+    const DWORD64 dr7 = ctx.dr[7];
+    for (int i = 0; i < 4; ++i) {
+        if (!(dr7 & (1ULL << (i * 2)))) continue;
+        const int rw = static_cast<int>((dr7 >> (16 + i * 4)) & 0b11);
+        if (rw == 0 || rw == 2) continue;   // execute / I/O
+        if (rw == 1 && !write) continue;    // write only
+
+        const SIZE_T len = DR7_LEN_BYTES[(dr7 >> (18 + i * 4)) & 0b11];
+        const uintptr_t bpStart = static_cast<uintptr_t>(ctx.dr[i]);
+        if (step.address >= bpStart + len || bpStart >= step.address + step.length) continue;
+
+        ctx.dr[6] = 1ULL << i;
+        ++stats_.hardwareBreakpoints;
+        makeException(event, step.threadId, EXCEPTION_SINGLE_STEP, static_cast<uintptr_t>(ctx.ip));
+        return true;
+    }
+    return false;
+}
+
+bool SimulatedBackend::step(const SimEvent_t& step, DebugEvent_t& event) {
+    switch (step.type) {
+        case SimEventType::EXECUTE:
+        case SimEventType::ACCESS: {
+            auto it = threads_.find(step.threadId);
+            if (it == threads_.end()) {
+                ++cursor_; // thread does not exist (yet / anymore)
+                return false;
+            }
+
+            // The stopped instruction runs first; unless the debugger rewound the IP the int3
+            // counts as the executed instruction. The scheduled step stays for the next turn.
+            SimThread_t& thread = it->second;
+            if (thread.replay) {
+                if (thread.ctx.ip == thread.replayAddress) return stepReplay(step.threadId, thread, event);
+                dropReplay(thread);
+            }
+
+            ++cursor_;
+            return step.type == SimEventType::EXECUTE ? stepExecute(step, thread, event)
+                                                      : stepAccess(step, thread, event);
+        }
+
+        case SimEventType::CREATE_THREAD: {
+            SimThread_t thread;
+            thread.ctx.ip = step.address;
+            thread.ctx.segCs = 0x33;
+            thread.ctx.segSs = 0x2B;
+            thread.ctx.flags = 0x202;
+            threads_[step.threadId] = thread;
+
+            event = DebugEvent_t{};
+            event.type         = DebugEventType::CREATE_THREAD;
+            event.hThread      = toHandle(step.threadId);
+            event.threadBase   = 0x7FFE0000ULL + static_cast<uintptr_t>(step.threadId) * 0x2000;
+            event.startAddress = step.address;
+            break;
+        }
+
+        case SimEventType::EXIT_THREAD:
+            threads_.erase(step.threadId);
+            event = DebugEvent_t{};
+            event.type     = DebugEventType::EXIT_THREAD;
+            event.exitCode = static_cast<DWORD>(step.value);
+            break;
+
+        case SimEventType::LOAD_DLL:
+            modules_[step.address] = SimModule_t{ step.text, static_cast<uintptr_t>(step.value) };
+            event = DebugEvent_t{};
+            event.type      = DebugEventType::LOAD_DLL;
+            event.imageBase = step.address;
+            event.imageName = step.address;
+            break;
+
+        case SimEventType::UNLOAD_DLL:
+            event = DebugEvent_t{};
+            event.type      = DebugEventType::UNLOAD_DLL;
+            event.imageBase = step.address;
+            event.imageName = step.address;
+            break;
+
+        case SimEventType::DEBUG_STRING:
+            event = DebugEvent_t{};
+            event.type              = DebugEventType::DEBUG_STRING;
+            event.debugString       = cursor_; // index into the script
+            event.debugStringLength = static_cast<DWORD>(step.text.size());
+            break;
+
+        case SimEventType::EXCEPTION:
+            event = DebugEvent_t{};
+            event.type             = DebugEventType::EXCEPTION;
+            event.exceptionCode    = static_cast<DWORD>(step.value);
+            event.exceptionAddress = step.address;
+            break;
+
+        case SimEventType::EXIT_PROCESS:
+            cursor_ = script_.size();
+            pass_   = repeat_;
+            exitCode_ = static_cast<DWORD>(step.value);
+            return false;
+    }
+
+    event.processId = pid_;
+    event.threadId  = step.threadId;
+    ++cursor_;
+    return true;
+}
+
+bool SimulatedBackend::flushReplays(DebugEvent_t& event) {
+    for (auto& [tid, thread] : threads_) {
+        if (!thread.replay) continue;
+        if (thread.ctx.ip != thread.replayAddress) {
+            dropReplay(thread);
+            continue;
+        }
+        if (stepReplay(tid, thread, event)) return true;
+    }
+    return false;
+}
+
+void SimulatedBackend::runConcurrentSteps(DWORD stoppedThreadId) {
+    std::vector<DWORD> stopped = { stoppedThreadId };
+    while (cursor_ < script_.size() && script_[cursor_].concurrent) {
+        const SimEvent_t& next = script_[cursor_];
+        // A thread that already stopped in this quantum cannot run on
+        if (std::find(stopped.begin(), stopped.end(), next.threadId) != stopped.end()) break;
+
+        DebugEvent_t event;
+        if (step(next, event)) {
+            pending_.push_back(event);
+            stopped.push_back(next.threadId);
+        }
+    }
+}
+
+bool SimulatedBackend::waitForEvent(DebugEvent_t& event, DWORD /*timeoutMs*/) {
+    if (!running_) return false;
+
+    if (!pending_.empty()) {
+        event = pending_.front();
+        pending_.pop_front();
+        ++stats_.events;
+        return true;
+    }
+    if (exited_) return false;
+
+    for (;;) {
+        if (cursor_ >= script_.size()) {
+            if (pass_ < repeat_ && flushReplays(event)) {
+                ++stats_.events;
+                return true;
+            }
+            if (++pass_ < repeat_ && !script_.empty()) {
+                cursor_ = 0;
+                continue;
+            }
+
+            event = DebugEvent_t{};
+            event.type      = DebugEventType::EXIT_PROCESS;
+            event.processId = pid_;
+            event.threadId  = MAIN_THREAD_ID;
+            event.exitCode  = exitCode_;
+            exited_ = true;
+            ++stats_.events;
+            return true;
+        }
+
+        if (step(script_[cursor_], event)) {
+            runConcurrentSteps(event.threadId);
+            ++stats_.events;
+            return true;
+        }
+    }
+}
+
+bool SimulatedBackend::continueEvent(const DebugEvent_t& event, bool handled) {
+    if (!handled && event.type == DebugEventType::EXCEPTION) {
+        ++stats_.unhandled;
+    }
+    return running_;
+}
+
+std::string SimulatedBackend::getModuleName(const DebugEvent_t& event) {
+    ++stats_.payloadReads;
+    RemoteScope call(*this, RemoteCall::EVENT_PAYLOAD);
+    auto it = modules_.find(event.imageName);
+    return it != modules_.end() ? it->second.name : std::string("<unknown>");
+}
+
+std::string SimulatedBackend::getDebugString(const DebugEvent_t& event) {
+    ++stats_.payloadReads;
+    RemoteScope call(*this, RemoteCall::EVENT_PAYLOAD);
+    if (event.debugString >= script_.size()) return std::string();
+    return script_[event.debugString].text;
+}
+
+uintptr_t SimulatedBackend::getEntryPoint(uintptr_t imageBase) {
+    ++stats_.payloadReads;
+    RemoteScope call(*this, RemoteCall::EVENT_PAYLOAD);
+    auto it = modules_.find(imageBase);
+    return it != modules_.end() ? it->second.entryPoint : 0;
+}
+
+// ==================================================
+// MEMORY
+// ==================================================
+
+bool SimulatedBackend::readMemory(uintptr_t address, void* buffer, SIZE_T size, SIZE_T* bytesRead) {
+    std::atomic_ref<uint64_t>(stats_.memoryReads).fetch_add(1, std::memory_order_relaxed);
+    RemoteScope call(*this, RemoteCall::READ_MEMORY);
+    BYTE* out = static_cast<BYTE*>(buffer);
+    SIZE_T done = 0;
+
+    while (done < size) {
+        const SimPage_t* page = lookupPage(address + done);
+        if (!page) break;
+        const SIZE_T offset = (address + done) & (PAGE_SIZE_SIM - 1);
+        const SIZE_T chunk = std::min<SIZE_T>(size - done, PAGE_SIZE_SIM - offset);
+        std::memcpy(out + done, page->data.data() + offset, chunk);
+        done += chunk;
+    }
+
+    call.setBytes(done);
+    if (bytesRead) *bytesRead = done;
+    return done == size;
+}
+
+bool SimulatedBackend::writeMemory(uintptr_t address, const void* buffer, SIZE_T size) {
+    ++stats_.memoryWrites;
+    RemoteScope call(*this, RemoteCall::WRITE_MEMORY);
+    const BYTE* in = static_cast<const BYTE*>(buffer);
+
+    // All or nothing, like WriteProcessMemory on a range crossing into unmapped memory
+    for (uintptr_t page = pageBase(address); page < address + size; page += PAGE_SIZE_SIM) {
+        if (!findPage(page)) return false;
+    }
+    call.setBytes(size);
+
+    SIZE_T done = 0;
+    while (done < size) {
+        SimPage_t* page = findPage(address + done);
+        const SIZE_T offset = (address + done) & (PAGE_SIZE_SIM - 1);
+        const SIZE_T chunk = std::min<SIZE_T>(size - done, PAGE_SIZE_SIM - offset);
+        std::memcpy(page->data.data() + offset, in + done, chunk);
+        done += chunk;
+    }
+    return true;
+}
+
+bool SimulatedBackend::flushInstructionCache(uintptr_t /*address*/, SIZE_T /*size*/) {
+    RemoteScope call(*this, RemoteCall::FLUSH_INSTRUCTION_CACHE);
+    return true;
+}
+
+bool SimulatedBackend::protectMemory(uintptr_t address, SIZE_T size, DWORD newProtect, DWORD* oldProtect) {
+    RemoteScope call(*this, RemoteCall::PROTECT_MEMORY);
+    for (uintptr_t page = pageBase(address); page < address + size; page += PAGE_SIZE_SIM) {
+        if (!findPage(page)) return false;
+    }
+
+    bool first = true;
+    for (uintptr_t page = pageBase(address); page < address + size; page += PAGE_SIZE_SIM) {
+        SimPage_t* p = findPage(page);
+        if (first && oldProtect) *oldProtect = p->protect;
+        first = false;
+        p->protect = newProtect;
+    }
+    return true;
+}
+
+uintptr_t SimulatedBackend::allocateMemory(uintptr_t address, SIZE_T size, DWORD protect) {
+    const SIZE_T bytes = (size + PAGE_SIZE_SIM - 1) & ~(PAGE_SIZE_SIM - 1);
+    if (bytes == 0) return 0;
+
+    auto isFree = [this, bytes](uintptr_t base) {
+        for (uintptr_t page = base; page < base + bytes; page += PAGE_SIZE_SIM) {
+            if (findPage(page)) return false;
+        }
+        return true;
+    };
+
+    // First free range at or above the preferred address
+    uintptr_t base = pageBase(address ? address : ALLOCATION_BASE);
+    while (!isFree(base)) base += PAGE_SIZE_SIM;
+
+    RemoteScope call(*this, RemoteCall::ALLOCATE_MEMORY);
+    mapMemory(base, bytes, protect, 0x00);
+    allocations_[base] = bytes;
+    return base;
+}
+
+bool SimulatedBackend::freeMemory(uintptr_t address, SIZE_T /*size*/) {
+    RemoteScope call(*this, RemoteCall::FREE_MEMORY);
+    auto it = allocations_.find(address);
+    if (it == allocations_.end()) return false;
+    unmapMemory(address, it->second);
+    allocations_.erase(it);
+    return true;
+}
+
+bool SimulatedBackend::isAllocated(uintptr_t address) const {
+    auto it = allocations_.upper_bound(address);
+    if (it == allocations_.begin()) return false;
+    --it;
+    return address < it->first + it->second;
+}
+
+std::vector<MemoryRegion_t> SimulatedBackend::getMemoryRegions() {
+    ++stats_.regionQueries;
+    RemoteScope call(*this, RemoteCall::QUERY_MEMORY);
+    std::vector<uintptr_t> bases;
+    bases.reserve(pages_.size());
+    for (const auto& [base, page] : pages_) bases.push_back(base);
+    std::sort(bases.begin(), bases.end());
+
+    // Coalesce adjacent pages with equal protection
+    std::vector<MemoryRegion_t> regions;
+    for (uintptr_t base : bases) {
+        const DWORD protect = pages_[base]->protect;
+        if (!regions.empty()) {
+            MemoryRegion_t& last = regions.back();
+            const uintptr_t lastEnd = reinterpret_cast<uintptr_t>(last.BaseAddress) + last.RegionSize;
+            if (lastEnd == base && last.Protect == protect) {
+                last.RegionSize += PAGE_SIZE_SIM;
+                continue;
+            }
+        }
+        regions.push_back(MemoryRegion_t{ reinterpret_cast<LPVOID>(base), PAGE_SIZE_SIM, MEM_COMMIT, protect, MEM_PRIVATE });
+    }
+    return regions;
+}
+
+// ==================================================
+// THREADS
+// ==================================================
+
+std::vector<DWORD> SimulatedBackend::enumerateThreads() {
+    std::vector<DWORD> tids;
+    tids.reserve(threads_.size());
+    for (const auto& [tid, thread] : threads_) tids.push_back(tid);
+    return tids;
+}
+
+HANDLE SimulatedBackend::openThread(DWORD threadId) {
+    if (!threads_.count(threadId)) return nullptr;
+    ++stats_.threadOpens;
+    RemoteScope call(*this, RemoteCall::OPEN_THREAD);
+    return toHandle(threadId);
+}
+
+void SimulatedBackend::closeThread(HANDLE hThread) {
+    if (hThread) ++stats_.threadCloses;
+}
+
+bool SimulatedBackend::suspendThread(HANDLE hThread) {
+    RemoteScope call(*this, RemoteCall::SUSPEND_THREAD);
+    SimThread_t* thread = findThread(hThread);
+    if (!thread) return false;
+    ++thread->suspendCount;
+    return true;
+}
+
+bool SimulatedBackend::resumeThread(HANDLE hThread) {
+    RemoteScope call(*this, RemoteCall::RESUME_THREAD);
+    SimThread_t* thread = findThread(hThread);
+    if (!thread) return false;
+    if (thread->suspendCount > 0) --thread->suspendCount;
+    return true;
+}
+
+bool SimulatedBackend::getContext(HANDLE hThread, ThreadContext_t& ctx, DWORD parts) {
+    ++stats_.contextReads;
+    RemoteScope call(*this, RemoteCall::GET_CONTEXT);
+    SimThread_t* thread = findThread(hThread);
+    if (!thread) {
+        if (verbose_) std::cerr << "[-] GetThreadContext failed: no thread " << toTid(hThread) << "\n";
+        return false;
+    }
+    copyContext(ctx, thread->ctx, parts);
+    return true;
+}
+
+bool SimulatedBackend::setContext(HANDLE hThread, const ThreadContext_t& ctx, DWORD parts) {
+    ++stats_.contextWrites;
+    RemoteScope call(*this, RemoteCall::SET_CONTEXT);
+    SimThread_t* thread = findThread(hThread);
+    if (!thread) {
+        std::cerr << "[-] SetThreadContext failed: no thread " << toTid(hThread) << "\n";
+        return false;
+    }
+    copyContext(thread->ctx, ctx, parts);
+    return true;
+}
+
+// ==================================================
+// MISC
+// ==================================================
+
+bool SimulatedBackend::hideDebugger() {
+    return true;
+}
+
+} // namespace RoboDBG
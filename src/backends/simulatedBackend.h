@@ -0,0 +1,298 @@
+/**
+ * @file simulatedBackend.h
+ * @brief Deterministic in-memory TargetBackend for tests and benchmarks
+ * @author Milkshake
+ */
+
+#ifndef SIMULATEDBACKEND_H
+#define SIMULATEDBACKEND_H
+
+#include "targetBackend.h"
+
+#include <array>
+#include <deque>
+#include <map>
+#include <unordered_map>
+
+namespace RoboDBG {
+
+    /**
+     * @enum SimEventType
+     * @brief Kind of a scripted step in a simulated target.
+     */
+    enum class SimEventType {
+        EXECUTE,        ///< Thread executes the instruction at address (length bytes).
+        ACCESS,         ///< Thread reads (value == 0) or writes (value != 0) length bytes at address.
+        CREATE_THREAD,  ///< New thread starting at address.
+        EXIT_THREAD,    ///< Thread exits with exit code value.
+        LOAD_DLL,       ///< Module text mapped at address; value is the entry point.
+        UNLOAD_DLL,     ///< Module at address unmapped.
+        DEBUG_STRING,   ///< OutputDebugString(text).
+        EXCEPTION,      ///< Thread raises exception code value at address (not a breakpoint; nothing is stopped).
+        EXIT_PROCESS    ///< Process exits with exit code value.
+    };
+
+    /**
+     * @struct SimEvent_t
+     * @brief One step of the script a SimulatedBackend replays.
+     */
+    struct SimEvent_t {
+        SimEventType type = SimEventType::EXECUTE; ///< Step kind.
+        DWORD threadId = 0;                        ///< Thread performing the step.
+        uintptr_t address = 0;                     ///< Instruction / data / module / start address.
+        DWORD length = 1;                          ///< Instruction or access length in bytes.
+        uint64_t value = 0;                        ///< Exit code, entry point or write flag (see SimEventType).
+        std::string text;                          ///< Module name or debug string.
+        bool concurrent = false;                   ///< Runs in the same quantum as the step before it (see concurrently()).
+
+        /**
+         * @brief Marks the step as running before the debugger has handled the previous step's event.
+         *
+         * Events raised by a chain of concurrent steps are queued and reported one after another
+         * without resuming the target in between, like threads hitting the same int3 on several cores.
+         */
+        SimEvent_t concurrently() const {
+            SimEvent_t e = *this;
+            e.concurrent = true;
+            return e;
+        }
+
+        static SimEvent_t execute(DWORD tid, uintptr_t address, DWORD length = 1) {
+            return { SimEventType::EXECUTE, tid, address, length, 0, {} };
+        }
+        static SimEvent_t access(DWORD tid, uintptr_t address, DWORD length, bool write) {
+            return { SimEventType::ACCESS, tid, address, length, write ? 1u : 0u, {} };
+        }
+        static SimEvent_t createThread(DWORD tid, uintptr_t startAddress) {
+            return { SimEventType::CREATE_THREAD, tid, startAddress, 0, 0, {} };
+        }
+        static SimEvent_t exitThread(DWORD tid, DWORD exitCode = 0) {
+            return { SimEventType::EXIT_THREAD, tid, 0, 0, exitCode, {} };
+        }
+        static SimEvent_t loadDll(uintptr_t base, std::string name, uintptr_t entryPoint = 0) {
+            return { SimEventType::LOAD_DLL, 0, base, 0, entryPoint, std::move(name) };
+        }
+        static SimEvent_t unloadDll(uintptr_t base) {
+            return { SimEventType::UNLOAD_DLL, 0, base, 0, 0, {} };
+        }
+        static SimEvent_t debugString(DWORD tid, std::string text) {
+            return { SimEventType::DEBUG_STRING, tid, 0, 0, 0, std::move(text) };
+        }
+        static SimEvent_t raise(DWORD tid, uintptr_t address, DWORD code) {
+            return { SimEventType::EXCEPTION, tid, address, 0, code, {} };
+        }
+        static SimEvent_t exitProcess(DWORD exitCode) {
+            return { SimEventType::EXIT_PROCESS, 0, 0, 0, exitCode, {} };
+        }
+    };
+
+    /**
+     * @struct SimStats_t
+     * @brief Counters collected while a script is replayed. Identical scripts give identical counters.
+     */
+    struct SimStats_t {
+        uint64_t events = 0;             ///< Debug events reported to the debugger.
+        uint64_t instructions = 0;       ///< EXECUTE steps retired.
+        uint64_t breakpoints = 0;        ///< int3 hits.
+        uint64_t singleSteps = 0;        ///< Trap flag single-steps.
+        uint64_t hardwareBreakpoints = 0;///< Debug register hits.
+        uint64_t displacedSteps = 0;     ///< Stopped instructions run from allocated memory (displaced stepping).
+        uint64_t unhandled = 0;          ///< Exceptions continued as not handled.
+        uint64_t memoryReads = 0;        ///< readMemory calls.
+        uint64_t memoryWrites = 0;       ///< writeMemory calls.
+        uint64_t payloadReads = 0;       ///< getModuleName / getEntryPoint / getDebugString calls (remote reads on a real target).
+        uint64_t regionQueries = 0;      ///< getMemoryRegions / queryMemoryRegions calls.
+        uint64_t contextReads = 0;       ///< getContext calls.
+        uint64_t contextWrites = 0;      ///< setContext calls.
+        uint64_t threadOpens = 0;        ///< Successful openThread calls.
+        uint64_t threadCloses = 0;       ///< closeThread calls.
+    };
+
+/**
+ * @class SimulatedBackend
+ * @brief Synthetic debuggee: sparse page map, thread table with register files and a scripted event stream.
+ *
+ * Nothing runs natively. Each EXECUTE step checks the simulated CPU state the way x86 would:
+ * execute debug registers first (honouring RF), then an int3 byte at the address, then retires the
+ * instruction and raises a trap if TF is set. An instruction stopped by an int3 or an execute debug
+ * register is replayed at the thread's next step if the debugger left the instruction pointer on
+ * it, so the Debugger's RESTORE / SINGLE_STEP state machine does exactly the work it does against
+ * a real target. If the debugger moved the instruction pointer into memory from allocateMemory(),
+ * the instruction counts as executed there (displaced stepping). Other threads' steps may run in
+ * between, and steps marked concurrent run before the debugger sees the pending event. When the
+ * script (and its repeats) is exhausted, pending replays are flushed and an EXIT_PROCESS event is
+ * reported.
+ *
+ * Thread handles are the thread IDs. The initial thread has ID 1.
+ * readMemory() may run on several threads at once (parallel scans) while nothing maps or writes memory.
+ */
+class SimulatedBackend : public TargetBackend {
+public:
+    static constexpr SIZE_T PAGE_SIZE_SIM = 0x1000; ///< Page granularity of the simulated address space.
+    static constexpr DWORD MAIN_THREAD_ID = 1;      ///< ID of the initial thread.
+    static constexpr uintptr_t ALLOCATION_BASE = 0x10000000; ///< Where allocateMemory() starts without a preferred address.
+
+    explicit SimulatedBackend(bool verbose = false);
+    ~SimulatedBackend() override;
+
+    // ===== Setup =====
+
+    /**
+     * @brief Sets the main image reported with CREATE_PROCESS.
+     * @param name Image name (also matched by findProcessId()).
+     * @param imageBase Image base.
+     * @param entryPoint Entry point; the main thread starts there.
+     */
+    void setImage(const std::string& name, uintptr_t imageBase, uintptr_t entryPoint);
+
+    /**
+     * @brief Maps zero-filled or pattern-filled pages. Existing pages keep their contents.
+     * @param address Start address (rounded down to a page).
+     * @param size Number of bytes (rounded up to pages).
+     * @param protect PAGE_* flags.
+     * @param fill Initial byte value of new pages.
+     */
+    void mapMemory(uintptr_t address, SIZE_T size, DWORD protect = PAGE_EXECUTE_READWRITE, BYTE fill = 0x90);
+
+    /**
+     * @brief Unmaps pages.
+     * @param address Start address (rounded down to a page).
+     * @param size Number of bytes (rounded up to pages).
+     */
+    void unmapMemory(uintptr_t address, SIZE_T size);
+
+    /**
+     * @brief Sets the script to replay.
+     * @param script Steps.
+     * @param repeat Number of passes over the script before the process exits.
+     * @param exitCode Exit code reported after the last pass.
+     */
+    void setScript(std::vector<SimEvent_t> script, size_t repeat = 1, DWORD exitCode = 0);
+
+    /**
+     * @brief Returns the replay counters.
+     */
+    const SimStats_t& getStats() const { return stats_; }
+
+    /**
+     * @brief Direct access to a simulated thread's registers (for test setup and checks).
+     * @param threadId Thread ID.
+     * @return Pointer to the register file, or nullptr if the thread does not exist.
+     */
+    ThreadContext_t* threadContext(DWORD threadId);
+
+    // ===== TargetBackend =====
+
+    bool start(const std::string& exeName, const std::vector<std::string>& args) override;
+    bool attach(DWORD pid) override;
+    bool detach() override;
+    bool terminate(DWORD exitCode) override;
+    void close() override;
+    DWORD findProcessId(const std::string& exeName) override;
+    DWORD getProcessId() const override { return pid_; }
+    HANDLE getProcessHandle() const override { return toHandle(pid_); }
+    HANDLE getMainThreadHandle() const override { return toHandle(MAIN_THREAD_ID); }
+
+    bool waitForEvent(DebugEvent_t& event, DWORD timeoutMs) override;
+    bool continueEvent(const DebugEvent_t& event, bool handled) override;
+    std::string getModuleName(const DebugEvent_t& event) override;
+    std::string getDebugString(const DebugEvent_t& event) override;
+    uintptr_t getEntryPoint(uintptr_t imageBase) override;
+
+    bool readMemory(uintptr_t address, void* buffer, SIZE_T size, SIZE_T* bytesRead = nullptr) override;
+    bool writeMemory(uintptr_t address, const void* buffer, SIZE_T size) override;
+    bool flushInstructionCache(uintptr_t address, SIZE_T size) override;
+    bool protectMemory(uintptr_t address, SIZE_T size, DWORD newProtect, DWORD* oldProtect) override;
+    uintptr_t allocateMemory(uintptr_t address, SIZE_T size, DWORD protect) override;
+    bool freeMemory(uintptr_t address, SIZE_T size) override;
+    std::vector<MemoryRegion_t> getMemoryRegions() override;
+
+    std::vector<DWORD> enumerateThreads() override;
+    HANDLE openThread(DWORD threadId) override;
+    void closeThread(HANDLE hThread) override;
+    bool suspendThread(HANDLE hThread) override;
+    bool resumeThread(HANDLE hThread) override;
+    bool getContext(HANDLE hThread, ThreadContext_t& ctx, DWORD parts) override;
+    bool setContext(HANDLE hThread, const ThreadContext_t& ctx, DWORD parts) override;
+
+    bool hideDebugger() override;
+
+private:
+    /**
+     * @struct SimPage_t
+     * @brief One page of simulated memory.
+     */
+    struct SimPage_t {
+        std::array<BYTE, PAGE_SIZE_SIM> data; ///< Page contents.
+        DWORD protect;                        ///< PAGE_* flags.
+    };
+
+    /**
+     * @struct SimThread_t
+     * @brief One simulated thread.
+     */
+    struct SimThread_t {
+        ThreadContext_t ctx;        ///< Register file.
+        DWORD suspendCount = 0;     ///< SuspendThread nesting.
+        bool resumeFlag = false;    ///< RF: skip execute debug registers once.
+        bool replay = false;        ///< An int3 / execute DR stopped the instruction at replayAddress.
+        uintptr_t replayAddress = 0;///< Stopped instruction.
+        DWORD replayLength = 1;     ///< Its length.
+    };
+
+    /**
+     * @struct SimModule_t
+     * @brief Module known to the simulated loader.
+     */
+    struct SimModule_t {
+        std::string name;       ///< File name.
+        uintptr_t entryPoint;   ///< Entry point.
+    };
+
+    static HANDLE toHandle(DWORD id) { return reinterpret_cast<HANDLE>(static_cast<uintptr_t>(id)); }
+    static DWORD toTid(HANDLE hThread) { return static_cast<DWORD>(reinterpret_cast<uintptr_t>(hThread)); }
+
+    SimPage_t* findPage(uintptr_t address);
+    const SimPage_t* lookupPage(uintptr_t address) const; // findPage() without the last-page cache, for concurrent readers
+    SimThread_t* findThread(HANDLE hThread);
+    bool step(const SimEvent_t& step, DebugEvent_t& event);
+    bool stepReplay(DWORD threadId, SimThread_t& thread, DebugEvent_t& event);
+    void dropReplay(SimThread_t& thread);
+    bool isAllocated(uintptr_t address) const;
+    bool flushReplays(DebugEvent_t& event);
+    void runConcurrentSteps(DWORD stoppedThreadId);
+    bool stepExecute(const SimEvent_t& step, SimThread_t& thread, DebugEvent_t& event);
+    bool stepAccess(const SimEvent_t& step, SimThread_t& thread, DebugEvent_t& event);
+    void makeException(DebugEvent_t& event, DWORD threadId, DWORD code, uintptr_t address);
+    void makeCreateProcessEvent(DebugEvent_t& event);
+
+    bool verbose_;
+    DWORD pid_ = 0x1000;
+    bool running_ = false;
+    bool exited_ = false;
+
+    std::string imageName_ = "simulated.exe";
+    uintptr_t imageBase_ = 0x0000000140000000ULL;
+    uintptr_t entryPoint_ = 0x0000000140001000ULL;
+
+    std::unordered_map<uintptr_t, std::unique_ptr<SimPage_t>> pages_;
+    uintptr_t lastPageBase_ = ~uintptr_t(0);
+    SimPage_t* lastPage_ = nullptr;
+
+    std::map<DWORD, SimThread_t> threads_;
+    std::map<uintptr_t, SimModule_t> modules_;
+    std::map<uintptr_t, SIZE_T> allocations_;
+
+    std::vector<SimEvent_t> script_;
+    size_t cursor_ = 0;
+    size_t pass_ = 0;
+    size_t repeat_ = 1;
+    DWORD exitCode_ = 0;
+    std::deque<DebugEvent_t> pending_;
+
+    SimStats_t stats_;
+};
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,79 @@
+#include "targetBackend.h"
+#include "backends.h"
+
+#include <algorithm>
+
+namespace RoboDBG {
+
+const char* remoteCallName(RemoteCall call)
+{
+    switch (call) {
+        case RemoteCall::READ_MEMORY:             return "read_memory";
+        case RemoteCall::WRITE_MEMORY:            return "write_memory";
+        case RemoteCall::FLUSH_INSTRUCTION_CACHE: return "flush_instruction_cache";
+        case RemoteCall::PROTECT_MEMORY:          return "protect_memory";
+        case RemoteCall::ALLOCATE_MEMORY:         return "allocate_memory";
+        case RemoteCall::FREE_MEMORY:             return "free_memory";
+        case RemoteCall::QUERY_MEMORY:            return "query_memory";
+        case RemoteCall::OPEN_THREAD:             return "open_thread";
+        case RemoteCall::SUSPEND_THREAD:          return "suspend_thread";
+        case RemoteCall::RESUME_THREAD:           return "resume_thread";
+        case RemoteCall::GET_CONTEXT:             return "get_context";
+        case RemoteCall::SET_CONTEXT:             return "set_context";
+        case RemoteCall::EVENT_PAYLOAD:           return "event_payload";
+        default:                                  return "unknown";
+    }
+}
+
+RemoteCallStats_t RemoteCounters_t::snapshot() const
+{
+    RemoteCallStats_t out;
+    for (size_t i = 0; i < REMOTE_CALL_COUNT; ++i) {
+        out.calls[i] = calls[i].load(std::memory_order_relaxed);
+        out.bytes[i] = bytes[i].load(std::memory_order_relaxed);
+    }
+    return out;
+}
+
+void RemoteCounters_t::reset()
+{
+    for (size_t i = 0; i < REMOTE_CALL_COUNT; ++i) {
+        calls[i].store(0, std::memory_order_relaxed);
+        bytes[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t TargetBackend::readMemoryScatter(MemoryIo_t* ios, size_t count)
+{
+    size_t complete = 0;
+    for (size_t i = 0; i < count; ++i) {
+        SIZE_T bytesRead = 0;
+        readMemory(ios[i].address, ios[i].buffer, ios[i].size, &bytesRead);
+        ios[i].transferred = bytesRead;
+        if (bytesRead == ios[i].size) ++complete;
+    }
+    return complete;
+}
+
+std::vector<MemoryRegion_t> TargetBackend::queryMemoryRegions(uintptr_t address, SIZE_T size)
+{
+    std::vector<MemoryRegion_t> regions = getMemoryRegions();
+    regions.erase(std::remove_if(regions.begin(), regions.end(), [&](const MemoryRegion_t& r) {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(r.BaseAddress);
+        return base + r.RegionSize <= address || base >= address + size;
+    }), regions.end());
+    return regions;
+}
+
+std::unique_ptr<TargetBackend> createNativeBackend(bool verbose)
+{
+#if defined(_WIN32)
+    return std::make_unique<Win32Backend>(verbose);
+#elif defined(__linux__)
+    return std::make_unique<PtraceBackend>(verbose);
+#else
+    #error "No native debugging backend for this platform"
+#endif
+}
+
+}
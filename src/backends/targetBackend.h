@@ -0,0 +1,484 @@
+/**
+ * @file targetBackend.h
+ * @brief OS abstraction the Debugger runs on top of (events, memory, threads and contexts)
+ * @author Milkshake
+ */
+
+#ifndef TARGETBACKEND_H
+#define TARGETBACKEND_H
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "../platform.h"
+#include "../traceRecorder.h"
+
+namespace RoboDBG {
+
+    /**
+     * @struct MemoryRegion_t
+     * @brief Represents a memory region in a process.
+     */
+    struct MemoryRegion_t {
+        LPVOID BaseAddress; ///< Base address of the memory region.
+        SIZE_T RegionSize;  ///< Size of the memory region in bytes.
+        DWORD State;        ///< State (MEM_COMMIT, MEM_FREE, MEM_RESERVE).
+        DWORD Protect;      ///< Protection flags (e.g., PAGE_READWRITE).
+        DWORD Type;         ///< Type (MEM_IMAGE, MEM_MAPPED, MEM_PRIVATE).
+    };
+
+    /**
+     * @enum DebugEventType
+     * @brief Kind of a debug event reported by a backend.
+     */
+    enum class DebugEventType {
+        CREATE_PROCESS, ///< Process was started or attached to.
+        EXIT_PROCESS,   ///< Process exited.
+        CREATE_THREAD,  ///< New thread.
+        EXIT_THREAD,    ///< Thread exited.
+        LOAD_DLL,       ///< Module mapped.
+        UNLOAD_DLL,     ///< Module unmapped.
+        EXCEPTION,      ///< Exception (breakpoint, single-step, access violation, ...).
+        DEBUG_STRING,   ///< OutputDebugString.
+        RIP_ERROR,      ///< RIP event.
+        UNKNOWN_EVENT   ///< Anything else; see DebugEvent_t::rawCode.
+    };
+
+    /**
+     * @struct DebugEvent_t
+     * @brief OS independent debug event. Only the fields belonging to @ref type are valid.
+     */
+    struct DebugEvent_t {
+        DebugEventType type = DebugEventType::UNKNOWN_EVENT; ///< Event kind.
+        DWORD processId = 0;            ///< Process the event belongs to.
+        DWORD threadId  = 0;            ///< Thread that reported the event.
+        DWORD rawCode   = 0;            ///< Native event code.
+
+        uintptr_t imageBase = 0;        ///< CREATE_PROCESS / LOAD_DLL / UNLOAD_DLL: module base.
+        uintptr_t imageName = 0;        ///< CREATE_PROCESS / LOAD_DLL: backend specific pointer to the module name.
+        bool unicode = false;           ///< LOAD_DLL / DEBUG_STRING: name/string is UTF-16.
+
+        HANDLE hThread = nullptr;       ///< CREATE_THREAD: backend owned handle of the new thread.
+        uintptr_t threadBase = 0;       ///< CREATE_THREAD: TEB / TLS base.
+        uintptr_t startAddress = 0;     ///< CREATE_THREAD: start address.
+
+        DWORD exitCode = 0;             ///< EXIT_PROCESS / EXIT_THREAD: exit code.
+
+        DWORD exceptionCode = 0;        ///< EXCEPTION: EXCEPTION_* code.
+        uintptr_t exceptionAddress = 0; ///< EXCEPTION: faulting instruction.
+        ULONG_PTR exceptionInfo[2] = {};///< EXCEPTION: access type / faulting address for access violations.
+        bool firstChance = true;        ///< EXCEPTION: first chance exception.
+
+        uintptr_t debugString = 0;      ///< DEBUG_STRING: remote string address.
+        DWORD debugStringLength = 0;    ///< DEBUG_STRING: length in characters.
+
+        RIP_INFO rip = {};              ///< RIP_ERROR: details.
+    };
+
+    /**
+     * @enum ContextFlags
+     * @brief Parts of a thread context to transfer.
+     */
+    enum ContextFlags : DWORD {
+        CONTEXT_PART_CONTROL = 1 << 0, ///< Instruction pointer, flags, stack pointer, frame pointer and code/stack segment.
+        CONTEXT_PART_INTEGER = 1 << 1, ///< General purpose registers.
+        CONTEXT_PART_DEBUG   = 1 << 2, ///< DR0-DR7.
+        CONTEXT_PART_ALL     = CONTEXT_PART_CONTROL | CONTEXT_PART_INTEGER | CONTEXT_PART_DEBUG
+    };
+
+    /**
+     * @struct ThreadContext_t
+     * @brief OS independent x86 / x86-64 register file.
+     *
+     * gpr[] is indexed like Register64 (RAX, RBX, RCX, RDX, RSI, RDI, RBP, RSP, R8-R15);
+     * the first eight entries line up with Register32.
+     */
+    struct ThreadContext_t {
+        DWORD64 gpr[16] = {}; ///< General purpose registers.
+        DWORD64 ip = 0;       ///< Instruction pointer.
+        DWORD64 flags = 0;    ///< (R/E)FLAGS.
+        DWORD segCs = 0;      ///< Code segment.
+        DWORD segSs = 0;      ///< Stack segment.
+        DWORD64 dr[8] = {};   ///< Debug registers DR0-DR7 (DR4/DR5 unused).
+    };
+
+    /**
+     * @struct MemoryIo_t
+     * @brief One element of a scatter/gather memory transfer.
+     */
+    struct MemoryIo_t {
+        uintptr_t address;       ///< Remote address.
+        void* buffer;            ///< Local buffer.
+        SIZE_T size;             ///< Number of bytes.
+        SIZE_T transferred = 0;  ///< Bytes actually transferred.
+    };
+
+    /**
+     * @enum RemoteCall
+     * @brief Target primitives counted while session metrics are on (see RemoteCounters_t).
+     */
+    enum class RemoteCall : uint8_t {
+        READ_MEMORY,             ///< ReadProcessMemory / process_vm_readv (bytes: bytes read).
+        WRITE_MEMORY,            ///< WriteProcessMemory / pwrite to /proc/pid/mem (bytes: bytes written).
+        FLUSH_INSTRUCTION_CACHE, ///< FlushInstructionCache.
+        PROTECT_MEMORY,          ///< VirtualProtectEx.
+        ALLOCATE_MEMORY,         ///< VirtualAllocEx / remote mmap.
+        FREE_MEMORY,             ///< VirtualFreeEx / remote munmap.
+        QUERY_MEMORY,            ///< VirtualQueryEx per region / one /proc/pid/maps read.
+        OPEN_THREAD,             ///< OpenThread.
+        SUSPEND_THREAD,          ///< SuspendThread.
+        RESUME_THREAD,           ///< ResumeThread.
+        GET_CONTEXT,             ///< GetThreadContext / PTRACE_GETREGS.
+        SET_CONTEXT,             ///< SetThreadContext / PTRACE_SETREGS.
+        EVENT_PAYLOAD,           ///< Module name, entry point or debug string of an event.
+        COUNT
+    };
+
+    constexpr size_t REMOTE_CALL_COUNT = static_cast<size_t>(RemoteCall::COUNT);
+
+    /**
+     * @brief Returns the name of a remote call ("read_memory", ...).
+     */
+    const char* remoteCallName(RemoteCall call);
+
+    /**
+     * @struct RemoteCallStats_t
+     * @brief Copy of RemoteCounters_t at one point in time.
+     */
+    struct RemoteCallStats_t {
+        uint64_t calls[REMOTE_CALL_COUNT] = {}; ///< Calls per RemoteCall.
+        uint64_t bytes[REMOTE_CALL_COUNT] = {}; ///< Bytes moved per RemoteCall (memory reads and writes).
+
+        inline uint64_t callsOf(RemoteCall call) const { return calls[static_cast<size_t>(call)]; }
+        inline uint64_t bytesOf(RemoteCall call) const { return bytes[static_cast<size_t>(call)]; }
+    };
+
+    /**
+     * @struct RemoteCounters_t
+     * @brief Call and byte counters a backend adds to; safe to update from scan worker threads.
+     */
+    struct RemoteCounters_t {
+        std::atomic<uint64_t> calls[REMOTE_CALL_COUNT] = {};
+        std::atomic<uint64_t> bytes[REMOTE_CALL_COUNT] = {};
+
+        inline void add(RemoteCall call, uint64_t moved = 0) {
+            calls[static_cast<size_t>(call)].fetch_add(1, std::memory_order_relaxed);
+            if (moved) bytes[static_cast<size_t>(call)].fetch_add(moved, std::memory_order_relaxed);
+        }
+
+        RemoteCallStats_t snapshot() const;
+        void reset();
+    };
+
+/**
+ * @class TargetBackend
+ * @brief Interface between the Debugger and the operating system debugging API.
+ *
+ * The Debugger never talks to the OS directly. Everything it needs from the target goes through
+ * this interface, so the breakpoint state machine can run on any backend (Win32, ptrace, ...).
+ * Thread handles are backend defined; on Win32 they are real HANDLEs.
+ */
+class TargetBackend {
+public:
+    virtual ~TargetBackend() = default;
+
+    // ===== Lifecycle =====
+
+    /**
+     * @brief Starts a process under debugging.
+     * @param exeName Path to the executable.
+     * @param args Arguments for the debugged application.
+     * @return true on success; false otherwise.
+     */
+    virtual bool start(const std::string& exeName, const std::vector<std::string>& args) = 0;
+
+    /**
+     * @brief Attaches to a running process.
+     * @param pid Process ID.
+     * @return true on success; false otherwise.
+     */
+    virtual bool attach(DWORD pid) = 0;
+
+    /**
+     * @brief Detaches from the debuggee and lets it run.
+     * @return true on success; false otherwise.
+     */
+    virtual bool detach() = 0;
+
+    /**
+     * @brief Terminates the debuggee.
+     * @param exitCode Exit code to use.
+     * @return true on success; false otherwise.
+     */
+    virtual bool terminate(DWORD exitCode) = 0;
+
+    /**
+     * @brief Releases all process / thread handles. Called when the event loop ends.
+     */
+    virtual void close() = 0;
+
+    /**
+     * @brief Finds the process ID of a process by name.
+     * @param exeName Name of the process executable.
+     * @return Process ID on success, or 0 if not found.
+     */
+    virtual DWORD findProcessId(const std::string& exeName) = 0;
+
+    /**
+     * @brief Returns the process ID of the debuggee.
+     */
+    virtual DWORD getProcessId() const = 0;
+
+    /**
+     * @brief Returns the process handle of the debuggee.
+     */
+    virtual HANDLE getProcessHandle() const = 0;
+
+    /**
+     * @brief Returns the handle of the initial thread (only valid after start()).
+     */
+    virtual HANDLE getMainThreadHandle() const = 0;
+
+    // ===== Events =====
+
+    /**
+     * @brief Waits for the next debug event. The debuggee stays stopped until continueEvent().
+     * @param event Receives the event.
+     * @param timeoutMs Timeout in milliseconds or INFINITE.
+     * @return true if an event was received; false on timeout or error.
+     */
+    virtual bool waitForEvent(DebugEvent_t& event, DWORD timeoutMs) = 0;
+
+    /**
+     * @brief Resumes the debuggee after an event.
+     * @param event Event returned by waitForEvent().
+     * @param handled true to swallow an exception (DBG_CONTINUE); false to pass it to the debuggee.
+     * @return true on success; false otherwise.
+     */
+    virtual bool continueEvent(const DebugEvent_t& event, bool handled) = 0;
+
+    /**
+     * @brief Resolves the module name of a CREATE_PROCESS / LOAD_DLL event.
+     * @param event The event.
+     * @return File name of the module.
+     */
+    virtual std::string getModuleName(const DebugEvent_t& event) = 0;
+
+    /**
+     * @brief Reads the payload of a DEBUG_STRING event as UTF-8.
+     * @param event The event.
+     * @return The debug string.
+     */
+    virtual std::string getDebugString(const DebugEvent_t& event) = 0;
+
+    /**
+     * @brief Gets the entry point of a module mapped in the debuggee.
+     * @param imageBase Module base address.
+     * @return Entry point address, or 0 on failure.
+     */
+    virtual uintptr_t getEntryPoint(uintptr_t imageBase) = 0;
+
+    // ===== Memory =====
+
+    /**
+     * @brief Reads raw bytes from target memory. Must be safe to call from several threads at once.
+     * @param address Source address in target.
+     * @param buffer Destination buffer.
+     * @param size Number of bytes to read.
+     * @param bytesRead Optional; receives the number of bytes read.
+     * @return true if all bytes were read; false otherwise.
+     */
+    virtual bool readMemory(uintptr_t address, void* buffer, SIZE_T size, SIZE_T* bytesRead = nullptr) = 0;
+
+    /**
+     * @brief Writes raw bytes to target memory, ignoring page protection where the OS allows it.
+     * @param address Destination address in target.
+     * @param buffer Source buffer.
+     * @param size Number of bytes to write.
+     * @return true if all bytes were written; false otherwise.
+     */
+    virtual bool writeMemory(uintptr_t address, const void* buffer, SIZE_T size) = 0;
+
+    /**
+     * @brief Reads many unrelated ranges. The default implementation issues one readMemory() per element.
+     * @param ios Transfer descriptors; transferred is filled for each.
+     * @param count Number of descriptors.
+     * @return Number of descriptors that were read completely.
+     */
+    virtual size_t readMemoryScatter(MemoryIo_t* ios, size_t count);
+
+    /**
+     * @brief Flushes the instruction cache for a range after code was patched.
+     * @param address Start of the range.
+     * @param size Size of the range.
+     * @return true on success; false otherwise.
+     */
+    virtual bool flushInstructionCache(uintptr_t address, SIZE_T size) = 0;
+
+    /**
+     * @brief Changes memory protection on a region.
+     * @param address Region base.
+     * @param size Region length in bytes.
+     * @param newProtect PAGE_* flags.
+     * @param oldProtect Receives the previous PAGE_* flags.
+     * @return true on success; false otherwise.
+     */
+    virtual bool protectMemory(uintptr_t address, SIZE_T size, DWORD newProtect, DWORD* oldProtect) = 0;
+
+    /**
+     * @brief Allocates memory in the debuggee.
+     * @param address Preferred address, or 0 to let the OS choose. The block may be placed elsewhere.
+     * @param size Number of bytes (rounded up to pages).
+     * @param protect PAGE_* flags.
+     * @return Address of the block, or 0 on failure.
+     */
+    virtual uintptr_t allocateMemory(uintptr_t address, SIZE_T size, DWORD protect) = 0;
+
+    /**
+     * @brief Releases memory returned by allocateMemory().
+     * @param address Block address.
+     * @param size Block size.
+     * @return true on success; false otherwise.
+     */
+    virtual bool freeMemory(uintptr_t address, SIZE_T size) = 0;
+
+    /**
+     * @brief Enumerates the address space of the debuggee in ascending order.
+     * @return Vector of memory regions.
+     */
+    virtual std::vector<MemoryRegion_t> getMemoryRegions() = 0;
+
+    /**
+     * @brief Enumerates the regions overlapping a range. The default implementation filters getMemoryRegions().
+     * @param address Start of the range.
+     * @param size Size of the range.
+     * @return Regions in ascending order; the first and last may reach past the range.
+     */
+    virtual std::vector<MemoryRegion_t> queryMemoryRegions(uintptr_t address, SIZE_T size);
+
+    // ===== Threads =====
+
+    /**
+     * @brief Enumerates the thread IDs of the debuggee.
+     * @return Thread IDs.
+     */
+    virtual std::vector<DWORD> enumerateThreads() = 0;
+
+    /**
+     * @brief Opens a thread handle. Must be released with closeThread().
+     * @param threadId Thread ID.
+     * @return Handle, or nullptr on failure.
+     */
+    virtual HANDLE openThread(DWORD threadId) = 0;
+
+    /**
+     * @brief Releases a handle returned by openThread().
+     * @param hThread Thread handle.
+     */
+    virtual void closeThread(HANDLE hThread) = 0;
+
+    /**
+     * @brief Suspends a thread while its context is modified.
+     * @param hThread Thread handle.
+     * @return true on success; false otherwise.
+     */
+    virtual bool suspendThread(HANDLE hThread) = 0;
+
+    /**
+     * @brief Resumes a thread suspended by suspendThread().
+     * @param hThread Thread handle.
+     * @return true on success; false otherwise.
+     */
+    virtual bool resumeThread(HANDLE hThread) = 0;
+
+    /**
+     * @brief Reads a thread context.
+     * @param hThread Thread handle.
+     * @param ctx Receives the requested parts of the context.
+     * @param parts ContextFlags to transfer.
+     * @return true on success; false otherwise.
+     */
+    virtual bool getContext(HANDLE hThread, ThreadContext_t& ctx, DWORD parts) = 0;
+
+    /**
+     * @brief Writes a thread context. Setting TF in flags single-steps the thread on the next resume.
+     * @param hThread Thread handle.
+     * @param ctx Context to write.
+     * @param parts ContextFlags to transfer.
+     * @return true on success; false otherwise.
+     */
+    virtual bool setContext(HANDLE hThread, const ThreadContext_t& ctx, DWORD parts) = 0;
+
+    // ===== Misc =====
+
+    /**
+     * @brief Attempts to hide the debugger from basic anti-debug checks.
+     * @return true if hiding steps were applied; false otherwise.
+     */
+    virtual bool hideDebugger() = 0;
+
+    // ===== Instrumentation =====
+
+    /**
+     * @brief Counts remote calls into counters from now on; nullptr (default) stops counting.
+     * @param counters Must outlive the backend or be replaced first. Set it while no scan is running.
+     */
+    inline void setRemoteCounters(RemoteCounters_t* counters) { remoteCounters_ = counters; }
+
+    /**
+     * @brief Records a span per remote call into tracer from now on; nullptr (default) stops tracing.
+     * @param tracer Must outlive the backend or be replaced first. Set it while no scan is running.
+     */
+    inline void setTracer(TraceRecorder* tracer) { tracer_ = tracer; }
+
+protected:
+    /**
+     * @class RemoteScope
+     * @brief Lives for the duration of one primitive: counts it and, while tracing, records its span.
+     * Two pointer tests when metrics and tracing are off.
+     */
+    class RemoteScope {
+    public:
+        inline RemoteScope(TargetBackend& backend, RemoteCall call)
+            : backend_(backend), call_(call), start_(backend.tracer_ ? monotonicNs() : 0) {}
+
+        inline ~RemoteScope() {
+            if (backend_.remoteCounters_) backend_.remoteCounters_->add(call_, bytes_);
+            if (backend_.tracer_ && start_) {
+                const bool io = call_ == RemoteCall::READ_MEMORY || call_ == RemoteCall::WRITE_MEMORY;
+                backend_.tracer_->record(TraceCategory::REMOTE, remoteCallName(call_), start_, monotonicNs(),
+                                         io ? "bytes" : nullptr, bytes_);
+            }
+        }
+
+        RemoteScope(const RemoteScope&) = delete;
+        RemoteScope& operator=(const RemoteScope&) = delete;
+
+        /// Bytes the call moved (memory reads and writes).
+        inline void setBytes(uint64_t bytes) { bytes_ = bytes; }
+
+    private:
+        TargetBackend& backend_;
+        RemoteCall call_;
+        uint64_t start_;
+        uint64_t bytes_ = 0;
+    };
+
+private:
+    RemoteCounters_t* remoteCounters_ = nullptr;
+    TraceRecorder* tracer_ = nullptr;
+};
+
+/**
+ * @brief Creates the backend for the platform the library was built for (Win32 or ptrace).
+ * @param verbose Enable verbose logging if true.
+ * @return The native backend.
+ */
+std::unique_ptr<TargetBackend> createNativeBackend(bool verbose);
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,506 @@
+#ifdef _WIN32
+
+#include "win32Backend.h"
+#include "../util.h"
+
+#include <iostream>
+#include <algorithm>
+
+namespace RoboDBG {
+
+Win32Backend::Win32Backend(bool verbose) : verbose_(verbose) {
+    SYSTEM_INFO sysInfo;
+    GetSystemInfo(&sysInfo);
+    minAddress_ = reinterpret_cast<uintptr_t>(sysInfo.lpMinimumApplicationAddress);
+    maxAddress_ = reinterpret_cast<uintptr_t>(sysInfo.lpMaximumApplicationAddress);
+}
+
+Win32Backend::~Win32Backend() = default;
+
+// ==================================================
+// LIFECYCLE
+// ==================================================
+
+bool Win32Backend::start(const std::string& exeName, const std::vector<std::string>& args) {
+    STARTUPINFO si = { sizeof(si) };
+    PROCESS_INFORMATION pi{};
+
+    // Without arguments exeName is used as the complete command line
+    std::string cmdLine = exeName;
+    if (!args.empty()) {
+        cmdLine = "\"" + exeName + "\""; // quote exe path in case it has spaces
+        for (const auto& arg : args) {
+            cmdLine += " " + arg;
+        }
+    }
+
+    // CreateProcess requires a modifiable LPSTR
+    std::vector<char> cmdLineMutable(cmdLine.begin(), cmdLine.end());
+    cmdLineMutable.push_back('\0');
+
+    if (!CreateProcessA(
+        nullptr,
+        cmdLineMutable.data(),
+                        nullptr,
+                        nullptr,
+                        FALSE,
+                        DEBUG_ONLY_THIS_PROCESS,
+                        nullptr,
+                        nullptr,
+                        &si,
+                        &pi
+    )) {
+        std::cerr << "[-] CreateProcess failed: " << GetLastError() << std::endl;
+        return false;
+    }
+
+    hProcess_ = pi.hProcess;
+    hThread_  = pi.hThread;
+    pid_      = pi.dwProcessId;
+    return true;
+}
+
+bool Win32Backend::attach(DWORD pid) {
+    if (!DebugActiveProcess(pid)) {
+        std::cerr << "[-] Failed to attach to process: " << GetLastError() << std::endl;
+        return false;
+    }
+
+    hProcess_ = OpenProcess(PROCESS_ALL_ACCESS, FALSE, pid);
+    if (hProcess_ == NULL) {
+        std::cerr << "[-] Failed to open process: " << GetLastError() << std::endl;
+        return false;
+    }
+    pid_ = pid;
+    return true;
+}
+
+bool Win32Backend::detach() {
+    if (!DebugActiveProcessStop(pid_)) {
+        std::cerr << "[-] Failed to detach debugger. Error: " << GetLastError() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Win32Backend::terminate(DWORD exitCode) {
+    if (!hProcess_) {
+        return false;
+    }
+
+    if (!TerminateProcess(hProcess_, exitCode)) {
+        std::cerr << "[-] TerminateProcess failed. Error: " << GetLastError() << std::endl;
+        return false;
+    }
+
+    CloseHandle(hProcess_);
+    hProcess_ = nullptr;
+    return true;
+}
+
+void Win32Backend::close() {
+    if (hProcess_) CloseHandle(hProcess_);
+    if (hThread_)  CloseHandle(hThread_);
+    hProcess_ = nullptr;
+    hThread_  = nullptr;
+}
+
+DWORD Win32Backend::findProcessId(const std::string& exeName) {
+    return Util::findProcessId(exeName);
+}
+
+// ==================================================
+// EVENTS
+// ==================================================
+
+bool Win32Backend::waitForEvent(DebugEvent_t& event, DWORD timeoutMs) {
+    DEBUG_EVENT dbgEvent;
+    if (!WaitForDebugEvent(&dbgEvent, timeoutMs)) return false;
+
+    event = DebugEvent_t{};
+    event.processId = dbgEvent.dwProcessId;
+    event.threadId  = dbgEvent.dwThreadId;
+    event.rawCode   = dbgEvent.dwDebugEventCode;
+
+    switch (dbgEvent.dwDebugEventCode) {
+        case CREATE_PROCESS_DEBUG_EVENT: {
+            const CREATE_PROCESS_DEBUG_INFO& info = dbgEvent.u.CreateProcessInfo;
+            event.type         = DebugEventType::CREATE_PROCESS;
+            event.imageBase    = reinterpret_cast<uintptr_t>(info.lpBaseOfImage);
+            event.imageName    = reinterpret_cast<uintptr_t>(info.lpImageName);
+            event.unicode      = info.fUnicode != 0;
+            event.hThread      = info.hThread;
+            event.threadBase   = reinterpret_cast<uintptr_t>(info.lpThreadLocalBase);
+            event.startAddress = reinterpret_cast<uintptr_t>(info.lpStartAddress);
+            break;
+        }
+        case EXIT_PROCESS_DEBUG_EVENT:
+            event.type     = DebugEventType::EXIT_PROCESS;
+            event.exitCode = dbgEvent.u.ExitProcess.dwExitCode;
+            break;
+        case CREATE_THREAD_DEBUG_EVENT:
+            event.type         = DebugEventType::CREATE_THREAD;
+            event.hThread      = dbgEvent.u.CreateThread.hThread;
+            event.threadBase   = reinterpret_cast<uintptr_t>(dbgEvent.u.CreateThread.lpThreadLocalBase);
+            event.startAddress = reinterpret_cast<uintptr_t>(dbgEvent.u.CreateThread.lpStartAddress);
+            break;
+        case EXIT_THREAD_DEBUG_EVENT:
+            event.type     = DebugEventType::EXIT_THREAD;
+            event.exitCode = dbgEvent.u.ExitThread.dwExitCode;
+            break;
+        case LOAD_DLL_DEBUG_EVENT:
+            event.type      = DebugEventType::LOAD_DLL;
+            event.imageBase = reinterpret_cast<uintptr_t>(dbgEvent.u.LoadDll.lpBaseOfDll);
+            event.imageName = reinterpret_cast<uintptr_t>(dbgEvent.u.LoadDll.lpImageName);
+            event.unicode   = dbgEvent.u.LoadDll.fUnicode != 0;
+            break;
+        case UNLOAD_DLL_DEBUG_EVENT:
+            event.type      = DebugEventType::UNLOAD_DLL;
+            event.imageBase = reinterpret_cast<uintptr_t>(dbgEvent.u.UnloadDll.lpBaseOfDll);
+            break;
+        case EXCEPTION_DEBUG_EVENT: {
+            const EXCEPTION_RECORD& rec = dbgEvent.u.Exception.ExceptionRecord;
+            event.type             = DebugEventType::EXCEPTION;
+            event.exceptionCode    = rec.ExceptionCode;
+            event.exceptionAddress = reinterpret_cast<uintptr_t>(rec.ExceptionAddress);
+            event.firstChance      = dbgEvent.u.Exception.dwFirstChance != 0;
+            for (DWORD i = 0; i < 2 && i < rec.NumberParameters; ++i)
+                event.exceptionInfo[i] = rec.ExceptionInformation[i];
+            break;
+        }
+        case OUTPUT_DEBUG_STRING_EVENT:
+            event.type              = DebugEventType::DEBUG_STRING;
+            event.debugString       = reinterpret_cast<uintptr_t>(dbgEvent.u.DebugString.lpDebugStringData);
+            event.debugStringLength = dbgEvent.u.DebugString.nDebugStringLength;
+            event.unicode           = dbgEvent.u.DebugString.fUnicode != 0;
+            break;
+        case RIP_EVENT:
+            event.type = DebugEventType::RIP_ERROR;
+            event.rip  = dbgEvent.u.RipInfo;
+            break;
+        default:
+            event.type = DebugEventType::UNKNOWN_EVENT;
+            break;
+    }
+    return true;
+}
+
+bool Win32Backend::continueEvent(const DebugEvent_t& event, bool handled) {
+    return ContinueDebugEvent(event.processId, event.threadId, handled ? DBG_CONTINUE : DBG_EXCEPTION_NOT_HANDLED) != 0;
+}
+
+std::string Win32Backend::getModuleName(const DebugEvent_t& event) {
+    RemoteScope call(*this, RemoteCall::EVENT_PAYLOAD);
+    return Util::getDllName(hProcess_, reinterpret_cast<LPVOID>(event.imageName), event.unicode);
+}
+
+std::string Win32Backend::getDebugString(const DebugEvent_t& event) {
+    RemoteScope call(*this, RemoteCall::EVENT_PAYLOAD);
+    SIZE_T bytesRead;
+
+    if (!event.unicode) {
+        // ANSI string
+        char buffer[1024] = {0};
+        ReadProcessMemory(
+            hProcess_,
+            reinterpret_cast<LPCVOID>(event.debugString),
+            buffer,
+            std::min<DWORD>(event.debugStringLength, sizeof(buffer) - 1),
+                          &bytesRead
+        );
+        return std::string(buffer);
+    }
+
+    // Unicode string
+    wchar_t wbuffer[1024] = {0};
+    ReadProcessMemory(
+        hProcess_,
+        reinterpret_cast<LPCVOID>(event.debugString),
+        wbuffer,
+        std::min<DWORD>(event.debugStringLength * sizeof(wchar_t), sizeof(wbuffer) - sizeof(wchar_t)),
+                      &bytesRead
+    );
+
+    // Convert wchar_t* to std::string using WideCharToMultiByte (UTF-8)
+    int size_needed = WideCharToMultiByte(CP_UTF8, 0, wbuffer, -1, nullptr, 0, nullptr, nullptr);
+    std::string msg(size_needed, 0);
+    WideCharToMultiByte(CP_UTF8, 0, wbuffer, -1, &msg[0], size_needed, nullptr, nullptr);
+    return msg;
+}
+
+uintptr_t Win32Backend::getEntryPoint(uintptr_t imageBase) {
+    RemoteScope call(*this, RemoteCall::EVENT_PAYLOAD);
+    return static_cast<uintptr_t>(Util::getEntryPoint(hProcess_, reinterpret_cast<LPVOID>(imageBase)));
+}
+
+// ==================================================
+// MEMORY
+// ==================================================
+
+bool Win32Backend::readMemory(uintptr_t address, void* buffer, SIZE_T size, SIZE_T* bytesRead) {
+    RemoteScope call(*this, RemoteCall::READ_MEMORY);
+    SIZE_T nread = 0;
+    BOOL ok = ReadProcessMemory(hProcess_, reinterpret_cast<LPCVOID>(address), buffer, size, &nread);
+    call.setBytes(nread);
+    if (bytesRead) *bytesRead = nread;
+    return ok && nread == size;
+}
+
+bool Win32Backend::writeMemory(uintptr_t address, const void* buffer, SIZE_T size) {
+    RemoteScope call(*this, RemoteCall::WRITE_MEMORY);
+    SIZE_T bytesWritten = 0;
+    const BOOL ok = WriteProcessMemory(hProcess_, reinterpret_cast<LPVOID>(address), buffer, size, &bytesWritten);
+    call.setBytes(bytesWritten);
+    return ok && bytesWritten == size;
+}
+
+bool Win32Backend::flushInstructionCache(uintptr_t address, SIZE_T size) {
+    RemoteScope call(*this, RemoteCall::FLUSH_INSTRUCTION_CACHE);
+    return FlushInstructionCache(hProcess_, reinterpret_cast<LPCVOID>(address), size) != 0;
+}
+
+bool Win32Backend::protectMemory(uintptr_t address, SIZE_T size, DWORD newProtect, DWORD* oldProtect) {
+    DWORD old = 0;
+    RemoteScope call(*this, RemoteCall::PROTECT_MEMORY);
+    BOOL ok = VirtualProtectEx(hProcess_, reinterpret_cast<LPVOID>(address), size, newProtect, &old);
+    if (oldProtect) *oldProtect = old;
+    return ok != 0;
+}
+
+uintptr_t Win32Backend::allocateMemory(uintptr_t address, SIZE_T size, DWORD protect) {
+    RemoteScope call(*this, RemoteCall::ALLOCATE_MEMORY);
+    LPVOID block = VirtualAllocEx(hProcess_, reinterpret_cast<LPVOID>(address), size, MEM_COMMIT | MEM_RESERVE, protect);
+    if (!block && address) {
+        // Preferred range is taken; any address will do
+        block = VirtualAllocEx(hProcess_, nullptr, size, MEM_COMMIT | MEM_RESERVE, protect);
+    }
+    return reinterpret_cast<uintptr_t>(block);
+}
+
+bool Win32Backend::freeMemory(uintptr_t address, SIZE_T size) {
+    RemoteScope call(*this, RemoteCall::FREE_MEMORY);
+    return VirtualFreeEx(hProcess_, reinterpret_cast<LPVOID>(address), 0, MEM_RELEASE) != 0;
+}
+
+std::vector<MemoryRegion_t> Win32Backend::getMemoryRegions() {
+    return queryMemoryRegions(minAddress_, maxAddress_ - minAddress_);
+}
+
+std::vector<MemoryRegion_t> Win32Backend::queryMemoryRegions(uintptr_t address, SIZE_T size) {
+    const uintptr_t end = std::min(address + size, maxAddress_);
+    uintptr_t addr = std::max(address, minAddress_);
+    MEMORY_BASIC_INFORMATION mbi;
+    std::vector<MemoryRegion_t> regions;
+
+    while (addr < end) {
+        RemoteScope call(*this, RemoteCall::QUERY_MEMORY);
+        if (VirtualQueryEx(hProcess_, reinterpret_cast<LPCVOID>(addr), &mbi, sizeof(mbi)) == 0)
+            break;
+
+        MemoryRegion_t region;
+        region.BaseAddress = mbi.BaseAddress;
+        region.RegionSize = mbi.RegionSize;
+        region.State = mbi.State;
+        region.Protect = mbi.Protect;
+        region.Type = mbi.Type;
+
+        regions.push_back(region);
+
+        addr = reinterpret_cast<uintptr_t>(mbi.BaseAddress) + mbi.RegionSize;
+    }
+
+    return regions;
+}
+
+// ==================================================
+// THREADS
+// ==================================================
+
+std::vector<DWORD> Win32Backend::enumerateThreads() {
+    std::vector<DWORD> tids;
+
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) {
+        std::cerr << "[-] Failed to create thread snapshot. Error: " << GetLastError() << std::endl;
+        return tids;
+    }
+
+    THREADENTRY32 te32 = {};
+    te32.dwSize = sizeof(te32);
+
+    if (Thread32First(snapshot, &te32)) {
+        do {
+            if (te32.th32OwnerProcessID == pid_) {
+                tids.push_back(te32.th32ThreadID);
+            }
+        } while (Thread32Next(snapshot, &te32));
+    }
+
+    CloseHandle(snapshot);
+    return tids;
+}
+
+HANDLE Win32Backend::openThread(DWORD threadId) {
+    RemoteScope call(*this, RemoteCall::OPEN_THREAD);
+    return OpenThread(THREAD_ALL_ACCESS, FALSE, threadId);
+}
+
+void Win32Backend::closeThread(HANDLE hThread) {
+    if (hThread) CloseHandle(hThread);
+}
+
+bool Win32Backend::suspendThread(HANDLE hThread) {
+    RemoteScope call(*this, RemoteCall::SUSPEND_THREAD);
+    if (SuspendThread(hThread) == (DWORD)-1) {
+        std::cerr << "[-] SuspendThread failed: " << GetLastError() << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool Win32Backend::resumeThread(HANDLE hThread) {
+    RemoteScope call(*this, RemoteCall::RESUME_THREAD);
+    if (ResumeThread(hThread) == (DWORD)-1) {
+        std::cerr << "[-] ResumeThread failed: " << GetLastError() << "\n";
+        return false;
+    }
+    return true;
+}
+
+DWORD Win32Backend::toNativeFlags(DWORD parts) {
+    DWORD flags = 0;
+    if (parts & CONTEXT_PART_CONTROL) flags |= CONTEXT_CONTROL;
+    if (parts & CONTEXT_PART_INTEGER) flags |= CONTEXT_INTEGER;
+    if (parts & CONTEXT_PART_DEBUG)   flags |= CONTEXT_DEBUG_REGISTERS;
+    return flags;
+}
+
+bool Win32Backend::getContext(HANDLE hThread, ThreadContext_t& ctx, DWORD parts) {
+    CONTEXT native = {};
+    native.ContextFlags = toNativeFlags(parts);
+    RemoteScope call(*this, RemoteCall::GET_CONTEXT);
+    if (!GetThreadContext(hThread, &native)) {
+        if (verbose_) std::cerr << "[-] GetThreadContext failed: " << GetLastError() << "\n";
+        return false;
+    }
+
+    if (parts & CONTEXT_PART_CONTROL) {
+        #ifdef ROBODBG_X64
+        ctx.ip = native.Rip;
+        ctx.gpr[7] = native.Rsp;
+        #else
+        ctx.ip = native.Eip;
+        ctx.gpr[7] = native.Esp;
+        ctx.gpr[6] = native.Ebp;
+        #endif
+        ctx.flags = native.EFlags;
+        ctx.segCs = native.SegCs;
+        ctx.segSs = native.SegSs;
+    }
+    if (parts & CONTEXT_PART_INTEGER) {
+        #ifdef ROBODBG_X64
+        const DWORD64 regs[16] = {
+            native.Rax, native.Rbx, native.Rcx, native.Rdx, native.Rsi, native.Rdi, native.Rbp, ctx.gpr[7],
+            native.R8, native.R9, native.R10, native.R11, native.R12, native.R13, native.R14, native.R15
+        };
+        std::copy(std::begin(regs), std::end(regs), ctx.gpr);
+        #else
+        ctx.gpr[0] = native.Eax; ctx.gpr[1] = native.Ebx;
+        ctx.gpr[2] = native.Ecx; ctx.gpr[3] = native.Edx;
+        ctx.gpr[4] = native.Esi; ctx.gpr[5] = native.Edi;
+        #endif
+    }
+    if (parts & CONTEXT_PART_DEBUG) {
+        ctx.dr[0] = native.Dr0; ctx.dr[1] = native.Dr1;
+        ctx.dr[2] = native.Dr2; ctx.dr[3] = native.Dr3;
+        ctx.dr[6] = native.Dr6; ctx.dr[7] = native.Dr7;
+    }
+    return true;
+}
+
+bool Win32Backend::setContext(HANDLE hThread, const ThreadContext_t& ctx, DWORD parts) {
+    CONTEXT native = {};
+    native.ContextFlags = toNativeFlags(parts);
+
+    if (parts & CONTEXT_PART_CONTROL) {
+        #ifdef ROBODBG_X64
+        native.Rip = ctx.ip;
+        native.Rsp = ctx.gpr[7];
+        #else
+        native.Eip = static_cast<DWORD>(ctx.ip);
+        native.Esp = static_cast<DWORD>(ctx.gpr[7]);
+        native.Ebp = static_cast<DWORD>(ctx.gpr[6]);
+        #endif
+        native.EFlags = static_cast<DWORD>(ctx.flags);
+        native.SegCs = static_cast<WORD>(ctx.segCs);
+        native.SegSs = static_cast<WORD>(ctx.segSs);
+    }
+    if (parts & CONTEXT_PART_INTEGER) {
+        #ifdef ROBODBG_X64
+        native.Rax = ctx.gpr[0]; native.Rbx = ctx.gpr[1];
+        native.Rcx = ctx.gpr[2]; native.Rdx = ctx.gpr[3];
+        native.Rsi = ctx.gpr[4]; native.Rdi = ctx.gpr[5];
+        native.Rbp = ctx.gpr[6];
+        native.R8  = ctx.gpr[8];  native.R9  = ctx.gpr[9];
+        native.R10 = ctx.gpr[10]; native.R11 = ctx.gpr[11];
+        native.R12 = ctx.gpr[12]; native.R13 = ctx.gpr[13];
+        native.R14 = ctx.gpr[14]; native.R15 = ctx.gpr[15];
+        #else
+        native.Eax = static_cast<DWORD>(ctx.gpr[0]); native.Ebx = static_cast<DWORD>(ctx.gpr[1]);
+        native.Ecx = static_cast<DWORD>(ctx.gpr[2]); native.Edx = static_cast<DWORD>(ctx.gpr[3]);
+        native.Esi = static_cast<DWORD>(ctx.gpr[4]); native.Edi = static_cast<DWORD>(ctx.gpr[5]);
+        #endif
+    }
+    if (parts & CONTEXT_PART_DEBUG) {
+        native.Dr0 = static_cast<DWORD_PTR>(ctx.dr[0]); native.Dr1 = static_cast<DWORD_PTR>(ctx.dr[1]);
+        native.Dr2 = static_cast<DWORD_PTR>(ctx.dr[2]); native.Dr3 = static_cast<DWORD_PTR>(ctx.dr[3]);
+        native.Dr6 = static_cast<DWORD_PTR>(ctx.dr[6]); native.Dr7 = static_cast<DWORD_PTR>(ctx.dr[7]);
+    }
+
+    RemoteScope call(*this, RemoteCall::SET_CONTEXT);
+    if (!SetThreadContext(hThread, &native)) {
+        std::cerr << "[-] SetThreadContext failed: " << GetLastError() << "\n";
+        return false;
+    }
+    return true;
+}
+
+// ==================================================
+// MISC
+// ==================================================
+
+bool Win32Backend::hideDebugger() {
+    PROCESS_BASIC_INFORMATION pbi = {};
+    ULONG retLen;
+
+    NTSTATUS status = NtQueryInformationProcess(
+        hProcess_,
+        ProcessBasicInformation,
+        &pbi,
+        sizeof(pbi),&retLen
+    );
+
+    if (status != 0) {
+        std::cerr << "[-] NtQueryInformationProcess failed\n";
+        return false;
+    }
+
+    // PEB is at this address in remote process
+    BYTE beingDebugged = 0;
+    SIZE_T bytesWritten = 0;
+
+    // BeingDebugged is at offset 0x2 of the PEB
+    LPVOID pebDebugFlagAddr = (LPBYTE)pbi.PebBaseAddress + 2;
+
+    // Write zero to the flag
+    if (!WriteProcessMemory(hProcess_, pebDebugFlagAddr, &beingDebugged, sizeof(beingDebugged), &bytesWritten)) {
+        std::cerr << "[-] WriteProcessMemory failed: " << GetLastError() << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace RoboDBG
+
+#endif
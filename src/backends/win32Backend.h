@@ -0,0 +1,75 @@
+/**
+ * @file win32Backend.h
+ * @brief TargetBackend on top of the Win32 debugging API
+ * @author Milkshake
+ */
+
+#ifndef WIN32BACKEND_H
+#define WIN32BACKEND_H
+
+#ifdef _WIN32
+
+#include "targetBackend.h"
+
+namespace RoboDBG {
+
+/**
+ * @class Win32Backend
+ * @brief Native Windows backend (WaitForDebugEvent, Read/WriteProcessMemory, Get/SetThreadContext).
+ */
+class Win32Backend : public TargetBackend {
+public:
+    explicit Win32Backend(bool verbose);
+    ~Win32Backend() override;
+
+    bool start(const std::string& exeName, const std::vector<std::string>& args) override;
+    bool attach(DWORD pid) override;
+    bool detach() override;
+    bool terminate(DWORD exitCode) override;
+    void close() override;
+    DWORD findProcessId(const std::string& exeName) override;
+    DWORD getProcessId() const override { return pid_; }
+    HANDLE getProcessHandle() const override { return hProcess_; }
+    HANDLE getMainThreadHandle() const override { return hThread_; }
+
+    bool waitForEvent(DebugEvent_t& event, DWORD timeoutMs) override;
+    bool continueEvent(const DebugEvent_t& event, bool handled) override;
+    std::string getModuleName(const DebugEvent_t& event) override;
+    std::string getDebugString(const DebugEvent_t& event) override;
+    uintptr_t getEntryPoint(uintptr_t imageBase) override;
+
+    bool readMemory(uintptr_t address, void* buffer, SIZE_T size, SIZE_T* bytesRead = nullptr) override;
+    bool writeMemory(uintptr_t address, const void* buffer, SIZE_T size) override;
+    bool flushInstructionCache(uintptr_t address, SIZE_T size) override;
+    bool protectMemory(uintptr_t address, SIZE_T size, DWORD newProtect, DWORD* oldProtect) override;
+    uintptr_t allocateMemory(uintptr_t address, SIZE_T size, DWORD protect) override;
+    bool freeMemory(uintptr_t address, SIZE_T size) override;
+    std::vector<MemoryRegion_t> getMemoryRegions() override;
+    std::vector<MemoryRegion_t> queryMemoryRegions(uintptr_t address, SIZE_T size) override;
+
+    std::vector<DWORD> enumerateThreads() override;
+    HANDLE openThread(DWORD threadId) override;
+    void closeThread(HANDLE hThread) override;
+    bool suspendThread(HANDLE hThread) override;
+    bool resumeThread(HANDLE hThread) override;
+    bool getContext(HANDLE hThread, ThreadContext_t& ctx, DWORD parts) override;
+    bool setContext(HANDLE hThread, const ThreadContext_t& ctx, DWORD parts) override;
+
+    bool hideDebugger() override;
+
+private:
+    static DWORD toNativeFlags(DWORD parts);
+
+    bool verbose_;
+    HANDLE hProcess_ = nullptr;
+    HANDLE hThread_ = nullptr;
+    DWORD pid_ = 0;
+    uintptr_t minAddress_ = 0; ///< lpMinimumApplicationAddress, queried once.
+    uintptr_t maxAddress_ = 0; ///< lpMaximumApplicationAddress.
+};
+
+} // namespace RoboDBG
+
+#endif
+
+#endif
@@ -0,0 +1,139 @@
+#include "breakpointTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace RoboDBG {
+
+namespace {
+    constexpr size_t MIN_CAPACITY = 16;
+
+    // Slots needed to keep the load factor at or below 3/4
+    size_t capacityFor(size_t count) {
+        size_t cap = MIN_CAPACITY;
+        while (cap - cap / 4 < count) cap <<= 1;
+        return cap;
+    }
+
+    unsigned log2(size_t v) {
+        unsigned bits = 0;
+        while ((size_t(1) << bits) < v) ++bits;
+        return bits;
+    }
+}
+
+BreakpointTable::BreakpointTable(size_t capacity) {
+    rehash(capacityFor(capacity));
+}
+
+BreakpointTable::BreakpointTable(BreakpointTable&& other) noexcept
+    : slots_(std::move(other.slots_)), mask_(other.mask_), count_(other.count_), shift_(other.shift_) {
+    other.release();
+}
+
+BreakpointTable& BreakpointTable::operator=(BreakpointTable&& other) noexcept {
+    if (this != &other) {
+        slots_ = std::move(other.slots_);
+        mask_  = other.mask_;
+        count_ = other.count_;
+        shift_ = other.shift_;
+        other.release();
+    }
+    return *this;
+}
+
+void BreakpointTable::release() noexcept {
+    slots_.reset();
+    mask_  = 0;
+    count_ = 0;
+    shift_ = 64;
+}
+
+void BreakpointTable::rehash(size_t newCapacity) {
+    auto* raw = static_cast<Breakpoint_t*>(::operator new[](newCapacity * sizeof(Breakpoint_t), std::align_val_t(64)));
+    std::memset(raw, 0, newCapacity * sizeof(Breakpoint_t));
+    std::unique_ptr<Breakpoint_t[], AlignedDelete> fresh(raw);
+
+    std::unique_ptr<Breakpoint_t[], AlignedDelete> old = std::move(slots_);
+    const size_t oldCapacity = old ? mask_ + 1 : 0;
+
+    slots_ = std::move(fresh);
+    mask_  = newCapacity - 1;
+    shift_ = 64 - log2(newCapacity);
+
+    for (size_t i = 0; i < oldCapacity; ++i) {
+        const Breakpoint_t& e = old[i];
+        if (e.address == 0) continue;
+        size_t j = slotOf(e.address);
+        while (slots_[j].address != 0) j = (j + 1) & mask_;
+        slots_[j] = e;
+    }
+}
+
+Breakpoint_t* BreakpointTable::insert(uintptr_t address, uint8_t original) {
+    if (address == 0) return nullptr;
+
+    if (Breakpoint_t* e = find(address)) {
+        e->original = original;
+        return e;
+    }
+
+    if (!slots_) {
+        rehash(capacityFor(0)); // moved from
+    } else if (count_ + 1 > capacity() - capacity() / 4) {
+        rehash(capacity() * 2);
+    }
+
+    size_t i = slotOf(address);
+    while (slots_[i].address != 0) i = (i + 1) & mask_;
+
+    Breakpoint_t& e = slots_[i];
+    e = Breakpoint_t{};
+    e.address  = address;
+    e.original = original;
+    ++count_;
+    return &e;
+}
+
+bool BreakpointTable::erase(uintptr_t address) {
+    Breakpoint_t* e = find(address);
+    if (!e) return false;
+
+    // Backward-shift deletion: pull later members of the probe chain into the hole
+    size_t hole = static_cast<size_t>(e - slots_.get());
+    for (size_t i = (hole + 1) & mask_; slots_[i].address != 0; i = (i + 1) & mask_) {
+        const size_t home = slotOf(slots_[i].address);
+        // Move if home is not cyclically within (hole, i]
+        const bool movable = (hole <= i) ? (home <= hole || home > i)
+                                         : (home <= hole && home > i);
+        if (movable) {
+            slots_[hole] = slots_[i];
+            hole = i;
+        }
+    }
+    slots_[hole] = Breakpoint_t{};
+    --count_;
+    return true;
+}
+
+void BreakpointTable::clear() {
+    if (slots_) std::memset(slots_.get(), 0, capacity() * sizeof(Breakpoint_t));
+    count_ = 0;
+}
+
+void BreakpointTable::reserve(size_t count) {
+    const size_t cap = capacityFor(count);
+    if (cap > capacity()) rehash(cap);
+}
+
+std::vector<uintptr_t> BreakpointTable::addresses() const {
+    std::vector<uintptr_t> result;
+    result.reserve(count_);
+    for (size_t i = 0; slots_ && i <= mask_; ++i) {
+        if (slots_[i].address != 0) result.push_back(slots_[i].address);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace RoboDBG
@@ -0,0 +1,178 @@
+/**
+ * @file breakpointTable.h
+ * @brief Open-addressing table of software breakpoints
+ * @author Milkshake
+ */
+
+#ifndef BREAKPOINTTABLE_H
+#define BREAKPOINTTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace RoboDBG {
+
+    /**
+     * @enum BreakpointFlags
+     * @brief State bits of a software breakpoint.
+     */
+    enum BreakpointFlags : uint8_t {
+        BP_FLAG_ARMED       = 1 << 0, ///< The int3 byte is currently written to the target.
+        BP_FLAG_NO_DISPLACE = 1 << 1  ///< The original instruction cannot be displaced-stepped; single-step it.
+    };
+
+    /**
+     * @struct Breakpoint_t
+     * @brief One software breakpoint. 16 bytes, four per cache line.
+     */
+    struct alignas(16) Breakpoint_t {
+        uintptr_t address; ///< Breakpoint address; 0 marks an empty slot.
+        uint32_t hits;     ///< Number of times the breakpoint was hit.
+        uint8_t original;  ///< Original byte replaced by int3.
+        uint8_t action;    ///< Last BreakpointAction returned by onBreakpoint.
+        uint8_t flags;     ///< BreakpointFlags.
+        uint8_t reserved;  ///< Padding.
+    };
+    static_assert(sizeof(Breakpoint_t) == 16, "Breakpoint_t must stay 16 bytes");
+
+/**
+ * @class BreakpointTable
+ * @brief Hash table of software breakpoints keyed by address.
+ *
+ * Linear probing over a power-of-two array of 16 byte entries with Fibonacci hashing and
+ * backward-shift deletion (no tombstones), so lookups on the exception path touch one or two cache
+ * lines regardless of how many breakpoints are set. Entry pointers are invalidated by insert() and
+ * erase(); iterate with addresses() / forEach(), which visit the breakpoints in ascending address
+ * order and allow modifying the table while iterating.
+ */
+class BreakpointTable {
+public:
+    /**
+     * @brief Creates an empty table.
+     * @param capacity Number of breakpoints to reserve room for.
+     */
+    explicit BreakpointTable(size_t capacity = 0);
+
+    BreakpointTable(const BreakpointTable&) = delete;
+    BreakpointTable& operator=(const BreakpointTable&) = delete;
+    /**
+     * @brief Takes the breakpoints of other, which is left empty and usable.
+     */
+    BreakpointTable(BreakpointTable&& other) noexcept;
+    BreakpointTable& operator=(BreakpointTable&& other) noexcept;
+
+    /**
+     * @brief Looks up a breakpoint.
+     * @param address Breakpoint address.
+     * @return The entry, or nullptr if there is no breakpoint at address.
+     */
+    inline Breakpoint_t* find(uintptr_t address) {
+        if (count_ == 0 || address == 0) return nullptr;
+        for (size_t i = slotOf(address);; i = (i + 1) & mask_) {
+            Breakpoint_t& e = slots_[i];
+            if (e.address == address) return &e;
+            if (e.address == 0) return nullptr;
+        }
+    }
+
+    /**
+     * @brief Looks up a breakpoint.
+     * @param address Breakpoint address.
+     * @return The entry, or nullptr if there is no breakpoint at address.
+     */
+    inline const Breakpoint_t* find(uintptr_t address) const {
+        return const_cast<BreakpointTable*>(this)->find(address);
+    }
+
+    /**
+     * @brief Checks if a breakpoint exists.
+     * @param address Breakpoint address.
+     * @return true if present; false otherwise.
+     */
+    inline bool contains(uintptr_t address) const { return find(address) != nullptr; }
+
+    /**
+     * @brief Inserts a breakpoint or updates the original byte of an existing one.
+     * @param address Breakpoint address (must not be 0).
+     * @param original Original byte at address.
+     * @return The entry, or nullptr if address is 0.
+     */
+    Breakpoint_t* insert(uintptr_t address, uint8_t original);
+
+    /**
+     * @brief Removes a breakpoint.
+     * @param address Breakpoint address.
+     * @return true if a breakpoint was removed; false otherwise.
+     */
+    bool erase(uintptr_t address);
+
+    /**
+     * @brief Removes all breakpoints.
+     */
+    void clear();
+
+    /**
+     * @brief Makes room for count breakpoints without rehashing.
+     * @param count Number of breakpoints.
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Returns the number of breakpoints.
+     */
+    inline size_t size() const { return count_; }
+
+    /**
+     * @brief Returns true if there are no breakpoints.
+     */
+    inline bool empty() const { return count_ == 0; }
+
+    /**
+     * @brief Returns the number of slots.
+     */
+    inline size_t capacity() const { return slots_ ? mask_ + 1 : 0; }
+
+    /**
+     * @brief Returns all breakpoint addresses in ascending order.
+     * @return Snapshot of the addresses.
+     */
+    std::vector<uintptr_t> addresses() const;
+
+    /**
+     * @brief Calls fn(Breakpoint_t&) for every breakpoint in ascending address order.
+     * The table may be modified from fn; breakpoints erased before they are visited are skipped.
+     * @param fn Callback.
+     */
+    template<typename F>
+    void forEach(F&& fn) {
+        for (uintptr_t address : addresses()) {
+            if (Breakpoint_t* e = find(address)) fn(*e);
+        }
+    }
+
+private:
+    struct AlignedDelete {
+        void operator()(Breakpoint_t* p) const { ::operator delete[](p, std::align_val_t(64)); }
+    };
+
+    inline size_t slotOf(uintptr_t address) const {
+        // Fibonacci hashing; neighbouring addresses spread over the table
+        return static_cast<size_t>((static_cast<uint64_t>(address) * 0x9E3779B97F4A7C15ULL) >> shift_);
+    }
+
+    void rehash(size_t newCapacity);
+    /// Gives up the slots; the table is empty and allocates again on the next insert().
+    void release() noexcept;
+
+    std::unique_ptr<Breakpoint_t[], AlignedDelete> slots_;
+    size_t mask_ = 0;
+    size_t count_ = 0;
+    unsigned shift_ = 64;
+};
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,78 @@
+#include "bytePatch.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace RoboDBG {
+
+namespace {
+    constexpr uintptr_t PATCH_PAGE_SIZE = 0x1000;
+}
+
+size_t applyBytePatches(TargetBackend& target, std::span<BytePatch_t> patches, int onlyIf, BytePatchStats_t* stats)
+{
+    BytePatchStats_t local;
+    size_t applied = 0;
+
+    std::stable_sort(patches.begin(), patches.end(),
+                     [](const BytePatch_t& a, const BytePatch_t& b) { return a.address < b.address; });
+
+    std::vector<BYTE> buffer;
+    size_t first = 0;
+    while (first < patches.size()) {
+        // Group [first, last) = all patches on the same page
+        const uintptr_t page = patches[first].address & ~(PATCH_PAGE_SIZE - 1);
+        size_t last = first + 1;
+        while (last < patches.size() && (patches[last].address & ~(PATCH_PAGE_SIZE - 1)) == page) ++last;
+
+        const uintptr_t spanStart = patches[first].address;
+        const SIZE_T spanSize = patches[last - 1].address - spanStart + 1;
+        ++local.pages;
+
+        buffer.resize(spanSize);
+        ++local.reads;
+        if (!target.readMemory(spanStart, buffer.data(), spanSize)) {
+            for (size_t i = first; i < last; ++i) patches[i].applied = false;
+            first = last;
+            continue;
+        }
+
+        bool dirty = false;
+        for (size_t i = first; i < last; ++i) {
+            BytePatch_t& p = patches[i];
+            BYTE& cur = buffer[p.address - spanStart];
+            p.previous = cur;
+            p.applied = false;
+            if (onlyIf >= 0 && cur != static_cast<BYTE>(onlyIf)) continue;
+            if (cur != p.value) {
+                cur = p.value;
+                dirty = true;
+            }
+            p.applied = true;
+        }
+
+        if (dirty) {
+            ++local.writes;
+            if (target.writeMemory(spanStart, buffer.data(), spanSize)) {
+                target.flushInstructionCache(spanStart, spanSize);
+            } else {
+                // Write failed; only patches whose value was already in place count
+                ++local.reads;
+                const bool reread = target.readMemory(spanStart, buffer.data(), spanSize);
+                for (size_t i = first; i < last; ++i) {
+                    if (!reread || buffer[patches[i].address - spanStart] != patches[i].value) patches[i].applied = false;
+                }
+            }
+        }
+
+        for (size_t i = first; i < last; ++i) {
+            if (patches[i].applied) ++applied;
+        }
+        first = last;
+    }
+
+    if (stats) *stats = local;
+    return applied;
+}
+
+} // namespace RoboDBG
@@ -0,0 +1,56 @@
+/**
+ * @file bytePatch.h
+ * @brief Page-batched single byte patching (breakpoint install / removal)
+ * @author Milkshake
+ */
+
+#ifndef BYTEPATCH_H
+#define BYTEPATCH_H
+
+#include <cstdint>
+#include <span>
+
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    /**
+     * @struct BytePatch_t
+     * @brief One byte to write into the target.
+     */
+    struct BytePatch_t {
+        uintptr_t address;      ///< Target address.
+        BYTE value;             ///< Byte to write.
+        BYTE previous = 0;      ///< Receives the byte found at address before patching.
+        bool applied = false;   ///< Set if value is now at address.
+    };
+
+    /**
+     * @struct BytePatchStats_t
+     * @brief Number of target operations a batch needed.
+     */
+    struct BytePatchStats_t {
+        size_t pages = 0;   ///< Pages touched.
+        size_t reads = 0;   ///< readMemory calls.
+        size_t writes = 0;  ///< writeMemory calls (one flush each).
+    };
+
+    /**
+     * @brief Applies many single byte patches with one read, one write and one flush per page.
+     *
+     * Patches are sorted by address. For every page the span from the first to the last patched
+     * byte is read once, patched locally and written back once if anything changed. Patches on
+     * unreadable pages are left with applied == false. Later patches to the same address see the
+     * earlier patch as their previous byte.
+     *
+     * @param target Memory of the debuggee.
+     * @param patches Patches; reordered, previous / applied are filled in.
+     * @param onlyIf Only patch bytes currently equal to this value; -1 patches unconditionally.
+     * @param stats Optional; receives the operation counts.
+     * @return Number of patches applied.
+     */
+    size_t applyBytePatches(TargetBackend& target, std::span<BytePatch_t> patches, int onlyIf = -1, BytePatchStats_t* stats = nullptr);
+
+} // namespace RoboDBG
+
+#endif
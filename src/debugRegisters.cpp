@@ -0,0 +1,51 @@
+#include "debugRegisters.h"
+
+namespace RoboDBG {
+
+bool DebugRegisters_t::set(int slot, DWORD64 addr, int rw, int len) {
+    if (slot < 0 || slot >= DEBUG_REGISTER_SLOTS) return false;
+
+    address[slot] = addr;
+    const int shift = 16 + slot * 4;
+    dr7 &= ~(0xFULL << shift);
+    dr7 |= static_cast<DWORD64>((rw & 0b11) | ((len & 0b11) << 2)) << shift;
+    dr7 |= 1ULL << (slot * 2);
+    return true;
+}
+
+bool DebugRegisters_t::clear(int slot) {
+    if (slot < 0 || slot >= DEBUG_REGISTER_SLOTS) return false;
+
+    address[slot] = 0;
+    dr7 &= ~(1ULL << (slot * 2));
+    dr7 &= ~(0xFULL << (16 + slot * 4));
+    return true;
+}
+
+int DebugRegisters_t::find(DWORD64 addr) const {
+    for (int i = 0; i < DEBUG_REGISTER_SLOTS; ++i) {
+        if (enabled(i) && address[i] == addr) return i;
+    }
+    return -1;
+}
+
+int DebugRegisters_t::hitSlot(DWORD64 dr6) const {
+    // B bits of disabled slots can be set too (matching but not enabled conditions)
+    DWORD64 hits = dr6 & DR6_HIT_MASK;
+    for (int i = 0; hits; ++i, hits >>= 1) {
+        if ((hits & 1) && enabled(i)) return i;
+    }
+    return -1;
+}
+
+void DebugRegisters_t::load(const ThreadContext_t& ctx) {
+    for (int i = 0; i < DEBUG_REGISTER_SLOTS; ++i) address[i] = ctx.dr[i];
+    dr7 = ctx.dr[7];
+}
+
+void DebugRegisters_t::store(ThreadContext_t& ctx) const {
+    for (int i = 0; i < DEBUG_REGISTER_SLOTS; ++i) ctx.dr[i] = address[i];
+    ctx.dr[7] = dr7;
+}
+
+} // namespace RoboDBG
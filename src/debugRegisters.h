@@ -0,0 +1,95 @@
+/**
+ * @file debugRegisters.h
+ * @brief Shadow copy of a thread's x86 debug registers
+ * @author Milkshake
+ */
+
+#ifndef DEBUGREGISTERS_H
+#define DEBUGREGISTERS_H
+
+#include <cstdint>
+
+#include "platform.h"
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    constexpr int DEBUG_REGISTER_SLOTS = 4; ///< DR0–DR3.
+    constexpr DWORD64 DR6_HIT_MASK = 0xF;   ///< DR6 B0–B3: slot that triggered the #DB.
+
+    /**
+     * @struct DebugRegisters_t
+     * @brief DR0–DR3 and DR7 of one thread as last written by the debugger.
+     *
+     * Kept next to the thread so breakpoint lookups do not read the thread context. DR6 is not
+     * shadowed; it changes on every #DB and is read once per single-step exception.
+     */
+    struct DebugRegisters_t {
+        DWORD64 address[DEBUG_REGISTER_SLOTS] = {}; ///< DR0–DR3.
+        DWORD64 dr7 = 0;                            ///< Enables (L0–L3), R/W and LEN fields.
+
+        /**
+         * @brief Checks if the local enable bit of a slot is set.
+         * @param slot Slot 0–3.
+         */
+        inline bool enabled(int slot) const { return (dr7 >> (slot * 2)) & 1; }
+
+        /**
+         * @brief Returns the R/W field of a slot (0 execute, 1 write, 2 I/O, 3 read/write).
+         * @param slot Slot 0–3.
+         */
+        inline int type(int slot) const { return static_cast<int>((dr7 >> (16 + slot * 4)) & 0b11); }
+
+        /**
+         * @brief Returns the LEN field of a slot.
+         * @param slot Slot 0–3.
+         */
+        inline int length(int slot) const { return static_cast<int>((dr7 >> (18 + slot * 4)) & 0b11); }
+
+        /**
+         * @brief Arms a slot.
+         * @param slot Slot 0–3.
+         * @param addr Address to watch.
+         * @param rw R/W field.
+         * @param len LEN field.
+         * @return false if slot is out of range.
+         */
+        bool set(int slot, DWORD64 addr, int rw, int len);
+
+        /**
+         * @brief Disarms a slot and zeroes its address.
+         * @param slot Slot 0–3.
+         * @return false if slot is out of range.
+         */
+        bool clear(int slot);
+
+        /**
+         * @brief Finds the enabled slot watching an address.
+         * @param addr Address to look up.
+         * @return Slot 0–3, or -1 if none.
+         */
+        int find(DWORD64 addr) const;
+
+        /**
+         * @brief Maps DR6 of a #DB to the slot that triggered it.
+         * @param dr6 DR6 as read from the faulting thread.
+         * @return Lowest enabled slot whose B bit is set, or -1 (e.g. a trap flag step).
+         */
+        int hitSlot(DWORD64 dr6) const;
+
+        /**
+         * @brief Copies DR0–DR3 and DR7 from a context.
+         * @param ctx Context holding CONTEXT_PART_DEBUG.
+         */
+        void load(const ThreadContext_t& ctx);
+
+        /**
+         * @brief Copies DR0–DR3 and DR7 into a context; DR6 is left alone.
+         * @param ctx Context holding CONTEXT_PART_DEBUG.
+         */
+        void store(ThreadContext_t& ctx) const;
+    };
+
+} // namespace RoboDBG
+
+#endif
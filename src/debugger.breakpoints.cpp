@@ -1,23 +1,161 @@
 #include "debugger.h"
+#include "bytePatch.h"
+#include "instructionDecoder.h"
+#include <algorithm>
 #include <vector>
 namespace RoboDBG {
 
+namespace {
+    constexpr SIZE_T SCRATCH_SLOT_SIZE  = 64;     // >= MAX_RELOCATED_LENGTH, one cache line
+    constexpr SIZE_T SCRATCH_BLOCK_SIZE = 0x1000; // 64 slots
+    constexpr uintptr_t ALLOCATION_GRANULARITY = 0x10000; // VirtualAllocEx base alignment
+
+#ifdef ROBODBG_X64
+    constexpr bool TARGET_X64 = true;
+#else
+    constexpr bool TARGET_X64 = false;
+#endif
+
+    // Free range of size bytes closest to near, so RIP-relative operands can reach it from there
+    uintptr_t findFreeNear(std::vector<MemoryRegion_t> regions, uintptr_t near, SIZE_T size)
+    {
+        regions.erase(std::remove_if(regions.begin(), regions.end(),
+                                     [](const MemoryRegion_t& r) { return r.State == MEM_FREE; }),
+                      regions.end());
+        std::sort(regions.begin(), regions.end(), [](const MemoryRegion_t& a, const MemoryRegion_t& b) {
+            return a.BaseAddress < b.BaseAddress;
+        });
+
+        uintptr_t best = 0;
+        uintptr_t bestDistance = ~uintptr_t(0);
+        auto consider = [&](uintptr_t start, uintptr_t end) {
+            const uintptr_t first = (start + ALLOCATION_GRANULARITY - 1) & ~(ALLOCATION_GRANULARITY - 1);
+            if (end < size || first < start) return;
+            const uintptr_t last = (end - size) & ~(ALLOCATION_GRANULARITY - 1);
+            for (uintptr_t candidate : { first, last }) {
+                if (candidate < first || candidate > end - size || candidate + size < candidate) continue;
+                const uintptr_t distance = candidate > near ? candidate - near : near - candidate;
+                if (distance < bestDistance) {
+                    best = candidate;
+                    bestDistance = distance;
+                }
+            }
+        };
+
+        uintptr_t gapStart = ALLOCATION_GRANULARITY;
+        for (const auto& r : regions) {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(r.BaseAddress);
+            if (base > gapStart) consider(gapStart, base);
+            gapStart = std::max(gapStart, base + r.RegionSize);
+        }
+        return best;
+    }
+    // DR7 encodings differ from the public enums: R/W 2 is I/O and LEN 2 is 8 bytes
+    int accessTypeToRw(AccessType type)
+    {
+        return type == AccessType::READWRITE ? 0b11 : static_cast<int>(type);
+    }
+
+    AccessType rwToAccessType(int rw)
+    {
+        return rw == 0b11 ? AccessType::READWRITE : static_cast<AccessType>(rw);
+    }
+
+    int lengthToLen(BreakpointLength len)
+    {
+        switch (len) {
+        case BreakpointLength::DWORD: return 0b11;
+        case BreakpointLength::QWORD: return 0b10;
+        default: return static_cast<int>(len);
+        }
+    }
+
+    BreakpointLength lenToLength(int len)
+    {
+        switch (len) {
+        case 0b11: return BreakpointLength::DWORD;
+        case 0b10: return BreakpointLength::QWORD;
+        default: return static_cast<BreakpointLength>(len);
+        }
+    }
+}
+
 void Debugger::setBreakpoint(LPVOID address)
 {
-    BYTE original;
-    SIZE_T read;
+    BYTE original = 0;
+    uintptr_t addr = reinterpret_cast<uintptr_t>(address);
 
     if (this->verbose) {
         std::cout << "[*] Breakpoint set at " << std::hex << address << std::endl;
     }
 
-    ReadProcessMemory(hProcessGlobal, address, &original, 1, &read);
+    retiredBreakpoints.erase(addr);
+    readTarget(addr, &original, 1);
     if (original != 0xCC) {
         BYTE int3 = 0xCC;
-        breakpoints[address] = original; // TODO
-        WriteProcessMemory(hProcessGlobal, address, &int3, 1, nullptr);
+        invalidateScratchSlots();
+        Breakpoint_t* bp = breakpoints.insert(addr, original);
+        if (writeTarget(addr, &int3, 1) && bp) bp->flags |= BP_FLAG_ARMED;
     }
-    FlushInstructionCache(hProcessGlobal, address, 1);
+    backend->flushInstructionCache(addr, 1);
+}
+
+size_t Debugger::setBreakpoints(std::span<const uintptr_t> addresses)
+{
+    std::vector<BytePatch_t> patches;
+    patches.reserve(addresses.size());
+    for (uintptr_t address : addresses) {
+        patches.push_back(BytePatch_t{ address, 0xCC });
+    }
+
+    BytePatchStats_t stats;
+    applyBytePatches(*backend, patches, -1, &stats);
+    for (const auto& p : patches) discardCachedMemory(p.address, 1);
+
+    size_t armed = 0;
+    invalidateScratchSlots();
+    breakpoints.reserve(breakpoints.size() + patches.size());
+    for (const auto& p : patches) {
+        if (!p.applied) {
+            if (this->verbose) std::cerr << "[-] Failed to set breakpoint at 0x" << std::hex << p.address << std::dec << "\n";
+            continue;
+        }
+        ++armed;
+        retiredBreakpoints.erase(p.address);
+        if (p.previous != 0xCC) { // already a breakpoint (or a duplicate address): keep the recorded byte
+            breakpoints.insert(p.address, p.previous)->flags |= BP_FLAG_ARMED;
+        }
+    }
+
+    if (this->verbose) {
+        std::cout << "[*] " << armed << " breakpoints set (" << stats.pages << " pages, "
+                  << stats.writes << " writes)" << std::endl;
+    }
+    return armed;
+}
+
+size_t Debugger::removeBreakpoints(std::span<const uintptr_t> addresses)
+{
+    std::vector<BytePatch_t> patches;
+    patches.reserve(addresses.size());
+    for (uintptr_t address : addresses) {
+        const Breakpoint_t* bp = breakpoints.find(address);
+        if (!bp) continue;
+        patches.push_back(BytePatch_t{ address, bp->original });
+    }
+
+    // Only replace bytes that still hold our int3
+    applyBytePatches(*backend, patches, 0xCC);
+    for (const auto& p : patches) discardCachedMemory(p.address, 1);
+
+    size_t removed = 0;
+    for (const auto& p : patches) {
+        if (!breakpoints.erase(p.address)) continue;
+        // Other threads may have hit the int3 already; their events are still to come
+        retireBreakpoint(p.address);
+        ++removed;
+    }
+    return removed;
 }
 
 bool Debugger::setHardwareBreakpointOnThread(hwBp_t bp)
@@ -32,57 +170,29 @@ bool Debugger::setHardwareBreakpointOnThread(hwBp_t bp)
         return false;
     }
 
-    CONTEXT ctx = {};
-    ctx.ContextFlags = CONTEXT_DEBUG_REGISTERS;
-    if (!GetThreadContext(hThread, &ctx)) {
-        std::cerr << "[-] GetThreadContext failed: " << GetLastError() << "\n";
+    const int slot = static_cast<int>(bp.reg);
+    if (slot < 0 || slot >= DEBUG_REGISTER_SLOTS) {
+        std::cerr << "[-] Invalid debug register index: " << slot << "\n";
         return false;
     }
 
-    // Assign address to correct DRx
-    switch (bp.reg) {
-    case DRReg::DR0:
-        ctx.Dr0 = reinterpret_cast<DWORD_PTR>(bp.address);
-        break;
-    case DRReg::DR1:
-        ctx.Dr1 = reinterpret_cast<DWORD_PTR>(bp.address);
-        break;
-    case DRReg::DR2:
-        ctx.Dr2 = reinterpret_cast<DWORD_PTR>(bp.address);
-        break;
-    case DRReg::DR3:
-        ctx.Dr3 = reinterpret_cast<DWORD_PTR>(bp.address);
-        break;
-    default:
-        std::cerr << "[-] Invalid debug register index: " << static_cast<int>(bp.reg) << "\n";
+    ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_DEBUG);
+    if (!ctx) {
+        std::cerr << "[-] GetThreadContext failed\n";
         return false;
     }
 
-    // Enable local breakpoint (L0–L3)
-    ctx.Dr7 |= (1 << (static_cast<int>(bp.reg) * 2));
-
-    // Set type and size in DR7
-    // Bits 16-31 control type and length for DR0-DR3
-    // Each DR uses 4 bits: [LEN1][LEN0][R/W1][R/W0]
-    const int shift = 16 + static_cast<int>(bp.reg) * 4;
-    ctx.Dr7 &= ~(0xF << shift); // Clear previous settings
-    ctx.Dr7 |= ((static_cast<int>(bp.type) | (static_cast<int>(bp.len) << 2)) << shift); // Set new type and length
+    // Start from the thread's registers so slots we did not set survive; DR6 is left alone
+    DebugRegisters_t dr;
+    dr.load(*ctx);
+    dr.set(slot, reinterpret_cast<uintptr_t>(bp.address), accessTypeToRw(bp.type), lengthToLen(bp.len));
+    dr.store(*ctx);
 
-    if (SuspendThread(hThread) == (DWORD)-1) {
-        std::cerr << "[-] SuspendThread failed: " << GetLastError() << "\n";
+    if (!storeContext(hThread, CONTEXT_PART_DEBUG)) {
         return false;
     }
 
-    if (!SetThreadContext(hThread, &ctx)) {
-        std::cerr << "[-] SetThreadContext failed: " << GetLastError() << "\n";
-        ResumeThread(hThread);
-        return false;
-    }
-
-    if (ResumeThread(hThread) == (DWORD)-1) {
-        std::cerr << "[-] ResumeThread failed: " << GetLastError() << "\n";
-        return false;
-    }
+    if (ThreadInfo_t* thread = findThread(hThread)) thread->debugRegisters = dr;
 
     // Save to global tracker
     hwBreakpoints[bp.address] = bp;
@@ -93,7 +203,6 @@ bool Debugger::setHardwareBreakpoint(hwBp_t bp)
 {
     bool allSucceeded = true;
 
-    actualizeThreadList();
     // Validate register index
     if (static_cast<int>(bp.reg) < 0 || static_cast<int>(bp.reg) > 3) {
         std::cerr << "[-] Invalid debug register DR" << static_cast<int>(bp.reg) << "\n";
@@ -125,16 +234,16 @@ bool Debugger::setHardwareBreakpoint(hwBp_t bp)
         lenStr = "2 bytes";
         break;
     case 2:
-        lenStr = "8 bytes";
+        lenStr = "4 bytes";
         break;
     case 3:
-        lenStr = "4 bytes";
+        lenStr = "8 bytes";
         break;
     default:
         lenStr = "unknown";
         break;
     }
-    actualizeThreadList();
+    if (threads.empty()) actualizeThreadList(); // called before the first debug event
     for (const auto& thread : threads) {
         hwBp_t perThreadBp = bp;
         perThreadBp.hThread = thread.hThread;
@@ -155,58 +264,26 @@ bool Debugger::setHardwareBreakpoint(hwBp_t bp)
 // Helper function to clear a hardware breakpoint
 bool Debugger::clearHardwareBreakpointOnThread(HANDLE hThread, DRReg reg)
 {
-    if (static_cast<int>(reg) < 0 || static_cast<int>(reg) > 3) {
-        std::cerr << "[-] Invalid debug register DR" << static_cast<int>(reg) << "\n";
+    const int slot = static_cast<int>(reg);
+    if (slot < 0 || slot >= DEBUG_REGISTER_SLOTS) {
+        std::cerr << "[-] Invalid debug register DR" << slot << "\n";
         return false;
     }
 
-    CONTEXT ctx = {};
-    ctx.ContextFlags = CONTEXT_DEBUG_REGISTERS;
-
-    if (!GetThreadContext(hThread, &ctx)) {
-        std::cerr << "[-] GetThreadContext failed: " << GetLastError() << "\n";
+    ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_DEBUG);
+    if (!ctx) {
+        std::cerr << "[-] GetThreadContext failed\n";
         return false;
     }
 
-    LPVOID oldAddr = nullptr;
-    switch (reg) {
-    case DRReg::DR0:
-        oldAddr = (LPVOID)ctx.Dr0;
-        ctx.Dr0 = 0;
-        break;
-    case DRReg::DR1:
-        oldAddr = (LPVOID)ctx.Dr1;
-        ctx.Dr1 = 0;
-        break;
-    case DRReg::DR2:
-        oldAddr = (LPVOID)ctx.Dr2;
-        ctx.Dr2 = 0;
-        break;
-    case DRReg::DR3:
-        oldAddr = (LPVOID)ctx.Dr3;
-        ctx.Dr3 = 0;
-        break;
-    }
-
-    ctx.Dr7 &= ~(1 << (static_cast<int>(reg) * 2)); // Disable local enable
-    ctx.Dr7 &= ~(0xF << (16 + static_cast<int>(reg) * 4)); // Clear type/length
+    DebugRegisters_t dr;
+    dr.load(*ctx);
+    LPVOID oldAddr = reinterpret_cast<LPVOID>(dr.address[slot]);
+    dr.clear(slot);
+    dr.store(*ctx);
 
-    if (SuspendThread(hThread) == (DWORD)-1) {
-        std::cerr << "[-] SuspendThread failed: " << GetLastError() << "\n";
-        return false;
-    }
-
-    bool success = true;
-
-    if (!SetThreadContext(hThread, &ctx)) {
-        std::cerr << "[-] SetThreadContext failed: " << GetLastError() << "\n";
-        success = false;
-    }
-
-    if (ResumeThread(hThread) == (DWORD)-1) {
-        std::cerr << "[-] ResumeThread failed: " << GetLastError() << "\n";
-        success = false;
-    }
+    const bool success = storeContext(hThread, CONTEXT_PART_DEBUG);
+    if (ThreadInfo_t* thread = findThread(hThread)) thread->debugRegisters = dr;
 
     if (oldAddr && hwBreakpoints.count(oldAddr)) {
         const hwBp_t& stored = hwBreakpoints[oldAddr];
@@ -221,7 +298,7 @@ bool Debugger::clearHardwareBreakpoint(DRReg reg)
 {
     bool allSucceeded = true;
 
-    actualizeThreadList();
+    if (threads.empty()) actualizeThreadList();
     for (const auto& thread : threads) {
         if (!clearHardwareBreakpointOnThread(thread.hThread, reg))
             allSucceeded = false;
@@ -230,49 +307,27 @@ bool Debugger::clearHardwareBreakpoint(DRReg reg)
     return allSucceeded;
 }
 
+hwBp_t Debugger::hardwareBreakpointOf(HANDLE hThread, const DebugRegisters_t& dr, int slot)
+{
+    return hwBp_t{
+        hThread,
+        reinterpret_cast<LPVOID>(dr.address[slot]),
+        static_cast<DRReg>(slot),
+        rwToAccessType(dr.type(slot)),
+        lenToLength(dr.length(slot))
+    };
+}
+
+// The queries below are answered from the per-thread shadows and never read a thread context
+
 std::vector<hwBp_t> Debugger::getHardwareBreakpoints()
 {
     std::vector<hwBp_t> result;
 
     for (const auto& thread : threads) {
-        CONTEXT ctx = {};
-        ctx.ContextFlags = CONTEXT_DEBUG_REGISTERS;
-
-        if (!GetThreadContext(thread.hThread, &ctx))
-            continue;
-
-        for (int i = 0; i < 4; ++i) {
-            bool enabled = ctx.Dr7 & (1 << (i * 2));
-            if (!enabled)
-                continue;
-
-            LPVOID addr = nullptr;
-            switch (i) {
-            case 0:
-                addr = (LPVOID)ctx.Dr0;
-                break;
-            case 1:
-                addr = (LPVOID)ctx.Dr1;
-                break;
-            case 2:
-                addr = (LPVOID)ctx.Dr2;
-                break;
-            case 3:
-                addr = (LPVOID)ctx.Dr3;
-                break;
-            }
-
-            int type = (ctx.Dr7 >> (16 + i * 4)) & 0b11;
-            int len = (ctx.Dr7 >> (18 + i * 4)) & 0b11;
-
-            hwBp_t bp = {
-                thread.hThread,
-                addr,
-                static_cast<DRReg>(i),
-                static_cast<AccessType>(type),
-                static_cast<BreakpointLength>(len)
-            };
-            result.push_back(bp);
+        for (int i = 0; i < DEBUG_REGISTER_SLOTS; ++i) {
+            if (thread.debugRegisters.enabled(i))
+                result.push_back(hardwareBreakpointOf(thread.hThread, thread.debugRegisters, i));
         }
     }
 
@@ -281,48 +336,13 @@ std::vector<hwBp_t> Debugger::getHardwareBreakpoints()
 
 hwBp_t Debugger::getBreakpointByReg(DRReg reg)
 {
-    for (const auto& thread : threads) {
-        CONTEXT ctx = {};
-        ctx.ContextFlags = CONTEXT_DEBUG_REGISTERS;
-
-        if (!GetThreadContext(thread.hThread, &ctx))
-            continue;
+    const int slot = static_cast<int>(reg);
+    if (slot < 0 || slot >= DEBUG_REGISTER_SLOTS)
+        return {}; // Invalid register index
 
-        bool enabled = ctx.Dr7 & (1 << (static_cast<int>(reg) * 2));
-        if (!enabled)
-            continue;
-
-        LPVOID addr = nullptr;
-        switch (reg) {
-        case DRReg::DR0:
-            addr = (LPVOID)ctx.Dr0;
-            break;
-        case DRReg::DR1:
-            addr = (LPVOID)ctx.Dr1;
-            break;
-        case DRReg::DR2:
-            addr = (LPVOID)ctx.Dr2;
-            break;
-        case DRReg::DR3:
-            addr = (LPVOID)ctx.Dr3;
-            break;
-        default:
-            return {}; // Invalid register index
-        }
-
-        int type = (ctx.Dr7 >> (16 + static_cast<int>(reg) * 4)) & 0b11;
-        int len = (ctx.Dr7 >> (18 + static_cast<int>(reg) * 4)) & 0b11;
-        if (len < 0 || len > 3)
-            len = 0;
-
-        hwBp_t bp = {
-            thread.hThread,
-            addr,
-            reg,
-            static_cast<AccessType>(type),
-            static_cast<BreakpointLength>(len)
-        };
-        return bp;
+    for (const auto& thread : threads) {
+        if (thread.debugRegisters.enabled(slot))
+            return hardwareBreakpointOf(thread.hThread, thread.debugRegisters, slot);
     }
 
     return {}; // Not found
@@ -331,20 +351,9 @@ hwBp_t Debugger::getBreakpointByReg(DRReg reg)
 DRReg Debugger::isHardwareBreakpointAt(LPVOID address)
 {
     for (const auto& thread : threads) {
-        CONTEXT ctx = {};
-        ctx.ContextFlags = CONTEXT_DEBUG_REGISTERS;
-
-        if (!GetThreadContext(thread.hThread, &ctx))
-            continue;
-
-        if ((ctx.Dr7 & 0x1) && ctx.Dr0 == (DWORD_PTR)address)
-            return DRReg::DR0;
-        if ((ctx.Dr7 & 0x4) && ctx.Dr1 == (DWORD_PTR)address)
-            return DRReg::DR1;
-        if ((ctx.Dr7 & 0x10) && ctx.Dr2 == (DWORD_PTR)address)
-            return DRReg::DR2;
-        if ((ctx.Dr7 & 0x40) && ctx.Dr3 == (DWORD_PTR)address)
-            return DRReg::DR3;
+        const int slot = thread.debugRegisters.find(reinterpret_cast<uintptr_t>(address));
+        if (slot >= 0)
+            return static_cast<DRReg>(slot);
     }
 
     return DRReg::NOP;
@@ -353,18 +362,17 @@ DRReg Debugger::isHardwareBreakpointAt(LPVOID address)
 int Debugger::verifyBreakpoints( )
 {
     int erased=0;
-    SIZE_T nread;
+    SIZE_T nread = 0;
     BYTE cur = 0x00;
-    for(size_t i=0; i < breakpoints.size( ); ++i)
+    for (uintptr_t address : breakpoints.addresses( ))
     {
-        auto bp = std::next(breakpoints.begin(), i);
-        if (!ReadProcessMemory(hProcessGlobal, static_cast<LPCVOID>(bp->first), &cur, sizeof(cur), &nread )) {
-            breakpoints.erase(std::next(breakpoints.begin(), i)); //memory not accessible, remove
+        if (!readTarget(address, &cur, sizeof(cur), &nread )) {
+            breakpoints.erase(address); //memory not accessible, remove
             ++erased;
             continue;
         }
         if( cur != 0xCC || nread != 1) {
-            breakpoints.erase(std::next(breakpoints.begin(), i)); //not a breakpoint anymore, remove
+            breakpoints.erase(address); //not a breakpoint anymore, remove
             ++erased;
             continue;
         }
@@ -372,16 +380,51 @@ int Debugger::verifyBreakpoints( )
     return erased;
 }
 
+void Debugger::retireBreakpoint(uintptr_t address)
+{
+    constexpr uint64_t STOPS_PER_THREAD = 3;
+    const uint64_t until = stopCount + STOPS_PER_THREAD * std::max<uint64_t>(threads.size(), 1);
+    retiredBreakpoints[address] = until;
+    retiredSweepAt = std::min(retiredSweepAt, until);
+}
+
+void Debugger::sweepRetiredBreakpoints()
+{
+    retiredSweepAt = UINT64_MAX;
+    for (auto it = retiredBreakpoints.begin(); it != retiredBreakpoints.end();) {
+        if (it->second <= stopCount) {
+            it = retiredBreakpoints.erase(it);
+        } else {
+            retiredSweepAt = std::min(retiredSweepAt, it->second);
+            ++it;
+        }
+    }
+}
+
+void Debugger::rearmAfterStep(uintptr_t address)
+{
+    TraceScope span(tracer.get(), TraceCategory::BREAKPOINT, "rearm", "address", address);
+    // Removed while being stepped over
+    if (!breakpoints.contains(address)) return;
+
+    // Re-arming now would make threads still stepping over the original instruction hit it twice
+    for (const auto& [tid, state] : stepStates) {
+        if (state.bpAddress == address) return;
+    }
+    setBreakpoint(address);
+}
+
 void Debugger::restoreBreakpoint(LPVOID address)
 {
-    auto it = breakpoints.find(address);
-    if (it != breakpoints.end()) {
+    TraceScope span(tracer.get(), TraceCategory::BREAKPOINT, "restore_breakpoint", "address",
+                    reinterpret_cast<uintptr_t>(address));
+    Breakpoint_t* bp = breakpoints.find(reinterpret_cast<uintptr_t>(address));
+    if (bp) {
         BYTE cur = 0;
         SIZE_T nread = 0;
-        if (!ReadProcessMemory(hProcessGlobal, address, &cur, sizeof(cur), &nread) || nread != sizeof(cur)) {
+        if (!readTarget(reinterpret_cast<uintptr_t>(address), &cur, sizeof(cur), &nread) || nread != sizeof(cur)) {
             if (this->verbose)
-                std::cerr << "[!] ReadProcessMemory failed at " << address
-                          << " err=" << GetLastError() << "\n";
+                std::cerr << "[!] ReadProcessMemory failed at " << address << "\n";
             return;
         }
 
@@ -395,13 +438,103 @@ void Debugger::restoreBreakpoint(LPVOID address)
             return;
         }
         if (this->verbose)
-            std::cout << "[~] Replacing breakpoint " << std::hex << static_cast<int>(it->second) << " at " << std::hex << address << std::endl;
-        WriteProcessMemory(hProcessGlobal, address, &it->second, 1, nullptr);
-        FlushInstructionCache(hProcessGlobal, address, 1);
+            std::cout << "[~] Replacing breakpoint " << std::hex << static_cast<int>(bp->original) << " at " << std::hex << address << std::endl;
+        writeTarget(reinterpret_cast<uintptr_t>(address), &bp->original, 1);
+        backend->flushInstructionCache(reinterpret_cast<uintptr_t>(address), 1);
+        bp->flags &= ~BP_FLAG_ARMED;
 
     } else {
         printf("WARNING: BREAKPOINT NOT FOUND!\n");
     }
 }
 
+void Debugger::setDisplacedStepping(bool enabled)
+{
+    displacedStepping = enabled;
+}
+
+ScratchSlot_t* Debugger::scratchSlotFor(DWORD threadId, uintptr_t near)
+{
+    auto it = scratchSlots.find(threadId);
+    if (it != scratchSlots.end()) return &it->second;
+
+    if (freeScratchSlots.empty()) {
+        const uintptr_t hint = findFreeNear(getMemoryPages(), near, SCRATCH_BLOCK_SIZE);
+        const uintptr_t block = backend->allocateMemory(hint, SCRATCH_BLOCK_SIZE, PAGE_EXECUTE_READWRITE);
+        if (!block) return nullptr;
+        refreshAddressSpace(block, SCRATCH_BLOCK_SIZE);
+        discardCachedMemory(block, SCRATCH_BLOCK_SIZE);
+        if (this->verbose) std::cout << "[*] Scratch block for displaced stepping at 0x" << std::hex << block << std::dec << std::endl;
+
+        // Highest first, so slots are handed out in ascending order
+        for (SIZE_T offset = SCRATCH_BLOCK_SIZE; offset >= SCRATCH_SLOT_SIZE; offset -= SCRATCH_SLOT_SIZE) {
+            freeScratchSlots.push_back(block + offset - SCRATCH_SLOT_SIZE);
+        }
+    }
+
+    ScratchSlot_t& slot = scratchSlots[threadId];
+    slot.address = freeScratchSlots.back();
+    slot.bpAddress = 0;
+    freeScratchSlots.pop_back();
+    return &slot;
+}
+
+void Debugger::releaseScratchSlot(DWORD threadId)
+{
+    auto it = scratchSlots.find(threadId);
+    if (it == scratchSlots.end()) return;
+    freeScratchSlots.push_back(it->second.address);
+    scratchSlots.erase(it);
+}
+
+void Debugger::invalidateScratchSlots()
+{
+    for (auto& [tid, slot] : scratchSlots) slot.bpAddress = 0;
+}
+
+bool Debugger::displaceStep(DWORD threadId, HANDLE hThread, uintptr_t address)
+{
+    TraceScope span(tracer.get(), TraceCategory::BREAKPOINT, "displaced_step", "address", address);
+    Breakpoint_t* bp = breakpoints.find(address);
+    if (!bp || (bp->flags & BP_FLAG_NO_DISPLACE)) return false;
+
+    ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_CONTROL);
+    if (!ctx) return false;
+    // onBreakpoint moved the thread away; there is nothing to step over
+    if (ctx->ip != address) return true;
+
+    ScratchSlot_t* slot = scratchSlotFor(threadId, address);
+    if (!slot) {
+        std::cerr << "[-] Failed to allocate scratch memory, displaced stepping disabled\n";
+        displacedStepping = false;
+        return false;
+    }
+
+    if (slot->bpAddress != address) {
+        // Decode the original bytes, not the int3s in the target
+        BYTE code[MAX_INSTRUCTION_LENGTH] = {};
+        SIZE_T got = 0;
+        readTarget(address, code, sizeof(code), &got);
+        for (SIZE_T i = 0; i < got; ++i) {
+            if (const Breakpoint_t* other = breakpoints.find(address + i)) code[i] = other->original;
+        }
+
+        BYTE relocated[MAX_RELOCATED_LENGTH];
+        DecodedInstruction_t insn;
+        const size_t n = relocateInstruction(code, got, address, slot->address, TARGET_X64, relocated, sizeof(relocated), &insn);
+        if (n == 0) {
+            // Only RIP-relative operands depend on the slot; anything else never relocates
+            if (!(insn.flags & INSN_RIP_RELATIVE)) bp->flags |= BP_FLAG_NO_DISPLACE;
+            if (this->verbose) std::cout << "[~] Cannot displace instruction at 0x" << std::hex << address << std::dec << "\n";
+            return false;
+        }
+        if (!writeTarget(slot->address, relocated, n)) return false;
+        backend->flushInstructionCache(slot->address, n);
+        slot->bpAddress = address;
+    }
+
+    ctx->ip = slot->address;
+    return storeContext(hThread, CONTEXT_PART_CONTROL);
+}
+
 }
@@ -129,6 +129,31 @@ namespace RoboDBG {
         std::cout << "    Code: " << std::dec << code << "\n";
     }
 
+    void Debugger::onStartEvent(EventInfo& event) {
+        onStart(event.imageBase(), event.entryPoint());
+    }
+
+    bool Debugger::onDLLLoadEvent(EventInfo& event) {
+        return onDLLLoad(event.imageBase(), event.moduleName(), event.entryPoint());
+    }
+
+    void Debugger::onDLLUnloadEvent(EventInfo& event) {
+        onDLLUnload(event.imageBase(), event.moduleName());
+    }
+
+    void Debugger::onDebugStringEvent(EventInfo& event) {
+        onDebugString(event.debugString());
+    }
+
+    void Debugger::onExceptionEvent(EventInfo& event) {
+        const ExceptionRecord_t record = event.exception();
+        if (record.code == EXCEPTION_ACCESS_VIOLATION) {
+            onAccessViolation(record.address, static_cast<uintptr_t>(record.info[1]), static_cast<long>(record.info[0]));
+        } else {
+            onUnknownException(record.address, record.code);
+        }
+    }
+
     BreakpointAction Debugger::onHardwareBreakpoint(uintptr_t address, HANDLE hThread, DRReg reg) {
         if (this->verbose) {
             std::cout << "[*] Hardware Breakpoint\n";
@@ -140,5 +165,9 @@ namespace RoboDBG {
         return RESTORE;
     }
 
+    void Debugger::onMetrics(const MetricsSnapshot_t& snapshot) {
+        std::cout << formatMetrics(snapshot) << std::flush;
+    }
+
 } // namespace RoboDBG
 
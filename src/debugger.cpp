@@ -5,42 +5,21 @@ namespace RoboDBG {
 
 Debugger::Debugger( ) {
     this->verbose = false;
+    this->backend = createNativeBackend(this->verbose);
 }
 
 Debugger::Debugger( bool verbose) {
     this->verbose = verbose;
+    this->backend = createNativeBackend(this->verbose);
 }
 
-bool Debugger::hideDebugger( ) {
-    PROCESS_BASIC_INFORMATION pbi = {};
-    ULONG retLen;
-
-    NTSTATUS status = NtQueryInformationProcess(
-        hProcessGlobal,
-        ProcessBasicInformation,
-        &pbi,
-        sizeof(pbi),&retLen
-    );
-
-    if (status != 0) {
-        std::cerr << "[-] NtQueryInformationProcess failed\n";
-        return false;
-    }
-
-    // PEB is at this address in remote process
-    BYTE beingDebugged = 0;
-    SIZE_T bytesWritten = 0;
-
-    // BeingDebugged is at offset 0x2 of the PEB
-    LPVOID pebDebugFlagAddr = (LPBYTE)pbi.PebBaseAddress + 2;
-
-    // Write zero to the flag
-    if (!WriteProcessMemory(hProcessGlobal, pebDebugFlagAddr, &beingDebugged, sizeof(beingDebugged), &bytesWritten)) {
-        std::cerr << "[-] WriteProcessMemory failed: " << GetLastError() << "\n";
-        return false;
-    }
+Debugger::Debugger( std::unique_ptr<TargetBackend> backend, bool verbose) {
+    this->verbose = verbose;
+    this->backend = std::move(backend);
+}
 
-    return true;
+bool Debugger::hideDebugger( ) {
+    return backend->hideDebugger( );
 }
 
 uintptr_t Debugger::ASLR(LPVOID address) {
@@ -53,22 +32,17 @@ uintptr_t Debugger::ASLR(uintptr_t address) {
 
 // Attach to an existing process
 int Debugger::attach(std::string exeName) {
-    DWORD pid = Util::findProcessId(exeName);
+    DWORD pid = backend->findProcessId(exeName);
     if (pid == 0) {
         std::cerr << "[-] Process not found: " << exeName << std::endl;
         return -1;
     }
     std::cout << "[+] Attached to " << pid << std::endl;
-    if (!DebugActiveProcess(pid)) {
-        std::cerr << "[-] Failed to attach to process: " << GetLastError() << std::endl;
+    if (!backend->attach(pid)) {
         return -1;
     }
 
-    hProcessGlobal = OpenProcess(PROCESS_ALL_ACCESS, FALSE, pid);
-    if (hProcessGlobal == NULL) {
-        std::cerr << "[-] Failed to open process: " << GetLastError() << std::endl;
-        return -1;
-    }
+    hProcessGlobal = backend->getProcessHandle();
     debuggedPid = pid;
     initPlugins( );
     onAttach( hProcessGlobal );
@@ -81,16 +55,11 @@ int Debugger::attach(DWORD pid) {
         return -1;
     }
     std::cout << "[+] Attach to " << pid << std::endl;
-    if (!DebugActiveProcess(pid)) {
-        std::cerr << "[-] Failed to attach to process: " << GetLastError() << std::endl;
+    if (!backend->attach(pid)) {
         return -1;
     }
 
-    hProcessGlobal = OpenProcess(PROCESS_ALL_ACCESS, FALSE, pid);
-    if (hProcessGlobal == NULL) {
-        std::cerr << "[-] Failed to open process: " << GetLastError() << std::endl;
-        return -1;
-    }
+    hProcessGlobal = backend->getProcessHandle();
     debuggedPid = pid;
     initPlugins( );
     onAttach( hProcessGlobal );
@@ -99,72 +68,27 @@ int Debugger::attach(DWORD pid) {
 
 bool Debugger::detach(  ) {
     // Detach the debugger
-    if (!DebugActiveProcessStop(debuggedPid)) {
-        std::cerr << "[-] Failed to detach debugger. Error: " << GetLastError() << std::endl;
+    if (!backend->detach()) {
         return false;
     }
+    releaseThreads();
     this->dbgLoop = false;
     return true;
 }
 
 // Start a new process under debug control
 int Debugger::start(std::string exeName) {
-    STARTUPINFO si = { sizeof(si) };
-    PROCESS_INFORMATION pi;
-
-    if (!CreateProcessA(
-        NULL,
-        const_cast<LPSTR>(exeName.c_str()),
-                       NULL,
-                       NULL,
-                       FALSE,
-                       DEBUG_ONLY_THIS_PROCESS,
-                       NULL,
-                       NULL,
-                       &si,
-                       &pi)) {
-        std::cerr << "[-] CreateProcess failed: " << GetLastError() << std::endl;
-        return -1;
-                       }
-
-    hProcessGlobal = pi.hProcess;
-    hThreadGlobal  = pi.hThread;
-    initPlugins( );
-    return 0;
+    return start(exeName, {});
 }
 
 int Debugger::start(std::string exeName, const std::vector<std::string>& args) {
-    STARTUPINFO si = { sizeof(si) };
-    PROCESS_INFORMATION pi{};
-
-    // Build the full command line
-    std::string cmdLine = "\"" + exeName + "\""; // quote exe path in case it has spaces
-    for (const auto& arg : args) {
-        cmdLine += " " + arg;
-    }
-
-    // CreateProcess requires a modifiable LPSTR
-    std::vector<char> cmdLineMutable(cmdLine.begin(), cmdLine.end());
-    cmdLineMutable.push_back('\0');
-
-    if (!CreateProcessA(
-        nullptr,
-        cmdLineMutable.data(),
-                        nullptr,
-                        nullptr,
-                        FALSE,
-                        DEBUG_ONLY_THIS_PROCESS,
-                        nullptr,
-                        nullptr,
-                        &si,
-                        &pi
-    )) {
-        std::cerr << "[-] CreateProcess failed: " << GetLastError() << std::endl;
+    if (!backend->start(exeName, args)) {
         return -1;
     }
 
-    hProcessGlobal = pi.hProcess;
-    hThreadGlobal  = pi.hThread;
+    hProcessGlobal = backend->getProcessHandle();
+    hThreadGlobal  = backend->getMainThreadHandle();
+    debuggedPid    = backend->getProcessId();
     initPlugins( );
     return 0;
 }
@@ -176,338 +100,463 @@ bool Debugger::exit( ) {
     }
 
     // Attempt to terminate the process
-    if (!TerminateProcess(hProcessGlobal, 0)) {
-        std::cerr << "[-] TerminateProcess failed. Error: " << GetLastError() << std::endl;
+    if (!backend->terminate(0)) {
         return false;
     }
-
-    CloseHandle(hProcessGlobal);
+    hProcessGlobal = nullptr;
     return true;
 }
 
 
 
 void Debugger::enableSingleStep(HANDLE hThread) {
-    CONTEXT ctx = {};
-    ctx.ContextFlags = CONTEXT_CONTROL;
-
-    if (GetThreadContext(hThread, &ctx)) {
-        ctx.EFlags |= 0x100; // Trap Flag
-        SetThreadContext(hThread, &ctx);
+    TraceScope span(tracer.get(), TraceCategory::BREAKPOINT, "single_step");
+    if (ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_CONTROL)) {
+        ctx->flags |= 0x100; // Trap Flag
+        storeContext(hThread, CONTEXT_PART_CONTROL);
     }
 }
 
 void Debugger::decrementIP(HANDLE hThread) {
-    if (SuspendThread(hThread) == (DWORD)-1) {
-        std::cerr << "[-] SuspendThread failed: " << GetLastError() << "\n";
-    }
-    CONTEXT ctx = {};
-    ctx.ContextFlags = CONTEXT_CONTROL;
-    if (GetThreadContext(hThread, &ctx)) {
-        #ifdef _WIN64
-            ctx.Rip--;
-        #else
-            ctx.Eip--;
-        #endif
-        SetThreadContext(hThread, &ctx);
-    }
-    // Always try to resume
-    if (ResumeThread(hThread) == (DWORD)-1) {
-        std::cerr << "[-] ResumeThread failed: " << GetLastError() << "\n";
+    if (ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_CONTROL)) {
+        ctx->ip--;
+        storeContext(hThread, CONTEXT_PART_CONTROL);
     }
 }
 
 
 
 void Debugger::printIP(HANDLE hThread) {
-    CONTEXT ctx = {};
-    ctx.ContextFlags = CONTEXT_CONTROL;
-    if (GetThreadContext(hThread, &ctx)) {
-        #ifdef _WIN64
-        std::cout << "[-] RIP = 0x" << std::hex << ctx.Rip << std::endl;
+    if (const ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_CONTROL)) {
+        #ifdef ROBODBG_X64
+        std::cout << "[-] RIP = 0x" << std::hex << ctx->ip << std::endl;
         #else
-        std::cout << "[-] EIP = 0x" << std::hex << ctx.Eip << std::endl;
+        std::cout << "[-] EIP = 0x" << std::hex << ctx->ip << std::endl;
         #endif
     }
 }
 
-//actualize a thread list. e.g. after attaching to an existing running application;
-void Debugger::actualizeThreadList() {
-    threads.clear(); // Clear existing thread list
+void Debugger::setEventMask(uint32_t mask) {
+    eventMask = mask & EVENT_ALL;
+}
 
-    DWORD processId = GetProcessId(hProcessGlobal);
-    if (processId == 0) {
-        std::cerr << "[-] Failed to get process ID from handle. Error: " << GetLastError() << std::endl;
-        return;
-    }
+void Debugger::setExceptionSubscribed(DWORD code, bool subscribed) {
+    if (subscribed) ignoredExceptions.erase(code);
+    else ignoredExceptions.insert(code);
+}
+
+bool Debugger::isExceptionSubscribed(DWORD code) const {
+    return (eventMask & EVENT_EXCEPTION) && !ignoredExceptions.count(code);
+}
 
-    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
-    if (snapshot == INVALID_HANDLE_VALUE) {
-        std::cerr << "[-] Failed to create thread snapshot. Error: " << GetLastError() << std::endl;
-        return;
+// EventMask bit of an event type that can be delivered asynchronously, else 0
+static uint32_t informationalEvent(DebugEventType type) {
+    switch (type) {
+        case DebugEventType::CREATE_THREAD: return EVENT_THREAD_CREATE;
+        case DebugEventType::EXIT_THREAD:   return EVENT_THREAD_EXIT;
+        case DebugEventType::LOAD_DLL:      return EVENT_DLL_LOAD;
+        case DebugEventType::UNLOAD_DLL:    return EVENT_DLL_UNLOAD;
+        case DebugEventType::DEBUG_STRING:  return EVENT_DEBUG_STRING;
+        default:                            return EVENT_NONE;
     }
+}
 
-    THREADENTRY32 te32 = {};
-    te32.dwSize = sizeof(te32);
+void Debugger::setAsyncEvents(uint32_t events, EventPumpOptions_t options) {
+    asyncEvents = events & EVENT_INFORMATIONAL;
+    eventPumpOptions = options;
+    eventPumpChanged = true;
+}
 
-    if (Thread32First(snapshot, &te32)) {
-        do {
-            if (te32.th32OwnerProcessID == processId) {
-                HANDLE hThread = OpenThread(THREAD_ALL_ACCESS, FALSE, te32.th32ThreadID);
-                if (!hThread) {
-                    std::cerr << "[-] Failed to open thread " << te32.th32ThreadID << ". Error: " << GetLastError() << std::endl;
-                    continue;
-                }
+EventPumpStats_t Debugger::getEventPumpStats() const {
+    return eventPump ? eventPump->stats() : EventPumpStats_t{};
+}
 
-                // Optionally get thread start address (Windows internal APIs, see note below)
-                // For now we fill with nullptr placeholders
-                thread_t t;
-                t.hThread = hThread;
-                t.threadId = te32.th32ThreadID;
-                t.threadBase = nullptr;     // Not easily available without NtQueryInformationThread
-                t.startAddress = nullptr;   // Optional: can use NtQueryInformationThread with ThreadQuerySetWin32StartAddress
+void Debugger::setMetrics(bool enabled, DWORD dumpIntervalMs) {
+    backend->setRemoteCounters(nullptr);
+    metrics.reset();
+    metricsIntervalNs = 0;
+    if (!enabled) return;
+    metrics = std::make_unique<SessionMetrics>();
+    backend->setRemoteCounters(&metrics->remote());
+    metricsIntervalNs = static_cast<uint64_t>(dumpIntervalMs) * 1000000;
+    metricsDueNs = monotonicNs() + metricsIntervalNs;
+}
 
-                threads.push_back(t);
-            }
-        } while (Thread32Next(snapshot, &te32));
+MetricsSnapshot_t Debugger::getMetrics() const {
+    return metrics ? metrics->snapshot() : MetricsSnapshot_t{};
+}
+
+void Debugger::resetMetrics() {
+    if (metrics) metrics->reset();
+}
+
+void Debugger::setTracing(bool enabled, const std::string& path, TraceOptions_t options) {
+    backend->setTracer(nullptr);
+    tracer.reset();
+    tracePath.clear();
+    if (!enabled) return;
+    tracer = std::make_unique<TraceRecorder>(options.maxEvents);
+    backend->setTracer(tracer.get());
+    tracePath = path;
+    traceFormat = options.format;
+}
+
+bool Debugger::writeTrace(const std::string& path, TraceFormat format) const {
+    return tracer && tracer->write(path, format);
+}
+
+void Debugger::finishTrace() {
+    if (!tracer || tracePath.empty()) return;
+    if (writeTrace(tracePath, traceFormat)) {
+        std::cout << "[+] Trace written to " << tracePath << " (" << tracer->dropped() << " spans dropped)\n";
+    } else {
+        std::cerr << "[-] Failed to write trace to " << tracePath << "\n";
     }
+}
 
-    CloseHandle(snapshot);
+void Debugger::recordStop(DebugEventType type, uint64_t received) {
+    const uint64_t now = monotonicNs();
+    if (received) metrics->stopped(type).record(now - received); // 0: turned on while this event was handled
+    if (metricsIntervalNs && now >= metricsDueNs) {
+        metricsDueNs = now + metricsIntervalNs;
+        onMetrics(metrics->snapshot());
+    }
 }
 
-int Debugger::loop() {
-    bool stepping = false;
+void Debugger::applyAsyncEvents() {
+    eventPumpChanged = false;
+    if (eventPump) eventPump->drain();
+    eventPump.reset();
+    closeHeldThreads(); // the next pump counts from zero
+    if (asyncEvents) {
+        eventPump = std::make_unique<EventPump>(eventPumpOptions, [this](QueuedEvent_t& queued) {
+            deliverQueuedEvent(queued);
+        });
+    }
+}
 
-    DEBUG_EVENT dbgEvent;
-    while (this->dbgLoop) {
-        if (!WaitForDebugEvent(&dbgEvent, INFINITE)) break;
+void Debugger::queueEvent(EventInfo& event, HANDLE hThread) {
+    eventPump->push(QueuedEvent_t{ event.raw(), event.snapshot(), hThread });
+}
 
-        DWORD cont = DBG_CONTINUE;
+void Debugger::deliverQueuedEvent(QueuedEvent_t& queued) {
+    const DebugEvent_t& raw = queued.raw;
+    EventInfo event(*backend, raw, std::move(queued.payload)); // answers from the payload, no target reads
+    if (tracer) tracer->nameThread("event pump");
+    switch (raw.type) {
+        case DebugEventType::CREATE_THREAD:
+            timedCallback(MetricCallback::THREAD_CREATE, [&] {
+                onThreadCreate(queued.hThread, raw.threadId, raw.threadBase, raw.startAddress);
+            });
+            break;
+        case DebugEventType::EXIT_THREAD:
+            timedCallback(MetricCallback::THREAD_EXIT, [&] { onThreadExit(raw.threadId); });
+            break;
+        case DebugEventType::LOAD_DLL:
+            timedCallback(MetricCallback::DLL_LOAD, [&] { return onDLLLoadEvent(event); });
+            break;
+        case DebugEventType::UNLOAD_DLL:
+            timedCallback(MetricCallback::DLL_UNLOAD, [&] { onDLLUnloadEvent(event); });
+            break;
+        case DebugEventType::DEBUG_STRING:
+            timedCallback(MetricCallback::DEBUG_STRING, [&] { onDebugStringEvent(event); });
+            break;
+        default: break;
+    }
+}
 
-        switch (dbgEvent.dwDebugEventCode) {
-            case CREATE_PROCESS_DEBUG_EVENT: {
-                baseImageBase = reinterpret_cast<uintptr_t>(dbgEvent.u.CreateProcessInfo.lpBaseOfImage);
-                DWORD_PTR entryPoint = Util::getEntryPoint(hProcessGlobal, reinterpret_cast<LPVOID>(baseImageBase));
-                onStart(baseImageBase,static_cast<uintptr_t>(entryPoint));
+int Debugger::loop() {
+    DebugEvent_t dbgEvent;
+    if (tracer) tracer->nameThread("debug loop");
+    while (this->dbgLoop) {
+        {
+            TraceScope wait(tracer.get(), TraceCategory::LOOP, "wait_for_event");
+            if (!backend->waitForEvent(dbgEvent, INFINITE)) break;
+        }
+        const uint64_t received = metrics || tracer ? monotonicNs() : 0;
+        if (++stopCount >= retiredSweepAt) sweepRetiredBreakpoints();
+        EventInfo event(*backend, dbgEvent); // payloads are read when a callback asks
+        stoppedAtEvent = true;
+        eventThreadId = dbgEvent.threadId;
+
+        bool handled = true; // DBG_CONTINUE
+
+        if (eventPumpChanged) applyAsyncEvents();
+        closeHeldThreads();
+        const bool async = eventPump && (asyncEvents & eventMask & informationalEvent(dbgEvent.type));
+        std::unique_lock<std::mutex> callbackLock; // callbacks run here never overlap the pump's
+        if (eventPump) {
+            if (dbgEvent.type == DebugEventType::EXIT_PROCESS) eventPump->drain(); // onEnd comes last
+            if (!async) callbackLock = std::unique_lock<std::mutex>(eventPump->callbackMutex());
+        }
+
+        switch (dbgEvent.type) {
+            case DebugEventType::CREATE_PROCESS: {
+                if (ThreadInfo_t* thread = trackThread(dbgEvent.threadId)) {
+                    thread->startAddress = dbgEvent.startAddress;
+                }
+                baseImageBase = dbgEvent.imageBase;
+                addressSpace.clear();
+                addressSpace.addModule(Module_t{ baseImageBase, imageSize(event), event.moduleName() });
+                if (eventMask & EVENT_START) timedCallback(MetricCallback::START, [&] { onStartEvent(event); });
                 break;
             }
 
-            case EXIT_PROCESS_DEBUG_EVENT: {
-                DWORD exitCode = dbgEvent.u.ExitProcess.dwExitCode;
-                DWORD pid = dbgEvent.dwProcessId;
-                onEnd(exitCode, pid);
+            case DebugEventType::EXIT_PROCESS: {
+                DWORD exitCode = dbgEvent.exitCode;
+                DWORD pid = dbgEvent.processId;
+                if (eventMask & EVENT_END) timedCallback(MetricCallback::END, [&] { onEnd(exitCode, pid); });
+                stoppedAtEvent = false;
+                if (memoryCache) memoryCache->invalidate();
+                releaseThreads();
+                if (tracer && received) {
+                    tracer->record(TraceCategory::DISPATCH, eventTypeName(dbgEvent.type), received, monotonicNs(),
+                                   "thread", dbgEvent.threadId);
+                }
+                if (metrics) recordStop(dbgEvent.type, received);
+                finishTrace();
                 return 0;
             }
-            case CREATE_THREAD_DEBUG_EVENT: {
+            case DebugEventType::CREATE_THREAD: {
                 //std::cout << "[*] Thread created. TID=" << dbgEvent.dwThreadId
                 //<< " TEB=0x" << std::hex << (DWORD_PTR)threadBase
                 // << " Start Address=0x" << std::hex << (DWORD_PTR)threadStartAddr << "\n";
 
-                LPVOID threadBase = dbgEvent.u.CreateThread.lpThreadLocalBase;
-                LPVOID threadStartAddr = dbgEvent.u.CreateThread.lpStartAddress;
-
-                HANDLE hThread = OpenThread(THREAD_ALL_ACCESS, FALSE, dbgEvent.dwThreadId);
-                if (!hThread) {
-                    std::cerr << "[-] Failed to open thread: " << GetLastError() << "\n";
+                ThreadInfo_t* thread = trackThread(dbgEvent.threadId);
+                if (!thread) {
+                    std::cerr << "[-] Failed to open thread: " << dbgEvent.threadId << "\n";
                     break;
                 }
-                onThreadCreate( hThread, dbgEvent.dwThreadId, reinterpret_cast<uintptr_t>(threadBase), reinterpret_cast<uintptr_t>(threadStartAddr));
-
-                // Store the thread info
-                thread_t newThread = {
-                    .hThread = hThread,
-                    .threadId = dbgEvent.dwThreadId,
-                    .threadBase = threadBase,
-                    .startAddress = threadStartAddr
-                };
-                threads.push_back(newThread);
-
+                thread->threadBase = dbgEvent.threadBase;
+                thread->startAddress = dbgEvent.startAddress;
+                if (async) queueEvent(event, thread->hThread);
+                else if (eventMask & EVENT_THREAD_CREATE) timedCallback(MetricCallback::THREAD_CREATE, [&] {
+                    onThreadCreate( thread->hThread, dbgEvent.threadId, dbgEvent.threadBase, dbgEvent.startAddress );
+                });
                 break;
             }
 
-            case EXIT_THREAD_DEBUG_EVENT: {
-                //std::cout << "[*] Thread exited. TID=" << dbgEvent.dwThreadId << "\n";
-                onThreadExit( dbgEvent.dwThreadId );
+            case DebugEventType::EXIT_THREAD: {
+                //std::cout << "[*] Thread exited. TID=" << dbgEvent.threadId << "\n";
+                if (async) queueEvent(event);
+                else if (eventMask & EVENT_THREAD_EXIT)
+                    timedCallback(MetricCallback::THREAD_EXIT, [&] { onThreadExit( dbgEvent.threadId ); });
+                releaseScratchSlot( dbgEvent.threadId );
+
+                auto it = stepStates.find(dbgEvent.threadId);
+                if (it != stepStates.end()) {
+                    uintptr_t bpAddr = it->second.bpAddress;
+                    stepStates.erase(it);
+                    if (bpAddr) rearmAfterStep(bpAddr);
+                }
+                untrackThread( dbgEvent.threadId );
                 break;
             }
 
-            case LOAD_DLL_DEBUG_EVENT: {
-                LPVOID base = dbgEvent.u.LoadDll.lpBaseOfDll;
-                auto name = Util::getDllName(hProcessGlobal, dbgEvent.u.LoadDll.lpImageName, dbgEvent.u.LoadDll.fUnicode);
-                DWORD_PTR entryPoint = Util::getEntryPoint(hProcessGlobal, base);
-                onDLLLoad(reinterpret_cast<uintptr_t>(base), name, static_cast<uintptr_t>(entryPoint));
+            case DebugEventType::LOAD_DLL: {
+                uintptr_t base = dbgEvent.imageBase;
+                invalidatePointerCache();
+                if (!(eventMask & (EVENT_DLL_LOAD | EVENT_MODULES))) {
+                    addressSpace.invalidateRegions();
+                    break;
+                }
+                if (eventMask & EVENT_MODULES) {
+                    const SIZE_T size = imageSize(event);
+                    if (addressSpace.built()) refreshAddressSpace(base, std::max<SIZE_T>(size, 1));
+                    addressSpace.addModule(Module_t{ base, size, event.moduleName() });
+                } else {
+                    addressSpace.invalidateRegions();
+                }
+                if (async) queueEvent(event);
+                else if (eventMask & EVENT_DLL_LOAD) timedCallback(MetricCallback::DLL_LOAD, [&] { return onDLLLoadEvent(event); });
 
                 //std::cout << "[*] DLL loaded at 0x" << std::hex << (DWORD_PTR)base
                 //<< " Name: " << name << "\n";
                 break;
             }
 
-            case UNLOAD_DLL_DEBUG_EVENT: {
-                LPVOID base = dbgEvent.u.UnloadDll.lpBaseOfDll;
-                auto name = Util::getDllName(hProcessGlobal, dbgEvent.u.LoadDll.lpImageName, dbgEvent.u.LoadDll.fUnicode);
-                onDLLUnload(reinterpret_cast<uintptr_t>(base), name);
+            case DebugEventType::UNLOAD_DLL: {
+                uintptr_t base = dbgEvent.imageBase;
+                if (async) queueEvent(event);
+                else if (eventMask & EVENT_DLL_UNLOAD) timedCallback(MetricCallback::DLL_UNLOAD, [&] { onDLLUnloadEvent(event); });
+                // Still resolvable inside the callback; dropped afterwards
+                const Module_t* module = addressSpace.findModule(base);
+                const SIZE_T size = module && module->base == base ? module->size : 1;
+                addressSpace.removeModule(base);
+                invalidatePointerCache();
+                if (!(eventMask & EVENT_MODULES)) addressSpace.invalidateRegions();
+                else if (addressSpace.built()) refreshAddressSpace(base, size);
                 //std::cout << "[*] DLL unloaded from 0x" << std::hex << (DWORD_PTR)base << "\n";
                 break;
             }
 
-            case EXCEPTION_DEBUG_EVENT: {
-                DWORD code = dbgEvent.u.Exception.ExceptionRecord.ExceptionCode;
-                LPVOID addr = dbgEvent.u.Exception.ExceptionRecord.ExceptionAddress;
-                HANDLE hThread = OpenThread(THREAD_ALL_ACCESS, FALSE, dbgEvent.dwThreadId);
-                if (!hThread) break;
+            case DebugEventType::EXCEPTION: {
+                DWORD code = dbgEvent.exceptionCode;
+                LPVOID addr = reinterpret_cast<LPVOID>(dbgEvent.exceptionAddress);
+                if (code != EXCEPTION_BREAKPOINT && code != EXCEPTION_SINGLE_STEP && !isExceptionSubscribed(code)) {
+                    handled = false; // the debuggee's own handlers get it
+                    break;
+                }
+                ThreadInfo_t* thread = trackThread(dbgEvent.threadId);
+                if (!thread) break;
+                thread->status = ThreadStatus::STOPPED;
+                HANDLE hThread = thread->hThread; // callbacks may grow the registry and move thread
 
                 if (code == EXCEPTION_BREAKPOINT) {
                     if(this->verbose) std::cout << "[+] Breakpoint Hit" << std::endl;
-                    auto it = breakpoints.find(addr);
-                    if (it != breakpoints.end()) {
+                    uintptr_t bpAddr = reinterpret_cast<uintptr_t>(addr);
+                    Breakpoint_t* bp = breakpoints.find(bpAddr);
+                    if (bp) {
                         //std::cout << "[*] Loop Breakpoint hit at: 0x" << std::hex << (DWORD_PTR)addr << "\n";
-                        restoreBreakpoint(addr);
+                        ++bp->hits;
+                        // Displaced stepping leaves the int3 in place unless the hit is single-stepped or removed
+                        const bool displace = displacedStepping && !(bp->flags & BP_FLAG_NO_DISPLACE);
+                        if (!displace) restoreBreakpoint(addr);
                         decrementIP(hThread);
-                        BreakpointAction bpType = onBreakpoint(reinterpret_cast<uintptr_t>(addr),hThread);
-                        if (bpType != BREAK ) {
+                        BreakpointAction bpType = timedCallback(MetricCallback::BREAKPOINT, [&] { return onBreakpoint(bpAddr,hThread); });
+                        // onBreakpoint may add breakpoints, which invalidates bp
+                        if (Breakpoint_t* entry = breakpoints.find(bpAddr))
+                            entry->action = static_cast<uint8_t>(bpType);
+                        if (bpType == RESTORE && displace && displaceStep(dbgEvent.threadId, hThread, bpAddr)) {
+                            // The thread runs the relocated instruction from its scratch slot
+                        } else if (bpType != BREAK ) {
+                            if (displace && breakpoints.contains(bpAddr)) restoreBreakpoint(addr);
+                            // Step over the original instruction, then re-arm (see rearmAfterStep)
+                            StepState_t& state = stepStates[dbgEvent.threadId];
+                            state = StepState_t{};
+                            state.action = bpType;
+                            state.bpAddress = bpAddr;
                             enableSingleStep(hThread);
-                            stepping = true;
-                            if(bpType == RESTORE )
-                            {
-                                bpAddrToRestore = addr;
-                                lastBpType = bpType;
-                                needToRestoreBreakpoint = true;
-                            }
                         } else { //BP_DO_NOP
-                            stepping = false;
-                            breakpoints.erase(addr);
+                            if (displace && breakpoints.contains(bpAddr)) restoreBreakpoint(addr);
+                            breakpoints.erase(bpAddr);
+                            retireBreakpoint(bpAddr);
                         }
+                    } else if (retiredBreakpoints.count(bpAddr)) {
+                        // Another thread hit this int3 before a BREAK removed it: run the original instruction
+                        BYTE cur = 0;
+                        if (readTarget(bpAddr, &cur, 1) && cur != 0xCC) decrementIP(hThread);
                     }
-                } else if (code == EXCEPTION_SINGLE_STEP && stepping) {
-                    if(needToRestoreBreakpoint) //just hit a breakpoint. Now restore.
-                    {
-                        if(restoreHwBP)
-                        {
-                            if(this->verbose) std::cout << "[+] Restoring hardware breakpoint" << std::endl;
-                            setHardwareBreakpoint(hwBPToRestore);
-                            restoreHwBP = false;
-                        } else {
-                            setBreakpoint(bpAddrToRestore); //TODO
-                        }
-                        needToRestoreBreakpoint = false;
+                } else if (code == EXCEPTION_SINGLE_STEP && stepStates.count(dbgEvent.threadId)) {
+                    auto it = stepStates.find(dbgEvent.threadId);
+                    StepState_t state = it->second;
+                    stepStates.erase(it);
 
+                    if(state.restoreHw)
+                    {
+                        if(this->verbose) std::cout << "[+] Restoring hardware breakpoint" << std::endl;
+                        state.hwBp.hThread = hThread;
+                        setHardwareBreakpointOnThread(state.hwBp);
+                    } else if (state.bpAddress) {
+                        rearmAfterStep(state.bpAddress);
                     }
 
-                    if(lastBpType == SINGLE_STEP ) {
-                        BreakpointAction bpType = onBreakpoint(reinterpret_cast<uintptr_t>(addr),hThread);
+                    if(state.action == SINGLE_STEP ) {
+                        BreakpointAction bpType = timedCallback(MetricCallback::BREAKPOINT, [&] {
+                            return onBreakpoint(reinterpret_cast<uintptr_t>(addr),hThread);
+                        });
                         if (bpType != BREAK) {
-                            bpAddrToRestore = addr;
-                            needToRestoreBreakpoint = true;
-
-                            lastBpType = bpType;
+                            stepStates[dbgEvent.threadId].action = bpType;
                             enableSingleStep(hThread);
-                            stepping = true;
                         }
-                    } else {
-                        stepping = false;
                     }
                 } else if (code == EXCEPTION_SINGLE_STEP ) {
                     if(this->verbose) std::cout << "[~] Single step: 0x" << std::hex << (DWORD_PTR)addr << "\n";
-                    DRReg reg = isHardwareBreakpointAt( addr );
-                    if(reg != DRReg::NOP) {
-                        BreakpointAction bpType = onHardwareBreakpoint(reinterpret_cast<uintptr_t>(addr), hThread, reg);
+                    // DR6 names the slot that fired. Data breakpoints report the IP behind the access,
+                    // so the exception address alone only identifies execute breakpoints.
+                    const DebugRegisters_t dr = thread->debugRegisters;
+                    int slot = -1;
+                    // Control is fetched in the same read for the step-over of execute breakpoints
+                    if (ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_DEBUG | CONTEXT_PART_CONTROL)) {
+                        slot = dr.hitSlot(ctx->dr[6]);
+                        if (ctx->dr[6] & DR6_HIT_MASK) {
+                            ctx->dr[6] &= ~DR6_HIT_MASK; // the CPU never clears B0-B3
+                            storeContext(hThread, CONTEXT_PART_DEBUG);
+                        }
+                    }
+                    if (slot < 0) slot = dr.find(reinterpret_cast<uintptr_t>(addr));
+
+                    if(slot >= 0) {
+                        DRReg reg = static_cast<DRReg>(slot);
+                        const bool execute = dr.type(slot) == 0;
+                        BreakpointAction bpType = timedCallback(MetricCallback::HARDWARE_BREAKPOINT, [&] {
+                            return onHardwareBreakpoint(static_cast<uintptr_t>(dr.address[slot]), hThread, reg);
+                        });
                         if(bpType == BREAK) { //Software Breakpoint
                             clearHardwareBreakpoint( reg );
                         } else if(bpType == SINGLE_STEP)
                         {
+                            stepStates[dbgEvent.threadId] = StepState_t{ SINGLE_STEP };
                             enableSingleStep(hThread);
-                            stepping = true;
                             clearHardwareBreakpoint(reg);
-                        } else if(bpType == RESTORE)
+                        } else if(bpType == RESTORE && execute)
                         {
-                            hwBp_t bp = getBreakpointByReg( reg );
-                            needToRestoreBreakpoint = true;
-                            restoreHwBP = true;
-                            hwBPToRestore = bp;
-                            bpAddrToRestore = addr;
-                            hwBPThreadToRestore = hThread;
-                            lastBpType = bpType;
-
-                            //getHardwareBreakpoints();
-                            clearHardwareBreakpointOnThread(hwBPThreadToRestore, reg);
+                            // Only this thread's debug register is cleared for the step.
+                            // Data breakpoints trap after the access and need no step.
+                            StepState_t& state = stepStates[dbgEvent.threadId];
+                            state = StepState_t{ RESTORE };
+                            state.restoreHw = true;
+                            state.hwBp = hardwareBreakpointOf( hThread, dr, slot );
+
+                            clearHardwareBreakpointOnThread(hThread, reg);
                             enableSingleStep(hThread);
-                            stepping = true;
                         }
                     } else {
-                        onUnknownException(reinterpret_cast<uintptr_t>(addr), code);
+                        timedCallback(MetricCallback::EXCEPTION, [&] { onUnknownException(reinterpret_cast<uintptr_t>(addr), code); });
 
                     }
-                } else if ( code == EXCEPTION_ACCESS_VIOLATION ) {
-                    ULONG_PTR rawAddr = dbgEvent.u.Exception.ExceptionRecord.ExceptionInformation[1];
-                    LPVOID faultingAddress = reinterpret_cast<LPVOID>(rawAddr);
-                    ULONG_PTR accessType = dbgEvent.u.Exception.ExceptionRecord.ExceptionInformation[0];
-                    onAccessViolation( static_cast<uintptr_t>(rawAddr), reinterpret_cast<uintptr_t>(faultingAddress), static_cast<long>(accessType));
-                    //enableSingleStep(hThread);
-                    //stepping = true;
-
                 } else {
-                    onUnknownException( reinterpret_cast<uintptr_t>(addr), code );
+                    timedCallback(MetricCallback::EXCEPTION, [&] { onExceptionEvent(event); });
                 }
 
-                CloseHandle(hThread);
+                if ((thread = threads.find(dbgEvent.threadId))) thread->status = ThreadStatus::RUNNING;
                 break;
             }
 
-                        case OUTPUT_DEBUG_STRING_EVENT: {
-                            OUTPUT_DEBUG_STRING_INFO& info = dbgEvent.u.DebugString;
-                            SIZE_T bytesRead;
-
-                            if (!info.fUnicode) {
-                                // ANSI string
-                                char buffer[1024] = {0};
-                                ReadProcessMemory(
-                                    hProcessGlobal,
-                                    info.lpDebugStringData,
-                                    buffer,
-                                    std::min<DWORD>(info.nDebugStringLength, sizeof(buffer) - 1),
-                                                  &bytesRead
-                                );
-
-                                std::string msg(buffer);
-                                onDebugString(msg);
-                            } else {
-                                // Unicode string
-                                wchar_t wbuffer[1024] = {0};
-                                ReadProcessMemory(
-                                    hProcessGlobal,
-                                    info.lpDebugStringData,
-                                    wbuffer,
-                                    std::min<DWORD>(info.nDebugStringLength * sizeof(wchar_t), sizeof(wbuffer) - sizeof(wchar_t)),
-                                                  &bytesRead
-                                );
-
-                                // Convert wchar_t* to std::string using WideCharToMultiByte (UTF-8)
-                                int size_needed = WideCharToMultiByte(CP_UTF8, 0, wbuffer, -1, nullptr, 0, nullptr, nullptr);
-                                std::string msg(size_needed, 0);
-                                WideCharToMultiByte(CP_UTF8, 0, wbuffer, -1, &msg[0], size_needed, nullptr, nullptr);
-
-                                onDebugString(msg);
-                            }
-
-                            break;
-                        }
+            case DebugEventType::DEBUG_STRING: {
+                if (async) queueEvent(event);
+                else if (eventMask & EVENT_DEBUG_STRING) timedCallback(MetricCallback::DEBUG_STRING, [&] { onDebugStringEvent(event); });
+                break;
+            }
 
-            case RIP_EVENT: {
-                const RIP_INFO& rip = dbgEvent.u.RipInfo;
-                onRIPError( rip );
+            case DebugEventType::RIP_ERROR: {
+                const RIP_INFO& rip = dbgEvent.rip;
+                if (eventMask & EVENT_RIP_ERROR) timedCallback(MetricCallback::RIP_ERROR, [&] { onRIPError( rip ); });
                 break;
             }
 
             default: {
-                onUnknownDebugEvent( dbgEvent.dwDebugEventCode );
+                if (eventMask & EVENT_UNKNOWN) timedCallback(MetricCallback::UNKNOWN, [&] { onUnknownDebugEvent( dbgEvent.rawCode ); });
                 break;
             }
         }
-        ContinueDebugEvent(dbgEvent.dwProcessId, dbgEvent.dwThreadId, cont);
+        if (tracer && received) {
+            tracer->record(TraceCategory::DISPATCH, eventTypeName(dbgEvent.type), received, monotonicNs(),
+                           "thread", dbgEvent.threadId);
+        }
+        {
+            // Register changes made while handling the event reach the thread in one write
+            TraceScope flush(tracer.get(), TraceCategory::LOOP, "flush_contexts");
+            flushContexts();
+        }
+        // The target may change any page once it runs
+        if (memoryCache) memoryCache->invalidate();
+        stoppedAtEvent = false;
+        {
+            TraceScope resume(tracer.get(), TraceCategory::LOOP, "continue");
+            backend->continueEvent(dbgEvent, handled);
+        }
+        if (metrics) {
+            // onMetrics() is a callback too: it does not overlap the pump's
+            if (eventPump && !callbackLock.owns_lock()) callbackLock = std::unique_lock<std::mutex>(eventPump->callbackMutex());
+            recordStop(dbgEvent.type, received);
+        }
     }
 
-    CloseHandle(hProcessGlobal);
-    CloseHandle(hThreadGlobal);
+    if (eventPump) eventPump->drain();
+    releaseThreads();
+    backend->close();
+    finishTrace();
     return 0;
 }
 
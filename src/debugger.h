@@ -7,28 +7,44 @@
 #ifndef DEBUGGER_H
 #define DEBUGGER_H
 
-#pragma comment(lib, "Advapi32.lib")
-#pragma comment(lib, "ntdll.lib")
-
-#include <windows.h>
 #include <string>
 #include <vector>
-#include <tlhelp32.h>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <unordered_map>
-#include <tchar.h>
+#include <unordered_set>
 #include <stdio.h>
-#include <psapi.h>
 #include <map>
 #include <fstream>
-#include <winternl.h>
-#include <intrin.h>
+#include <functional>
 #include <memory>
-
+#include <span>
+#include <string_view>
+
+#include "platform.h"
+#include "backends/targetBackend.h"
+#include "breakpointTable.h"
+#include "threadRegistry.h"
+#include "patternScanner.h"
+#include "regionReader.h"
+#include "parallelScan.h"
+#include "signatureSet.h"
+#include "valueScanner.h"
+#include "addressSpace.h"
+#include "pageCache.h"
+#include "readBatch.h"
+#include "pointerChain.h"
+#include "pointerScanner.h"
+#include "stringScanner.h"
+#include "eventInfo.h"
+#include "eventPump.h"
+#include "sessionMetrics.h"
+#include "traceRecorder.h"
+#ifdef _WIN32
 #include "util.h"
 #include "plugins/plugins.h"
+#endif
 
 namespace RoboDBG {
 
@@ -76,14 +92,29 @@ namespace RoboDBG {
     };
 
     /**
-     * @struct thread_t
-     * @brief Represents a thread in a debugged process.
-     */
-    struct thread_t {
-        HANDLE hThread;      ///< Thread handle.
-        DWORD threadId;      ///< Thread ID.
-        LPVOID threadBase;   ///< Base address of the thread.
-        LPVOID startAddress; ///< Start address of the thread.
+     * @enum EventMask
+     * @brief Debug events the loop does work for (see Debugger::setEventMask()).
+     *
+     * An event outside the mask is continued right away: its callback is not called and the payload it would
+     * get (DLL name and entry point, debug string text, thread handle) is never read from the target.
+     * Breakpoints, hardware breakpoints and single-steps the debugger set are always handled.
+     */
+    enum EventMask : uint32_t {
+        EVENT_START         = 1 << 0,  ///< onStart (reads the entry point).
+        EVENT_END           = 1 << 1,  ///< onEnd.
+        EVENT_THREAD_CREATE = 1 << 2,  ///< onThreadCreate.
+        EVENT_THREAD_EXIT   = 1 << 3,  ///< onThreadExit.
+        EVENT_DLL_LOAD      = 1 << 4,  ///< onDLLLoad (reads the name and the entry point).
+        EVENT_DLL_UNLOAD    = 1 << 5,  ///< onDLLUnload.
+        EVENT_EXCEPTION     = 1 << 6,  ///< onAccessViolation / onUnknownException; see also setExceptionSubscribed().
+        EVENT_DEBUG_STRING  = 1 << 7,  ///< onDebugString (reads up to 2 KB of text).
+        EVENT_RIP_ERROR     = 1 << 8,  ///< onRIPError.
+        EVENT_UNKNOWN       = 1 << 9,  ///< onUnknownDebugEvent.
+        EVENT_MODULES       = 1 << 10, ///< Keep the module index of getModuleByAddress() current (name and PE header per DLL).
+        EVENT_NONE          = 0,
+        EVENT_ALL           = (1 << 11) - 1,
+        /// Events that can be delivered while the target runs (see Debugger::setAsyncEvents()).
+        EVENT_INFORMATIONAL = EVENT_THREAD_CREATE | EVENT_THREAD_EXIT | EVENT_DLL_LOAD | EVENT_DLL_UNLOAD | EVENT_DEBUG_STRING
     };
 
     /**
@@ -99,18 +130,35 @@ namespace RoboDBG {
     };
 
     /**
-     * @struct MemoryRegion_t
-     * @brief Represents a memory region in a process.
+     * @struct StepState_t
+     * @brief Single-step the debugger started on one thread (breakpoint step-over or tracing).
+     */
+    struct StepState_t {
+        int action = BREAK;          ///< Action that started the step: RESTORE or SINGLE_STEP.
+        uintptr_t bpAddress = 0;     ///< Software breakpoint to re-arm after the step, 0 if none.
+        bool restoreHw = false;      ///< Re-arm hwBp on the stepping thread after the step.
+        hwBp_t hwBp{};               ///< Hardware breakpoint cleared for the step.
+    };
+
+    /**
+     * @struct ScratchSlot_t
+     * @brief Per-thread code slot in the debuggee that displaced stepping runs relocated instructions from.
+     */
+    struct ScratchSlot_t {
+        uintptr_t address = 0;       ///< Slot address in the debuggee.
+        uintptr_t bpAddress = 0;     ///< Breakpoint whose relocated instruction the slot holds, 0 if none.
+    };
+
+    /**
+     * @struct HeldThread_t
+     * @brief Handle of an exited thread, kept open until the event pump has delivered what was queued before it exited.
      */
-    struct MemoryRegion_t {
-        LPVOID BaseAddress; ///< Base address of the memory region.
-        SIZE_T RegionSize;  ///< Size of the memory region in bytes.
-        DWORD State;        ///< State (MEM_COMMIT, MEM_FREE, MEM_RESERVE).
-        DWORD Protect;      ///< Protection flags (e.g., PAGE_READWRITE).
-        DWORD Type;         ///< Type (MEM_IMAGE, MEM_MAPPED, MEM_PRIVATE).
+    struct HeldThread_t {
+        HANDLE hThread = nullptr;    ///< Handle from TargetBackend::openThread().
+        uint64_t queued = 0;         ///< EventPumpStats_t::queued when the thread exited.
     };
 
-    #ifdef _WIN64
+    #ifdef ROBODBG_X64
     /**
      * @enum Flags64
      * @brief x86-64 CPU status flags.
@@ -144,7 +192,7 @@ namespace RoboDBG {
     };
     #endif
 
-    #ifdef _WIN64
+    #ifdef ROBODBG_X64
     /**
      * @enum Register64
      * @brief 64-bit x86-64 general-purpose registers.
@@ -174,16 +222,272 @@ namespace RoboDBG {
  */
 class Debugger {
 private:
+    std::unique_ptr<TargetBackend> backend;
+#ifdef _WIN32
     std::unique_ptr<Imports> imports;
     std::unique_ptr<Freezer> freezer;
+#endif
+
+    std::unordered_map<DWORD, StepState_t> stepStates; ///< Threads with a debugger single-step in flight, keyed by TID.
+    std::unordered_map<uintptr_t, uint64_t> retiredBreakpoints; ///< Breakpoints removed by a BREAK or removeBreakpoints(), with the stop after which they are dropped.
+    uint64_t stopCount = 0;                            ///< Debug events received by loop().
+    uint64_t retiredSweepAt = UINT64_MAX;              ///< Earliest stop at which a retired breakpoint is dropped.
+
+    /**
+     * @brief Keeps a removed breakpoint known while other threads may still report hits on it.
+     *
+     * Threads that hit the int3 before it was removed report it later; each of them is reported within a
+     * few events per thread, so the address is dropped after 3 stops per known thread (as gdb does with
+     * its moribund locations). Setting the breakpoint again drops it at once.
+     * @param address Breakpoint address.
+     */
+    void retireBreakpoint(uintptr_t address);
+
+    /**
+     * @brief Drops the retired breakpoints whose time is up; called by the loop once per event.
+     */
+    void sweepRetiredBreakpoints();
+
+    /**
+     * @brief Re-arms a software breakpoint after a step-over, unless it was removed or another thread is still stepping over it.
+     * @param address Breakpoint address.
+     */
+    void rearmAfterStep(uintptr_t address);
+
+    /**
+     * @brief Returns the committed regions that may be read (see RegionReader::readable()).
+     */
+    std::vector<MemoryRegion_t> readableMemoryRegions();
+
+    /**
+     * @brief Runs a StringScanner over regions (see extractStrings()).
+     */
+    std::vector<StringHit_t> extractStrings(std::span<const MemoryRegion_t> regions, const StringScanner& scanner,
+                                            const ScanOptions_t& options);
+
+    /**
+     * @brief Runs a chunk scanner over memory regions, serially or on a ParallelScan pool.
+     * @param regions Regions to scan (see readableMemoryRegions()).
+     * @param overlap Bytes each chunk repeats from the previous one.
+     * @param options Threads, chunk size and result limit.
+     * @param scan Appends the results of one chunk in address order; results of consecutive chunks must stay sorted.
+     * @return Results in address order, truncated to options.maxHits.
+     */
+    template<typename Hit>
+    std::vector<Hit> scanMemory(std::span<const MemoryRegion_t> regions, SIZE_T overlap, const ScanOptions_t& options,
+                                const std::function<void(const MemoryChunk_t&, std::vector<Hit>&)>& scan);
+
+    /**
+     * @brief Returns the size of a loaded image: SizeOfImage for PE images, otherwise the run of
+     * MEM_IMAGE regions from the base (or the region at the base) after a full walk.
+     * @param event CREATE_PROCESS / LOAD_DLL event; its PE headers are kept for entryPoint().
+     * @return Size in bytes; 0 if nothing is mapped there.
+     */
+    SIZE_T imageSize(EventInfo& event);
+
+    /**
+     * @brief Reads target memory; through the page cache while it is enabled and the target is stopped.
+     * @param address Source address.
+     * @param buffer Destination buffer.
+     * @param size Bytes to read.
+     * @param bytesRead Optional; bytes read before the first unreadable byte.
+     * @return true if all bytes were read.
+     */
+    bool readTarget(uintptr_t address, void* buffer, SIZE_T size, SIZE_T* bytesRead = nullptr);
+
+    /**
+     * @brief Writes target memory, keeping cached pages up to date.
+     * @param address Destination address.
+     * @param buffer Source buffer.
+     * @param size Bytes to write.
+     * @return true on success.
+     */
+    bool writeTarget(uintptr_t address, const void* buffer, SIZE_T size);
+
+    /**
+     * @brief Drops cached pages of a range changed behind the cache (protection, allocation, batched patches).
+     */
+    void discardCachedMemory(uintptr_t address, SIZE_T size);
+
+    bool displacedStepping = false;
+    uint32_t eventMask = EVENT_ALL;                  ///< EventMask bits (see setEventMask()).
+    std::unordered_set<DWORD> ignoredExceptions;     ///< Exception codes continued without a callback.
+    uint32_t asyncEvents = EVENT_NONE;               ///< EventMask bits delivered by eventPump (see setAsyncEvents()).
+    std::unique_ptr<EventPump> eventPump;            ///< Consumer of asynchronous events; nullptr when off.
+    EventPumpOptions_t eventPumpOptions;             ///< Options of the next pump.
+    bool eventPumpChanged = false;                   ///< setAsyncEvents() was called; see applyAsyncEvents().
+    std::vector<HeldThread_t> heldThreads;           ///< Exited threads' handles a queued onThreadCreate() may still get.
+    std::unique_ptr<SessionMetrics> metrics;         ///< Latency histograms and remote counters; nullptr when off.
+    uint64_t metricsIntervalNs = 0;                  ///< Period of onMetrics() (see setMetrics()); 0 for none.
+    uint64_t metricsDueNs = 0;                       ///< When onMetrics() is called next.
+    std::unique_ptr<TraceRecorder> tracer;           ///< Span recorder; nullptr when tracing is off.
+    std::string tracePath;                           ///< File loop() writes the trace to when it returns; empty for none.
+    TraceFormat traceFormat = TraceFormat::CHROME_JSON; ///< Format of that file.
+    RegionReaderOptions_t readerOptions; ///< Buffers of whole-address-space passes (search, dumps).
+    AddressSpace addressSpace;           ///< Region / module index (see getAddressSpace()).
+    std::unique_ptr<PageCache> memoryCache; ///< Per-stop page cache (see setMemoryCache()); nullptr when off.
+    std::unique_ptr<PointerResolver> pointerResolver; ///< Created by the first resolvePointerChains().
+    std::unordered_map<DWORD, ScratchSlot_t> scratchSlots; ///< Displaced stepping slot of each thread, keyed by TID.
+    std::vector<uintptr_t> freeScratchSlots;               ///< Allocated slots not owned by a thread.
+
+    /**
+     * @brief Replaces the event pump after setAsyncEvents(), delivering what the old one still holds.
+     * Called by the loop between events, when no callback holds the pump's callback mutex.
+     */
+    void applyAsyncEvents();
+
+    /**
+     * @brief Copies an informational event and its payloads into the event pump; the callback runs on the consumer.
+     * @param event Event; its payloads are read here, before the target continues.
+     * @param hThread Thread handle for onThreadCreate().
+     */
+    void queueEvent(EventInfo& event, HANDLE hThread = nullptr);
+
+    /**
+     * @brief Runs a callback, adding its run time to the callback's histogram while metrics are on and
+     * recording it as a span while tracing. Both are looked up after the callback returns, as it may
+     * call setMetrics().
+     * @param callback Histogram to add to; its name is the span's.
+     * @param call Calls the callback and returns its result.
+     */
+    template<typename F>
+    inline auto timedCallback(MetricCallback callback, F&& call) -> decltype(call()) {
+        if (!metrics && !tracer) return call();
+        struct Timer_t {
+            Debugger* debugger;
+            MetricCallback callback;
+            uint64_t start;
+            ~Timer_t() {
+                const uint64_t end = monotonicNs();
+                if (debugger->metrics) debugger->metrics->callback(callback).record(end - start);
+                if (debugger->tracer) debugger->tracer->record(TraceCategory::CALLBACK, metricCallbackName(callback), start, end);
+            }
+        } timer{ this, callback, monotonicNs() };
+        return call();
+    }
+
+    /**
+     * @brief Writes the trace to tracePath, if set, when loop() returns.
+     */
+    void finishTrace();
+
+    /**
+     * @brief Records how long an event kept the target stopped and calls onMetrics() when a period is due.
+     * @param type Event type.
+     * @param received When waitForEvent() returned it.
+     */
+    void recordStop(DebugEventType type, uint64_t received);
+
+    /**
+     * @brief Calls the callback of a queued event (consumer thread).
+     */
+    void deliverQueuedEvent(QueuedEvent_t& queued);
+
+    /**
+     * @brief Runs the instruction under a RESTORE breakpoint from the thread's scratch slot, leaving the int3 armed.
+     * @param threadId Thread that hit the breakpoint.
+     * @param hThread Its handle; the IP must already be rewound to the breakpoint.
+     * @param address Breakpoint address.
+     * @return true if the thread will continue without a single-step; false to fall back to single-stepping.
+     */
+    bool displaceStep(DWORD threadId, HANDLE hThread, uintptr_t address);
+
+    /**
+     * @brief Returns the scratch slot of a thread, allocating a block of slots near an address if needed.
+     * @param threadId Thread ID.
+     * @param near Address the slot should be reachable from with a 32-bit displacement.
+     * @return The slot, or nullptr if no memory could be allocated in the debuggee.
+     */
+    ScratchSlot_t* scratchSlotFor(DWORD threadId, uintptr_t near);
+
+    /**
+     * @brief Returns a thread's scratch slot to the free list.
+     * @param threadId Thread ID.
+     */
+    void releaseScratchSlot(DWORD threadId);
+
+    /**
+     * @brief Forgets the relocated instructions cached in the scratch slots (breakpoints or code changed).
+     */
+    void invalidateScratchSlots();
+
+    /**
+     * @brief Registers a thread, opening its handle if it is not known yet.
+     * @param threadId Thread ID.
+     * @return The registry entry, or nullptr if the thread could not be opened.
+     */
+    ThreadInfo_t* trackThread(DWORD threadId);
+
+    /**
+     * @brief Closes a thread's handle and removes it from the registry.
+     * @param threadId Thread ID.
+     */
+    void untrackThread(DWORD threadId);
+
+    /**
+     * @brief Closes all thread handles and empties the registry.
+     */
+    void releaseThreads();
 
-    LPVOID bpAddrToRestore;
-    bool needToRestoreBreakpoint; // TODO: rename to bpNeedToRestore
-    int lastBpType;
+    /**
+     * @brief Closes a thread handle, or holds it while the event pump may still pass it to onThreadCreate().
+     * @param hThread Handle from TargetBackend::openThread().
+     */
+    void closeThreadHandle(HANDLE hThread);
 
-    bool restoreHwBP;
-    hwBp_t hwBPToRestore;
-    HANDLE hwBPThreadToRestore;
+    /**
+     * @brief Closes the held handles whose events have been delivered (all of them without a pump).
+     */
+    void closeHeldThreads();
+
+    bool stoppedAtEvent = false;       ///< Between waitForEvent() and continueEvent(); contexts may be cached.
+    DWORD eventThreadId = 0;           ///< Thread that reported the current event.
+    std::vector<DWORD> cachedContexts; ///< Threads with a context cached for the current stop.
+    ThreadInfo_t uncachedContext;      ///< Context of a thread that cannot be cached (not registered / not stopped).
+
+    /**
+     * @brief Finds the registry entry of a thread handle.
+     * @param hThread Thread handle.
+     * @return The entry, or nullptr if the handle was not opened by the registry.
+     */
+    ThreadInfo_t* findThread(HANDLE hThread);
+
+    /**
+     * @brief Returns the register file of a thread with at least parts loaded.
+     *
+     * While stopped at a debug event the context of a registered thread is fetched once and
+     * served from the cache until the event is continued. Otherwise it is read on every call.
+     *
+     * @param hThread Thread handle.
+     * @param parts ContextFlags needed.
+     * @return The context, or nullptr if it could not be read.
+     */
+    ThreadContext_t* loadContext(HANDLE hThread, DWORD parts);
+
+    /**
+     * @brief Commits changes made to the context returned by loadContext().
+     *
+     * Cached contexts are marked dirty and written back by flushContexts(); others are written immediately.
+     *
+     * @param hThread Thread handle.
+     * @param parts ContextFlags that were modified.
+     * @return false if an immediate write failed.
+     */
+    bool storeContext(HANDLE hThread, DWORD parts);
+
+    /**
+     * @brief Writes all dirty cached contexts back and empties the cache. Called before continuing an event.
+     */
+    void flushContexts();
+
+    /**
+     * @brief Builds the hwBp_t of one slot of a debug register shadow.
+     * @param hThread Thread the shadow belongs to.
+     * @param dr Debug register shadow.
+     * @param slot Slot 0–3.
+     * @return Hardware breakpoint record.
+     */
+    static hwBp_t hardwareBreakpointOf(HANDLE hThread, const DebugRegisters_t& dr, int slot);
 
     bool dbgLoop = true;
 
@@ -204,15 +508,15 @@ protected:
     bool verbose;
     uintptr_t baseAddressOffset = 0; // TODO: Add a base image address, e.g: 0x00400000U
 
-#ifdef __WIN64
+#ifdef ROBODBG_X64
     uintptr_t baseImageBase = 0x0000000140000000ULL; ///< Typical image base (without ASLR).
 #else
     uintptr_t baseImageBase = 0x00400000U;           ///< Typical image base (without ASLR).
 #endif
-    std::map<LPVOID, BYTE> breakpoints;
+    BreakpointTable breakpoints;                     ///< Software breakpoints keyed by address.
     std::map<LPVOID, hwBp_t> hwBreakpoints;
     std::map<LPVOID, BYTE> dlls;
-    std::vector<thread_t> threads;
+    ThreadRegistry threads;                          ///< Debuggee threads, kept up to date from CREATE/EXIT_THREAD events.
     int debuggedPid;
     HANDLE hProcessGlobal = nullptr;
     HANDLE hThreadGlobal = nullptr;
@@ -279,6 +583,9 @@ protected:
 
     /**
      * @brief Called on hardware breakpoint hit.
+     *
+     * Data breakpoints stop the thread after the access; RESTORE continues it without a step.
+     *
      * @param address Address being watched.
      * @param hThread Current thread handle.
      * @param reg Debug register that fired.
@@ -326,10 +633,56 @@ protected:
      */
     virtual void onUnknownDebugEvent(DWORD code);
 
+    // ===== Event objects =====
+    // The loop calls these; by default they read what the callbacks above take and call them. Override
+    // one to get the event object instead and read only the payloads the handler needs.
+
+    /**
+     * @brief Called when a new debuggee process is started; calls onStart() by default.
+     * @param event CREATE_PROCESS event.
+     */
+    virtual void onStartEvent(EventInfo& event);
+
+    /**
+     * @brief Called when a DLL is loaded; calls onDLLLoad() (name and entry point read) by default.
+     * @param event LOAD_DLL event.
+     * @return Value of onDLLLoad().
+     */
+    virtual bool onDLLLoadEvent(EventInfo& event);
+
+    /**
+     * @brief Called when a DLL is unloaded; calls onDLLUnload() by default.
+     * @param event UNLOAD_DLL event.
+     */
+    virtual void onDLLUnloadEvent(EventInfo& event);
+
+    /**
+     * @brief Called when OutputDebugString is emitted; calls onDebugString() (text read) by default.
+     * @param event DEBUG_STRING event.
+     */
+    virtual void onDebugStringEvent(EventInfo& event);
+
+    /**
+     * @brief Called on exceptions other than the debugger's breakpoints and steps; calls onAccessViolation()
+     * or onUnknownException() by default.
+     * @param event EXCEPTION event.
+     */
+    virtual void onExceptionEvent(EventInfo& event);
+
+    /**
+     * @brief Called every dump interval while metrics are on (see setMetrics()); prints the table of
+     * formatMetrics() by default.
+     * @param snapshot Metrics of the session so far.
+     */
+    virtual void onMetrics(const MetricsSnapshot_t& snapshot);
+
     // ===== Threading =====
 
     /**
-     * @brief Refreshes the internal thread list by querying the target process.
+     * @brief Reconciles the thread registry with the threads the target reports.
+     *
+     * Only needed if threads were created without a debug event (the loop keeps the registry up
+     * to date otherwise). Known threads keep their handle; vanished threads are closed and removed.
      */
     void actualizeThreadList();
 
@@ -341,6 +694,153 @@ protected:
      */
     void setBreakpoint(LPVOID address);
 
+    /**
+     * @brief Sets many software INT3 breakpoints with one read / write / flush per page.
+     * @param addresses Target addresses in the debuggee.
+     * @return Number of addresses that now hold a breakpoint.
+     */
+    size_t setBreakpoints(std::span<const uintptr_t> addresses);
+
+    /**
+     * @brief Removes many software breakpoints, restoring the original bytes page by page.
+     * @param addresses Breakpoint addresses; addresses without a breakpoint are ignored.
+     * @return Number of breakpoints removed.
+     */
+    size_t removeBreakpoints(std::span<const uintptr_t> addresses);
+
+    /**
+     * @brief Returns how many removed breakpoints are still kept for hits other threads may report.
+     */
+    inline size_t getRetiredBreakpointCount() const { return retiredBreakpoints.size(); }
+
+    /**
+     * @brief Enables displaced stepping for breakpoints that return RESTORE.
+     *
+     * Instead of removing the int3 and single-stepping the original instruction, the instruction is
+     * relocated into a per-thread scratch slot allocated in the debuggee, followed by a jump back,
+     * and the thread resumes there. The breakpoint stays armed and a hit costs one debug event.
+     * Instructions that cannot be relocated fall back to single-stepping. Exceptions raised by the
+     * relocated instruction report the scratch slot address. Scratch memory is not released on detach.
+     * @param enabled true to enable; false to single-step (default).
+     */
+    void setDisplacedStepping(bool enabled);
+
+    /**
+     * @brief Selects the debug events the loop handles; the others are continued with no target I/O.
+     *
+     * Without EVENT_MODULES, DLL loads and unloads only mark the region index stale (it is walked again on
+     * the next lookup) and modules loaded meanwhile are not known to getModuleByAddress().
+     * @param mask EventMask bits; EVENT_ALL by default.
+     */
+    void setEventMask(uint32_t mask);
+
+    /**
+     * @brief Returns the EventMask bits the loop handles.
+     */
+    inline uint32_t getEventMask() const { return eventMask; }
+
+    /**
+     * @brief Subscribes to or ignores one exception code.
+     *
+     * Ignored exceptions (and all of them without EVENT_EXCEPTION) are passed to the debuggee as not handled,
+     * without opening the thread or calling a callback. Breakpoint and single-step exceptions always reach the
+     * debugger's own breakpoint handling.
+     * @param code EXCEPTION_* code.
+     * @param subscribed false to ignore the code; true (default) to deliver it.
+     */
+    void setExceptionSubscribed(DWORD code, bool subscribed);
+
+    /**
+     * @brief Returns true if an exception code reaches the callbacks.
+     * @param code EXCEPTION_* code.
+     */
+    bool isExceptionSubscribed(DWORD code) const;
+
+    /**
+     * @brief Delivers informational events from a consumer thread while the target keeps running.
+     *
+     * The loop reads the payloads of an event in events (name and entry point of a DLL, debug string text),
+     * queues them and continues the target at once; the callback (onDLLLoadEvent(), onThreadCreate(), ...)
+     * runs later on the pump's consumer thread, in event order. Breakpoints, steps, exceptions, onStart and
+     * onEnd stay synchronous; queued events are delivered before onEnd and before loop() returns. Callbacks
+     * never run at the same time, but an asynchronous one runs while the target and the loop move on: it
+     * should use the event it gets and its own state, not set breakpoints, touch registers or read memory.
+     * Call it before loop() or from a synchronous callback; it takes effect with the next event.
+     * @param events EventMask bits out of EVENT_INFORMATIONAL; EVENT_NONE (default) delivers everything synchronously.
+     * @param options Queue size and what happens when it is full.
+     */
+    void setAsyncEvents(uint32_t events, EventPumpOptions_t options = {});
+
+    /**
+     * @brief Returns the EventMask bits delivered asynchronously.
+     */
+    inline uint32_t getAsyncEvents() const { return asyncEvents; }
+
+    /**
+     * @brief Returns the counters of asynchronous delivery (all zero when it is off).
+     */
+    EventPumpStats_t getEventPumpStats() const;
+
+    /**
+     * @brief Turns the debugger's self-metrics on or off.
+     *
+     * While on, the loop records per event type how long the target stayed stopped (event received until
+     * it is continued) and how long each user callback ran, in log-linear histograms; the backend counts
+     * every remote primitive (memory reads and writes with their bytes, context reads and writes, thread
+     * opens, instruction cache flushes, ...). Off, nothing is recorded and the loop only tests a pointer.
+     * Turning them on again starts from zero. Call it before loop() or from a synchronous callback.
+     * @param enabled true to record.
+     * @param dumpIntervalMs Period of onMetrics(), checked after each event; 0 (default) for none.
+     */
+    void setMetrics(bool enabled, DWORD dumpIntervalMs = 0);
+
+    /**
+     * @brief Returns true while metrics are recorded.
+     */
+    inline bool getMetricsEnabled() const { return metrics != nullptr; }
+
+    /**
+     * @brief Returns the metrics recorded so far (all zero when they are off).
+     */
+    MetricsSnapshot_t getMetrics() const;
+
+    /**
+     * @brief Sets every histogram and counter back to zero.
+     */
+    void resetMetrics();
+
+    /**
+     * @brief Turns tracing of the debugger's internals on or off.
+     *
+     * While on, the loop records spans for waiting on each event, its dispatch, every user callback (also
+     * those run by the event pump), flushing contexts and continuing; the backend adds one per memory,
+     * context, thread and protection primitive; the breakpoint code adds restores, single-steps, re-arms
+     * and displaced steps. Spans go to a buffer preallocated here, so recording neither locks nor
+     * allocates; spans beyond options.maxEvents are dropped and counted. When loop() returns the trace is
+     * written to path, as Chrome trace-event JSON or Perfetto protobuf (both open in ui.perfetto.dev).
+     * Turning it on again starts an empty trace. Call it before loop().
+     * @param enabled true to record.
+     * @param path File written when loop() returns; empty (default) to only write with writeTrace().
+     * @param options Format and capacity.
+     */
+    void setTracing(bool enabled, const std::string& path = "", TraceOptions_t options = {});
+
+    /**
+     * @brief Returns true while spans are recorded.
+     */
+    inline bool getTracingEnabled() const { return tracer != nullptr; }
+
+    /**
+     * @brief Writes the spans recorded so far to a file.
+     * @return false if tracing is off or the file could not be written.
+     */
+    bool writeTrace(const std::string& path, TraceFormat format = TraceFormat::CHROME_JSON) const;
+
+    /**
+     * @brief Returns how many spans did not fit in the trace buffer.
+     */
+    inline uint64_t getTraceDropped() const { return tracer ? tracer->dropped() : 0; }
+
     /**
      * @brief Checks if a hardware breakpoint exists at an address.
      * @param address Address to probe.
@@ -428,6 +928,35 @@ protected:
      */
     bool readMemory(LPVOID address, void* buffer, SIZE_T size);
 
+    /**
+     * @brief Reads many ranges at once.
+     *
+     * Requests are sorted and overlapping / adjacent ones merged, and the merged ranges are read with
+     * one scatter read (process_vm_readv on Linux). While the page cache is on and the target is
+     * stopped, the requests are served from the cache instead.
+     *
+     * @param requests Requests; transferred / ok are filled in, the order is kept.
+     * @param maxGap Also merge requests at most this many bytes apart.
+     * @return Number of requests read completely.
+     */
+    size_t readMany(std::span<ReadRequest_t> requests, SIZE_T maxGap = 0);
+
+    /**
+     * @brief Reads a zero-terminated string in page-bounded chunks (see readTerminated()).
+     * @param address Address of the string.
+     * @param maxLength Most characters read.
+     * @return Characters before the terminator; cut at maxLength or at the first unreadable page.
+     */
+    std::string readCString(uintptr_t address, SIZE_T maxLength = DEFAULT_STRING_LENGTH);
+
+    /**
+     * @brief Reads a zero-terminated UTF-16 string (wchar_t on Windows) in page-bounded chunks.
+     * @param address Address of the string.
+     * @param maxLength Most characters read.
+     * @return Characters before the terminator; cut at maxLength or at the first unreadable page.
+     */
+    std::u16string readWString(uintptr_t address, SIZE_T maxLength = DEFAULT_STRING_LENGTH);
+
     /**
      * @brief Changes memory protection on a region.
      * @param baseAddress Region base.
@@ -438,18 +967,47 @@ protected:
     bool changeMemoryProtection(LPVOID baseAddress, SIZE_T regionSize, DWORD newProtect);
 
     /**
-     * @brief Gets information for the page containing an address.
+     * @brief Gets information for the page containing an address from the region index (O(log n)).
+     *
+     * An address the index does not cover is looked up in the target once and added.
+     *
      * @param baseAddress Address inside the page.
-     * @return Memory region descriptor.
+     * @return Memory region descriptor; all zero if the address is not mapped.
      */
     MemoryRegion_t getPageByAddress(LPVOID baseAddress);
 
     /**
-     * @brief Enumerates readable/committed pages of the process.
+     * @brief Walks the whole address space of the process and rebuilds the region index from it.
      * @return Vector of memory regions.
      */
     std::vector<MemoryRegion_t> getMemoryPages();
 
+    /**
+     * @brief Returns the region and module index, walking the address space once on first use.
+     *
+     * The index follows DLL loads / unloads, changeMemoryProtection() and the debugger's own allocations.
+     * Memory the target maps or reprotects by itself shows up after refreshAddressSpace().
+     */
+    const AddressSpace& getAddressSpace();
+
+    /**
+     * @brief Rebuilds the region index with a full walk of the address space.
+     */
+    void refreshAddressSpace();
+
+    /**
+     * @brief Re-queries the regions of one range of the region index.
+     * @param address Start of the range.
+     * @param size Size of the range.
+     */
+    void refreshAddressSpace(uintptr_t address, SIZE_T size);
+
+    /**
+     * @brief Returns the module containing an address, or nullptr. O(log n).
+     * @param address Address to look up.
+     */
+    const Module_t* getModuleByAddress(uintptr_t address);
+
     /**
      * @brief Changes protection for a specific page descriptor.
      * @param page Page descriptor from getMemoryPages().
@@ -461,9 +1019,155 @@ protected:
     /**
      * @brief Scans process memory for a byte pattern.
      * @param pattern Byte sequence to match.
-     * @return Vector of matched start addresses.
+     * @param options Threads, work item size and result limit (see ScanOptions_t).
+     * @return Vector of matched start addresses in ascending order.
      */
-    std::vector<uintptr_t> searchInMemory(const std::vector<BYTE>& pattern);
+    std::vector<uintptr_t> searchInMemory(const std::vector<BYTE>& pattern, const ScanOptions_t& options = {});
+
+    /**
+     * @brief Scans process memory for a pattern with wildcards.
+     * @param pattern Compiled pattern.
+     * @param options Threads, work item size and result limit (see ScanOptions_t).
+     * @return Vector of matched start addresses in ascending order.
+     */
+    std::vector<uintptr_t> searchInMemory(const BytePattern_t& pattern, const ScanOptions_t& options = {});
+
+    /**
+     * @brief Scans process memory for an IDA-style signature, e.g. "56 57 ?? 8B 54".
+     * @param signature Signature text (see BytePattern_t::parse()).
+     * @param options Threads, work item size and result limit (see ScanOptions_t).
+     * @return Vector of matched start addresses in ascending order; empty if the signature is malformed.
+     */
+    std::vector<uintptr_t> searchInMemory(std::string_view signature, const ScanOptions_t& options = {});
+
+    /**
+     * @brief Scans process memory for many signatures in a single pass.
+     * @param signatures Compiled set (see SignatureSet::compile() / SignatureSet::load()).
+     * @param options Threads, work item size and result limit (see ScanOptions_t).
+     * @return (signature id, address) pairs ordered by address; empty if the set is not compiled.
+     */
+    std::vector<SignatureMatch_t> searchInMemoryMulti(const SignatureSet& signatures, const ScanOptions_t& options = {});
+
+    /**
+     * @brief Finds the ASCII / UTF-16 strings in readable memory, like strings(1) (see StringScanner).
+     * @param strings Lengths and encodings.
+     * @param options Threads, work item size and result limit (see ScanOptions_t).
+     * @return Strings ordered by address.
+     */
+    std::vector<StringHit_t> extractStrings(const StringScanOptions_t& strings = {}, const ScanOptions_t& options = {});
+
+    /**
+     * @brief Like extractStrings(), handing the strings to a callback region batch by region batch.
+     *
+     * Regions are scanned in batches of about 64 MB, so only the strings of one batch are held at once.
+     * The callback runs on the calling thread, in address order.
+     *
+     * @param fn Called for every string; return false to stop.
+     * @param strings Lengths and encodings.
+     * @param options Threads and work item size; maxHits limits the strings handed to fn.
+     * @return Number of strings handed to fn.
+     */
+    size_t extractStrings(const std::function<bool(const StringHit_t&)>& fn,
+                          const StringScanOptions_t& strings = {}, const ScanOptions_t& options = {});
+
+    /**
+     * @brief Creates a value scanner over the memory of the debuggee (see ValueScanner).
+     * @param type Value type.
+     * @param alignment Distance between positions looked at; 0 is the size of the type.
+     * @return Scanner; valid as long as the debugger.
+     */
+    ValueScanner createValueScanner(ValueType type, size_t alignment = 0);
+
+    /**
+     * @brief Builds a pointer map of all readable memory and finds the static paths to an address (see PointerScanner).
+     * @param address Address the paths must end at.
+     * @param options Depth, offset, result and thread limits.
+     * @return Scanner holding the map and the results; scan() it again for other addresses.
+     */
+    PointerScanner pointerScan(uintptr_t address, const PointerScanOptions_t& options = {});
+
+    /**
+     * @brief Resolves pointer paths level by level, with one coalesced read per level (see PointerResolver).
+     *
+     * The resolver is kept by the debugger, so pointers cached through PointerResolverOptions_t::stableLevels
+     * carry over between calls. Its cache is emptied whenever a DLL is loaded or unloaded.
+     *
+     * @param paths Paths such as { base, { 0x10, 0x48, 0x8 } } for [[[base+0x10]+0x48]+0x8].
+     * @return One result per path, in the same order.
+     */
+    std::vector<PointerResult_t> resolvePointerChains(std::span<const PointerPath_t> paths);
+
+    /**
+     * @brief Sets pointer width, batching and prefix caching of resolvePointerChains(); empties its cache.
+     * @param options Resolver options.
+     */
+    void setPointerResolverOptions(const PointerResolverOptions_t& options);
+
+    /**
+     * @brief Returns the work done by the last resolvePointerChains().
+     */
+    PointerResolverStats_t getPointerResolverStats() const;
+
+    /**
+     * @brief Forgets the pointers cached by resolvePointerChains().
+     */
+    void invalidatePointerCache();
+
+    /**
+     * @brief Streams all readable memory through bounded, reused buffers (see RegionReader).
+     * @param fn Called for every chunk in address order; return false to stop.
+     * @param overlap Bytes each chunk repeats from the previous chunk of the same region.
+     * @return Number of chunks handed to fn.
+     */
+    size_t forEachMemoryChunk(const std::function<bool(const MemoryChunk_t&)>& fn, SIZE_T overlap = 0);
+
+    /**
+     * @brief Writes a range of target memory to a file without holding the whole range in memory.
+     * @param address Start of the range.
+     * @param size Size of the range.
+     * @param path Output file; unreadable bytes are written as zeros.
+     * @return true if every byte was read and written; false otherwise.
+     */
+    bool dumpMemory(LPVOID address, SIZE_T size, const std::string& path);
+
+    /**
+     * @brief Sets chunk size, memory ceiling and prefetching used by searchInMemory(), dumpMemory()
+     * and forEachMemoryChunk().
+     * @param options Reader options.
+     */
+    void setReaderOptions(const RegionReaderOptions_t& options);
+
+    /**
+     * @brief Returns the options set with setReaderOptions().
+     */
+    inline const RegionReaderOptions_t& getReaderOptions() const { return readerOptions; }
+
+    /**
+     * @brief Turns the per-stop memory page cache on or off.
+     *
+     * While stopped at a debug event, readMemory() reads whole pages on first touch and serves later
+     * reads of them from the cache; writeMemory() writes through. The cache is emptied before the event
+     * is continued, so callbacks never see memory from an earlier stop.
+     *
+     * @param enabled true to cache.
+     * @param maxPages Pages kept per stop before the cache starts over.
+     */
+    void setMemoryCache(bool enabled, size_t maxPages = PageCache::DEFAULT_MAX_PAGES);
+
+    /**
+     * @brief Returns true if setMemoryCache() turned the cache on.
+     */
+    inline bool isMemoryCacheEnabled() const { return memoryCache != nullptr; }
+
+    /**
+     * @brief Returns the hit / miss counters of the page cache; all zero if it is off.
+     */
+    PageCacheStats_t getMemoryCacheStats() const;
+
+    /**
+     * @brief Empties the page cache, e.g. after the target changed memory through a side channel.
+     */
+    void invalidateMemoryCache();
 
     // ===== Misc =====
 
@@ -493,7 +1197,7 @@ protected:
      */
     void printIP(HANDLE hThread);
 
-#ifdef _WIN64
+#ifdef ROBODBG_X64
     /**
      * @brief Reads a status flag from RFLAGS.
      * @param hThread Thread handle.
@@ -592,6 +1296,17 @@ protected:
         return getPageByAddress(reinterpret_cast<LPVOID>(baseAddress));
     }
 
+    /**
+     * @brief Writes a range of target memory to a file (uintptr_t overload).
+     * @param address Start of the range.
+     * @param size Size of the range.
+     * @param path Output file.
+     * @return true if every byte was read and written; false otherwise.
+     */
+    inline bool dumpMemory(uintptr_t address, SIZE_T size, const std::string& path) {
+        return dumpMemory(reinterpret_cast<LPVOID>(address), size, path);
+    }
+
     /**
      * @brief Verifies existing breakpoints
      * @return Number of removed invalid breakpoints
@@ -688,11 +1403,10 @@ protected:
      */
     template<typename T>
     bool writeMemory(uintptr_t address, const T& value) {
-        SIZE_T bytesWritten = 0;
-        if (!WriteProcessMemory(hProcessGlobal, reinterpret_cast<LPVOID>(address), &value, sizeof(T), &bytesWritten) || bytesWritten != sizeof(T)) {
+        if (!writeTarget(address, &value, sizeof(T))) {
             return false;
         }
-        FlushInstructionCache(hProcessGlobal, reinterpret_cast<LPVOID>(address), sizeof(T));
+        backend->flushInstructionCache(address, sizeof(T));
         return true;
     }
 
@@ -705,8 +1419,7 @@ protected:
     template<typename T>
     T readMemory(uintptr_t address) {
         T value{};
-        SIZE_T bytesRead = 0;
-        if (!ReadProcessMemory(hProcessGlobal, reinterpret_cast<LPCVOID>(address), &value, sizeof(T), &bytesRead) || bytesRead != sizeof(T)) {
+        if (!readTarget(address, &value, sizeof(T))) {
             return T{};
         }
         return value;
@@ -730,11 +1443,31 @@ protected:
     {
         return hProcessGlobal;
     }
+
+    /**
+     * @brief Returns the backend the debugger runs on
+     * @return TargetBackend
+     */
+    inline TargetBackend& getBackend( )
+    {
+        return *backend;
+    }
 public:
+    /**
+     * @brief Returns the debuggee's threads keyed by thread ID.
+     * @return Thread registry
+     */
+    inline const ThreadRegistry& getThreads( ) const
+    {
+        return threads;
+    }
+
+#ifdef _WIN32
     // Plugins
 
     inline auto& getImports() { return imports; }
     inline auto& getFreezer() { return freezer; }
+#endif
 
 
     /**
@@ -748,6 +1481,15 @@ public:
      */
     Debugger(bool verbose);
 
+    /**
+     * @brief Constructs a Debugger on top of a specific backend instead of the native one.
+     * @param backend Backend to drive (e.g. a ptrace or simulated target).
+     * @param verbose Enable verbose logging if true.
+     */
+    Debugger(std::unique_ptr<TargetBackend> backend, bool verbose = false);
+
+    virtual ~Debugger() = default;
+
     /**
      * @brief Starts a process under debugging.
      * @param exeName Path to the executable.
@@ -1,61 +1,155 @@
 #include "debugger.h"
+#include <algorithm>
+#include <cstring>
 
 namespace RoboDBG {
 
 bool Debugger::writeMemory(LPVOID address, const void* buffer, SIZE_T size)
 {
-    SIZE_T bytesWritten = 0;
-    if (!WriteProcessMemory(hProcessGlobal, address, buffer, size, &bytesWritten) || bytesWritten != size) {
-        std::cerr << "WriteProcessMemory failed: " << GetLastError() << std::endl;
+    if (!writeTarget(reinterpret_cast<uintptr_t>(address), buffer, size)) {
+        std::cerr << "WriteProcessMemory failed at " << address << std::endl;
         return false;
     }
-    FlushInstructionCache(hProcessGlobal, address, size);
+    backend->flushInstructionCache(reinterpret_cast<uintptr_t>(address), size);
     return true;
 }
 
 bool Debugger::readMemory(LPVOID address, void* buffer, SIZE_T size)
 {
-    SIZE_T bytesRead = 0;
-    if (!ReadProcessMemory(hProcessGlobal, address, buffer, size, &bytesRead) || bytesRead != size) {
-        std::cerr << "ReadProcessMemory failed: " << GetLastError() << std::endl;
+    if (!readTarget(reinterpret_cast<uintptr_t>(address), buffer, size)) {
+        std::cerr << "ReadProcessMemory failed at " << address << std::endl;
         return false;
     }
     return true;
 }
 
-MemoryRegion_t Debugger::getPageByAddress(LPVOID baseAddress) // TODO: make a std::optional out of it
+size_t Debugger::readMany(std::span<ReadRequest_t> requests, SIZE_T maxGap)
 {
-    SYSTEM_INFO sysInfo;
-    GetSystemInfo(&sysInfo);
+    if (!(memoryCache && stoppedAtEvent)) return readBatch(*backend, requests, maxGap);
 
-    LPVOID addr = sysInfo.lpMinimumApplicationAddress;
-    MEMORY_BASIC_INFORMATION mbi;
+    size_t complete = 0;
+    for (ReadRequest_t& r : requests) {
+        r.transferred = 0;
+        r.ok = memoryCache->read(r.address, r.buffer, r.size, &r.transferred);
+        if (r.ok) ++complete;
+    }
+    return complete;
+}
 
-    while (addr < sysInfo.lpMaximumApplicationAddress) {
-        if (VirtualQueryEx(hProcessGlobal, addr, &mbi, sizeof(mbi)) == 0)
-            break;
+std::string Debugger::readCString(uintptr_t address, SIZE_T maxLength)
+{
+    return readTerminated([this](uintptr_t at, void* buffer, SIZE_T size) { return readTarget(at, buffer, size); },
+                          address, maxLength, 1);
+}
 
-        BYTE* regionStart = static_cast<BYTE*>(mbi.BaseAddress);
-        BYTE* regionEnd = regionStart + mbi.RegionSize;
-        BYTE* target = static_cast<BYTE*>(baseAddress);
+std::u16string Debugger::readWString(uintptr_t address, SIZE_T maxLength)
+{
+    const std::string bytes = readTerminated([this](uintptr_t at, void* buffer, SIZE_T size) { return readTarget(at, buffer, size); },
+                                             address, maxLength * 2, 2);
+    std::u16string text(bytes.size() / 2, u'\0');
+    std::memcpy(text.data(), bytes.data(), text.size() * 2);
+    return text;
+}
 
-        if (target >= regionStart && target < regionEnd) {
-            return MemoryRegion_t {
-                mbi.BaseAddress,
-                mbi.RegionSize,
-                mbi.State,
-                mbi.Protect,
-                mbi.Type
-            };
-        }
+bool Debugger::readTarget(uintptr_t address, void* buffer, SIZE_T size, SIZE_T* bytesRead)
+{
+    if (memoryCache && stoppedAtEvent) return memoryCache->read(address, buffer, size, bytesRead);
+    return backend->readMemory(address, buffer, size, bytesRead);
+}
 
-        addr = regionEnd;
+bool Debugger::writeTarget(uintptr_t address, const void* buffer, SIZE_T size)
+{
+    if (memoryCache && stoppedAtEvent) return memoryCache->write(address, buffer, size);
+    return backend->writeMemory(address, buffer, size);
+}
+
+void Debugger::discardCachedMemory(uintptr_t address, SIZE_T size)
+{
+    if (memoryCache) memoryCache->invalidate(address, size);
+}
+
+void Debugger::setMemoryCache(bool enabled, size_t maxPages)
+{
+    if (!enabled) {
+        memoryCache.reset();
+        return;
+    }
+    if (!memoryCache || memoryCache->maxPages() != maxPages) memoryCache = std::make_unique<PageCache>(*backend, maxPages);
+}
+
+PageCacheStats_t Debugger::getMemoryCacheStats() const
+{
+    return memoryCache ? memoryCache->stats() : PageCacheStats_t{};
+}
+
+void Debugger::invalidateMemoryCache()
+{
+    if (memoryCache) memoryCache->invalidate();
+}
+
+MemoryRegion_t Debugger::getPageByAddress(LPVOID baseAddress) // TODO: make a std::optional out of it
+{
+    const uintptr_t target = reinterpret_cast<uintptr_t>(baseAddress);
+    const MemoryRegion_t* region = getAddressSpace().find(target);
+    if (!region) {
+        // Mapped since the index was built?
+        refreshAddressSpace(target, 1);
+        region = addressSpace.find(target);
     }
+    if (region) return *region;
 
     // Return invalid result
     return MemoryRegion_t { nullptr, 0, 0, 0, 0 };
 }
 
+const AddressSpace& Debugger::getAddressSpace()
+{
+    if (!addressSpace.built()) refreshAddressSpace();
+    return addressSpace;
+}
+
+void Debugger::refreshAddressSpace()
+{
+    addressSpace.assign(backend->getMemoryRegions());
+}
+
+void Debugger::refreshAddressSpace(uintptr_t address, SIZE_T size)
+{
+    if (!addressSpace.built()) {
+        refreshAddressSpace();
+        return;
+    }
+    addressSpace.update(address, size, backend->queryMemoryRegions(address, size));
+}
+
+const Module_t* Debugger::getModuleByAddress(uintptr_t address)
+{
+    return addressSpace.findModule(address);
+}
+
+SIZE_T Debugger::imageSize(EventInfo& event)
+{
+    const uintptr_t imageBase = event.imageBase();
+    if (const PeHeaders_t* pe = event.peHeaders(); pe && pe->sizeOfImage) return pe->sizeOfImage;
+
+    // Other images (ELF on Linux): consecutive MEM_IMAGE regions up to the next module, from a fresh walk
+    refreshAddressSpace();
+    const AddressSpace& space = addressSpace;
+    const MemoryRegion_t* region = space.find(imageBase);
+    if (!region) return 0;
+    const uintptr_t start = reinterpret_cast<uintptr_t>(region->BaseAddress);
+    uintptr_t end = start + region->RegionSize;
+    if (region->Type == MEM_IMAGE) {
+        const std::span<const MemoryRegion_t> all = space.regions();
+        for (size_t i = static_cast<size_t>(region - all.data()) + 1; i < all.size(); ++i) {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(all[i].BaseAddress);
+            if (base != end || all[i].Type != MEM_IMAGE || space.findModule(base)) break;
+            end = base + all[i].RegionSize;
+        }
+    }
+    return end - imageBase;
+}
+
 bool Debugger::changeMemoryProtection(MemoryRegion_t page, DWORD newProtect)
 { // TODO: Use AccessRights enum instead of Memory Protection Constants (https://learn.microsoft.com/en-us/windows/win32/Memory/memory-protection-constants)
     return changeMemoryProtection(page.BaseAddress, page.RegionSize, newProtect);
@@ -63,94 +157,247 @@ bool Debugger::changeMemoryProtection(MemoryRegion_t page, DWORD newProtect)
 
 bool Debugger::changeMemoryProtection(LPVOID baseAddress, SIZE_T regionSize, DWORD newProtect)
 {
-    DWORD oldProtect;
-    if (VirtualProtectEx(hProcessGlobal, baseAddress, regionSize, newProtect, &oldProtect)) {
+    DWORD oldProtect = 0;
+    if (backend->protectMemory(reinterpret_cast<uintptr_t>(baseAddress), regionSize, newProtect, &oldProtect)) {
+        discardCachedMemory(reinterpret_cast<uintptr_t>(baseAddress), regionSize);
+        if (addressSpace.built()) refreshAddressSpace(reinterpret_cast<uintptr_t>(baseAddress), regionSize);
         std::cout << "[+] Changed protection at " << baseAddress
                   << " from 0x" << std::hex << oldProtect
                   << " to 0x" << newProtect << std::endl;
         return true;
     } else {
-        std::cerr << "[-] Failed to change protection at " << baseAddress
-                  << " - Error: " << GetLastError() << std::endl;
+        std::cerr << "[-] Failed to change protection at " << baseAddress << std::endl;
         return false;
     }
 }
 
 std::vector<MemoryRegion_t> Debugger::getMemoryPages()
 {
-    SYSTEM_INFO sysInfo;
-    GetSystemInfo(&sysInfo);
-
-    LPVOID addr = sysInfo.lpMinimumApplicationAddress;
-    MEMORY_BASIC_INFORMATION mbi;
-    std::vector<MemoryRegion_t> regions;
+    refreshAddressSpace();
+    return std::vector<MemoryRegion_t>(addressSpace.regions().begin(), addressSpace.regions().end());
+}
 
-    while (addr < sysInfo.lpMaximumApplicationAddress) {
-        if (VirtualQueryEx(hProcessGlobal, addr, &mbi, sizeof(mbi)) == 0)
-            break;
+std::vector<uintptr_t> Debugger::searchInMemory(const std::vector<BYTE>& pattern, const ScanOptions_t& options)
+{
+    if (pattern.empty()) return {};
+    return searchInMemory(BytePattern_t::exact(pattern), options);
+}
 
-        MemoryRegion_t region;
-        region.BaseAddress = mbi.BaseAddress;
-        region.RegionSize = mbi.RegionSize;
-        region.State = mbi.State;
-        region.Protect = mbi.Protect;
-        region.Type = mbi.Type;
+std::vector<uintptr_t> Debugger::searchInMemory(std::string_view signature, const ScanOptions_t& options)
+{
+    BytePattern_t pattern;
+    if (!BytePattern_t::parse(signature, pattern)) {
+        std::cerr << "[-] Invalid signature: " << signature << std::endl;
+        return {};
+    }
+    return searchInMemory(pattern, options);
+}
 
-        regions.push_back(region);
+template<typename Hit>
+std::vector<Hit> Debugger::scanMemory(std::span<const MemoryRegion_t> regions, SIZE_T overlap, const ScanOptions_t& options,
+                                      const std::function<void(const MemoryChunk_t&, std::vector<Hit>&)>& scan)
+{
+    if (options.threads != 1) {
+        ScanOptions_t parallel = options;
+        if (!parallel.chunkSize) parallel.chunkSize = readerOptions.chunkSize;
+        return ParallelScan(*backend, parallel).collect<Hit>(regions, overlap, scan);
+    }
 
-        addr = static_cast<BYTE*>(mbi.BaseAddress) + mbi.RegionSize;
+    // An explicit item size overrides the reader's chunk size and memory ceiling
+    RegionReaderOptions_t serial = readerOptions;
+    if (options.chunkSize) {
+        serial.chunkSize = options.chunkSize;
+        serial.memoryLimit = std::max(serial.memoryLimit, 2 * options.chunkSize);
     }
+    std::vector<Hit> hits;
+    RegionReader(*backend, serial).forEachChunk(regions, overlap, [&](const MemoryChunk_t& chunk) {
+        scan(chunk, hits);
+        return !options.maxHits || hits.size() < options.maxHits;
+    });
+    if (options.maxHits && hits.size() > options.maxHits) hits.resize(options.maxHits);
+    return hits;
+}
 
-    return regions;
+std::vector<uintptr_t> Debugger::searchInMemory(const BytePattern_t& pattern, const ScanOptions_t& options)
+{
+    if (pattern.empty()) return {};
+    const PatternScanner scanner(pattern);
+
+    // Chunks overlap by one byte less than the pattern, so a match across a boundary is found once
+    return scanMemory<uintptr_t>(readableMemoryRegions(), pattern.size() - 1, options, [&](const MemoryChunk_t& chunk, std::vector<uintptr_t>& hits) {
+        scanner.scan(chunk.data, chunk.size, chunk.address, hits);
+    });
 }
 
-std::vector<uintptr_t> Debugger::searchInMemory(const std::vector<BYTE>& pattern)
+std::vector<SignatureMatch_t> Debugger::searchInMemoryMulti(const SignatureSet& signatures, const ScanOptions_t& options)
 {
-    std::vector<uintptr_t> matches;
-    auto regions = getMemoryPages(); // Ensure correct capitalization if needed
+    if (!signatures.compiled()) {
+        std::cerr << "[-] Signature set is not compiled" << std::endl;
+        return {};
+    }
+    if (signatures.size() == 0) return {};
 
-    for (const auto& region : regions) {
-        // Skip regions that are not committed or inaccessible
-        if (region.State != MEM_COMMIT || (region.Protect & PAGE_GUARD) || (region.Protect == PAGE_NOACCESS))
-            continue;
+    // Overlap for the longest signature; shorter ones are reported by the chunk they start in
+    const SIZE_T overlap = signatures.maxLength() - 1;
+    return scanMemory<SignatureMatch_t>(readableMemoryRegions(), overlap, options, [&](const MemoryChunk_t& chunk, std::vector<SignatureMatch_t>& hits) {
+        const size_t limit = chunk.lastInRegion() ? chunk.size : chunk.requested - overlap;
+        signatures.scan(chunk.data, chunk.size, chunk.address, hits, limit);
+    });
+}
+
+std::vector<StringHit_t> Debugger::extractStrings(const StringScanOptions_t& strings, const ScanOptions_t& options)
+{
+    return extractStrings(readableMemoryRegions(), StringScanner(strings), options);
+}
 
-        std::vector<BYTE> buffer(region.RegionSize);
-        SIZE_T bytesRead;
+size_t Debugger::extractStrings(const std::function<bool(const StringHit_t&)>& fn,
+                                const StringScanOptions_t& strings, const ScanOptions_t& options)
+{
+    constexpr SIZE_T BATCH_BYTES = 64 << 20;
+    const StringScanner scanner(strings);
+    const std::vector<MemoryRegion_t> regions = readableMemoryRegions();
 
-        if (ReadProcessMemory(hProcessGlobal, region.BaseAddress, buffer.data(), region.RegionSize, &bytesRead)) {
-            for (SIZE_T i = 0; i + pattern.size() <= bytesRead; ++i) {
-                if (memcmp(buffer.data() + i, pattern.data(), pattern.size()) == 0) {
-                    matches.push_back(reinterpret_cast<uintptr_t>(region.BaseAddress) + i);
-                }
-            }
+    size_t handed = 0;
+    for (size_t first = 0; first < regions.size(); ) {
+        size_t last = first;
+        SIZE_T bytes = 0;
+        while (last < regions.size() && (last == first || bytes + regions[last].RegionSize <= BATCH_BYTES)) {
+            bytes += regions[last++].RegionSize;
         }
+        ScanOptions_t batch = options;
+        if (options.maxHits) batch.maxHits = options.maxHits - handed;
+        for (const StringHit_t& hit : extractStrings({ regions.data() + first, last - first }, scanner, batch)) {
+            ++handed;
+            if (!fn(hit) || (options.maxHits && handed >= options.maxHits)) return handed;
+        }
+        first = last;
     }
+    return handed;
+}
 
-    return matches;
+std::vector<StringHit_t> Debugger::extractStrings(std::span<const MemoryRegion_t> regions, const StringScanner& scanner,
+                                                  const ScanOptions_t& options)
+{
+    // A string starting at the seam of two chunks is the earlier chunk's (see StringScanner::overlap())
+    const SIZE_T overlap = scanner.overlap();
+    return scanMemory<StringHit_t>(regions, overlap, options, [&](const MemoryChunk_t& chunk, std::vector<StringHit_t>& hits) {
+        const size_t first = chunk.overlap ? 1 : 0;
+        const size_t limit = chunk.lastInRegion() ? chunk.size : chunk.requested - overlap + 1;
+        scanner.scan(chunk.data, chunk.size, chunk.address, hits, first, limit);
+    });
 }
 
-// -------------------------------------------------------------
-// prints all memory pages for debugging reasonss
-// -------------------------------------------------------------
-void Debugger::PrintMemoryPages()
+ValueScanner Debugger::createValueScanner(ValueType type, size_t alignment)
+{
+    return ValueScanner(*backend, type, alignment);
+}
+
+PointerScanner Debugger::pointerScan(uintptr_t address, const PointerScanOptions_t& options)
+{
+    PointerScanner scanner(options);
+    scanner.buildMap(*backend, readableMemoryRegions());
+    scanner.scan(address, getAddressSpace().modules());
+    return scanner;
+}
+
+std::vector<PointerResult_t> Debugger::resolvePointerChains(std::span<const PointerPath_t> paths)
+{
+    if (!pointerResolver) pointerResolver = std::make_unique<PointerResolver>(*backend);
+    return pointerResolver->resolve(paths);
+}
+
+void Debugger::setPointerResolverOptions(const PointerResolverOptions_t& options)
+{
+    if (!pointerResolver) pointerResolver = std::make_unique<PointerResolver>(*backend, options);
+    else pointerResolver->setOptions(options);
+}
+
+PointerResolverStats_t Debugger::getPointerResolverStats() const
 {
-    SYSTEM_INFO sysInfo;
-    GetSystemInfo(&sysInfo);
+    return pointerResolver ? pointerResolver->stats() : PointerResolverStats_t{};
+}
+
+void Debugger::invalidatePointerCache()
+{
+    if (pointerResolver) pointerResolver->invalidate();
+}
+
+void Debugger::setReaderOptions(const RegionReaderOptions_t& options)
+{
+    readerOptions = options;
+}
+
+std::vector<MemoryRegion_t> Debugger::readableMemoryRegions()
+{
+    std::vector<MemoryRegion_t> regions = getMemoryPages();
+    regions.erase(std::remove_if(regions.begin(), regions.end(),
+                                 [](const MemoryRegion_t& r) { return !RegionReader::readable(r); }),
+                  regions.end());
+    return regions;
+}
+
+size_t Debugger::forEachMemoryChunk(const std::function<bool(const MemoryChunk_t&)>& fn, SIZE_T overlap)
+{
+    const std::vector<MemoryRegion_t> regions = readableMemoryRegions();
+    RegionReader reader(*backend, readerOptions);
+    return reader.forEachChunk(regions, overlap, fn);
+}
 
-    LPVOID addr = sysInfo.lpMinimumApplicationAddress;
-    MEMORY_BASIC_INFORMATION mbi;
+bool Debugger::dumpMemory(LPVOID address, SIZE_T size, const std::string& path)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "[-] Failed to open " << path << std::endl;
+        return false;
+    }
 
-    while (addr < sysInfo.lpMaximumApplicationAddress) {
-        if (VirtualQueryEx(hProcessGlobal, addr, &mbi, sizeof(mbi)) == 0)
-            break;
+    const uintptr_t start = reinterpret_cast<uintptr_t>(address);
+    const MemoryRegion_t range{ address, size, MEM_COMMIT, PAGE_READONLY, 0 };
+    const std::vector<BYTE> zeros(4096, 0);
+    uintptr_t written = start;
+    auto pad = [&](uintptr_t to) {
+        while (written < to) {
+            const SIZE_T n = std::min<SIZE_T>(zeros.size(), to - written);
+            out.write(reinterpret_cast<const char*>(zeros.data()), static_cast<std::streamsize>(n));
+            written += n;
+        }
+    };
 
-        std::cout << "BaseAddr: " << mbi.BaseAddress
-                  << " | RegionSize: " << mbi.RegionSize
-                  << " | State: " << std::hex << mbi.State
-                  << " | Protect: " << mbi.Protect
-                  << " | Type: " << mbi.Type << std::endl;
+    SIZE_T missing = 0;
+    RegionReader reader(*backend, readerOptions);
+    reader.forEachChunk(std::span<const MemoryRegion_t>(&range, 1), 0, [&](const MemoryChunk_t& chunk) {
+        missing += chunk.address - written; // chunks that could not be read at all are skipped
+        pad(chunk.address);
+        out.write(reinterpret_cast<const char*>(chunk.data), static_cast<std::streamsize>(chunk.size));
+        written += chunk.size;
+        missing += chunk.requested - chunk.size;
+        pad(chunk.address + chunk.requested);
+        return static_cast<bool>(out);
+    });
+    missing += start + size - written;
+    pad(start + size);
+
+    if (!out) {
+        std::cerr << "[-] Failed to write " << path << std::endl;
+        return false;
+    }
+    if (missing) {
+        std::cerr << "[-] " << std::dec << missing << " bytes at " << address << " could not be read" << std::endl;
+    }
+    return missing == 0;
+}
 
-        addr = static_cast<BYTE*>(mbi.BaseAddress) + mbi.RegionSize;
+// -------------------------------------------------------------
+// prints all memory pages for debugging reasonss
+// -------------------------------------------------------------
+void Debugger::PrintMemoryPages()
+{
+    for (const auto& region : backend->getMemoryRegions()) {
+        std::cout << "BaseAddr: " << region.BaseAddress
+                  << " | RegionSize: " << region.RegionSize
+                  << " | State: " << std::hex << region.State
+                  << " | Protect: " << region.Protect
+                  << " | Type: " << region.Type << std::endl;
     }
 }
 
@@ -6,8 +6,13 @@ namespace RoboDBG {
     bool Debugger::initPlugins( )
     {
         if(hProcessGlobal == nullptr) return false;
+        #ifdef _WIN32
         this->imports = std::make_unique<Imports>(hProcessGlobal);
         this->freezer = std::make_unique<Freezer>(hProcessGlobal);
+        this->freezer->setThreadSource([this]() { return threads.threadIds(); });
         return true;
+        #else
+        return false; // Imports / Freezer are Windows only
+        #endif
     }
 }
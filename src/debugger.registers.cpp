@@ -1,210 +1,182 @@
-
 #include "debugger.h"
 
 namespace RoboDBG {
     // ===========================
-    // GET REGISTER
+    // CONTEXT CACHE
     // ===========================
 
-    #ifdef _WIN64
-    int64_t Debugger::getRegister(HANDLE hThread, Register64 reg) {
-        CONTEXT ctx = {};
-        ctx.ContextFlags = CONTEXT_ALL;
+    ThreadInfo_t* Debugger::findThread(HANDLE hThread) {
+        // Nearly every call is for the thread that reported the event
+        ThreadInfo_t* thread = threads.find(eventThreadId);
+        if (thread && thread->hThread == hThread) return thread;
+        for (ThreadInfo_t& t : threads) {
+            if (t.hThread == hThread) return &t;
+        }
+        return nullptr;
+    }
 
-        if (!GetThreadContext(hThread, &ctx)) {
-            std::cerr << "GetThreadContext failed: " << GetLastError() << "\n";
-            return -1;
+    ThreadContext_t* Debugger::loadContext(HANDLE hThread, DWORD parts) {
+        ThreadInfo_t* thread = stoppedAtEvent ? findThread(hThread) : nullptr;
+        if (!thread) {
+            uncachedContext = ThreadInfo_t{};
+            uncachedContext.hThread = hThread;
+            if (!backend->getContext(hThread, uncachedContext.context, parts)) return nullptr;
+            uncachedContext.contextParts = parts;
+            return &uncachedContext.context;
         }
 
-        switch (reg) {
-            case Register64::RAX: return ctx.Rax;
-            case Register64::RBX: return ctx.Rbx;
-            case Register64::RCX: return ctx.Rcx;
-            case Register64::RDX: return ctx.Rdx;
-            case Register64::RSI: return ctx.Rsi;
-            case Register64::RDI: return ctx.Rdi;
-            case Register64::RBP: return ctx.Rbp;
-            case Register64::RSP: return ctx.Rsp;
-            case Register64::R8:  return ctx.R8;
-            case Register64::R9:  return ctx.R9;
-            case Register64::R10: return ctx.R10;
-            case Register64::R11: return ctx.R11;
-            case Register64::R12: return ctx.R12;
-            case Register64::R13: return ctx.R13;
-            case Register64::R14: return ctx.R14;
-            case Register64::R15: return ctx.R15;
-            case Register64::RIP: return ctx.Rip;
+        const DWORD missing = parts & ~thread->contextParts;
+        if (missing) {
+            // Backends only fill the requested parts, so the dirty rest of the cache survives
+            if (!backend->getContext(hThread, thread->context, missing)) return nullptr;
+            if (thread->contextParts == 0) cachedContexts.push_back(thread->threadId);
+            thread->contextParts |= missing;
+        }
+        return &thread->context;
+    }
+
+    bool Debugger::storeContext(HANDLE hThread, DWORD parts) {
+        ThreadInfo_t* thread = stoppedAtEvent ? findThread(hThread) : nullptr;
+        if (thread && (thread->contextParts & parts) == parts) {
+            thread->dirtyParts |= parts;
+            return true;
         }
 
-        return -1;
+        if (uncachedContext.hThread != hThread || (uncachedContext.contextParts & parts) != parts) return false;
+        backend->suspendThread(hThread);
+        const bool ok = backend->setContext(hThread, uncachedContext.context, parts);
+        backend->resumeThread(hThread);
+        return ok;
     }
 
-    void Debugger::setRegister(HANDLE hThread, Register64 reg, int64_t value) {
-        CONTEXT ctx = {};
-        ctx.ContextFlags = CONTEXT_ALL;
+    void Debugger::flushContexts() {
+        for (DWORD threadId : cachedContexts) {
+            ThreadInfo_t* thread = threads.find(threadId);
+            if (!thread) continue; // exited during the event
+            if (thread->dirtyParts && !backend->setContext(thread->hThread, thread->context, thread->dirtyParts)) {
+                std::cerr << "[-] Failed to write context of thread " << threadId << "\n";
+            }
+            thread->contextParts = 0;
+            thread->dirtyParts = 0;
+        }
+        cachedContexts.clear();
+    }
 
-        if (!GetThreadContext(hThread, &ctx)) {
-            std::cerr << "GetThreadContext failed: " << GetLastError() << "\n";
-            return;
+    // ===========================
+    // GET REGISTER
+    // ===========================
+
+    #ifdef ROBODBG_X64
+    int64_t Debugger::getRegister(HANDLE hThread, Register64 reg) {
+        const ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_CONTROL | CONTEXT_PART_INTEGER);
+        if (!ctx) {
+            std::cerr << "GetThreadContext failed\n";
+            return -1;
         }
 
-        switch (reg) {
-            case Register64::RAX: ctx.Rax = value; break;
-            case Register64::RBX: ctx.Rbx = value; break;
-            case Register64::RCX: ctx.Rcx = value; break;
-            case Register64::RDX: ctx.Rdx = value; break;
-            case Register64::RSI: ctx.Rsi = value; break;
-            case Register64::RDI: ctx.Rdi = value; break;
-            case Register64::RBP: ctx.Rbp = value; break;
-            case Register64::RSP: ctx.Rsp = value; break;
-            case Register64::R8:  ctx.R8  = value; break;
-            case Register64::R9:  ctx.R9  = value; break;
-            case Register64::R10: ctx.R10 = value; break;
-            case Register64::R11: ctx.R11 = value; break;
-            case Register64::R12: ctx.R12 = value; break;
-            case Register64::R13: ctx.R13 = value; break;
-            case Register64::R14: ctx.R14 = value; break;
-            case Register64::R15: ctx.R15 = value; break;
-            case Register64::RIP: ctx.Rip = value; break;
+        // gpr[] is laid out like Register64
+        if (reg == Register64::RIP) return static_cast<int64_t>(ctx->ip);
+        return static_cast<int64_t>(ctx->gpr[static_cast<int>(reg)]);
+    }
+
+    void Debugger::setRegister(HANDLE hThread, Register64 reg, int64_t value) {
+        const DWORD parts = CONTEXT_PART_CONTROL | CONTEXT_PART_INTEGER;
+        ThreadContext_t* ctx = loadContext(hThread, parts);
+        if (!ctx) {
+            std::cerr << "GetThreadContext failed\n";
+            return;
         }
 
-        SetThreadContext(hThread, &ctx);
+        if (reg == Register64::RIP) ctx->ip = static_cast<DWORD64>(value);
+        else ctx->gpr[static_cast<int>(reg)] = static_cast<DWORD64>(value);
+
+        storeContext(hThread, parts);
     }
     #else
     int32_t Debugger::getRegister(HANDLE hThread, Register32 reg) {
-        CONTEXT ctx = {};
-        ctx.ContextFlags = CONTEXT_ALL;
-
-        if (!GetThreadContext(hThread, &ctx)) {
-            std::cerr << "GetThreadContext failed: " << GetLastError() << "\n";
+        const ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_CONTROL | CONTEXT_PART_INTEGER);
+        if (!ctx) {
+            std::cerr << "GetThreadContext failed\n";
             return -1;
         }
 
-        switch (reg) {
-            case Register32::EAX: return ctx.Eax;
-            case Register32::EBX: return ctx.Ebx;
-            case Register32::ECX: return ctx.Ecx;
-            case Register32::EDX: return ctx.Edx;
-            case Register32::ESI: return ctx.Esi;
-            case Register32::EDI: return ctx.Edi;
-            case Register32::EBP: return ctx.Ebp;
-            case Register32::ESP: return ctx.Esp;
-            case Register32::EIP: return ctx.Eip;
-        }
-
-        return -1; // unreachable if all cases covered
+        // gpr[] is laid out like Register32
+        if (reg == Register32::EIP) return static_cast<int32_t>(ctx->ip);
+        return static_cast<int32_t>(ctx->gpr[static_cast<int>(reg)]);
     }
 
     void Debugger::setRegister(HANDLE hThread, Register32 reg, int value) {
-        CONTEXT ctx = {};
-        ctx.ContextFlags = CONTEXT_ALL;
-
-        if (!GetThreadContext(hThread, &ctx)) {
-            std::cerr << "GetThreadContext failed: " << GetLastError() << "\n";
+        const DWORD parts = CONTEXT_PART_CONTROL | CONTEXT_PART_INTEGER;
+        ThreadContext_t* ctx = loadContext(hThread, parts);
+        if (!ctx) {
+            std::cerr << "GetThreadContext failed\n";
             return;
         }
 
-        switch (reg) {
-            case Register32::EAX: ctx.Eax = value; break;
-            case Register32::EBX: ctx.Ebx = value; break;
-            case Register32::ECX: ctx.Ecx = value; break;
-            case Register32::EDX: ctx.Edx = value; break;
-            case Register32::ESI: ctx.Esi = value; break;
-            case Register32::EDI: ctx.Edi = value; break;
-            case Register32::EBP: ctx.Ebp = value; break;
-            case Register32::ESP: ctx.Esp = value; break;
-            case Register32::EIP: ctx.Eip = value; break;
-        }
+        if (reg == Register32::EIP) ctx->ip = static_cast<DWORD>(value);
+        else ctx->gpr[static_cast<int>(reg)] = static_cast<DWORD>(value);
 
-        SetThreadContext(hThread, &ctx);
+        storeContext(hThread, parts);
     }
 
     #endif
 
 
-    #ifdef _WIN64
+    #ifdef ROBODBG_X64
     void Debugger::setFlag(HANDLE hThread, Flags64 flag, bool enabled) {
-        SuspendThread(hThread);
-
-        CONTEXT ctx = {};
-        ctx.ContextFlags = CONTEXT_FULL;
-
-        if (!GetThreadContext(hThread, &ctx)) {
+        ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_CONTROL);
+        if (!ctx) {
             std::cerr << "GetThreadContext failed\n";
-            ResumeThread(hThread);
             return;
         }
 
         if (enabled)
-            ctx.EFlags |= static_cast<DWORD64>(flag);
+            ctx->flags |= static_cast<DWORD64>(flag);
         else
-            ctx.EFlags &= ~static_cast<DWORD64>(flag);
+            ctx->flags &= ~static_cast<DWORD64>(flag);
 
-        if (!SetThreadContext(hThread, &ctx)) {
+        if (!storeContext(hThread, CONTEXT_PART_CONTROL)) {
             std::cerr << "SetThreadContext failed\n";
         }
-
-        ResumeThread(hThread);
     }
 
     bool Debugger::getFlag(HANDLE hThread, Flags64 flag) {
-        SuspendThread(hThread);
-
-        CONTEXT ctx = {};
-        ctx.ContextFlags = CONTEXT_FULL;
-
-        if (!GetThreadContext(hThread, &ctx)) {
+        const ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_CONTROL);
+        if (!ctx) {
             std::cerr << "GetThreadContext failed\n";
-            ResumeThread(hThread);
             return false;
         }
 
-        bool result = (ctx.EFlags & static_cast<DWORD64>(flag)) != 0;
-        ResumeThread(hThread);
-        return result;
+        return (ctx->flags & static_cast<DWORD64>(flag)) != 0;
     }
 
     #else
 
     void Debugger::setFlag(HANDLE hThread, Flags32 flag, bool enabled) {
-        SuspendThread(hThread);
-
-        CONTEXT ctx = {};
-        ctx.ContextFlags = CONTEXT_FULL;
-
-        if (!GetThreadContext(hThread, &ctx)) {
+        ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_CONTROL);
+        if (!ctx) {
             std::cerr << "GetThreadContext failed\n";
-            ResumeThread(hThread);
             return;
         }
 
         if (enabled)
-            ctx.EFlags |= static_cast<DWORD>(flag);
+            ctx->flags |= static_cast<DWORD>(flag);
         else
-            ctx.EFlags &= ~static_cast<DWORD>(flag);
+            ctx->flags &= ~static_cast<DWORD64>(static_cast<DWORD>(flag));
 
-        if (!SetThreadContext(hThread, &ctx)) {
+        if (!storeContext(hThread, CONTEXT_PART_CONTROL)) {
             std::cerr << "SetThreadContext failed\n";
         }
-
-        ResumeThread(hThread);
     }
 
     bool Debugger::getFlag(HANDLE hThread, Flags32 flag) {
-        SuspendThread(hThread);
-
-        CONTEXT ctx = {};
-        ctx.ContextFlags = CONTEXT_FULL;
-
-        if (!GetThreadContext(hThread, &ctx)) {
+        const ThreadContext_t* ctx = loadContext(hThread, CONTEXT_PART_CONTROL);
+        if (!ctx) {
             std::cerr << "GetThreadContext failed\n";
-            ResumeThread(hThread);
             return false;
         }
 
-        bool result = (ctx.EFlags & static_cast<DWORD>(flag)) != 0;
-        ResumeThread(hThread);
-        return result;
+        return (ctx->flags & static_cast<DWORD>(flag)) != 0;
     }
 
     #endif
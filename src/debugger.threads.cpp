@@ -0,0 +1,71 @@
+#include "debugger.h"
+
+#include <algorithm>
+
+namespace RoboDBG {
+
+ThreadInfo_t* Debugger::trackThread(DWORD threadId) {
+    if (ThreadInfo_t* known = threads.find(threadId)) return known;
+
+    HANDLE hThread = backend->openThread(threadId);
+    if (!hThread) return nullptr;
+
+    ThreadInfo_t& thread = threads.insert(threadId);
+    thread.hThread = hThread;
+    return &thread;
+}
+
+void Debugger::untrackThread(DWORD threadId) {
+    if (ThreadInfo_t* thread = threads.find(threadId)) {
+        closeThreadHandle(thread->hThread);
+        threads.erase(threadId);
+    }
+}
+
+void Debugger::releaseThreads() {
+    for (const ThreadInfo_t& thread : threads) closeThreadHandle(thread.hThread);
+    threads.clear();
+    cachedContexts.clear();
+    closeHeldThreads();
+}
+
+void Debugger::closeThreadHandle(HANDLE hThread) {
+    if (eventPump) {
+        const EventPumpStats_t stats = eventPump->stats();
+        if (stats.delivered < stats.queued) {
+            heldThreads.push_back(HeldThread_t{ hThread, stats.queued });
+            return;
+        }
+    }
+    backend->closeThread(hThread);
+}
+
+void Debugger::closeHeldThreads() {
+    if (heldThreads.empty()) return;
+    const uint64_t delivered = eventPump ? eventPump->stats().delivered : UINT64_MAX;
+    auto open = std::remove_if(heldThreads.begin(), heldThreads.end(), [&](const HeldThread_t& held) {
+        if (held.queued > delivered) return false;
+        backend->closeThread(held.hThread);
+        return true;
+    });
+    heldThreads.erase(open, heldThreads.end());
+}
+
+//actualize a thread list. e.g. after attaching to an existing running application;
+void Debugger::actualizeThreadList() {
+    std::vector<DWORD> live = backend->enumerateThreads();
+    std::sort(live.begin(), live.end());
+
+    // Threads that exited without an EXIT_THREAD event
+    for (DWORD threadId : threads.threadIds()) {
+        if (!std::binary_search(live.begin(), live.end(), threadId)) untrackThread(threadId);
+    }
+
+    for (DWORD threadId : live) {
+        if (!trackThread(threadId)) {
+            std::cerr << "[-] Failed to open thread " << threadId << std::endl;
+        }
+    }
+}
+
+}
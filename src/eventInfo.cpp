@@ -0,0 +1,126 @@
+#include "eventInfo.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace RoboDBG {
+
+namespace {
+    // Headers usually sit within the first few hundred bytes; one read covers DOS stub and NT headers
+    constexpr SIZE_T HEADER_READ = 0x400;
+    constexpr size_t NT_FIELDS = 0x60; // signature, file header and the optional header up to DllCharacteristics
+
+    template<typename T>
+    T field(const BYTE* p, size_t offset) {
+        T v;
+        std::memcpy(&v, p + offset, sizeof(T));
+        return v;
+    }
+}
+
+bool parsePeHeaders(const BYTE* data, size_t size, PeHeaders_t& out) {
+    if (size < 0x40 || field<uint16_t>(data, 0) != 0x5A4D) return false;
+    const uint32_t lfanew = field<uint32_t>(data, 0x3C);
+    if (lfanew > size || size - lfanew < NT_FIELDS) return false;
+
+    const BYTE* nt = data + lfanew;
+    if (field<uint32_t>(nt, 0) != 0x00004550) return false;
+    const uint16_t magic = field<uint16_t>(nt, 0x18);
+    if (magic != 0x10B && magic != 0x20B) return false;
+
+    // Offsets from the PE signature; the two optional header layouts differ only around ImageBase
+    out.machine            = field<uint16_t>(nt, 0x04);
+    out.sections           = field<uint16_t>(nt, 0x06);
+    out.timeDateStamp      = field<uint32_t>(nt, 0x08);
+    out.characteristics    = field<uint16_t>(nt, 0x16);
+    out.magic              = magic;
+    out.entryPoint         = field<uint32_t>(nt, 0x28);
+    out.imageBase          = magic == 0x20B ? field<uint64_t>(nt, 0x30) : field<uint32_t>(nt, 0x34);
+    out.sizeOfImage        = field<uint32_t>(nt, 0x50);
+    out.sizeOfHeaders      = field<uint32_t>(nt, 0x54);
+    out.subsystem          = field<uint16_t>(nt, 0x5C);
+    out.dllCharacteristics = field<uint16_t>(nt, 0x5E);
+    return true;
+}
+
+EventInfo::EventInfo(TargetBackend& target, const DebugEvent_t& event, EventPayload_t payload)
+    : target_(target), event_(event), payload_(std::move(payload)) {
+}
+
+const std::string& EventInfo::moduleName() {
+    if (!payload_.moduleName) payload_.moduleName = target_.getModuleName(event_);
+    return *payload_.moduleName;
+}
+
+const PeHeaders_t* EventInfo::peHeaders() {
+    std::optional<PeHeaders_t>& headers = payload_.peHeaders;
+    if (payload_.peRead) return headers ? &*headers : nullptr;
+    payload_.peRead = true;
+
+    BYTE buffer[HEADER_READ];
+    SIZE_T got = 0;
+    target_.readMemory(event_.imageBase, buffer, sizeof(buffer), &got);
+    if (got < 0x40 || field<uint16_t>(buffer, 0) != 0x5A4D) return nullptr;
+
+    PeHeaders_t pe;
+    const uint32_t lfanew = field<uint32_t>(buffer, 0x3C);
+    if (static_cast<SIZE_T>(lfanew) + NT_FIELDS <= got) {
+        if (parsePeHeaders(buffer, got, pe)) headers = pe;
+    } else {
+        // Long DOS stub: read the NT headers on their own, behind a copy of the DOS header pointing at them
+        BYTE image[0x40 + NT_FIELDS];
+        std::memcpy(image, buffer, 0x40);
+        const uint32_t moved = 0x40;
+        std::memcpy(image + 0x3C, &moved, sizeof(moved));
+        if (target_.readMemory(event_.imageBase + lfanew, image + 0x40, NT_FIELDS)
+            && parsePeHeaders(image, sizeof(image), pe)) headers = pe;
+    }
+    return headers ? &*headers : nullptr;
+}
+
+uintptr_t EventInfo::entryPoint() {
+    std::optional<uintptr_t>& entry = payload_.entryPoint;
+    if (!entry) {
+        if (const PeHeaders_t* pe = peHeaders()) {
+            entry = pe->entryPoint ? event_.imageBase + pe->entryPoint : 0;
+        } else {
+            entry = target_.getEntryPoint(event_.imageBase); // ELF and other formats
+        }
+    }
+    return *entry;
+}
+
+const std::string& EventInfo::debugString() {
+    if (!payload_.debugString) payload_.debugString = target_.getDebugString(event_);
+    return *payload_.debugString;
+}
+
+ExceptionRecord_t EventInfo::exception() const {
+    ExceptionRecord_t record;
+    record.code = event_.exceptionCode;
+    record.address = event_.exceptionAddress;
+    record.info[0] = event_.exceptionInfo[0];
+    record.info[1] = event_.exceptionInfo[1];
+    record.firstChance = event_.firstChance;
+    return record;
+}
+
+EventPayload_t EventInfo::snapshot() {
+    switch (event_.type) {
+        case DebugEventType::CREATE_PROCESS:
+        case DebugEventType::LOAD_DLL:
+            entryPoint();
+            [[fallthrough]];
+        case DebugEventType::UNLOAD_DLL:
+            moduleName();
+            break;
+        case DebugEventType::DEBUG_STRING:
+            debugString();
+            break;
+        default:
+            break;
+    }
+    return payload_;
+}
+
+} // namespace RoboDBG
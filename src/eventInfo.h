@@ -0,0 +1,140 @@
+/**
+ * @file eventInfo.h
+ * @brief Debug event handed to callbacks, with payloads read from the target on first use
+ * @author Milkshake
+ */
+
+#ifndef EVENTINFO_H
+#define EVENTINFO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "platform.h"
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    /**
+     * @struct PeHeaders_t
+     * @brief The fields of a mapped PE image's file and optional headers callbacks usually ask for.
+     */
+    struct PeHeaders_t {
+        uint16_t machine = 0;            ///< IMAGE_FILE_MACHINE_*.
+        uint16_t sections = 0;           ///< Number of section headers.
+        uint32_t timeDateStamp = 0;      ///< Link time.
+        uint16_t characteristics = 0;    ///< IMAGE_FILE_* flags.
+        uint16_t magic = 0;              ///< 0x10B (PE32) or 0x20B (PE32+).
+        uint32_t entryPoint = 0;         ///< AddressOfEntryPoint (RVA; 0 for most resource-only DLLs).
+        uint64_t imageBase = 0;          ///< Preferred base address.
+        uint32_t sizeOfImage = 0;        ///< Bytes the image occupies once mapped.
+        uint32_t sizeOfHeaders = 0;      ///< Bytes of headers at the start of the image.
+        uint16_t subsystem = 0;          ///< IMAGE_SUBSYSTEM_*.
+        uint16_t dllCharacteristics = 0; ///< IMAGE_DLLCHARACTERISTICS_* flags.
+
+        inline bool is64() const { return magic == 0x20B; }
+    };
+
+    /**
+     * @brief Parses the DOS, file and optional headers at the start of an image.
+     * @param data Bytes from the image base.
+     * @param size Bytes available.
+     * @param out Receives the headers.
+     * @return false if the signatures do not match or the headers are not in data.
+     */
+    bool parsePeHeaders(const BYTE* data, size_t size, PeHeaders_t& out);
+
+    /**
+     * @struct ExceptionRecord_t
+     * @brief Exception details of an EXCEPTION event.
+     */
+    struct ExceptionRecord_t {
+        DWORD code = 0;                 ///< EXCEPTION_* code.
+        uintptr_t address = 0;          ///< Faulting instruction.
+        ULONG_PTR info[2] = {};         ///< Access type / faulting address for access violations.
+        bool firstChance = true;        ///< First chance exception.
+    };
+
+    /**
+     * @struct EventPayload_t
+     * @brief What an EventInfo has read from the target so far.
+     */
+    struct EventPayload_t {
+        std::optional<std::string> moduleName;
+        std::optional<std::string> debugString;
+        std::optional<uintptr_t> entryPoint;
+        std::optional<PeHeaders_t> peHeaders;
+        bool peRead = false;            ///< peHeaders was looked for (it stays empty for non-PE images).
+    };
+
+    /**
+     * @class EventInfo
+     * @brief A debug event as callbacks see it; payloads are read from the target once, when first asked for.
+     *
+     * Constructing an EventInfo reads nothing. moduleName(), peHeaders(), entryPoint() and debugString() each read
+     * on their first call and return the kept value afterwards; entryPoint() and the image size used by the module
+     * index share one header read. The object is only valid until the event is continued: the module name
+     * pointer of a Windows LOAD_DLL event does not outlive it.
+     */
+    class EventInfo {
+    public:
+        /**
+         * @brief Wraps an event; nothing is read.
+         * @param target Backend the event came from.
+         * @param event The event; must outlive this object.
+         * @param payload Payloads read earlier (see snapshot()); accessors holding one do not read.
+         */
+        EventInfo(TargetBackend& target, const DebugEvent_t& event, EventPayload_t payload = {});
+
+        inline const DebugEvent_t& raw() const { return event_; }
+        inline DebugEventType type() const { return event_.type; }
+        inline DWORD processId() const { return event_.processId; }
+        inline DWORD threadId() const { return event_.threadId; }
+
+        /**
+         * @brief Returns the module base of a CREATE_PROCESS / LOAD_DLL / UNLOAD_DLL event.
+         */
+        inline uintptr_t imageBase() const { return event_.imageBase; }
+
+        /**
+         * @brief Returns the module's file name (CREATE_PROCESS / LOAD_DLL / UNLOAD_DLL); read on first call.
+         */
+        const std::string& moduleName();
+
+        /**
+         * @brief Returns the PE headers of the module, or nullptr if the base holds no PE image; read on first call.
+         */
+        const PeHeaders_t* peHeaders();
+
+        /**
+         * @brief Returns the module's entry point address, or 0; from the PE headers, else asked from the backend.
+         */
+        uintptr_t entryPoint();
+
+        /**
+         * @brief Returns the text of a DEBUG_STRING event as UTF-8; read on first call.
+         */
+        const std::string& debugString();
+
+        /**
+         * @brief Returns the exception details of an EXCEPTION event (no read).
+         */
+        ExceptionRecord_t exception() const;
+
+        /**
+         * @brief Reads every payload the event type carries and returns a copy of them, so an EventInfo built
+         * from a copy of the event answers after the event was continued without touching the target.
+         */
+        EventPayload_t snapshot();
+
+    private:
+        TargetBackend& target_;
+        const DebugEvent_t& event_;
+        EventPayload_t payload_;
+    };
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,91 @@
+#include "eventPump.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace RoboDBG {
+
+// Sleeping and waking: each side stores its flag, then a seq_cst fence, then looks at the other side's
+// counter. Either the sleeper sees the new element / free slot, or the waker sees the flag and notifies.
+
+EventPump::EventPump(EventPumpOptions_t options, Deliver deliver)
+    : options_(options), deliver_(std::move(deliver)), ring_(std::max<size_t>(options.capacity, 2)) {
+    options_.capacity = ring_.capacity();
+    consumer_ = std::thread(&EventPump::run, this);
+}
+
+EventPump::~EventPump() {
+    stop_.store(true);
+    wakeups_.fetch_add(1);
+    wakeups_.notify_one();
+    consumer_.join();
+}
+
+bool EventPump::push(QueuedEvent_t&& event) {
+    if (!ring_.push(std::move(event))) {
+        if (options_.overflow == OverflowPolicy::DROP) {
+            ++stats_.dropped;
+            return false;
+        }
+        ++stats_.blocked;
+        waitForPops(stats_.queued - ring_.capacity() + 1);
+        ring_.push(std::move(event));
+    }
+    ++stats_.queued;
+    stats_.maxDepth = std::max<uint64_t>(stats_.maxDepth, ring_.size());
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumerSleeping_.load(std::memory_order_relaxed)) {
+        wakeups_.fetch_add(1);
+        wakeups_.notify_one();
+    }
+    return true;
+}
+
+void EventPump::drain() {
+    waitForPops(stats_.queued);
+}
+
+void EventPump::waitForPops(uint64_t target) {
+    std::atomic<uint64_t>& popped = ring_.popped();
+    while (popped.load(std::memory_order_acquire) < target) {
+        producerWaiting_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const uint64_t seen = popped.load(std::memory_order_acquire);
+        if (seen < target) popped.wait(seen);
+        producerWaiting_.store(false, std::memory_order_relaxed);
+    }
+}
+
+EventPumpStats_t EventPump::stats() const {
+    EventPumpStats_t out = stats_;
+    out.delivered = ring_.poppedCount();
+    return out;
+}
+
+void EventPump::run() {
+    while (true) {
+        if (QueuedEvent_t* event = ring_.front()) {
+            try {
+                std::lock_guard<std::mutex> lock(callbacks_);
+                deliver_(*event);
+            } catch (const std::exception& e) {
+                std::cerr << "[-] Event callback failed: " << e.what() << "\n";
+            }
+            ring_.pop();
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (producerWaiting_.load(std::memory_order_relaxed)) ring_.popped().notify_one();
+            continue;
+        }
+        if (stop_.load()) return;
+
+        const uint32_t seen = wakeups_.load();
+        consumerSleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ring_.empty() && !stop_.load()) wakeups_.wait(seen);
+        consumerSleeping_.store(false, std::memory_order_relaxed);
+    }
+}
+
+} // namespace RoboDBG
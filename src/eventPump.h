@@ -0,0 +1,194 @@
+/**
+ * @file eventPump.h
+ * @brief Asynchronous delivery of debug events that do not need the target stopped
+ * @author Milkshake
+ */
+
+#ifndef EVENTPUMP_H
+#define EVENTPUMP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "platform.h"
+#include "eventInfo.h"
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    /**
+     * @class SpscRing
+     * @brief Bounded lock-free queue for one producer and one consumer thread.
+     *
+     * Capacity is rounded up to a power of two. The consumer reads the front element in place and releases
+     * its slot with pop(), so an element may be used until it is popped without copying it out.
+     */
+    template<typename T>
+    class SpscRing {
+    public:
+        explicit SpscRing(size_t capacity) {
+            size_t slots = 2;
+            while (slots < capacity) slots <<= 1;
+            slots_ = std::make_unique<T[]>(slots);
+            mask_ = slots - 1;
+        }
+
+        inline size_t capacity() const { return mask_ + 1; }
+        inline size_t size() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+        inline bool empty() const { return size() == 0; }
+
+        /**
+         * @brief Appends an element (producer).
+         * @return false if the ring is full; value is left untouched.
+         */
+        bool push(T&& value) {
+            const uint64_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_.load(std::memory_order_acquire) > mask_) return false;
+            slots_[tail & mask_] = std::move(value);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Returns the oldest element, or nullptr if the ring is empty (consumer).
+         */
+        T* front() {
+            const uint64_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) return nullptr;
+            return &slots_[head & mask_];
+        }
+
+        /**
+         * @brief Releases the element returned by front() (consumer).
+         */
+        void pop() {
+            head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /// Number of elements popped so far; waited on by a producer that needs room.
+        inline std::atomic<uint64_t>& popped() { return head_; }
+        inline uint64_t poppedCount() const { return head_.load(std::memory_order_acquire); }
+
+    private:
+        std::unique_ptr<T[]> slots_;
+        size_t mask_ = 0;
+        alignas(64) std::atomic<uint64_t> head_{ 0 }; ///< Next element to pop; written by the consumer only.
+        alignas(64) std::atomic<uint64_t> tail_{ 0 }; ///< Next slot to fill; written by the producer only.
+    };
+
+    /**
+     * @enum OverflowPolicy
+     * @brief What the pump does with an event when the queue is full.
+     */
+    enum class OverflowPolicy : uint8_t {
+        BLOCK, ///< Keep the target stopped until the consumer made room.
+        DROP   ///< Continue the target and count the event as dropped.
+    };
+
+    /**
+     * @struct EventPumpOptions_t
+     * @brief Back-pressure settings of asynchronous event delivery.
+     */
+    struct EventPumpOptions_t {
+        size_t capacity = 1024;                        ///< Queued events before the overflow policy applies.
+        OverflowPolicy overflow = OverflowPolicy::BLOCK;
+    };
+
+    /**
+     * @struct EventPumpStats_t
+     * @brief Counters of an EventPump.
+     */
+    struct EventPumpStats_t {
+        uint64_t queued = 0;    ///< Events handed to the consumer.
+        uint64_t delivered = 0; ///< Events whose callback has returned.
+        uint64_t dropped = 0;   ///< Events lost to OverflowPolicy::DROP.
+        uint64_t blocked = 0;   ///< Pushes that waited for room (OverflowPolicy::BLOCK).
+        uint64_t maxDepth = 0;  ///< Most events queued at once.
+    };
+
+    /**
+     * @struct QueuedEvent_t
+     * @brief An event copied out of the debug loop with everything its callback takes.
+     */
+    struct QueuedEvent_t {
+        DebugEvent_t raw;
+        EventPayload_t payload; ///< Read before the event was continued (see EventInfo::snapshot()).
+        HANDLE hThread = nullptr; ///< Thread handle of CREATE_THREAD; the Debugger keeps it open until the event is delivered.
+    };
+
+    /**
+     * @class EventPump
+     * @brief Hands events from the debug loop to a consumer thread that runs their callbacks.
+     *
+     * The debug loop stays the producer: Win32 and ptrace only take continue requests from the thread that
+     * attached. It copies an informational event into the ring and continues the target right away; the
+     * consumer thread calls the callback while the target runs. Callbacks never overlap: the consumer holds
+     * callbackMutex() while delivering and the loop takes it for the callbacks it runs itself.
+     */
+    class EventPump {
+    public:
+        using Deliver = std::function<void(QueuedEvent_t&)>;
+
+        /**
+         * @brief Starts the consumer thread.
+         * @param options Queue size and overflow policy; capacity is at least 2.
+         * @param deliver Runs the callback of one event, on the consumer thread.
+         */
+        EventPump(EventPumpOptions_t options, Deliver deliver);
+
+        /**
+         * @brief Stops the consumer thread once it has delivered every event still queued; blocks until those
+         * callbacks have returned.
+         */
+        ~EventPump();
+
+        EventPump(const EventPump&) = delete;
+        EventPump& operator=(const EventPump&) = delete;
+
+        /**
+         * @brief Queues an event (producer thread only).
+         * @return false if the event was dropped.
+         */
+        bool push(QueuedEvent_t&& event);
+
+        /**
+         * @brief Waits until every queued event has been delivered (producer thread only).
+         */
+        void drain();
+
+        /**
+         * @brief Held by the consumer while a callback runs; lock it to run a callback on another thread.
+         */
+        inline std::mutex& callbackMutex() { return callbacks_; }
+
+        inline const EventPumpOptions_t& options() const { return options_; }
+
+        /**
+         * @brief Returns the counters; delivered is read from the consumer and may lag behind.
+         */
+        EventPumpStats_t stats() const;
+
+    private:
+        void run();
+        void waitForPops(uint64_t target);
+
+        EventPumpOptions_t options_;
+        Deliver deliver_;
+        SpscRing<QueuedEvent_t> ring_;
+        std::mutex callbacks_;
+        EventPumpStats_t stats_;                    ///< Producer side counters.
+        std::atomic<uint32_t> wakeups_{ 0 };        ///< Bumped to wake a sleeping consumer.
+        std::atomic<bool> consumerSleeping_{ false };
+        std::atomic<bool> producerWaiting_{ false };
+        std::atomic<bool> stop_{ false };
+        std::thread consumer_;
+    };
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,390 @@
+#include "instructionDecoder.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace RoboDBG {
+
+namespace {
+    bool isLegacyPrefix(BYTE b) {
+        switch (b) {
+            case 0xF0: case 0xF2: case 0xF3:                       // lock / repne / rep
+            case 0x2E: case 0x36: case 0x3E: case 0x26:            // segment overrides / branch hints
+            case 0x64: case 0x65:
+            case 0x66: case 0x67:                                  // operand / address size
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Opcodes that do not exist in 64-bit mode (their bytes are REX / VEX / EVEX there or #UD)
+    bool isInvalidIn64(BYTE op) {
+        switch (op) {
+            case 0x06: case 0x07: case 0x0E: case 0x16: case 0x17: case 0x1E: case 0x1F:
+            case 0x27: case 0x2F: case 0x37: case 0x3F: case 0x60: case 0x61: case 0x82:
+            case 0x9A: case 0xCE: case 0xD4: case 0xD5: case 0xD6: case 0xEA:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool oneByteHasModrm(BYTE op) {
+        if (op < 0x40) return (op & 0x07) < 4; // ALU r/m forms
+        switch (op) {
+            case 0x62: case 0x63: case 0x69: case 0x6B:
+            case 0xC0: case 0xC1: case 0xC4: case 0xC5: case 0xC6: case 0xC7:
+            case 0xD0: case 0xD1: case 0xD2: case 0xD3:
+            case 0xF6: case 0xF7: case 0xFE: case 0xFF:
+                return true;
+            default:
+                return (op >= 0x80 && op <= 0x8F) || (op >= 0xD8 && op <= 0xDF);
+        }
+    }
+
+    bool twoByteHasModrm(BYTE op) {
+        switch (op) {
+            case 0x05: case 0x06: case 0x07: case 0x08: case 0x09: case 0x0B: case 0x0E: // syscall .. ud2, femms
+            case 0x30: case 0x31: case 0x32: case 0x33: case 0x34: case 0x35: case 0x37: // wrmsr .. getsec
+            case 0x77:                                                                     // emms
+            case 0xA0: case 0xA1: case 0xA2: case 0xA8: case 0xA9: case 0xAA:              // push/pop fs/gs, cpuid, rsm
+                return false;
+            default:
+                return !(op >= 0x80 && op <= 0x8F) && !(op >= 0xC8 && op <= 0xCF);       // jcc, bswap
+        }
+    }
+
+    // 0F map (and VEX / EVEX map 1) opcodes with an imm8
+    bool twoByteHasImm8(BYTE op) {
+        switch (op) {
+            case 0x70: case 0x71: case 0x72: case 0x73:
+            case 0xA4: case 0xAC: case 0xBA:
+            case 0xC2: case 0xC4: case 0xC5: case 0xC6:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    int64_t readSigned(const BYTE* p, size_t size) {
+        switch (size) {
+            case 1: return static_cast<int8_t>(p[0]);
+            case 2: { int16_t v; std::memcpy(&v, p, 2); return v; }
+            case 4: { int32_t v; std::memcpy(&v, p, 4); return v; }
+            default: return 0;
+        }
+    }
+
+    bool fitsInt32(int64_t v) {
+        return v >= INT32_MIN && v <= INT32_MAX;
+    }
+
+    uintptr_t wrap(uint64_t address, bool x64) {
+        return static_cast<uintptr_t>(x64 ? address : (address & 0xFFFFFFFFULL));
+    }
+
+    /**
+     * @struct CodeWriter_t
+     * @brief Appends code to a buffer that will run at base.
+     */
+    struct CodeWriter_t {
+        BYTE buf[MAX_RELOCATED_LENGTH + 16] = {};
+        size_t n = 0;
+        uintptr_t base = 0;
+
+        uintptr_t here() const { return base + n; }
+        void put(BYTE b) { if (n < sizeof(buf)) buf[n] = b; ++n; }
+        void put32(uint32_t v) { for (int i = 0; i < 4; ++i) put(static_cast<BYTE>(v >> (8 * i))); }
+        void put64(uint64_t v) { for (int i = 0; i < 8; ++i) put(static_cast<BYTE>(v >> (8 * i))); }
+        void putBytes(const BYTE* p, size_t len) { for (size_t i = 0; i < len; ++i) put(p[i]); }
+    };
+
+    size_t jumpLength(uintptr_t at, uintptr_t target, bool x64) {
+        if (!x64) return 5;
+        return fitsInt32(static_cast<int64_t>(target - (at + 5))) ? 5 : 14;
+    }
+
+    void emitJump(CodeWriter_t& w, uintptr_t target, bool x64) {
+        if (jumpLength(w.here(), target, x64) == 5) {
+            const uint32_t rel = static_cast<uint32_t>(target - (w.here() + 5));
+            w.put(0xE9);
+            w.put32(rel);
+        } else {
+            // jmp [rip+0] followed by the absolute target
+            w.put(0xFF); w.put(0x25);
+            w.put32(0);
+            w.put64(target);
+        }
+    }
+
+    void emitPushReturn(CodeWriter_t& w, uintptr_t ret, bool x64) {
+        w.put(0x68); // push imm32, sign-extended in 64-bit mode
+        w.put32(static_cast<uint32_t>(ret));
+        if (x64 && static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(ret))) != static_cast<uint64_t>(ret)) {
+            w.put(0xC7); w.put(0x44); w.put(0x24); w.put(0x04); // mov dword [rsp+4], high half
+            w.put32(static_cast<uint32_t>(static_cast<uint64_t>(ret) >> 32));
+        }
+    }
+
+    // Copies the instruction to w and moves its RIP-relative displacement so it still hits the same address
+    bool emitCopy(CodeWriter_t& w, const BYTE* code, const DecodedInstruction_t& d, uintptr_t from) {
+        const size_t start = w.n;
+        const uintptr_t at = w.here();
+        w.putBytes(code, d.length);
+        if (!(d.flags & INSN_RIP_RELATIVE)) return true;
+
+        const int64_t disp = readSigned(code + d.dispOffset, 4) + static_cast<int64_t>(from - at);
+        if (!fitsInt32(disp)) return false;
+        const int32_t disp32 = static_cast<int32_t>(disp);
+        std::memcpy(w.buf + start + d.dispOffset, &disp32, 4);
+        return true;
+    }
+
+    // The operand of a call r/m is evaluated after the return address is pushed by the relocated code
+    bool usesStackPointer(const DecodedInstruction_t& d) {
+        const int mod = d.modrm >> 6;
+        const int rm = d.modrm & 0x07;
+        const bool rexB = (d.rex & 0x01) != 0;
+        if (mod == 3) return rm == 4 && !rexB;
+        return rm == 4 && (d.sib & 0x07) == 4 && !rexB;
+    }
+}
+
+bool decodeInstruction(const BYTE* code, size_t size, bool x64, DecodedInstruction_t& insn) {
+    insn = DecodedInstruction_t{};
+    const size_t limit = std::min(size, MAX_INSTRUCTION_LENGTH);
+    size_t p = 0;
+
+    bool opsize = false, addrsize = false;
+    BYTE rep = 0, rex = 0;
+
+    // Legacy prefixes, then REX. A REX byte followed by another prefix is ignored by the CPU.
+    for (;; ++p) {
+        if (p >= limit) return false;
+        const BYTE b = code[p];
+        if (isLegacyPrefix(b)) {
+            if (b == 0x66) opsize = true;
+            if (b == 0x67) addrsize = true;
+            if (b == 0xF2 || b == 0xF3) rep = b;
+            rex = 0;
+            continue;
+        }
+        if (x64 && (b & 0xF0) == 0x40) {
+            rex = b;
+            continue;
+        }
+        break;
+    }
+    insn.prefixLength = static_cast<uint8_t>(p);
+    insn.rex = rex;
+
+    const bool rexW = (rex & 0x08) != 0;
+    const size_t immZ = (opsize && !rexW) ? 2 : 4; // "z" sized immediates follow the operand size
+    const bool addr16 = !x64 && addrsize;
+
+    bool modrm = false;
+    size_t imm = 0;
+    BYTE op = code[p];
+    int map = 0;
+
+    // VEX (C4 / C5), EVEX (62) and XOP (8F) replace the opcode escape. In 32-bit mode the first
+    // three are LES / LDS / BOUND unless the next byte has mod == 11.
+    const BYTE escape = op;
+    const bool vexLike = (op == 0xC4 || op == 0xC5 || op == 0x62);
+    if (vexLike && p + 1 < limit && (x64 || (code[p + 1] & 0xC0) == 0xC0)) {
+        const size_t payload = op == 0xC5 ? 1 : (op == 0xC4 ? 2 : 3);
+        if (p + 1 + payload >= limit) return false;
+        map = op == 0xC5 ? 1 : (op == 0xC4 ? (code[p + 1] & 0x1F) : (code[p + 1] & 0x07));
+        p += 1 + payload;
+        op = code[p];
+        modrm = !(escape != 0x62 && map == 1 && op == 0x77); // vzeroupper / vzeroall
+        if (map == 3 || (map == 1 && twoByteHasImm8(op))) imm = 1;
+    } else if (op == 0x8F && p + 1 < limit && (code[p + 1] & 0x1F) >= 8) {
+        if (p + 3 >= limit) return false;
+        map = code[p + 1] & 0x1F;
+        p += 3;
+        op = code[p];
+        modrm = true;
+        imm = map == 8 ? 1 : (map == 0x0A ? 4 : 0);
+    } else if (op == 0x0F) {
+        if (++p >= limit) return false;
+        op = code[p];
+        map = 1;
+        if (op == 0x38 || op == 0x3A) {
+            map = op == 0x38 ? 2 : 3;
+            if (++p >= limit) return false;
+            op = code[p];
+            modrm = true;
+            imm = map == 3 ? 1 : 0;
+        } else if (op == 0x0F) {
+            modrm = true; // 3DNow!: the opcode is the trailing imm8
+            imm = 1;
+        } else {
+            modrm = twoByteHasModrm(op);
+            if (twoByteHasImm8(op)) imm = 1;
+            if (op == 0x78 && (opsize || rep == 0xF2)) imm = 2; // SSE4a extrq / insertq
+            if (op >= 0x80 && op <= 0x8F) {
+                imm = x64 ? 4 : immZ;
+                insn.flags |= INSN_REL_BRANCH | INSN_CONDITIONAL;
+            }
+        }
+    } else {
+        if (x64 && isInvalidIn64(op)) return false;
+        modrm = oneByteHasModrm(op);
+
+        if (op < 0x40 && (op & 0x07) == 4) imm = 1;
+        else if (op < 0x40 && (op & 0x07) == 5) imm = immZ;
+        else if (op >= 0x70 && op <= 0x7F) { imm = 1; insn.flags |= INSN_REL_BRANCH | INSN_CONDITIONAL; }
+        else if (op >= 0xE0 && op <= 0xE3) { imm = 1; insn.flags |= INSN_REL_BRANCH | INSN_CONDITIONAL; }
+        else if (op >= 0xB0 && op <= 0xB7) imm = 1;
+        else if (op >= 0xB8 && op <= 0xBF) imm = rexW ? 8 : immZ;
+        else if (op >= 0xA0 && op <= 0xA3) imm = x64 ? (addrsize ? 4 : 8) : (addrsize ? 2 : 4); // moffs
+        else {
+            switch (op) {
+                case 0x6A: case 0x6B: case 0x80: case 0x82: case 0x83: case 0xA8:
+                case 0xC0: case 0xC1: case 0xC6: case 0xCD: case 0xD4: case 0xD5:
+                case 0xE4: case 0xE5: case 0xE6: case 0xE7:
+                    imm = 1;
+                    break;
+                case 0x68: case 0x69: case 0x81: case 0xA9: case 0xC7:
+                    imm = immZ;
+                    break;
+                case 0xC2: case 0xCA:
+                    imm = 2;
+                    break;
+                case 0xC8: // enter imm16, imm8
+                    imm = 3;
+                    break;
+                case 0x9A: case 0xEA: // far ptr16:16/32
+                    imm = immZ + 2;
+                    break;
+                case 0xEB:
+                    imm = 1;
+                    insn.flags |= INSN_REL_BRANCH;
+                    break;
+                case 0xE8:
+                case 0xE9:
+                    imm = x64 ? 4 : immZ;
+                    insn.flags |= INSN_REL_BRANCH | (op == 0xE8 ? INSN_CALL : 0);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // Instructions whose effect depends on where they run and cannot be rewritten
+        if (op == 0xCC || op == 0xF1 || op == 0x9A) insn.flags |= INSN_NOT_RELOCATABLE;
+        if (op == 0x9A) insn.flags |= INSN_CALL;
+    }
+
+    insn.map = static_cast<uint8_t>(map);
+    insn.opcode = op;
+    insn.opcodeOffset = static_cast<uint8_t>(p);
+    ++p;
+
+    if (modrm) {
+        if (p >= limit) return false;
+        const BYTE m = code[p++];
+        const int mod = m >> 6;
+        const int reg = (m >> 3) & 0x07;
+        const int rm = m & 0x07;
+        insn.modrm = m;
+        insn.flags |= INSN_MODRM;
+
+        size_t disp = 0;
+        if (mod != 3) {
+            if (addr16) {
+                if (mod == 0 && rm == 6) disp = 2;
+                else if (mod == 1) disp = 1;
+                else if (mod == 2) disp = 2;
+            } else {
+                if (rm == 4) {
+                    if (p >= limit) return false;
+                    insn.sib = code[p++];
+                    if (mod == 0 && (insn.sib & 0x07) == 5) disp = 4;
+                } else if (mod == 0 && rm == 5) {
+                    disp = 4;
+                    if (x64) insn.flags |= INSN_RIP_RELATIVE;
+                }
+                if (mod == 1) disp = 1;
+                else if (mod == 2) disp = 4;
+            }
+        }
+        insn.dispOffset = static_cast<uint8_t>(p);
+        insn.dispSize = static_cast<uint8_t>(disp);
+        p += disp;
+
+        // Group opcodes whose operands depend on ModRM.reg
+        if (map == 0) {
+            if (op == 0xF6 && reg < 2) imm = 1;
+            if (op == 0xF7 && reg < 2) imm = immZ;
+            if (op == 0xFF && (reg == 2 || reg == 3)) insn.flags |= INSN_CALL | INSN_INDIRECT;
+            if (op == 0xFF && (reg == 4 || reg == 5)) insn.flags |= INSN_INDIRECT;
+            if (op == 0xFF && (reg == 3 || reg == 5)) insn.flags |= INSN_NOT_RELOCATABLE; // far call / jmp
+            if (op == 0xC7 && m == 0xF8) insn.flags |= INSN_NOT_RELOCATABLE;              // xbegin rel
+        }
+    }
+
+    insn.immOffset = static_cast<uint8_t>(p);
+    insn.immSize = static_cast<uint8_t>(imm);
+    p += imm;
+    if (p > limit) return false;
+    insn.length = static_cast<uint8_t>(p);
+
+    if (map == 0 && op == 0xCD && code[insn.immOffset] == 0x03) insn.flags |= INSN_NOT_RELOCATABLE; // int 3
+    // 16-bit branches truncate the instruction pointer; EIP-relative operands wrap at 4 GB
+    if (!x64 && opsize && (insn.flags & INSN_REL_BRANCH)) insn.flags |= INSN_NOT_RELOCATABLE;
+    if (x64 && addrsize && (insn.flags & INSN_RIP_RELATIVE)) insn.flags |= INSN_NOT_RELOCATABLE;
+    return true;
+}
+
+size_t relocateInstruction(const BYTE* code, size_t size, uintptr_t from, uintptr_t to, bool x64,
+                           BYTE* out, size_t outSize, DecodedInstruction_t* insn) {
+    DecodedInstruction_t d;
+    if (!decodeInstruction(code, size, x64, d)) return 0;
+    if (insn) *insn = d;
+    if (d.flags & INSN_NOT_RELOCATABLE) return 0;
+
+    CodeWriter_t w;
+    w.base = to;
+    const uintptr_t next = wrap(static_cast<uint64_t>(from) + d.length, x64);
+
+    if (d.flags & INSN_REL_BRANCH) {
+        const uintptr_t target = wrap(static_cast<uint64_t>(next) + readSigned(code + d.immOffset, d.immSize), x64);
+
+        if (d.flags & INSN_CONDITIONAL) {
+            // jcc / loop rel8 over the fall-through jump to a jump to the target
+            if (d.map == 0 && d.opcode >= 0xE0 && d.opcode <= 0xE3 &&
+                std::find(code, code + d.prefixLength, BYTE(0x67)) != code + d.prefixLength) {
+                w.put(0x67); // loop / jecxz count register size
+            }
+            w.put(d.map == 1 ? static_cast<BYTE>(0x70 | (d.opcode & 0x0F)) : d.opcode);
+            const size_t rel8 = w.n;
+            w.put(0);
+            w.buf[rel8] = static_cast<BYTE>(jumpLength(w.here(), next, x64));
+            emitJump(w, next, x64);
+            emitJump(w, target, x64);
+        } else {
+            if (d.flags & INSN_CALL) emitPushReturn(w, next, x64);
+            emitJump(w, target, x64);
+        }
+    } else if ((d.flags & INSN_CALL) && (d.flags & INSN_INDIRECT)) {
+        // call r/m: push the original return address, then jmp r/m with the same operand
+        if (usesStackPointer(d)) return 0;
+        emitPushReturn(w, next, x64);
+        const size_t start = w.n;
+        if (!emitCopy(w, code, d, from)) return 0;
+        w.buf[start + d.opcodeOffset + 1] = static_cast<BYTE>((d.modrm & ~0x38) | (4 << 3));
+    } else {
+        if (!emitCopy(w, code, d, from)) return 0;
+        emitJump(w, next, x64);
+    }
+
+    if (w.n > outSize || w.n > MAX_RELOCATED_LENGTH) return 0;
+    std::memcpy(out, w.buf, w.n);
+    return w.n;
+}
+
+} // namespace RoboDBG
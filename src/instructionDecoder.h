@@ -0,0 +1,91 @@
+/**
+ * @file instructionDecoder.h
+ * @brief x86 / x86-64 instruction length decoder and relocator (displaced stepping)
+ * @author Milkshake
+ */
+
+#ifndef INSTRUCTIONDECODER_H
+#define INSTRUCTIONDECODER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "platform.h"
+
+namespace RoboDBG {
+
+    constexpr size_t MAX_INSTRUCTION_LENGTH = 15; ///< Architectural limit of one x86 instruction.
+    constexpr size_t MAX_RELOCATED_LENGTH   = 48; ///< Upper bound of relocateInstruction() output.
+
+    /**
+     * @enum InstructionFlags
+     * @brief Properties of a decoded instruction that matter when it runs from another address.
+     */
+    enum InstructionFlags : uint16_t {
+        INSN_MODRM          = 1 << 0, ///< Has a ModRM byte.
+        INSN_RIP_RELATIVE   = 1 << 1, ///< Memory operand is addressed relative to the next instruction (x64).
+        INSN_REL_BRANCH     = 1 << 2, ///< jmp / jcc / call / loop with a relative target in the immediate.
+        INSN_CONDITIONAL    = 1 << 3, ///< Relative branch that may fall through (jcc, loop, jecxz).
+        INSN_CALL           = 1 << 4, ///< Pushes the address of the next instruction.
+        INSN_INDIRECT       = 1 << 5, ///< Branch target comes from a register or memory operand.
+        INSN_NOT_RELOCATABLE= 1 << 6  ///< Depends on its own address in a way that cannot be fixed up.
+    };
+
+    /**
+     * @struct DecodedInstruction_t
+     * @brief Layout of one decoded instruction. Offsets are relative to the first byte.
+     */
+    struct DecodedInstruction_t {
+        uint8_t length = 0;       ///< Total length in bytes.
+        uint8_t prefixLength = 0; ///< Legacy prefixes and REX.
+        uint8_t rex = 0;          ///< REX byte, 0 if none.
+        uint8_t map = 0;          ///< Opcode map: 0 one byte, 1 0F, 2 0F38, 3 0F3A (VEX / EVEX / XOP: their map).
+        uint8_t opcode = 0;       ///< Opcode byte within the map.
+        uint8_t opcodeOffset = 0; ///< Offset of the opcode byte.
+        uint8_t modrm = 0;        ///< ModRM byte (valid with INSN_MODRM).
+        uint8_t sib = 0;          ///< SIB byte, 0 if none.
+        uint8_t dispOffset = 0;   ///< Offset of the displacement.
+        uint8_t dispSize = 0;     ///< Displacement size (0, 1, 2 or 4).
+        uint8_t immOffset = 0;    ///< Offset of the immediate / relative branch target.
+        uint8_t immSize = 0;      ///< Immediate size in bytes.
+        uint16_t flags = 0;       ///< InstructionFlags.
+    };
+
+    /**
+     * @brief Decodes the length and operand layout of one instruction.
+     *
+     * Covers the one byte, 0F, 0F38 and 0F3A maps, legacy / REX prefixes, VEX, EVEX, XOP and 3DNow!.
+     * Only the encoding is examined; whether the instruction is valid on a given CPU is not checked.
+     *
+     * @param code Instruction bytes.
+     * @param size Number of bytes available at code.
+     * @param x64 Decode in 64-bit mode; 32-bit mode otherwise.
+     * @param insn Receives the layout.
+     * @return true on success; false if the bytes are truncated or not an instruction.
+     */
+    bool decodeInstruction(const BYTE* code, size_t size, bool x64, DecodedInstruction_t& insn);
+
+    /**
+     * @brief Rewrites one instruction so it can run at another address and then continue behind the original.
+     *
+     * RIP-relative displacements are adjusted, relative branches become jumps to their absolute
+     * targets and calls push the original return address. Everything else is followed by a jump
+     * back to from + length.
+     *
+     * @param code Instruction bytes (original bytes, not the int3).
+     * @param size Number of bytes available at code.
+     * @param from Address the instruction was decoded at.
+     * @param to Address the output will run at.
+     * @param x64 64-bit mode.
+     * @param out Output buffer.
+     * @param outSize Size of out; MAX_RELOCATED_LENGTH is always enough.
+     * @param insn Optional; receives the decoded instruction.
+     * @return Number of bytes written, or 0 if the instruction cannot run at to (undecodable,
+     *         INSN_NOT_RELOCATABLE, or a RIP-relative operand out of reach).
+     */
+    size_t relocateInstruction(const BYTE* code, size_t size, uintptr_t from, uintptr_t to, bool x64,
+                               BYTE* out, size_t outSize, DecodedInstruction_t* insn = nullptr);
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,119 @@
+#include "pageCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace RoboDBG {
+
+PageCache::PageCache(TargetBackend& target, size_t maxPages)
+    : target_(target), maxPages_(std::max<size_t>(maxPages, 1)) {
+}
+
+const BYTE* PageCache::page(uintptr_t base) {
+    if (base == lastBase_) {
+        ++stats_.hits;
+        return data_.data() + lastSlot_ * PAGE_BYTES;
+    }
+
+    auto it = index_.find(base);
+    if (it != index_.end()) {
+        ++stats_.hits;
+        lastBase_ = base;
+        lastSlot_ = it->second;
+        return data_.data() + lastSlot_ * PAGE_BYTES;
+    }
+
+    if (unreadable_.count(base)) {
+        ++stats_.uncached;
+        return nullptr;
+    }
+
+    if (used_ == maxPages_) invalidate();
+    const uint32_t slot = used_;
+    if (data_.size() < (slot + 1) * PAGE_BYTES) data_.resize((slot + 1) * PAGE_BYTES);
+
+    SIZE_T got = 0;
+    if (!target_.readMemory(base, data_.data() + slot * PAGE_BYTES, PAGE_BYTES, &got) || got != PAGE_BYTES) {
+        unreadable_.insert(base);
+        ++stats_.uncached;
+        return nullptr;
+    }
+
+    ++used_;
+    ++stats_.misses;
+    index_.emplace(base, slot);
+    lastBase_ = base;
+    lastSlot_ = slot;
+    return data_.data() + slot * PAGE_BYTES;
+}
+
+bool PageCache::read(uintptr_t address, void* buffer, SIZE_T size, SIZE_T* bytesRead) {
+    BYTE* out = static_cast<BYTE*>(buffer);
+    SIZE_T done = 0;
+
+    while (done < size) {
+        const uintptr_t at = address + done;
+        const uintptr_t base = at & ~(PAGE_BYTES - 1);
+        const SIZE_T offset = at - base;
+        const SIZE_T chunk = std::min<SIZE_T>(size - done, PAGE_BYTES - offset);
+
+        const BYTE* data = page(base);
+        if (!data) {
+            // Partly readable or unmapped: the target decides how far the read gets
+            SIZE_T got = 0;
+            target_.readMemory(at, out + done, size - done, &got);
+            done += got;
+            break;
+        }
+        std::memcpy(out + done, data + offset, chunk);
+        done += chunk;
+    }
+
+    if (bytesRead) *bytesRead = done;
+    return done == size;
+}
+
+bool PageCache::write(uintptr_t address, const void* buffer, SIZE_T size) {
+    ++stats_.writes;
+    if (!target_.writeMemory(address, buffer, size)) {
+        invalidate(address, size);
+        return false;
+    }
+
+    const BYTE* in = static_cast<const BYTE*>(buffer);
+    for (uintptr_t base = address & ~(PAGE_BYTES - 1); base < address + size; base += PAGE_BYTES) {
+        auto it = index_.find(base);
+        if (it == index_.end()) continue;
+        const uintptr_t from = std::max(base, address);
+        const uintptr_t to = std::min(base + PAGE_BYTES, address + size);
+        std::memcpy(data_.data() + it->second * PAGE_BYTES + (from - base), in + (from - address), to - from);
+    }
+    return true;
+}
+
+void PageCache::invalidate() {
+    if (used_ || !unreadable_.empty()) ++stats_.flushes;
+    index_.clear();
+    unreadable_.clear();
+    used_ = 0;
+    lastBase_ = 1;
+}
+
+void PageCache::invalidate(uintptr_t address, SIZE_T size) {
+    if (!size) return;
+    const uintptr_t first = address & ~(PAGE_BYTES - 1), end = address + size;
+    if ((end - first) / PAGE_BYTES > index_.size() + unreadable_.size()) {
+        // Large range (a whole region): cheaper to walk what is cached
+        std::erase_if(index_, [&](const auto& entry) { return entry.first + PAGE_BYTES > address && entry.first < end; });
+        std::erase_if(unreadable_, [&](uintptr_t base) { return base + PAGE_BYTES > address && base < end; });
+        if (lastBase_ + PAGE_BYTES > address && lastBase_ < end) lastBase_ = 1;
+        return;
+    }
+    for (uintptr_t base = first; base < end; base += PAGE_BYTES) {
+        index_.erase(base);
+        unreadable_.erase(base);
+        if (base == lastBase_) lastBase_ = 1;
+    }
+}
+
+} // namespace RoboDBG
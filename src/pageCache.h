@@ -0,0 +1,116 @@
+/**
+ * @file pageCache.h
+ * @brief Page-granular copy of target memory kept while the debuggee is stopped
+ * @author Milkshake
+ */
+
+#ifndef PAGECACHE_H
+#define PAGECACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "platform.h"
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    /**
+     * @struct PageCacheStats_t
+     * @brief What the cache saved. Every page a read touches counts once as a hit, a miss or uncached.
+     */
+    struct PageCacheStats_t {
+        uint64_t hits = 0;     ///< Page touches served from the cache.
+        uint64_t misses = 0;   ///< Pages read whole from the target and kept.
+        uint64_t uncached = 0; ///< Page touches read directly because the page is not fully readable.
+        uint64_t writes = 0;   ///< Writes passed through to the target.
+        uint64_t flushes = 0;  ///< Times the cache was emptied (continue, explicit or full).
+    };
+
+    /**
+     * @class PageCache
+     * @brief Serves many small reads from whole pages read once.
+     *
+     * The first read touching a page reads all PAGE_BYTES of it; later reads of the page are copies.
+     * Pages that cannot be read whole (unmapped, guard, or the end of a mapping) are remembered and read
+     * directly, byte-exact, so results match reading the target. Writes go to the target first and then
+     * patch the cached copies. The cache does not notice the target changing its own memory: empty it
+     * with invalidate() before the target runs again.
+     */
+    class PageCache {
+    public:
+        static constexpr SIZE_T PAGE_BYTES = 0x1000;        ///< Cached unit.
+        static constexpr size_t DEFAULT_MAX_PAGES = 1024;   ///< 4 MB.
+
+        /**
+         * @brief Creates an empty cache.
+         * @param target Memory of the debuggee.
+         * @param maxPages Pages kept before the cache starts over; at least 1.
+         */
+        explicit PageCache(TargetBackend& target, size_t maxPages = DEFAULT_MAX_PAGES);
+
+        /**
+         * @brief Reads target memory, filling the pages touched.
+         * @param address Source address.
+         * @param buffer Destination buffer.
+         * @param size Bytes to read.
+         * @param bytesRead Optional; bytes copied before the first unreadable byte.
+         * @return true if all size bytes were read.
+         */
+        bool read(uintptr_t address, void* buffer, SIZE_T size, SIZE_T* bytesRead = nullptr);
+
+        /**
+         * @brief Writes target memory and updates the cached pages of the range.
+         * @param address Destination address.
+         * @param buffer Source buffer.
+         * @param size Bytes to write.
+         * @return false if the target write failed; the range is dropped from the cache then.
+         */
+        bool write(uintptr_t address, const void* buffer, SIZE_T size);
+
+        /**
+         * @brief Drops every cached page.
+         */
+        void invalidate();
+
+        /**
+         * @brief Drops the cached pages of a range (e.g. after its protection changed).
+         * @param address Start of the range.
+         * @param size Size of the range.
+         */
+        void invalidate(uintptr_t address, SIZE_T size);
+
+        inline const PageCacheStats_t& stats() const { return stats_; }
+        inline void resetStats() { stats_ = {}; }
+
+        /**
+         * @brief Returns the number of pages held.
+         */
+        inline size_t pages() const { return index_.size(); }
+
+        inline size_t maxPages() const { return maxPages_; }
+
+    private:
+        /**
+         * @brief Returns the cached copy of a page, reading it if needed; nullptr if it is not fully readable.
+         * @param base Page base.
+         */
+        const BYTE* page(uintptr_t base);
+
+        TargetBackend& target_;
+        size_t maxPages_;
+        std::unordered_map<uintptr_t, uint32_t> index_; ///< Page base -> slot in data_.
+        std::unordered_set<uintptr_t> unreadable_;      ///< Pages a whole-page read failed on.
+        std::vector<BYTE> data_;                        ///< Slots of PAGE_BYTES; kept across invalidate().
+        uint32_t used_ = 0;                             ///< Slots handed out since the last invalidate().
+        uintptr_t lastBase_ = 1;                        ///< Page of the last hit (1: none).
+        uint32_t lastSlot_ = 0;
+        PageCacheStats_t stats_;
+    };
+
+} // namespace RoboDBG
+
+#endif
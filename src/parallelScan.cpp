@@ -0,0 +1,151 @@
+#include "parallelScan.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace RoboDBG {
+
+namespace {
+    constexpr SIZE_T DEFAULT_CHUNK = 1 << 20;
+    constexpr SIZE_T MIN_STEP = 0x1000;
+
+    struct Item_t {
+        const MemoryRegion_t* region;
+        uintptr_t address;
+        SIZE_T size;
+        SIZE_T overlap;
+    };
+
+    // [front, back) of a worker's items in one word, so the owner and thieves agree with a single CAS.
+    // Item indices fit in 32 bits: even 4 KB items would need 16 TB of committed memory to overflow.
+    struct alignas(64) Block_t {
+        std::atomic<uint64_t> range{ 0 };
+
+        static uint64_t pack(uint64_t front, uint64_t back) { return (front << 32) | back; }
+
+        void assign(size_t front, size_t back) { range.store(pack(front, back), std::memory_order_relaxed); }
+
+        bool popFront(size_t& item) {
+            uint64_t r = range.load(std::memory_order_relaxed);
+            for (;;) {
+                const uint64_t front = r >> 32, back = r & 0xFFFFFFFF;
+                if (front >= back) return false;
+                if (range.compare_exchange_weak(r, pack(front + 1, back), std::memory_order_relaxed)) {
+                    item = static_cast<size_t>(front);
+                    return true;
+                }
+            }
+        }
+
+        bool popBack(size_t& item) {
+            uint64_t r = range.load(std::memory_order_relaxed);
+            for (;;) {
+                const uint64_t front = r >> 32, back = r & 0xFFFFFFFF;
+                if (front >= back) return false;
+                if (range.compare_exchange_weak(r, pack(front, back - 1), std::memory_order_relaxed)) {
+                    item = static_cast<size_t>(back - 1);
+                    return true;
+                }
+            }
+        }
+    };
+}
+
+ParallelScan::ParallelScan(TargetBackend& target, ScanOptions_t options)
+    : target_(target), options_(options) {
+}
+
+unsigned ParallelScan::threads(size_t items) const {
+    unsigned n = options_.threads ? options_.threads : std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(n, items)));
+}
+
+SIZE_T ParallelScan::chunkSize(SIZE_T overlap) const {
+    const SIZE_T chunk = options_.chunkSize ? options_.chunkSize : DEFAULT_CHUNK;
+    return std::max(chunk, overlap + MIN_STEP);
+}
+
+size_t ParallelScan::run(std::span<const MemoryRegion_t> regions, SIZE_T overlap,
+                         const std::function<void(size_t)>& prepare,
+                         const std::function<size_t(const MemoryChunk_t&, size_t)>& scan) {
+    const SIZE_T chunk = chunkSize(overlap);
+
+    // Same cut as RegionReader: each item after the first of a region repeats `overlap` bytes
+    std::vector<Item_t> items;
+    SIZE_T largest = 0;
+    for (const MemoryRegion_t& r : regions) {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(r.BaseAddress);
+        const uintptr_t end = base + r.RegionSize;
+        largest = std::max(largest, r.RegionSize);
+        for (uintptr_t position = base; position < end; ) {
+            const SIZE_T back = position == base ? 0 : overlap;
+            const uintptr_t address = position - back;
+            const SIZE_T size = std::min<SIZE_T>(chunk, end - address);
+            items.push_back(Item_t{ &r, address, size, back });
+            position = address + size;
+        }
+    }
+
+    prepare(items.size());
+    if (items.empty()) return 0;
+
+    const unsigned workers = threads(items.size());
+    std::unique_ptr<Block_t[]> blocks(new Block_t[workers]);
+    for (unsigned w = 0; w < workers; ++w) {
+        blocks[w].assign(items.size() * w / workers, items.size() * (w + 1) / workers);
+    }
+
+    // Lowest item known to complete the first maxHits results; later items are skipped
+    std::atomic<size_t> cutoff{ SIZE_MAX };
+    std::mutex hitsMutex;
+    std::map<size_t, size_t> hitsPerItem;
+    auto record = [&](size_t item, size_t hits) {
+        std::lock_guard<std::mutex> lock(hitsMutex);
+        hitsPerItem[item] = hits;
+        size_t total = 0;
+        for (const auto& [i, n] : hitsPerItem) {
+            if (i > cutoff.load(std::memory_order_relaxed)) break;
+            total += n;
+            if (total >= options_.maxHits) {
+                cutoff.store(i, std::memory_order_relaxed);
+                break;
+            }
+        }
+    };
+
+    const SIZE_T bufferSize = std::min(chunk, largest);
+    auto work = [&](unsigned self) {
+        std::vector<BYTE> buffer(bufferSize);
+        size_t index = 0;
+        for (;;) {
+            if (!blocks[self].popFront(index)) {
+                bool stolen = false;
+                for (unsigned k = 1; k < workers && !stolen; ++k) stolen = blocks[(self + k) % workers].popBack(index);
+                if (!stolen) return; // no item is ever added, so every block is drained
+            }
+            if (index > cutoff.load(std::memory_order_relaxed)) continue;
+
+            const Item_t& item = items[index];
+            SIZE_T got = 0;
+            if (!target_.readMemory(item.address, buffer.data(), item.size, &got)) got = std::min(got, item.size);
+            if (got == 0) continue; // unreadable, e.g. decommitted since the region list was taken
+
+            const size_t hits = scan(MemoryChunk_t{ item.region, item.address, buffer.data(), got, item.size, item.overlap }, index);
+            if (options_.maxHits && hits) record(index, hits);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (unsigned w = 1; w < workers; ++w) pool.emplace_back(work, w);
+    work(0);
+    for (std::thread& t : pool) t.join();
+
+    return std::min(cutoff.load(), items.size() - 1);
+}
+
+} // namespace RoboDBG
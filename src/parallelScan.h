@@ -0,0 +1,117 @@
+/**
+ * @file parallelScan.h
+ * @brief Multi-threaded passes over target memory regions
+ * @author Milkshake
+ */
+
+#ifndef PARALLELSCAN_H
+#define PARALLELSCAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "platform.h"
+#include "regionReader.h"
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    /**
+     * @struct ScanOptions_t
+     * @brief How a whole-address-space scan is split across threads.
+     */
+    struct ScanOptions_t {
+        unsigned threads = 1; ///< Worker threads; 0 = one per core. 1 scans on the calling thread.
+        SIZE_T chunkSize = 0; ///< Bytes per work item; 0 = the chunk size of the reader options.
+        size_t maxHits   = 0; ///< Stop once the first maxHits results (lowest addresses) are known; 0 = all.
+    };
+
+    /**
+     * @class ParallelScan
+     * @brief Runs a chunk scanner over memory regions on a work-stealing thread pool.
+     *
+     * Regions are cut into work items of chunkSize bytes that overlap like RegionReader chunks, and numbered
+     * in address order. Each worker starts on its own contiguous block of items and takes from the front of it;
+     * a worker whose block is empty steals from the back of another block. Every worker reads into its own
+     * buffer, so at most threads * chunkSize bytes are held at once. The backend's readMemory() must be
+     * callable from several threads at the same time (Win32, ptrace and the simulated backend are).
+     *
+     * With maxHits, a result limit is reached as soon as the completed items up to some item k hold maxHits
+     * results: the first maxHits results overall lie at or before k, so items after k are not scanned.
+     */
+    class ParallelScan {
+    public:
+        /**
+         * @brief Creates a scan.
+         * @param target Memory of the debuggee.
+         * @param options Thread count, item size and result limit; chunkSize 0 is taken as 1 MB.
+         */
+        ParallelScan(TargetBackend& target, ScanOptions_t options);
+
+        /**
+         * @brief Scans regions and returns the results of all items in address order.
+         * @tparam Hit Result type; results of one item must be appended in address order.
+         * @param regions Regions to scan (see RegionReader::readable()).
+         * @param overlap Bytes each item repeats from the previous item of the same region.
+         * @param scan Called for every item with at least one byte read, on any worker thread.
+         * @return Results, truncated to maxHits.
+         */
+        template<typename Hit>
+        std::vector<Hit> collect(std::span<const MemoryRegion_t> regions, SIZE_T overlap,
+                                 const std::function<void(const MemoryChunk_t&, std::vector<Hit>&)>& scan) {
+            std::vector<std::vector<Hit>> perItem;
+            const size_t last = run(regions, overlap,
+                [&](size_t items) { perItem.resize(items); },
+                [&](const MemoryChunk_t& chunk, size_t item) {
+                    std::vector<Hit>& hits = perItem[item];
+                    scan(chunk, hits);
+                    if (options_.maxHits && hits.size() > options_.maxHits) hits.resize(options_.maxHits);
+                    return hits.size();
+                });
+
+            std::vector<Hit> out;
+            for (size_t i = 0; i < perItem.size() && i <= last; ++i) {
+                out.insert(out.end(), perItem[i].begin(), perItem[i].end());
+                if (options_.maxHits && out.size() >= options_.maxHits) {
+                    out.resize(options_.maxHits);
+                    break;
+                }
+            }
+            return out;
+        }
+
+        /**
+         * @brief Scans regions without collecting results; the building block of collect().
+         * @param regions Regions to scan.
+         * @param overlap Bytes each item repeats from the previous item of the same region.
+         * @param prepare Called once with the number of items before any worker starts.
+         * @param scan Called for every item with at least one byte read; returns the results it found.
+         * @return Index of the last item whose results count (items - 1 without a limit).
+         */
+        size_t run(std::span<const MemoryRegion_t> regions, SIZE_T overlap,
+                   const std::function<void(size_t)>& prepare,
+                   const std::function<size_t(const MemoryChunk_t&, size_t)>& scan);
+
+        /**
+         * @brief Returns the number of workers used for a number of items.
+         * @param items Work items; no more workers than items are started.
+         */
+        unsigned threads(size_t items = SIZE_MAX) const;
+
+        /**
+         * @brief Returns the item size used with an overlap.
+         * @param overlap Overlap that will be passed to run().
+         */
+        SIZE_T chunkSize(SIZE_T overlap = 0) const;
+
+    private:
+        TargetBackend& target_;
+        ScanOptions_t options_;
+    };
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,323 @@
+#include "patternScanner.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define PATTERN_SCANNER_X86 1
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+#endif
+
+// GCC / Clang compile the SIMD paths for their instruction set only; MSVC accepts the intrinsics anywhere
+#if defined(PATTERN_SCANNER_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define TARGET_SSE2 __attribute__((target("sse2")))
+    #define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define TARGET_SSE2
+    #define TARGET_AVX2
+#endif
+
+namespace RoboDBG {
+
+namespace {
+    constexpr size_t HORSPOOL_MIN_LENGTH = 16; // below this memchr on the anchor wins
+    constexpr size_t HORSPOOL_MIN_SHIFT  = 8;  // wildcards near the end make shifts useless
+    constexpr int HORSPOOL_MIN_FREQUENCY = 100; // see byteFrequency()
+
+    int hexDigit(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+}
+
+int byteFrequency(BYTE b) {
+    switch (b) {
+    case 0x00: return 255;
+    case 0xFF: return 200;
+    case 0xCC: case 0x48: case 0x8B: return 180;
+    case 0x89: case 0x24: case 0x44: case 0x4C: case 0x0F: case 0xE8: return 150;
+    case 0x83: case 0x85: case 0x01: case 0x45: case 0x08: case 0x10: case 0x20: case 0x90: return 120;
+    case 0xC3: case 0x74: case 0x75: case 0x8D: case 0x4D: case 0x40: case 0x41: case 0x49: case 0x04: case 0xC0: return 100;
+    default: break;
+    }
+    if (b < 0x20) return 60;           // small immediates / displacements
+    if (b < 0x7F) return 40;           // ASCII text
+    return 20;
+}
+
+// ===========================
+// PATTERN
+// ===========================
+
+BytePattern_t BytePattern_t::exact(std::span<const BYTE> bytes) {
+    BytePattern_t p;
+    p.value.assign(bytes.begin(), bytes.end());
+    p.mask.assign(bytes.size(), 0xFF);
+    return p;
+}
+
+bool BytePattern_t::parse(std::string_view signature, BytePattern_t& out) {
+    BytePattern_t p;
+    size_t i = 0;
+    while (i < signature.size()) {
+        if (signature[i] == ' ' || signature[i] == '\t' || signature[i] == '\n' || signature[i] == '\r') {
+            ++i;
+            continue;
+        }
+        size_t end = i;
+        while (end < signature.size() && signature[end] != ' ' && signature[end] != '\t'
+               && signature[end] != '\n' && signature[end] != '\r') ++end;
+        const std::string_view token = signature.substr(i, end - i);
+        i = end;
+
+        if (token == "?" || token == "??") {
+            p.value.push_back(0);
+            p.mask.push_back(0);
+            continue;
+        }
+        if (token.size() != 2) return false;
+
+        BYTE value = 0, mask = 0;
+        for (int n = 0; n < 2; ++n) {
+            const int shift = n == 0 ? 4 : 0;
+            if (token[n] == '?') continue;
+            const int d = hexDigit(token[n]);
+            if (d < 0) return false;
+            value |= static_cast<BYTE>(d << shift);
+            mask |= static_cast<BYTE>(0xF << shift);
+        }
+        p.value.push_back(value);
+        p.mask.push_back(mask);
+    }
+
+    // A pattern that matches everywhere is a typo, not a search
+    if (std::none_of(p.mask.begin(), p.mask.end(), [](BYTE m) { return m != 0; })) return false;
+
+    out = std::move(p);
+    return true;
+}
+
+// ===========================
+// SCANNER
+// ===========================
+
+PatternScanner::PatternScanner(BytePattern_t pattern, ScanImpl impl)
+    : pattern_(std::move(pattern)),
+      impl_(std::min(impl == ScanImpl::AUTO ? bestImplementation() : impl, bestImplementation())) {
+    const size_t len = pattern_.size();
+    for (size_t i = 0; i < len; ++i) pattern_.value[i] &= pattern_.mask[i];
+    exact_ = std::all_of(pattern_.mask.begin(), pattern_.mask.end(), [](BYTE m) { return m == 0xFF; });
+
+    // Anchors are compared as whole bytes, so only fixed bytes qualify
+    int best = -1, second = -1;
+    for (size_t i = 0; i < len; ++i) {
+        if (pattern_.mask[i] != 0xFF) continue;
+        const int f = byteFrequency(pattern_.value[i]);
+        if (best < 0 || f < byteFrequency(pattern_.value[best])) {
+            second = best;
+            best = static_cast<int>(i);
+        } else if (second < 0 || f < byteFrequency(pattern_.value[second])
+                   || (f == byteFrequency(pattern_.value[second]) && i > static_cast<size_t>(second))) {
+            second = static_cast<int>(i); // on a tie the farther byte correlates less with the first
+        }
+    }
+    anchored_ = best >= 0;
+    anchor1_ = anchored_ ? static_cast<size_t>(best) : 0;
+    anchor2_ = second >= 0 ? static_cast<size_t>(second) : anchor1_;
+    if (impl_ != ScanImpl::SCALAR && !anchored_) impl_ = ScanImpl::SCALAR;
+
+    // Horspool: shift by the distance from the last position the tail byte could match to the end
+    size_t lastLoose = 0; // 1 + last position before the tail that matches more than one byte value
+    for (size_t j = 0; j + 1 < len; ++j) {
+        if (pattern_.mask[j] != 0xFF) lastLoose = j + 1;
+    }
+    // memchr on a rare anchor is faster; Horspool pays off when every fixed byte is common
+    horspool_ = anchored_ && len >= HORSPOOL_MIN_LENGTH && len - lastLoose >= HORSPOOL_MIN_SHIFT
+             && byteFrequency(pattern_.value[anchor1_]) >= HORSPOOL_MIN_FREQUENCY;
+    if (horspool_) {
+        for (size_t c = 0; c < 256; ++c) shift_[c] = len;
+        for (size_t j = 0; j + 1 < len; ++j) {
+            for (size_t c = 0; c < 256; ++c) {
+                if ((c & pattern_.mask[j]) == pattern_.value[j]) shift_[c] = len - 1 - j;
+            }
+        }
+    }
+}
+
+ScanImpl PatternScanner::bestImplementation() {
+#ifdef PATTERN_SCANNER_X86
+    static const ScanImpl best = [] {
+    #ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+        __cpuid(info, 1);
+        const bool sse2 = (info[3] >> 26) & 1;
+        const bool ymmEnabled = ((info[2] >> 27) & 1) && ((info[2] >> 28) & 1) && (_xgetbv(0) & 6) == 6;
+        bool avx2 = false;
+        if (maxLeaf >= 7 && ymmEnabled) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] >> 5) & 1;
+        }
+    #else
+        __builtin_cpu_init();
+        const bool sse2 = __builtin_cpu_supports("sse2");
+        const bool avx2 = __builtin_cpu_supports("avx2");
+    #endif
+        return avx2 ? ScanImpl::AVX2 : sse2 ? ScanImpl::SSE2 : ScanImpl::SCALAR;
+    }();
+    return best;
+#else
+    return ScanImpl::SCALAR;
+#endif
+}
+
+bool PatternScanner::matchesAt(const BYTE* p) const {
+    const size_t len = pattern_.size();
+    if (exact_) return std::memcmp(p, pattern_.value.data(), len) == 0;
+    for (size_t i = 0; i < len; ++i) {
+        if ((p[i] & pattern_.mask[i]) != pattern_.value[i]) return false;
+    }
+    return true;
+}
+
+size_t PatternScanner::scan(const BYTE* data, size_t size, uintptr_t base, std::vector<uintptr_t>& matches) const {
+    if (pattern_.empty() || size < pattern_.size()) return 0;
+    switch (impl_) {
+    case ScanImpl::AVX2: return scanAvx2(data, size, base, matches);
+    case ScanImpl::SSE2: return scanSse2(data, size, base, matches);
+    default:             return scanScalar(data, size, 0, base, matches);
+    }
+}
+
+size_t PatternScanner::scanScalar(const BYTE* data, size_t size, size_t from, uintptr_t base, std::vector<uintptr_t>& matches) const {
+    const size_t len = pattern_.size();
+    if (size < len) return 0;
+    const size_t last = size - len; // last valid start offset
+    size_t found = 0;
+
+    if (!anchored_) {
+        for (size_t i = from; i <= last; ++i) {
+            if (matchesAt(data + i)) {
+                matches.push_back(base + i);
+                ++found;
+            }
+        }
+    } else if (horspool_) {
+        for (size_t i = from; i <= last; i += shift_[data[i + len - 1]]) {
+            if (matchesAt(data + i)) {
+                matches.push_back(base + i);
+                ++found;
+            }
+        }
+    } else {
+        const BYTE c = pattern_.value[anchor1_];
+        const BYTE* p = data + from + anchor1_;
+        const BYTE* end = data + last + anchor1_ + 1;
+        while (p < end) {
+            p = static_cast<const BYTE*>(std::memchr(p, c, static_cast<size_t>(end - p)));
+            if (!p) break;
+            const size_t i = static_cast<size_t>(p - data) - anchor1_;
+            if (matchesAt(data + i)) {
+                matches.push_back(base + i);
+                ++found;
+            }
+            ++p;
+        }
+    }
+    return found;
+}
+
+#ifdef PATTERN_SCANNER_X86
+
+// Each step tests 64 start offsets. The rarest anchor byte is checked first, so a step without it
+// costs one compare per vector; otherwise the second anchor narrows the candidates before the full
+// pattern is compared. Offsets left over at the end go to the scalar path.
+
+TARGET_SSE2 size_t PatternScanner::scanSse2(const BYTE* data, size_t size, uintptr_t base, std::vector<uintptr_t>& matches) const {
+    constexpr size_t WIDTH = 16;
+    constexpr size_t STEP  = 4 * WIDTH;
+    const size_t candidates = size - pattern_.size() + 1;
+    const __m128i v1 = _mm_set1_epi8(static_cast<char>(pattern_.value[anchor1_]));
+    const __m128i v2 = _mm_set1_epi8(static_cast<char>(pattern_.value[anchor2_]));
+    const BYTE* p1 = data + anchor1_;
+    const BYTE* p2 = data + anchor2_;
+
+    size_t found = 0;
+    size_t i = 0;
+    for (; i + STEP <= candidates; i += STEP) {
+        __m128i a[4];
+        for (size_t k = 0; k < 4; ++k)
+            a[k] = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p1 + i + k * WIDTH)), v1);
+        const __m128i any = _mm_or_si128(_mm_or_si128(a[0], a[1]), _mm_or_si128(a[2], a[3]));
+        if (_mm_movemask_epi8(any) == 0) continue;
+
+        uint64_t m = 0;
+        for (size_t k = 0; k < 4; ++k) {
+            const __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p2 + i + k * WIDTH)), v2);
+            m |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(a[k], b)))) << (k * WIDTH);
+        }
+        while (m) {
+            const size_t at = i + static_cast<size_t>(std::countr_zero(m));
+            if (matchesAt(data + at)) {
+                matches.push_back(base + at);
+                ++found;
+            }
+            m &= m - 1;
+        }
+    }
+    return found + scanScalar(data, size, i, base, matches);
+}
+
+TARGET_AVX2 size_t PatternScanner::scanAvx2(const BYTE* data, size_t size, uintptr_t base, std::vector<uintptr_t>& matches) const {
+    constexpr size_t WIDTH = 32;
+    constexpr size_t STEP  = 2 * WIDTH;
+    const size_t candidates = size - pattern_.size() + 1;
+    const __m256i v1 = _mm256_set1_epi8(static_cast<char>(pattern_.value[anchor1_]));
+    const __m256i v2 = _mm256_set1_epi8(static_cast<char>(pattern_.value[anchor2_]));
+    const BYTE* p1 = data + anchor1_;
+    const BYTE* p2 = data + anchor2_;
+
+    size_t found = 0;
+    size_t i = 0;
+    for (; i + STEP <= candidates; i += STEP) {
+        const __m256i a0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p1 + i)), v1);
+        const __m256i a1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p1 + i + WIDTH)), v1);
+        const __m256i any = _mm256_or_si256(a0, a1);
+        if (_mm256_testz_si256(any, any)) continue;
+
+        const __m256i b0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p2 + i)), v2);
+        const __m256i b1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p2 + i + WIDTH)), v2);
+        uint64_t m = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(a0, b0)))
+                   | (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(a1, b1)))) << WIDTH);
+        while (m) {
+            const size_t at = i + static_cast<size_t>(std::countr_zero(m));
+            if (matchesAt(data + at)) {
+                matches.push_back(base + at);
+                ++found;
+            }
+            m &= m - 1;
+        }
+    }
+    return found + scanScalar(data, size, i, base, matches);
+}
+
+#else
+
+size_t PatternScanner::scanSse2(const BYTE* data, size_t size, uintptr_t base, std::vector<uintptr_t>& matches) const {
+    return scanScalar(data, size, 0, base, matches);
+}
+
+size_t PatternScanner::scanAvx2(const BYTE* data, size_t size, uintptr_t base, std::vector<uintptr_t>& matches) const {
+    return scanScalar(data, size, 0, base, matches);
+}
+
+#endif
+
+} // namespace RoboDBG
@@ -0,0 +1,133 @@
+/**
+ * @file patternScanner.h
+ * @brief Byte signature search with wildcards (SIMD with a scalar fallback)
+ * @author Milkshake
+ */
+
+#ifndef PATTERNSCANNER_H
+#define PATTERNSCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "platform.h"
+
+namespace RoboDBG {
+
+    /**
+     * @struct BytePattern_t
+     * @brief Signature in byte + mask form. A byte b matches position i if (b & mask[i]) == value[i].
+     */
+    struct BytePattern_t {
+        std::vector<BYTE> value; ///< Expected bits (already masked).
+        std::vector<BYTE> mask;  ///< 0xFF exact, 0x00 wildcard, 0xF0 / 0x0F nibble wildcard.
+
+        inline size_t size() const { return value.size(); }
+        inline bool empty() const { return value.empty(); }
+
+        /**
+         * @brief Builds a pattern without wildcards.
+         * @param bytes Bytes to match.
+         * @return The pattern.
+         */
+        static BytePattern_t exact(std::span<const BYTE> bytes);
+
+        /**
+         * @brief Parses an IDA-style signature such as "56 57 ?? 8B 54".
+         *
+         * Tokens are separated by whitespace: two hex digits, "?" / "??" for a wildcard byte,
+         * or one hex digit and one "?" for a nibble wildcard ("4?", "?F").
+         *
+         * @param signature Signature text.
+         * @param out Receives the pattern.
+         * @return false if a token is malformed or the pattern has no fixed bits.
+         */
+        static bool parse(std::string_view signature, BytePattern_t& out);
+    };
+
+    /**
+     * @brief Rough frequency of a byte in x86 / x64 images, higher is more common (20..255).
+     * @param b Byte value.
+     */
+    int byteFrequency(BYTE b);
+
+    /**
+     * @enum ScanImpl
+     * @brief Instruction set a PatternScanner uses. Ordered by preference.
+     */
+    enum class ScanImpl : uint8_t {
+        SCALAR, ///< memchr anchor or Horspool, any CPU.
+        SSE2,   ///< 16 candidates per step (x86).
+        AVX2,   ///< 32 candidates per step (x86, checked at runtime).
+        AUTO    ///< Best the CPU supports.
+    };
+
+    /**
+     * @class PatternScanner
+     * @brief Finds every occurrence of one BytePattern_t in plain buffers.
+     *
+     * Candidates are filtered on two anchor bytes, picked as the rarest fixed bytes of the pattern
+     * for typical x86 code, and only the survivors are compared in full. The SIMD paths test a whole
+     * vector of start offsets per step. The scalar path uses memchr on the rarest byte, or Horspool
+     * for long patterns whose tail allows large shifts.
+     */
+    class PatternScanner {
+    public:
+        /**
+         * @brief Compiles a pattern.
+         * @param pattern Pattern; must not be empty.
+         * @param impl Instruction set; clamped to what the CPU supports.
+         */
+        explicit PatternScanner(BytePattern_t pattern, ScanImpl impl = ScanImpl::AUTO);
+
+        /**
+         * @brief Appends base + offset of every match in data to matches, in ascending order.
+         *
+         * Matches overlapping the end of the buffer are not reported; callers scanning in chunks
+         * overlap them by size() - 1 bytes.
+         *
+         * @param data Buffer.
+         * @param size Buffer size.
+         * @param base Address of data[0] in the target.
+         * @param matches Receives the addresses.
+         * @return Number of matches appended.
+         */
+        size_t scan(const BYTE* data, size_t size, uintptr_t base, std::vector<uintptr_t>& matches) const;
+
+        /**
+         * @brief Returns the compiled pattern.
+         */
+        inline const BytePattern_t& pattern() const { return pattern_; }
+
+        /**
+         * @brief Returns the instruction set used by scan().
+         */
+        inline ScanImpl implementation() const { return impl_; }
+
+        /**
+         * @brief Returns the best instruction set of the running CPU.
+         */
+        static ScanImpl bestImplementation();
+
+    private:
+        bool matchesAt(const BYTE* p) const;
+        size_t scanScalar(const BYTE* data, size_t size, size_t from, uintptr_t base, std::vector<uintptr_t>& matches) const;
+        size_t scanSse2(const BYTE* data, size_t size, uintptr_t base, std::vector<uintptr_t>& matches) const;
+        size_t scanAvx2(const BYTE* data, size_t size, uintptr_t base, std::vector<uintptr_t>& matches) const;
+
+        BytePattern_t pattern_;
+        ScanImpl impl_;
+        bool exact_ = true;         ///< No wildcards: verify with memcmp.
+        bool anchored_ = false;     ///< Has at least one fixed byte to filter on.
+        size_t anchor1_ = 0;        ///< Rarest fixed byte.
+        size_t anchor2_ = 0;        ///< Second rarest fixed byte (== anchor1_ if there is only one).
+        bool horspool_ = false;     ///< Scalar path uses Horspool.
+        size_t shift_[256] = {};    ///< Horspool shift by the byte under the last pattern position.
+    };
+
+} // namespace RoboDBG
+
+#endif
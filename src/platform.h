@@ -0,0 +1,98 @@
+/**
+ * @file platform.h
+ * @brief Platform layer. Pulls in the Win32 headers on Windows and provides the
+ *        subset of Win32 types and constants the debugger core uses everywhere else.
+ * @author Milkshake
+ */
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_WIN64) || defined(__x86_64__)
+    #define ROBODBG_X64 1 ///< Set when the debugger (and therefore the debuggee) is 64-bit.
+#endif
+
+#ifdef _WIN32
+
+#ifdef _MSC_VER
+    #pragma comment(lib, "Advapi32.lib")
+    #pragma comment(lib, "ntdll.lib")
+#endif
+
+#include <windows.h>
+#include <tlhelp32.h>
+#include <tchar.h>
+#include <psapi.h>
+#include <winternl.h>
+#include <intrin.h>
+
+#else
+
+// Win32 compatible type names so that the public API stays the same on every platform.
+typedef uint8_t   BYTE;
+typedef uint16_t  WORD;
+typedef uint32_t  DWORD;
+typedef uint64_t  DWORD64;
+typedef int       BOOL;
+typedef long      LONG;
+typedef uintptr_t ULONG_PTR;
+typedef uintptr_t DWORD_PTR;
+typedef size_t    SIZE_T;
+typedef void*     HANDLE;
+typedef void*     LPVOID;
+typedef const void* LPCVOID;
+typedef BYTE*     LPBYTE;
+
+#ifndef TRUE
+    #define TRUE  1
+#endif
+#ifndef FALSE
+    #define FALSE 0
+#endif
+
+#define MAX_PATH 260
+#define INFINITE 0xFFFFFFFF
+
+// Memory states / types (VirtualQueryEx)
+#define MEM_COMMIT  0x00001000
+#define MEM_RESERVE 0x00002000
+#define MEM_FREE    0x00010000
+#define MEM_PRIVATE 0x00020000
+#define MEM_MAPPED  0x00040000
+#define MEM_IMAGE   0x01000000
+
+// Memory protection constants
+#define PAGE_NOACCESS          0x01
+#define PAGE_READONLY          0x02
+#define PAGE_READWRITE         0x04
+#define PAGE_WRITECOPY         0x08
+#define PAGE_EXECUTE           0x10
+#define PAGE_EXECUTE_READ      0x20
+#define PAGE_EXECUTE_READWRITE 0x40
+#define PAGE_EXECUTE_WRITECOPY 0x80
+#define PAGE_GUARD             0x100
+
+// Exception codes reported through EXCEPTION events
+#define EXCEPTION_ACCESS_VIOLATION      0xC0000005
+#define EXCEPTION_IN_PAGE_ERROR         0xC0000006
+#define EXCEPTION_ILLEGAL_INSTRUCTION   0xC000001D
+#define EXCEPTION_INT_DIVIDE_BY_ZERO    0xC0000094
+#define EXCEPTION_PRIV_INSTRUCTION      0xC0000096
+#define EXCEPTION_BREAKPOINT            0x80000003
+#define EXCEPTION_SINGLE_STEP           0x80000004
+
+/**
+ * @struct RIP_INFO
+ * @brief Mirror of the Win32 RIP_INFO structure.
+ */
+typedef struct _RIP_INFO {
+    DWORD dwError; ///< Error code.
+    DWORD dwType;  ///< Error type.
+} RIP_INFO;
+
+#endif
+
+#endif
@@ -1,3 +1,4 @@
+#ifdef _WIN32
 // Freezer.cpp
 #include "Freezer.h"
 #include <windows.h>
@@ -132,6 +133,11 @@ std::vector<DWORD> Freezer::enumerateThreadIds() const {
     std::vector<DWORD> tids;
     if (!process_) return tids;
 
+    if (threadSource_) {
+        tids = threadSource_();
+        if (!tids.empty()) return tids;
+    }
+
     Handle snap(CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0));
     if (!snap) return tids;
 
@@ -204,3 +210,5 @@ bool Freezer::restore(const std::vector<ThreadState>& states) const {
     }
     return ok;
 }
+
+#endif
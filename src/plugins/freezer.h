@@ -9,6 +9,7 @@
 #include <windows.h>
 #include <tlhelp32.h>
 #include <vector>
+#include <functional>
 #include <optional>
 #include <cstdio>
 #include <iostream>
@@ -79,6 +80,12 @@ public:
      */
     bool isValid() const { return (bool)process_; }
 
+    /**
+     * @brief Takes thread IDs from source (e.g. the debugger's thread registry) instead of a Toolhelp snapshot
+     * @param source returns the thread IDs of the process; an empty result falls back to the snapshot
+     */
+    void setThreadSource(std::function<std::vector<DWORD>()> source) { threadSource_ = std::move(source); }
+
     //CSV functions
 
 
@@ -88,5 +95,6 @@ private:
 
     Handle process_{};
     DWORD pid_{ 0 };
+    std::function<std::vector<DWORD>()> threadSource_{};
 };
 #endif
@@ -1,5 +1,7 @@
+#ifdef _WIN32
 // imports.cpp
 #include "imports.h"
+#include "stringScanner.h"
 
 #include <psapi.h>
 
@@ -148,23 +150,8 @@ Imports::findImportsByName(std::string_view func) const
 
 std::string Imports::readCString(uintptr_t addr, SIZE_T maxLen)
 {
-    std::string s;
-    s.reserve(64);
-    BYTE chunk[256];
-    SIZE_T off = 0;
-    while (off < maxLen) {
-        const SIZE_T toRead = std::min<SIZE_T>(sizeof(chunk), maxLen - off);
-        if (!this->readMemory(addr + off, chunk, toRead)) break;
-        for (SIZE_T i = 0; i < toRead; ++i) {
-            if (chunk[i] == 0) {
-                s.append(reinterpret_cast<const char*>(chunk), i);
-                return s;
-            }
-        }
-        s.append(reinterpret_cast<const char*>(chunk), toRead);
-        off += toRead;
-    }
-    return s;
+    return RoboDBG::readTerminated([this](uintptr_t at, void* buffer, SIZE_T size) { return this->readMemory(at, buffer, size); },
+                                   addr, maxLen, 1);
 }
 
 bool Imports::getNtInfo(HMODULE base, NtInfo& out)
@@ -326,3 +313,5 @@ void Imports::collectModuleIat(HMODULE base, const char* modulePath, bool alsoPr
         }
     }
 }
+
+#endif
@@ -0,0 +1,104 @@
+#include "pointerChain.h"
+#include "readBatch.h"
+
+#include <algorithm>
+
+namespace RoboDBG {
+
+PointerResolver::PointerResolver(TargetBackend& target, PointerResolverOptions_t options)
+    : target_(target) {
+    setOptions(options);
+}
+
+void PointerResolver::setOptions(const PointerResolverOptions_t& options) {
+    options_ = options;
+    options_.pointerSize = options.pointerSize == 4 ? 4 : 8;
+    cache_.clear();
+}
+
+void PointerResolver::invalidate() {
+    cache_.clear();
+}
+
+std::vector<PointerResult_t> PointerResolver::resolve(std::span<const PointerPath_t> paths) {
+    ++calls_;
+    stats_ = {};
+
+    std::vector<PointerResult_t> results(paths.size());
+    std::vector<uintptr_t> current(paths.size());
+    std::vector<uint64_t> slots(paths.size());
+    std::vector<size_t> owners;
+    std::vector<ReadRequest_t> requests;
+    size_t depth = 0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        current[i] = paths[i].base;
+        depth = std::max(depth, paths[i].offsets.size());
+    }
+
+    auto pass = [&]() {
+        if (requests.empty()) return;
+        ReadBatchStats_t batch;
+        readBatch(target_, requests, options_.maxGap, &batch);
+        ++stats_.passes;
+        stats_.reads += requests.size();
+        stats_.ranges += batch.ranges;
+    };
+
+    // Level n reads the pointer at current + offsets[n] for every path with more offsets after it
+    for (size_t level = 0; level + 1 < depth; ++level) {
+        requests.clear();
+        owners.clear();
+        for (size_t i = 0; i < paths.size(); ++i) {
+            if (results[i].failedLevel >= 0 || level + 1 >= paths[i].offsets.size()) continue;
+            const uintptr_t at = current[i] + static_cast<uintptr_t>(paths[i].offsets[level]);
+
+            if (level < options_.stableLevels) {
+                auto it = cache_.find(at);
+                if (it != cache_.end() && (!options_.revalidateEvery || calls_ - it->second.call < options_.revalidateEvery)) {
+                    current[i] = it->second.value;
+                    ++stats_.cacheHits;
+                    continue;
+                }
+            }
+            slots[i] = 0;
+            requests.push_back(ReadRequest_t{ at, &slots[i], options_.pointerSize });
+            owners.push_back(i);
+        }
+        pass();
+
+        for (size_t k = 0; k < requests.size(); ++k) {
+            const size_t i = owners[k];
+            if (!requests[k].ok) {
+                results[i].failedLevel = static_cast<int>(level);
+                results[i].address = requests[k].address;
+                continue;
+            }
+            current[i] = static_cast<uintptr_t>(slots[i]); // little endian: a 4-byte pointer is zero-extended
+            if (level < options_.stableLevels) cache_[requests[k].address] = Cached_t{ current[i], calls_ };
+        }
+    }
+
+    // Final addresses and values
+    requests.clear();
+    owners.clear();
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (results[i].failedLevel >= 0) continue;
+        const auto& offsets = paths[i].offsets;
+        results[i].address = current[i] + (offsets.empty() ? 0 : static_cast<uintptr_t>(offsets.back()));
+        const SIZE_T size = std::min<SIZE_T>(paths[i].valueSize, sizeof(uint64_t));
+        if (!size) continue;
+        slots[i] = 0;
+        requests.push_back(ReadRequest_t{ results[i].address, &slots[i], size });
+        owners.push_back(i);
+    }
+    pass();
+
+    for (size_t k = 0; k < requests.size(); ++k) {
+        const size_t i = owners[k];
+        if (requests[k].ok) results[i].value = slots[i];
+        else results[i].failedLevel = static_cast<int>(paths[i].offsets.empty() ? 0 : paths[i].offsets.size() - 1);
+    }
+    return results;
+}
+
+} // namespace RoboDBG
@@ -0,0 +1,126 @@
+/**
+ * @file pointerChain.h
+ * @brief Batched resolution of multi-level pointer paths ([[[base+a]+b]+c])
+ * @author Milkshake
+ */
+
+#ifndef POINTERCHAIN_H
+#define POINTERCHAIN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "platform.h"
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    /**
+     * @struct PointerPath_t
+     * @brief A pointer path: start at base, and for every offset but the last add it and read a pointer.
+     *
+     * [[[base+0x10]+0x48]+0x8] is { base, { 0x10, 0x48, 0x8 } }: pointers are read at base+0x10 and
+     * at [base+0x10]+0x48, and the path ends at [[base+0x10]+0x48]+0x8, where valueSize bytes are read.
+     */
+    struct PointerPath_t {
+        uintptr_t base = 0;           ///< Start address (e.g. module base + static offset).
+        std::vector<int64_t> offsets; ///< Offsets per level; empty ends at base.
+        uint8_t valueSize = 0;        ///< Bytes read at the final address (0–8); 0 reads nothing.
+    };
+
+    /**
+     * @struct PointerResult_t
+     * @brief Where a path ended.
+     */
+    struct PointerResult_t {
+        uintptr_t address = 0; ///< Final address; if failedLevel >= 0 the address that could not be read.
+        uint64_t value = 0;    ///< valueSize bytes at address, zero-extended.
+        int failedLevel = -1;  ///< Level whose read failed (offsets.size() - 1: the value); -1 if none.
+
+        inline bool ok() const { return failedLevel < 0; }
+    };
+
+    /**
+     * @struct PointerResolverOptions_t
+     * @brief Pointer width, batching and prefix caching of a PointerResolver.
+     */
+    struct PointerResolverOptions_t {
+        size_t pointerSize = sizeof(uintptr_t); ///< 8 or 4 (32-bit target).
+        size_t stableLevels = 0;     ///< Leading pointer reads of every path that are cached between calls.
+        unsigned revalidateEvery = 0;///< Re-read cached pointers after this many calls; 0 keeps them until invalidate().
+        SIZE_T maxGap = 0;           ///< Merge reads at most this many bytes apart (see readBatch()).
+    };
+
+    /**
+     * @struct PointerResolverStats_t
+     * @brief Work done by the last resolve().
+     */
+    struct PointerResolverStats_t {
+        size_t passes = 0;    ///< Batched read passes (one per level with reads, one for the values).
+        size_t reads = 0;     ///< Pointer and value reads issued, before coalescing.
+        size_t ranges = 0;    ///< Ranges actually read after coalescing.
+        size_t cacheHits = 0; ///< Pointer reads served from the prefix cache.
+    };
+
+    /**
+     * @class PointerResolver
+     * @brief Resolves many pointer paths level by level, one coalesced batch read per level.
+     *
+     * All paths advance together: the pointer reads of depth n of every path go into one readBatch(),
+     * so paths sharing a prefix read it once and neighbouring fields are merged. The first stableLevels
+     * reads of a path (typically the static pointer off a module base) are remembered by address and
+     * reused by later calls until invalidate(), or for revalidateEvery calls.
+     */
+    class PointerResolver {
+    public:
+        /**
+         * @brief Creates a resolver.
+         * @param target Memory of the debuggee.
+         * @param options Pointer width, batching and caching.
+         */
+        explicit PointerResolver(TargetBackend& target, PointerResolverOptions_t options = {});
+
+        /**
+         * @brief Resolves paths.
+         * @param paths Paths.
+         * @return One result per path, in the same order.
+         */
+        std::vector<PointerResult_t> resolve(std::span<const PointerPath_t> paths);
+
+        /**
+         * @brief Forgets the cached pointers (modules loaded / unloaded, target restarted).
+         */
+        void invalidate();
+
+        /**
+         * @brief Replaces the options; the cache is emptied.
+         */
+        void setOptions(const PointerResolverOptions_t& options);
+
+        inline const PointerResolverOptions_t& options() const { return options_; }
+        inline const PointerResolverStats_t& stats() const { return stats_; }
+
+        /**
+         * @brief Returns the number of cached pointers.
+         */
+        inline size_t cached() const { return cache_.size(); }
+
+    private:
+        struct Cached_t {
+            uintptr_t value;
+            uint64_t call; ///< Call that read it.
+        };
+
+        TargetBackend& target_;
+        PointerResolverOptions_t options_;
+        PointerResolverStats_t stats_;
+        std::unordered_map<uintptr_t, Cached_t> cache_; ///< Pointer address -> pointer read there.
+        uint64_t calls_ = 0;
+    };
+
+} // namespace RoboDBG
+
+#endif
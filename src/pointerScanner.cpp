@@ -0,0 +1,344 @@
+#include "pointerScanner.h"
+#include "parallelScan.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+namespace RoboDBG {
+
+namespace {
+    constexpr char FILE_MAGIC[8] = { 'R', 'D', 'B', 'G', 'P', 'T', 'R', '\0' };
+    constexpr uint64_t FILE_VERSION = 1;
+
+    constexpr SIZE_T DUMP_ITEM = 1 << 20; // bytes of a dump per work item
+
+    // LEB128: offsets below 0x4000 take two bytes
+    void putVarint(std::vector<char>& out, uint64_t v) {
+        do {
+            const char b = static_cast<char>(v & 0x7F);
+            v >>= 7;
+            out.push_back(static_cast<char>(b | (v ? 0x80 : 0)));
+        } while (v);
+    }
+
+    // Bounds-checked cursor over a loaded file
+    struct Reader_t {
+        const std::vector<char>& data;
+        size_t at = 0;
+
+        bool getVarint(uint64_t& v) {
+            v = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                if (at == data.size()) return false;
+                const auto b = static_cast<unsigned char>(data[at++]);
+                v |= static_cast<uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) return true;
+            }
+            return false;
+        }
+
+        bool getBytes(void* out, size_t n) {
+            if (data.size() - at < n) return false;
+            std::memcpy(out, data.data() + at, n);
+            at += n;
+            return true;
+        }
+
+        // Every element of a count takes at least one byte, so bogus counts fail before allocating
+        bool getCount(uint64_t& n) { return getVarint(n) && n <= data.size() - at; }
+    };
+
+    unsigned workerCount(unsigned threads, size_t items) {
+        const unsigned n = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+        return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(n, items)));
+    }
+
+    // Depth-first walk back from one address; every worker owns one
+    struct Search_t {
+        const std::vector<uintptr_t>& values;
+        const std::vector<uintptr_t>& slots;
+        const std::vector<Module_t>& modules;
+        const PointerScanOptions_t& options;
+        std::atomic<size_t>& found;
+        std::vector<PointerScanResult_t> out;
+        std::vector<int64_t> stack; ///< Offsets from the scanned address backwards.
+
+        // Map entries pointing into [address - maxOffset, address]
+        std::pair<size_t, size_t> below(uintptr_t address) const {
+            const uintptr_t low = address > options.maxOffset ? address - options.maxOffset : 0;
+            const auto first = std::lower_bound(values.begin(), values.end(), low);
+            const auto last = std::upper_bound(first, values.end(), address);
+            return { static_cast<size_t>(first - values.begin()), static_cast<size_t>(last - values.begin()) };
+        }
+
+        const Module_t* moduleAt(uintptr_t address) const {
+            auto it = std::upper_bound(modules.begin(), modules.end(), address,
+                                       [](uintptr_t a, const Module_t& m) { return a < m.base; });
+            if (it == modules.begin()) return nullptr;
+            --it;
+            return address < it->end() ? &*it : nullptr;
+        }
+
+        bool full() const {
+            return options.maxResults && found.load(std::memory_order_relaxed) >= options.maxResults;
+        }
+
+        // Entry i points at most maxOffset below target: step back to its slot
+        void step(size_t i, uintptr_t target) {
+            const uintptr_t slot = slots[i];
+            stack.push_back(static_cast<int64_t>(target - values[i]));
+            if (const Module_t* m = moduleAt(slot)) {
+                PointerScanResult_t r{ static_cast<uint32_t>(m - modules.data()), {} };
+                r.offsets.reserve(stack.size() + 1);
+                r.offsets.push_back(static_cast<int64_t>(slot - m->base));
+                r.offsets.insert(r.offsets.end(), stack.rbegin(), stack.rend());
+                out.push_back(std::move(r));
+                found.fetch_add(1, std::memory_order_relaxed);
+            } else if (stack.size() < options.maxDepth) {
+                const auto [first, last] = below(slot);
+                for (size_t j = first; j < last && !full(); ++j) step(j, slot);
+            }
+            stack.pop_back();
+        }
+    };
+}
+
+PointerScanner::PointerScanner(PointerScanOptions_t options)
+    : options_(options) {
+    options_.pointerSize = options.pointerSize == 4 ? 4 : 8;
+    if (!options_.alignment) options_.alignment = options_.pointerSize;
+}
+
+// ===========================
+// MAP
+// ===========================
+
+void PointerScanner::setRanges(std::vector<Range_t> ranges) {
+    std::sort(ranges.begin(), ranges.end(), [](const Range_t& a, const Range_t& b) { return a.begin < b.begin; });
+    ranges_.clear();
+    for (const Range_t& r : ranges) {
+        if (r.begin == r.end) continue;
+        if (!ranges_.empty() && r.begin <= ranges_.back().end) ranges_.back().end = std::max(ranges_.back().end, r.end);
+        else ranges_.push_back(r);
+    }
+}
+
+bool PointerScanner::pointsIntoMemory(uintptr_t value) const {
+    if (ranges_.empty() || value < ranges_.front().begin || value >= ranges_.back().end) return false;
+    auto it = std::upper_bound(ranges_.begin(), ranges_.end(), value,
+                               [](uintptr_t v, const Range_t& r) { return v < r.begin; });
+    return value < (--it)->end;
+}
+
+void PointerScanner::collect(const BYTE* data, SIZE_T size, uintptr_t address, std::vector<Entry_t>& out) const {
+    const size_t width = options_.pointerSize, align = options_.alignment;
+    const uintptr_t end = address + size;
+    for (uintptr_t at = (address + align - 1) / align * align; at < end && end - at >= width; at += align) {
+        uintptr_t value = 0; // little endian: a 4-byte pointer is zero-extended
+        std::memcpy(&value, data + (at - address), width);
+        if (pointsIntoMemory(value)) out.push_back(Entry_t{ value, at });
+    }
+}
+
+void PointerScanner::assignMap(std::vector<Entry_t> entries) {
+    std::sort(entries.begin(), entries.end(), [](const Entry_t& a, const Entry_t& b) {
+        return a.value != b.value ? a.value < b.value : a.slot < b.slot;
+    });
+    clearMap();
+    values_.reserve(entries.size());
+    slots_.reserve(entries.size());
+    for (const Entry_t& e : entries) {
+        values_.push_back(e.value);
+        slots_.push_back(e.slot);
+    }
+}
+
+size_t PointerScanner::buildMap(TargetBackend& target, std::span<const MemoryRegion_t> regions) {
+    std::vector<Range_t> ranges;
+    for (const MemoryRegion_t& r : regions) {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(r.BaseAddress);
+        ranges.push_back(Range_t{ base, base + r.RegionSize });
+    }
+    setRanges(std::move(ranges));
+
+    ParallelScan scan(target, ScanOptions_t{ options_.threads, 0, 0 });
+    assignMap(scan.collect<Entry_t>(regions, 0, [&](const MemoryChunk_t& chunk, std::vector<Entry_t>& hits) {
+        collect(chunk.data, chunk.size, chunk.address, hits);
+    }));
+    return values_.size();
+}
+
+size_t PointerScanner::buildMap(std::span<const MemoryDump_t> dumps) {
+    std::vector<Range_t> ranges;
+    struct Item_t { const MemoryDump_t* dump; SIZE_T offset; SIZE_T size; };
+    std::vector<Item_t> items;
+    for (const MemoryDump_t& d : dumps) {
+        ranges.push_back(Range_t{ d.address, d.address + d.data.size() });
+        for (SIZE_T offset = 0; offset < d.data.size(); offset += DUMP_ITEM) {
+            items.push_back(Item_t{ &d, offset, std::min<SIZE_T>(DUMP_ITEM, d.data.size() - offset) });
+        }
+    }
+    setRanges(std::move(ranges));
+
+    // An item reads up to pointerSize - 1 bytes into the next one, so a slot crossing the cut is kept by the item it starts in
+    std::vector<std::vector<Entry_t>> perItem(items.size());
+    std::atomic<size_t> next{ 0 };
+    auto work = [&]() {
+        for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < items.size(); ) {
+            const Item_t& item = items[i];
+            const SIZE_T size = std::min<SIZE_T>(item.size + options_.pointerSize - 1, item.dump->data.size() - item.offset);
+            std::vector<Entry_t>& hits = perItem[i];
+            collect(item.dump->data.data() + item.offset, size, item.dump->address + item.offset, hits);
+            // Slots starting in the next item's bytes are that item's
+            while (!hits.empty() && hits.back().slot >= item.dump->address + item.offset + item.size) hits.pop_back();
+        }
+    };
+    const unsigned workers = workerCount(options_.threads, items.size());
+    std::vector<std::thread> pool;
+    for (unsigned w = 1; w < workers; ++w) pool.emplace_back(work);
+    work();
+    for (std::thread& t : pool) t.join();
+
+    size_t total = 0;
+    for (const auto& hits : perItem) total += hits.size();
+    std::vector<Entry_t> entries;
+    entries.reserve(total);
+    for (auto& hits : perItem) {
+        entries.insert(entries.end(), hits.begin(), hits.end());
+        std::vector<Entry_t>().swap(hits);
+    }
+    assignMap(std::move(entries));
+    return values_.size();
+}
+
+void PointerScanner::clearMap() {
+    std::vector<uintptr_t>().swap(values_);
+    std::vector<uintptr_t>().swap(slots_);
+}
+
+// ===========================
+// SEARCH
+// ===========================
+
+size_t PointerScanner::scan(uintptr_t address, std::span<const Module_t> modules) {
+    modules_.assign(modules.begin(), modules.end());
+    std::sort(modules_.begin(), modules_.end(), [](const Module_t& a, const Module_t& b) { return a.base < b.base; });
+    results_.clear();
+    if (!options_.maxDepth) return 0;
+
+    // The first steps back are shared out; each worker follows its own depth-first
+    std::atomic<size_t> found{ 0 };
+    Search_t probe{ values_, slots_, modules_, options_, found, {}, {} };
+    const auto [first, last] = probe.below(address);
+    std::atomic<size_t> next{ first };
+
+    const unsigned workers = workerCount(options_.threads, last - first);
+    std::vector<Search_t> searches(workers, probe);
+    auto work = [&](Search_t& search) {
+        for (size_t i; !search.full() && (i = next.fetch_add(1, std::memory_order_relaxed)) < last; ) {
+            search.step(i, address);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned w = 1; w < workers; ++w) pool.emplace_back(work, std::ref(searches[w]));
+    work(searches[0]);
+    for (std::thread& t : pool) t.join();
+
+    for (Search_t& search : searches) {
+        std::move(search.out.begin(), search.out.end(), std::back_inserter(results_));
+    }
+    std::sort(results_.begin(), results_.end(), [](const PointerScanResult_t& a, const PointerScanResult_t& b) {
+        return a.module != b.module ? a.module < b.module : a.offsets < b.offsets;
+    });
+    // With a limit and several workers, which paths make the cut depends on timing
+    if (options_.maxResults && results_.size() > options_.maxResults) results_.resize(options_.maxResults);
+    return results_.size();
+}
+
+PointerPath_t PointerScanner::path(size_t index, uint8_t valueSize, std::span<const Module_t> modules) const {
+    const PointerScanResult_t& r = results_.at(index);
+    const Module_t& scanned = modules_[r.module];
+    uintptr_t base = scanned.base;
+    if (!modules.empty()) {
+        auto it = std::find_if(modules.begin(), modules.end(), [&](const Module_t& m) { return m.name == scanned.name; });
+        base = it == modules.end() ? 0 : it->base;
+    }
+    return PointerPath_t{ base, r.offsets, valueSize };
+}
+
+// ===========================
+// SERIALIZATION
+// ===========================
+
+bool PointerScanner::save(const std::string& path) const {
+    std::vector<char> out(FILE_MAGIC, FILE_MAGIC + sizeof(FILE_MAGIC));
+    putVarint(out, FILE_VERSION);
+    putVarint(out, options_.pointerSize);
+    putVarint(out, modules_.size());
+    for (const Module_t& m : modules_) {
+        putVarint(out, m.name.size());
+        out.insert(out.end(), m.name.begin(), m.name.end());
+        putVarint(out, m.size);
+    }
+    putVarint(out, results_.size());
+    for (const PointerScanResult_t& r : results_) {
+        putVarint(out, r.module);
+        putVarint(out, r.offsets.size());
+        for (int64_t offset : r.offsets) putVarint(out, static_cast<uint64_t>(offset));
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+bool PointerScanner::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Reader_t in{ data };
+    char magic[sizeof(FILE_MAGIC)];
+    uint64_t version = 0, pointerSize = 0, count = 0;
+    if (!in.getBytes(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) return false;
+    if (!in.getVarint(version) || version != FILE_VERSION) return false;
+    if (!in.getVarint(pointerSize) || (pointerSize != 4 && pointerSize != 8)) return false;
+
+    std::vector<Module_t> modules;
+    if (!in.getCount(count)) return false;
+    modules.resize(count);
+    for (Module_t& m : modules) {
+        uint64_t length = 0, size = 0;
+        if (!in.getCount(length)) return false;
+        m.name.resize(length);
+        if (!in.getBytes(m.name.data(), length) || !in.getVarint(size)) return false;
+        m.size = static_cast<SIZE_T>(size);
+    }
+
+    std::vector<PointerScanResult_t> results;
+    if (!in.getCount(count)) return false;
+    results.resize(count);
+    for (PointerScanResult_t& r : results) {
+        uint64_t module = 0, offsets = 0;
+        if (!in.getVarint(module) || module >= modules.size() || !in.getCount(offsets) || offsets < 2) return false;
+        r.module = static_cast<uint32_t>(module);
+        r.offsets.resize(offsets);
+        for (int64_t& offset : r.offsets) {
+            uint64_t v = 0;
+            if (!in.getVarint(v)) return false;
+            offset = static_cast<int64_t>(v);
+        }
+    }
+    if (in.at != data.size()) return false;
+
+    options_.pointerSize = static_cast<size_t>(pointerSize);
+    modules_ = std::move(modules);
+    results_ = std::move(results);
+    return true;
+}
+
+} // namespace RoboDBG
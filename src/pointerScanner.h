@@ -0,0 +1,166 @@
+/**
+ * @file pointerScanner.h
+ * @brief Search for static pointer paths to an address (pointer scan)
+ * @author Milkshake
+ */
+
+#ifndef POINTERSCANNER_H
+#define POINTERSCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "platform.h"
+#include "addressSpace.h"
+#include "pointerChain.h"
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    /**
+     * @struct PointerScanOptions_t
+     * @brief Limits of a pointer scan.
+     */
+    struct PointerScanOptions_t {
+        size_t maxDepth = 4;          ///< Most pointer reads in a path (the static one included).
+        SIZE_T maxOffset = 0x800;     ///< Largest offset added to a pointer (the size of the structs walked).
+        size_t pointerSize = sizeof(uintptr_t); ///< 8 or 4 (32-bit target).
+        size_t alignment = 0;         ///< Distance between pointer slots looked at; 0 is the pointer size.
+        size_t maxResults = 0;        ///< Stop after this many paths; 0 = all.
+        unsigned threads = 0;         ///< Worker threads for building the map and searching; 0 = one per core.
+    };
+
+    /**
+     * @struct MemoryDump_t
+     * @brief A copy of target memory at an address, e.g. loaded from a dump file.
+     */
+    struct MemoryDump_t {
+        uintptr_t address = 0;       ///< Target address of data[0].
+        std::span<const BYTE> data;  ///< Bytes; must stay alive while the map is built.
+    };
+
+    /**
+     * @struct PointerScanResult_t
+     * @brief A static path, relative to a module so it survives ASLR and restarts.
+     *
+     * The first offset is the static pointer's offset into the module, the others are added to the pointers
+     * read: { module base, offsets } as a PointerPath_t ends at the scanned address.
+     */
+    struct PointerScanResult_t {
+        uint32_t module = 0;          ///< Index into PointerScanner::modules().
+        std::vector<int64_t> offsets; ///< Module offset of the static pointer, then one offset per level.
+    };
+
+    /**
+     * @class PointerScanner
+     * @brief Finds the paths from module-static pointers to an address, like a debugger's pointer scan.
+     *
+     * buildMap() reads all memory once and keeps every aligned slot whose value points into the scanned
+     * memory, sorted by that value: a reverse pointer map (value -> slots) of 16 bytes per pointer. scan()
+     * then walks backwards from the address: every slot pointing at most maxOffset bytes below the current
+     * address is a step back, and a slot inside a module ends a path. Both the map and the search run on
+     * several threads; the map can be reused for any number of scans while the target does not change.
+     */
+    class PointerScanner {
+    public:
+        /**
+         * @brief Creates a scanner.
+         * @param options Depth, offset and result limits; pointerSize is forced to 4 or 8.
+         */
+        explicit PointerScanner(PointerScanOptions_t options = {});
+
+        /**
+         * @brief Builds the pointer map from target memory.
+         * @param target Memory of the debuggee.
+         * @param regions Regions to read (see RegionReader::readable()); pointers must point into them.
+         * @return Number of pointers in the map.
+         */
+        size_t buildMap(TargetBackend& target, std::span<const MemoryRegion_t> regions);
+
+        /**
+         * @brief Builds the pointer map from memory copies; pointers must point into one of them.
+         * @param dumps Non-overlapping copies.
+         * @return Number of pointers in the map.
+         */
+        size_t buildMap(std::span<const MemoryDump_t> dumps);
+
+        /**
+         * @brief Finds the static paths to an address and replaces the results.
+         * @param address Address the paths must end at.
+         * @param modules Modules whose memory counts as static (see AddressSpace::modules()).
+         * @return Number of paths, sorted by module, then offsets.
+         */
+        size_t scan(uintptr_t address, std::span<const Module_t> modules);
+
+        inline const std::vector<PointerScanResult_t>& results() const { return results_; }
+        inline const std::vector<Module_t>& modules() const { return modules_; }
+        inline const PointerScanOptions_t& options() const { return options_; }
+
+        /**
+         * @brief Returns a result as a path for PointerResolver / Debugger::resolvePointerChains().
+         * @param index Result index.
+         * @param valueSize Bytes to read at the end of the path.
+         * @param modules Modules of the current run (matched by name); empty uses the modules of the scan.
+         */
+        PointerPath_t path(size_t index, uint8_t valueSize = 0, std::span<const Module_t> modules = {}) const;
+
+        /**
+         * @brief Writes the modules and results to a compact binary file (variable-length integers).
+         * @param path File path.
+         * @return false if the file could not be written.
+         */
+        bool save(const std::string& path) const;
+
+        /**
+         * @brief Replaces the modules and results with those written by save(); the map is kept.
+         *
+         * Module bases are not saved: pass the modules of the current run to path().
+         * @param path File path.
+         * @return false if the file is missing or malformed.
+         */
+        bool load(const std::string& path);
+
+        /**
+         * @brief Returns the number of pointers in the map.
+         */
+        inline size_t mapSize() const { return values_.size(); }
+
+        /**
+         * @brief Returns the bytes held by the map.
+         */
+        inline size_t memoryUsage() const { return (values_.capacity() + slots_.capacity()) * sizeof(uintptr_t); }
+
+        /**
+         * @brief Frees the map; the results are kept.
+         */
+        void clearMap();
+
+    private:
+        struct Entry_t {
+            uintptr_t value; ///< Pointer read.
+            uintptr_t slot;  ///< Where it was read.
+        };
+
+        struct Range_t {
+            uintptr_t begin, end;
+        };
+
+        void collect(const BYTE* data, SIZE_T size, uintptr_t address, std::vector<Entry_t>& out) const;
+        void assignMap(std::vector<Entry_t> entries);
+        void setRanges(std::vector<Range_t> ranges);
+        bool pointsIntoMemory(uintptr_t value) const;
+
+        PointerScanOptions_t options_;
+        std::vector<Range_t> ranges_;       ///< Memory a pointer may point into, ascending.
+        std::vector<uintptr_t> values_;     ///< Map: pointer values, ascending.
+        std::vector<uintptr_t> slots_;      ///< Map: slot of values_[i].
+        std::vector<Module_t> modules_;     ///< Modules of the last scan / load.
+        std::vector<PointerScanResult_t> results_;
+    };
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,104 @@
+#include "readBatch.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace RoboDBG {
+
+std::vector<ReadRange_t> coalesceReads(std::span<const ReadRequest_t> requests, std::vector<size_t>& order, SIZE_T maxGap)
+{
+    order.clear();
+    for (size_t i = 0; i < requests.size(); ++i) {
+        if (requests[i].size) order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return requests[a].address < requests[b].address; });
+
+    std::vector<ReadRange_t> ranges;
+    uintptr_t end = 0;
+    for (size_t k = 0; k < order.size(); ++k) {
+        const ReadRequest_t& r = requests[order[k]];
+        // Overlapping, touching or at most maxGap bytes behind the current range
+        if (!ranges.empty() && (r.address <= end || r.address - end <= maxGap)) {
+            end = std::max<uintptr_t>(end, r.address + r.size);
+            ranges.back().size = end - ranges.back().address;
+            ++ranges.back().count;
+            continue;
+        }
+        ranges.push_back(ReadRange_t{ r.address, r.size, k, 1 });
+        end = r.address + r.size;
+    }
+    return ranges;
+}
+
+size_t readBatch(TargetBackend& target, std::span<ReadRequest_t> requests, SIZE_T maxGap, ReadBatchStats_t* stats)
+{
+    ReadBatchStats_t local;
+    std::vector<size_t> order;
+    const std::vector<ReadRange_t> ranges = coalesceReads(requests, order, maxGap);
+    local.ranges = ranges.size();
+
+    // A range serving one request exactly reads into the caller's buffer
+    auto direct = [&](const ReadRange_t& range) {
+        const ReadRequest_t& r = requests[order[range.first]];
+        return range.count == 1 && r.address == range.address && r.size == range.size;
+    };
+
+    SIZE_T staged = 0;
+    for (const ReadRange_t& range : ranges) {
+        if (!direct(range)) staged += range.size;
+        local.bytes += range.size;
+    }
+    std::vector<BYTE> staging(staged);
+
+    std::vector<MemoryIo_t> ios;
+    ios.reserve(ranges.size());
+    staged = 0;
+    for (const ReadRange_t& range : ranges) {
+        if (direct(range)) {
+            ios.push_back(MemoryIo_t{ range.address, requests[order[range.first]].buffer, range.size });
+        } else {
+            ios.push_back(MemoryIo_t{ range.address, staging.data() + staged, range.size });
+            staged += range.size;
+        }
+    }
+    if (!ios.empty()) target.readMemoryScatter(ios.data(), ios.size());
+
+    size_t complete = 0;
+    for (ReadRequest_t& r : requests) {
+        if (!r.size) {
+            r.transferred = 0;
+            r.ok = true;
+            ++complete;
+        }
+    }
+
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        const ReadRange_t& range = ranges[i];
+        const MemoryIo_t& io = ios[i];
+        const uintptr_t readEnd = range.address + io.transferred;
+
+        for (size_t k = range.first; k < range.first + range.count; ++k) {
+            ReadRequest_t& r = requests[order[k]];
+            if (r.address > readEnd && io.transferred < range.size) {
+                // The range broke before this request started; its own bytes may still be readable.
+                // A request starting right at the break would fail the same way and is not retried.
+                ++local.retries;
+                SIZE_T got = 0;
+                target.readMemory(r.address, r.buffer, r.size, &got);
+                r.transferred = got;
+            } else {
+                const SIZE_T offset = r.address - range.address;
+                r.transferred = std::min<SIZE_T>(r.size, readEnd - r.address);
+                if (io.buffer != r.buffer) std::memcpy(r.buffer, static_cast<const BYTE*>(io.buffer) + offset, r.transferred);
+            }
+            r.ok = r.transferred == r.size;
+            if (r.ok) ++complete;
+        }
+    }
+
+    if (stats) *stats = local;
+    return complete;
+}
+
+} // namespace RoboDBG
@@ -0,0 +1,78 @@
+/**
+ * @file readBatch.h
+ * @brief Many small target reads coalesced into as few backend reads as possible
+ * @author Milkshake
+ */
+
+#ifndef READBATCH_H
+#define READBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    /**
+     * @struct ReadRequest_t
+     * @brief One range to read into a local buffer.
+     */
+    struct ReadRequest_t {
+        uintptr_t address = 0;  ///< Target address.
+        void* buffer = nullptr; ///< Local buffer of at least size bytes.
+        SIZE_T size = 0;        ///< Bytes to read.
+        SIZE_T transferred = 0; ///< Bytes read from address before the first unreadable byte.
+        bool ok = false;        ///< Set if all size bytes were read.
+    };
+
+    /**
+     * @struct ReadRange_t
+     * @brief A range read once on behalf of several requests.
+     */
+    struct ReadRange_t {
+        uintptr_t address = 0; ///< Start of the range.
+        SIZE_T size = 0;       ///< Bytes in the range.
+        size_t first = 0;      ///< Index of the first request of the range in the order returned by coalesceReads().
+        size_t count = 0;      ///< Number of requests served by the range.
+    };
+
+    /**
+     * @struct ReadBatchStats_t
+     * @brief Number of target operations a batch needed.
+     */
+    struct ReadBatchStats_t {
+        size_t ranges = 0;  ///< Ranges after coalescing (one scatter descriptor each).
+        size_t retries = 0; ///< Requests read again alone because their range failed before them.
+        SIZE_T bytes = 0;   ///< Bytes requested from the target, gaps included.
+    };
+
+    /**
+     * @brief Sorts requests by address and merges overlapping, adjacent and nearly adjacent ones.
+     * @param requests Requests; not reordered. Requests of size 0 are left out.
+     * @param order Receives request indices in address order; ranges refer to runs of it.
+     * @param maxGap Largest number of unrequested bytes between two requests that are still merged.
+     * @return Ranges in ascending order; they neither overlap nor touch.
+     */
+    std::vector<ReadRange_t> coalesceReads(std::span<const ReadRequest_t> requests, std::vector<size_t>& order, SIZE_T maxGap = 0);
+
+    /**
+     * @brief Reads many ranges with one readMemoryScatter() call over the coalesced ranges.
+     *
+     * A range that serves one request exactly is read straight into its buffer; others go through a
+     * staging buffer. If a range stops early, the requests that start behind the failing byte are read
+     * again on their own, so every request gets the bytes a readMemory() of its own would have returned.
+     *
+     * @param target Memory of the debuggee.
+     * @param requests Requests; transferred / ok are filled in, the order is kept.
+     * @param maxGap See coalesceReads().
+     * @param stats Optional; receives the operation counts.
+     * @return Number of requests read completely (requests of size 0 included).
+     */
+    size_t readBatch(TargetBackend& target, std::span<ReadRequest_t> requests, SIZE_T maxGap = 0, ReadBatchStats_t* stats = nullptr);
+
+} // namespace RoboDBG
+
+#endif
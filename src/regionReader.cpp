@@ -0,0 +1,161 @@
+#include "regionReader.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace RoboDBG {
+
+namespace {
+    constexpr SIZE_T MIN_STEP = 0x1000; // each chunk advances at least one page past the overlap
+}
+
+RegionReader::RegionReader(TargetBackend& target, RegionReaderOptions_t options)
+    : target_(target), options_(options) {
+}
+
+bool RegionReader::readable(const MemoryRegion_t& region) {
+    return region.State == MEM_COMMIT && !(region.Protect & PAGE_GUARD) && region.Protect != PAGE_NOACCESS;
+}
+
+SIZE_T RegionReader::chunkSize(SIZE_T overlap) const {
+    const SIZE_T buffers = options_.prefetch ? 2 : 1;
+    const SIZE_T chunk = std::min(options_.chunkSize, options_.memoryLimit / buffers);
+    return std::max(chunk, overlap + MIN_STEP);
+}
+
+SIZE_T RegionReader::read(const Job_t& job, BYTE* buffer) {
+    SIZE_T got = 0;
+    if (!target_.readMemory(job.address, buffer, job.size, &got)) got = std::min(got, job.size);
+    return got;
+}
+
+size_t RegionReader::forEachChunk(std::span<const MemoryRegion_t> regions, SIZE_T overlap,
+                                  const std::function<bool(const MemoryChunk_t&)>& fn) {
+    const SIZE_T chunk = chunkSize(overlap);
+
+    // Chunks are produced in region order; next() advances (region, end of the last chunk)
+    size_t regionIndex = 0;
+    uintptr_t position = 0;
+    bool started = false;
+    auto next = [&](Job_t& job) {
+        while (regionIndex < regions.size()) {
+            const MemoryRegion_t& r = regions[regionIndex];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(r.BaseAddress);
+            const uintptr_t end = base + r.RegionSize;
+            if (!started) {
+                position = base;
+                started = true;
+            }
+            if (position < end) {
+                const SIZE_T back = position == base ? 0 : overlap;
+                job.region  = &r;
+                job.address = position - back;
+                job.size    = std::min<SIZE_T>(chunk, end - job.address);
+                job.overlap = back;
+                position = job.address + job.size;
+                return true;
+            }
+            ++regionIndex;
+            started = false;
+        }
+        return false;
+    };
+
+    SIZE_T largest = 0;
+    for (const auto& r : regions) largest = std::max(largest, r.RegionSize);
+    const SIZE_T bufferSize = std::min(chunk, largest);
+
+    size_t delivered = 0;
+    auto deliver = [&](const Job_t& job, const BYTE* data, SIZE_T got) {
+        if (got == 0) return true; // unreadable chunk, e.g. decommitted since the region list was taken
+        ++delivered;
+        return fn(MemoryChunk_t{ job.region, job.address, data, got, job.size, job.overlap });
+    };
+
+    Job_t current{};
+    if (!next(current)) return 0;
+
+    if (!options_.prefetch) {
+        buffers_[0].resize(bufferSize);
+        do {
+            const SIZE_T got = read(current, buffers_[0].data());
+            if (!deliver(current, buffers_[0].data(), got)) break;
+        } while (next(current));
+        return delivered;
+    }
+
+    buffers_[0].resize(bufferSize);
+    buffers_[1].resize(bufferSize);
+
+    // One worker reads the next chunk while the callback consumes the current one
+    std::mutex mutex;
+    std::condition_variable cv;
+    Job_t pending{};
+    BYTE* pendingBuffer = nullptr;
+    bool hasJob = false, finished = false, quit = false;
+    SIZE_T pendingGot = 0;
+
+    std::thread worker([&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            cv.wait(lock, [&] { return hasJob || quit; });
+            if (quit) return;
+            const Job_t job = pending;
+            BYTE* buffer = pendingBuffer;
+            lock.unlock();
+            const SIZE_T got = read(job, buffer);
+            lock.lock();
+            pendingGot = got;
+            hasJob = false;
+            finished = true;
+            cv.notify_all();
+        }
+    });
+
+    auto submit = [&](const Job_t& job, BYTE* buffer) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = job;
+        pendingBuffer = buffer;
+        hasJob = true;
+        finished = false;
+        cv.notify_all();
+    };
+    auto wait = [&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return finished; });
+        finished = false;
+        return pendingGot;
+    };
+
+    size_t slot = 0;
+    bool inFlight = true;
+    submit(current, buffers_[0].data());
+    for (;;) {
+        const SIZE_T got = wait();
+        inFlight = false;
+
+        Job_t following{};
+        const bool more = next(following);
+        if (more) {
+            submit(following, buffers_[slot ^ 1].data());
+            inFlight = true;
+        }
+
+        if (!deliver(current, buffers_[slot].data(), got) || !more) break;
+        current = following;
+        slot ^= 1;
+    }
+
+    if (inFlight) wait(); // stopped early; the worker still writes into the other buffer
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+        cv.notify_all();
+    }
+    worker.join();
+    return delivered;
+}
+
+} // namespace RoboDBG
@@ -0,0 +1,109 @@
+/**
+ * @file regionReader.h
+ * @brief Bounded-memory streaming of target memory regions
+ * @author Milkshake
+ */
+
+#ifndef REGIONREADER_H
+#define REGIONREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "platform.h"
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    /**
+     * @struct RegionReaderOptions_t
+     * @brief How much memory a RegionReader may use and how it reads.
+     */
+    struct RegionReaderOptions_t {
+        SIZE_T chunkSize   = 1 << 20; ///< Bytes per read; reduced to fit memoryLimit.
+        SIZE_T memoryLimit = 4 << 20; ///< Ceiling for all buffers together.
+        bool prefetch      = true;    ///< Read the next chunk on a worker thread while the current one is processed.
+    };
+
+    /**
+     * @struct MemoryChunk_t
+     * @brief One piece of a region handed to the consumer. Valid only during the callback.
+     */
+    struct MemoryChunk_t {
+        const MemoryRegion_t* region = nullptr; ///< Region the chunk belongs to.
+        uintptr_t address = 0;  ///< Target address of data[0].
+        const BYTE* data = nullptr; ///< Bytes read.
+        SIZE_T size = 0;        ///< Bytes read from address (less than requested if the read failed part way).
+        SIZE_T requested = 0;   ///< Bytes asked for.
+        SIZE_T overlap = 0;     ///< Leading bytes repeated from the end of the previous chunk of the region.
+
+        /**
+         * @brief Returns true if no chunk of the same region follows.
+         */
+        inline bool lastInRegion() const {
+            return address + requested == reinterpret_cast<uintptr_t>(region->BaseAddress) + region->RegionSize;
+        }
+    };
+
+    /**
+     * @class RegionReader
+     * @brief Streams target regions through two reusable buffers instead of reading each region whole.
+     *
+     * Every region is cut into chunks of at most chunkSize bytes. With an overlap of n bytes each chunk
+     * after the first in a region starts n bytes before the end of the previous one, so a pattern of
+     * n + 1 bytes that crosses a chunk boundary is seen whole exactly once. With prefetch the next chunk
+     * is read on a worker thread while the callback runs, which needs a backend whose readMemory() may be
+     * called from another thread (Win32, ptrace and the simulated backend can).
+     */
+    class RegionReader {
+    public:
+        /**
+         * @brief Creates a reader.
+         * @param target Memory of the debuggee.
+         * @param options Buffer sizes.
+         */
+        explicit RegionReader(TargetBackend& target, RegionReaderOptions_t options = {});
+
+        /**
+         * @brief Reads the regions chunk by chunk in order.
+         * @param regions Regions to read (see readable()).
+         * @param overlap Bytes each chunk repeats from the previous one; must be smaller than the chunk size.
+         * @param fn Called for every chunk with at least one byte read; return false to stop.
+         * @return Number of chunks handed to fn.
+         */
+        size_t forEachChunk(std::span<const MemoryRegion_t> regions, SIZE_T overlap,
+                            const std::function<bool(const MemoryChunk_t&)>& fn);
+
+        /**
+         * @brief Returns the chunk size used with the current options and overlap.
+         * @param overlap Overlap that will be passed to forEachChunk().
+         */
+        SIZE_T chunkSize(SIZE_T overlap = 0) const;
+
+        /**
+         * @brief Checks if a region is committed and may be read (no guard / no-access pages).
+         * @param region Region from TargetBackend::getMemoryRegions().
+         */
+        static bool readable(const MemoryRegion_t& region);
+
+    private:
+        struct Job_t {
+            const MemoryRegion_t* region;
+            uintptr_t address;
+            SIZE_T size;
+            SIZE_T overlap;
+        };
+
+        SIZE_T read(const Job_t& job, BYTE* buffer);
+
+        TargetBackend& target_;
+        RegionReaderOptions_t options_;
+        std::vector<BYTE> buffers_[2];
+    };
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,160 @@
+#include "sessionMetrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+
+namespace RoboDBG {
+
+size_t LatencyHistogram::bucketOf(uint64_t ns) {
+    if (ns < SUB_BUCKETS) return static_cast<size_t>(ns);
+    // Power of two picks the group, the next SUB_BITS bits below the leading one the bucket within it
+    const unsigned exponent = static_cast<unsigned>(std::bit_width(ns)) - 1;
+    const size_t sub = static_cast<size_t>(ns >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1);
+    return (exponent - SUB_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucketHigh(size_t bucket) {
+    if (bucket < SUB_BUCKETS) return bucket;
+    const unsigned exponent = static_cast<unsigned>(bucket / SUB_BUCKETS) + SUB_BITS - 1;
+    const uint64_t width = uint64_t(1) << (exponent - SUB_BITS);
+    const uint64_t low = (SUB_BUCKETS + bucket % SUB_BUCKETS) * width;
+    return low + (width - 1);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    const uint64_t total = count();
+    if (!total) return 0;
+    p = std::clamp(p, 0.0, 100.0);
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(total))));
+
+    const uint64_t lo = min_.load(std::memory_order_relaxed);
+    const uint64_t hi = max_.load(std::memory_order_relaxed);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) return std::clamp(bucketHigh(i), lo, std::max(lo, hi));
+    }
+    return hi;
+}
+
+LatencySummary_t LatencyHistogram::summary() const {
+    LatencySummary_t out;
+    out.count = count();
+    if (!out.count) return out;
+    out.totalNs = total_.load(std::memory_order_relaxed);
+    out.minNs = min_.load(std::memory_order_relaxed);
+    out.maxNs = max_.load(std::memory_order_relaxed);
+    out.p50Ns = percentile(50);
+    out.p90Ns = percentile(90);
+    out.p99Ns = percentile(99);
+    out.p999Ns = percentile(99.9);
+    return out;
+}
+
+void LatencyHistogram::reset() {
+    for (std::atomic<uint64_t>& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    total_.store(0, std::memory_order_relaxed);
+    min_.store(UINT64_MAX, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+const char* eventTypeName(DebugEventType type) {
+    switch (type) {
+        case DebugEventType::CREATE_PROCESS: return "create_process";
+        case DebugEventType::EXIT_PROCESS:   return "exit_process";
+        case DebugEventType::CREATE_THREAD:  return "create_thread";
+        case DebugEventType::EXIT_THREAD:    return "exit_thread";
+        case DebugEventType::LOAD_DLL:       return "load_dll";
+        case DebugEventType::UNLOAD_DLL:     return "unload_dll";
+        case DebugEventType::EXCEPTION:      return "exception";
+        case DebugEventType::DEBUG_STRING:   return "debug_string";
+        case DebugEventType::RIP_ERROR:      return "rip_error";
+        default:                             return "unknown";
+    }
+}
+
+const char* metricCallbackName(MetricCallback callback) {
+    switch (callback) {
+        case MetricCallback::START:               return "onStart";
+        case MetricCallback::END:                 return "onEnd";
+        case MetricCallback::THREAD_CREATE:       return "onThreadCreate";
+        case MetricCallback::THREAD_EXIT:         return "onThreadExit";
+        case MetricCallback::DLL_LOAD:            return "onDLLLoad";
+        case MetricCallback::DLL_UNLOAD:          return "onDLLUnload";
+        case MetricCallback::BREAKPOINT:          return "onBreakpoint";
+        case MetricCallback::HARDWARE_BREAKPOINT: return "onHardwareBreakpoint";
+        case MetricCallback::EXCEPTION:           return "onException";
+        case MetricCallback::DEBUG_STRING:        return "onDebugString";
+        case MetricCallback::RIP_ERROR:           return "onRIPError";
+        case MetricCallback::UNKNOWN:             return "onUnknownDebugEvent";
+        default:                                  return "unknown";
+    }
+}
+
+SessionMetrics::SessionMetrics() : since_(monotonicNs()) {
+}
+
+MetricsSnapshot_t SessionMetrics::snapshot() const {
+    MetricsSnapshot_t out;
+    out.seconds = static_cast<double>(monotonicNs() - since_.load(std::memory_order_relaxed)) / 1e9;
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; ++i) out.stopped[i] = stopped_[i].summary();
+    for (size_t i = 0; i < METRIC_CALLBACK_COUNT; ++i) out.callbacks[i] = callbacks_[i].summary();
+    out.remote = remote_.snapshot();
+    return out;
+}
+
+void SessionMetrics::reset() {
+    for (LatencyHistogram& h : stopped_) h.reset();
+    for (LatencyHistogram& h : callbacks_) h.reset();
+    remote_.reset();
+    since_.store(monotonicNs(), std::memory_order_relaxed);
+}
+
+namespace {
+    void appendRow(std::string& out, const char* name, const LatencySummary_t& s) {
+        char line[160];
+        std::snprintf(line, sizeof(line), "    %-22s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f\n", name,
+            static_cast<unsigned long long>(s.count), s.p50Ns / 1e3, s.p90Ns / 1e3, s.p99Ns / 1e3,
+            s.p999Ns / 1e3, s.maxNs / 1e3);
+        out += line;
+    }
+
+    void appendHeader(std::string& out, const char* title) {
+        char line[160];
+        std::snprintf(line, sizeof(line), "    %-22s %10s %10s %10s %10s %10s %10s\n", title,
+            "count", "p50 us", "p90 us", "p99 us", "p99.9 us", "max us");
+        out += line;
+    }
+}
+
+std::string formatMetrics(const MetricsSnapshot_t& snapshot) {
+    std::string out;
+    char line[160];
+    std::snprintf(line, sizeof(line), "[+] Debugger metrics over %.3f s\n", snapshot.seconds);
+    out += line;
+
+    appendHeader(out, "stopped per event");
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; ++i) {
+        if (snapshot.stopped[i].count) appendRow(out, eventTypeName(static_cast<DebugEventType>(i)), snapshot.stopped[i]);
+    }
+    appendHeader(out, "callback");
+    for (size_t i = 0; i < METRIC_CALLBACK_COUNT; ++i) {
+        if (snapshot.callbacks[i].count) appendRow(out, metricCallbackName(static_cast<MetricCallback>(i)), snapshot.callbacks[i]);
+    }
+
+    std::snprintf(line, sizeof(line), "    %-22s %10s %14s\n", "remote call", "calls", "bytes");
+    out += line;
+    for (size_t i = 0; i < REMOTE_CALL_COUNT; ++i) {
+        if (!snapshot.remote.calls[i]) continue;
+        std::snprintf(line, sizeof(line), "    %-22s %10llu %14llu\n", remoteCallName(static_cast<RemoteCall>(i)),
+            static_cast<unsigned long long>(snapshot.remote.calls[i]),
+            static_cast<unsigned long long>(snapshot.remote.bytes[i]));
+        out += line;
+    }
+    return out;
+}
+
+} // namespace RoboDBG
@@ -0,0 +1,174 @@
+/**
+ * @file sessionMetrics.h
+ * @brief Per-event latency histograms and counters of the debugger's own work
+ * @author Milkshake
+ */
+
+#ifndef SESSIONMETRICS_H
+#define SESSIONMETRICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "platform.h"
+#include "traceRecorder.h"
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    /**
+     * @struct LatencySummary_t
+     * @brief Count and percentiles of a LatencyHistogram, in nanoseconds.
+     */
+    struct LatencySummary_t {
+        uint64_t count = 0;   ///< Recorded values.
+        uint64_t totalNs = 0; ///< Sum of the recorded values.
+        uint64_t minNs = 0;
+        uint64_t maxNs = 0;
+        uint64_t p50Ns = 0;
+        uint64_t p90Ns = 0;
+        uint64_t p99Ns = 0;
+        uint64_t p999Ns = 0;
+
+        inline uint64_t meanNs() const { return count ? totalNs / count : 0; }
+    };
+
+    /**
+     * @class LatencyHistogram
+     * @brief Log-linear histogram of durations (HdrHistogram layout with 16 sub-buckets per power of two).
+     *
+     * Values below 16 ns get a bucket each; above, every power of two is split into 16 equal buckets, so a
+     * percentile is off by at most 1/16 (6.25 %) of the value over the whole uint64_t range. Recording is a
+     * handful of instructions and never allocates. One thread records at a time; snapshots may be taken
+     * from any thread and see each counter on its own.
+     */
+    class LatencyHistogram {
+    public:
+        static constexpr unsigned SUB_BITS = 4;
+        static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BITS;
+        static constexpr size_t BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+        /**
+         * @brief Adds one value.
+         */
+        inline void record(uint64_t ns) {
+            bump(buckets_[bucketOf(ns)], 1);
+            bump(count_, 1);
+            bump(total_, ns);
+            if (ns < min_.load(std::memory_order_relaxed)) min_.store(ns, std::memory_order_relaxed);
+            if (ns > max_.load(std::memory_order_relaxed)) max_.store(ns, std::memory_order_relaxed);
+        }
+
+        inline uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Returns the value below or at which p percent of the recorded values fall, or 0 if empty.
+         * @param p Percentile in [0, 100].
+         */
+        uint64_t percentile(double p) const;
+
+        LatencySummary_t summary() const;
+        void reset();
+
+        /// Bucket a value is counted in.
+        static size_t bucketOf(uint64_t ns);
+        /// Largest value counted in a bucket.
+        static uint64_t bucketHigh(size_t bucket);
+
+    private:
+        static inline void bump(std::atomic<uint64_t>& counter, uint64_t by) {
+            counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+        }
+
+        std::atomic<uint64_t> buckets_[BUCKETS] = {};
+        std::atomic<uint64_t> count_{ 0 };
+        std::atomic<uint64_t> total_{ 0 };
+        std::atomic<uint64_t> min_{ UINT64_MAX };
+        std::atomic<uint64_t> max_{ 0 };
+    };
+
+    constexpr size_t EVENT_TYPE_COUNT = static_cast<size_t>(DebugEventType::UNKNOWN_EVENT) + 1;
+
+    /**
+     * @enum MetricCallback
+     * @brief User callbacks the loop times (the *Event overloads count as their plain callback).
+     */
+    enum class MetricCallback : uint8_t {
+        START,               ///< onStartEvent / onStart.
+        END,                 ///< onEnd.
+        THREAD_CREATE,       ///< onThreadCreate.
+        THREAD_EXIT,         ///< onThreadExit.
+        DLL_LOAD,            ///< onDLLLoadEvent / onDLLLoad.
+        DLL_UNLOAD,          ///< onDLLUnloadEvent / onDLLUnload.
+        BREAKPOINT,          ///< onBreakpoint (software breakpoints and SINGLE_STEP actions).
+        HARDWARE_BREAKPOINT, ///< onHardwareBreakpoint.
+        EXCEPTION,           ///< onExceptionEvent / onAccessViolation / onUnknownException.
+        DEBUG_STRING,        ///< onDebugStringEvent / onDebugString.
+        RIP_ERROR,           ///< onRIPError.
+        UNKNOWN,             ///< onUnknownDebugEvent.
+        COUNT
+    };
+
+    constexpr size_t METRIC_CALLBACK_COUNT = static_cast<size_t>(MetricCallback::COUNT);
+
+    /**
+     * @brief Returns the name of a debug event type ("load_dll", ...).
+     */
+    const char* eventTypeName(DebugEventType type);
+
+    /**
+     * @brief Returns the name of a timed callback ("onBreakpoint", ...).
+     */
+    const char* metricCallbackName(MetricCallback callback);
+
+    /**
+     * @struct MetricsSnapshot_t
+     * @brief Copy of the session metrics at one point in time.
+     */
+    struct MetricsSnapshot_t {
+        double seconds = 0;                                ///< Time since the metrics were enabled or reset.
+        LatencySummary_t stopped[EVENT_TYPE_COUNT];        ///< Event received until continued, per DebugEventType.
+        LatencySummary_t callbacks[METRIC_CALLBACK_COUNT]; ///< Time inside each user callback.
+        RemoteCallStats_t remote;                          ///< Target primitives the session called.
+
+        inline uint64_t eventsOf(DebugEventType type) const { return stopped[static_cast<size_t>(type)].count; }
+        inline const LatencySummary_t& stoppedOf(DebugEventType type) const { return stopped[static_cast<size_t>(type)]; }
+        inline const LatencySummary_t& callbackOf(MetricCallback callback) const { return callbacks[static_cast<size_t>(callback)]; }
+    };
+
+    /**
+     * @class SessionMetrics
+     * @brief Histograms and counters of one debugging session.
+     *
+     * The debug loop records how long each event kept the target stopped and how long each callback ran;
+     * the backend adds every remote primitive to remote(). Only allocated while metrics are enabled.
+     */
+    class SessionMetrics {
+    public:
+        SessionMetrics();
+
+        inline LatencyHistogram& stopped(DebugEventType type) { return stopped_[static_cast<size_t>(type)]; }
+        inline LatencyHistogram& callback(MetricCallback callback) { return callbacks_[static_cast<size_t>(callback)]; }
+        inline RemoteCounters_t& remote() { return remote_; }
+
+        MetricsSnapshot_t snapshot() const;
+        void reset();
+
+    private:
+        LatencyHistogram stopped_[EVENT_TYPE_COUNT];
+        LatencyHistogram callbacks_[METRIC_CALLBACK_COUNT];
+        RemoteCounters_t remote_;
+        std::atomic<uint64_t> since_;
+    };
+
+    /**
+     * @brief Formats a snapshot as a table: events, callbacks (microseconds) and remote calls. Rows without
+     * any count are left out.
+     */
+    std::string formatMetrics(const MetricsSnapshot_t& snapshot);
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,352 @@
+#include "signatureSet.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+
+namespace RoboDBG {
+
+namespace {
+    constexpr char FILE_MAGIC[8] = { 'R', 'D', 'B', 'G', 'S', 'I', 'G', '\0' };
+    constexpr uint32_t FILE_VERSION = 1;
+
+    constexpr uint32_t NONE = UINT32_MAX; // missing trie edge while building
+
+    // Low bits of a DFA entry, recomputed by finish()
+    constexpr uint32_t HAS_OUTPUT = 1;    // the target state ends an anchor
+    constexpr uint32_t SHALLOW    = 2;    // the target state is one byte deep
+    constexpr uint32_t FLAGS      = 0xFF;
+
+    void put32(std::vector<char>& out, uint32_t v) {
+        const char b[4] = { static_cast<char>(v), static_cast<char>(v >> 8), static_cast<char>(v >> 16), static_cast<char>(v >> 24) };
+        out.insert(out.end(), b, b + 4);
+    }
+
+    // Bounds-checked cursor over a loaded file
+    struct Reader_t {
+        const std::vector<char>& data;
+        size_t at = 0;
+
+        bool get32(uint32_t& v) {
+            if (data.size() - at < 4) return false;
+            const auto* p = reinterpret_cast<const unsigned char*>(data.data() + at);
+            v = p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+            at += 4;
+            return true;
+        }
+
+        bool getBytes(void* out, size_t n) {
+            if (data.size() - at < n) return false;
+            std::memcpy(out, data.data() + at, n);
+            at += n;
+            return true;
+        }
+    };
+}
+
+// ===========================
+// BUILDING
+// ===========================
+
+SignatureSet::Anchor_t SignatureSet::pickAnchor(const BytePattern_t& pattern) {
+    // Window of fully fixed bytes, at most MAX_ANCHOR long. The scan skips positions by the first two bytes
+    // of the anchors, so rare leading bytes matter most; then longer anchors verify fewer false hits.
+    Anchor_t best;
+    int bestScore = INT_MAX;
+    for (size_t i = 0; i < pattern.size(); ) {
+        if (pattern.mask[i] != 0xFF) { ++i; continue; }
+        size_t run = i;
+        while (run < pattern.size() && pattern.mask[run] == 0xFF) ++run;
+        for (size_t start = i; start < run; ++start) {
+            const size_t width = std::min(run - start, MAX_ANCHOR);
+            const int lead = byteFrequency(pattern.value[start]) + (width > 1 ? byteFrequency(pattern.value[start + 1]) : 1000);
+            const int score = lead * 16 - static_cast<int>(width);
+            if (score < bestScore) {
+                best = Anchor_t{ static_cast<uint32_t>(start), static_cast<uint32_t>(width) };
+                bestScore = score;
+            }
+        }
+        i = run;
+    }
+    return best;
+}
+
+int SignatureSet::add(const BytePattern_t& pattern, std::string name) {
+    if (pattern.empty() || pattern.mask.size() != pattern.value.size()) return -1;
+    patterns_.push_back(pattern);
+    names_.push_back(std::move(name));
+    compiled_ = false;
+    return static_cast<int>(patterns_.size() - 1);
+}
+
+int SignatureSet::add(std::string_view signature, std::string name) {
+    BytePattern_t pattern;
+    if (!BytePattern_t::parse(signature, pattern)) return -1;
+    return add(pattern, name.empty() ? std::string(signature) : std::move(name));
+}
+
+void SignatureSet::compile() {
+    anchors_.clear();
+    for (const BytePattern_t& p : patterns_) anchors_.push_back(pickAnchor(p));
+
+    // Trie of the anchors; state indices for now
+    next_.assign(256, NONE);
+    std::vector<std::vector<uint32_t>> out(1);
+    for (uint32_t id = 0; id < patterns_.size(); ++id) {
+        const Anchor_t& a = anchors_[id];
+        if (!a.length) continue;
+        uint32_t s = 0;
+        for (uint32_t k = 0; k < a.length; ++k) {
+            const size_t edge = size_t(s) * 256 + patterns_[id].value[a.offset + k];
+            if (next_[edge] == NONE) {
+                next_[edge] = static_cast<uint32_t>(out.size());
+                out.emplace_back();
+                next_.resize(next_.size() + 256, NONE);
+            }
+            s = next_[edge];
+        }
+        out[s].push_back(id);
+    }
+
+    // Failure links in BFS order turn the trie into a DFA; each state also reports its suffixes' anchors
+    const size_t states = out.size();
+    std::vector<uint32_t> fail(states, 0);
+    std::deque<uint32_t> queue;
+    for (size_t c = 0; c < 256; ++c) {
+        if (next_[c] == NONE) next_[c] = 0;
+        else queue.push_back(next_[c]);
+    }
+    while (!queue.empty()) {
+        const uint32_t s = queue.front();
+        queue.pop_front();
+        out[s].insert(out[s].end(), out[fail[s]].begin(), out[fail[s]].end());
+        for (size_t c = 0; c < 256; ++c) {
+            uint32_t& t = next_[size_t(s) * 256 + c];
+            const uint32_t viaFail = next_[size_t(fail[s]) * 256 + c];
+            if (t == NONE) {
+                t = viaFail;
+            } else {
+                fail[t] = viaFail;
+                queue.push_back(t);
+            }
+        }
+    }
+
+    outStart_.assign(states, 0);
+    outCount_.assign(states, 0);
+    outputs_.clear();
+    for (size_t s = 0; s < states; ++s) {
+        outStart_[s] = static_cast<uint32_t>(outputs_.size());
+        outCount_[s] = static_cast<uint32_t>(out[s].size());
+        outputs_.insert(outputs_.end(), out[s].begin(), out[s].end());
+    }
+    for (uint32_t& e : next_) e <<= 8;
+
+    finish();
+}
+
+void SignatureSet::finish() {
+    const size_t states = next_.size() / 256;
+
+    // Trie depth is the BFS distance from the start state
+    std::vector<uint8_t> depth(states, 0xFF);
+    std::deque<uint32_t> queue{ 0 };
+    depth[0] = 0;
+    while (!queue.empty()) {
+        const uint32_t s = queue.front();
+        queue.pop_front();
+        for (size_t c = 0; c < 256; ++c) {
+            const uint32_t t = next_[size_t(s) * 256 + c] >> 8;
+            if (depth[t] == 0xFF) {
+                depth[t] = static_cast<uint8_t>(depth[s] + 1);
+                queue.push_back(t);
+            }
+        }
+    }
+    for (uint32_t& e : next_) {
+        const uint32_t t = e >> 8;
+        e = (t << 8) | (outCount_[t] ? HAS_OUTPUT : 0) | (depth[t] == 1 ? SHALLOW : 0);
+    }
+
+    // Byte pairs an anchor can start with; a one-byte anchor allows any second byte
+    std::fill(std::begin(startPair_), std::end(startPair_), 0);
+    for (size_t a = 0; a < 256; ++a) {
+        const uint32_t t = next_[a] >> 8;
+        if (!t) continue;
+        for (size_t b = 0; b < 256; ++b) {
+            if (outCount_[t] || depth[next_[size_t(t) * 256 + b] >> 8] == 2) {
+                const size_t pair = a | (b << 8);
+                startPair_[pair >> 6] |= uint64_t(1) << (pair & 63);
+            }
+        }
+    }
+
+    loose_.clear();
+    looseIds_.clear();
+    maxLength_ = 0;
+    for (uint32_t id = 0; id < patterns_.size(); ++id) {
+        maxLength_ = std::max(maxLength_, patterns_[id].size());
+        if (anchors_[id].length) continue;
+        loose_.emplace_back(patterns_[id]);
+        looseIds_.push_back(id);
+    }
+    compiled_ = true;
+}
+
+// ===========================
+// SCANNING
+// ===========================
+
+bool SignatureSet::matchesAt(uint32_t id, const BYTE* p) const {
+    const BytePattern_t& pattern = patterns_[id];
+    for (size_t k = 0; k < pattern.size(); ++k) {
+        if ((p[k] & pattern.mask[k]) != pattern.value[k]) return false;
+    }
+    return true;
+}
+
+size_t SignatureSet::scan(const BYTE* data, size_t size, uintptr_t base, std::vector<SignatureMatch_t>& matches, size_t limit) const {
+    if (!compiled_) return 0;
+    const size_t before = matches.size();
+    const uint32_t* next = next_.data();
+
+    // Little-endian byte pair at data + i, as indexed in startPair_
+    auto startsAnchor = [&](size_t i) {
+        const size_t pair = data[i] | (size_t(data[i + 1]) << 8);
+        return (startPair_[pair >> 6] >> (pair & 63)) & 1;
+    };
+
+    uint32_t s = 0;
+    for (size_t i = 0; i < size; ++i) {
+        // In the start state only positions whose byte pair begins an anchor need the DFA
+        if (s == 0) {
+            while (i + 1 < size && !startsAnchor(i)) ++i;
+        }
+        const uint32_t e = next[s + data[i]];
+        s = e & ~FLAGS;
+
+        if (e & HAS_OUTPUT) {
+            // An anchor ends at i: check where each signature using it would start
+            const uint32_t state = s >> 8;
+            for (uint32_t k = 0; k < outCount_[state]; ++k) {
+                const uint32_t id = outputs_[outStart_[state] + k];
+                const size_t lead = anchors_[id].offset + anchors_[id].length;
+                if (i + 1 < lead) continue;
+                const size_t start = i + 1 - lead;
+                if (start >= limit || start + patterns_[id].size() > size) continue;
+                if (matchesAt(id, data + start)) matches.push_back(SignatureMatch_t{ id, base + start });
+            }
+        }
+
+        // One byte deep: the only anchor in progress starts at i, and the pair rules it out
+        if ((e & SHALLOW) && i + 1 < size && !startsAnchor(i)) s = 0;
+    }
+
+    std::vector<uintptr_t> hits;
+    for (size_t k = 0; k < loose_.size(); ++k) {
+        hits.clear();
+        loose_[k].scan(data, size, base, hits);
+        for (uintptr_t address : hits) {
+            if (address - base < limit) matches.push_back(SignatureMatch_t{ looseIds_[k], address });
+        }
+    }
+
+    std::sort(matches.begin() + before, matches.end());
+    return matches.size() - before;
+}
+
+// ===========================
+// SERIALIZATION
+// ===========================
+
+bool SignatureSet::save(const std::string& path) const {
+    if (!compiled_) return false;
+
+    std::vector<char> out(FILE_MAGIC, FILE_MAGIC + sizeof(FILE_MAGIC));
+    put32(out, FILE_VERSION);
+    put32(out, static_cast<uint32_t>(patterns_.size()));
+    put32(out, static_cast<uint32_t>(states()));
+    put32(out, static_cast<uint32_t>(outputs_.size()));
+    for (size_t id = 0; id < patterns_.size(); ++id) {
+        const BytePattern_t& p = patterns_[id];
+        put32(out, static_cast<uint32_t>(p.size()));
+        out.insert(out.end(), p.value.begin(), p.value.end());
+        out.insert(out.end(), p.mask.begin(), p.mask.end());
+        put32(out, anchors_[id].offset);
+        put32(out, anchors_[id].length);
+        put32(out, static_cast<uint32_t>(names_[id].size()));
+        out.insert(out.end(), names_[id].begin(), names_[id].end());
+    }
+    for (uint32_t e : next_) put32(out, e);
+    for (size_t s = 0; s < states(); ++s) {
+        put32(out, outStart_[s]);
+        put32(out, outCount_[s]);
+    }
+    for (uint32_t id : outputs_) put32(out, id);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+bool SignatureSet::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Reader_t in{ data };
+    char magic[sizeof(FILE_MAGIC)];
+    uint32_t version = 0, count = 0, states = 0, outputs = 0;
+    if (!in.getBytes(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) return false;
+    if (!in.get32(version) || version != FILE_VERSION) return false;
+    if (!in.get32(count) || !in.get32(states) || !in.get32(outputs)) return false;
+    // Every count is backed by at least 4 bytes of file, so bogus counts fail before allocating
+    if (states == 0 || states > (UINT32_MAX >> 8) || (data.size() - in.at) / 4 < size_t(states) * 258 + outputs + count) return false;
+
+    SignatureSet set;
+    for (uint32_t id = 0; id < count; ++id) {
+        uint32_t length = 0, nameLength = 0;
+        BytePattern_t p;
+        Anchor_t a;
+        if (!in.get32(length) || length == 0 || length > data.size()) return false;
+        p.value.resize(length);
+        p.mask.resize(length);
+        if (!in.getBytes(p.value.data(), length) || !in.getBytes(p.mask.data(), length)) return false;
+        if (!in.get32(a.offset) || !in.get32(a.length) || a.length > MAX_ANCHOR) return false;
+        if (a.offset > length || a.length > length - a.offset) return false; // no uint32_t wrap-around
+        for (uint32_t k = 0; k < a.length; ++k) {
+            if (p.mask[a.offset + k] != 0xFF) return false;
+        }
+        if (!in.get32(nameLength) || nameLength > data.size()) return false;
+        std::string name(nameLength, '\0');
+        if (!in.getBytes(name.data(), nameLength)) return false;
+        set.patterns_.push_back(std::move(p));
+        set.names_.push_back(std::move(name));
+        set.anchors_.push_back(a);
+    }
+
+    set.next_.resize(size_t(states) * 256);
+    set.outStart_.resize(states);
+    set.outCount_.resize(states);
+    set.outputs_.resize(outputs);
+    for (uint32_t& e : set.next_) {
+        if (!in.get32(e) || (e >> 8) >= states) return false;
+    }
+    for (uint32_t s = 0; s < states; ++s) {
+        if (!in.get32(set.outStart_[s]) || !in.get32(set.outCount_[s])) return false;
+        if (set.outStart_[s] > outputs || set.outCount_[s] > outputs - set.outStart_[s]) return false;
+    }
+    for (uint32_t& id : set.outputs_) {
+        if (!in.get32(id) || id >= count || !set.anchors_[id].length) return false;
+    }
+    if (in.at != data.size()) return false;
+
+    set.finish();
+    *this = std::move(set);
+    return true;
+}
+
+} // namespace RoboDBG
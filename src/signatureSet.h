@@ -0,0 +1,162 @@
+/**
+ * @file signatureSet.h
+ * @brief Many wildcard signatures matched in one pass (Aho-Corasick over fixed anchors)
+ * @author Milkshake
+ */
+
+#ifndef SIGNATURESET_H
+#define SIGNATURESET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "platform.h"
+#include "patternScanner.h"
+
+namespace RoboDBG {
+
+    /**
+     * @struct SignatureMatch_t
+     * @brief One hit of a SignatureSet. Ordered by address, then signature id.
+     */
+    struct SignatureMatch_t {
+        uint32_t id = 0;       ///< Signature id returned by SignatureSet::add().
+        uintptr_t address = 0; ///< Start of the match.
+
+        bool operator==(const SignatureMatch_t& o) const { return id == o.id && address == o.address; }
+        bool operator<(const SignatureMatch_t& o) const { return address != o.address ? address < o.address : id < o.id; }
+    };
+
+    /**
+     * @class SignatureSet
+     * @brief Compiles many BytePattern_t into one automaton that finds all of them in a single pass.
+     *
+     * Every signature contributes its anchor: the run of up to 8 fully fixed bytes with the rarest bytes
+     * (see byteFrequency()). The anchors form an Aho-Corasick automaton stored as a dense DFA, so the scan
+     * costs one table lookup per byte however many signatures there are. In the start state, positions whose
+     * byte pair begins no anchor are skipped with an 8 KB bit set lookup instead. Every anchor hit is verified against the whole signature with its mask.
+     * Signatures without a fully fixed byte (only nibble wildcards) are scanned with a PatternScanner each.
+     *
+     * The compiled set is saved to and loaded from a binary file so large sets need not be rebuilt.
+     */
+    class SignatureSet {
+    public:
+        static constexpr size_t MAX_ANCHOR = 8; ///< Longest anchor taken from a signature.
+
+        /**
+         * @brief Adds a signature. Invalidates the compiled automaton.
+         * @param pattern Pattern; must not be empty.
+         * @param name Optional name reported by name().
+         * @return The signature id (ids count up from 0), or -1 if the pattern is empty.
+         */
+        int add(const BytePattern_t& pattern, std::string name = {});
+
+        /**
+         * @brief Parses and adds an IDA-style signature (see BytePattern_t::parse()).
+         * @param signature Signature text.
+         * @param name Optional name; defaults to the signature text.
+         * @return The signature id, or -1 if the signature is malformed.
+         */
+        int add(std::string_view signature, std::string name = {});
+
+        /**
+         * @brief Builds the automaton. Needed after add() and before scan() / save().
+         */
+        void compile();
+
+        /**
+         * @brief Appends every match in data to matches, sorted by address and id.
+         *
+         * Matches overlapping the end of the buffer are not reported. Callers scanning in chunks overlap them
+         * by maxLength() - 1 bytes and pass where the next chunk starts as limit, so each match is reported
+         * by the chunk it starts in and the results of consecutive chunks stay sorted.
+         *
+         * @param data Buffer.
+         * @param size Buffer size.
+         * @param base Address of data[0] in the target.
+         * @param matches Receives the matches.
+         * @param limit Only matches starting before data + limit are reported.
+         * @return Number of matches appended; 0 if the set is not compiled.
+         */
+        size_t scan(const BYTE* data, size_t size, uintptr_t base, std::vector<SignatureMatch_t>& matches, size_t limit = SIZE_MAX) const;
+
+        /**
+         * @brief Writes the compiled set (signatures, names and automaton) to a file.
+         * @param path Output file.
+         * @return false if the set is not compiled or the file cannot be written.
+         */
+        bool save(const std::string& path) const;
+
+        /**
+         * @brief Replaces the set with one written by save().
+         * @param path Input file.
+         * @return false if the file cannot be read or is not a valid set; the set is left unchanged then.
+         */
+        bool load(const std::string& path);
+
+        /**
+         * @brief Returns the number of signatures.
+         */
+        inline size_t size() const { return patterns_.size(); }
+
+        /**
+         * @brief Returns true if scan() is up to date with every add().
+         */
+        inline bool compiled() const { return compiled_; }
+
+        /**
+         * @brief Returns the length of the longest signature.
+         */
+        inline size_t maxLength() const { return maxLength_; }
+
+        /**
+         * @brief Returns the number of automaton states.
+         */
+        inline size_t states() const { return compiled_ ? next_.size() / 256 : 0; }
+
+        /**
+         * @brief Returns a signature by id.
+         * @param id Id from add().
+         */
+        inline const BytePattern_t& pattern(uint32_t id) const { return patterns_[id]; }
+
+        /**
+         * @brief Returns the name of a signature.
+         * @param id Id from add().
+         */
+        inline const std::string& name(uint32_t id) const { return names_[id]; }
+
+    private:
+        struct Anchor_t {
+            uint32_t offset = 0; ///< Position of the anchor in the signature.
+            uint32_t length = 0; ///< 0 if the signature has no fully fixed byte.
+        };
+
+        static Anchor_t pickAnchor(const BytePattern_t& pattern);
+        bool matchesAt(uint32_t id, const BYTE* p) const;
+        void finish();
+
+        std::vector<BytePattern_t> patterns_;
+        std::vector<std::string> names_;
+        std::vector<Anchor_t> anchors_;
+        size_t maxLength_ = 0;
+        bool compiled_ = false;
+
+        // Dense DFA; entries are the target state times 256 (plus flags in the low byte) so a step is next_[state + byte]
+        std::vector<uint32_t> next_;
+        std::vector<uint32_t> outStart_; ///< First entry in outputs_ per state.
+        std::vector<uint32_t> outCount_; ///< Signatures whose anchor ends in the state (0 for most).
+        std::vector<uint32_t> outputs_;  ///< Signature ids.
+
+        // Rebuilt from the above by compile() and load()
+        uint64_t startPair_[65536 / 64] = {}; ///< Bit set of byte pairs (first | second << 8) an anchor starts with.
+        std::vector<PatternScanner> loose_;  ///< Signatures without an anchor.
+        std::vector<uint32_t> looseIds_;
+    };
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,215 @@
+#include "stringScanner.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define STRING_SCANNER_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+namespace RoboDBG {
+
+namespace {
+    constexpr size_t NONE = SIZE_MAX;
+    constexpr SIZE_T PAGE = 0x1000;
+    constexpr SIZE_T FIRST_READ = 64;
+
+    constexpr std::array<bool, 256> PRINTABLE = [] {
+        std::array<bool, 256> t{};
+        for (int c = 0x20; c <= 0x7E; ++c) t[c] = true;
+        t['\t'] = true;
+        return t;
+    }();
+
+    struct Masks_t {
+        uint64_t printable = 0; ///< Bit j: byte j is printable.
+        uint64_t zero = 0;      ///< Bit j: byte j is 0.
+    };
+
+    // n <= 64 bytes; bits past n stay clear
+    Masks_t masks(const BYTE* p, size_t n) {
+        Masks_t m;
+#ifdef STRING_SCANNER_SSE2
+        if (n == 64) {
+            const __m128i low = _mm_set1_epi8(0x20), span = _mm_set1_epi8(0x7E - 0x20);
+            const __m128i tab = _mm_set1_epi8('\t'), nul = _mm_setzero_si128();
+            for (int k = 0; k < 4; ++k) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k));
+                const __m128i d = _mm_sub_epi8(v, low); // 0x20..0x7E -> 0..0x5E, everything else above
+                const __m128i printable = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(d, span), d), _mm_cmpeq_epi8(v, tab));
+                m.printable |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(printable))) << (16 * k);
+                m.zero |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, nul)))) << (16 * k);
+            }
+            return m;
+        }
+#endif
+        for (size_t j = 0; j < n; ++j) {
+            m.printable |= static_cast<uint64_t>(PRINTABLE[p[j]]) << j;
+            m.zero |= static_cast<uint64_t>(p[j] == 0) << j;
+        }
+        return m;
+    }
+
+    // Runs of set bits across consecutive 64-bit words
+    struct RunTracker_t {
+        size_t start = NONE;
+
+        template<typename Emit>
+        void feed(uint64_t bits, size_t at, Emit&& emit) {
+            unsigned bit = 0;
+            while (bit < 64) {
+                if (start == NONE) {
+                    const uint64_t rest = bits >> bit;
+                    if (!rest) return;
+                    bit += static_cast<unsigned>(std::countr_zero(rest));
+                    start = at + bit;
+                }
+                const uint64_t rest = ~bits >> bit;
+                if (!rest) return; // runs on into the next word
+                bit += static_cast<unsigned>(std::countr_zero(rest));
+                emit(start, at + bit);
+                start = NONE;
+            }
+        }
+
+        template<typename Emit>
+        void finish(size_t end, Emit&& emit) {
+            if (start != NONE) emit(start, end);
+            start = NONE;
+        }
+    };
+}
+
+StringScanner::StringScanner(StringScanOptions_t options)
+    : options_(options) {
+    options_.minLength = std::max<size_t>(1, options.minLength);
+    options_.maxLength = std::max(options_.minLength, options.maxLength);
+}
+
+SIZE_T StringScanner::overlap() const {
+    return options_.maxLength * (options_.utf16 ? 2 : 1);
+}
+
+size_t StringScanner::scan(const BYTE* data, size_t size, uintptr_t base, std::vector<StringHit_t>& out,
+                           size_t first, size_t limit) const {
+    const size_t before = out.size();
+    limit = std::min(limit, size);
+
+    auto emit = [&](StringEncoding encoding, size_t start, size_t end) {
+        const size_t width = encoding == StringEncoding::UTF16 ? 2 : 1;
+        const size_t length = (end - start) / width;
+        if (start < first || start >= limit || length < options_.minLength) return;
+        StringHit_t hit{ base + start, encoding, {} };
+        hit.text.resize(std::min(length, options_.maxLength));
+        for (size_t k = 0; k < hit.text.size(); ++k) hit.text[k] = static_cast<char>(data[start + k * width]);
+        out.push_back(std::move(hit));
+    };
+
+    // A UTF-16 character is a printable byte at an even address and a zero byte after it
+    const uint64_t even = (base & 1) ? 0xAAAAAAAAAAAAAAAAULL : 0x5555555555555555ULL;
+    RunTracker_t ascii, wide;
+    uint64_t carry = 0; // high byte of a character that started at bit 63 of the previous block
+    for (size_t at = 0; at < size; at += 64) {
+        const size_t n = std::min<size_t>(64, size - at);
+        const Masks_t m = masks(data + at, n);
+        if (options_.ascii) {
+            ascii.feed(m.printable, at, [&](size_t s, size_t e) { emit(StringEncoding::ASCII, s, e); });
+        }
+        if (options_.utf16) {
+            const uint64_t nextZero = at + 64 < size && data[at + 64] == 0 ? 1 : 0;
+            const uint64_t chars = m.printable & ((m.zero >> 1) | (nextZero << 63)) & even;
+            wide.feed(chars | (chars << 1) | carry, at, [&](size_t s, size_t e) { emit(StringEncoding::UTF16, s, e); });
+            carry = chars >> 63;
+        }
+    }
+    ascii.finish(size, [&](size_t s, size_t e) { emit(StringEncoding::ASCII, s, e); });
+    wide.finish(size, [&](size_t s, size_t e) { emit(StringEncoding::UTF16, s, e); });
+
+    std::stable_sort(out.begin() + static_cast<std::ptrdiff_t>(before), out.end(),
+                     [](const StringHit_t& a, const StringHit_t& b) { return a.address < b.address; });
+    return out.size() - before;
+}
+
+// ===========================
+// ZERO-TERMINATED READS
+// ===========================
+
+size_t findTerminator(const BYTE* data, size_t size, size_t charSize) {
+    size_t at = 0;
+#ifdef STRING_SCANNER_SSE2
+    const __m128i nul = _mm_setzero_si128();
+    for (; at + 16 <= size; at += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + at));
+        const int hits = _mm_movemask_epi8(charSize == 2 ? _mm_cmpeq_epi16(v, nul) : _mm_cmpeq_epi8(v, nul));
+        if (hits) return at + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(hits)));
+    }
+#endif
+    if (charSize == 2) {
+        for (; at + 2 <= size; at += 2) {
+            if (data[at] == 0 && data[at + 1] == 0) return at;
+        }
+        return size;
+    }
+    const void* hit = std::memchr(data + at, 0, size - at);
+    return hit ? static_cast<size_t>(static_cast<const BYTE*>(hit) - data) : size;
+}
+
+std::string readTerminated(const std::function<bool(uintptr_t, void*, SIZE_T)>& read,
+                           uintptr_t address, SIZE_T maxBytes, size_t charSize) {
+    std::string out;
+    BYTE buffer[PAGE];
+    SIZE_T want = FIRST_READ;
+    while (out.size() < maxBytes) {
+        const uintptr_t at = address + out.size();
+        const SIZE_T toPage = PAGE - (at & (PAGE - 1));
+        const SIZE_T left = maxBytes - out.size();
+        SIZE_T size = std::min({ want, toPage, left });
+        if (charSize == 2) {
+            // Whole characters; one that straddles the page boundary is read across it
+            size = size < 2 ? std::min<SIZE_T>(2, left) : size & ~SIZE_T(1);
+        }
+        if (!read(at, buffer, size)) break;
+
+        const size_t end = findTerminator(buffer, size, charSize);
+        out.append(reinterpret_cast<const char*>(buffer), end);
+        if (end < size) break;
+        want = std::min<SIZE_T>(want * 2, PAGE);
+    }
+    if (charSize == 2) out.resize(out.size() & ~size_t(1));
+    return out;
+}
+
+std::string toUtf8(std::u16string_view text) {
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        uint32_t c = text[i];
+        if (c >= 0xD800 && c <= 0xDBFF && i + 1 < text.size() && text[i + 1] >= 0xDC00 && text[i + 1] <= 0xDFFF) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (text[++i] - 0xDC00);
+        } else if (c >= 0xD800 && c <= 0xDFFF) {
+            c = 0xFFFD;
+        }
+
+        if (c < 0x80) {
+            out.push_back(static_cast<char>(c));
+        } else if (c < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (c >> 6)));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else if (c < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (c >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (c >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        }
+    }
+    return out;
+}
+
+} // namespace RoboDBG
@@ -0,0 +1,131 @@
+/**
+ * @file stringScanner.h
+ * @brief Zero-terminated string reads and strings(1)-style extraction of ASCII / UTF-16 text
+ * @author Milkshake
+ */
+
+#ifndef STRINGSCANNER_H
+#define STRINGSCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "platform.h"
+
+namespace RoboDBG {
+
+    constexpr SIZE_T DEFAULT_STRING_LENGTH = 0x1000; ///< Default character limit of zero-terminated reads.
+
+    /**
+     * @enum StringEncoding
+     * @brief Width of the characters of a string.
+     */
+    enum class StringEncoding : uint8_t {
+        ASCII, ///< One byte per character.
+        UTF16  ///< Two bytes per character, little endian.
+    };
+
+    /**
+     * @struct StringScanOptions_t
+     * @brief What a StringScanner reports.
+     */
+    struct StringScanOptions_t {
+        size_t minLength = 4;    ///< Shortest string reported, in characters.
+        size_t maxLength = 1024; ///< Longer strings are cut to this many characters.
+        bool ascii = true;       ///< Report one-byte strings.
+        bool utf16 = true;       ///< Report UTF-16LE strings (printable ASCII characters, 2-byte aligned).
+    };
+
+    /**
+     * @struct StringHit_t
+     * @brief A string found in memory.
+     */
+    struct StringHit_t {
+        uintptr_t address = 0;   ///< Address of the first character.
+        StringEncoding encoding = StringEncoding::ASCII;
+        std::string text;        ///< Characters (printable ASCII, also for UTF16).
+    };
+
+    /**
+     * @class StringScanner
+     * @brief Finds runs of printable characters in plain buffers, 64 bytes per step.
+     *
+     * Printable is 0x20..0x7E and tab. Each 64-byte block is turned into a bit per byte (SSE2 on x86, a table
+     * elsewhere) and the runs are found with bit scans, so binary data is skipped a block at a time. A UTF-16
+     * character is a printable byte at an even address followed by a zero byte.
+     */
+    class StringScanner {
+    public:
+        /**
+         * @brief Creates a scanner.
+         * @param options Lengths and encodings; minLength is at least 1.
+         */
+        explicit StringScanner(StringScanOptions_t options = {});
+
+        /**
+         * @brief Appends the strings starting in [first, limit) of a buffer, in address order.
+         *
+         * Strings are ended by the end of the buffer; a run starting at offset 0 with first > 0 is taken as the
+         * tail of a string that started before the buffer and is skipped.
+         *
+         * @param data Buffer.
+         * @param size Bytes in the buffer.
+         * @param base Target address of data[0]; UTF-16 strings start at even addresses.
+         * @param out Receives the strings.
+         * @param first Smallest start offset reported.
+         * @param limit Start offsets at or past this are not reported.
+         * @return Number of strings appended.
+         */
+        size_t scan(const BYTE* data, size_t size, uintptr_t base, std::vector<StringHit_t>& out,
+                    size_t first = 0, size_t limit = SIZE_MAX) const;
+
+        /**
+         * @brief Returns the bytes a chunk must repeat from the previous one so no string is cut short of
+         * maxLength characters (maxLength, twice that with UTF-16).
+         *
+         * Scan every chunk but the first of a region from offset 1, and every chunk but the last up to
+         * requested - overlap() + 1: a string starting at the seam belongs to the earlier chunk.
+         */
+        SIZE_T overlap() const;
+
+        inline const StringScanOptions_t& options() const { return options_; }
+
+    private:
+        StringScanOptions_t options_;
+    };
+
+    /**
+     * @brief Returns the offset of the first zero character, or size if there is none. SSE2 on x86.
+     * @param data Buffer.
+     * @param size Bytes in the buffer.
+     * @param charSize 1 (C string) or 2 (UTF-16); two-byte characters are aligned to data.
+     */
+    size_t findTerminator(const BYTE* data, size_t size, size_t charSize);
+
+    /**
+     * @brief Reads a zero-terminated string in chunks that never cross a page boundary.
+     *
+     * Chunks start at 64 bytes and double up to a page, so short strings cost one small read and an unreadable
+     * page behind a string does not fail the read of its last chunk.
+     *
+     * @param read Reads target memory; false if the range could not be read whole.
+     * @param address Address of the string.
+     * @param maxBytes Most bytes read, terminator excluded.
+     * @param charSize 1 or 2.
+     * @return The bytes before the terminator, maxBytes or the first unreadable page.
+     */
+    std::string readTerminated(const std::function<bool(uintptr_t, void*, SIZE_T)>& read,
+                               uintptr_t address, SIZE_T maxBytes, size_t charSize);
+
+    /**
+     * @brief Converts UTF-16 to UTF-8; unpaired surrogates become U+FFFD.
+     */
+    std::string toUtf8(std::u16string_view text);
+
+} // namespace RoboDBG
+
+#endif
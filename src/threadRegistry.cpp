@@ -0,0 +1,99 @@
+#include "threadRegistry.h"
+
+#include <algorithm>
+
+namespace RoboDBG {
+
+namespace {
+    constexpr size_t MIN_CAPACITY = 16;
+
+    unsigned log2(size_t v) {
+        unsigned bits = 0;
+        while ((size_t(1) << bits) < v) ++bits;
+        return bits;
+    }
+}
+
+ThreadRegistry::ThreadRegistry() {
+    rehash(MIN_CAPACITY);
+}
+
+void ThreadRegistry::rehash(size_t newCapacity) {
+    index_.assign(newCapacity, 0);
+    mask_  = newCapacity - 1;
+    shift_ = 64 - log2(newCapacity);
+
+    for (size_t e = 0; e < entries_.size(); ++e) {
+        size_t i = slotOf(entries_[e].threadId);
+        while (index_[i] != 0) i = (i + 1) & mask_;
+        index_[i] = static_cast<uint32_t>(e + 1);
+    }
+}
+
+size_t ThreadRegistry::slotOfEntry(size_t entry) const {
+    size_t i = slotOf(entries_[entry].threadId);
+    while (index_[i] != entry + 1) i = (i + 1) & mask_;
+    return i;
+}
+
+ThreadInfo_t& ThreadRegistry::insert(DWORD threadId) {
+    if (ThreadInfo_t* existing = find(threadId)) return *existing;
+
+    // Keep the index at most 3/4 full
+    if (entries_.size() + 1 > index_.size() - index_.size() / 4) {
+        entries_.reserve(index_.size() * 2);
+        rehash(index_.size() * 2);
+    }
+
+    size_t i = slotOf(threadId);
+    while (index_[i] != 0) i = (i + 1) & mask_;
+
+    ThreadInfo_t& entry = entries_.emplace_back();
+    entry.threadId = threadId;
+    index_[i] = static_cast<uint32_t>(entries_.size());
+    return entry;
+}
+
+bool ThreadRegistry::erase(DWORD threadId) {
+    ThreadInfo_t* entry = find(threadId);
+    if (!entry) return false;
+    const size_t position = static_cast<size_t>(entry - entries_.data());
+
+    // Backward-shift deletion in the index
+    size_t hole = slotOfEntry(position);
+    for (size_t i = (hole + 1) & mask_; index_[i] != 0; i = (i + 1) & mask_) {
+        const size_t home = slotOf(entries_[index_[i] - 1].threadId);
+        // Move if home is not cyclically within (hole, i]
+        const bool movable = (hole <= i) ? (home <= hole || home > i)
+                                         : (home <= hole && home > i);
+        if (movable) {
+            index_[hole] = index_[i];
+            hole = i;
+        }
+    }
+    index_[hole] = 0;
+
+    // Fill the gap in entries_ with the last entry
+    const size_t last = entries_.size() - 1;
+    if (position != last) {
+        index_[slotOfEntry(last)] = static_cast<uint32_t>(position + 1);
+        entries_[position] = entries_[last];
+    }
+    entries_.pop_back();
+    return true;
+}
+
+void ThreadRegistry::clear() {
+    entries_.clear();
+    std::fill(index_.begin(), index_.end(), 0);
+}
+
+std::vector<DWORD> ThreadRegistry::threadIds() const {
+    std::vector<DWORD> ids;
+    ids.reserve(entries_.size());
+    for (const ThreadInfo_t& entry : entries_) ids.push_back(entry.threadId);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+} // namespace RoboDBG
@@ -0,0 +1,148 @@
+/**
+ * @file threadRegistry.h
+ * @brief Table of the debuggee's threads keyed by thread ID
+ * @author Milkshake
+ */
+
+#ifndef THREADREGISTRY_H
+#define THREADREGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "platform.h"
+#include "backends/targetBackend.h"
+#include "debugRegisters.h"
+
+namespace RoboDBG {
+
+    /**
+     * @enum ThreadStatus
+     * @brief What a registered thread is doing from the debugger's point of view.
+     */
+    enum class ThreadStatus : uint8_t {
+        RUNNING, ///< Runs (or is stopped by another thread's debug event).
+        STOPPED  ///< Raised the exception that is currently being handled.
+    };
+
+    /**
+     * @struct ThreadInfo_t
+     * @brief One debuggee thread. The handle is owned by the Debugger and stays open until the thread exits.
+     */
+    struct ThreadInfo_t {
+        DWORD threadId = 0;         ///< Thread ID.
+        HANDLE hThread = nullptr;   ///< Handle from TargetBackend::openThread().
+        uintptr_t threadBase = 0;   ///< TEB / TLS base, 0 if unknown.
+        uintptr_t startAddress = 0; ///< Start address, 0 if unknown.
+        ThreadStatus status = ThreadStatus::RUNNING; ///< Current status.
+        DWORD contextParts = 0;     ///< ContextFlags of context that are valid for the current stop.
+        DWORD dirtyParts = 0;       ///< ContextFlags of context modified but not yet written to the thread.
+        ThreadContext_t context;    ///< Cached register file.
+        DebugRegisters_t debugRegisters; ///< DR0–DR3 / DR7 as last written by the debugger.
+    };
+
+/**
+ * @class ThreadRegistry
+ * @brief Hash map from thread ID to ThreadInfo_t.
+ *
+ * Entries are stored contiguously and looked up through an open-addressing index (linear probing,
+ * Fibonacci hashing, backward-shift deletion), so walking all threads is a linear scan and finding
+ * the thread of a debug event touches one index slot in the common case. Entry pointers and
+ * iterators are invalidated by insert() and erase(); erase() moves the last entry into the hole.
+ */
+class ThreadRegistry {
+public:
+    using iterator = std::vector<ThreadInfo_t>::iterator;
+    using const_iterator = std::vector<ThreadInfo_t>::const_iterator;
+
+    ThreadRegistry();
+
+    /**
+     * @brief Looks up a thread.
+     * @param threadId Thread ID.
+     * @return The entry, or nullptr if the thread is not registered.
+     */
+    inline ThreadInfo_t* find(DWORD threadId) {
+        if (entries_.empty()) return nullptr;
+        for (size_t i = slotOf(threadId);; i = (i + 1) & mask_) {
+            const uint32_t slot = index_[i];
+            if (slot == 0) return nullptr;
+            if (entries_[slot - 1].threadId == threadId) return &entries_[slot - 1];
+        }
+    }
+
+    /**
+     * @brief Looks up a thread.
+     * @param threadId Thread ID.
+     * @return The entry, or nullptr if the thread is not registered.
+     */
+    inline const ThreadInfo_t* find(DWORD threadId) const {
+        return const_cast<ThreadRegistry*>(this)->find(threadId);
+    }
+
+    /**
+     * @brief Checks if a thread is registered.
+     * @param threadId Thread ID.
+     * @return true if present; false otherwise.
+     */
+    inline bool contains(DWORD threadId) const { return find(threadId) != nullptr; }
+
+    /**
+     * @brief Registers a thread, or returns the existing entry.
+     * @param threadId Thread ID.
+     * @return The entry; a new one is default initialised apart from threadId.
+     */
+    ThreadInfo_t& insert(DWORD threadId);
+
+    /**
+     * @brief Removes a thread.
+     * @param threadId Thread ID.
+     * @return true if a thread was removed; false otherwise.
+     */
+    bool erase(DWORD threadId);
+
+    /**
+     * @brief Removes all threads.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of threads.
+     */
+    inline size_t size() const { return entries_.size(); }
+
+    /**
+     * @brief Returns true if no thread is registered.
+     */
+    inline bool empty() const { return entries_.empty(); }
+
+    /**
+     * @brief Returns the registered thread IDs in ascending order.
+     * @return Snapshot of the IDs.
+     */
+    std::vector<DWORD> threadIds() const;
+
+    inline iterator begin() { return entries_.begin(); }
+    inline iterator end() { return entries_.end(); }
+    inline const_iterator begin() const { return entries_.begin(); }
+    inline const_iterator end() const { return entries_.end(); }
+
+private:
+    inline size_t slotOf(DWORD threadId) const {
+        return static_cast<size_t>((static_cast<uint64_t>(threadId) * 0x9E3779B97F4A7C15ULL) >> shift_);
+    }
+
+    // Index slot that refers to entries_[entry]
+    size_t slotOfEntry(size_t entry) const;
+    void rehash(size_t newCapacity);
+
+    std::vector<ThreadInfo_t> entries_;
+    std::vector<uint32_t> index_; ///< entries_ position + 1; 0 marks an empty slot.
+    size_t mask_ = 0;
+    unsigned shift_ = 64;
+};
+
+} // namespace RoboDBG
+
+#endif
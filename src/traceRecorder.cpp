@@ -0,0 +1,370 @@
+#include "traceRecorder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+
+namespace RoboDBG {
+
+struct TraceRecorder::Block_t {
+    TraceEvent_t events[BLOCK_EVENTS];
+    std::atomic<uint32_t> count{ 0 }; ///< Spans written; published with release.
+    uint32_t thread = 0;              ///< Index of the thread that took the block.
+};
+
+// Each thread keeps its index and the block it writes to; a different recorder id means it needs new ones.
+// Both are handed back when the thread exits or moves on to another recorder.
+struct TraceRecorder::Local_t {
+    uint64_t recorder = 0;
+    uint32_t thread = 0;
+    Block_t* block = nullptr;
+
+    ~Local_t() {
+        if (recorder) handBack(recorder, thread, block);
+    }
+};
+
+namespace {
+    std::atomic<uint64_t> nextRecorderId{ 1 };
+
+    // Recorders that exist, by id, so exiting threads never touch a destroyed one
+    std::mutex& liveMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+    std::unordered_map<uint64_t, TraceRecorder*>& liveRecorders() {
+        static std::unordered_map<uint64_t, TraceRecorder*> recorders;
+        return recorders;
+    }
+
+    constexpr uint32_t PROCESS_ID = 1;
+    constexpr uint64_t PROCESS_TRACK = 1;
+    constexpr uint64_t THREAD_TRACKS = 100; ///< Track uuid of thread index i is THREAD_TRACKS + i.
+}
+
+const char* traceCategoryName(TraceCategory category) {
+    switch (category) {
+        case TraceCategory::LOOP:       return "loop";
+        case TraceCategory::DISPATCH:   return "dispatch";
+        case TraceCategory::CALLBACK:   return "callback";
+        case TraceCategory::REMOTE:     return "remote";
+        case TraceCategory::BREAKPOINT: return "breakpoint";
+        default:                        return "unknown";
+    }
+}
+
+thread_local TraceRecorder::Local_t TraceRecorder::local_;
+
+TraceRecorder::TraceRecorder(size_t maxEvents)
+    : id_(nextRecorderId.fetch_add(1)),
+      blockCount_(std::max<size_t>(1, (maxEvents + BLOCK_EVENTS - 1) / BLOCK_EVENTS)),
+      blocks_(std::make_unique<Block_t[]>(blockCount_)) {
+    std::lock_guard<std::mutex> lock(liveMutex());
+    liveRecorders()[id_] = this;
+}
+
+TraceRecorder::~TraceRecorder() {
+    std::lock_guard<std::mutex> lock(liveMutex());
+    liveRecorders().erase(id_);
+}
+
+void TraceRecorder::handBack(uint64_t id, uint32_t thread, Block_t* block) {
+    std::lock_guard<std::mutex> live(liveMutex());
+    auto it = liveRecorders().find(id);
+    if (it == liveRecorders().end()) return;
+    TraceRecorder& recorder = *it->second;
+    std::lock_guard<std::mutex> lock(recorder.freeMutex_);
+    recorder.freeSlots_.push_back(Slot_t{ thread, block });
+    recorder.freeCount_.store(recorder.freeSlots_.size(), std::memory_order_release);
+}
+
+void TraceRecorder::enter() {
+    if (local_.recorder == id_) return;
+    if (local_.recorder) handBack(local_.recorder, local_.thread, local_.block); // moving on from another recorder
+    local_.recorder = id_;
+    local_.block = nullptr;
+    if (freeCount_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(freeMutex_);
+        if (!freeSlots_.empty()) {
+            local_.thread = freeSlots_.back().thread;
+            local_.block = freeSlots_.back().block;
+            freeSlots_.pop_back();
+            freeCount_.store(freeSlots_.size(), std::memory_order_release);
+            // This thread continues the exited one's track, unnamed until it names it
+            if (local_.thread <= MAX_NAMED_THREADS) names_[local_.thread - 1].store(nullptr, std::memory_order_release);
+            return;
+        }
+    }
+    local_.thread = threads_.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+TraceRecorder::Block_t* TraceRecorder::block() {
+    enter();
+    Block_t* current = local_.block;
+    if (current && current->count.load(std::memory_order_relaxed) < BLOCK_EVENTS) return current;
+
+    // Full or none yet: take the next free block
+    if (nextBlock_.load(std::memory_order_relaxed) >= blockCount_) return nullptr;
+    const size_t index = nextBlock_.fetch_add(1, std::memory_order_relaxed);
+    if (index >= blockCount_) return nullptr;
+    Block_t* next = &blocks_[index];
+    next->thread = local_.thread; // published with the block's first span
+    local_.block = next;
+    return next;
+}
+
+void TraceRecorder::record(TraceCategory category, const char* name, uint64_t startNs, uint64_t endNs,
+                           const char* argName, uint64_t arg) {
+    Block_t* b = block();
+    if (!b) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const uint32_t n = b->count.load(std::memory_order_relaxed);
+    TraceEvent_t& event = b->events[n];
+    event.startNs = startNs;
+    event.durationNs = endNs > startNs ? endNs - startNs : 0;
+    event.name = name;
+    event.argName = argName;
+    event.arg = arg;
+    event.category = category;
+    b->count.store(n + 1, std::memory_order_release);
+}
+
+void TraceRecorder::nameThread(const char* name) {
+    enter();
+    if (local_.thread <= MAX_NAMED_THREADS) names_[local_.thread - 1].store(name, std::memory_order_release);
+}
+
+std::vector<TraceThread_t> TraceRecorder::collect() const {
+    std::map<uint32_t, TraceThread_t> threads;
+    const size_t used = std::min(nextBlock_.load(std::memory_order_acquire), blockCount_);
+    for (size_t i = 0; i < used; ++i) {
+        const Block_t& b = blocks_[i];
+        const uint32_t count = b.count.load(std::memory_order_acquire);
+        if (!count) continue;
+        TraceThread_t& thread = threads[b.thread];
+        thread.events.insert(thread.events.end(), b.events, b.events + count);
+    }
+
+    std::vector<TraceThread_t> out;
+    out.reserve(threads.size());
+    for (auto& [index, thread] : threads) {
+        thread.index = index;
+        const char* name = index <= MAX_NAMED_THREADS ? names_[index - 1].load(std::memory_order_acquire) : nullptr;
+        thread.name = name ? name : "thread " + std::to_string(index);
+        out.push_back(std::move(thread));
+    }
+    return out;
+}
+
+namespace {
+    uint64_t firstStart(const std::vector<TraceThread_t>& threads) {
+        uint64_t first = UINT64_MAX;
+        for (const TraceThread_t& t : threads) {
+            for (const TraceEvent_t& e : t.events) first = std::min(first, e.startNs);
+        }
+        return first == UINT64_MAX ? 0 : first;
+    }
+
+    void appendJsonString(std::string& out, const char* text) {
+        out += '"';
+        for (const char* p = text; *p; ++p) {
+            if (*p == '"' || *p == '\\') out += '\\';
+            if (static_cast<unsigned char>(*p) >= 0x20) out += *p;
+        }
+        out += '"';
+    }
+
+    // ===== Protobuf wire format =====
+
+    void putVarint(std::string& out, uint64_t v) {
+        while (v >= 0x80) {
+            out += static_cast<char>((v & 0x7F) | 0x80);
+            v >>= 7;
+        }
+        out += static_cast<char>(v);
+    }
+
+    void putUint(std::string& out, uint32_t field, uint64_t v) {
+        putVarint(out, uint64_t(field) << 3);
+        putVarint(out, v);
+    }
+
+    void putBytes(std::string& out, uint32_t field, const std::string& bytes) {
+        putVarint(out, (uint64_t(field) << 3) | 2);
+        putVarint(out, bytes.size());
+        out += bytes;
+    }
+
+    // Field numbers of perfetto/trace/trace_packet.proto and track_event/*.proto
+    namespace pb {
+        constexpr uint32_t TRACE_PACKET = 1;
+        constexpr uint32_t TIMESTAMP = 8;
+        constexpr uint32_t SEQUENCE_ID = 10;
+        constexpr uint32_t TRACK_EVENT = 11;
+        constexpr uint32_t SEQUENCE_FLAGS = 13;
+        constexpr uint32_t TRACK_DESCRIPTOR = 60;
+
+        constexpr uint32_t TRACK_UUID = 1;
+        constexpr uint32_t TRACK_NAME = 2;
+        constexpr uint32_t TRACK_PROCESS = 3;
+        constexpr uint32_t TRACK_THREAD = 4;
+        constexpr uint32_t TRACK_PARENT = 5;
+        constexpr uint32_t PROCESS_PID = 1;
+        constexpr uint32_t PROCESS_NAME = 6;
+        constexpr uint32_t THREAD_PID = 1;
+        constexpr uint32_t THREAD_TID = 2;
+        constexpr uint32_t THREAD_NAME = 5;
+
+        constexpr uint32_t EVENT_ANNOTATION = 4;
+        constexpr uint32_t EVENT_TYPE = 9;
+        constexpr uint32_t EVENT_TRACK = 11;
+        constexpr uint32_t EVENT_CATEGORY = 22;
+        constexpr uint32_t EVENT_NAME = 23;
+        constexpr uint32_t ANNOTATION_UINT = 3;
+        constexpr uint32_t ANNOTATION_NAME = 10;
+
+        constexpr uint64_t SLICE_BEGIN = 1;
+        constexpr uint64_t SLICE_END = 2;
+        constexpr uint64_t INCREMENTAL_STATE_CLEARED = 1;
+    }
+
+    void putPacket(std::string& out, const std::string& packet) {
+        putBytes(out, pb::TRACE_PACKET, packet);
+    }
+
+    std::string sliceBegin(const TraceEvent_t& e, uint64_t track, uint64_t ts) {
+        std::string event;
+        putUint(event, pb::EVENT_TYPE, pb::SLICE_BEGIN);
+        putUint(event, pb::EVENT_TRACK, track);
+        putBytes(event, pb::EVENT_CATEGORY, traceCategoryName(e.category));
+        putBytes(event, pb::EVENT_NAME, e.name);
+        if (e.argName) {
+            std::string annotation;
+            putUint(annotation, pb::ANNOTATION_UINT, e.arg);
+            putBytes(annotation, pb::ANNOTATION_NAME, e.argName);
+            putBytes(event, pb::EVENT_ANNOTATION, annotation);
+        }
+        std::string packet;
+        putUint(packet, pb::TIMESTAMP, ts);
+        putUint(packet, pb::SEQUENCE_ID, 1);
+        putBytes(packet, pb::TRACK_EVENT, event);
+        return packet;
+    }
+
+    std::string sliceEnd(uint64_t track, uint64_t ts) {
+        std::string event;
+        putUint(event, pb::EVENT_TYPE, pb::SLICE_END);
+        putUint(event, pb::EVENT_TRACK, track);
+        std::string packet;
+        putUint(packet, pb::TIMESTAMP, ts);
+        putUint(packet, pb::SEQUENCE_ID, 1);
+        putBytes(packet, pb::TRACK_EVENT, event);
+        return packet;
+    }
+}
+
+std::string TraceRecorder::toChromeJson() const {
+    const std::vector<TraceThread_t> threads = collect();
+    const uint64_t base = firstStart(threads);
+    std::string out = "{\"traceEvents\":[\n";
+    char line[256];
+
+    std::snprintf(line, sizeof(line),
+        "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%u,\"tid\":0,\"args\":{\"name\":\"robodbg\"}}", PROCESS_ID);
+    out += line;
+    for (const TraceThread_t& t : threads) {
+        std::snprintf(line, sizeof(line), ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":",
+            PROCESS_ID, t.index);
+        out += line;
+        appendJsonString(out, t.name.c_str());
+        out += "}}";
+    }
+    for (const TraceThread_t& t : threads) {
+        for (const TraceEvent_t& e : t.events) {
+            std::snprintf(line, sizeof(line), ",\n{\"ph\":\"X\",\"cat\":\"%s\",\"name\":", traceCategoryName(e.category));
+            out += line;
+            appendJsonString(out, e.name);
+            std::snprintf(line, sizeof(line), ",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f", PROCESS_ID, t.index,
+                (e.startNs - base) / 1e3, e.durationNs / 1e3);
+            out += line;
+            if (e.argName) {
+                out += ",\"args\":{";
+                appendJsonString(out, e.argName);
+                out += ':' + std::to_string(e.arg) + '}';
+            }
+            out += '}';
+        }
+    }
+    out += "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":" + std::to_string(dropped()) + "}}\n";
+    return out;
+}
+
+std::string TraceRecorder::toPerfetto() const {
+    const std::vector<TraceThread_t> threads = collect();
+    const uint64_t base = firstStart(threads);
+    std::string out;
+
+    {
+        std::string process, track, packet;
+        putUint(process, pb::PROCESS_PID, PROCESS_ID);
+        putBytes(process, pb::PROCESS_NAME, "robodbg");
+        putUint(track, pb::TRACK_UUID, PROCESS_TRACK);
+        putBytes(track, pb::TRACK_PROCESS, process);
+        putUint(packet, pb::SEQUENCE_ID, 1);
+        putUint(packet, pb::SEQUENCE_FLAGS, pb::INCREMENTAL_STATE_CLEARED);
+        putBytes(packet, pb::TRACK_DESCRIPTOR, track);
+        putPacket(out, packet);
+    }
+
+    for (const TraceThread_t& t : threads) {
+        const uint64_t uuid = THREAD_TRACKS + t.index;
+        std::string thread, track, packet;
+        putUint(thread, pb::THREAD_PID, PROCESS_ID);
+        putUint(thread, pb::THREAD_TID, t.index);
+        putBytes(thread, pb::THREAD_NAME, t.name);
+        putUint(track, pb::TRACK_UUID, uuid);
+        putBytes(track, pb::TRACK_NAME, t.name);
+        putUint(track, pb::TRACK_PARENT, PROCESS_TRACK);
+        putBytes(track, pb::TRACK_THREAD, thread);
+        putUint(packet, pb::SEQUENCE_ID, 1);
+        putBytes(packet, pb::TRACK_DESCRIPTOR, track);
+        putPacket(out, packet);
+
+        // Spans are kept in the order they ended; slices need begin / end in time order. Spans of one thread
+        // nest, so outer spans (earlier start, longer) go first and a stack of open ends closes them.
+        std::vector<TraceEvent_t> events = t.events;
+        std::stable_sort(events.begin(), events.end(), [](const TraceEvent_t& a, const TraceEvent_t& b) {
+            return a.startNs != b.startNs ? a.startNs < b.startNs : a.durationNs > b.durationNs;
+        });
+        std::vector<uint64_t> open;
+        for (const TraceEvent_t& e : events) {
+            while (!open.empty() && open.back() <= e.startNs) {
+                putPacket(out, sliceEnd(uuid, open.back() - base));
+                open.pop_back();
+            }
+            putPacket(out, sliceBegin(e, uuid, e.startNs - base));
+            // A span cannot outlast the one around it, even if the clock says so by a few ns
+            const uint64_t end = e.startNs + e.durationNs;
+            open.push_back(open.empty() ? end : std::min(end, open.back()));
+        }
+        while (!open.empty()) {
+            putPacket(out, sliceEnd(uuid, open.back() - base));
+            open.pop_back();
+        }
+    }
+    return out;
+}
+
+bool TraceRecorder::write(const std::string& path, TraceFormat format) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    const std::string data = format == TraceFormat::PERFETTO ? toPerfetto() : toChromeJson();
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+} // namespace RoboDBG
@@ -0,0 +1,214 @@
+/**
+ * @file traceRecorder.h
+ * @brief Span recording of the debugger's internals, written as Chrome trace-event JSON or Perfetto protobuf
+ * @author Milkshake
+ */
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RoboDBG {
+
+    /**
+     * @brief Monotonic clock in nanoseconds, the time base of metrics and traces.
+     */
+    inline uint64_t monotonicNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @enum TraceCategory
+     * @brief What a span belongs to; the category column of the trace viewer.
+     */
+    enum class TraceCategory : uint8_t {
+        LOOP,       ///< Waiting for events, continuing them, flushing contexts.
+        DISPATCH,   ///< Handling of one debug event, named after its type.
+        CALLBACK,   ///< A user callback (C++ override or Python).
+        REMOTE,     ///< A target primitive: memory, context, thread and protection calls.
+        BREAKPOINT, ///< Breakpoint state machine: restore, single-step, re-arm, displaced step.
+        COUNT
+    };
+
+    /**
+     * @brief Returns the name of a category ("loop", ...).
+     */
+    const char* traceCategoryName(TraceCategory category);
+
+    /**
+     * @enum TraceFormat
+     * @brief File format of a written trace; both open in ui.perfetto.dev, JSON also in chrome://tracing.
+     */
+    enum class TraceFormat : uint8_t {
+        CHROME_JSON, ///< Trace-event JSON ("X" complete events).
+        PERFETTO     ///< Perfetto protobuf (TrackEvent slices).
+    };
+
+    /**
+     * @struct TraceEvent_t
+     * @brief One recorded span. Names are string literals; nothing is copied while recording.
+     */
+    struct TraceEvent_t {
+        uint64_t startNs = 0;
+        uint64_t durationNs = 0;
+        const char* name = nullptr;
+        const char* argName = nullptr; ///< Name of arg, or nullptr if the span has none.
+        uint64_t arg = 0;              ///< Bytes of a memory call, thread of an event, address of a breakpoint.
+        TraceCategory category = TraceCategory::LOOP;
+    };
+
+    /**
+     * @struct TraceThread_t
+     * @brief The spans one thread recorded, oldest first.
+     */
+    struct TraceThread_t {
+        uint32_t index = 0;            ///< Order in which the thread recorded its first span, from 1.
+        std::string name;              ///< Set with nameThread(), else "thread <index>".
+        std::vector<TraceEvent_t> events;
+    };
+
+    /**
+     * @struct TraceOptions_t
+     * @brief Settings of a trace.
+     */
+    struct TraceOptions_t {
+        TraceFormat format = TraceFormat::CHROME_JSON;
+        size_t maxEvents = size_t(1) << 18;            ///< Spans kept; preallocated (48 bytes each), later ones are dropped.
+    };
+
+    /**
+     * @class TraceRecorder
+     * @brief Records spans from any number of threads into preallocated per-thread blocks.
+     *
+     * All memory is allocated by the constructor. A thread filling its block takes the next free block of
+     * 256 spans with one atomic increment; a span is a plain store into the thread's own block and a release
+     * store of its length. Nothing allocates while recording and only a thread's first span may lock.
+     * Once every block is taken, further spans are counted as dropped.
+     *
+     * Threads get an index (their track in the trace) with their first span. When a thread exits, its index
+     * and partly filled block go to the next thread that starts recording, so short-lived workers (scan
+     * threads, prefetchers) share a few tracks and blocks instead of taking new ones each time. Indices
+     * therefore only grow with the number of threads recording at the same time; only the first
+     * MAX_NAMED_THREADS indices can be named. Collect and write the trace once the recording threads are
+     * done (the debug loop writes it when loop() returns).
+     */
+    class TraceRecorder {
+    public:
+        static constexpr size_t BLOCK_EVENTS = 256;
+        static constexpr size_t MAX_NAMED_THREADS = 64;
+
+        explicit TraceRecorder(size_t maxEvents = TraceOptions_t{}.maxEvents);
+        ~TraceRecorder();
+
+        TraceRecorder(const TraceRecorder&) = delete;
+        TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+        /**
+         * @brief Adds a finished span of the calling thread.
+         */
+        void record(TraceCategory category, const char* name, uint64_t startNs, uint64_t endNs,
+                    const char* argName = nullptr, uint64_t arg = 0);
+
+        /**
+         * @brief Names the calling thread in the trace.
+         * @param name String literal (kept as a pointer).
+         */
+        void nameThread(const char* name);
+
+        /**
+         * @brief Returns the spans of every thread that recorded, ordered by thread index.
+         */
+        std::vector<TraceThread_t> collect() const;
+
+        inline uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+        inline size_t capacity() const { return blockCount_ * BLOCK_EVENTS; }
+
+        /**
+         * @brief Writes every span to a file.
+         * @return false if the file could not be written.
+         */
+        bool write(const std::string& path, TraceFormat format) const;
+
+        /**
+         * @brief Serializes the trace as Chrome trace-event JSON.
+         */
+        std::string toChromeJson() const;
+
+        /**
+         * @brief Serializes the trace as a Perfetto protobuf Trace (one track per thread).
+         */
+        std::string toPerfetto() const;
+
+    private:
+        struct Block_t;
+        struct Local_t;
+
+        /// Index and block a thread gave back when it exited.
+        struct Slot_t {
+            uint32_t thread;
+            Block_t* block;
+        };
+
+        /// Gives the calling thread its index in this recorder on first use.
+        void enter();
+        /// Takes back the index and block of an exiting thread if the recorder still exists.
+        static void handBack(uint64_t id, uint32_t thread, Block_t* block);
+        /// Current block of the calling thread, or nullptr when the pool is used up.
+        Block_t* block();
+
+        const uint64_t id_;                                   ///< Tells recorders apart in the threads' cached blocks.
+        size_t blockCount_;
+        std::unique_ptr<Block_t[]> blocks_;
+        std::atomic<size_t> nextBlock_{ 0 };
+        std::atomic<uint32_t> threads_{ 0 };
+        std::atomic<uint64_t> dropped_{ 0 };
+        std::atomic<const char*> names_[MAX_NAMED_THREADS] = {};
+        std::mutex freeMutex_;
+        std::vector<Slot_t> freeSlots_;                       ///< Left by exited threads; guarded by freeMutex_.
+        std::atomic<size_t> freeCount_{ 0 };                  ///< freeSlots_.size(), read without the lock.
+
+        static thread_local Local_t local_;                   ///< The calling thread's index and block.
+    };
+
+    /**
+     * @class TraceScope
+     * @brief Records the span from its construction to its destruction; does nothing without a recorder.
+     */
+    class TraceScope {
+    public:
+        inline TraceScope(TraceRecorder* recorder, TraceCategory category, const char* name,
+                          const char* argName = nullptr, uint64_t arg = 0)
+            : recorder_(recorder), name_(name), argName_(argName), arg_(arg), category_(category),
+              start_(recorder ? monotonicNs() : 0) {}
+
+        inline ~TraceScope() {
+            if (recorder_) recorder_->record(category_, name_, start_, monotonicNs(), argName_, arg_);
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+        /// Sets the argument once it is known (bytes actually moved, ...).
+        inline void setArg(uint64_t arg) { arg_ = arg; }
+
+    private:
+        TraceRecorder* recorder_;
+        const char* name_;
+        const char* argName_;
+        uint64_t arg_;
+        TraceCategory category_;
+        uint64_t start_;
+    };
+
+} // namespace RoboDBG
+
+#endif
@@ -1,3 +1,4 @@
+#ifdef _WIN32
 #include "util.h"
 
 
@@ -211,3 +212,5 @@ namespace RoboDBG::Util {
         return entryPoint;
     }
 }
+
+#endif
@@ -8,6 +8,8 @@
 
 #include "debugger.h"
 
+#ifdef _WIN32
+
 /**
  * @namespace RoboDBG::Util
  * @brief Utility helper functions for more high-level stuff.
@@ -83,3 +85,5 @@ namespace RoboDBG::Util {
 }
 
 #endif
+
+#endif
@@ -0,0 +1,419 @@
+#include "valueScanner.h"
+#include "regionReader.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace RoboDBG {
+
+namespace {
+    constexpr size_t BLOCK_BYTES = 0x10000;    // addresses per block; positions fit a uint16_t at alignment 1
+    constexpr size_t BATCH_BYTES = 4 << 20;    // read buffer of one readMemoryScatter() batch
+    constexpr size_t BITS_TO_LOOP = 8;         // dense words with fewer candidates are tested one by one
+    constexpr SIZE_T PAGE = 0x1000;            // granularity of unreadable holes
+
+    template<size_t N> struct BitsOf;
+    template<> struct BitsOf<1> { using type = uint8_t; };
+    template<> struct BitsOf<2> { using type = uint16_t; };
+    template<> struct BitsOf<4> { using type = uint32_t; };
+    template<> struct BitsOf<8> { using type = uint64_t; };
+
+    template<typename T>
+    inline T load(const BYTE* p) {
+        T v;
+        std::memcpy(&v, p, sizeof(T));
+        return v;
+    }
+
+    template<typename T, ScanCompare C>
+    inline bool pass(T cur, T prev, T lo, T hi) {
+        using Bits = typename BitsOf<sizeof(T)>::type;
+        if constexpr (C == ScanCompare::EXACT)     return cur == lo;
+        if constexpr (C == ScanCompare::RANGE)     return cur >= lo && cur <= hi;
+        if constexpr (C == ScanCompare::UNKNOWN)   return true;
+        if constexpr (C == ScanCompare::CHANGED)   return std::bit_cast<Bits>(cur) != std::bit_cast<Bits>(prev);
+        if constexpr (C == ScanCompare::UNCHANGED) return std::bit_cast<Bits>(cur) == std::bit_cast<Bits>(prev);
+        if constexpr (C == ScanCompare::INCREASED) return cur > prev;
+        if constexpr (C == ScanCompare::DECREASED) return cur < prev;
+        return false;
+    }
+
+    // Bit j of the result is set if position j of up to 64 passes. One flag byte per position keeps the
+    // loop free of branches and cross-lane work so it vectorizes; eight flags are then packed by one multiply.
+    template<typename T, ScanCompare C, bool Packed>
+    uint64_t compareWord(const BYTE* cur, const BYTE* prev, size_t n, size_t align, T lo, T hi) {
+        const size_t stride = Packed ? sizeof(T) : align;
+        alignas(8) uint8_t keep[64] = {};
+        for (size_t j = 0; j < n; ++j) {
+            keep[j] = pass<T, C>(load<T>(cur + j * stride), load<T>(prev + j * stride), lo, hi);
+        }
+        uint64_t bits = 0;
+        for (size_t k = 0; k < 8; ++k) {
+            bits |= ((load<uint64_t>(keep + 8 * k) * 0x0102040810204080ULL) >> 56) << (8 * k);
+        }
+        return bits;
+    }
+
+    template<typename T, ScanCompare C>
+    uint64_t compareWord(const BYTE* cur, const BYTE* prev, size_t n, size_t align, T lo, T hi) {
+        return align == sizeof(T) ? compareWord<T, C, true>(cur, prev, n, align, lo, hi)
+                                  : compareWord<T, C, false>(cur, prev, n, align, lo, hi);
+    }
+
+    // Turns value / high into bounds of type T; false if nothing can be EXACT / RANGE
+    template<typename T>
+    bool bounds(ScanCompare compare, ScanValue_t value, ScanValue_t high, T& lo, T& hi) {
+        if (compare != ScanCompare::EXACT && compare != ScanCompare::RANGE) return true;
+        if (compare == ScanCompare::EXACT) high = value;
+        if constexpr (std::is_integral_v<T>) {
+            const int64_t l = std::max<int64_t>(value.integer, std::numeric_limits<T>::min());
+            const int64_t h = std::min<int64_t>(high.integer, std::numeric_limits<T>::max());
+            if (l > h) return false;
+            lo = static_cast<T>(l);
+            hi = static_cast<T>(h);
+            return true;
+        } else {
+            lo = static_cast<T>(value.real);
+            hi = static_cast<T>(high.real);
+            return lo <= hi;
+        }
+    }
+
+    // Calls fn with ScanCompare as a compile-time constant
+    template<typename F>
+    decltype(auto) withCompare(ScanCompare compare, F&& fn) {
+        switch (compare) {
+            case ScanCompare::EXACT:     return fn(std::integral_constant<ScanCompare, ScanCompare::EXACT>{});
+            case ScanCompare::RANGE:     return fn(std::integral_constant<ScanCompare, ScanCompare::RANGE>{});
+            case ScanCompare::CHANGED:   return fn(std::integral_constant<ScanCompare, ScanCompare::CHANGED>{});
+            case ScanCompare::UNCHANGED: return fn(std::integral_constant<ScanCompare, ScanCompare::UNCHANGED>{});
+            case ScanCompare::INCREASED: return fn(std::integral_constant<ScanCompare, ScanCompare::INCREASED>{});
+            case ScanCompare::DECREASED: return fn(std::integral_constant<ScanCompare, ScanCompare::DECREASED>{});
+            default:                     return fn(std::integral_constant<ScanCompare, ScanCompare::UNKNOWN>{});
+        }
+    }
+
+    // Calls fn with a value of the C++ type behind type
+    template<typename F>
+    decltype(auto) withType(ValueType type, F&& fn) {
+        switch (type) {
+            case ValueType::INT8:   return fn(int8_t{});
+            case ValueType::INT16:  return fn(int16_t{});
+            case ValueType::INT32:  return fn(int32_t{});
+            case ValueType::INT64:  return fn(int64_t{});
+            case ValueType::FLOAT:  return fn(float{});
+            default:                return fn(double{});
+        }
+    }
+
+    struct Read_t {
+        size_t block;
+        size_t slot; ///< First position read.
+        MemoryIo_t io;
+    };
+
+    struct Hole_t {
+        SIZE_T begin, end; ///< Unreadable bytes, relative to the start of a read.
+    };
+
+    // Reads the ranges in batches of about BATCH_BYTES and calls fn(read, holes) for each once its bytes are in.
+    // A read that stops early is resumed page by page behind the failure, so one unmapped page in a block
+    // does not hide the rest of it.
+    template<typename F>
+    void readBatched(TargetBackend& target, std::vector<Read_t>& reads, F&& fn) {
+        std::vector<BYTE> buffer;
+        std::vector<MemoryIo_t> ios;
+        std::vector<Hole_t> holes;
+        for (size_t i = 0; i < reads.size();) {
+            size_t end = i, bytes = 0;
+            while (end < reads.size() && (end == i || bytes + reads[end].io.size <= BATCH_BYTES)) bytes += reads[end++].io.size;
+
+            buffer.resize(bytes);
+            ios.clear();
+            BYTE* at = buffer.data();
+            for (size_t r = i; r < end; ++r) {
+                reads[r].io.buffer = at;
+                at += reads[r].io.size;
+                ios.push_back(reads[r].io);
+            }
+            target.readMemoryScatter(ios.data(), ios.size());
+            for (size_t r = i; r < end; ++r) {
+                const MemoryIo_t& io = ios[r - i];
+                holes.clear();
+                for (SIZE_T done = std::min(io.transferred, io.size); done < io.size;) {
+                    const SIZE_T skip = std::min(io.size - done, PAGE - ((io.address + done) & (PAGE - 1)));
+                    if (!holes.empty() && holes.back().end == done) holes.back().end += skip;
+                    else holes.push_back(Hole_t{ done, done + skip });
+                    done += skip;
+                    if (done == io.size) break;
+                    SIZE_T got = 0;
+                    target.readMemory(io.address + done, static_cast<BYTE*>(io.buffer) + done, io.size - done, &got);
+                    done += std::min(got, io.size - done);
+                }
+                fn(reads[r], holes);
+            }
+            i = end;
+        }
+    }
+
+    // Clears the positions (counted from slot) whose value overlaps a hole
+    void clearHoles(std::vector<uint64_t>& bitmap, size_t slot, size_t align, size_t size, const std::vector<Hole_t>& holes) {
+        const size_t slots = bitmap.size() * 64;
+        for (const Hole_t& h : holes) {
+            const size_t from = slot + (h.begin + 1 > size ? (h.begin + 1 - size + align - 1) / align : 0);
+            const size_t to = std::min(slots, slot + (h.end - 1) / align + 1);
+            for (size_t p = from; p < to; ++p) bitmap[p / 64] &= ~(uint64_t(1) << (p % 64));
+        }
+    }
+}
+
+ValueScanner::ValueScanner(TargetBackend& target, ValueType type, size_t alignment)
+    : target_(target), type_(type), size_(valueSize(type)), align_(alignment ? alignment : valueSize(type)) {
+    blockSlots_ = std::max<size_t>(1, BLOCK_BYTES / align_);
+}
+
+size_t ValueScanner::valueSize(ValueType type) {
+    return withType(type, [](auto v) { return sizeof(v); });
+}
+
+void ValueScanner::reset() {
+    blocks_.clear();
+    prefix_.clear();
+}
+
+size_t ValueScanner::memoryUsage() const {
+    size_t bytes = blocks_.capacity() * sizeof(Block_t) + prefix_.capacity() * sizeof(size_t);
+    for (const Block_t& b : blocks_) {
+        bytes += b.bitmap.capacity() * sizeof(uint64_t) + b.offsets.capacity() * sizeof(uint16_t) + b.values.capacity();
+    }
+    return bytes;
+}
+
+size_t ValueScanner::firstScan(ScanCompare compare, ScanValue_t value, ScanValue_t high) {
+    std::vector<MemoryRegion_t> regions = target_.getMemoryRegions();
+    regions.erase(std::remove_if(regions.begin(), regions.end(),
+                                 [](const MemoryRegion_t& r) { return !RegionReader::readable(r); }),
+                  regions.end());
+    return firstScan(regions, compare, value, high);
+}
+
+size_t ValueScanner::firstScan(std::span<const MemoryRegion_t> regions, ScanCompare compare,
+                               ScanValue_t value, ScanValue_t high) {
+    reset();
+    if (compare != ScanCompare::EXACT && compare != ScanCompare::RANGE && compare != ScanCompare::UNKNOWN) return 0;
+    withType(type_, [&](auto v) { first<decltype(v)>(regions, compare, value, high); });
+    index();
+    return count();
+}
+
+size_t ValueScanner::nextScan(ScanCompare compare, ScanValue_t value, ScanValue_t high) {
+    withType(type_, [&](auto v) { next<decltype(v)>(compare, value, high); });
+    index();
+    return count();
+}
+
+template<typename T>
+void ValueScanner::first(std::span<const MemoryRegion_t> regions, ScanCompare compare, ScanValue_t value, ScanValue_t high) {
+    T lo{}, hi{};
+    if (!bounds(compare, value, high, lo, hi)) return;
+
+    // One read per block of every region
+    std::vector<Read_t> reads;
+    for (const MemoryRegion_t& region : regions) {
+        if (region.RegionSize < size_) continue;
+        const uintptr_t base = reinterpret_cast<uintptr_t>(region.BaseAddress);
+        const size_t positions = (region.RegionSize - size_) / align_ + 1;
+        for (size_t slot = 0; slot < positions; slot += blockSlots_) {
+            const size_t slots = std::min(blockSlots_, positions - slot);
+            reads.push_back(Read_t{ blocks_.size(), 0, MemoryIo_t{ base + slot * align_, nullptr, (slots - 1) * align_ + size_ } });
+            Block_t block;
+            block.base = base + slot * align_;
+            block.slots = static_cast<uint32_t>(slots);
+            blocks_.push_back(std::move(block));
+        }
+    }
+
+    std::vector<uint64_t> bitmap;
+    withCompare(compare, [&](auto c) {
+        readBatched(target_, reads, [&](const Read_t& read, const std::vector<Hole_t>& holes) {
+            Block_t& block = blocks_[read.block];
+            const BYTE* data = static_cast<const BYTE*>(read.io.buffer);
+
+            bitmap.assign((block.slots + 63) / 64, 0);
+            for (size_t at = 0; at < block.slots; at += 64) {
+                const BYTE* p = data + at * align_;
+                bitmap[at / 64] = compareWord<T, decltype(c)::value>(p, p, std::min<size_t>(64, block.slots - at), align_, lo, hi);
+            }
+            clearHoles(bitmap, 0, align_, size_, holes);
+            for (uint64_t bits : bitmap) block.count += static_cast<uint32_t>(std::popcount(bits));
+            if (block.count) {
+                block.bitmap.swap(bitmap);
+                store(block, data);
+            }
+        });
+    });
+}
+
+// Keeps the block dense (bitmap + copy of the block) or makes it sparse, whichever takes less memory.
+// data holds the bytes from position 0; a dense block must come with its bitmap already in place.
+void ValueScanner::store(Block_t& block, const BYTE* data) {
+    const size_t denseBytes = block.bitmap.size() * sizeof(uint64_t) + (block.slots - 1) * align_ + size_;
+    const size_t sparseBytes = block.count * (sizeof(uint16_t) + size_);
+    if (sparseBytes < denseBytes) {
+        std::vector<uint16_t> offsets;
+        std::vector<BYTE> values(block.count * size_);
+        offsets.reserve(block.count);
+        for (size_t w = 0; w < block.bitmap.size(); ++w) {
+            for (uint64_t bits = block.bitmap[w]; bits; bits &= bits - 1) {
+                const size_t slot = w * 64 + std::countr_zero(bits);
+                std::memcpy(values.data() + offsets.size() * size_, data + slot * align_, size_);
+                offsets.push_back(static_cast<uint16_t>(slot));
+            }
+        }
+        block.offsets.swap(offsets);
+        block.values.swap(values);
+        std::vector<uint64_t>().swap(block.bitmap);
+    } else if (block.values.data() != data) {
+        block.values.assign(data, data + (block.slots - 1) * align_ + size_);
+    }
+}
+
+template<typename T>
+void ValueScanner::next(ScanCompare compare, ScanValue_t value, ScanValue_t high) {
+    T lo{}, hi{};
+    if (!bounds(compare, value, high, lo, hi)) {
+        reset();
+        return;
+    }
+
+    // Read each block from its first to its last candidate; dense blocks from a 64-position word boundary
+    std::vector<Read_t> reads;
+    reads.reserve(blocks_.size());
+    for (size_t i = 0; i < blocks_.size(); ++i) {
+        const Block_t& block = blocks_[i];
+        size_t lowSlot, highSlot;
+        if (block.dense()) {
+            size_t w = 0, last = block.bitmap.size() - 1;
+            while (!block.bitmap[w]) ++w;
+            while (!block.bitmap[last]) --last;
+            lowSlot = w * 64;
+            highSlot = last * 64 + 63 - std::countl_zero(block.bitmap[last]);
+        } else {
+            lowSlot = block.offsets.front();
+            highSlot = block.offsets.back();
+        }
+        reads.push_back(Read_t{ i, lowSlot, MemoryIo_t{ block.base + lowSlot * align_, nullptr, (highSlot - lowSlot) * align_ + size_ } });
+    }
+
+    withCompare(compare, [&](auto c) {
+        constexpr ScanCompare C = decltype(c)::value;
+        readBatched(target_, reads, [&](const Read_t& read, const std::vector<Hole_t>& holes) {
+            Block_t& block = blocks_[read.block];
+            const BYTE* cur = static_cast<const BYTE*>(read.io.buffer);
+            uint32_t count = 0;
+
+            if (block.dense()) {
+                const size_t end = read.slot + (read.io.size - size_) / align_ + 1; // past the last position read
+                clearHoles(block.bitmap, read.slot, align_, size_, holes);
+                BYTE* prev = block.values.data() + read.slot * align_;
+                for (size_t w = read.slot / 64; w < block.bitmap.size(); ++w) {
+                    uint64_t word = block.bitmap[w];
+                    if (!word) continue;
+                    const size_t rel = (w * 64 - read.slot) * align_;
+                    if (std::popcount(word) < static_cast<int>(BITS_TO_LOOP)) {
+                        for (uint64_t bits = word; bits; bits &= bits - 1) {
+                            const size_t j = std::countr_zero(bits) * align_;
+                            if (!pass<T, C>(load<T>(cur + rel + j), load<T>(prev + rel + j), lo, hi)) word &= ~(bits & (0 - bits));
+                        }
+                    } else {
+                        const size_t n = std::min<size_t>(64, end - w * 64);
+                        word &= compareWord<T, C>(cur + rel, prev + rel, n, align_, lo, hi);
+                    }
+                    block.bitmap[w] = word;
+                    count += static_cast<uint32_t>(std::popcount(word));
+                }
+                block.count = count;
+                if (count) {
+                    std::memcpy(prev, cur, read.io.size);
+                    store(block, block.values.data());
+                }
+            } else {
+                size_t h = 0;
+                for (size_t k = 0; k < block.count; ++k) {
+                    const size_t slot = block.offsets[k];
+                    const SIZE_T rel = (slot - read.slot) * align_;
+                    while (h < holes.size() && holes[h].end <= rel) ++h;
+                    if (h < holes.size() && holes[h].begin < rel + size_) continue;
+                    if (pass<T, C>(load<T>(cur + rel), load<T>(block.values.data() + k * size_), lo, hi)) {
+                        block.offsets[count] = static_cast<uint16_t>(slot);
+                        std::memmove(block.values.data() + count * size_, cur + rel, size_);
+                        ++count;
+                    }
+                }
+                block.count = count;
+                block.offsets.resize(count);
+                block.values.resize(count * size_);
+                if (block.offsets.capacity() > 2 * count) {
+                    block.offsets.shrink_to_fit();
+                    block.values.shrink_to_fit();
+                }
+            }
+        });
+    });
+}
+
+// Drops empty blocks and rebuilds the running candidate count used for paging
+void ValueScanner::index() {
+    blocks_.erase(std::remove_if(blocks_.begin(), blocks_.end(), [](const Block_t& b) { return b.count == 0; }), blocks_.end());
+    if (blocks_.capacity() > 2 * blocks_.size()) blocks_.shrink_to_fit();
+    prefix_.resize(blocks_.size());
+    size_t total = 0;
+    for (size_t i = 0; i < blocks_.size(); ++i) prefix_[i] = total += blocks_[i].count;
+}
+
+template<typename T>
+ScanValue_t ValueScanner::decode(const BYTE* p) const {
+    const T v = load<T>(p);
+    if constexpr (std::is_integral_v<T>) return ScanValue_t::of(static_cast<int64_t>(v));
+    else return ScanValue_t::of(static_cast<double>(v));
+}
+
+std::vector<ValueHit_t> ValueScanner::results(size_t first, size_t max) const {
+    std::vector<ValueHit_t> out;
+    if (first >= count() || !max) return out;
+    out.reserve(std::min(max, count() - first));
+
+    withType(type_, [&](auto v) {
+        using T = decltype(v);
+        size_t i = std::upper_bound(prefix_.begin(), prefix_.end(), first) - prefix_.begin();
+        size_t skip = first - (i ? prefix_[i - 1] : 0);
+        for (; i < blocks_.size() && out.size() < max; ++i, skip = 0) {
+            const Block_t& block = blocks_[i];
+            if (block.dense()) {
+                for (size_t w = 0; w < block.bitmap.size() && out.size() < max; ++w) {
+                    uint64_t bits = block.bitmap[w];
+                    const size_t n = std::popcount(bits);
+                    if (skip >= n) {
+                        skip -= n;
+                        continue;
+                    }
+                    for (; skip; --skip) bits &= bits - 1;
+                    for (; bits && out.size() < max; bits &= bits - 1) {
+                        const size_t slot = w * 64 + std::countr_zero(bits);
+                        out.push_back(ValueHit_t{ block.base + slot * align_, decode<T>(block.values.data() + slot * align_) });
+                    }
+                }
+            } else {
+                for (size_t k = skip; k < block.count && out.size() < max; ++k) {
+                    out.push_back(ValueHit_t{ block.base + block.offsets[k] * align_, decode<T>(block.values.data() + k * size_) });
+                }
+            }
+        }
+    });
+    return out;
+}
+
+} // namespace RoboDBG
@@ -0,0 +1,180 @@
+/**
+ * @file valueScanner.h
+ * @brief Typed value search narrowed down over repeated scans (first scan / next scan)
+ * @author Milkshake
+ */
+
+#ifndef VALUESCANNER_H
+#define VALUESCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "platform.h"
+#include "backends/targetBackend.h"
+
+namespace RoboDBG {
+
+    /**
+     * @enum ValueType
+     * @brief Type of the values a ValueScanner looks for. Integers are signed and little endian.
+     */
+    enum class ValueType : uint8_t {
+        INT8,
+        INT16,
+        INT32,
+        INT64,
+        FLOAT,
+        DOUBLE
+    };
+
+    /**
+     * @enum ScanCompare
+     * @brief Which values a scan keeps.
+     *
+     * A first scan takes EXACT, RANGE or UNKNOWN. A next scan takes any mode but UNKNOWN, which there only
+     * refreshes the stored values. CHANGED and UNCHANGED compare the bits, so a NaN that stays NaN is unchanged.
+     */
+    enum class ScanCompare : uint8_t {
+        EXACT,     ///< Equal to the value.
+        RANGE,     ///< Between the value and the high value, both included.
+        UNKNOWN,   ///< Every position (first scan only).
+        CHANGED,   ///< Differs from the previous scan.
+        UNCHANGED, ///< Same as in the previous scan.
+        INCREASED, ///< Greater than in the previous scan.
+        DECREASED  ///< Less than in the previous scan.
+    };
+
+    /**
+     * @struct ScanValue_t
+     * @brief A value given to or returned by a ValueScanner. Integer types use integer, FLOAT / DOUBLE use real.
+     */
+    struct ScanValue_t {
+        int64_t integer = 0; ///< Value for the integer types.
+        double real = 0;     ///< Value for FLOAT and DOUBLE.
+
+        static ScanValue_t of(int64_t v) { return { v, static_cast<double>(v) }; }
+        static ScanValue_t of(double v) { return { static_cast<int64_t>(v), v }; }
+    };
+
+    /**
+     * @struct ValueHit_t
+     * @brief One candidate with the value it had in the last scan.
+     */
+    struct ValueHit_t {
+        uintptr_t address = 0; ///< Address of the value.
+        ScanValue_t value;     ///< Value read by the last scan.
+    };
+
+    /**
+     * @class ValueScanner
+     * @brief Finds the addresses holding a value, then narrows them down as the target changes the value.
+     *
+     * Memory is cut into blocks of 64 KB of addresses. A block keeps its candidates either as a bitmap over
+     * its positions plus a copy of the block (dense, e.g. after an UNKNOWN scan) or as 16-bit positions plus
+     * the packed values (sparse), whichever is smaller. A next scan reads only the blocks that still have
+     * candidates, from the first to the last candidate, in batches through readMemoryScatter(); dense blocks
+     * are compared 64 positions at a time in loops the compiler vectorizes.
+     *
+     * Results are paged with results(), so millions of candidates never have to be copied out at once.
+     */
+    class ValueScanner {
+    public:
+        /**
+         * @brief Creates a scanner.
+         * @param target Memory of the debuggee.
+         * @param type Value type.
+         * @param alignment Distance between positions looked at; 0 is the size of the type.
+         */
+        ValueScanner(TargetBackend& target, ValueType type, size_t alignment = 0);
+
+        /**
+         * @brief Scans the readable memory of the target and replaces the candidates.
+         * @param compare EXACT, RANGE or UNKNOWN.
+         * @param value Value (EXACT) or low end (RANGE).
+         * @param high High end (RANGE).
+         * @return Number of candidates; 0 for a compare mode a first scan does not take.
+         */
+        size_t firstScan(ScanCompare compare, ScanValue_t value = {}, ScanValue_t high = {});
+
+        /**
+         * @brief Like firstScan(compare, value, high) over the given regions only.
+         * @param regions Regions to scan; unreadable ranges are skipped.
+         */
+        size_t firstScan(std::span<const MemoryRegion_t> regions, ScanCompare compare,
+                         ScanValue_t value = {}, ScanValue_t high = {});
+
+        /**
+         * @brief Re-reads the candidates, keeps those that pass and stores their new values.
+         *
+         * Candidates that can no longer be read are dropped.
+         *
+         * @param compare Any mode; UNKNOWN keeps every readable candidate.
+         * @param value Value (EXACT) or low end (RANGE).
+         * @param high High end (RANGE).
+         * @return Number of candidates left.
+         */
+        size_t nextScan(ScanCompare compare, ScanValue_t value = {}, ScanValue_t high = {});
+
+        /**
+         * @brief Returns a page of candidates in address order.
+         * @param first Index of the first candidate.
+         * @param max Largest number of candidates returned.
+         */
+        std::vector<ValueHit_t> results(size_t first, size_t max) const;
+
+        /**
+         * @brief Drops all candidates.
+         */
+        void reset();
+
+        /**
+         * @brief Returns the number of candidates.
+         */
+        inline size_t count() const { return prefix_.empty() ? 0 : prefix_.back(); }
+
+        /**
+         * @brief Returns the bytes held for the candidates.
+         */
+        size_t memoryUsage() const;
+
+        inline ValueType type() const { return type_; }
+        inline size_t alignment() const { return align_; }
+
+        /**
+         * @brief Returns the size of a value of the given type.
+         */
+        static size_t valueSize(ValueType type);
+
+    private:
+        struct Block_t {
+            uintptr_t base = 0;            ///< Address of position 0.
+            uint32_t slots = 0;            ///< Positions in the block.
+            uint32_t count = 0;            ///< Candidates.
+            std::vector<uint64_t> bitmap;  ///< Dense: one bit per position.
+            std::vector<uint16_t> offsets; ///< Sparse: candidate positions, ascending.
+            std::vector<BYTE> values;      ///< Dense: the block bytes; sparse: the candidate values back to back.
+
+            inline bool dense() const { return !bitmap.empty(); }
+        };
+
+        template<typename T> void first(std::span<const MemoryRegion_t> regions, ScanCompare compare, ScanValue_t value, ScanValue_t high);
+        template<typename T> void next(ScanCompare compare, ScanValue_t value, ScanValue_t high);
+        template<typename T> ScanValue_t decode(const BYTE* p) const;
+        void store(Block_t& block, const BYTE* data);
+        void index();
+
+        TargetBackend& target_;
+        ValueType type_;
+        size_t size_;
+        size_t align_;
+        size_t blockSlots_;
+        std::vector<Block_t> blocks_;
+        std::vector<size_t> prefix_; ///< Candidates in blocks_[0..i].
+    };
+
+} // namespace RoboDBG
+
+#endif
@@ -0,0 +1,75 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "platform.h"
+#include "breakpointTable.h"
+
+// Lookup / BREAK-RESTORE churn of BreakpointTable against the std::map it replaced.
+// Usage: benchBreakpointTable [breakpoints] [lookups]
+
+using namespace RoboDBG;
+
+template<typename F>
+static double timeIt(F&& fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main( int argc, char** argv ) {
+    const size_t count   = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000;
+    const size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5000000;
+
+    // Breakpoints spread over a 16 MB text section, like a coverage run
+    std::mt19937_64 rng(42);
+    std::vector<uintptr_t> addrs(count);
+    for (auto& a : addrs) a = 0x140001000ULL + (rng() % (16u << 20));
+    std::vector<uintptr_t> probes(lookups);
+    for (auto& p : probes) p = addrs[rng() % count];
+
+    std::map<LPVOID, BYTE> map;
+    BreakpointTable table;
+    for (uintptr_t a : addrs) {
+        map[reinterpret_cast<LPVOID>(a)] = 0x90;
+        table.insert(a, 0x90);
+    }
+
+    uint64_t sink = 0;
+    double tMap = timeIt([&] {
+        for (uintptr_t p : probes) {
+            auto it = map.find(reinterpret_cast<LPVOID>(p));
+            if (it != map.end()) sink += it->second;
+        }
+    });
+    double tTable = timeIt([&] {
+        for (uintptr_t p : probes) {
+            if (Breakpoint_t* e = table.find(p)) sink += e->original;
+        }
+    });
+
+    // erase + insert per hit, what a BREAK followed by setBreakpoint costs
+    double tMapChurn = timeIt([&] {
+        for (size_t i = 0; i < lookups / 10; ++i) {
+            LPVOID a = reinterpret_cast<LPVOID>(probes[i]);
+            map.erase(a);
+            map[a] = 0x90;
+        }
+    });
+    double tTableChurn = timeIt([&] {
+        for (size_t i = 0; i < lookups / 10; ++i) {
+            table.erase(probes[i]);
+            table.insert(probes[i], 0x90);
+        }
+    });
+
+    std::printf("[*] %zu breakpoints, %zu lookups (checksum %llu)\n", table.size(), lookups, (unsigned long long)sink);
+    std::printf("lookup   std::map %8.1f ns   BreakpointTable %8.1f ns\n",
+                tMap * 1e9 / lookups, tTable * 1e9 / lookups);
+    std::printf("churn    std::map %8.1f ns   BreakpointTable %8.1f ns\n",
+                tMapChurn * 1e9 / (lookups / 10), tTableChurn * 1e9 / (lookups / 10));
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "parallelScan.h"
+#include "patternScanner.h"
+#include "regionReader.h"
+#include "backends/ptraceBackend.h"
+
+// Whole-address-space signature scan of a live Linux process: serial RegionReader vs ParallelScan.
+// Usage: benchParallelScan [GB of target buffers] [max threads]
+// A forked child maps the buffers in 256 MB regions, fills them with code-like bytes and plants a signature
+// every MB; the benchmark attaches with ptrace and scans every readable region through process_vm_readv.
+
+using namespace RoboDBG;
+
+constexpr size_t REGION_SIZE = size_t(256) << 20;
+const BYTE SIGNATURE[] = { 0x48, 0x89, 0x5C, 0x24, 0x08, 0x57, 0x48, 0x83, 0xEC, 0x20 };
+
+template<typename F>
+static double timeIt(F&& fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+[[noreturn]] static void target( size_t gb, int ready ) {
+    static constexpr BYTE common[] = { 0x00, 0x00, 0x00, 0x48, 0x8B, 0x89, 0xCC, 0xFF, 0x24, 0x44, 0x0F, 0xE8, 0x83, 0x85 };
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (size_t r = 0; r < (gb << 30) / REGION_SIZE; ++r) {
+        BYTE* p = static_cast<BYTE*>(mmap(nullptr, REGION_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (p == MAP_FAILED) _exit(1);
+        for (size_t i = 0; i < REGION_SIZE; ++i) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            p[i] = (x & 1) ? common[(x >> 8) % sizeof(common)] : static_cast<BYTE>(x >> 16);
+        }
+        for (size_t at = 4096; at + sizeof(SIGNATURE) <= REGION_SIZE; at += 1 << 20) std::memcpy(p + at, SIGNATURE, sizeof(SIGNATURE));
+    }
+    const char c = 1;
+    if (write(ready, &c, 1) != 1) _exit(1);
+    for (;;) pause();
+}
+
+int main( int argc, char** argv ) {
+    const size_t gb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2;
+    const unsigned maxThreads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10))
+                                         : std::max(1u, std::thread::hardware_concurrency());
+
+    int pipeFd[2];
+    if (pipe(pipeFd) != 0) return 1;
+    const pid_t child = fork();
+    if (child == 0) target(gb, pipeFd[1]);
+    char c = 0;
+    if (read(pipeFd[0], &c, 1) != 1) {
+        std::cerr << "[-] Target failed to map " << gb << " GB\n";
+        return 1;
+    }
+
+    PtraceBackend backend(false);
+    if (!backend.attach(static_cast<DWORD>(child))) {
+        kill(child, SIGKILL);
+        return 1;
+    }
+
+    std::vector<MemoryRegion_t> regions = backend.getMemoryRegions();
+    regions.erase(std::remove_if(regions.begin(), regions.end(),
+                                 [](const MemoryRegion_t& r) { return !RegionReader::readable(r); }),
+                  regions.end());
+    SIZE_T total = 0;
+    for (const MemoryRegion_t& r : regions) total += r.RegionSize;
+    const double mb = static_cast<double>(total) / (1 << 20);
+    std::cout << "[*] " << regions.size() << " regions, " << (total >> 20) << " MB, "
+              << std::thread::hardware_concurrency() << " cores\n";
+
+    const PatternScanner scanner(BytePattern_t::exact(SIGNATURE));
+    const SIZE_T overlap = sizeof(SIGNATURE) - 1;
+
+    std::vector<uintptr_t> serial;
+    const double ts = timeIt([&] {
+        RegionReader(backend).forEachChunk(regions, overlap, [&](const MemoryChunk_t& chunk) {
+            scanner.scan(chunk.data, chunk.size, chunk.address, serial);
+            return true;
+        });
+    });
+    std::printf("  %-28s hits=%-8zu %7.3fs %7.0f MB/s\n", "RegionReader", serial.size(), ts, mb / ts);
+
+    auto parallel = [&](ScanOptions_t options) {
+        std::vector<uintptr_t> hits;
+        const double t = timeIt([&] {
+            hits = ParallelScan(backend, options).collect<uintptr_t>(regions, overlap,
+                [&](const MemoryChunk_t& chunk, std::vector<uintptr_t>& out) {
+                    scanner.scan(chunk.data, chunk.size, chunk.address, out);
+                });
+        });
+        char name[64];
+        std::snprintf(name, sizeof(name), "threads=%u chunk=%zuK%s", options.threads, static_cast<size_t>(options.chunkSize >> 10),
+                      options.maxHits ? " first" : "");
+        std::printf("  %-28s hits=%-8zu %7.3fs %7.0f MB/s%s\n", name, hits.size(), t, mb / t,
+                    options.maxHits || hits == serial ? "" : "  MISMATCH");
+    };
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        parallel(ScanOptions_t{ threads, 1 << 20, 0 });
+        if (threads * 2 > maxThreads && threads != maxThreads) parallel(ScanOptions_t{ maxThreads, 1 << 20, 0 });
+    }
+    for (SIZE_T chunk : { SIZE_T(64) << 10, SIZE_T(256) << 10, SIZE_T(4) << 20 }) parallel(ScanOptions_t{ maxThreads, chunk, 0 });
+    parallel(ScanOptions_t{ maxThreads, 1 << 20, 100 });
+
+    backend.terminate(0);
+    waitpid(child, nullptr, 0);
+    return 0;
+}
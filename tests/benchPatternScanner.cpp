@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "patternScanner.h"
+
+// Signature scan throughput of PatternScanner against the memcmp loop searchInMemory used before.
+// Usage: benchPatternScanner [corpus file | size in MB]
+// Without a file the corpus is synthetic bytes skewed like x86 code (zeros, REX, mov, int3 padding).
+
+using namespace RoboDBG;
+
+template<typename F>
+static double timeIt(F&& fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static std::vector<BYTE> syntheticCorpus( size_t size ) {
+    static constexpr BYTE common[] = { 0x00, 0x00, 0x00, 0x48, 0x8B, 0x89, 0xCC, 0xFF, 0x24, 0x44, 0x0F, 0xE8, 0x83, 0x85 };
+    std::mt19937_64 rng(1);
+    std::vector<BYTE> data(size);
+    for (auto& b : data) {
+        const uint64_t r = rng();
+        b = (r & 1) ? common[(r >> 8) % sizeof(common)] : static_cast<BYTE>(r >> 16);
+    }
+    return data;
+}
+
+int main( int argc, char** argv ) {
+    std::vector<BYTE> corpus;
+    const char* arg = argc > 1 ? argv[1] : nullptr;
+    if (arg && std::ifstream(arg, std::ios::binary)) {
+        std::ifstream in(arg, std::ios::binary);
+        corpus.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    } else {
+        corpus = syntheticCorpus((arg ? std::strtoull(arg, nullptr, 10) : 256) << 20);
+    }
+
+    const char* signatures[] = {
+        "56 57 FC 8B 54",                                  // Warden memscan
+        "56 57 ?? 8B 54",
+        "48 8B ?? 24 ?? 48 85 C0 74",
+        "?? ?? 42 4C 4C 32",
+        "48 89 5C 24 08 48 89 74 24 10 57 48 83 EC 20 48 8B F9 33 DB",
+        "48 8B 44 24 ?? 48 89 44 24 48 83 C4 48 C3 CC CC CC CC", // common bytes only
+    };
+
+    std::vector<BytePattern_t> patterns;
+    for (const char* signature : signatures) {
+        patterns.emplace_back();
+        BytePattern_t::parse(signature, patterns.back());
+    }
+
+    // Plant every signature once per MB of the synthetic corpus, wildcards filled with nops
+    if (!arg || !std::ifstream(arg, std::ios::binary)) {
+        for (size_t at = 0; at + (1 << 20) <= corpus.size(); at += 1 << 20) {
+            size_t offset = at + 4096;
+            for (const BytePattern_t& p : patterns) {
+                for (size_t j = 0; j < p.size(); ++j) corpus[offset + j] = p.value[j] | (0x90 & ~p.mask[j]);
+                offset += 128;
+            }
+        }
+    }
+
+    std::cout << "[*] Corpus " << (corpus.size() >> 20) << " MB, best scanner "
+              << static_cast<int>(PatternScanner::bestImplementation()) << "\n";
+    // Small corpora are scanned repeatedly to measure in-cache throughput
+    const size_t reps = std::max<size_t>(1, (size_t(1) << 30) / std::max<size_t>(corpus.size(), 1));
+    const double mb = static_cast<double>(corpus.size()) * static_cast<double>(reps) / (1 << 20);
+
+    for (size_t s = 0; s < patterns.size(); ++s) {
+        const BytePattern_t& pattern = patterns[s];
+        std::printf("%-62s\n", signatures[s]);
+
+        // Only exact signatures can use the old loop
+        if (std::all_of(pattern.mask.begin(), pattern.mask.end(), [](BYTE m) { return m == 0xFF; })) {
+            size_t hits = 0;
+            const double t = timeIt([&] {
+                for (size_t r = 0; r < reps; ++r) {
+                    hits = 0;
+                    for (size_t i = 0; i + pattern.size() <= corpus.size(); ++i) {
+                        if (std::memcmp(corpus.data() + i, pattern.value.data(), pattern.size()) == 0) ++hits;
+                    }
+                }
+            });
+            std::printf("  %-8s hits=%-8zu %7.3fs %9.0f MB/s\n", "memcmp", hits, t, mb / t);
+        }
+
+        for (ScanImpl impl : { ScanImpl::SCALAR, ScanImpl::SSE2, ScanImpl::AVX2 }) {
+            PatternScanner scanner(pattern, impl);
+            if (scanner.implementation() != impl) continue;
+            std::vector<uintptr_t> matches;
+            const double t = timeIt([&] {
+                for (size_t r = 0; r < reps; ++r) {
+                    matches.clear();
+                    scanner.scan(corpus.data(), corpus.size(), 0, matches);
+                }
+            });
+            static const char* names[] = { "scalar", "sse2", "avx2" };
+            std::printf("  %-8s hits=%-8zu %7.3fs %9.0f MB/s\n", names[static_cast<int>(impl)], matches.size(), t, mb / t);
+        }
+    }
+    return 0;
+}
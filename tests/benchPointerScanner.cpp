@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "pointerScanner.h"
+
+// Pointer map build and backward search over a synthetic heap dump, by thread count.
+// Usage: benchPointerScanner [heap size in MB] [max threads]
+// The heap is cut into 256-byte objects; a quarter of the slots point into random objects, so every object
+// is reached from several others. A 64 KB module holds static pointers into the heap.
+
+using namespace RoboDBG;
+
+constexpr uintptr_t MODULE = 0x140000000;
+constexpr uintptr_t HEAP   = 0x20000000000;
+constexpr size_t OBJECT    = 256;
+
+template<typename F>
+static double timeIt(F&& fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main( int argc, char** argv ) {
+    const size_t size = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64) << 20;
+    const unsigned maxThreads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10))
+                                         : std::max(1u, std::thread::hardware_concurrency());
+
+    std::mt19937_64 rng(5);
+    const size_t objects = size / OBJECT;
+    std::vector<BYTE> module(64 << 10), heap(size);
+    auto fill = [&](std::vector<BYTE>& bytes, unsigned percent) {
+        for (size_t at = 0; at < bytes.size(); at += 8) {
+            const uint64_t r = rng();
+            const uint64_t value = r % 100 < percent ? HEAP + (r >> 8) % objects * OBJECT + (r >> 40) % 4 * 8 : r >> 20;
+            std::memcpy(bytes.data() + at, &value, 8);
+        }
+    };
+    fill(module, 25);
+    fill(heap, 25);
+    const std::vector<MemoryDump_t> dumps = { { MODULE, module }, { HEAP, heap } };
+    const std::vector<Module_t> modules = { { MODULE, module.size(), "game.exe" } };
+    const uintptr_t target = HEAP + (objects / 2) * OBJECT + 0x40;
+
+    std::cout << "[*] " << (size >> 20) << " MB heap, " << objects << " objects, "
+              << std::thread::hardware_concurrency() << " cores\n";
+
+    size_t serial = SIZE_MAX;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        PointerScanner scanner(PointerScanOptions_t{ 4, 0x100, 8, 0, 0, threads });
+        size_t pointers = 0, paths = 0;
+        const double tm = timeIt([&] { pointers = scanner.buildMap(dumps); });
+        const double ts = timeIt([&] { paths = scanner.scan(target, modules); });
+        if (serial == SIZE_MAX) serial = paths;
+        std::printf("  threads=%-3u map: %9zu pointers %7.3fs %7.0f MB/s   scan: %8zu paths %7.3fs%s\n",
+                    threads, pointers, tm, static_cast<double>(size >> 20) / tm, paths, ts, paths == serial ? "" : "  MISMATCH");
+    }
+    return 0;
+}
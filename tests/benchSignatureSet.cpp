@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "patternScanner.h"
+#include "signatureSet.h"
+
+// One SignatureSet pass against one PatternScanner pass per signature, over the same buffer.
+// Usage: benchSignatureSet [signatures] [corpus size in MB]
+// The corpus is synthetic bytes skewed like x86 code; signatures are 8..32 byte slices of it with
+// some wildcards, so every signature has hits.
+
+using namespace RoboDBG;
+
+template<typename F>
+static double timeIt(F&& fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main( int argc, char** argv ) {
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+    const size_t size = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64) << 20;
+
+    static constexpr BYTE common[] = { 0x00, 0x00, 0x00, 0x48, 0x8B, 0x89, 0xCC, 0xFF, 0x24, 0x44, 0x0F, 0xE8, 0x83, 0x85 };
+    std::mt19937_64 rng(1);
+    std::vector<BYTE> corpus(size);
+    for (auto& b : corpus) {
+        const uint64_t r = rng();
+        b = (r & 1) ? common[(r >> 8) % sizeof(common)] : static_cast<BYTE>(r >> 16);
+    }
+
+    SignatureSet set;
+    std::vector<BytePattern_t> patterns;
+    for (size_t n = 0; n < count; ++n) {
+        const size_t len = 8 + rng() % 25;
+        const size_t at = rng() % (corpus.size() - len);
+        BytePattern_t p = BytePattern_t::exact(std::span<const BYTE>(corpus.data() + at, len));
+        for (size_t j = 1; j < len; j += 3 + rng() % 6) { p.mask[j] = 0; p.value[j] = 0; }
+        patterns.push_back(p);
+        set.add(p);
+    }
+
+    const double tc = timeIt([&] { set.compile(); });
+    const std::string path = (std::filesystem::temp_directory_path() / "benchSignatureSet.bin").string();
+    SignatureSet loaded;
+    const double ts = timeIt([&] { set.save(path); });
+    const double tl = timeIt([&] { loaded.load(path); });
+    std::printf("[*] %zu signatures, %zu MB corpus, %zu states (%zu KB table)\n", count, size >> 20,
+                set.states(), set.states() * 256 * sizeof(uint32_t) >> 10);
+    std::printf("  compile %.3fs  save %.3fs  load %.3fs (%zu KB file)\n", tc, ts, tl,
+                static_cast<size_t>(std::filesystem::file_size(path) >> 10));
+    std::filesystem::remove(path);
+
+    const double mb = static_cast<double>(size) / (1 << 20);
+    std::vector<SignatureMatch_t> matches;
+    const double tm = timeIt([&] { loaded.scan(corpus.data(), corpus.size(), 0, matches); });
+    std::printf("  %-22s hits=%-8zu %7.3fs %7.0f MB/s\n", "SignatureSet", matches.size(), tm, mb / tm);
+
+    size_t hits = 0;
+    const double tp = timeIt([&] {
+        std::vector<uintptr_t> out;
+        for (const BytePattern_t& p : patterns) {
+            out.clear();
+            hits += PatternScanner(p).scan(corpus.data(), corpus.size(), 0, out);
+        }
+    });
+    std::printf("  %-22s hits=%-8zu %7.3fs %7.0f MB/s%s\n", "PatternScanner x N", hits, tp, mb / tp,
+                hits == matches.size() ? "" : "  MISMATCH");
+    return 0;
+}
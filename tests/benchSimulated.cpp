@@ -0,0 +1,307 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "debugger.h"
+#include "backends/simulatedBackend.h"
+
+// Breakpoint throughput of the Debugger event loop against the simulated target.
+// Usage: benchSimulated [passes]
+// The replay is deterministic; the "events" column must match across commits for the same passes.
+
+using namespace RoboDBG;
+
+constexpr uintptr_t IMAGE_BASE  = 0x0000000140000000ULL;
+constexpr uintptr_t ENTRY_POINT = IMAGE_BASE + 0x1000;
+constexpr int LOOP_BODY = 16;
+
+enum class Scenario {
+    SOFTWARE_RESTORE,  ///< int3 on every 4th instruction, RESTORE
+    SOFTWARE_MANY,     ///< int3 on every instruction, RESTORE
+    HARDWARE_RESTORE,  ///< DR0 execute breakpoint, RESTORE
+    DISPLACED_RESTORE, ///< SOFTWARE_RESTORE with displaced stepping
+};
+
+class BenchDebugger : public Debugger {
+private:
+    Scenario scenario;
+public:
+    uint64_t hits = 0;
+
+    BenchDebugger( Scenario s, std::unique_ptr<SimulatedBackend> backend, bool metrics = false, bool trace = false )
+        : Debugger(std::move(backend)), scenario(s) {
+        setMetrics(metrics);
+        setTracing(trace); // kept in memory; nothing is written
+    }
+
+    MetricsSnapshot_t metrics( ) const { return getMetrics(); }
+    uint64_t traceDropped( ) const { return getTraceDropped(); }
+
+    const SimulatedBackend& sim( ) {
+        return static_cast<SimulatedBackend&>(getBackend());
+    }
+
+    void onStart( uintptr_t imageBase, uintptr_t entryPoint ) override {
+        switch (scenario) {
+            case Scenario::DISPLACED_RESTORE:
+                setDisplacedStepping(true);
+                [[fallthrough]];
+            case Scenario::SOFTWARE_RESTORE:
+                for (int i = 0; i < LOOP_BODY; i += 4) setBreakpoint(entryPoint + i);
+                break;
+            case Scenario::SOFTWARE_MANY:
+                for (int i = 0; i < LOOP_BODY; ++i) setBreakpoint(entryPoint + i);
+                break;
+            case Scenario::HARDWARE_RESTORE:
+                setHardwareBreakpoint(reinterpret_cast<LPVOID>(entryPoint + 8), DRReg::DR0, AccessType::EXECUTE, BreakpointLength::BYTE);
+                break;
+        }
+    }
+
+    BreakpointAction onBreakpoint( uintptr_t address, HANDLE hThread ) override {
+        ++hits;
+        return RESTORE;
+    }
+
+    BreakpointAction onHardwareBreakpoint( uintptr_t address, HANDLE hThread, DRReg reg ) override {
+        ++hits;
+        return RESTORE;
+    }
+};
+
+static void runScenario( const char* name, Scenario scenario, size_t passes, bool metrics = false, bool trace = false ) {
+    auto sim = std::make_unique<SimulatedBackend>();
+    sim->setImage("bench.exe", IMAGE_BASE, ENTRY_POINT);
+    sim->mapMemory(IMAGE_BASE, 0x2000, PAGE_EXECUTE_READ);
+
+    std::vector<SimEvent_t> script;
+    for (int i = 0; i < LOOP_BODY; ++i) {
+        script.push_back(SimEvent_t::execute(SimulatedBackend::MAIN_THREAD_ID, ENTRY_POINT + i));
+    }
+    sim->setScript(script, passes);
+
+    BenchDebugger dbg(scenario, std::move(sim), metrics, trace);
+    const SimulatedBackend& backend = dbg.sim();
+
+    auto t0 = std::chrono::steady_clock::now();
+    dbg.start("bench.exe");
+    dbg.loop();
+    auto t1 = std::chrono::steady_clock::now();
+
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    const SimStats_t& s = backend.getStats();
+    std::printf("%-18s hits=%-9llu events=%-9llu ctx r/w=%llu/%llu mem r/w=%llu/%llu  %.3fs  %.0f hits/s\n",
+                name,
+                (unsigned long long)dbg.hits, (unsigned long long)s.events,
+                (unsigned long long)s.contextReads, (unsigned long long)s.contextWrites,
+                (unsigned long long)s.memoryReads, (unsigned long long)s.memoryWrites,
+                secs, secs > 0 ? dbg.hits / secs : 0.0);
+    if (metrics) {
+        const LatencySummary_t stop = dbg.metrics().stoppedOf(DebugEventType::EXCEPTION);
+        std::printf("%-18s stopped per exception p50=%.2fus p99=%.2fus p99.9=%.2fus max=%.2fus\n", "",
+                    stop.p50Ns / 1e3, stop.p99Ns / 1e3, stop.p999Ns / 1e3, stop.maxNs / 1e3);
+    }
+    if (trace) std::printf("%-18s spans dropped=%llu\n", "", (unsigned long long)dbg.traceDropped());
+}
+
+// Arming cost at onStart: one setBreakpoint per address vs. one page-batched setBreakpoints
+class InstallDebugger : public Debugger {
+public:
+    bool bulk;
+    std::vector<uintptr_t> addresses;
+    double seconds = 0;
+
+    InstallDebugger( bool bulk, std::unique_ptr<SimulatedBackend> backend )
+        : Debugger(std::move(backend)), bulk(bulk) { }
+
+    const SimulatedBackend& sim( ) {
+        return static_cast<SimulatedBackend&>(getBackend());
+    }
+
+    void onStart( uintptr_t imageBase, uintptr_t entryPoint ) override {
+        auto t0 = std::chrono::steady_clock::now();
+        if (bulk) {
+            setBreakpoints(addresses);
+        } else {
+            for (uintptr_t a : addresses) setBreakpoint(a);
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+};
+
+static void runInstall( const char* name, bool bulk, size_t count ) {
+    constexpr SIZE_T TEXT_SIZE = 16u << 20;
+    auto sim = std::make_unique<SimulatedBackend>();
+    sim->setImage("bench.exe", IMAGE_BASE, ENTRY_POINT);
+    sim->mapMemory(ENTRY_POINT, TEXT_SIZE, PAGE_EXECUTE_READ);
+
+    InstallDebugger dbg(bulk, std::move(sim));
+    uint64_t x = 42; // xorshift; same addresses for both runs
+    for (size_t i = 0; i < count; ++i) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        dbg.addresses.push_back(ENTRY_POINT + x % TEXT_SIZE);
+    }
+
+    dbg.start("bench.exe");
+    dbg.loop();
+    const SimStats_t& s = dbg.sim().getStats();
+    std::printf("%-18s bps=%-9zu mem r/w=%llu/%llu  %.3fs\n", name, count,
+                (unsigned long long)s.memoryReads, (unsigned long long)s.memoryWrites, dbg.seconds);
+}
+
+// Attach-time noise: DLL loads with a debug string each, handled in full vs. masked out (setEventMask)
+class NoisyDebugger : public Debugger {
+public:
+    uint64_t callbacks = 0;
+
+    NoisyDebugger( uint32_t mask, std::unique_ptr<SimulatedBackend> backend )
+        : Debugger(std::move(backend)) {
+        setEventMask(mask);
+    }
+
+    const SimulatedBackend& sim( ) {
+        return static_cast<SimulatedBackend&>(getBackend());
+    }
+
+    bool onDLLLoad( uintptr_t address, std::string name, uintptr_t entryPoint ) override {
+        ++callbacks;
+        return false;
+    }
+
+    void onDebugString( std::string dbgString ) override {
+        ++callbacks;
+    }
+};
+
+static void runNoisy( const char* name, uint32_t mask, size_t dlls ) {
+    auto sim = std::make_unique<SimulatedBackend>();
+    sim->setImage("bench.exe", IMAGE_BASE, ENTRY_POINT);
+    sim->mapMemory(IMAGE_BASE, 0x2000, PAGE_EXECUTE_READ);
+
+    // Each DLL is a minimal PE image, so its size comes from the header
+    std::vector<SimEvent_t> script;
+    for (size_t i = 0; i < dlls; ++i) {
+        const uintptr_t base = 0x7FF800000000ULL + i * 0x10000;
+        const uint32_t lfanew = 0x80, sizeOfImage = 0x3000;
+        sim->mapMemory(base, 0x3000, PAGE_READONLY, 0);
+        sim->writeMemory(base, "MZ", 2);
+        sim->writeMemory(base + 0x3C, &lfanew, sizeof(lfanew));
+        sim->writeMemory(base + lfanew, "PE\0\0", 4);
+        sim->writeMemory(base + lfanew + 0x50, &sizeOfImage, sizeof(sizeOfImage));
+        script.push_back(SimEvent_t::loadDll(base, "lib" + std::to_string(i) + ".dll", base + 0x1000));
+        script.push_back(SimEvent_t::debugString(SimulatedBackend::MAIN_THREAD_ID, "initialized"));
+    }
+    sim->setScript(script);
+
+    NoisyDebugger dbg(mask, std::move(sim));
+    auto t0 = std::chrono::steady_clock::now();
+    dbg.start("bench.exe");
+    dbg.loop();
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    const SimStats_t& s = dbg.sim().getStats();
+    std::printf("%-18s events=%-6llu callbacks=%-6llu payload=%-6llu mem r=%-6llu regions=%-6llu  %.4fs\n", name,
+                (unsigned long long)s.events, (unsigned long long)dbg.callbacks, (unsigned long long)s.payloadReads,
+                (unsigned long long)s.memoryReads, (unsigned long long)s.regionQueries, secs);
+}
+
+// Target slowdown: time the target spends stopped while callbacks that take 20 us each (a Python handler)
+// run synchronously vs. on the event pump
+class StopTimedBackend : public SimulatedBackend {
+private:
+    std::chrono::steady_clock::time_point stoppedAt;
+public:
+    double stoppedSeconds = 0;
+
+    bool waitForEvent( DebugEvent_t& event, DWORD timeoutMs ) override {
+        const bool ok = SimulatedBackend::waitForEvent(event, timeoutMs);
+        stoppedAt = std::chrono::steady_clock::now();
+        return ok;
+    }
+
+    bool continueEvent( const DebugEvent_t& event, bool handled ) override {
+        stoppedSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - stoppedAt).count();
+        return SimulatedBackend::continueEvent(event, handled);
+    }
+};
+
+class SlowCallbackDebugger : public Debugger {
+public:
+    uint64_t callbacks = 0;
+
+    SlowCallbackDebugger( uint32_t async, EventPumpOptions_t options, std::unique_ptr<SimulatedBackend> backend )
+        : Debugger(std::move(backend)) {
+        setAsyncEvents(async, options);
+    }
+
+    const StopTimedBackend& sim( ) {
+        return static_cast<StopTimedBackend&>(getBackend());
+    }
+
+    EventPumpStats_t pumpStats( ) const {
+        return getEventPumpStats();
+    }
+
+    static void work( ) {
+        const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(20);
+        while (std::chrono::steady_clock::now() < until) { }
+    }
+
+    bool onDLLLoad( uintptr_t address, std::string name, uintptr_t entryPoint ) override {
+        work();
+        ++callbacks;
+        return true;
+    }
+
+    void onDebugString( std::string dbgString ) override {
+        work();
+        ++callbacks;
+    }
+};
+
+static void runAsync( const char* name, uint32_t async, EventPumpOptions_t options, size_t events ) {
+    auto sim = std::make_unique<StopTimedBackend>();
+    sim->setImage("bench.exe", IMAGE_BASE, ENTRY_POINT);
+    sim->mapMemory(IMAGE_BASE, 0x2000, PAGE_EXECUTE_READ);
+    std::vector<SimEvent_t> script;
+    for (size_t i = 0; i < events / 2; ++i) {
+        script.push_back(SimEvent_t::loadDll(0x7FF800000000ULL + i * 0x10000, "lib" + std::to_string(i) + ".dll", 0x1000));
+        script.push_back(SimEvent_t::debugString(SimulatedBackend::MAIN_THREAD_ID, "initialized"));
+    }
+    sim->setScript(script);
+
+    SlowCallbackDebugger dbg(async, options, std::move(sim));
+    auto t0 = std::chrono::steady_clock::now();
+    dbg.start("bench.exe");
+    dbg.loop();
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    const EventPumpStats_t pump = dbg.pumpStats();
+    std::printf("%-18s callbacks=%-6llu stopped=%.4fs (%.2f us/event) dropped=%-5llu blocked=%-5llu  %.4fs\n", name,
+                (unsigned long long)dbg.callbacks, dbg.sim().stoppedSeconds, 1e6 * dbg.sim().stoppedSeconds / events,
+                (unsigned long long)pump.dropped, (unsigned long long)pump.blocked, secs);
+}
+
+int main( int argc, char** argv ) {
+    size_t passes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+
+    std::cout << "[*] " << passes << " passes over a " << LOOP_BODY << " instruction loop\n";
+    runScenario("sw restore 1/4",  Scenario::SOFTWARE_RESTORE, passes);
+    runScenario("sw restore all",  Scenario::SOFTWARE_MANY,    passes);
+    runScenario("hw restore",      Scenario::HARDWARE_RESTORE, passes);
+    runScenario("sw displaced 1/4", Scenario::DISPLACED_RESTORE, passes);
+    runScenario("sw 1/4 +metrics",  Scenario::SOFTWARE_RESTORE, passes, true);
+    runScenario("hw +metrics",      Scenario::HARDWARE_RESTORE, passes, true);
+    runScenario("sw 1/4 +trace",    Scenario::SOFTWARE_RESTORE, passes, false, true);
+    runInstall("install single",   false, 20000);
+    runInstall("install batched",  true,  20000);
+    runNoisy("300 dlls all",       EVENT_ALL, 300);
+    runNoisy("300 dlls masked",    EVENT_START | EVENT_END, 300);
+    runAsync("sync callbacks",     EVENT_NONE, EventPumpOptions_t{}, 20000);
+    runAsync("async callbacks",    EVENT_INFORMATIONAL, EventPumpOptions_t{ 32768 }, 20000);
+    runAsync("async block 256",    EVENT_INFORMATIONAL, EventPumpOptions_t{ 256 }, 20000);
+    runAsync("async drop 256",     EVENT_INFORMATIONAL, EventPumpOptions_t{ 256, OverflowPolicy::DROP }, 20000);
+    return 0;
+}
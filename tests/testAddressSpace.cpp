@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "addressSpace.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    lookupAgainstLinear,
+    updateSplitsRegions,
+    updateGrowsToFreshRegions,
+    filters,
+    modules,
+    overlappingRange,
+    Size
+};
+
+constexpr uintptr_t PAGE = 0x1000;
+
+static MemoryRegion_t region( uintptr_t base, SIZE_T size, DWORD protect = PAGE_READWRITE,
+                              DWORD state = MEM_COMMIT, DWORD type = MEM_PRIVATE ) {
+    return MemoryRegion_t{ reinterpret_cast<LPVOID>(base), size, state, protect, type };
+}
+
+static uintptr_t baseOf( const MemoryRegion_t& r ) { return reinterpret_cast<uintptr_t>(r.BaseAddress); }
+
+static bool same( const MemoryRegion_t& a, const MemoryRegion_t& b ) {
+    return a.BaseAddress == b.BaseAddress && a.RegionSize == b.RegionSize && a.State == b.State
+        && a.Protect == b.Protect && a.Type == b.Type;
+}
+
+// Regions sorted, non-overlapping and without empty ones
+static bool wellFormed( const AddressSpace& space ) {
+    const auto regions = space.regions();
+    for (size_t i = 0; i < regions.size(); ++i) {
+        if (!regions[i].RegionSize) return false;
+        if (i && baseOf(regions[i - 1]) + regions[i - 1].RegionSize > baseOf(regions[i])) return false;
+    }
+    return true;
+}
+
+// Random regions with gaps between some of them, shuffled
+static std::vector<MemoryRegion_t> scatter( std::mt19937& rng, size_t count ) {
+    std::vector<MemoryRegion_t> out;
+    uintptr_t at = 0x10000;
+    for (size_t i = 0; i < count; ++i) {
+        if (rng() % 3 == 0) at += PAGE * (1 + rng() % 4);
+        const SIZE_T size = PAGE * (1 + rng() % 16);
+        out.push_back(region(at, size, (rng() & 1) ? PAGE_READWRITE : PAGE_READONLY));
+        at += size;
+    }
+    std::shuffle(out.begin(), out.end(), rng);
+    return out;
+}
+
+static bool run( TestCase tc ) {
+    std::mt19937 rng(11);
+
+    switch (tc) {
+        case TestCase::lookupAgainstLinear: {
+            const std::vector<MemoryRegion_t> regions = scatter(rng, 2000);
+            AddressSpace space;
+            if (space.built() || space.find(0x10000)) return false;
+            space.assign(regions);
+            if (!space.built() || !wellFormed(space) || space.regions().size() != regions.size()) return false;
+
+            const uintptr_t top = baseOf(space.regions().back()) + space.regions().back().RegionSize;
+            for (int n = 0; n < 20000; ++n) {
+                const uintptr_t address = rng() % (top + PAGE);
+                const MemoryRegion_t* expected = nullptr;
+                for (const MemoryRegion_t& r : regions) {
+                    if (address >= baseOf(r) && address < baseOf(r) + r.RegionSize) expected = &r;
+                }
+                const MemoryRegion_t* got = space.find(address);
+                if (!expected != !got) return false;
+                if (got && !same(*got, *expected)) return false;
+            }
+            return true;
+        }
+        case TestCase::updateSplitsRegions: {
+            AddressSpace space;
+            space.assign({ region(0x10000, 0x10000), region(0x20000, 0x4000, PAGE_READONLY) });
+            const uint64_t generation = space.generation();
+
+            // Protection changed on two pages in the middle of the first region
+            space.update(0x14000, 0x2000, std::vector<MemoryRegion_t>{ region(0x14000, 0x2000, PAGE_EXECUTE_READ) });
+            const auto regions = space.regions();
+            return space.generation() > generation && wellFormed(space) && regions.size() == 4
+                && same(regions[0], region(0x10000, 0x4000))
+                && same(regions[1], region(0x14000, 0x2000, PAGE_EXECUTE_READ))
+                && same(regions[2], region(0x16000, 0xA000))
+                && same(regions[3], region(0x20000, 0x4000, PAGE_READONLY));
+        }
+        case TestCase::updateGrowsToFreshRegions: {
+            AddressSpace space;
+            space.assign({ region(0x10000, 0x2000), region(0x14000, 0x2000), region(0x18000, 0x2000) });
+
+            // A query for one page reports the whole (merged) region around it, which swallows two old ones
+            space.update(0x15000, 1, std::vector<MemoryRegion_t>{ region(0x12000, 0x8000, PAGE_READONLY) });
+            auto regions = space.regions();
+            if (!wellFormed(space) || regions.size() != 2
+                || !same(regions[0], region(0x10000, 0x2000)) || !same(regions[1], region(0x12000, 0x8000, PAGE_READONLY))) {
+                return false;
+            }
+
+            // Unmapped: no fresh regions, the range just empties; a new mapping past the end is added
+            space.update(0x12000, 0x8000, {});
+            space.update(0x40000, 0x1000, std::vector<MemoryRegion_t>{ region(0x40000, 0x1000) });
+            regions = space.regions();
+            return wellFormed(space) && regions.size() == 2 && !space.find(0x15000)
+                && same(regions[1], region(0x40000, 0x1000)) && space.find(0x40FFF) && !space.find(0x41000);
+        }
+        case TestCase::filters: {
+            AddressSpace space;
+            space.assign({
+                region(0x10000, PAGE, PAGE_READWRITE),
+                region(0x11000, PAGE, PAGE_READONLY, MEM_COMMIT, MEM_IMAGE),
+                region(0x12000, PAGE, PAGE_EXECUTE_READ, MEM_COMMIT, MEM_IMAGE),
+                region(0x13000, PAGE, PAGE_NOACCESS),
+                region(0x14000, PAGE, PAGE_READWRITE | PAGE_GUARD),
+                region(0x15000, PAGE, PAGE_READWRITE, MEM_RESERVE),
+                region(0x16000, PAGE, PAGE_NOACCESS, MEM_FREE, 0),
+                region(0x17000, PAGE, PAGE_EXECUTE_READWRITE),
+            });
+            auto bases = [&](uint32_t filter) {
+                std::vector<uintptr_t> out;
+                for (const MemoryRegion_t& r : space.select(filter)) out.push_back(baseOf(r));
+                return out;
+            };
+            return bases(REGION_ANY).size() == 8
+                && bases(REGION_COMMITTED) == std::vector<uintptr_t>{ 0x10000, 0x11000, 0x12000, 0x13000, 0x14000, 0x17000 }
+                && bases(REGION_READABLE) == std::vector<uintptr_t>{ 0x10000, 0x11000, 0x12000, 0x17000 }
+                && bases(REGION_READABLE | REGION_WRITABLE) == std::vector<uintptr_t>{ 0x10000, 0x17000 }
+                && bases(REGION_EXECUTABLE) == std::vector<uintptr_t>{ 0x12000, 0x17000 }
+                && bases(REGION_READABLE | REGION_IMAGE) == std::vector<uintptr_t>{ 0x11000, 0x12000 };
+        }
+        case TestCase::modules: {
+            AddressSpace space;
+            space.addModule(Module_t{ 0x400000, 0x3000, "main.exe" });
+            space.addModule(Module_t{ 0x7FF000000000, 0x10000, "kernel32.dll" });
+            space.addModule(Module_t{ 0x500000, 0, "empty.dll" }); // ignored
+            if (space.modules().size() != 2) return false;
+
+            const Module_t* m = space.findModule(0x400000);
+            if (!m || m->name != "main.exe" || !space.findModule(0x402FFF) || space.findModule(0x403000) || space.findModule(0x3FFFFF)) {
+                return false;
+            }
+            m = space.findModule(0x7FF00000FFFF);
+            if (!m || m->name != "kernel32.dll") return false;
+
+            // Reloaded at an overlapping base: the stale module goes
+            const uint64_t generation = space.generation();
+            space.addModule(Module_t{ 0x401000, 0x4000, "main2.exe" });
+            m = space.findModule(0x400000);
+            if (m || space.modules().size() != 2 || space.generation() == generation) return false;
+            m = space.findModule(0x404FFF);
+            if (!m || m->name != "main2.exe") return false;
+
+            if (space.removeModule(0x402000) || !space.removeModule(0x401000) || space.findModule(0x402000)) return false;
+            space.clear();
+            return space.modules().empty() && !space.findModule(0x7FF000000000) && !space.built();
+        }
+        case TestCase::overlappingRange: {
+            AddressSpace space;
+            space.assign({ region(0x10000, 0x2000), region(0x14000, 0x2000), region(0x18000, 0x2000) });
+            auto range = [&](uintptr_t address, SIZE_T size) {
+                std::vector<uintptr_t> out;
+                for (const MemoryRegion_t& r : space.overlapping(address, size)) out.push_back(baseOf(r));
+                return out;
+            };
+            return range(0x11FFF, 1) == std::vector<uintptr_t>{ 0x10000 }
+                && range(0x12000, 0x2000).empty()
+                && range(0x11000, 0x3001) == std::vector<uintptr_t>{ 0x10000, 0x14000 }
+                && range(0x0, 0x100000).size() == 3
+                && range(0x1A000, 0x1000).empty();
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
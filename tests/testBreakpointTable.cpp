@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "breakpointTable.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    insertFind,
+    updateOriginal,
+    eraseChains,
+    randomAgainstMap,
+    sortedIteration,
+    eraseWhileIterating,
+    rejectNull,
+    movedFrom,
+    Size
+};
+
+static bool run( TestCase tc ) {
+    switch(tc) {
+        case TestCase::insertFind: {
+            BreakpointTable t;
+            for (uintptr_t a = 0x401000; a < 0x401000 + 1000; ++a) t.insert(a, static_cast<uint8_t>(a));
+            if (t.size() != 1000) return false;
+            for (uintptr_t a = 0x401000; a < 0x401000 + 1000; ++a) {
+                const Breakpoint_t* e = t.find(a);
+                if (!e || e->original != static_cast<uint8_t>(a) || e->hits != 0) return false;
+            }
+            return !t.find(0x400FFF) && !t.find(0x401000 + 1000) && t.capacity() >= 1000 * 4 / 3;
+        }
+        case TestCase::updateOriginal: {
+            BreakpointTable t;
+            t.insert(0x1000, 0x55)->hits = 3;
+            t.insert(0x1000, 0x90);
+            const Breakpoint_t* e = t.find(0x1000);
+            return t.size() == 1 && e && e->original == 0x90 && e->hits == 3;
+        }
+        case TestCase::eraseChains: {
+            // 12 entries in 16 slots form probe chains; erasing from the middle must keep the rest reachable
+            BreakpointTable t(8);
+            std::vector<uintptr_t> addrs;
+            for (uintptr_t i = 1; i <= 12; ++i) addrs.push_back(0x1000 + i * 0x10);
+            for (uintptr_t a : addrs) t.insert(a, 1);
+            for (size_t i = 0; i < addrs.size(); i += 2) if (!t.erase(addrs[i])) return false;
+            for (size_t i = 0; i < addrs.size(); ++i) {
+                if ((t.find(addrs[i]) != nullptr) != (i % 2 == 1)) return false;
+            }
+            return t.size() == 6 && !t.erase(addrs[0]);
+        }
+        case TestCase::randomAgainstMap: {
+            std::mt19937_64 rng(1234);
+            BreakpointTable t;
+            std::map<uintptr_t, uint8_t> ref;
+            for (int i = 0; i < 200000; ++i) {
+                uintptr_t a = 0x140000000ULL + (rng() % 4096);
+                switch (rng() % 3) {
+                    case 0: t.insert(a, static_cast<uint8_t>(i)); ref[a] = static_cast<uint8_t>(i); break;
+                    case 1: if (t.erase(a) != (ref.erase(a) == 1)) return false; break;
+                    case 2: {
+                        const Breakpoint_t* e = t.find(a);
+                        auto it = ref.find(a);
+                        if ((e != nullptr) != (it != ref.end())) return false;
+                        if (e && e->original != it->second) return false;
+                    }
+                }
+            }
+            return t.size() == ref.size();
+        }
+        case TestCase::sortedIteration: {
+            BreakpointTable t;
+            std::vector<uintptr_t> expected = { 0x10, 0x20, 0x7FF000, 0x401000, 0x140001000ULL };
+            for (auto it = expected.rbegin(); it != expected.rend(); ++it) t.insert(*it, 0);
+            std::sort(expected.begin(), expected.end());
+            return t.addresses() == expected;
+        }
+        case TestCase::eraseWhileIterating: {
+            BreakpointTable t;
+            for (uintptr_t a = 1; a <= 100; ++a) t.insert(a, 0);
+            int visited = 0;
+            t.forEach([&](Breakpoint_t& e) {
+                ++visited;
+                if (e.address % 2 == 1) t.erase(e.address + 1); // erase the next one before it is visited
+            });
+            return visited == 50 && t.size() == 50;
+        }
+        case TestCase::rejectNull: {
+            BreakpointTable t;
+            return t.insert(0, 0xCC) == nullptr && t.empty() && !t.find(0);
+        }
+        case TestCase::movedFrom: {
+            // Both move operations leave the source empty: lookups, iteration and inserts still work
+            BreakpointTable a;
+            for (uintptr_t x = 0x1000; x < 0x1000 + 100; ++x) a.insert(x, 0x90);
+            BreakpointTable b(std::move(a));
+            if (b.size() != 100 || !b.contains(0x1010) || !a.empty() || a.contains(0x1010)
+                || !a.addresses().empty() || a.erase(0x1010)) return false;
+            a.clear();
+            if (!a.insert(0x2000, 0x55) || !a.contains(0x2000) || a.size() != 1) return false;
+
+            BreakpointTable c;
+            c.insert(0x3000, 0x90);
+            c = std::move(b);
+            if (c.size() != 100 || c.contains(0x3000) || !b.empty() || b.find(0x1010) || !b.addresses().empty()) return false;
+            b.reserve(10);
+            b.insert(0x4000, 0xCC);
+            return b.size() == 1 && b.addresses() == std::vector<uintptr_t>{ 0x4000 };
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "bytePatch.h"
+#include "backends/simulatedBackend.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+constexpr uintptr_t TEXT = 0x401000;
+
+enum TestCase {
+    onePassPerPage,
+    unchangedPageNotWritten,
+    onlyIfMatching,
+    unmappedPage,
+    duplicateAddresses,
+    Size
+};
+
+static BYTE byteAt( SimulatedBackend& sim, uintptr_t address ) {
+    BYTE b = 0;
+    sim.readMemory(address, &b, 1);
+    return b;
+}
+
+static bool run( TestCase tc ) {
+    SimulatedBackend sim;
+    sim.mapMemory(TEXT, 0x3000, PAGE_EXECUTE_READ, 0x90);
+
+    switch(tc) {
+        case TestCase::onePassPerPage: {
+            // 300 addresses over three pages, given out of order
+            std::vector<BytePatch_t> patches;
+            for (int i = 299; i >= 0; --i) patches.push_back(BytePatch_t{ TEXT + i * 40, 0xCC });
+            BytePatchStats_t stats;
+            size_t n = applyBytePatches(sim, patches, -1, &stats);
+            const SimStats_t& s = sim.getStats();
+            bool ok = n == 300 && stats.pages == 3 && stats.reads == 3 && stats.writes == 3
+                   && s.memoryReads == 3 && s.memoryWrites == 3;
+            for (int i = 0; i < 300; ++i) ok = ok && byteAt(sim, TEXT + i * 40) == 0xCC;
+            ok = ok && byteAt(sim, TEXT + 1) == 0x90 && patches[0].address == TEXT && patches[0].previous == 0x90;
+            return ok;
+        }
+        case TestCase::unchangedPageNotWritten: {
+            std::vector<BytePatch_t> patches = { { TEXT, 0x90 }, { TEXT + 0x1000, 0xCC } };
+            BytePatchStats_t stats;
+            size_t n = applyBytePatches(sim, patches, -1, &stats);
+            return n == 2 && stats.reads == 2 && stats.writes == 1;
+        }
+        case TestCase::onlyIfMatching: {
+            BYTE int3 = 0xCC;
+            sim.writeMemory(TEXT + 1, &int3, 1);
+            std::vector<BytePatch_t> patches = { { TEXT, 0x55 }, { TEXT + 1, 0x55 } };
+            size_t n = applyBytePatches(sim, patches, 0xCC);
+            return n == 1 && !patches[0].applied && patches[1].applied && patches[1].previous == 0xCC
+                && byteAt(sim, TEXT) == 0x90 && byteAt(sim, TEXT + 1) == 0x55;
+        }
+        case TestCase::unmappedPage: {
+            std::vector<BytePatch_t> patches = { { TEXT + 0x10, 0xCC }, { 0x900000, 0xCC }, { 0x900010, 0xCC } };
+            size_t n = applyBytePatches(sim, patches);
+            return n == 1 && patches[0].applied && !patches[1].applied && !patches[2].applied;
+        }
+        case TestCase::duplicateAddresses: {
+            std::vector<BytePatch_t> patches = { { TEXT + 5, 0xCC }, { TEXT + 5, 0xCC } };
+            size_t n = applyBytePatches(sim, patches);
+            return n == 2 && patches[0].previous == 0x90 && patches[1].previous == 0xCC;
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#include <cstdio>
+#include <iostream>
+
+#include "debugRegisters.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    setFields,
+    clearSlot,
+    findEnabled,
+    hitFromDr6,
+    contextRoundTrip,
+    Size
+};
+
+static bool run( TestCase tc ) {
+    switch(tc) {
+        case TestCase::setFields: {
+            DebugRegisters_t dr;
+            if (!dr.set(1, 0x1000, 0b01, 0b11) || !dr.set(3, 0x2000, 0b11, 0b10)) return false;
+            // L1 | L3, R/W1=01 LEN1=11, R/W3=11 LEN3=10
+            const DWORD64 expected = (1ULL << 2) | (1ULL << 6) | (0xDULL << 20) | (0xBULL << 28);
+            return dr.dr7 == expected && dr.address[1] == 0x1000 && dr.address[3] == 0x2000
+                && dr.enabled(1) && dr.enabled(3) && !dr.enabled(0) && !dr.enabled(2)
+                && dr.type(1) == 0b01 && dr.length(1) == 0b11 && dr.type(3) == 0b11 && dr.length(3) == 0b10
+                && !dr.set(4, 0x3000, 0, 0) && !dr.set(-1, 0x3000, 0, 0);
+        }
+        case TestCase::clearSlot: {
+            DebugRegisters_t dr;
+            dr.set(0, 0x1000, 0, 0);
+            dr.set(2, 0x2000, 0b01, 0b01);
+            dr.set(2, 0x2000, 0b11, 0b00); // re-setting replaces the fields
+            if (dr.type(2) != 0b11 || dr.length(2) != 0) return false;
+            dr.clear(2);
+            return dr.dr7 == 1 && dr.address[2] == 0 && dr.address[0] == 0x1000 && !dr.clear(4);
+        }
+        case TestCase::findEnabled: {
+            DebugRegisters_t dr;
+            dr.set(2, 0x1000, 0, 0);
+            dr.address[1] = 0x2000; // address without enable bit
+            return dr.find(0x1000) == 2 && dr.find(0x2000) == -1 && dr.find(0) == -1;
+        }
+        case TestCase::hitFromDr6: {
+            DebugRegisters_t dr;
+            dr.set(1, 0x1000, 0b01, 0b11);
+            dr.set(3, 0x2000, 0b11, 0b10);
+            constexpr DWORD64 BS = 1ULL << 14;
+            // B bits of disabled slots are ignored; a plain trap flag step names no slot
+            return dr.hitSlot(1ULL << 1) == 1 && dr.hitSlot(1ULL << 3) == 3
+                && dr.hitSlot((1ULL << 0) | (1ULL << 3)) == 3 && dr.hitSlot(1ULL << 2) == -1
+                && dr.hitSlot(BS) == -1 && dr.hitSlot(0) == -1 && dr.hitSlot(BS | (1ULL << 1)) == 1;
+        }
+        case TestCase::contextRoundTrip: {
+            ThreadContext_t ctx;
+            ctx.dr[0] = 0x1111;
+            ctx.dr[6] = 0xFFFF0FF1;
+            ctx.dr[7] = 0x401; // bit 10 is reserved-set, L0
+            DebugRegisters_t dr;
+            dr.load(ctx);
+            dr.set(1, 0x2222, 0, 0);
+            dr.store(ctx);
+            return ctx.dr[0] == 0x1111 && ctx.dr[1] == 0x2222 && ctx.dr[6] == 0xFFFF0FF1
+                && ctx.dr[7] == (0x401ULL | (1ULL << 2)) && dr.find(0x1111) == 0;
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "eventInfo.h"
+#include "backends/simulatedBackend.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    parseHeaders,
+    rejectMalformed,
+    lazyReads,
+    longDosStub,
+    notAnImage,
+    exceptionRecord,
+    Size
+};
+
+constexpr uintptr_t DLL = 0x7FF800000000ULL;
+
+template<typename T>
+static void put( std::vector<BYTE>& image, size_t offset, T value ) {
+    std::memcpy(image.data() + offset, &value, sizeof(T));
+}
+
+// MZ header, PE signature and the optional header fields EventInfo reads
+static std::vector<BYTE> peImage( bool pe64, uint32_t lfanew = 0x80 ) {
+    std::vector<BYTE> image(0x1000);
+    put<uint16_t>(image, 0, 0x5A4D);
+    put<uint32_t>(image, 0x3C, lfanew);
+    put<uint32_t>(image, lfanew, 0x00004550);
+    put<uint16_t>(image, lfanew + 0x04, pe64 ? 0x8664 : 0x14C);
+    put<uint16_t>(image, lfanew + 0x06, 5);
+    put<uint32_t>(image, lfanew + 0x08, 0x12345678);
+    put<uint16_t>(image, lfanew + 0x16, 0x2022);
+    put<uint16_t>(image, lfanew + 0x18, pe64 ? 0x20B : 0x10B);
+    put<uint32_t>(image, lfanew + 0x28, 0x1A30);
+    if (pe64) put<uint64_t>(image, lfanew + 0x30, 0x180000000ULL);
+    else put<uint32_t>(image, lfanew + 0x34, 0x10000000);
+    put<uint32_t>(image, lfanew + 0x50, 0x3000);
+    put<uint32_t>(image, lfanew + 0x54, 0x400);
+    put<uint16_t>(image, lfanew + 0x5C, 3);
+    put<uint16_t>(image, lfanew + 0x5E, 0x160);
+    return image;
+}
+
+static bool expected( const PeHeaders_t& pe, bool pe64 ) {
+    return pe.machine == (pe64 ? 0x8664 : 0x14C) && pe.sections == 5 && pe.timeDateStamp == 0x12345678
+        && pe.characteristics == 0x2022 && pe.is64() == pe64 && pe.entryPoint == 0x1A30
+        && pe.imageBase == (pe64 ? 0x180000000ULL : 0x10000000) && pe.sizeOfImage == 0x3000
+        && pe.sizeOfHeaders == 0x400 && pe.subsystem == 3 && pe.dllCharacteristics == 0x160;
+}
+
+static DebugEvent_t loadEvent( uintptr_t base ) {
+    DebugEvent_t event;
+    event.type = DebugEventType::LOAD_DLL;
+    event.imageBase = base;
+    event.imageName = base;
+    return event;
+}
+
+static void mapImage( SimulatedBackend& sim, const std::vector<BYTE>& image ) {
+    sim.mapMemory(DLL, 0x3000, PAGE_READONLY, 0);
+    sim.writeMemory(DLL, image.data(), image.size());
+}
+
+static bool run( TestCase tc ) {
+    switch(tc) {
+        case TestCase::parseHeaders: {
+            PeHeaders_t pe32, pe64;
+            const std::vector<BYTE> a = peImage(false), b = peImage(true);
+            return parsePeHeaders(a.data(), a.size(), pe32) && expected(pe32, false)
+                && parsePeHeaders(b.data(), b.size(), pe64) && expected(pe64, true);
+        }
+        case TestCase::rejectMalformed: {
+            PeHeaders_t pe;
+            std::vector<BYTE> mz = peImage(true), sig = mz, magic = mz, far = mz;
+            put<uint16_t>(mz, 0, 0x4D5A);
+            put<uint32_t>(sig, 0x80, 0x00004551);
+            put<uint16_t>(magic, 0x80 + 0x18, 0x107);
+            put<uint32_t>(far, 0x3C, 0xFFFFFFF0);
+            const std::vector<BYTE> good = peImage(true);
+            return !parsePeHeaders(mz.data(), mz.size(), pe) && !parsePeHeaders(sig.data(), sig.size(), pe)
+                && !parsePeHeaders(magic.data(), magic.size(), pe) && !parsePeHeaders(far.data(), far.size(), pe)
+                && !parsePeHeaders(good.data(), 0x80 + 0x50, pe) && !parsePeHeaders(good.data(), 0x20, pe);
+        }
+        case TestCase::lazyReads: {
+            SimulatedBackend sim;
+            mapImage(sim, peImage(true));
+            const DebugEvent_t raw = loadEvent(DLL);
+            const SimStats_t& s = sim.getStats();
+            const uint64_t reads = s.memoryReads;
+
+            EventInfo event(sim, raw);
+            if (s.memoryReads != reads || s.payloadReads != 0) return false;
+
+            // One header read serves the headers and the entry point; the name is asked for once
+            const PeHeaders_t* pe = event.peHeaders();
+            const bool ok = pe && expected(*pe, true) && event.peHeaders() == pe && event.entryPoint() == DLL + 0x1A30
+                && event.entryPoint() == DLL + 0x1A30 && &event.moduleName() == &event.moduleName()
+                && event.imageBase() == DLL && event.type() == DebugEventType::LOAD_DLL;
+            return ok && s.memoryReads - reads == 1 && s.payloadReads == 1;
+        }
+        case TestCase::longDosStub: {
+            // NT headers past the first 1 KB: read on their own
+            SimulatedBackend sim;
+            mapImage(sim, peImage(false, 0x600));
+            const DebugEvent_t raw = loadEvent(DLL);
+            EventInfo event(sim, raw);
+            const uint64_t reads = sim.getStats().memoryReads;
+            const PeHeaders_t* pe = event.peHeaders();
+            return pe && expected(*pe, false) && sim.getStats().memoryReads - reads == 2;
+        }
+        case TestCase::notAnImage: {
+            // No headers: the entry point comes from the backend, asked once
+            SimulatedBackend sim;
+            sim.mapMemory(DLL, 0x1000, PAGE_READWRITE);
+            const DebugEvent_t raw = loadEvent(DLL);
+            EventInfo event(sim, raw);
+            const bool ok = event.peHeaders() == nullptr && event.entryPoint() == 0 && event.entryPoint() == 0;
+            const DebugEvent_t unmapped = loadEvent(DLL + 0x10000);
+            EventInfo nothing(sim, unmapped);
+            return ok && sim.getStats().payloadReads == 1 && nothing.peHeaders() == nullptr;
+        }
+        case TestCase::exceptionRecord: {
+            SimulatedBackend sim;
+            DebugEvent_t raw;
+            raw.type = DebugEventType::EXCEPTION;
+            raw.threadId = 7;
+            raw.exceptionCode = EXCEPTION_ACCESS_VIOLATION;
+            raw.exceptionAddress = 0x401000;
+            raw.exceptionInfo[0] = 1;
+            raw.exceptionInfo[1] = 0xDEAD0000;
+            raw.firstChance = false;
+            EventInfo event(sim, raw);
+            const ExceptionRecord_t r = event.exception();
+            return r.code == EXCEPTION_ACCESS_VIOLATION && r.address == 0x401000 && r.info[0] == 1
+                && r.info[1] == 0xDEAD0000 && !r.firstChance && event.threadId() == 7 && &event.raw() == &raw
+                && sim.getStats().memoryReads == 0;
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "eventPump.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    ringOrder,
+    ringThreads,
+    pumpOrder,
+    dropWhenFull,
+    blockWhenFull,
+    callbackThrows,
+    Size
+};
+
+static QueuedEvent_t numbered( DWORD n ) {
+    QueuedEvent_t event;
+    event.raw.type = DebugEventType::DEBUG_STRING;
+    event.raw.threadId = n;
+    event.payload.debugString = std::to_string(n);
+    return event;
+}
+
+static bool testRingOrder() {
+    SpscRing<int> ring(5);
+    if (ring.capacity() != 8 || !ring.empty() || ring.front()) return false;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            int v = round * 8 + i;
+            if (!ring.push(std::move(v))) return false;
+        }
+        int extra = -1;
+        if (ring.push(std::move(extra)) || ring.size() != 8) return false;
+        for (int i = 0; i < 8; ++i) {
+            int* front = ring.front();
+            if (!front || *front != round * 8 + i) return false;
+            ring.pop();
+        }
+        if (!ring.empty()) return false;
+    }
+    return ring.poppedCount() == 24 && SpscRing<int>(0).capacity() == 2;
+}
+
+static bool testRingThreads() {
+    // Producer and consumer on two threads through a small ring: nothing lost, nothing reordered
+    constexpr uint64_t COUNT = 200000;
+    SpscRing<uint64_t> ring(16);
+    bool ordered = true;
+    std::thread consumer([&] {
+        for (uint64_t expected = 0; expected < COUNT; ) {
+            if (uint64_t* v = ring.front()) {
+                if (*v != expected) ordered = false;
+                ring.pop();
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (uint64_t i = 0; i < COUNT; ) {
+        uint64_t v = i;
+        if (ring.push(std::move(v))) ++i;
+        else std::this_thread::yield();
+    }
+    consumer.join();
+    return ordered && ring.empty();
+}
+
+static bool testPumpOrder() {
+    constexpr DWORD COUNT = 50000;
+    std::vector<DWORD> seen;
+    std::thread::id consumer;
+    {
+        EventPump pump(EventPumpOptions_t{ 8, OverflowPolicy::BLOCK }, [&](QueuedEvent_t& event) {
+            consumer = std::this_thread::get_id();
+            if (event.payload.debugString != std::to_string(event.raw.threadId)) return;
+            seen.push_back(event.raw.threadId);
+        });
+        for (DWORD i = 0; i < COUNT; ++i) {
+            if (!pump.push(numbered(i))) return false;
+        }
+        pump.drain();
+        const EventPumpStats_t stats = pump.stats();
+        if (stats.queued != COUNT || stats.delivered != COUNT || stats.dropped || stats.maxDepth > 8) return false;
+        if (seen.size() != COUNT || consumer == std::this_thread::get_id()) return false;
+
+        // Sleeps between events and wakes for the next
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        pump.push(numbered(COUNT));
+        pump.drain();
+    }
+    for (DWORD i = 0; i <= COUNT; ++i) {
+        if (seen[i] != i) return false;
+    }
+    return true;
+}
+
+static bool testDropWhenFull() {
+    std::vector<DWORD> seen;
+    EventPump pump(EventPumpOptions_t{ 4, OverflowPolicy::DROP }, [&](QueuedEvent_t& event) {
+        seen.push_back(event.raw.threadId);
+    });
+    {
+        // A callback running elsewhere holds the consumer up
+        std::lock_guard<std::mutex> busy(pump.callbackMutex());
+        for (DWORD i = 0; i < 10; ++i) pump.push(numbered(i));
+    }
+    pump.drain();
+    const EventPumpStats_t stats = pump.stats();
+    // A slot is only released once its callback returned: four queued, the rest dropped
+    return stats.dropped == 6 && stats.queued == 4 && stats.delivered == 4
+        && seen == std::vector<DWORD>{ 0, 1, 2, 3 } && stats.blocked == 0;
+}
+
+static bool testBlockWhenFull() {
+    std::atomic<int> inCallback{ 0 };
+    bool overlapped = false;
+    std::vector<DWORD> seen;
+    EventPump pump(EventPumpOptions_t{ 2, OverflowPolicy::BLOCK }, [&](QueuedEvent_t& event) {
+        if (inCallback.fetch_add(1) != 0) overlapped = true;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        seen.push_back(event.raw.threadId);
+        inCallback.fetch_sub(1);
+    });
+    for (DWORD i = 0; i < 40; ++i) {
+        pump.push(numbered(i));
+        if (i % 8 == 0) {
+            // A callback run by the producer never overlaps the consumer's
+            std::lock_guard<std::mutex> lock(pump.callbackMutex());
+            if (inCallback.fetch_add(1) != 0) overlapped = true;
+            inCallback.fetch_sub(1);
+        }
+    }
+    pump.drain();
+    const EventPumpStats_t stats = pump.stats();
+    bool ordered = seen.size() == 40;
+    for (DWORD i = 0; ordered && i < 40; ++i) ordered = seen[i] == i;
+    return ordered && !overlapped && stats.blocked > 0 && stats.dropped == 0 && stats.maxDepth <= 2;
+}
+
+static bool testCallbackThrows() {
+    int delivered = 0;
+    EventPump pump(EventPumpOptions_t{}, [&](QueuedEvent_t& event) {
+        ++delivered;
+        if (event.raw.threadId == 1) throw std::runtime_error("callback error");
+    });
+    for (DWORD i = 0; i < 3; ++i) pump.push(numbered(i));
+    pump.drain();
+    return delivered == 3 && pump.stats().delivered == 3;
+}
+
+static bool run( TestCase tc ) {
+    switch(tc) {
+        case TestCase::ringOrder:      return testRingOrder();
+        case TestCase::ringThreads:    return testRingThreads();
+        case TestCase::pumpOrder:      return testPumpOrder();
+        case TestCase::dropWhenFull:   return testDropWhenFull();
+        case TestCase::blockWhenFull:  return testBlockWhenFull();
+        case TestCase::callbackThrows: return testCallbackThrows();
+        default: return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,338 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "instructionDecoder.h"
+
+#if defined(__linux__) && defined(__x86_64__)
+#include <sys/mman.h>
+#define ROBODBG_TEST_EXECUTE 1 // relocated code is run in-process
+#endif
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    lengths64,
+    lengths32,
+    truncated,
+    ripRelative,
+    relocateFar,
+    notRelocatable,
+    executeRelocated,
+    Size
+};
+
+struct LengthCase_t {
+    std::vector<BYTE> bytes;
+    size_t length;
+    uint16_t flags; // flags that must be set
+};
+
+static bool checkLengths( const std::vector<LengthCase_t>& cases, bool x64 ) {
+    bool ok = true;
+    for (const auto& c : cases) {
+        std::vector<BYTE> code = c.bytes;
+        code.resize(MAX_INSTRUCTION_LENGTH, 0x90); // trailing bytes must not be consumed
+        DecodedInstruction_t insn;
+        const bool decoded = decodeInstruction(code.data(), code.size(), x64, insn);
+        if (!decoded || insn.length != c.length || (insn.flags & c.flags) != c.flags) {
+            std::cout << "    length mismatch for";
+            for (BYTE b : c.bytes) std::printf(" %02X", b);
+            std::cout << ": got " << int(insn.length) << " expected " << c.length << "\n";
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+static bool lengths64Case( ) {
+    const std::vector<LengthCase_t> cases = {
+        { { 0x90 }, 1, 0 },                                                     // nop
+        { { 0x55 }, 1, 0 },                                                     // push rbp
+        { { 0x48, 0x89, 0xE5 }, 3, INSN_MODRM },                                // mov rbp, rsp
+        { { 0x48, 0x83, 0xEC, 0x20 }, 4, 0 },                                   // sub rsp, 0x20
+        { { 0x48, 0x81, 0xEC, 0x00, 0x01, 0x00, 0x00 }, 7, 0 },                 // sub rsp, 0x100
+        { { 0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8 }, 10, 0 },                      // mov rax, imm64
+        { { 0x66, 0xB8, 0x34, 0x12 }, 4, 0 },                                   // mov ax, imm16
+        { { 0x8B, 0x44, 0x24, 0x08 }, 4, 0 },                                   // mov eax, [rsp+8]
+        { { 0x8B, 0x84, 0x24, 0x00, 0x01, 0x00, 0x00 }, 7, 0 },                 // mov eax, [rsp+0x100]
+        { { 0x8B, 0x04, 0x25, 0x00, 0x10, 0x00, 0x00 }, 7, 0 },                 // mov eax, [0x1000]
+        { { 0x8B, 0x05, 0x10, 0x00, 0x00, 0x00 }, 6, INSN_RIP_RELATIVE },       // mov eax, [rip+0x10]
+        { { 0xC7, 0x05, 1, 0, 0, 0, 2, 0, 0, 0 }, 10, INSN_RIP_RELATIVE },      // mov dword [rip+1], 2
+        { { 0x66, 0xC7, 0x05, 1, 0, 0, 0, 2, 0 }, 9, INSN_RIP_RELATIVE },       // mov word [rip+1], 2
+        { { 0xF6, 0x05, 1, 0, 0, 0, 0x80 }, 7, INSN_RIP_RELATIVE },             // test byte [rip+1], 0x80
+        { { 0xF7, 0xD8 }, 2, 0 },                                               // neg eax
+        { { 0xF7, 0xC1, 1, 0, 0, 0 }, 6, 0 },                                   // test ecx, 1
+        { { 0xE8, 0, 0, 0, 0 }, 5, INSN_REL_BRANCH | INSN_CALL },               // call rel32
+        { { 0x66, 0xE8, 0, 0, 0, 0 }, 6, INSN_REL_BRANCH | INSN_CALL },         // call rel32 (66 ignored)
+        { { 0xE9, 0, 0, 0, 0 }, 5, INSN_REL_BRANCH },                           // jmp rel32
+        { { 0xEB, 0x10 }, 2, INSN_REL_BRANCH },                                 // jmp rel8
+        { { 0x74, 0x10 }, 2, INSN_REL_BRANCH | INSN_CONDITIONAL },              // jz rel8
+        { { 0x0F, 0x84, 0, 1, 0, 0 }, 6, INSN_REL_BRANCH | INSN_CONDITIONAL },  // jz rel32
+        { { 0xE2, 0xFE }, 2, INSN_REL_BRANCH | INSN_CONDITIONAL },              // loop
+        { { 0xFF, 0x15, 0, 0, 0, 0 }, 6, INSN_CALL | INSN_INDIRECT | INSN_RIP_RELATIVE }, // call [rip]
+        { { 0xFF, 0xE0 }, 2, INSN_INDIRECT },                                   // jmp rax
+        { { 0x41, 0xFF, 0xD3 }, 3, INSN_CALL | INSN_INDIRECT },                 // call r11
+        { { 0x0F, 0x1F, 0x44, 0x00, 0x00 }, 5, 0 },                             // nop dword [rax+rax]
+        { { 0x66, 0x0F, 0x1F, 0x84, 0, 0, 0, 0, 0 }, 9, 0 },                    // nop word [rax+rax+0]
+        { { 0xF3, 0x0F, 0x1E, 0xFA }, 4, 0 },                                   // endbr64
+        { { 0x0F, 0x05 }, 2, 0 },                                               // syscall
+        { { 0x0F, 0xA2 }, 2, 0 },                                               // cpuid
+        { { 0x0F, 0xC8 }, 2, 0 },                                               // bswap eax
+        { { 0x0F, 0xBA, 0xE0, 0x05 }, 4, 0 },                                   // bt eax, 5
+        { { 0xF0, 0x0F, 0xB1, 0x0A }, 4, 0 },                                   // lock cmpxchg [rdx], ecx
+        { { 0x66, 0x0F, 0x38, 0x00, 0xC1 }, 5, 0 },                             // pshufb xmm0, xmm1
+        { { 0x66, 0x0F, 0x3A, 0x0F, 0xC1, 0x08 }, 6, 0 },                       // palignr xmm0, xmm1, 8
+        { { 0x0F, 0x0F, 0xC1, 0x9E }, 4, 0 },                                   // pfadd mm0, mm1
+        { { 0xC5, 0xF8, 0x77 }, 3, 0 },                                         // vzeroupper
+        { { 0xC5, 0xFD, 0x6F, 0x05, 0, 0, 0, 0 }, 8, INSN_RIP_RELATIVE },       // vmovdqa ymm0, [rip]
+        { { 0xC4, 0xE3, 0x79, 0x0F, 0xC1, 0x08 }, 6, 0 },                       // vpalignr xmm0, xmm0, xmm1, 8
+        { { 0xC5, 0xF9, 0x70, 0xC1, 0x1B }, 5, 0 },                             // vpshufd xmm0, xmm1, 0x1b
+        { { 0x62, 0xF1, 0x7C, 0x48, 0x10, 0x05, 0, 0, 0, 0 }, 10, INSN_RIP_RELATIVE }, // vmovups zmm0, [rip]
+        { { 0x8F, 0xE8, 0x78, 0xC0, 0xC1, 0x05 }, 6, 0 },                       // vprotb xmm0, xmm1, 5 (XOP)
+        { { 0x8F, 0xC0 }, 2, 0 },                                               // pop rax (8F /0)
+        { { 0xC8, 0x10, 0x00, 0x00 }, 4, 0 },                                   // enter 0x10, 0
+        { { 0xC2, 0x08, 0x00 }, 3, 0 },                                         // ret 8
+        { { 0xA1, 1, 2, 3, 4, 5, 6, 7, 8 }, 9, 0 },                             // mov eax, [moffs64]
+        { { 0x67, 0xA1, 1, 2, 3, 4 }, 6, 0 },                                   // mov eax, [moffs32]
+        { { 0xD9, 0x45, 0xF8 }, 3, 0 },                                         // fld dword [rbp-8]
+        { { 0x2E, 0x48, 0x8D, 0x04, 0x08 }, 5, 0 },                             // cs lea rax, [rax+rcx]
+        { { 0xCC }, 1, INSN_NOT_RELOCATABLE },                                  // int3
+        { { 0xC7, 0xF8, 0, 0, 0, 0 }, 6, INSN_NOT_RELOCATABLE },                // xbegin
+    };
+    return checkLengths(cases, true);
+}
+
+static bool lengths32Case( ) {
+    const std::vector<LengthCase_t> cases = {
+        { { 0x40 }, 1, 0 },                                                     // inc eax
+        { { 0x8B, 0x05, 0, 0x10, 0x40, 0 }, 6, 0 },                             // mov eax, [0x401000] (absolute)
+        { { 0x67, 0x8B, 0x46, 0x02 }, 4, 0 },                                   // mov eax, [bp+2]
+        { { 0x67, 0x8B, 0x06, 0x34, 0x12 }, 5, 0 },                             // mov eax, [0x1234]
+        { { 0xA1, 0, 0x10, 0x40, 0 }, 5, 0 },                                   // mov eax, [moffs32]
+        { { 0xC4, 0x00 }, 2, 0 },                                               // les eax, [eax]
+        { { 0xC5, 0xF8, 0x77 }, 3, 0 },                                         // vzeroupper
+        { { 0x62, 0x00 }, 2, 0 },                                               // bound eax, [eax]
+        { { 0x9A, 1, 2, 3, 4, 5, 6 }, 7, INSN_CALL | INSN_NOT_RELOCATABLE },    // call far ptr16:32
+        { { 0x66, 0xE8, 0x00, 0x00 }, 4, INSN_NOT_RELOCATABLE },                // call rel16
+        { { 0xE8, 0, 0, 0, 0 }, 5, INSN_REL_BRANCH | INSN_CALL },               // call rel32
+        { { 0x66, 0x68, 0x34, 0x12 }, 4, 0 },                                   // push imm16
+        { { 0xCD, 0x80 }, 2, 0 },                                               // int 0x80
+        { { 0xCD, 0x03 }, 2, INSN_NOT_RELOCATABLE },                            // int 3
+    };
+    return checkLengths(cases, false);
+}
+
+static bool truncatedCase( ) {
+    const BYTE code[] = { 0x48, 0x81, 0xEC, 0x00, 0x01, 0x00, 0x00 };
+    DecodedInstruction_t insn;
+    bool ok = decodeInstruction(code, sizeof(code), true, insn) && insn.length == 7;
+    for (size_t n = 0; n < sizeof(code); ++n) ok = ok && !decodeInstruction(code, n, true, insn);
+
+    // More than 15 prefixes is not an instruction
+    std::vector<BYTE> prefixes(16, 0x66);
+    prefixes.push_back(0x90);
+    return ok && !decodeInstruction(prefixes.data(), prefixes.size(), true, insn);
+}
+
+static bool ripRelativeCase( ) {
+    // mov eax, [rip+0x10] at 0x140001000 -> 0x140001016; run at 0x140002000
+    const BYTE code[] = { 0x8B, 0x05, 0x10, 0x00, 0x00, 0x00 };
+    BYTE out[MAX_RELOCATED_LENGTH];
+    const uintptr_t from = 0x140001000, to = 0x140002000;
+    size_t n = relocateInstruction(code, sizeof(code), from, to, true, out, sizeof(out));
+    int32_t disp = 0;
+    std::memcpy(&disp, out + 2, 4);
+    int32_t back = 0;
+    std::memcpy(&back, out + 7, 4);
+    return n == 11 && out[0] == 0x8B && out[1] == 0x05
+        && to + 6 + disp == from + 6 + 0x10          // same operand address
+        && out[6] == 0xE9 && to + 11 + back == from + 6; // jump back behind the original
+}
+
+static bool relocateFarCase( ) {
+    const uintptr_t from = 0x0000000140001000ULL, to = 0x00007FF000000000ULL;
+    BYTE out[MAX_RELOCATED_LENGTH];
+
+    // RIP-relative operand out of reach
+    const BYTE load[] = { 0x8B, 0x05, 0x10, 0x00, 0x00, 0x00 };
+    bool ok = relocateInstruction(load, sizeof(load), from, to, true, out, sizeof(out)) == 0;
+
+    // jz rel8: jz +14; jmp [rip] fall-through; jmp [rip] target
+    const BYTE jz[] = { 0x74, 0x10 };
+    size_t n = relocateInstruction(jz, sizeof(jz), from, to, true, out, sizeof(out));
+    uint64_t fall = 0, target = 0;
+    std::memcpy(&fall, out + 2 + 6, 8);
+    std::memcpy(&target, out + 16 + 6, 8);
+    ok = ok && n == 30 && out[0] == 0x74 && out[1] == 14 && out[2] == 0xFF && out[3] == 0x25
+            && fall == from + 2 && target == from + 2 + 0x10;
+
+    // call rel32 with a return address above 4 GB: push lo; mov [rsp+4], hi; jmp [rip]
+    const BYTE call[] = { 0xE8, 0x00, 0x01, 0x00, 0x00 };
+    n = relocateInstruction(call, sizeof(call), from, to, true, out, sizeof(out));
+    uint32_t lo = 0, hi = 0;
+    std::memcpy(&lo, out + 1, 4);
+    std::memcpy(&hi, out + 9, 4);
+    std::memcpy(&target, out + 13 + 6, 8);
+    ok = ok && n == 27 && out[0] == 0x68 && out[5] == 0xC7
+            && ((uint64_t(hi) << 32) | lo) == from + 5 && target == from + 5 + 0x100;
+
+    // 32-bit: jumps wrap around 4 GB
+    const BYTE jmp32[] = { 0xEB, 0xFE };
+    n = relocateInstruction(jmp32, sizeof(jmp32), 0x401000, 0x10000, false, out, sizeof(out));
+    uint32_t rel = 0;
+    std::memcpy(&rel, out + 1, 4);
+    return ok && n == 5 && out[0] == 0xE9 && uint32_t(0x10000 + 5 + rel) == 0x401000;
+}
+
+static bool notRelocatableCase( ) {
+    BYTE out[MAX_RELOCATED_LENGTH];
+    const BYTE int3[] = { 0xCC };
+    const BYTE callRsp[] = { 0xFF, 0x54, 0x24, 0x08 };  // call [rsp+8]: rsp moves by the push
+    const BYTE callR12[] = { 0x41, 0xFF, 0x14, 0x24 };  // call [r12]
+    DecodedInstruction_t insn;
+    return relocateInstruction(int3, sizeof(int3), 0x1000, 0x2000, true, out, sizeof(out)) == 0
+        && relocateInstruction(callRsp, sizeof(callRsp), 0x1000, 0x2000, true, out, sizeof(out), &insn) == 0
+        && (insn.flags & INSN_CALL)
+        && relocateInstruction(callR12, sizeof(callR12), 0x1000, 0x2000, true, out, sizeof(out)) != 0;
+}
+
+#ifdef ROBODBG_TEST_EXECUTE
+// Page layout for the execution test
+constexpr size_t CODE   = 0x000; // instruction under test followed by the rest of the function
+constexpr size_t CALLEE = 0x400; // mov eax, 42; ret
+constexpr size_t DATA   = 0x600; // data read by RIP-relative loads
+constexpr size_t STUB   = 0x700; // test edi, edi; jmp entry
+constexpr size_t SLOT   = 0x800; // relocated instruction
+
+typedef uint64_t (*TestFn)(uint64_t);
+
+struct ExecCase_t {
+    const char* name;
+    std::vector<BYTE> code; // first instruction is relocated
+    uint64_t arg;
+    uint64_t expected;
+};
+
+static void put32( BYTE* p, uint32_t v ) { std::memcpy(p, &v, 4); }
+
+static uint64_t callVia( BYTE* page, uintptr_t entry, uint64_t arg ) {
+    BYTE* stub = page + STUB;
+    stub[0] = 0x85; stub[1] = 0xFF; // test edi, edi: flags for the conditional cases
+    stub[2] = 0xE9;
+    put32(stub + 3, static_cast<uint32_t>(entry - reinterpret_cast<uintptr_t>(stub + 7)));
+    __builtin___clear_cache(reinterpret_cast<char*>(page), reinterpret_cast<char*>(page + 0x1000));
+    return reinterpret_cast<TestFn>(stub)(arg);
+}
+
+static bool executeRelocatedCase( ) {
+    BYTE* page = static_cast<BYTE*>(mmap(nullptr, 0x1000, PROT_READ | PROT_WRITE | PROT_EXEC,
+                                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (page == MAP_FAILED) {
+        std::cout << "    mmap(PROT_EXEC) not permitted, skipped\n";
+        return true;
+    }
+    const uintptr_t base = reinterpret_cast<uintptr_t>(page);
+    auto rel32 = [](size_t next, size_t target) { // displacement from CODE + next to target
+        return static_cast<uint32_t>(static_cast<int64_t>(target) - static_cast<int64_t>(CODE + next));
+    };
+
+    const uint32_t toData   = rel32(6, DATA);     // 6-byte instruction at CODE
+    const uint32_t toLea    = rel32(7, DATA);     // 7-byte lea
+    const uint32_t toCallee = rel32(5, CALLEE);   // call rel32
+    const uint32_t toPtr    = rel32(6, DATA + 8); // call / jmp [rip] through a pointer
+
+    std::vector<ExecCase_t> cases = {
+        { "mov eax, [rip]", { 0x8B, 0x05, 0, 0, 0, 0, 0xC3 }, 0, 0x11223344 },
+        { "lea rax, [rip]", { 0x48, 0x8D, 0x05, 0, 0, 0, 0, 0xC3 }, 0, base + DATA },
+        { "call rel32",     { 0xE8, 0, 0, 0, 0, 0x83, 0xC0, 0x01, 0xC3 }, 0, 43 },           // call; add eax, 1; ret
+        { "call [rip]",     { 0xFF, 0x15, 0, 0, 0, 0, 0x83, 0xC0, 0x02, 0xC3 }, 0, 44 },
+        { "jmp [rip]",      { 0xFF, 0x25, 0, 0, 0, 0 }, 0, 42 },
+        { "jz taken",       { 0x74, 0x06, 0xB8, 1, 0, 0, 0, 0xC3, 0xB8, 2, 0, 0, 0, 0xC3 }, 0, 2 },
+        { "jz not taken",   { 0x74, 0x06, 0xB8, 1, 0, 0, 0, 0xC3, 0xB8, 2, 0, 0, 0, 0xC3 }, 1, 1 },
+        { "jnz rel32",      { 0x0F, 0x85, 0x06, 0, 0, 0, 0xB8, 1, 0, 0, 0, 0xC3, 0xB8, 2, 0, 0, 0, 0xC3 }, 1, 2 },
+        { "jmp rel8",       { 0xEB, 0x06, 0xB8, 1, 0, 0, 0, 0xC3, 0xB8, 3, 0, 0, 0, 0xC3 }, 0, 3 },
+        { "mov eax, edi",   { 0x89, 0xF8, 0xC3 }, 7, 7 },
+    };
+    put32(cases[0].code.data() + 2, toData);
+    put32(cases[1].code.data() + 3, toLea);
+    put32(cases[2].code.data() + 1, toCallee);
+    put32(cases[3].code.data() + 2, toPtr);
+    put32(cases[4].code.data() + 2, toPtr);
+
+    bool ok = true;
+    for (const auto& c : cases) {
+        std::memset(page, 0xCC, 0x1000);
+        const BYTE callee[] = { 0xB8, 42, 0, 0, 0, 0xC3 };
+        std::memcpy(page + CALLEE, callee, sizeof(callee));
+        put32(page + DATA, 0x11223344);
+        const uint64_t calleeAddress = base + CALLEE;
+        std::memcpy(page + DATA + 8, &calleeAddress, 8);
+        std::memcpy(page + CODE, c.code.data(), c.code.size());
+
+        const uint64_t direct = callVia(page, base + CODE, c.arg);
+
+        BYTE out[MAX_RELOCATED_LENGTH];
+        const size_t n = relocateInstruction(page + CODE, c.code.size(), base + CODE, base + SLOT, true, out, sizeof(out));
+        std::memcpy(page + SLOT, out, n);
+        const uint64_t displaced = n ? callVia(page, base + SLOT, c.arg) : ~0ULL;
+
+        if (direct != c.expected || displaced != c.expected) {
+            std::cout << "    " << c.name << ": direct=" << std::hex << direct << " displaced=" << displaced
+                      << " expected=" << c.expected << std::dec << "\n";
+            ok = false;
+        }
+    }
+    munmap(page, 0x1000);
+    return ok;
+}
+#else
+static bool executeRelocatedCase( ) {
+    std::cout << "    in-process execution needs Linux x86-64, skipped\n";
+    return true;
+}
+#endif
+
+static bool run( TestCase tc ) {
+    switch(tc) {
+        case TestCase::lengths64:        return lengths64Case();
+        case TestCase::lengths32:        return lengths32Case();
+        case TestCase::truncated:        return truncatedCase();
+        case TestCase::ripRelative:      return ripRelativeCase();
+        case TestCase::relocateFar:      return relocateFarCase();
+        case TestCase::notRelocatable:   return notRelocatableCase();
+        case TestCase::executeRelocated: return executeRelocatedCase();
+        default:                         return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
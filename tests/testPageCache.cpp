@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "pageCache.h"
+#include "backends/simulatedBackend.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    againstDirect,
+    smallReads,
+    writeThrough,
+    invalidation,
+    capacity,
+    unreadablePages,
+    Size
+};
+
+constexpr uintptr_t BASE = 0x10000000;
+constexpr SIZE_T PAGE = PageCache::PAGE_BYTES;
+
+// Two mappings of 3 and 5 pages with a one-page hole between them, random bytes
+static void mapRandom( SimulatedBackend& sim, std::mt19937& rng ) {
+    sim.mapMemory(BASE, 3 * PAGE, PAGE_READWRITE);
+    sim.mapMemory(BASE + 4 * PAGE, 5 * PAGE, PAGE_READWRITE);
+    std::vector<BYTE> data(PAGE);
+    for (uintptr_t page : { 0, 1, 2, 4, 5, 6, 7, 8 }) {
+        for (auto& b : data) b = static_cast<BYTE>(rng());
+        sim.writeMemory(BASE + page * PAGE, data.data(), PAGE);
+    }
+}
+
+// Same result, byte count and bytes as reading the target directly
+static bool sameRead( PageCache& cache, SimulatedBackend& sim, uintptr_t address, SIZE_T size ) {
+    std::vector<BYTE> a(size, 0xEE), b(size, 0xEE);
+    SIZE_T gotA = 0, gotB = 0;
+    const bool okA = cache.read(address, a.data(), size, &gotA);
+    const bool okB = sim.readMemory(address, b.data(), size, &gotB);
+    return okA == okB && gotA == gotB && std::memcmp(a.data(), b.data(), gotA) == 0;
+}
+
+static bool run( TestCase tc ) {
+    std::mt19937 rng(17);
+    SimulatedBackend sim;
+    mapRandom(sim, rng);
+
+    switch (tc) {
+        case TestCase::againstDirect: {
+            PageCache cache(sim, 4);
+            for (int n = 0; n < 5000; ++n) {
+                const uintptr_t address = BASE - PAGE + rng() % (11 * PAGE);
+                const SIZE_T size = 1 + rng() % (n % 10 == 0 ? 3 * PAGE : 64);
+                if (!sameRead(cache, sim, address, size)) return false;
+            }
+            const PageCacheStats_t& s = cache.stats();
+            // Eight readable pages through four slots: starts over now and then
+            return s.hits > 0 && s.misses > 0 && s.uncached > 0 && s.flushes > 0 && cache.pages() <= 4;
+        }
+        case TestCase::smallReads: {
+            // A C string read byte by byte: one target read for the page
+            PageCache cache(sim);
+            const uint64_t reads = sim.getStats().memoryReads;
+            BYTE b = 0;
+            for (SIZE_T i = 0; i < PAGE; ++i) {
+                if (!cache.read(BASE + PAGE + i, &b, 1)) return false;
+            }
+            const PageCacheStats_t& s = cache.stats();
+            return sim.getStats().memoryReads - reads == 1 && s.misses == 1 && s.hits == PAGE - 1 && s.uncached == 0;
+        }
+        case TestCase::writeThrough: {
+            PageCache cache(sim);
+            uint32_t value = 0;
+            if (!cache.read(BASE + PAGE - 2, &value, sizeof(value))) return false; // caches pages 0 and 1
+
+            const uint32_t written = 0x11223344;
+            if (!cache.write(BASE + PAGE - 2, &written, sizeof(written))) return false;
+            uint32_t cached = 0, direct = 0;
+            const uint64_t reads = sim.getStats().memoryReads;
+            cache.read(BASE + PAGE - 2, &cached, sizeof(cached));
+            if (sim.getStats().memoryReads != reads) return false;
+            sim.readMemory(BASE + PAGE - 2, &direct, sizeof(direct));
+
+            // Into the hole: rejected by the target, the range is dropped
+            const BYTE block[8] = {};
+            const bool rejected = !cache.write(BASE + 4 * PAGE - 4, block, sizeof(block));
+            return cached == written && direct == written && rejected && cache.stats().writes == 2
+                && sameRead(cache, sim, BASE + 2 * PAGE, PAGE);
+        }
+        case TestCase::invalidation: {
+            PageCache cache(sim);
+            BYTE b = 0;
+            cache.read(BASE, &b, 1);
+            cache.read(BASE + 4 * PAGE, &b, 1);
+
+            // The target changes memory behind the cache
+            const BYTE changed = static_cast<BYTE>(b + 1);
+            sim.writeMemory(BASE + 4 * PAGE, &changed, 1);
+            cache.invalidate(BASE + 4 * PAGE, 1);
+            if (!cache.read(BASE + 4 * PAGE, &b, 1) || b != changed || cache.pages() != 2) return false;
+
+            // Protection change over the whole mapping, then everything
+            cache.invalidate(BASE, 3 * PAGE);
+            if (cache.pages() != 1) return false;
+            sim.unmapMemory(BASE + 4 * PAGE, PAGE);
+            if (!cache.read(BASE + 4 * PAGE, &b, 1)) return false; // still cached: the cache is not told
+            cache.invalidate();
+            return !cache.read(BASE + 4 * PAGE, &b, 1) && cache.pages() == 0 && cache.stats().flushes == 1;
+        }
+        case TestCase::capacity: {
+            PageCache cache(sim, 2);
+            BYTE b = 0;
+            for (uintptr_t page : { 0, 1, 2, 0 }) cache.read(BASE + page * PAGE, &b, 1);
+            const PageCacheStats_t& s = cache.stats();
+            return cache.pages() == 2 && s.misses == 4 && s.flushes == 1 && sameRead(cache, sim, BASE, 3 * PAGE);
+        }
+        case TestCase::unreadablePages: {
+            PageCache cache(sim);
+            // Read running off the end of the first mapping
+            std::vector<BYTE> buffer(2 * PAGE);
+            SIZE_T got = 0;
+            if (cache.read(BASE + 2 * PAGE, buffer.data(), buffer.size(), &got) || got != PAGE) return false;
+
+            // The hole is not probed with a whole-page read again
+            const uint64_t reads = sim.getStats().memoryReads;
+            BYTE b = 0;
+            for (int i = 0; i < 10; ++i) {
+                if (cache.read(BASE + 3 * PAGE + i, &b, 1)) return false;
+            }
+            return sim.getStats().memoryReads - reads == 10 && cache.stats().uncached == 11
+                && sameRead(cache, sim, BASE + 3 * PAGE - 1, 2);
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "parallelScan.h"
+#include "patternScanner.h"
+#include "backends/simulatedBackend.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    matchesSerial,
+    firstHits,
+    workStealing,
+    emptyAndTiny,
+    Size
+};
+
+constexpr uintptr_t BASE = 0x10000000;
+constexpr unsigned THREAD_COUNTS[] = { 1, 2, 3, 4, 8, 0 };
+const BYTE SIGNATURE[] = { 0x56, 0x57, 0xFC, 0x8B, 0x54 };
+
+// Random regions with the signature planted at region edges and across every 0x1000-aligned offset of 0x3000
+static std::vector<uintptr_t> mapRandom( SimulatedBackend& sim ) {
+    std::mt19937 rng(3);
+    std::vector<uintptr_t> planted;
+    uintptr_t at = BASE;
+    for (SIZE_T pages : { 1, 40, 3, 17, 64, 2 }) {
+        const SIZE_T size = pages * 0x1000;
+        sim.mapMemory(at, size, pages % 2 ? PAGE_READWRITE : PAGE_EXECUTE_READ);
+        std::vector<BYTE> data(size);
+        for (auto& b : data) b = static_cast<BYTE>(rng() % 8 + 0x50); // SIGNATURE bytes are rare
+        sim.writeMemory(at, data.data(), size);
+
+        std::set<uintptr_t> spots = { at, at + size - sizeof(SIGNATURE) };
+        for (uintptr_t o = 0x3000 - 2; o + sizeof(SIGNATURE) <= size; o += 0x3000) spots.insert(at + o);
+        for (uintptr_t s : spots) sim.writeMemory(s, SIGNATURE, sizeof(SIGNATURE));
+        planted.insert(planted.end(), spots.begin(), spots.end());
+        at += size + 0x10000;
+    }
+    return planted;
+}
+
+static std::vector<uintptr_t> scan( SimulatedBackend& sim, ScanOptions_t options ) {
+    const std::vector<MemoryRegion_t> regions = sim.getMemoryRegions();
+    const PatternScanner scanner(BytePattern_t::exact(SIGNATURE));
+    return ParallelScan(sim, options).collect<uintptr_t>(regions, sizeof(SIGNATURE) - 1,
+        [&](const MemoryChunk_t& chunk, std::vector<uintptr_t>& hits) {
+            scanner.scan(chunk.data, chunk.size, chunk.address, hits);
+        });
+}
+
+static bool run( TestCase tc ) {
+    switch(tc) {
+        case TestCase::matchesSerial: {
+            // Every thread count and item size finds each planted signature exactly once, in order
+            SimulatedBackend sim;
+            const std::vector<uintptr_t> planted = mapRandom(sim);
+            for (unsigned threads : THREAD_COUNTS) {
+                for (SIZE_T chunk : { 0x1000, 0x3000, 0x10000, 0 }) {
+                    if (scan(sim, ScanOptions_t{ threads, chunk, 0 }) != planted) {
+                        std::cout << "    mismatch: threads " << threads << " chunk 0x" << std::hex << chunk << std::dec << "\n";
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        case TestCase::firstHits: {
+            // A limit returns the lowest addresses, whichever worker found them
+            SimulatedBackend sim;
+            const std::vector<uintptr_t> planted = mapRandom(sim);
+            for (unsigned threads : THREAD_COUNTS) {
+                for (size_t limit : { size_t(1), size_t(5), planted.size() - 1, planted.size(), planted.size() + 10 }) {
+                    const std::vector<uintptr_t> got = scan(sim, ScanOptions_t{ threads, 0x2000, limit });
+                    const size_t n = std::min(limit, planted.size());
+                    if (got != std::vector<uintptr_t>(planted.begin(), planted.begin() + n)) return false;
+                }
+            }
+            // Items past the limit are not read at all
+            const uint64_t before = sim.getStats().memoryReads;
+            scan(sim, ScanOptions_t{ 1, 0x1000, 1 });
+            return sim.getStats().memoryReads - before == 1;
+        }
+        case TestCase::workStealing: {
+            // Worker 0's block is slow; idle workers steal its items from the back
+            SimulatedBackend sim;
+            sim.mapMemory(BASE, 64 * 0x1000, PAGE_READWRITE);
+            const std::vector<MemoryRegion_t> regions = sim.getMemoryRegions();
+            std::mutex mutex;
+            std::set<std::thread::id> firstBlockWorkers;
+            const std::thread::id caller = std::this_thread::get_id();
+            std::vector<uintptr_t> seen = ParallelScan(sim, ScanOptions_t{ 4, 0x1000, 0 }).collect<uintptr_t>(regions, 0,
+                [&](const MemoryChunk_t& chunk, std::vector<uintptr_t>& hits) {
+                    if (chunk.address < BASE + 16 * 0x1000) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                        std::lock_guard<std::mutex> lock(mutex);
+                        firstBlockWorkers.insert(std::this_thread::get_id());
+                    }
+                    hits.push_back(chunk.address);
+                });
+            bool ok = seen.size() == 64;
+            for (size_t i = 0; ok && i < seen.size(); ++i) ok = seen[i] == BASE + i * 0x1000;
+            return ok && firstBlockWorkers.size() > 1 && firstBlockWorkers.count(caller);
+        }
+        case TestCase::emptyAndTiny: {
+            SimulatedBackend sim;
+            if (!scan(sim, ScanOptions_t{ 4, 0, 0 }).empty()) return false;
+            // A region list entry whose memory is gone is skipped
+            sim.mapMemory(BASE, 0x2000, PAGE_READWRITE);
+            const std::vector<MemoryRegion_t> regions = sim.getMemoryRegions();
+            sim.unmapMemory(BASE, 0x1000);
+            sim.writeMemory(BASE + 0x1000, SIGNATURE, sizeof(SIGNATURE));
+            const PatternScanner scanner(BytePattern_t::exact(SIGNATURE));
+            const std::vector<uintptr_t> got = ParallelScan(sim, ScanOptions_t{ 3, 0x1000, 0 }).collect<uintptr_t>(regions, 4,
+                [&](const MemoryChunk_t& chunk, std::vector<uintptr_t>& hits) {
+                    scanner.scan(chunk.data, chunk.size, chunk.address, hits);
+                });
+            return got == std::vector<uintptr_t>{ BASE + 0x1000 };
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
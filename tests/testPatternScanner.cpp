@@ -0,0 +1,179 @@
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "patternScanner.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    parseSignature,
+    parseNibbles,
+    parseInvalid,
+    randomAgainstNaive,
+    bufferEdges,
+    longPatterns,
+    Size
+};
+
+constexpr ScanImpl IMPLS[] = { ScanImpl::SCALAR, ScanImpl::SSE2, ScanImpl::AVX2 };
+
+static std::vector<uintptr_t> naive( const BytePattern_t& p, const std::vector<BYTE>& data, uintptr_t base ) {
+    std::vector<uintptr_t> out;
+    for (size_t i = 0; i + p.size() <= data.size(); ++i) {
+        bool ok = true;
+        for (size_t j = 0; j < p.size() && ok; ++j) ok = (data[i + j] & p.mask[j]) == (p.value[j] & p.mask[j]);
+        if (ok) out.push_back(base + i);
+    }
+    return out;
+}
+
+// Every instruction set finds exactly what the byte-by-byte reference finds
+static bool agrees( const BytePattern_t& p, const std::vector<BYTE>& data, uintptr_t base = 0x10000 ) {
+    const std::vector<uintptr_t> expected = naive(p, data, base);
+    for (ScanImpl impl : IMPLS) {
+        PatternScanner scanner(p, impl);
+        std::vector<uintptr_t> got;
+        if (scanner.scan(data.data(), data.size(), base, got) != got.size() || got != expected) {
+            std::cout << "    mismatch: impl " << static_cast<int>(scanner.implementation())
+                      << " length " << p.size() << " found " << got.size() << " expected " << expected.size() << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Pattern cut from the data, with wildcards and nibble wildcards sprinkled in
+static BytePattern_t cutPattern( std::mt19937& rng, const std::vector<BYTE>& data, size_t len, int looseEvery ) {
+    const size_t at = rng() % (data.size() - len);
+    BytePattern_t p = BytePattern_t::exact(std::span<const BYTE>(data.data() + at, len));
+    if (looseEvery) {
+        for (size_t j = 0; j < len; ++j) {
+            if (rng() % looseEvery) continue;
+            static constexpr BYTE masks[] = { 0x00, 0xF0, 0x0F };
+            p.mask[j] = masks[rng() % 3];
+            p.value[j] &= p.mask[j];
+        }
+        p.mask[rng() % len] = 0xFF; // keep one fixed byte
+    }
+    return p;
+}
+
+static bool run( TestCase tc ) {
+    switch(tc) {
+        case TestCase::parseSignature: {
+            BytePattern_t p;
+            if (!BytePattern_t::parse("56 57 ?? 8B  54\t? fc", p)) return false;
+            const std::vector<BYTE> value = { 0x56, 0x57, 0x00, 0x8B, 0x54, 0x00, 0xFC };
+            const std::vector<BYTE> mask  = { 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF };
+            return p.value == value && p.mask == mask;
+        }
+        case TestCase::parseNibbles: {
+            BytePattern_t p;
+            if (!BytePattern_t::parse("4? ?F 48", p)) return false;
+            const std::vector<BYTE> value = { 0x40, 0x0F, 0x48 };
+            const std::vector<BYTE> mask  = { 0xF0, 0x0F, 0xFF };
+            const std::vector<BYTE> data  = { 0x41, 0x3F, 0x48, 0x4C, 0x1F, 0x48, 0x50, 0x0F, 0x48 };
+            PatternScanner scanner(p);
+            std::vector<uintptr_t> got;
+            scanner.scan(data.data(), data.size(), 100, got);
+            return p.value == value && p.mask == mask && got == std::vector<uintptr_t>{ 100, 103 };
+        }
+        case TestCase::parseInvalid: {
+            BytePattern_t p;
+            p.value = { 1 };
+            const bool rejected = !BytePattern_t::parse("", p) && !BytePattern_t::parse("5", p)
+                && !BytePattern_t::parse("567", p) && !BytePattern_t::parse("56 GG", p)
+                && !BytePattern_t::parse("?? ?", p) && !BytePattern_t::parse("56 ???", p);
+            return rejected && p.value == std::vector<BYTE>{ 1 }; // out is untouched on failure
+        }
+        case TestCase::randomAgainstNaive: {
+            // Small alphabets produce many anchor hits that fail the full compare
+            std::mt19937 rng(7);
+            for (int alphabet : { 2, 4, 256 }) {
+                std::vector<BYTE> data(1 << 16);
+                for (auto& b : data) b = static_cast<BYTE>(rng() % alphabet) * (alphabet == 2 ? 0x11 : 1);
+                for (size_t len : { 1, 2, 3, 4, 5, 8, 13 }) {
+                    for (int looseEvery : { 0, 3 }) {
+                        if (!agrees(cutPattern(rng, data, len, looseEvery), data)) return false;
+                    }
+                }
+            }
+            return true;
+        }
+        case TestCase::bufferEdges: {
+            // Matches at both ends of buffers around the vector widths, and buffers shorter than the pattern
+            const BytePattern_t p = BytePattern_t::exact(std::vector<BYTE>{ 0xAB, 0xCD, 0xEF });
+            for (size_t size = 0; size <= 100; ++size) {
+                std::vector<BYTE> data(size, 0xAB);
+                if (size >= 3) {
+                    data[0] = 0xAB; data[1] = 0xCD; data[2] = 0xEF;
+                    data[size - 3] = 0xAB; data[size - 2] = 0xCD; data[size - 1] = 0xEF;
+                }
+                if (!agrees(p, data)) return false;
+            }
+            return true;
+        }
+        case TestCase::longPatterns: {
+            // Long patterns over a small alphabet, some with wildcards
+            std::mt19937 rng(11);
+            std::vector<BYTE> data(1 << 18);
+            for (auto& b : data) b = static_cast<BYTE>(rng() % 16);
+            for (size_t len : { 16, 24, 40, 64 }) {
+                BytePattern_t p = cutPattern(rng, data, len, 0);
+                if (!agrees(p, data)) return false;
+                p.mask[1] = 0; p.value[1] = 0;
+                if (!agrees(p, data)) return false;
+                p.mask[len - 3] = 0; p.value[len - 3] = 0;
+                if (!agrees(p, data)) return false;
+            }
+            // Only common bytes, so the scalar path picks Horspool over memchr
+            static constexpr BYTE common[] = { 0x00, 0x48, 0x8B, 0xFF, 0xCC, 0x89 };
+            for (auto& b : data) b = common[rng() % sizeof(common)];
+            for (size_t len : { 16, 31 }) {
+                BytePattern_t p = cutPattern(rng, data, len, 0);
+                if (!agrees(p, data)) return false;
+                p.mask[2] = 0; p.value[2] = 0;
+                if (!agrees(p, data)) return false;
+            }
+            // Periodic data: matches overlap each other
+            std::vector<BYTE> periodic(4096);
+            for (size_t i = 0; i < periodic.size(); ++i) periodic[i] = static_cast<BYTE>(i % 3);
+            return agrees(cutPattern(rng, periodic, 20, 0), periodic);
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+    std::cout << "[*] Best scanner: " << static_cast<int>(PatternScanner::bestImplementation()) << std::endl;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
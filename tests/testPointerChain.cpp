@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "pointerChain.h"
+#include "backends/simulatedBackend.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    againstNaive,
+    pointers32,
+    batchedLevels,
+    prefixCache,
+    failures,
+    Size
+};
+
+constexpr uintptr_t MODULE = 0x400000;   // static pointers
+constexpr uintptr_t HEAP   = 0x10000000; // objects
+constexpr SIZE_T OBJECT    = 0x100;
+constexpr size_t OBJECTS   = 256;
+
+// Every object slot holds a pointer to a random object, a bad pointer or 0; the module holds 64 roots
+static void buildGraph( SimulatedBackend& sim, std::mt19937& rng, size_t pointerSize ) {
+    sim.mapMemory(MODULE, 0x1000, PAGE_READWRITE);
+    sim.mapMemory(HEAP, OBJECTS * OBJECT, PAGE_READWRITE);
+    auto pointer = [&](bool roots) -> uint64_t {
+        const unsigned pick = rng() % 16;
+        if (!roots && pick == 0) return 0;
+        if (!roots && pick == 1) return 0x7000000; // unmapped
+        return HEAP + (rng() % OBJECTS) * OBJECT;
+    };
+    for (SIZE_T at = 0; at < 0x1000; at += pointerSize) {
+        const uint64_t p = pointer(true);
+        sim.writeMemory(MODULE + at, &p, pointerSize);
+    }
+    for (SIZE_T at = 0; at < OBJECTS * OBJECT; at += pointerSize) {
+        const uint64_t p = pointer(false);
+        sim.writeMemory(HEAP + at, &p, pointerSize);
+    }
+}
+
+static PointerPath_t randomPath( std::mt19937& rng, size_t pointerSize ) {
+    PointerPath_t path{ MODULE, {}, static_cast<uint8_t>(rng() % 9) };
+    const size_t depth = rng() % 6;
+    for (size_t l = 0; l < depth; ++l) {
+        const SIZE_T span = l == 0 ? 0x1000 : OBJECT;
+        path.offsets.push_back(static_cast<int64_t>((rng() % (span / pointerSize)) * pointerSize));
+    }
+    if (!path.offsets.empty() && rng() % 8 == 0) path.offsets.back() = -8; // into the previous object
+    return path;
+}
+
+// One readMemory per level
+static PointerResult_t naive( SimulatedBackend& sim, const PointerPath_t& path, size_t pointerSize ) {
+    PointerResult_t r;
+    uintptr_t current = path.base;
+    for (size_t l = 0; l + 1 < path.offsets.size(); ++l) {
+        const uintptr_t at = current + static_cast<uintptr_t>(path.offsets[l]);
+        uint64_t p = 0;
+        if (!sim.readMemory(at, &p, pointerSize)) {
+            r.failedLevel = static_cast<int>(l);
+            r.address = at;
+            return r;
+        }
+        current = static_cast<uintptr_t>(p);
+    }
+    r.address = current + (path.offsets.empty() ? 0 : static_cast<uintptr_t>(path.offsets.back()));
+    if (path.valueSize && !sim.readMemory(r.address, &r.value, path.valueSize))
+        r.failedLevel = static_cast<int>(path.offsets.empty() ? 0 : path.offsets.size() - 1);
+    return r;
+}
+
+static bool same( const PointerResult_t& a, const PointerResult_t& b ) {
+    return a.address == b.address && a.failedLevel == b.failedLevel && (!a.ok() || a.value == b.value);
+}
+
+static bool matchesNaive( SimulatedBackend& sim, const std::vector<PointerPath_t>& paths,
+                          const std::vector<PointerResult_t>& results, size_t pointerSize ) {
+    if (results.size() != paths.size()) return false;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (!same(results[i], naive(sim, paths[i], pointerSize))) return false;
+    }
+    return true;
+}
+
+static bool run( TestCase tc ) {
+    std::mt19937 rng(31);
+    SimulatedBackend sim;
+
+    switch (tc) {
+        case TestCase::againstNaive:
+        case TestCase::pointers32: {
+            const size_t pointerSize = tc == TestCase::pointers32 ? 4 : 8;
+            buildGraph(sim, rng, pointerSize);
+            PointerResolver resolver(sim, PointerResolverOptions_t{ pointerSize, 0, 0, 16 });
+            size_t failed = 0;
+            for (int round = 0; round < 20; ++round) {
+                std::vector<PointerPath_t> paths;
+                for (int n = 0; n < 200; ++n) paths.push_back(randomPath(rng, pointerSize));
+                const auto results = resolver.resolve(paths);
+                if (!matchesNaive(sim, paths, results, pointerSize)) return false;
+                for (const auto& r : results) failed += !r.ok();
+            }
+            return failed > 0 && resolver.options().pointerSize == pointerSize;
+        }
+        case TestCase::batchedLevels: {
+            // 100 paths of depth 3 off neighbouring roots: one pass per level, fields of a level merged
+            buildGraph(sim, rng, 8);
+            std::vector<PointerPath_t> paths;
+            for (int n = 0; n < 100; ++n) paths.push_back(PointerPath_t{ MODULE, { (n % 10) * 8, 0x48, 0x8 }, 4 });
+            PointerResolver resolver(sim);
+            const uint64_t reads = sim.getStats().memoryReads;
+            const auto results = resolver.resolve(paths);
+            const uint64_t batchReads = sim.getStats().memoryReads - reads;
+            const PointerResolverStats_t& s = resolver.stats();
+            return matchesNaive(sim, paths, results, 8) && s.passes == 3 && s.reads == 300
+                && s.ranges <= 21 && batchReads == s.ranges;
+        }
+        case TestCase::prefixCache: {
+            buildGraph(sim, rng, 8);
+            std::vector<PointerPath_t> paths;
+            for (int n = 0; n < 10; ++n) paths.push_back(PointerPath_t{ MODULE, { n * 8, 0x10, 0 }, 8 });
+            PointerResolver resolver(sim, PointerResolverOptions_t{ 8, 1, 0, 0 });
+
+            const auto first = resolver.resolve(paths);
+            if (resolver.stats().cacheHits != 0 || resolver.cached() != 10) return false;
+            const auto second = resolver.resolve(paths);
+            if (resolver.stats().cacheHits != 10 || !matchesNaive(sim, paths, second, 8)) return false;
+
+            // The root moves: the cached pointer is stale until invalidated
+            const uint64_t moved = HEAP + 7 * OBJECT;
+            sim.writeMemory(MODULE, &moved, 8);
+            const auto stale = resolver.resolve(paths);
+            if (stale[0].address != first[0].address || !matchesNaive(sim, { paths.begin() + 1, paths.end() }, { stale.begin() + 1, stale.end() }, 8))
+                return false;
+            resolver.invalidate();
+            if (!matchesNaive(sim, paths, resolver.resolve(paths), 8)) return false;
+
+            // Revalidated every second call
+            resolver.setOptions(PointerResolverOptions_t{ 8, 1, 2, 0 });
+            size_t hits = 0;
+            for (int call = 0; call < 4; ++call) {
+                resolver.resolve(paths);
+                hits += resolver.stats().cacheHits;
+            }
+            return hits == 20;
+        }
+        case TestCase::failures: {
+            sim.mapMemory(MODULE, 0x1000, PAGE_READWRITE);
+            const uint64_t bad = 0x7000000, good = MODULE + 0x800, value = 0x1122334455667788ULL;
+            sim.writeMemory(MODULE, &bad, 8);
+            sim.writeMemory(MODULE + 8, &good, 8);
+            sim.writeMemory(MODULE + 0x800, &value, 8);
+            const std::vector<PointerPath_t> paths = {
+                { MODULE, { 0, 0x10, 0 }, 8 },       // level 1 reads the bad pointer
+                { MODULE, { 8, 0 }, 8 },             // resolves
+                { MODULE, { 8, 0x1000 }, 4 },        // value past the mapping
+                { MODULE + 0x800, {}, 2 },           // no levels: value at base
+                { 0x7000000, { 0x10 }, 0 },          // no reads at all
+                { MODULE, { 8, 0 }, 0 },             // address only
+            };
+            PointerResolver resolver(sim);
+            const auto r = resolver.resolve(paths);
+            return r[0].failedLevel == 1 && r[0].address == bad + 0x10
+                && r[1].ok() && r[1].address == good && r[1].value == value
+                && r[2].failedLevel == 1 && r[2].address == good + 0x1000
+                && r[3].ok() && r[3].value == 0x7788
+                && r[4].ok() && r[4].address == 0x7000010
+                && r[5].ok() && r[5].address == good && r[5].value == 0
+                && matchesNaive(sim, paths, r, 8);
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
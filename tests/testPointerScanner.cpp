@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "pointerScanner.h"
+#include "backends/simulatedBackend.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    knownPath,
+    againstNaive,
+    dumpsAndTarget,
+    limits,
+    saveLoad,
+    itemBoundary,
+    Size
+};
+
+constexpr uintptr_t MODULE = 0x400000;
+constexpr uintptr_t HEAP   = 0x10000000;
+
+struct Memory_t {
+    std::vector<std::pair<uintptr_t, std::vector<BYTE>>> blocks;
+    std::vector<Module_t> modules;
+
+    void put(uintptr_t address, uint64_t value, size_t width = 8) {
+        for (auto& [base, bytes] : blocks) {
+            if (address >= base && address + width <= base + bytes.size()) std::memcpy(bytes.data() + (address - base), &value, width);
+        }
+    }
+
+    std::vector<MemoryDump_t> dumps() const {
+        std::vector<MemoryDump_t> out;
+        for (const auto& [base, bytes] : blocks) out.push_back(MemoryDump_t{ base, bytes });
+        return out;
+    }
+
+    void mirror(SimulatedBackend& sim) const {
+        for (const auto& [base, bytes] : blocks) {
+            sim.mapMemory(base, bytes.size(), PAGE_READWRITE);
+            sim.writeMemory(base, bytes.data(), bytes.size());
+        }
+    }
+};
+
+// Module of 0x2000 bytes and 64 objects of 0x200 bytes; slots hold random object pointers, the rest zeros
+static Memory_t randomMemory( std::mt19937& rng, size_t width, int density ) {
+    Memory_t m;
+    m.blocks.push_back({ MODULE, std::vector<BYTE>(0x2000) });
+    m.blocks.push_back({ HEAP, std::vector<BYTE>(64 * 0x200) });
+    m.modules.push_back(Module_t{ MODULE, 0x2000, "game.exe" });
+    for (const auto& [base, bytes] : std::vector(m.blocks)) {
+        for (SIZE_T at = 0; at < bytes.size(); at += width) {
+            if (static_cast<int>(rng() % 100) < density) m.put(base + at, HEAP + (rng() % 64) * 0x200 + (rng() % 4) * 0x10, width);
+        }
+    }
+    return m;
+}
+
+static bool sameResults( const std::vector<PointerScanResult_t>& a, const std::vector<PointerScanResult_t>& b ) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].module != b[i].module || a[i].offsets != b[i].offsets) return false;
+    }
+    return true;
+}
+
+// Every path, by trying every slot at every level
+static void naive( const Memory_t& m, size_t width, const PointerScanOptions_t& o, uintptr_t target,
+                   std::vector<int64_t>& stack, std::vector<PointerScanResult_t>& out ) {
+    for (const auto& [base, bytes] : m.blocks) {
+        for (SIZE_T at = 0; at + width <= bytes.size(); at += width) {
+            uint64_t value = 0;
+            std::memcpy(&value, bytes.data() + at, width);
+            if (value > target || target - value > o.maxOffset || value == 0) continue;
+            const uintptr_t slot = base + at;
+            stack.push_back(static_cast<int64_t>(target - value));
+            if (slot >= MODULE && slot < MODULE + 0x2000) {
+                PointerScanResult_t r{ 0, { static_cast<int64_t>(slot - MODULE) } };
+                r.offsets.insert(r.offsets.end(), stack.rbegin(), stack.rend());
+                out.push_back(r);
+            } else if (stack.size() < o.maxDepth) {
+                naive(m, width, o, slot, stack, out);
+            }
+            stack.pop_back();
+        }
+    }
+}
+
+static std::vector<PointerScanResult_t> naive( const Memory_t& m, size_t width, const PointerScanOptions_t& o, uintptr_t target ) {
+    std::vector<int64_t> stack;
+    std::vector<PointerScanResult_t> out;
+    naive(m, width, o, target, stack, out);
+    std::sort(out.begin(), out.end(), [](const PointerScanResult_t& a, const PointerScanResult_t& b) { return a.offsets < b.offsets; });
+    return out;
+}
+
+// Every result followed forwards ends at the target
+static bool resolvesTo( SimulatedBackend& sim, const PointerScanner& scanner, uintptr_t target ) {
+    std::vector<PointerPath_t> paths;
+    for (size_t i = 0; i < scanner.results().size(); ++i) paths.push_back(scanner.path(i));
+    PointerResolver resolver(sim, PointerResolverOptions_t{ scanner.options().pointerSize });
+    for (const PointerResult_t& r : resolver.resolve(paths)) {
+        if (!r.ok() || r.address != target) return false;
+    }
+    return true;
+}
+
+static bool run( TestCase tc ) {
+    std::mt19937 rng(47);
+
+    switch (tc) {
+        case TestCase::knownPath: {
+            // [[[game.exe+0x100]+0x18]+0x40]+0x2C, next to a dead end through an object no static reaches
+            Memory_t m;
+            m.blocks.push_back({ MODULE, std::vector<BYTE>(0x1000) });
+            m.blocks.push_back({ HEAP, std::vector<BYTE>(0x10000) });
+            m.modules.push_back(Module_t{ MODULE, 0x1000, "game.exe" });
+            m.put(MODULE + 0x100, HEAP + 0x1000);
+            m.put(HEAP + 0x1018, HEAP + 0x5000);
+            m.put(HEAP + 0x5040, HEAP + 0x8000);
+            m.put(HEAP + 0x9000, HEAP + 0x8000);
+            const uintptr_t target = HEAP + 0x802C;
+
+            PointerScanner scanner(PointerScanOptions_t{ 4, 0x100, 8, 0, 0, 2 });
+            const auto dumps = m.dumps();
+            return scanner.buildMap(dumps) == 4 && scanner.scan(target, m.modules) == 1
+                && scanner.results()[0].module == 0
+                && scanner.results()[0].offsets == std::vector<int64_t>{ 0x100, 0x18, 0x40, 0x2C }
+                && scanner.path(0).base == MODULE;
+        }
+        case TestCase::againstNaive: {
+            for (size_t width : { 8, 4 }) {
+                const Memory_t m = randomMemory(rng, width, 6);
+                const auto dumps = m.dumps();
+                for (unsigned threads : { 1u, 3u }) {
+                    PointerScanOptions_t o{ 3, 0x40, width, 0, 0, threads };
+                    PointerScanner scanner(o);
+                    scanner.buildMap(dumps);
+                    for (int round = 0; round < 10; ++round) {
+                        const uintptr_t target = HEAP + (rng() % 64) * 0x200 + (rng() % 0x50);
+                        scanner.scan(target, m.modules);
+                        if (!sameResults(scanner.results(), naive(m, width, o, target))) return false;
+                    }
+                }
+            }
+            return true;
+        }
+        case TestCase::dumpsAndTarget: {
+            // The map from copies equals the map read through the backend; every path resolves forwards
+            const Memory_t m = randomMemory(rng, 8, 8);
+            SimulatedBackend sim;
+            m.mirror(sim);
+            uint64_t first = 0; // object a static points to: at least one path
+            for (SIZE_T at = 0; !first; at += 8) std::memcpy(&first, m.blocks[0].second.data() + at, 8);
+            const uintptr_t target = first + 0x18;
+
+            PointerScanner fromDumps(PointerScanOptions_t{ 4, 0x80, 8, 0, 0, 2 });
+            PointerScanner fromTarget(fromDumps.options());
+            const auto dumps = m.dumps();
+            const auto regions = sim.getMemoryRegions();
+            const size_t pointers = fromDumps.buildMap(dumps);
+            if (pointers == 0 || fromTarget.buildMap(sim, regions) != pointers) return false;
+            fromDumps.scan(target, m.modules);
+            fromTarget.scan(target, m.modules);
+            return !fromDumps.results().empty() && sameResults(fromDumps.results(), fromTarget.results())
+                && resolvesTo(sim, fromTarget, target) && fromTarget.memoryUsage() >= 2 * pointers * sizeof(uintptr_t);
+        }
+        case TestCase::limits: {
+            const Memory_t m = randomMemory(rng, 8, 8);
+            const auto dumps = m.dumps();
+            const uintptr_t target = HEAP + 0x11 * 0x200 + 0x30;
+            PointerScanner all(PointerScanOptions_t{ 4, 0x100, 8, 0, 0, 1 });
+            all.buildMap(dumps);
+            const size_t total = all.scan(target, m.modules);
+
+            PointerScanner shallow(PointerScanOptions_t{ 2, 0x100, 8, 0, 0, 1 });
+            shallow.buildMap(dumps);
+            shallow.scan(target, m.modules);
+            const bool depthOk = std::all_of(shallow.results().begin(), shallow.results().end(),
+                                             [](const PointerScanResult_t& r) { return r.offsets.size() <= 3; });
+
+            PointerScanner capped(PointerScanOptions_t{ 4, 0x100, 8, 0, 5, 2 });
+            capped.buildMap(dumps);
+            const size_t five = capped.scan(target, m.modules);
+
+            PointerScanner none(all.options());
+            none.buildMap(dumps);
+            return total > 5 && depthOk && shallow.results().size() < total && five == 5
+                && none.scan(target, {}) == 0 && none.scan(HEAP + 0x100000, m.modules) == 0;
+        }
+        case TestCase::saveLoad: {
+            const Memory_t m = randomMemory(rng, 8, 8);
+            const auto dumps = m.dumps();
+            PointerScanner scanner(PointerScanOptions_t{ 3, 0x100, 8, 0, 0, 1 });
+            scanner.buildMap(dumps);
+            scanner.scan(HEAP + 0x05 * 0x200 + 0x10, m.modules);
+            const char* path = "testPointerScanner.ptr";
+            if (scanner.results().empty() || !scanner.save(path)) return false;
+
+            PointerScanner loaded;
+            bool ok = loaded.load(path) && sameResults(loaded.results(), scanner.results())
+                   && loaded.modules().size() == 1 && loaded.modules()[0].name == "game.exe";
+
+            // Rebased on the next run: the module is found by name
+            const std::vector<Module_t> moved = { Module_t{ 0x7FF000000000, 0x2000, "game.exe" } };
+            ok = ok && loaded.path(0, 4, moved).base == 0x7FF000000000 && loaded.path(0, 4, moved).offsets == scanner.results()[0].offsets;
+
+            // Corrupt files are refused and leave the results alone
+            std::ifstream in(path, std::ios::binary);
+            std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            in.close();
+            for (size_t cut : { size_t(4), bytes.size() / 2, bytes.size() - 1 }) {
+                std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(cut));
+                ok = ok && !loaded.load(path) && sameResults(loaded.results(), scanner.results());
+            }
+            std::remove(path);
+            return ok && bytes.size() < scanner.results().size() * 16;
+        }
+        case TestCase::itemBoundary: {
+            // A pointer at 4-byte alignment straddling the 1 MB cut of a dump, and one at its end
+            Memory_t m;
+            m.blocks.push_back({ MODULE, std::vector<BYTE>(0x200000) });
+            m.modules.push_back(Module_t{ MODULE, 0x200000, "big.dll" });
+            m.put(MODULE + 0x100000 - 4, MODULE + 0x1000);
+            m.put(MODULE + 0x200000 - 8, MODULE + 0x2000);
+            PointerScanner scanner(PointerScanOptions_t{ 1, 0x10, 8, 4, 0, 2 });
+            const auto dumps = m.dumps();
+            return scanner.buildMap(dumps) == 2 && scanner.scan(MODULE + 0x1008, m.modules) == 1
+                && scanner.results()[0].offsets == std::vector<int64_t>{ 0x100000 - 4, 8 }
+                && scanner.scan(MODULE + 0x2000, m.modules) == 1;
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
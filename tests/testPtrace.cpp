@@ -0,0 +1,202 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "debugger.h"
+
+#ifdef __linux__ // Linux / ptrace backend test. The binary debugs a second copy of itself.
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+extern "C" char __executable_start; // Load address of this image (set by the linker)
+
+// ==================================================
+// DEBUGGEE
+// ==================================================
+
+// No inlining, cloning or constant propagation: the breakpoint on the symbol must be hit at -O2/-O3 too
+#if defined(__clang__)
+#define ROBO_TARGET_FUNCTION __attribute__((noinline, used))
+#else
+#define ROBO_TARGET_FUNCTION __attribute__((noipa, used))
+#endif
+
+extern "C" {
+    volatile uint32_t robo_marker = 0x1337C0DE;
+
+    ROBO_TARGET_FUNCTION int robo_target_add(int a, int b) {
+        return a + b;
+    }
+}
+
+static int runTarget() {
+    int (* volatile add)(int, int) = &robo_target_add; // called through the symbol, never a specialized copy
+    int sum = 0;
+    for (int i = 0; i < 5; ++i) {
+        sum += add(i, 1); // 1+2+3+4+5 = 15
+    }
+    if (robo_marker != 0x1337C0DE) {
+        return static_cast<int>(robo_marker & 0x7F);
+    }
+    return sum;
+}
+
+// ==================================================
+// DEBUGGER
+// ==================================================
+
+// Same binary on both sides: image relative offsets are valid in the debuggee
+static uintptr_t imageOffset(const volatile void* p) {
+    return reinterpret_cast<uintptr_t>(p) - reinterpret_cast<uintptr_t>(&__executable_start);
+}
+
+static const uintptr_t targetFunctionRva = imageOffset(reinterpret_cast<const void*>(&robo_target_add));
+static const uintptr_t markerRva         = imageOffset(&robo_marker);
+
+enum TestCase {
+    exitCode,
+    breakpointRestore,
+    breakpointBreak,
+    changeRegister,
+    changeMemory,
+    hardwareBreakpoint,
+    displacedRestore,
+    Size
+};
+
+using namespace RoboDBG;
+class PtraceTester : public Debugger {
+private:
+    TestCase testCase;
+public:
+    int hits = 0;
+    int exitStatus = -1;
+    uint32_t markerRead = 0;
+    uint32_t markerMany = 0;  // the marker read as two halves by readMany
+    size_t manyComplete = 0;
+    int armedHits = 0; // hits that saw the int3 still in place
+
+    explicit PtraceTester( TestCase testId ) : testCase(testId) {
+        this->verbose = false;
+    }
+
+    void onStart( uintptr_t /*imageBase*/, uintptr_t /*entryPoint*/ ) override {
+        switch(testCase) {
+            case TestCase::breakpointRestore:
+            case TestCase::breakpointBreak:
+            case TestCase::changeRegister:
+                setBreakpoint( ASLR(targetFunctionRva) );
+                break;
+            case TestCase::displacedRestore:
+                setDisplacedStepping( true );
+                setBreakpoint( ASLR(targetFunctionRva) );
+                break;
+            case TestCase::changeMemory:
+                markerRead = readMemory<uint32_t>( ASLR(markerRva) );
+                {
+                    // Halves in reverse order plus an unmapped address: one process_vm_readv
+                    uint16_t low = 0, high = 0, none = 0;
+                    ReadRequest_t requests[] = {
+                        { ASLR(markerRva) + 2, &high, 2 },
+                        { 0x10, &none, 2 },
+                        { ASLR(markerRva), &low, 2 },
+                    };
+                    manyComplete = readMany( requests );
+                    markerMany = (static_cast<uint32_t>(high) << 16) | low;
+                }
+                writeMemory<uint32_t>( ASLR(markerRva), 0x2A );
+                break;
+            case TestCase::hardwareBreakpoint:
+                setHardwareBreakpoint( reinterpret_cast<LPVOID>(ASLR(targetFunctionRva)), DRReg::DR0, AccessType::EXECUTE, BreakpointLength::BYTE );
+                break;
+            default:
+                break;
+        }
+    }
+
+    void onEnd( DWORD exitCode, DWORD /*pid*/ ) override {
+        exitStatus = static_cast<int>(exitCode);
+    }
+
+    BreakpointAction onBreakpoint( uintptr_t address, HANDLE hThread ) override {
+        ++hits;
+        switch(testCase) {
+            case TestCase::breakpointRestore:
+                return RESTORE;
+            case TestCase::displacedRestore:
+                if (readMemory<BYTE>( address ) == 0xCC) ++armedHits;
+                return RESTORE;
+            case TestCase::changeRegister:
+                // First argument of robo_target_add(0, 1)
+                setRegister(hThread, Register64::RDI, 100);
+                return BREAK;
+            default:
+                return BREAK;
+        }
+    }
+
+    BreakpointAction onHardwareBreakpoint( uintptr_t address, HANDLE /*hThread*/, DRReg reg ) override {
+        if (address == ASLR(targetFunctionRva) && reg == DRReg::DR0) ++hits;
+        return RESTORE;
+    }
+};
+
+static bool check( TestCase tc, const PtraceTester& t ) {
+    switch(tc) {
+        case TestCase::exitCode:           return t.exitStatus == 15;
+        case TestCase::breakpointRestore:  return t.hits == 5 && t.exitStatus == 15;
+        case TestCase::breakpointBreak:    return t.hits == 1 && t.exitStatus == 15;
+        case TestCase::changeRegister:     return t.hits == 1 && t.exitStatus == 115;
+        case TestCase::changeMemory:       return t.markerRead == 0x1337C0DE && t.exitStatus == 0x2A
+                                               && t.markerMany == 0x1337C0DE && t.manyComplete == 2;
+        case TestCase::hardwareBreakpoint: return t.hits == 5 && t.exitStatus == 15;
+        case TestCase::displacedRestore:   return t.hits == 5 && t.armedHits == 5 && t.exitStatus == 15;
+        default:                           return false;
+    }
+}
+
+int main( int argc, char** argv ) {
+    if (argc > 1 && std::strcmp(argv[1], "--target") == 0) {
+        return runTarget();
+    }
+
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        TestCase tc = static_cast<TestCase>(i);
+        std::cout << "[*] Running test case: " << i << std::endl;
+
+        std::unique_ptr<PtraceTester> dbg = std::make_unique<PtraceTester>(tc);
+        if (dbg->start("/proc/self/exe", { "--target" }) != 0) {
+            std::cout << RED << "[-] Failed to start test application!\n[-] Tests aborted!" << RESET << std::endl;
+            return -1;
+        }
+
+        dbg->loop();
+
+        if (check(tc, *dbg)) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed (hits=" << dbg->hits
+                      << ", exit=" << dbg->exitStatus << ")" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
+#endif
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "readBatch.h"
+#include "backends/simulatedBackend.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    coalesce,
+    coalesceGap,
+    againstDirect,
+    structFields,
+    brokenRange,
+    Size
+};
+
+constexpr uintptr_t BASE = 0x10000000;
+constexpr SIZE_T PAGE = 0x1000;
+
+static ReadRequest_t request( uintptr_t address, SIZE_T size ) {
+    return ReadRequest_t{ address, nullptr, size };
+}
+
+static bool sameRanges( const std::vector<ReadRange_t>& got, const std::vector<ReadRange_t>& expected ) {
+    if (got.size() != expected.size()) return false;
+    for (size_t i = 0; i < got.size(); ++i) {
+        if (got[i].address != expected[i].address || got[i].size != expected[i].size
+            || got[i].first != expected[i].first || got[i].count != expected[i].count)
+            return false;
+    }
+    return true;
+}
+
+// Pages 0-2 and 4-8 mapped with random bytes, page 3 a hole
+static void mapRandom( SimulatedBackend& sim, std::mt19937& rng ) {
+    sim.mapMemory(BASE, 3 * PAGE, PAGE_READWRITE);
+    sim.mapMemory(BASE + 4 * PAGE, 5 * PAGE, PAGE_READWRITE);
+    std::vector<BYTE> data(PAGE);
+    for (uintptr_t page : { 0, 1, 2, 4, 5, 6, 7, 8 }) {
+        for (auto& b : data) b = static_cast<BYTE>(rng());
+        sim.writeMemory(BASE + page * PAGE, data.data(), PAGE);
+    }
+}
+
+// Every request against a readMemory of its own
+static bool matchesDirect( SimulatedBackend& sim, const std::vector<ReadRequest_t>& requests, size_t complete ) {
+    size_t ok = 0;
+    for (const ReadRequest_t& r : requests) {
+        std::vector<BYTE> expected(r.size);
+        SIZE_T got = 0;
+        const bool read = sim.readMemory(r.address, expected.data(), r.size, &got);
+        if (read != r.ok || got != r.transferred || std::memcmp(expected.data(), r.buffer, got) != 0) return false;
+        ok += r.ok;
+    }
+    return ok == complete;
+}
+
+static bool run( TestCase tc ) {
+    std::mt19937 rng(23);
+    SimulatedBackend sim;
+    mapRandom(sim, rng);
+
+    switch (tc) {
+        case TestCase::coalesce: {
+            // Out of order: overlapping, adjacent, contained, duplicate, empty and separate
+            const std::vector<ReadRequest_t> requests = {
+                request(0x1010, 8),  // 0
+                request(0x1000, 16), // 1: adjacent to 0
+                request(0x2000, 4),  // 2: separate
+                request(0x1004, 2),  // 3: inside 1
+                request(0x1014, 8),  // 4: overlaps 0
+                request(0x3000, 0),  // 5: empty
+                request(0x2000, 4),  // 6: duplicate of 2
+                request(0x2005, 1),  // 7: one byte after 2
+            };
+            std::vector<size_t> order;
+            const auto ranges = coalesceReads(requests, order);
+            return order == std::vector<size_t>{ 1, 3, 0, 4, 2, 6, 7 }
+                && sameRanges(ranges, { { 0x1000, 0x1C, 0, 4 }, { 0x2000, 4, 4, 2 }, { 0x2005, 1, 6, 1 } });
+        }
+        case TestCase::coalesceGap: {
+            const std::vector<ReadRequest_t> requests = { request(0x1000, 4), request(0x1008, 4), request(0x1020, 4), request(0x1030, 8) };
+            std::vector<size_t> order;
+            const bool four = coalesceReads(requests, order, 3).size() == 4;
+            const auto ranges = coalesceReads(requests, order, 12);
+            return four && sameRanges(ranges, { { 0x1000, 0x0C, 0, 2 }, { 0x1020, 0x18, 2, 2 } })
+                && coalesceReads(requests, order, 0x100).size() == 1 && coalesceReads({}, order).empty() && order.empty();
+        }
+        case TestCase::againstDirect: {
+            for (SIZE_T gap : { SIZE_T(0), SIZE_T(64), SIZE_T(PAGE) }) {
+                for (int round = 0; round < 50; ++round) {
+                    std::vector<ReadRequest_t> requests(1 + rng() % 64);
+                    std::vector<std::vector<BYTE>> buffers(requests.size());
+                    for (size_t i = 0; i < requests.size(); ++i) {
+                        const SIZE_T size = rng() % 7 == 0 ? rng() % (2 * PAGE) : rng() % 32;
+                        buffers[i].assign(size + 1, 0xEE);
+                        requests[i] = ReadRequest_t{ BASE - PAGE + rng() % (11 * PAGE), buffers[i].data(), size };
+                    }
+                    const size_t complete = readBatch(sim, requests, gap);
+                    if (!matchesDirect(sim, requests, complete)) return false;
+                }
+            }
+            return true;
+        }
+        case TestCase::structFields: {
+            // 100 fields of a struct array, listed backwards: one backend read
+            std::vector<uint64_t> fields(100);
+            std::vector<ReadRequest_t> requests;
+            for (size_t i = fields.size(); i-- > 0;) {
+                requests.push_back(ReadRequest_t{ BASE + PAGE + i * 8, &fields[i], 8 });
+            }
+            const uint64_t reads = sim.getStats().memoryReads;
+            ReadBatchStats_t stats;
+            const size_t complete = readBatch(sim, requests, 0, &stats);
+            const uint64_t batchReads = sim.getStats().memoryReads - reads;
+
+            std::vector<uint64_t> direct(fields.size());
+            sim.readMemory(BASE + PAGE, direct.data(), direct.size() * 8);
+            return complete == fields.size() && fields == direct && stats.ranges == 1 && stats.retries == 0
+                && stats.bytes == 800 && batchReads == 1;
+        }
+        case TestCase::brokenRange: {
+            // One merged range across the hole at page 3: the request behind it is read again
+            BYTE a[16], b[16], c[16];
+            std::vector<ReadRequest_t> requests = {
+                { BASE + 3 * PAGE - 8, a, 16 },  // straddles the start of the hole
+                { BASE + 3 * PAGE + 64, b, 16 }, // in the hole
+                { BASE + 4 * PAGE, c, 16 },      // behind it
+            };
+            ReadBatchStats_t stats;
+            const size_t complete = readBatch(sim, requests, PAGE, &stats);
+            return stats.ranges == 1 && stats.retries == 2 && complete == 1 && requests[0].transferred == 8
+                && !requests[1].ok && requests[1].transferred == 0 && requests[2].ok && matchesDirect(sim, requests, complete);
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "regionReader.h"
+#include "patternScanner.h"
+#include "backends/simulatedBackend.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    chunksCoverRegions,
+    patternAcrossChunks,
+    memoryCeiling,
+    earlyStop,
+    unreadableRange,
+    Size
+};
+
+constexpr uintptr_t BASE  = 0x10000000;
+constexpr SIZE_T CHUNK    = 0x4000;
+constexpr SIZE_T OVERLAP  = 7;
+
+// Three regions that do not coalesce: one page, many chunks, a few chunks
+static void mapRegions( SimulatedBackend& sim ) {
+    sim.mapMemory(BASE, 0x1000, PAGE_READONLY, 0x11);
+    sim.mapMemory(BASE + 0x1000, 0x23000, PAGE_READWRITE, 0x22);
+    sim.mapMemory(BASE + 0x30000, 0x5000, PAGE_EXECUTE_READ, 0x33);
+}
+
+static bool run( TestCase tc, bool prefetch ) {
+    SimulatedBackend sim;
+    mapRegions(sim);
+    const std::vector<MemoryRegion_t> regions = sim.getMemoryRegions();
+    RegionReader reader(sim, RegionReaderOptions_t{ CHUNK, 1 << 20, prefetch });
+
+    switch(tc) {
+        case TestCase::chunksCoverRegions: {
+            // Chunks stay inside their region, advance in order and repeat exactly OVERLAP bytes
+            if (regions.size() != 3) return false;
+            std::vector<std::pair<uintptr_t, uintptr_t>> covered(regions.size(), { 0, 0 });
+            uintptr_t lastAddress = 0;
+            bool ok = true;
+            reader.forEachChunk(regions, OVERLAP, [&](const MemoryChunk_t& c) {
+                const size_t r = static_cast<size_t>(c.region - regions.data());
+                const uintptr_t base = reinterpret_cast<uintptr_t>(c.region->BaseAddress);
+                const bool first = c.address == base;
+                ok = ok && c.address >= lastAddress && c.size == c.requested && c.size <= CHUNK
+                    && c.address + c.size <= base + c.region->RegionSize
+                    && c.overlap == (first ? 0 : OVERLAP)
+                    && (first || c.address == covered[r].second - OVERLAP)
+                    && c.data[0] == static_cast<BYTE>(0x11 * (r + 1)) && c.data[c.size - 1] == c.data[0];
+                if (first) covered[r].first = c.address;
+                covered[r].second = c.address + c.size;
+                lastAddress = c.address;
+                return true;
+            });
+            for (size_t r = 0; r < regions.size(); ++r) {
+                const uintptr_t base = reinterpret_cast<uintptr_t>(regions[r].BaseAddress);
+                ok = ok && covered[r].first == base && covered[r].second == base + regions[r].RegionSize;
+            }
+            return ok;
+        }
+        case TestCase::patternAcrossChunks: {
+            // A signature straddling every chunk boundary of the big region is reported once each
+            const BYTE sig[] = { 0xDE, 0xAD, 0xBE, 0xEF, 0x13, 0x37, 0xC0, 0xDE };
+            std::vector<uintptr_t> expected;
+            const SIZE_T step = reader.chunkSize(sizeof(sig) - 1) - (sizeof(sig) - 1);
+            for (uintptr_t at = BASE + 0x1000 + step - 3; at + sizeof(sig) <= BASE + 0x24000; at += step) {
+                sim.writeMemory(at, sig, sizeof(sig));
+                expected.push_back(at);
+            }
+            PatternScanner scanner(BytePattern_t::exact(sig));
+            std::vector<uintptr_t> found;
+            reader.forEachChunk(regions, sizeof(sig) - 1, [&](const MemoryChunk_t& c) {
+                scanner.scan(c.data, c.size, c.address, found);
+                return true;
+            });
+            return expected.size() > 4 && found == expected;
+        }
+        case TestCase::memoryCeiling: {
+            // Both buffers together stay under the limit; the overlap still fits
+            RegionReader small(sim, RegionReaderOptions_t{ 1 << 20, 0x6000, prefetch });
+            const SIZE_T chunk = small.chunkSize(OVERLAP);
+            SIZE_T largest = 0;
+            small.forEachChunk(regions, OVERLAP, [&](const MemoryChunk_t& c) {
+                largest = std::max(largest, c.requested);
+                return true;
+            });
+            return chunk * (prefetch ? 2 : 1) <= 0x6000 && largest == chunk
+                && small.chunkSize(0x8000) == 0x9000;
+        }
+        case TestCase::earlyStop: {
+            size_t calls = 0;
+            const size_t delivered = reader.forEachChunk(regions, 0, [&](const MemoryChunk_t&) { return ++calls < 3; });
+            return delivered == 3 && calls == 3;
+        }
+        case TestCase::unreadableRange: {
+            // A stale region list: unmapped chunks are skipped, a partly mapped one is cut short
+            std::vector<MemoryRegion_t> stale = regions;
+            sim.unmapMemory(BASE + 0x9000, 0x8000);
+            sim.unmapMemory(BASE + 0x33000, 0x2000);
+            SIZE_T total = 0;
+            bool ok = true, cut = false;
+            reader.forEachChunk(stale, 0, [&](const MemoryChunk_t& c) {
+                ok = ok && !(c.address >= BASE + 0x9000 && c.address < BASE + 0x11000) && c.address < BASE + 0x34000;
+                cut = cut || (c.address == BASE + 0x30000 && c.size == 0x3000 && c.requested == CHUNK);
+                total += c.size;
+                return true;
+            });
+            return ok && cut && total == 0x1000 + 0x23000 - 0x8000 + 0x3000;
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        // Same results with and without the prefetch worker
+        if (run(static_cast<TestCase>(i), false) && run(static_cast<TestCase>(i), true)) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sessionMetrics.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    bucketBounds,
+    percentiles,
+    emptyAndReset,
+    remoteCounters,
+    snapshotAndFormat,
+    Size
+};
+
+// Every value lands in a bucket whose upper bound is at most 1/16 above it, buckets in value order
+static bool testBucketBounds() {
+    std::vector<uint64_t> values;
+    for (uint64_t v = 0; v < 4096; ++v) values.push_back(v);
+    for (unsigned shift = 12; shift < 64; ++shift) {
+        const uint64_t p = uint64_t(1) << shift;
+        values.insert(values.end(), { p - 1, p, p + 1, p + p / 3, p + p / 2 + 7 });
+    }
+    values.push_back(UINT64_MAX);
+
+    size_t last = 0;
+    for (uint64_t v : values) {
+        const size_t bucket = LatencyHistogram::bucketOf(v);
+        const uint64_t high = LatencyHistogram::bucketHigh(bucket);
+        if (bucket >= LatencyHistogram::BUCKETS || bucket < last || high < v || high - v > v / 16) return false;
+        if (bucket > 0 && LatencyHistogram::bucketHigh(bucket - 1) >= v) return false;
+        last = bucket;
+    }
+    return LatencyHistogram::bucketOf(UINT64_MAX) == LatencyHistogram::BUCKETS - 1
+        && LatencyHistogram::bucketHigh(LatencyHistogram::BUCKETS - 1) == UINT64_MAX;
+}
+
+static bool near( uint64_t got, uint64_t want ) {
+    return got >= want && got - want <= want / 16;
+}
+
+static bool testPercentiles() {
+    // 1..100000 ns, shuffled by a stride coprime to the count
+    LatencyHistogram h;
+    constexpr uint64_t COUNT = 100000;
+    for (uint64_t i = 0; i < COUNT; ++i) h.record((i * 7919) % COUNT + 1);
+    const LatencySummary_t s = h.summary();
+    return s.count == COUNT && s.minNs == 1 && s.maxNs == COUNT && s.totalNs == COUNT * (COUNT + 1) / 2
+        && s.meanNs() == (COUNT + 1) / 2 && near(s.p50Ns, 50000) && near(s.p90Ns, 90000) && near(s.p99Ns, 99000)
+        && near(s.p999Ns, 99900) && h.percentile(100) == COUNT && h.percentile(0) == 1;
+}
+
+static bool testEmptyAndReset() {
+    LatencyHistogram h;
+    const LatencySummary_t empty = h.summary();
+    if (empty.count || empty.minNs || empty.maxNs || empty.p99Ns || h.percentile(50) != 0) return false;
+
+    // A single value is every percentile, exactly
+    h.record(123456789);
+    const LatencySummary_t one = h.summary();
+    if (one.p50Ns != 123456789 || one.p999Ns != 123456789 || one.minNs != one.maxNs) return false;
+
+    h.reset();
+    h.record(5);
+    const LatencySummary_t again = h.summary();
+    return again.count == 1 && again.minNs == 5 && again.maxNs == 5 && again.p50Ns == 5;
+}
+
+static bool testRemoteCounters() {
+    // Scan workers add from several threads
+    RemoteCounters_t counters;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < 10000; ++i) counters.add(RemoteCall::READ_MEMORY, 0x1000);
+        });
+    }
+    for (std::thread& w : workers) w.join();
+    counters.add(RemoteCall::GET_CONTEXT);
+
+    const RemoteCallStats_t s = counters.snapshot();
+    if (s.callsOf(RemoteCall::READ_MEMORY) != 40000 || s.bytesOf(RemoteCall::READ_MEMORY) != 40000ULL * 0x1000
+        || s.callsOf(RemoteCall::GET_CONTEXT) != 1 || s.bytesOf(RemoteCall::GET_CONTEXT) != 0
+        || s.callsOf(RemoteCall::WRITE_MEMORY) != 0) return false;
+    counters.reset();
+    return counters.snapshot().callsOf(RemoteCall::READ_MEMORY) == 0
+        && std::string(remoteCallName(RemoteCall::FLUSH_INSTRUCTION_CACHE)) == "flush_instruction_cache";
+}
+
+static bool testSnapshotAndFormat() {
+    SessionMetrics metrics;
+    metrics.stopped(DebugEventType::LOAD_DLL).record(2500);
+    metrics.stopped(DebugEventType::LOAD_DLL).record(3500);
+    metrics.callback(MetricCallback::DLL_LOAD).record(1500);
+    metrics.remote().add(RemoteCall::READ_MEMORY, 64);
+
+    const MetricsSnapshot_t s = metrics.snapshot();
+    if (s.eventsOf(DebugEventType::LOAD_DLL) != 2 || s.eventsOf(DebugEventType::EXCEPTION) != 0
+        || s.stoppedOf(DebugEventType::LOAD_DLL).maxNs != 3500 || s.callbackOf(MetricCallback::DLL_LOAD).count != 1
+        || s.remote.bytesOf(RemoteCall::READ_MEMORY) != 64 || s.seconds < 0) return false;
+
+    // Only rows that were counted
+    const std::string text = formatMetrics(s);
+    if (text.find("load_dll") == std::string::npos || text.find("onDLLLoad") == std::string::npos
+        || text.find("read_memory") == std::string::npos || text.find("exception") != std::string::npos
+        || text.find("write_memory") != std::string::npos) return false;
+
+    metrics.reset();
+    const MetricsSnapshot_t cleared = metrics.snapshot();
+    return cleared.eventsOf(DebugEventType::LOAD_DLL) == 0 && cleared.remote.callsOf(RemoteCall::READ_MEMORY) == 0
+        && std::string(eventTypeName(DebugEventType::DEBUG_STRING)) == "debug_string"
+        && std::string(metricCallbackName(MetricCallback::BREAKPOINT)) == "onBreakpoint";
+}
+
+static bool run( TestCase tc ) {
+    switch(tc) {
+        case TestCase::bucketBounds:      return testBucketBounds();
+        case TestCase::percentiles:       return testPercentiles();
+        case TestCase::emptyAndReset:     return testEmptyAndReset();
+        case TestCase::remoteCounters:    return testRemoteCounters();
+        case TestCase::snapshotAndFormat: return testSnapshotAndFormat();
+        default: return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
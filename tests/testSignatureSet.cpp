@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "signatureSet.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    againstNaive,
+    chunkedScan,
+    saveAndLoad,
+    rejectBadFiles,
+    notCompiled,
+    Size
+};
+
+constexpr uintptr_t BASE = 0x400000;
+
+static std::vector<SignatureMatch_t> naive( const SignatureSet& set, const std::vector<BYTE>& data ) {
+    std::vector<SignatureMatch_t> out;
+    for (size_t i = 0; i < data.size(); ++i) {
+        for (uint32_t id = 0; id < set.size(); ++id) {
+            const BytePattern_t& p = set.pattern(id);
+            if (i + p.size() > data.size()) continue;
+            bool ok = true;
+            for (size_t j = 0; j < p.size() && ok; ++j) ok = (data[i + j] & p.mask[j]) == p.value[j];
+            if (ok) out.push_back(SignatureMatch_t{ id, BASE + i });
+        }
+    }
+    return out;
+}
+
+// Small alphabet data and signatures cut from it: shared prefixes, anchors inside other anchors,
+// duplicates, wildcards and nibble-only signatures
+static void build( std::vector<BYTE>& data, SignatureSet& set ) {
+    std::mt19937 rng(5);
+    data.resize(1 << 16);
+    for (auto& b : data) b = static_cast<BYTE>(0x40 + rng() % 6);
+    for (int n = 0; n < 200; ++n) {
+        const size_t len = 1 + rng() % 24;
+        const size_t at = rng() % (data.size() - len);
+        BytePattern_t p = BytePattern_t::exact(std::span<const BYTE>(data.data() + at, len));
+        const int style = n % 5;
+        for (size_t j = 0; j < len; ++j) {
+            if (style == 1 && rng() % 4 == 0) p.mask[j] = 0x00;
+            if (style == 2 && rng() % 3 == 0) p.mask[j] = (rng() & 1) ? 0xF0 : 0x0F;
+            if (style == 3) p.mask[j] = 0x0F; // no fully fixed byte
+            p.value[j] &= p.mask[j];
+        }
+        if (style == 4 && n > 10) p = set.pattern(rng() % set.size()); // duplicate
+        set.add(p, "sig" + std::to_string(n));
+    }
+    set.add("41 42 43 44 45 46 47 48 49 4A", "long anchor");
+    set.add("44 45 46", "inside long anchor");
+    set.compile();
+}
+
+static std::vector<BYTE> slurp( const std::string& path ) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<BYTE>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void spill( const std::string& path, const std::vector<BYTE>& data ) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+static bool run( TestCase tc ) {
+    std::vector<BYTE> data;
+    SignatureSet set;
+    build(data, set);
+    const std::string path = (std::filesystem::temp_directory_path() / "robodbg_sigset.bin").string();
+
+    switch(tc) {
+        case TestCase::againstNaive: {
+            std::vector<SignatureMatch_t> got;
+            set.scan(data.data(), data.size(), BASE, got);
+            return !got.empty() && got == naive(set, data);
+        }
+        case TestCase::chunkedScan: {
+            // Chunks overlapping by maxLength() - 1, each reporting the matches that start before the next chunk
+            std::vector<SignatureMatch_t> whole, chunked;
+            set.scan(data.data(), data.size(), BASE, whole);
+            const size_t overlap = set.maxLength() - 1;
+            for (size_t chunk : { size_t(64), size_t(1000), size_t(4096) }) {
+                chunked.clear();
+                for (size_t at = 0; at < data.size(); at += chunk - overlap) {
+                    const size_t size = std::min(chunk, data.size() - at);
+                    const bool last = at + size == data.size();
+                    set.scan(data.data() + at, size, BASE + at, chunked, last ? size : chunk - overlap);
+                    if (last) break;
+                }
+                if (chunked != whole) return false;
+            }
+            return true;
+        }
+        case TestCase::saveAndLoad: {
+            SignatureSet loaded;
+            if (!set.save(path) || !loaded.load(path)) return false;
+            std::filesystem::remove(path);
+            std::vector<SignatureMatch_t> a, b;
+            set.scan(data.data(), data.size(), BASE, a);
+            loaded.scan(data.data(), data.size(), BASE, b);
+            bool ok = a == b && loaded.size() == set.size() && loaded.states() == set.states()
+                && loaded.maxLength() == set.maxLength() && loaded.compiled();
+            for (uint32_t id = 0; ok && id < set.size(); ++id) {
+                ok = loaded.name(id) == set.name(id) && loaded.pattern(id).value == set.pattern(id).value
+                    && loaded.pattern(id).mask == set.pattern(id).mask;
+            }
+            return ok && loaded.name(static_cast<uint32_t>(set.size() - 1)) == "inside long anchor";
+        }
+        case TestCase::rejectBadFiles: {
+            // A rejected file leaves the set as it was
+            if (!set.save(path)) return false;
+            const std::vector<BYTE> good = slurp(path);
+            SignatureSet target;
+            target.add("90 90");
+            target.compile();
+            bool ok = !target.load(path + ".missing");
+
+            std::vector<BYTE> bad = good;
+            bad[0] = 'X';
+            spill(path, bad);
+            ok = ok && !target.load(path);
+
+            spill(path, std::vector<BYTE>(good.begin(), good.end() - 1));
+            ok = ok && !target.load(path);
+
+            bad = good;
+            bad.push_back(0);
+            spill(path, bad);
+            ok = ok && !target.load(path);
+
+            bad = good;
+            for (size_t i = 8; i < 28; ++i) bad[i] = 0xFF; // absurd counts
+            spill(path, bad);
+            ok = ok && !target.load(path);
+
+            // First anchor at offset 0xFFFFFFFF, length 1: the sum wraps to 0 in 32 bits
+            bad = good;
+            const uint32_t firstLength = bad[24] | bad[25] << 8 | bad[26] << 16 | uint32_t(bad[27]) << 24;
+            const size_t anchorAt = 28 + 2 * size_t(firstLength);
+            for (size_t i = 0; i < 4; ++i) bad[anchorAt + i] = 0xFF;
+            bad[anchorAt + 4] = 1;
+            for (size_t i = 5; i < 8; ++i) bad[anchorAt + i] = 0;
+            spill(path, bad);
+            ok = ok && !target.load(path);
+
+            // Last output entry: an id past the signature count
+            bad = good;
+            bad[bad.size() - 4] = 0xFF;
+            bad[bad.size() - 3] = 0xFF;
+            spill(path, bad);
+            ok = ok && !target.load(path);
+
+            std::filesystem::remove(path);
+            return ok && target.size() == 1 && target.compiled() && target.name(0) == "90 90";
+        }
+        case TestCase::notCompiled: {
+            SignatureSet fresh;
+            std::vector<SignatureMatch_t> got;
+            const bool rejected = fresh.add("56 5") == -1 && fresh.add(BytePattern_t{}) == -1;
+            const int id = fresh.add("41 42");
+            if (!rejected || id != 0 || fresh.scan(data.data(), data.size(), BASE, got) != 0 || fresh.save(path)) return false;
+            fresh.compile();
+            if (fresh.scan(data.data(), data.size(), BASE, got) == 0) return false;
+            fresh.add("43 44"); // adding invalidates the automaton
+            return !fresh.compiled() && fresh.scan(data.data(), data.size(), BASE, got) == 0;
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,823 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "debugger.h"
+#include "backends/simulatedBackend.h"
+
+// Runs the Debugger event loop against the deterministic simulated target (any OS).
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+constexpr uintptr_t IMAGE_BASE  = 0x0000000140000000ULL;
+constexpr uintptr_t ENTRY_POINT = IMAGE_BASE + 0x1000;
+constexpr uintptr_t BP_ADDRESS  = ENTRY_POINT + 4;
+constexpr uintptr_t HW_ADDRESS  = ENTRY_POINT + 8;
+constexpr uintptr_t BP2_ADDRESS = ENTRY_POINT + 12;
+constexpr uintptr_t DATA_ADDRESS  = IMAGE_BASE + 0x1800;
+constexpr uintptr_t DATA2_ADDRESS = IMAGE_BASE + 0x1810;
+constexpr int LOOP_BODY  = 16;
+constexpr int LOOP_COUNT = 100;
+constexpr DWORD THREADS  = 64;
+constexpr int ROUNDS     = 50;
+constexpr int DLL_COUNT  = 300;
+
+enum TestCase {
+    breakpointRestore,
+    breakpointBreak,
+    hardwareBreakpoint,
+    changeRegister,
+    threadsAndModules,
+    deterministicReplay,
+    bulkBreakpoints,
+    retiredBreakpoints,
+    threadsOnOneBreakpoint,
+    threadsOnOneBreakpointBreak,
+    threadsOnRemovedBreakpoint,
+    threadsOnTwoBreakpoints,
+    displacedRestore,
+    displacedThreads,
+    registerCache,
+    dataWatchpoint,
+    searchSignature,
+    streamedMemory,
+    searchMulti,
+    valueScan,
+    memoryCache,
+    stringExtraction,
+    eventsMasked,
+    eventsAll,
+    lazyEvents,
+    asyncEvents,
+    sessionMetrics,
+    metricsToggled,
+    tracing,
+    Size
+};
+
+using namespace RoboDBG;
+
+static std::string traceFile( ) {
+    return (std::filesystem::temp_directory_path() / "robodbg_trace.json").string();
+}
+
+static std::vector<SimEvent_t> loopScript( ) {
+    std::vector<SimEvent_t> script;
+    for (int i = 0; i < LOOP_BODY; ++i) {
+        script.push_back(SimEvent_t::execute(SimulatedBackend::MAIN_THREAD_ID, ENTRY_POINT + i));
+    }
+    return script;
+}
+
+// Every thread runs the instruction before, at and after BP_ADDRESS. All threads reach the
+// int3 in the same quantum, so THREADS breakpoint events are pending at once.
+static std::vector<SimEvent_t> threadsScript( ) {
+    std::vector<SimEvent_t> script;
+    for (DWORD t = 2; t <= THREADS; ++t) script.push_back(SimEvent_t::createThread(t, BP_ADDRESS - 1));
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (DWORD t = 1; t <= THREADS; ++t) script.push_back(SimEvent_t::execute(t, BP_ADDRESS - 1));
+        script.push_back(SimEvent_t::execute(1, BP_ADDRESS));
+        for (DWORD t = 2; t <= THREADS; ++t) script.push_back(SimEvent_t::execute(t, BP_ADDRESS).concurrently());
+        for (DWORD t = 1; t <= THREADS; ++t) script.push_back(SimEvent_t::execute(t, BP_ADDRESS + 1));
+    }
+    for (DWORD t = 2; t <= THREADS; ++t) script.push_back(SimEvent_t::exitThread(t));
+    return script;
+}
+
+// Writes and reads around two watched variables: a write-only DWORD and a read/write QWORD
+static std::vector<SimEvent_t> watchScript( ) {
+    const DWORD tid = SimulatedBackend::MAIN_THREAD_ID;
+    return {
+        SimEvent_t::execute(tid, ENTRY_POINT),
+        SimEvent_t::access(tid, DATA_ADDRESS, 4, true),      // hit DR1
+        SimEvent_t::access(tid, DATA_ADDRESS + 2, 1, false), // read: no hit
+        SimEvent_t::access(tid, DATA_ADDRESS + 4, 4, true),  // behind the DWORD: no hit
+        SimEvent_t::execute(tid, ENTRY_POINT + 1),
+        SimEvent_t::access(tid, DATA2_ADDRESS, 8, false),    // hit DR2
+    };
+}
+
+// Two threads hit different breakpoints in the same quantum; both step-overs are in flight together
+static std::vector<SimEvent_t> twoBreakpointsScript( ) {
+    std::vector<SimEvent_t> script = { SimEvent_t::createThread(2, BP2_ADDRESS) };
+    for (int r = 0; r < ROUNDS; ++r) {
+        script.push_back(SimEvent_t::execute(1, BP_ADDRESS));
+        script.push_back(SimEvent_t::execute(2, BP2_ADDRESS).concurrently());
+        script.push_back(SimEvent_t::execute(1, BP_ADDRESS + 1));
+        script.push_back(SimEvent_t::execute(2, BP2_ADDRESS + 1));
+    }
+    return script;
+}
+
+class SimTester : public Debugger {
+private:
+    TestCase testCase;
+public:
+    SimulatedBackend* sim;
+    int hits = 0;
+    int threadsCreated = 0;
+    int threadsExited = 0;
+    size_t removed = 0;
+    int unknownExceptions = 0;
+    int accessViolations = 0;
+    int dllLoads = 0;
+    int debugStrings = 0;
+    bool subscriptionKept = false;
+    std::thread::id loopThread;
+    int asyncCallbacks = 0;
+    bool asyncInOrder = true;
+    int dllLoadsAtEnd = 0;
+    EventPumpStats_t pumpStats;
+    int metricDumps = 0;
+    bool metricsAtEnd = false;
+    uint64_t dumpedBreakpoints = 0;
+    std::map<DWORD, int> hitsPerThread;
+    std::string dllName;
+    size_t threadsAtDllLoad = 0;
+    size_t threadsAtDllUnload = 0;
+    bool createdRegistered = false;
+    bool moduleAtLoad = false, moduleAtUnload = false, moduleAfterUnload = true;
+    uint64_t lookupQueries = 0;
+    int cacheMismatches = 0;
+    int queryReads = 0;
+    uint64_t pageReads = 0;
+    PageCacheStats_t cacheStats;
+    std::map<DRReg, int> hitsPerReg;
+    std::vector<uintptr_t> found, foundExact, foundInvalid, foundParallel, foundFirst;
+    std::vector<SignatureMatch_t> multi, multiParallel, multiFirst;
+    size_t valueFirst = 0, valueNext = 0;
+    std::vector<ValueHit_t> valueHits;
+    std::string cString, cStringCut;
+    std::u16string wString;
+    std::vector<StringHit_t> strings, stringsExpected, stringsStreamed;
+    bool dumpedWhole = false, dumpedPartial = false;
+    std::vector<BYTE> dumpWhole, dumpPartial;
+    std::string dbgString;
+    DWORD exitStatus = 0;
+    size_t maxRetired = 0;
+    bool rearmForgotten = false;
+
+    SimTester( TestCase testId, std::unique_ptr<SimulatedBackend> backend )
+        : Debugger(std::move(backend)), testCase(testId) {
+        sim = static_cast<SimulatedBackend*>(&getBackend());
+        if (testCase == TestCase::eventsMasked) {
+            setEventMask(EVENT_START | EVENT_EXCEPTION);
+            setExceptionSubscribed(EXCEPTION_INT_DIVIDE_BY_ZERO, false);
+            subscriptionKept = getEventMask() == (EVENT_START | EVENT_EXCEPTION)
+                && !isExceptionSubscribed(EXCEPTION_INT_DIVIDE_BY_ZERO) && isExceptionSubscribed(EXCEPTION_ACCESS_VIOLATION);
+        }
+        if (testCase == TestCase::asyncEvents) setAsyncEvents(EVENT_INFORMATIONAL, EventPumpOptions_t{ 64, OverflowPolicy::BLOCK });
+        if (testCase == TestCase::sessionMetrics || testCase == TestCase::metricsToggled) setMetrics(true, 1);
+        if (testCase == TestCase::tracing) setTracing(true, traceFile());
+    }
+
+    MetricsSnapshot_t metricsNow() const { return getMetrics(); }
+    uint64_t traceDropped() const { return getTraceDropped(); }
+
+    void onMetrics( const MetricsSnapshot_t& snapshot ) override {
+        ++metricDumps;
+        dumpedBreakpoints = snapshot.callbackOf(MetricCallback::BREAKPOINT).count;
+    }
+
+    void onStart( uintptr_t /*imageBase*/, uintptr_t /*entryPoint*/ ) override {
+        switch(testCase) {
+            case TestCase::breakpointRestore:
+            case TestCase::breakpointBreak:
+            case TestCase::changeRegister:
+            case TestCase::registerCache:
+            case TestCase::deterministicReplay:
+            case TestCase::sessionMetrics:
+            case TestCase::metricsToggled:
+            case TestCase::tracing:
+            case TestCase::threadsOnOneBreakpoint:
+            case TestCase::threadsOnOneBreakpointBreak:
+            case TestCase::threadsOnRemovedBreakpoint:
+                setBreakpoint( ASLR(BP_ADDRESS - IMAGE_BASE) );
+                break;
+            case TestCase::displacedRestore:
+            case TestCase::displacedThreads:
+                setDisplacedStepping( true );
+                setBreakpoint( BP_ADDRESS );
+                break;
+            case TestCase::threadsOnTwoBreakpoints:
+                setBreakpoint( BP_ADDRESS );
+                setBreakpoint( BP2_ADDRESS );
+                break;
+            case TestCase::bulkBreakpoints:
+            case TestCase::retiredBreakpoints: {
+                std::vector<uintptr_t> addrs;
+                for (int i = 0; i < LOOP_BODY; ++i) addrs.push_back(ENTRY_POINT + i);
+                setBreakpoints(addrs);
+                break;
+            }
+            case TestCase::hardwareBreakpoint:
+                setHardwareBreakpoint( reinterpret_cast<LPVOID>(HW_ADDRESS), DRReg::DR0, AccessType::EXECUTE, BreakpointLength::BYTE );
+                break;
+            case TestCase::searchSignature: {
+                // At the start of the image, across the page boundary and at the very end
+                const BYTE a[] = { 0x56, 0x57, 0xFC, 0x8B, 0x54 };
+                const BYTE b[] = { 0x56, 0x57, 0x00, 0x8B, 0x54 };
+                sim->writeMemory(IMAGE_BASE, a, sizeof(a));
+                sim->writeMemory(IMAGE_BASE + 0xFFE, b, sizeof(b));
+                sim->writeMemory(IMAGE_BASE + 0x2000 - sizeof(a), b, sizeof(b));
+                found = searchInMemory("56 57 ?? 8B 54");
+                foundExact = searchInMemory({ 0x56, 0x57, 0xFC, 0x8B, 0x54 });
+                foundInvalid = searchInMemory("56 5");
+                foundParallel = searchInMemory("56 57 ?? 8B 54", ScanOptions_t{ 4, 0x1000, 0 });
+                foundFirst = searchInMemory("56 57 ?? 8B 54", ScanOptions_t{ 3, 0x1000, 2 });
+                break;
+            }
+            case TestCase::streamedMemory: {
+                // Chunks of 0x1004 bytes repeating 4: the signature crosses the end of the first one
+                setReaderOptions( RegionReaderOptions_t{ 0x1000, 0x2000, true } );
+                const BYTE a[] = { 0x56, 0x57, 0xFC, 0x8B, 0x54 };
+                sim->writeMemory(IMAGE_BASE + 0x1002, a, sizeof(a));
+                found = searchInMemory("56 57 FC 8B 54");
+
+                // The second dump runs 0x100 bytes past the mapping; the tail is zero-filled
+                const auto path = (std::filesystem::temp_directory_path() / "robodbg_dump.bin").string();
+                auto slurp = [&] {
+                    std::ifstream in(path, std::ios::binary);
+                    return std::vector<BYTE>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+                };
+                dumpedWhole = dumpMemory(IMAGE_BASE, 0x2000, path);
+                dumpWhole = slurp();
+                dumpedPartial = dumpMemory(IMAGE_BASE + 0x1F00, 0x200, path);
+                dumpPartial = slurp();
+                std::filesystem::remove(path);
+                break;
+            }
+            case TestCase::searchMulti: {
+                // Same bytes as searchSignature plus a ret; 4 KB chunks split the match at +0xFFE
+                const BYTE a[] = { 0x56, 0x57, 0xFC, 0x8B, 0x54 };
+                const BYTE b[] = { 0x56, 0x57, 0x00, 0x8B, 0x54 };
+                const BYTE ret = 0xC3;
+                sim->writeMemory(IMAGE_BASE, a, sizeof(a));
+                sim->writeMemory(IMAGE_BASE + 0xFFE, b, sizeof(b));
+                sim->writeMemory(IMAGE_BASE + 0x1A00, &ret, 1);
+                SignatureSet set;
+                set.add("56 57 FC 8B 54");
+                set.add("56 57 ?? 8B 54");
+                set.add("90 90 C3");
+                set.compile();
+                multi = searchInMemoryMulti(set, ScanOptions_t{ 1, 0x1000, 0 });
+                multiParallel = searchInMemoryMulti(set, ScanOptions_t{ 3, 0x1000, 0 });
+                multiFirst = searchInMemoryMulti(set, ScanOptions_t{ 2, 0x1000, 3 });
+                break;
+            }
+            case TestCase::valueScan: {
+                // 1500 in two places; one drops to 1400 before the next scan
+                const int32_t health = 1500, hurt = 1400;
+                sim->writeMemory(IMAGE_BASE + 0x1900, &health, sizeof(health));
+                sim->writeMemory(IMAGE_BASE + 0x1A40, &health, sizeof(health));
+                ValueScanner scanner = createValueScanner(ValueType::INT32);
+                valueFirst = scanner.firstScan(ScanCompare::EXACT, ScanValue_t::of(int64_t(1500)));
+                sim->writeMemory(IMAGE_BASE + 0x1A40, &hurt, sizeof(hurt));
+                valueNext = scanner.nextScan(ScanCompare::DECREASED);
+                valueHits = scanner.results(0, 10);
+                break;
+            }
+            case TestCase::stringExtraction: {
+                // Words of 1..70 characters every 0x7B bytes, every third one UTF-16, clear of the loop code
+                for (int k = 0; k < 60; ++k) {
+                    const uintptr_t at = IMAGE_BASE + 0x20 + k * 0x7B;
+                    if (at >= ENTRY_POINT - 0x100 && at < ENTRY_POINT + 0x40) continue;
+                    for (int c = 0; c <= k % 70; ++c) {
+                        const char16_t ch = static_cast<char16_t>('A' + (k + c) % 26);
+                        if (k % 3 == 0) sim->writeMemory(at + 2 * c, &ch, 2);
+                        else sim->writeMemory(at + c, &ch, 1);
+                    }
+                }
+                sim->writeMemory(IMAGE_BASE + 0x1F00, u"wide", 10);
+                sim->writeMemory(IMAGE_BASE + 0x1FFA, "at end", 6); // unterminated, up to the end of the mapping
+                cString = readCString(IMAGE_BASE + 0x1FFA);
+                cStringCut = readCString(IMAGE_BASE + 0x1FFA, 3);
+                wString = readWString(IMAGE_BASE + 0x1F00);
+
+                // 0x200-byte items repeating 128 bytes must find what one pass over the whole image finds
+                const StringScanOptions_t options{ 4, 64, true, true };
+                std::vector<BYTE> image(0x2000);
+                sim->readMemory(IMAGE_BASE, image.data(), image.size());
+                StringScanner(options).scan(image.data(), image.size(), IMAGE_BASE, stringsExpected);
+                strings = extractStrings(options, ScanOptions_t{ 3, 0x200, 0 });
+                extractStrings([&](const StringHit_t& hit) {
+                    stringsStreamed.push_back(hit);
+                    return stringsStreamed.size() < 3;
+                }, options);
+                break;
+            }
+            case TestCase::eventsMasked:
+            case TestCase::eventsAll:
+            case TestCase::lazyEvents:
+            case TestCase::asyncEvents:
+                loopThread = std::this_thread::get_id();
+                setBreakpoint( BP_ADDRESS );
+                break;
+            case TestCase::memoryCache: {
+                const int32_t zero = 0;
+                sim->writeMemory(DATA_ADDRESS, &zero, sizeof(zero));
+                setMemoryCache( true );
+                setBreakpoint( BP_ADDRESS );
+                break;
+            }
+            case TestCase::dataWatchpoint:
+                setHardwareBreakpoint( reinterpret_cast<LPVOID>(DATA_ADDRESS), DRReg::DR1, AccessType::WRITE, BreakpointLength::DWORD );
+                setHardwareBreakpoint( reinterpret_cast<LPVOID>(DATA2_ADDRESS), DRReg::DR2, AccessType::READWRITE, BreakpointLength::QWORD );
+                break;
+            default:
+                break;
+        }
+    }
+
+    void onEnd( DWORD exitCode, DWORD /*pid*/ ) override {
+        exitStatus = exitCode;
+        dllLoadsAtEnd = dllLoads;
+        pumpStats = getEventPumpStats();
+        metricsAtEnd = getMetricsEnabled();
+        cacheStats = getMemoryCacheStats();
+        if (testCase == TestCase::threadsAndModules) moduleAfterUnload = getModuleByAddress(0x7FF800000000ULL) != nullptr;
+    }
+
+    BreakpointAction onBreakpoint( uintptr_t address, HANDLE hThread ) override {
+        if (testCase == TestCase::retiredBreakpoints) {
+            // Every hit removes its breakpoint; setting one again forgets that it was removed
+            ++hits;
+            maxRetired = std::max(maxRetired, getRetiredBreakpointCount());
+            if (hits == 2) {
+                const size_t before = getRetiredBreakpointCount();
+                setBreakpoint( ENTRY_POINT );
+                rearmForgotten = before == 1 && getRetiredBreakpointCount() == 0;
+            }
+            return BREAK;
+        }
+        if (testCase == TestCase::bulkBreakpoints) {
+            // Disarm everything once the first pass is done
+            if (++hits == LOOP_BODY) {
+                std::vector<uintptr_t> addrs;
+                for (int i = 0; i < LOOP_BODY; ++i) addrs.push_back(ENTRY_POINT + i);
+                removed = removeBreakpoints(addrs);
+            }
+            return RESTORE;
+        }
+        if (testCase == TestCase::threadsOnTwoBreakpoints && address == BP2_ADDRESS) {
+            ++hits;
+            ++hitsPerThread[static_cast<DWORD>(reinterpret_cast<uintptr_t>(hThread))];
+            return RESTORE;
+        }
+        if (address != BP_ADDRESS) return BREAK;
+        ++hitsPerThread[static_cast<DWORD>(reinterpret_cast<uintptr_t>(hThread))]; // handle == TID
+        ++hits;
+        switch(testCase) {
+            case TestCase::breakpointBreak:
+            case TestCase::threadsOnOneBreakpointBreak:
+                return BREAK;
+            case TestCase::threadsOnRemovedBreakpoint: {
+                // Removed in bulk while the other threads' hits are still queued
+                const uintptr_t addrs[] = { BP_ADDRESS };
+                removeBreakpoints(addrs);
+                return RESTORE;
+            }
+            case TestCase::sessionMetrics:
+                // One slow callback: it shows in both histograms and lets a dump period run out
+                if (hits == 1) std::this_thread::sleep_for(std::chrono::milliseconds(3));
+                return RESTORE;
+            case TestCase::metricsToggled:
+                // Restarted, off, on: the histogram this callback is timed into goes away under it
+                setMetrics(hits % 3 != 2, 1);
+                return RESTORE;
+            case TestCase::changeRegister:
+            #ifdef ROBODBG_X64
+                setRegister(hThread, Register64::RAX, getRegister(hThread, Register64::RAX) + 1);
+            #else
+                setRegister(hThread, Register32::EAX, getRegister(hThread, Register32::EAX) + 1);
+            #endif
+                return RESTORE;
+            case TestCase::memoryCache: {
+                // Written behind the cache at the previous hit: the cache was emptied when that stop was continued
+                if (readMemory<int32_t>(DATA_ADDRESS) != hits - 1) ++cacheMismatches;
+
+                // Byte-sized reads of the page are copies
+                const uint64_t reads = sim->getStats().memoryReads;
+                for (int i = 0; i < 256; ++i) {
+                    if (readMemory<BYTE>(DATA_ADDRESS + 0x100 + i) != 0x90) ++cacheMismatches;
+                }
+                pageReads += sim->getStats().memoryReads - reads;
+
+                // Write-through
+                writeMemory<int32_t>(DATA_ADDRESS + 8, hits);
+                if (readMemory<int32_t>(DATA_ADDRESS + 8) != hits) ++cacheMismatches;
+                const int32_t current = hits;
+                sim->writeMemory(DATA_ADDRESS, &current, sizeof(current));
+                return RESTORE;
+            }
+            case TestCase::registerCache: {
+                // Several reads and writes in one stop; each sees the previous write
+            #ifdef ROBODBG_X64
+                const int64_t rax = getRegister(hThread, Register64::RAX);
+                setRegister(hThread, Register64::RAX, rax + 1);
+                setRegister(hThread, Register64::RBX, getRegister(hThread, Register64::RAX) + getRegister(hThread, Register64::RCX));
+                if (getRegister(hThread, Register64::RIP) != static_cast<int64_t>(address)) ++cacheMismatches;
+                setFlag(hThread, Flags64::CF, true);
+                if (!getFlag(hThread, Flags64::CF)) ++cacheMismatches;
+            #else
+                const int32_t eax = getRegister(hThread, Register32::EAX);
+                setRegister(hThread, Register32::EAX, eax + 1);
+                setRegister(hThread, Register32::EBX, getRegister(hThread, Register32::EAX) + getRegister(hThread, Register32::ECX));
+                if (getRegister(hThread, Register32::EIP) != static_cast<int32_t>(address)) ++cacheMismatches;
+                setFlag(hThread, Flags32::CF, true);
+                if (!getFlag(hThread, Flags32::CF)) ++cacheMismatches;
+            #endif
+                return RESTORE;
+            }
+            default:
+                return RESTORE;
+        }
+    }
+
+    BreakpointAction onHardwareBreakpoint( uintptr_t address, HANDLE /*hThread*/, DRReg reg ) override {
+        if (testCase == TestCase::dataWatchpoint) {
+            if ((reg == DRReg::DR1 && address == DATA_ADDRESS) || (reg == DRReg::DR2 && address == DATA2_ADDRESS))
+                ++hitsPerReg[reg];
+            return RESTORE;
+        }
+        if (address == HW_ADDRESS && reg == DRReg::DR0) ++hits;
+
+        // Served from the debug register shadows
+        const uint64_t reads = sim->getStats().contextReads;
+        const std::vector<hwBp_t> all = getHardwareBreakpoints();
+        if (all.size() != 1 || all[0].address != reinterpret_cast<LPVOID>(HW_ADDRESS) || all[0].len != BreakpointLength::BYTE
+            || isHardwareBreakpointAt(HW_ADDRESS) != DRReg::DR0 || getBreakpointByReg(DRReg::DR0).type != AccessType::EXECUTE)
+            ++queryReads;
+        queryReads += static_cast<int>(sim->getStats().contextReads - reads);
+        return RESTORE;
+    }
+
+    void onUnknownException( uintptr_t /*addr*/, DWORD /*code*/ ) override {
+        ++unknownExceptions;
+    }
+
+    void onAccessViolation( uintptr_t /*address*/, uintptr_t /*faultingAddress*/, long /*accessType*/ ) override {
+        ++accessViolations;
+    }
+
+    void onThreadCreate( HANDLE hThread, DWORD threadId, uintptr_t /*threadBase*/, uintptr_t startAddress ) override {
+        ++threadsCreated;
+        if (testCase == TestCase::asyncEvents) return; // the registry belongs to the loop thread
+        const ThreadInfo_t* thread = getThreads().find(threadId);
+        createdRegistered = thread && thread->hThread == hThread && thread->startAddress == startAddress;
+    }
+
+    void onThreadExit( DWORD /*threadId*/ ) override {
+        ++threadsExited;
+    }
+
+    bool onDLLLoad( uintptr_t address, std::string name, uintptr_t entryPoint ) override {
+        ++dllLoads;
+        if (entryPoint == address + 0x1234) dllName = name;
+        threadsAtDllLoad = getThreads().size();
+
+        // Sized from the PE header; the main module is known too
+        const Module_t* dll = getModuleByAddress(address + 0x2FFF);
+        const Module_t* main = getModuleByAddress(ENTRY_POINT);
+        moduleAtLoad = dll && dll->name == name && dll->base == address && dll->size == 0x3000
+            && !getModuleByAddress(address + 0x3000) && main && main->name == "sim.exe";
+
+        // Page lookups are answered by the index
+        const uint64_t queries = sim->getStats().regionQueries;
+        for (int i = 0; i < 100; ++i) {
+            if (getPageByAddress(address + 0x1000).RegionSize == 0 || getPageByAddress(ENTRY_POINT).RegionSize == 0) ++lookupQueries;
+        }
+        lookupQueries += sim->getStats().regionQueries - queries;
+        return false;
+    }
+
+    // Event objects: nothing is read unless asked for
+    bool onDLLLoadEvent( EventInfo& event ) override {
+        if (testCase == TestCase::asyncEvents) {
+            // Delivered on the pump's thread, in load order, from the copied payload
+            if (std::this_thread::get_id() != loopThread) ++asyncCallbacks;
+            if (event.moduleName() != "lib" + std::to_string(dllLoads) + ".dll") asyncInOrder = false;
+            ++dllLoads;
+            return true;
+        }
+        if (testCase != TestCase::lazyEvents) return Debugger::onDLLLoadEvent(event);
+        ++dllLoads;
+        return event.imageBase() != 0;
+    }
+
+    void onDebugStringEvent( EventInfo& event ) override {
+        if (testCase != TestCase::lazyEvents) return Debugger::onDebugStringEvent(event);
+        if (event.type() == DebugEventType::DEBUG_STRING) ++debugStrings;
+    }
+
+    void onDLLUnload( uintptr_t address, std::string name ) override {
+        if (testCase == TestCase::asyncEvents) {
+            if (name != "lib0.dll" || dllLoads != DLL_COUNT) asyncInOrder = false;
+            return;
+        }
+        threadsAtDllUnload = getThreads().size();
+        moduleAtUnload = getModuleByAddress(address) != nullptr;
+    }
+
+    void onDebugString( std::string dbgString ) override {
+        this->dbgString = dbgString;
+        ++debugStrings;
+    }
+};
+
+static std::unique_ptr<SimTester> run( TestCase tc ) {
+    auto sim = std::make_unique<SimulatedBackend>();
+    sim->setImage("sim.exe", IMAGE_BASE, ENTRY_POINT);
+    sim->mapMemory(IMAGE_BASE, 0x2000, PAGE_EXECUTE_READ);
+
+    if (tc == TestCase::threadsAndModules) {
+        std::vector<SimEvent_t> script = {
+            SimEvent_t::createThread(2, ENTRY_POINT),
+            SimEvent_t::execute(2, ENTRY_POINT),
+            SimEvent_t::loadDll(0x7FF800000000ULL, "kernel32.dll", 0x7FF800001234ULL),
+            SimEvent_t::debugString(2, "hello"),
+            SimEvent_t::exitThread(2),
+            SimEvent_t::unloadDll(0x7FF800000000ULL),
+            SimEvent_t::exitProcess(7),
+            SimEvent_t::execute(1, ENTRY_POINT), // never reached
+        };
+        sim->setScript(script);
+
+        // Minimal PE header: e_lfanew, signature and SizeOfImage
+        const uintptr_t dll = 0x7FF800000000ULL;
+        const uint32_t lfanew = 0x80, sizeOfImage = 0x3000;
+        sim->mapMemory(dll, 0x3000, PAGE_READONLY, 0);
+        sim->writeMemory(dll, "MZ", 2);
+        sim->writeMemory(dll + 0x3C, &lfanew, sizeof(lfanew));
+        sim->writeMemory(dll + lfanew, "PE\0\0", 4);
+        sim->writeMemory(dll + lfanew + 0x50, &sizeOfImage, sizeof(sizeOfImage));
+    } else if (tc == TestCase::threadsOnOneBreakpoint || tc == TestCase::threadsOnOneBreakpointBreak ||
+               tc == TestCase::threadsOnRemovedBreakpoint || tc == TestCase::displacedThreads) {
+        sim->setScript(threadsScript());
+    } else if (tc == TestCase::eventsMasked || tc == TestCase::eventsAll || tc == TestCase::lazyEvents ||
+               tc == TestCase::asyncEvents) {
+        // A noisy start: 300 DLLs, a debug string each, two exceptions, then one pass over the loop
+        std::vector<SimEvent_t> script = { SimEvent_t::createThread(2, ENTRY_POINT) };
+        for (int i = 0; i < DLL_COUNT; ++i) {
+            script.push_back(SimEvent_t::loadDll(0x7FF800000000ULL + i * 0x10000ULL, "lib" + std::to_string(i) + ".dll", 0x1234));
+            script.push_back(SimEvent_t::debugString(SimulatedBackend::MAIN_THREAD_ID, "spam"));
+        }
+        script.push_back(SimEvent_t::raise(2, ENTRY_POINT, EXCEPTION_ACCESS_VIOLATION));
+        script.push_back(SimEvent_t::raise(2, ENTRY_POINT, EXCEPTION_INT_DIVIDE_BY_ZERO));
+        script.push_back(SimEvent_t::unloadDll(0x7FF800000000ULL));
+        script.push_back(SimEvent_t::exitThread(2));
+        for (const SimEvent_t& step : loopScript()) script.push_back(step);
+        sim->setScript(script);
+    } else if (tc == TestCase::threadsOnTwoBreakpoints) {
+        sim->setScript(twoBreakpointsScript());
+    } else if (tc == TestCase::dataWatchpoint) {
+        sim->setScript(watchScript(), LOOP_COUNT);
+    } else {
+        sim->setScript(loopScript(), LOOP_COUNT);
+    }
+
+    auto dbg = std::make_unique<SimTester>(tc, std::move(sim));
+    if (dbg->start("sim.exe") != 0) return nullptr;
+    dbg->loop();
+    return dbg;
+}
+
+static BYTE byteAt( SimTester& t, uintptr_t address ) {
+    BYTE b = 0;
+    t.sim->readMemory(address, &b, 1);
+    return b;
+}
+
+static bool check( TestCase tc ) {
+    auto t = run(tc);
+    if (!t) return false;
+    const SimStats_t& s = t->sim->getStats();
+
+    switch(tc) {
+        case TestCase::breakpointRestore:
+            return t->hits == LOOP_COUNT && s.breakpoints == LOOP_COUNT
+                && s.instructions == LOOP_BODY * LOOP_COUNT && byteAt(*t, BP_ADDRESS) == 0xCC;
+        case TestCase::breakpointBreak:
+            return t->hits == 1 && s.breakpoints == 1 && byteAt(*t, BP_ADDRESS) == 0x90
+                && s.instructions == LOOP_BODY * LOOP_COUNT;
+        case TestCase::hardwareBreakpoint:
+            return t->hits == LOOP_COUNT && s.hardwareBreakpoints == LOOP_COUNT && t->queryReads == 0;
+        case TestCase::searchSignature:
+            return t->found == std::vector<uintptr_t>{ IMAGE_BASE, IMAGE_BASE + 0xFFE, IMAGE_BASE + 0x2000 - 5 }
+                && t->foundExact == std::vector<uintptr_t>{ IMAGE_BASE } && t->foundInvalid.empty()
+                && t->foundParallel == t->found && t->foundFirst == std::vector<uintptr_t>{ IMAGE_BASE, IMAGE_BASE + 0xFFE };
+        case TestCase::streamedMemory: {
+            bool ok = t->found == std::vector<uintptr_t>{ IMAGE_BASE + 0x1002 }
+                && t->dumpedWhole && t->dumpWhole.size() == 0x2000 && t->dumpWhole[0x1002] == 0x56
+                && !t->dumpedPartial && t->dumpPartial.size() == 0x200;
+            for (size_t i = 0; ok && i < t->dumpPartial.size(); ++i) ok = t->dumpPartial[i] == (i < 0x100 ? 0x90 : 0x00);
+            return ok;
+        }
+        case TestCase::searchMulti: {
+            const std::vector<SignatureMatch_t> expected = {
+                { 0, IMAGE_BASE }, { 1, IMAGE_BASE }, { 1, IMAGE_BASE + 0xFFE }, { 2, IMAGE_BASE + 0x19FE } };
+            return t->multi == expected && t->multiParallel == expected
+                && t->multiFirst == std::vector<SignatureMatch_t>(expected.begin(), expected.begin() + 3);
+        }
+        case TestCase::valueScan:
+            return t->valueFirst == 2 && t->valueNext == 1 && t->valueHits.size() == 1
+                && t->valueHits[0].address == IMAGE_BASE + 0x1A40 && t->valueHits[0].value.integer == 1400;
+        case TestCase::memoryCache: {
+            const PageCacheStats_t& cache = t->cacheStats;
+            // One page per stop (the breakpoint and the step over it); the int3 writes pass through too
+            return t->hits == LOOP_COUNT && t->cacheMismatches == 0 && t->pageReads == 0
+                && byteAt(*t, BP_ADDRESS) == 0xCC && cache.hits >= 256 * LOOP_COUNT
+                && cache.misses == 2 * LOOP_COUNT + 1 && cache.uncached == 0 && cache.writes == 3 * LOOP_COUNT + 1;
+        }
+        case TestCase::stringExtraction: {
+            bool ok = t->cString == "at end" && t->cStringCut == "at " && t->wString == u"wide"
+                && t->strings.size() == t->stringsExpected.size() && t->strings.size() > 30
+                && t->stringsStreamed.size() == 3;
+            for (size_t i = 0; ok && i < t->strings.size(); ++i) {
+                ok = t->strings[i].address == t->stringsExpected[i].address && t->strings[i].text == t->stringsExpected[i].text
+                    && t->strings[i].encoding == t->stringsExpected[i].encoding
+                    && (i >= 3 || t->stringsStreamed[i].address == t->strings[i].address);
+            }
+            return ok;
+        }
+        case TestCase::eventsMasked:
+            // Name and entry point of the main image only; the ignored exception goes back to the target
+            return t->hits == 1 && s.payloadReads == 2 && t->dllLoads == 0 && t->debugStrings == 0
+                && t->threadsCreated == 0 && t->threadsExited == 0 && t->accessViolations == 1
+                && t->unknownExceptions == 0 && s.unhandled == 1 && t->subscriptionKept;
+        case TestCase::eventsAll:
+            return t->hits == 1 && s.payloadReads == 2 + 3 * DLL_COUNT + 1 && t->dllLoads == DLL_COUNT
+                && t->debugStrings == DLL_COUNT && t->threadsCreated == 1 && t->threadsExited == 1
+                && t->accessViolations == 1 && t->unknownExceptions == 1 && s.unhandled == 0;
+        case TestCase::lazyEvents:
+            // Only the DLL names for the module index; entry points and debug strings are never read
+            return t->hits == 1 && s.payloadReads == 2 + DLL_COUNT + 1 && t->dllLoads == DLL_COUNT
+                && t->debugStrings == DLL_COUNT && t->accessViolations == 1 && t->unknownExceptions == 1;
+        case TestCase::asyncEvents: {
+            // Same reads as eventsAll; every queued event is delivered before onEnd, the ring holds 64
+            const EventPumpStats_t& pump = t->pumpStats;
+            return t->hits == 1 && s.payloadReads == 2 + 3 * DLL_COUNT + 1 && t->dllLoadsAtEnd == DLL_COUNT
+                && t->debugStrings == DLL_COUNT && t->threadsCreated == 1 && t->threadsExited == 1
+                && t->asyncCallbacks == DLL_COUNT && t->asyncInOrder && t->accessViolations == 1
+                && pump.queued == 2 * DLL_COUNT + 3 && pump.delivered == pump.queued && pump.dropped == 0
+                && pump.maxDepth <= 64 && s.threadCloses == s.threadOpens;
+        }
+        case TestCase::sessionMetrics: {
+            // Counters match what the simulator saw; every event and callback is in its histogram
+            const MetricsSnapshot_t m = t->metricsNow();
+            const RemoteCallStats_t& r = m.remote;
+            const LatencySummary_t& bp = m.callbackOf(MetricCallback::BREAKPOINT);
+            const LatencySummary_t& stops = m.stoppedOf(DebugEventType::EXCEPTION);
+            return t->hits == LOOP_COUNT && r.callsOf(RemoteCall::READ_MEMORY) == s.memoryReads
+                && r.callsOf(RemoteCall::WRITE_MEMORY) == s.memoryWrites && r.bytesOf(RemoteCall::WRITE_MEMORY) == 2 * LOOP_COUNT + 1
+                && r.callsOf(RemoteCall::GET_CONTEXT) == s.contextReads && r.callsOf(RemoteCall::SET_CONTEXT) == s.contextWrites
+                && r.callsOf(RemoteCall::OPEN_THREAD) == s.threadOpens && r.callsOf(RemoteCall::EVENT_PAYLOAD) == s.payloadReads
+                && r.callsOf(RemoteCall::FLUSH_INSTRUCTION_CACHE) >= 2 * LOOP_COUNT + 1
+                && m.eventsOf(DebugEventType::CREATE_PROCESS) == 1 && m.eventsOf(DebugEventType::EXIT_PROCESS) == 1
+                && m.eventsOf(DebugEventType::EXCEPTION) == s.breakpoints + s.singleSteps
+                && m.callbackOf(MetricCallback::START).count == 1 && m.callbackOf(MetricCallback::END).count == 1
+                && bp.count == LOOP_COUNT && bp.maxNs >= 3000000 && stops.maxNs >= bp.maxNs
+                && stops.minNs <= stops.p50Ns && stops.p50Ns <= stops.p99Ns && stops.p99Ns <= stops.maxNs
+                && t->metricDumps >= 1 && t->dumpedBreakpoints >= 1;
+        }
+        case TestCase::metricsToggled: {
+            // Restarted by the last hit, which is the only callback in the fresh histograms
+            const MetricsSnapshot_t m = t->metricsNow();
+            return t->hits == LOOP_COUNT && t->metricsAtEnd && m.callbackOf(MetricCallback::BREAKPOINT).count == 1
+                && m.callbackOf(MetricCallback::END).count == 1 && byteAt(*t, BP_ADDRESS) == 0xCC;
+        }
+        case TestCase::tracing: {
+            // Written when loop() returned: the loop, every callback, breakpoint step and remote call
+            std::ifstream file(traceFile());
+            const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            file.close();
+            std::filesystem::remove(traceFile());
+            auto count = [&](const std::string& needle) {
+                int n = 0;
+                for (size_t at = json.find(needle); at != std::string::npos; at = json.find(needle, at + 1)) ++n;
+                return n;
+            };
+            return t->hits == LOOP_COUNT && t->traceDropped() == 0 && json.find("\"debug loop\"") != std::string::npos
+                && count("\"name\":\"onBreakpoint\"") == LOOP_COUNT && count("\"name\":\"restore_breakpoint\"") == LOOP_COUNT
+                && count("\"name\":\"single_step\"") == LOOP_COUNT && count("\"name\":\"onStart\"") == 1
+                && count("\"name\":\"exit_process\"") == 1
+                && count("\"name\":\"wait_for_event\"") == static_cast<int>(s.breakpoints + s.singleSteps) + 2
+                && count("\"name\":\"read_memory\"") >= LOOP_COUNT && count("\"name\":\"write_memory\"") >= LOOP_COUNT
+                && json.find("\"dropped\":0") != std::string::npos;
+        }
+        case TestCase::dataWatchpoint:
+            // DR6 picks the slot; the watchpoints stay armed and no hit needs a single-step
+            return t->hitsPerReg[DRReg::DR1] == LOOP_COUNT && t->hitsPerReg[DRReg::DR2] == LOOP_COUNT
+                && s.hardwareBreakpoints == 2 * LOOP_COUNT && s.singleSteps == 0 && t->unknownExceptions == 0
+                && s.instructions == 2 * LOOP_COUNT;
+        case TestCase::changeRegister: {
+            ThreadContext_t* ctx = t->sim->threadContext(SimulatedBackend::MAIN_THREAD_ID);
+            return t->hits == LOOP_COUNT && ctx && ctx->gpr[0] == LOOP_COUNT;
+        }
+        case TestCase::registerCache: {
+            // One context read for the IP rewind, one for the integer registers, one write when the hit is continued
+            ThreadContext_t* ctx = t->sim->threadContext(SimulatedBackend::MAIN_THREAD_ID);
+            return t->hits == LOOP_COUNT && t->cacheMismatches == 0 && ctx
+                && ctx->gpr[0] == LOOP_COUNT && ctx->gpr[1] == LOOP_COUNT
+                && s.contextReads == 2 * LOOP_COUNT && s.contextWrites == LOOP_COUNT;
+        }
+        case TestCase::threadsAndModules:
+            return t->threadsCreated == 1 && t->threadsExited == 1 && t->dllName == "kernel32.dll"
+                && t->dbgString == "hello" && t->exitStatus == 7 && s.instructions == 1
+                && t->createdRegistered && t->threadsAtDllLoad == 2 && t->threadsAtDllUnload == 1
+                && s.threadOpens == 2 && s.threadCloses == 2 && t->getThreads().empty()
+                && t->moduleAtLoad && t->moduleAtUnload && !t->moduleAfterUnload && t->lookupQueries == 0;
+        case TestCase::bulkBreakpoints: {
+            // Includes the breakpoint being stepped over when removeBreakpoints ran; it must not be re-armed
+            bool ok = t->removed == LOOP_BODY && t->hits == LOOP_BODY && s.breakpoints == LOOP_BODY;
+            for (int i = 0; i < LOOP_BODY; ++i) ok = ok && byteAt(*t, ENTRY_POINT + i) == 0x90;
+            return ok;
+        }
+        case TestCase::retiredBreakpoints:
+            // One thread: a removed breakpoint is dropped 3 stops later instead of piling up (16 removed)
+            return t->hits == LOOP_BODY + 1 && t->rearmForgotten && t->maxRetired <= 3
+                && s.breakpoints == LOOP_BODY + 1 && t->unknownExceptions == 0;
+        case TestCase::threadsOnOneBreakpoint: {
+            // Every thread counted once per round, each ran every instruction once, and the int3 is back.
+            // Each thread handle is opened once, not once per event.
+            bool ok = t->hits == THREADS * ROUNDS && s.breakpoints == THREADS * ROUNDS
+                && s.threadOpens == THREADS && s.threadCloses == THREADS
+                && s.instructions == 3 * THREADS * ROUNDS && s.singleSteps == THREADS * ROUNDS
+                && t->unknownExceptions == 0 && byteAt(*t, BP_ADDRESS) == 0xCC
+                && t->hitsPerThread.size() == THREADS && t->threadsExited == THREADS - 1;
+            for (const auto& [tid, n] : t->hitsPerThread) ok = ok && n == ROUNDS;
+            return ok;
+        }
+        case TestCase::threadsOnOneBreakpointBreak:
+            // The first thread removes the breakpoint; the others still replay the original instruction
+            return t->hits == 1 && s.breakpoints == THREADS && s.instructions == 3 * THREADS * ROUNDS
+                && t->unknownExceptions == 0 && byteAt(*t, BP_ADDRESS) == 0x90;
+        case TestCase::threadsOnRemovedBreakpoint:
+            // Same for removeBreakpoints(): no hit reaches the target unhandled or resumes mid-instruction
+            return t->hits == 1 && s.breakpoints == THREADS && s.instructions == 3 * THREADS * ROUNDS
+                && t->unknownExceptions == 0 && s.unhandled == 0 && byteAt(*t, BP_ADDRESS) == 0x90;
+        case TestCase::threadsOnTwoBreakpoints:
+            return t->hits == 2 * ROUNDS && t->hitsPerThread[1] == ROUNDS && t->hitsPerThread[2] == ROUNDS
+                && t->unknownExceptions == 0 && byteAt(*t, BP_ADDRESS) == 0xCC && byteAt(*t, BP2_ADDRESS) == 0xCC;
+        case TestCase::displacedRestore:
+            // Every hit runs the copy in the scratch slot: no single-steps, and the int3 never leaves
+            return t->hits == LOOP_COUNT && s.breakpoints == LOOP_COUNT && s.singleSteps == 0
+                && s.displacedSteps == LOOP_COUNT && s.instructions == LOOP_BODY * LOOP_COUNT
+                && byteAt(*t, BP_ADDRESS) == 0xCC;
+        case TestCase::displacedThreads: {
+            bool ok = t->hits == THREADS * ROUNDS && s.breakpoints == THREADS * ROUNDS
+                && s.singleSteps == 0 && s.displacedSteps == THREADS * ROUNDS
+                && s.instructions == 3 * THREADS * ROUNDS && t->unknownExceptions == 0
+                && byteAt(*t, BP_ADDRESS) == 0xCC && t->hitsPerThread.size() == THREADS;
+            for (const auto& [tid, n] : t->hitsPerThread) ok = ok && n == ROUNDS;
+            return ok;
+        }
+        case TestCase::deterministicReplay: {
+            auto other = run(tc);
+            const SimStats_t& o = other->sim->getStats();
+            return s.events == o.events && s.instructions == o.instructions && s.breakpoints == o.breakpoints
+                && s.singleSteps == o.singleSteps && s.memoryReads == o.memoryReads
+                && s.memoryWrites == o.memoryWrites && s.contextReads == o.contextReads
+                && s.contextWrites == o.contextWrites;
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (check(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
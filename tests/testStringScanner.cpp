@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "stringScanner.h"
+#include "backends/simulatedBackend.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    againstNaive,
+    startRange,
+    terminator,
+    pagedReads,
+    utf8,
+    Size
+};
+
+constexpr uintptr_t BASE = 0x10000;
+
+static bool printable( BYTE c ) {
+    return (c >= 0x20 && c <= 0x7E) || c == '\t';
+}
+
+// One byte at a time, straight from the definition
+static std::vector<StringHit_t> naiveScan( const std::vector<BYTE>& data, uintptr_t base, const StringScanOptions_t& o,
+                                           size_t first = 0, size_t limit = SIZE_MAX ) {
+    std::vector<StringHit_t> out;
+    const size_t minLength = std::max<size_t>(1, o.minLength), maxLength = std::max(minLength, o.maxLength);
+    auto report = [&](StringEncoding encoding, size_t start, size_t length, size_t width) {
+        if (start < first || start >= std::min(limit, data.size()) || length < minLength) return;
+        StringHit_t hit{ base + start, encoding, {} };
+        for (size_t k = 0; k < std::min(length, maxLength); ++k) hit.text.push_back(static_cast<char>(data[start + k * width]));
+        out.push_back(hit);
+    };
+    if (o.ascii) {
+        for (size_t i = 0; i < data.size(); ) {
+            size_t j = i;
+            while (j < data.size() && printable(data[j])) ++j;
+            if (j > i) report(StringEncoding::ASCII, i, j - i, 1);
+            i = j + 1;
+        }
+    }
+    if (o.utf16) {
+        auto isChar = [&](size_t i) { return i + 1 < data.size() && printable(data[i]) && data[i + 1] == 0; };
+        for (size_t i = (base & 1) ? 1 : 0; i < data.size(); ) {
+            size_t j = i;
+            while (isChar(j)) j += 2;
+            if (j > i) report(StringEncoding::UTF16, i, (j - i) / 2, 2);
+            i = j + 2;
+        }
+    }
+    return out;
+}
+
+static void normalize( std::vector<StringHit_t>& hits ) {
+    std::sort(hits.begin(), hits.end(), [](const StringHit_t& a, const StringHit_t& b) {
+        return std::tie(a.address, a.encoding) < std::tie(b.address, b.encoding);
+    });
+}
+
+static bool sameHits( std::vector<StringHit_t> a, std::vector<StringHit_t> b ) {
+    normalize(a);
+    normalize(b);
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].address != b[i].address || a[i].encoding != b[i].encoding || a[i].text != b[i].text) return false;
+    }
+    return true;
+}
+
+// Binary noise with ASCII and UTF-16 words of 1..40 characters dropped in, some touching each other
+static std::vector<BYTE> randomText( std::mt19937& rng, size_t size ) {
+    std::vector<BYTE> data(size);
+    for (BYTE& b : data) b = static_cast<BYTE>(rng() % 4 == 0 ? 0 : rng());
+    for (size_t words = size / 24; words--; ) {
+        const size_t length = 1 + rng() % 40, at = rng() % size;
+        const bool wide = rng() % 2;
+        for (size_t k = 0; k < length; ++k) {
+            const size_t i = at + k * (wide ? 2 : 1);
+            if (i + 1 >= size) break;
+            data[i] = static_cast<BYTE>(0x20 + rng() % 0x5F);
+            if (wide) data[i + 1] = 0;
+        }
+    }
+    return data;
+}
+
+static bool testAgainstNaive() {
+    std::mt19937 rng(11);
+    const StringScanOptions_t variants[] = {
+        { 4, 1024, true, true }, { 1, 8, true, true }, { 6, 6, true, false }, { 3, 20, false, true },
+    };
+    for (int round = 0; round < 40; ++round) {
+        const size_t size = 1 + rng() % 700;
+        const uintptr_t base = BASE + rng() % 4;
+        const std::vector<BYTE> data = randomText(rng, size);
+        for (const StringScanOptions_t& o : variants) {
+            std::vector<StringHit_t> hits;
+            const size_t appended = StringScanner(o).scan(data.data(), data.size(), base, hits);
+            if (appended != hits.size() || !sameHits(hits, naiveScan(data, base, o))) {
+                std::cerr << "[-] Mismatch: size " << size << ", base 0x" << std::hex << base << std::dec << "\n";
+                return false;
+            }
+            if (!std::is_sorted(hits.begin(), hits.end(), [](auto& a, auto& b) { return a.address < b.address; })) return false;
+        }
+    }
+
+    // A printable run across a whole block and a UTF-16 character straddling bit 63
+    std::vector<BYTE> data(200, 'A');
+    for (size_t i = 63; i < 150; i += 2) data[i + 1] = 0;
+    std::vector<StringHit_t> hits;
+    StringScanner().scan(data.data(), data.size(), BASE + 1, hits);
+    return sameHits(hits, naiveScan(data, BASE + 1, StringScanOptions_t{}));
+}
+
+static bool testStartRange() {
+    // "abcdef" at 0, "ghij" at 10, "klmnop" at 20
+    const std::string text = std::string("abcdef\0\0\0\0ghij\0\0\0\0\0\0klmnop", 26);
+    const std::vector<BYTE> data(text.begin(), text.end());
+    const StringScanner scanner(StringScanOptions_t{ 4, 64, true, false });
+
+    std::vector<StringHit_t> hits;
+    scanner.scan(data.data(), data.size(), BASE, hits, 1, 20);
+    if (hits.size() != 1 || hits[0].address != BASE + 10 || hits[0].text != "ghij") return false;
+
+    // The run at offset 0 is the tail of an earlier string, even when it continues past first
+    hits.clear();
+    scanner.scan(data.data(), data.size(), BASE, hits, 1);
+    if (hits.size() != 2 || hits[1].text != "klmnop") return false;
+
+    // A run starting at the limit belongs to the next chunk; one before it is read to the end of the buffer
+    hits.clear();
+    scanner.scan(data.data(), data.size(), BASE, hits, 0, 21);
+    return hits.size() == 3 && hits[2].address == BASE + 20 && hits[2].text == "klmnop"
+        && scanner.overlap() == 64 && StringScanner(StringScanOptions_t{ 4, 64 }).overlap() == 128
+        && StringScanner(StringScanOptions_t{ 0, 0 }).options().minLength == 1;
+}
+
+static bool testTerminator() {
+    std::mt19937 rng(3);
+    for (int round = 0; round < 500; ++round) {
+        std::vector<BYTE> data(rng() % 300);
+        for (BYTE& b : data) b = static_cast<BYTE>(1 + rng() % 255);
+        for (int zeros = rng() % 3; zeros--; ) {
+            if (!data.empty()) data[rng() % data.size()] = 0;
+        }
+        const size_t offset = data.empty() ? 0 : rng() % std::min<size_t>(data.size(), 17);
+        const BYTE* p = data.data() + offset;
+        const size_t size = data.size() - offset;
+
+        size_t narrow = 0, wide = 0;
+        while (narrow < size && p[narrow]) ++narrow;
+        while (wide + 2 <= size && (p[wide] || p[wide + 1])) wide += 2;
+        if (wide + 2 > size) wide = size;
+        if (findTerminator(p, size, 1) != narrow || findTerminator(p, size, 2) != wide) return false;
+    }
+
+    // A zero byte pair across two characters is no terminator
+    const BYTE pair[] = { 'a', 0, 0, 'b', 'c', 0, 0, 0 };
+    return findTerminator(pair, sizeof(pair), 2) == 6 && findTerminator(pair, sizeof(pair), 1) == 1;
+}
+
+static bool testPagedReads() {
+    SimulatedBackend sim;
+    sim.mapMemory(BASE, 0x2000, PAGE_READWRITE, 'x');
+    auto read = [&](uintptr_t at, void* buffer, SIZE_T size) {
+        SIZE_T got = 0;
+        return sim.readMemory(at, buffer, size, &got) && got == size;
+    };
+    auto readCounted = [&](uintptr_t at, SIZE_T maxBytes, size_t charSize, uint64_t& reads) {
+        const uint64_t before = sim.getStats().memoryReads;
+        std::string s = readTerminated(read, at, maxBytes, charSize);
+        reads = sim.getStats().memoryReads - before;
+        return s;
+    };
+    uint64_t reads = 0;
+
+    // Short string: one 64-byte read
+    sim.writeMemory(BASE + 0x100, "hello", 6);
+    if (readCounted(BASE + 0x100, 0x1000, 1, reads) != "hello" || reads != 1) return false;
+
+    // Runs into the unmapped page behind the mapping: everything up to it
+    if (readCounted(BASE + 0x1F00, 0x1000, 1, reads) != std::string(0x100, 'x')) return false;
+
+    // Crosses the page boundary at BASE + 0x1000
+    const std::string along(0x180, 'y');
+    sim.writeMemory(BASE + 0xF00, along.c_str(), along.size() + 1);
+    if (readCounted(BASE + 0xF00, 0x1000, 1, reads) != along) return false;
+
+    // Cut at maxBytes
+    if (readCounted(BASE + 0xF00, 10, 1, reads) != std::string(10, 'y') || reads != 1) return false;
+
+    // UTF-16 with a character across the page boundary (odd address)
+    const char16_t wide[] = u"wide string";
+    const uintptr_t at = BASE + 0x1000 - 7;
+    sim.writeMemory(at, wide, sizeof(wide));
+    const std::string bytes = readCounted(at, 0x1000, 2, reads);
+    if (bytes.size() != sizeof(wide) - 2 || std::memcmp(bytes.data(), wide, bytes.size()) != 0) return false;
+
+    // Nothing readable at all
+    return readTerminated(read, BASE + 0x3000, 0x1000, 1).empty();
+}
+
+static bool testUtf8() {
+    const char16_t text[] = { u'a', 0xE9, 0x20AC, 0xD83D, 0xDE00, 0xD800, u'b', 0xDC00 };
+    return toUtf8(std::u16string_view(text, 8)) == "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xEF\xBF\xBD" "b\xEF\xBF\xBD"
+        && toUtf8(u"").empty();
+}
+
+static bool run( TestCase tc ) {
+    switch(tc) {
+        case TestCase::againstNaive: return testAgainstNaive();
+        case TestCase::startRange:   return testStartRange();
+        case TestCase::terminator:   return testTerminator();
+        case TestCase::pagedReads:   return testPagedReads();
+        case TestCase::utf8:         return testUtf8();
+        default: return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
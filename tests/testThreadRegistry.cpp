@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "threadRegistry.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    insertFind,
+    insertExisting,
+    eraseMovesLast,
+    randomAgainstMap,
+    sortedIds,
+    Size
+};
+
+static bool run( TestCase tc ) {
+    switch(tc) {
+        case TestCase::insertFind: {
+            ThreadRegistry t;
+            for (DWORD tid = 1000; tid < 1000 + 500; tid += 4) t.insert(tid).startAddress = tid * 2;
+            if (t.size() != 125) return false;
+            for (DWORD tid = 1000; tid < 1000 + 500; tid += 4) {
+                const ThreadInfo_t* e = t.find(tid);
+                if (!e || e->threadId != tid || e->startAddress != tid * 2 || e->status != ThreadStatus::RUNNING) return false;
+            }
+            return !t.find(1001) && !t.find(0) && !t.contains(1000 + 500);
+        }
+        case TestCase::insertExisting: {
+            ThreadRegistry t;
+            t.insert(42).hThread = reinterpret_cast<HANDLE>(0x1234);
+            ThreadInfo_t& again = t.insert(42);
+            return t.size() == 1 && again.hThread == reinterpret_cast<HANDLE>(0x1234);
+        }
+        case TestCase::eraseMovesLast: {
+            // Erasing from the front keeps every other entry reachable and the storage dense
+            ThreadRegistry t;
+            for (DWORD tid = 1; tid <= 40; ++tid) t.insert(tid).threadBase = tid;
+            for (DWORD tid = 1; tid <= 40; tid += 3) if (!t.erase(tid)) return false;
+            size_t walked = 0;
+            for (const ThreadInfo_t& e : t) {
+                if (e.threadBase != e.threadId || (e.threadId - 1) % 3 == 0) return false;
+                ++walked;
+            }
+            for (DWORD tid = 1; tid <= 40; ++tid) {
+                if (t.contains(tid) != ((tid - 1) % 3 != 0)) return false;
+            }
+            return walked == t.size() && t.size() == 26 && !t.erase(1);
+        }
+        case TestCase::randomAgainstMap: {
+            std::mt19937_64 rng(4321);
+            ThreadRegistry t;
+            std::map<DWORD, uintptr_t> ref;
+            for (int i = 0; i < 200000; ++i) {
+                const DWORD tid = static_cast<DWORD>(4 * (rng() % 512)); // Windows TIDs are multiples of 4
+                switch (rng() % 3) {
+                    case 0: t.insert(tid).startAddress = i; ref[tid] = i; break;
+                    case 1: if (t.erase(tid) != (ref.erase(tid) == 1)) return false; break;
+                    case 2: {
+                        const ThreadInfo_t* e = t.find(tid);
+                        auto it = ref.find(tid);
+                        if ((e != nullptr) != (it != ref.end())) return false;
+                        if (e && e->startAddress != it->second) return false;
+                    }
+                }
+            }
+            return t.size() == ref.size();
+        }
+        case TestCase::sortedIds: {
+            ThreadRegistry t;
+            std::vector<DWORD> expected = { 7, 3, 9001, 12, 5 };
+            for (DWORD tid : expected) t.insert(tid);
+            std::sort(expected.begin(), expected.end());
+            t.clear();
+            if (!t.empty() || t.find(7)) return false;
+            for (DWORD tid : expected) t.insert(tid);
+            return t.threadIds() == expected;
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,282 @@
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "traceRecorder.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    threadsCollected,
+    poolExhausted,
+    exitedThreadsReused,
+    chromeJson,
+    perfettoSlices,
+    Size
+};
+
+static size_t countOf( const std::string& text, const std::string& needle ) {
+    size_t n = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) ++n;
+    return n;
+}
+
+// Four threads, each more spans than a block holds: every span lands with its own thread, in order
+static bool testThreadsCollected() {
+    constexpr int THREADS = 4;
+    constexpr uint64_t SPANS = 1000;
+    TraceRecorder recorder(THREADS * SPANS);
+    std::atomic<int> done{ 0 };
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([&recorder, &done, t] {
+            if (t == 0) recorder.nameThread("worker zero");
+            for (uint64_t i = 0; i < SPANS; ++i) recorder.record(TraceCategory::REMOTE, "read_memory", i * 10, i * 10 + 5, "bytes", t);
+            // All alive together, or an exiting thread would pass its track on
+            done.fetch_add(1);
+            while (done.load() < THREADS) std::this_thread::yield();
+        });
+    }
+    for (std::thread& w : workers) w.join();
+
+    const std::vector<TraceThread_t> threads = recorder.collect();
+    if (threads.size() != THREADS || recorder.dropped() != 0) return false;
+    int named = 0;
+    for (const TraceThread_t& thread : threads) {
+        if (thread.events.size() != SPANS) return false;
+        const uint64_t owner = thread.events[0].arg;
+        for (uint64_t i = 0; i < SPANS; ++i) {
+            const TraceEvent_t& e = thread.events[i];
+            if (e.arg != owner || e.startNs != i * 10 || e.durationNs != 5 || std::string(e.argName) != "bytes") return false;
+        }
+        if (thread.name == "worker zero") {
+            if (owner != 0) return false;
+            ++named;
+        } else if (thread.name != "thread " + std::to_string(thread.index)) {
+            return false;
+        }
+    }
+    return named == 1;
+}
+
+// Capacity is rounded up to whole blocks; what does not fit is counted, not written
+static bool testPoolExhausted() {
+    TraceRecorder recorder(300);
+    if (recorder.capacity() != 2 * TraceRecorder::BLOCK_EVENTS) return false;
+    for (int i = 0; i < 1000; ++i) recorder.record(TraceCategory::LOOP, "continue", i, i + 1);
+    const std::vector<TraceThread_t> threads = recorder.collect();
+    return threads.size() == 1 && threads[0].events.size() == recorder.capacity()
+        && recorder.dropped() == 1000 - recorder.capacity();
+}
+
+// Scan-style workers: a fresh thread per job. Exited threads pass their index and block on, so 1000
+// threads need 4 tracks and a few blocks instead of 1000 of each
+static bool testExitedThreadsReused() {
+    constexpr int ROUNDS = 250;
+    constexpr int WORKERS = 4;
+    constexpr int SPANS = 10;
+    TraceRecorder recorder(64 * TraceRecorder::BLOCK_EVENTS);
+    recorder.nameThread("debug loop");
+    recorder.record(TraceCategory::LOOP, "wait_for_event", 0, 1);
+    std::atomic<uint64_t> clock{ 1 }; // orders the spans as they really happened
+    for (int r = 0; r < ROUNDS; ++r) {
+        std::vector<std::thread> workers;
+        for (int w = 0; w < WORKERS; ++w) {
+            workers.emplace_back([&recorder, &clock] {
+                for (int i = 0; i < SPANS; ++i) {
+                    const uint64_t now = clock.fetch_add(1);
+                    recorder.record(TraceCategory::REMOTE, "read_memory", now, now + 1);
+                }
+            });
+        }
+        for (std::thread& w : workers) w.join();
+    }
+
+    const std::vector<TraceThread_t> threads = recorder.collect();
+    size_t spans = 0;
+    for (const TraceThread_t& t : threads) {
+        spans += t.events.size();
+        // A track is one worker after the other: its spans never go back in time
+        for (size_t i = 1; i < t.events.size(); ++i) {
+            if (t.events[i].startNs < t.events[i - 1].startNs) return false;
+        }
+    }
+    // Workers of a round may also pick up the index of one that already finished
+    return recorder.dropped() == 0 && threads.size() >= 2 && threads.size() <= WORKERS + 1
+        && spans == ROUNDS * WORKERS * SPANS + 1
+        && threads[0].name == "debug loop" && threads[1].name == "thread 2";
+}
+
+static bool testChromeJson() {
+    TraceRecorder recorder(16);
+    recorder.nameThread("debug loop");
+    recorder.record(TraceCategory::CALLBACK, "onBreakpoint", 1000, 3500);
+    recorder.record(TraceCategory::DISPATCH, "exception", 500, 4000, "thread", 7);
+    const std::string json = recorder.toChromeJson();
+    return json.rfind("{\"traceEvents\":[", 0) == 0
+        && json.find("\"name\":\"thread_name\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"debug loop\"}") != std::string::npos
+        && json.find("\"cat\":\"callback\",\"name\":\"onBreakpoint\",\"pid\":1,\"tid\":1,\"ts\":0.500,\"dur\":2.500}") != std::string::npos
+        && json.find("\"cat\":\"dispatch\",\"name\":\"exception\",\"pid\":1,\"tid\":1,\"ts\":0.000,\"dur\":3.500,\"args\":{\"thread\":7}}") != std::string::npos
+        && countOf(json, "\"ph\":\"X\"") == 2 && json.find("\"dropped\":0") != std::string::npos;
+}
+
+// ===== Minimal protobuf reader =====
+
+struct Field_t {
+    uint32_t number = 0;
+    uint64_t value = 0;    ///< Varint fields.
+    std::string bytes;     ///< Length-delimited fields.
+};
+
+static bool readVarint( const std::string& in, size_t& at, uint64_t& out ) {
+    out = 0;
+    for (unsigned shift = 0; at < in.size() && shift < 64; shift += 7) {
+        const uint8_t b = static_cast<uint8_t>(in[at++]);
+        out |= uint64_t(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static bool parse( const std::string& in, std::vector<Field_t>& fields ) {
+    size_t at = 0;
+    while (at < in.size()) {
+        uint64_t key = 0;
+        Field_t field;
+        if (!readVarint(in, at, key)) return false;
+        field.number = static_cast<uint32_t>(key >> 3);
+        if ((key & 7) == 0) {
+            if (!readVarint(in, at, field.value)) return false;
+        } else if ((key & 7) == 2) {
+            uint64_t size = 0;
+            if (!readVarint(in, at, size) || at + size > in.size()) return false;
+            field.bytes = in.substr(at, size);
+            at += size;
+        } else {
+            return false;
+        }
+        fields.push_back(std::move(field));
+    }
+    return true;
+}
+
+static const Field_t* fieldOf( const std::vector<Field_t>& fields, uint32_t number ) {
+    for (const Field_t& f : fields) if (f.number == number) return &f;
+    return nullptr;
+}
+
+// Nested and sibling spans on two threads decode into balanced, time-ordered slices on two thread tracks
+static bool testPerfettoSlices() {
+    TraceRecorder recorder(1024);
+    recorder.nameThread("debug loop");
+    // Recorded as they end: inner spans first
+    recorder.record(TraceCategory::REMOTE, "read_memory", 150, 160, "bytes", 1);
+    recorder.record(TraceCategory::CALLBACK, "onBreakpoint", 120, 200);
+    recorder.record(TraceCategory::DISPATCH, "exception", 100, 300, "thread", 1);
+    recorder.record(TraceCategory::LOOP, "continue", 300, 310);
+    std::thread([&recorder] { recorder.record(TraceCategory::CALLBACK, "onDLLLoad", 400, 450); }).join();
+
+    std::vector<Field_t> packets;
+    if (!parse(recorder.toPerfetto(), packets)) return false;
+
+    std::map<uint64_t, std::string> tracks;              // thread track uuid -> name
+    std::map<uint64_t, std::vector<std::string>> stacks; // open slices per track
+    std::vector<std::string> order;
+    uint64_t lastTs = 0;
+    size_t ends = 0;
+    for (const Field_t& p : packets) {
+        std::vector<Field_t> packet;
+        if (p.number != 1 || !parse(p.bytes, packet)) return false;
+        if (const Field_t* desc = fieldOf(packet, 60)) {
+            std::vector<Field_t> track;
+            if (!parse(desc->bytes, track)) return false;
+            const Field_t* uuid = fieldOf(track, 1);
+            const Field_t* name = fieldOf(track, 2);
+            if (!uuid) return false;
+            if (fieldOf(track, 4)) tracks[uuid->value] = name ? name->bytes : "";
+            continue;
+        }
+        const Field_t* ts = fieldOf(packet, 8);
+        const Field_t* ev = fieldOf(packet, 11);
+        std::vector<Field_t> event;
+        if (!ts || !ev || !parse(ev->bytes, event)) return false;
+        const Field_t* type = fieldOf(event, 9);
+        const Field_t* track = fieldOf(event, 11);
+        if (!type || !track || !tracks.count(track->value)) return false;
+        // Timestamps only go forward on a track; this trace has one thread after the other
+        if (ts->value < lastTs) return false;
+        lastTs = ts->value;
+        std::vector<std::string>& stack = stacks[track->value];
+        if (type->value == 1) {
+            const Field_t* name = fieldOf(event, 23);
+            const Field_t* category = fieldOf(event, 22);
+            if (!name || !category) return false;
+            if (name->bytes == "read_memory") {
+                const Field_t* annotation = fieldOf(event, 4);
+                std::vector<Field_t> arg;
+                if (!annotation || !parse(annotation->bytes, arg) || !fieldOf(arg, 3) || fieldOf(arg, 3)->value != 1
+                    || !fieldOf(arg, 10) || fieldOf(arg, 10)->bytes != "bytes" || category->bytes != "remote") return false;
+            }
+            stack.push_back(name->bytes);
+            order.push_back(name->bytes + "@" + std::to_string(stack.size()));
+        } else if (type->value == 2) {
+            if (stack.empty()) return false;
+            stack.pop_back();
+            ++ends;
+        } else {
+            return false;
+        }
+    }
+    for (const auto& [uuid, stack] : stacks) if (!stack.empty()) return false;
+
+    const std::vector<std::string> expected = {
+        "exception@1", "onBreakpoint@2", "read_memory@3", "continue@1", "onDLLLoad@1" };
+    return tracks.size() == 2 && ends == 5 && order == expected && lastTs == 350
+        && tracks.begin()->second == "debug loop" && std::next(tracks.begin())->second == "thread 2";
+}
+
+static bool run( TestCase tc ) {
+    switch(tc) {
+        case TestCase::threadsCollected: return testThreadsCollected();
+        case TestCase::poolExhausted:    return testPoolExhausted();
+        case TestCase::exitedThreadsReused: return testExitedThreadsReused();
+        case TestCase::chromeJson:       return testChromeJson();
+        case TestCase::perfettoSlices:   return testPerfettoSlices();
+        default: return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
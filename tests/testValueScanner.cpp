@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "valueScanner.h"
+#include "backends/simulatedBackend.h"
+
+#define GREEN   "\033[32m"
+#define RED     "\033[31m"
+#define YELLOW  "\033[33m"
+#define RESET   "\033[0m"
+
+using namespace RoboDBG;
+
+enum TestCase {
+    againstNaive,
+    exactThenDecreased,
+    paging,
+    compactStorage,
+    unmappedCandidates,
+    badArguments,
+    Size
+};
+
+constexpr uintptr_t BASE = 0x10000000;
+
+// Regions of 1, 17 and 40 pages (the last spans several 64 KB blocks); half the bytes are zero, the rest 1..3
+static std::vector<MemoryRegion_t> mapRandom( SimulatedBackend& sim, std::mt19937& rng ) {
+    uintptr_t at = BASE;
+    for (SIZE_T pages : { 1, 17, 40 }) {
+        const SIZE_T size = pages * 0x1000;
+        sim.mapMemory(at, size, PAGE_READWRITE);
+        std::vector<BYTE> data(size);
+        for (auto& b : data) b = (rng() & 1) ? static_cast<BYTE>(1 + rng() % 3) : 0;
+        sim.writeMemory(at, data.data(), size);
+        at += size + 0x10000;
+    }
+    return sim.getMemoryRegions();
+}
+
+// Reference: every candidate with the bytes of its last scan
+template<typename T>
+struct Naive_t {
+    std::map<uintptr_t, T> candidates;
+
+    static bool pass( ScanCompare c, T cur, T prev, T lo, T hi ) {
+        switch (c) {
+            case ScanCompare::EXACT:     return cur == lo;
+            case ScanCompare::RANGE:     return cur >= lo && cur <= hi;
+            case ScanCompare::UNKNOWN:   return true;
+            case ScanCompare::CHANGED:   return std::memcmp(&cur, &prev, sizeof(T)) != 0;
+            case ScanCompare::UNCHANGED: return std::memcmp(&cur, &prev, sizeof(T)) == 0;
+            case ScanCompare::INCREASED: return cur > prev;
+            case ScanCompare::DECREASED: return cur < prev;
+        }
+        return false;
+    }
+
+    void first( SimulatedBackend& sim, const std::vector<MemoryRegion_t>& regions, size_t align, ScanCompare c, T lo, T hi ) {
+        candidates.clear();
+        for (const MemoryRegion_t& r : regions) {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(r.BaseAddress);
+            for (uintptr_t a = base; a + sizeof(T) <= base + r.RegionSize; a += align) {
+                T v;
+                sim.readMemory(a, &v, sizeof(T));
+                if (pass(c, v, v, lo, hi)) candidates[a] = v;
+            }
+        }
+    }
+
+    void next( SimulatedBackend& sim, ScanCompare c, T lo, T hi ) {
+        for (auto it = candidates.begin(); it != candidates.end();) {
+            T v;
+            if (sim.readMemory(it->first, &v, sizeof(T)) && pass(c, v, it->second, lo, hi)) {
+                it->second = v;
+                ++it;
+            } else {
+                it = candidates.erase(it);
+            }
+        }
+    }
+
+    bool same( const ValueScanner& scanner ) const {
+        const std::vector<ValueHit_t> got = scanner.results(0, SIZE_MAX);
+        if (got.size() != candidates.size() || scanner.count() != candidates.size()) return false;
+        size_t i = 0;
+        for (const auto& [address, v] : candidates) {
+            const ValueHit_t& h = got[i++];
+            const T value = std::is_integral_v<T> ? static_cast<T>(h.value.integer) : static_cast<T>(h.value.real);
+            if (h.address != address || std::memcmp(&value, &v, sizeof(T)) != 0) return false;
+        }
+        return true;
+    }
+};
+
+// Random first scan, then rounds of random writes and random next scans, compared after every scan
+template<typename T>
+static bool workflow( ValueType type, size_t align, unsigned seed ) {
+    std::mt19937 rng(seed);
+    SimulatedBackend sim;
+    const std::vector<MemoryRegion_t> regions = mapRandom(sim, rng);
+    ValueScanner scanner(sim, type, align);
+    Naive_t<T> naive;
+
+    const ScanCompare firsts[] = { ScanCompare::UNKNOWN, ScanCompare::EXACT, ScanCompare::RANGE };
+    const ScanCompare first = firsts[seed % 3];
+    // EXACT 0, RANGE [0, 0x01000000] for integers (clamped to the type) and [0, 1e-30] for floats
+    T lo{}, hi{};
+    ScanValue_t low, high;
+    if constexpr (std::is_integral_v<T>) {
+        hi = static_cast<T>(std::min<int64_t>(0x01000000, std::numeric_limits<T>::max()));
+        high = ScanValue_t::of(int64_t(0x01000000));
+    } else {
+        hi = static_cast<T>(1e-30);
+        high = ScanValue_t::of(1e-30);
+    }
+
+    scanner.firstScan(regions, first, low, high);
+    naive.first(sim, regions, scanner.alignment(), first, lo, first == ScanCompare::EXACT ? lo : hi);
+    if (!naive.same(scanner) || naive.candidates.empty()) return false;
+
+    const ScanCompare nexts[] = { ScanCompare::CHANGED, ScanCompare::UNCHANGED, ScanCompare::INCREASED,
+                                  ScanCompare::DECREASED, ScanCompare::UNKNOWN, ScanCompare::RANGE };
+    for (int round = 0; round < 6 && !naive.candidates.empty(); ++round) {
+        // Rewrite bytes of random candidates
+        std::vector<uintptr_t> addresses;
+        for (const auto& [a, v] : naive.candidates) addresses.push_back(a);
+        for (int n = 0; n < 3000; ++n) {
+            const uintptr_t a = addresses[rng() % addresses.size()] + rng() % sizeof(T);
+            const BYTE b = static_cast<BYTE>(rng() % 3);
+            sim.writeMemory(a, &b, 1);
+        }
+        const ScanCompare c = nexts[(seed + round) % 6];
+        scanner.nextScan(c, low, high);
+        naive.next(sim, c, lo, hi);
+        if (!naive.same(scanner)) return false;
+    }
+    return true;
+}
+
+static bool run( TestCase tc ) {
+    switch(tc) {
+        case TestCase::againstNaive: {
+            bool ok = true;
+            for (unsigned seed = 0; seed < 3 && ok; ++seed) {
+                ok = workflow<int8_t>(ValueType::INT8, 0, seed)
+                    && workflow<int16_t>(ValueType::INT16, 0, seed)
+                    && workflow<int32_t>(ValueType::INT32, 0, seed)
+                    && workflow<int32_t>(ValueType::INT32, 1, seed)
+                    && workflow<int64_t>(ValueType::INT64, 4, seed)
+                    && workflow<float>(ValueType::FLOAT, 0, seed)
+                    && workflow<double>(ValueType::DOUBLE, 0, seed);
+            }
+            return ok;
+        }
+        case TestCase::exactThenDecreased: {
+            SimulatedBackend sim;
+            sim.mapMemory(BASE, 0x30000, PAGE_READWRITE, 0);
+            const uintptr_t spots[] = { BASE + 0x10, BASE + 0x1000, BASE + 0x12344, BASE + 0x2FFFC };
+            const int32_t start = 1500;
+            for (uintptr_t a : spots) sim.writeMemory(a, &start, sizeof(start));
+            sim.writeMemory(BASE + 0x2002, &start, sizeof(start)); // unaligned, not a candidate
+
+            ValueScanner scanner(sim, ValueType::INT32);
+            if (scanner.firstScan(ScanCompare::EXACT, ScanValue_t::of(int64_t(1500))) != 4) return false;
+            const int32_t lower = 1400, higher = 1600;
+            sim.writeMemory(spots[1], &lower, sizeof(lower));
+            sim.writeMemory(spots[3], &lower, sizeof(lower));
+            sim.writeMemory(spots[2], &higher, sizeof(higher));
+            if (scanner.nextScan(ScanCompare::DECREASED) != 2) return false;
+            const std::vector<ValueHit_t> hits = scanner.results(0, 10);
+            const bool found = hits.size() == 2 && hits[0].address == spots[1] && hits[1].address == spots[3]
+                && hits[0].value.integer == 1400;
+            return found && scanner.nextScan(ScanCompare::EXACT, ScanValue_t::of(int64_t(1400))) == 2
+                && scanner.nextScan(ScanCompare::CHANGED) == 0 && scanner.results(0, 10).empty();
+        }
+        case TestCase::paging: {
+            std::mt19937 rng(7);
+            SimulatedBackend sim;
+            const std::vector<MemoryRegion_t> regions = mapRandom(sim, rng);
+            ValueScanner scanner(sim, ValueType::INT16);
+            if (scanner.firstScan(regions, ScanCompare::RANGE, ScanValue_t::of(int64_t(0x100)), ScanValue_t::of(int64_t(0x200))) < 1000) return false;
+            const std::vector<ValueHit_t> all = scanner.results(0, SIZE_MAX);
+            for (size_t page : { size_t(1), size_t(63), size_t(64), size_t(1000) }) {
+                std::vector<ValueHit_t> joined;
+                for (size_t at = 0; at < scanner.count(); at += page) {
+                    const std::vector<ValueHit_t> part = scanner.results(at, page);
+                    if (part.size() != std::min(page, scanner.count() - at)) return false;
+                    joined.insert(joined.end(), part.begin(), part.end());
+                }
+                if (joined.size() != all.size()) return false;
+                for (size_t i = 0; i < all.size(); ++i) {
+                    if (joined[i].address != all[i].address || joined[i].value.integer != all[i].value.integer) return false;
+                }
+            }
+            return all.size() == scanner.count() && scanner.results(scanner.count(), 10).empty() && scanner.results(0, 0).empty();
+        }
+        case TestCase::compactStorage: {
+            // Dense after UNKNOWN (about a copy of memory), sparse once few candidates are left
+            SimulatedBackend sim;
+            const SIZE_T size = 0x100000;
+            sim.mapMemory(BASE, size, PAGE_READWRITE, 0);
+            ValueScanner scanner(sim, ValueType::INT32);
+            if (scanner.firstScan(ScanCompare::UNKNOWN) != size / 4) return false;
+            const size_t dense = scanner.memoryUsage();
+            const int32_t one = 1;
+            for (uintptr_t a = BASE; a < BASE + size; a += 0x8000) sim.writeMemory(a, &one, sizeof(one));
+            if (scanner.nextScan(ScanCompare::CHANGED) != size / 0x8000) return false;
+            const size_t sparse = scanner.memoryUsage();
+
+            ValueScanner exact(sim, ValueType::INT32);
+            const bool few = exact.firstScan(ScanCompare::EXACT, ScanValue_t::of(int64_t(1))) == size / 0x8000
+                && exact.memoryUsage() < 0x1000;
+            return dense >= size && dense < size + size / 16 && sparse < 0x1000 && few;
+        }
+        case TestCase::unmappedCandidates: {
+            SimulatedBackend sim;
+            sim.mapMemory(BASE, 0x4000, PAGE_READWRITE, 0);
+            ValueScanner scanner(sim, ValueType::INT64);
+            if (scanner.firstScan(ScanCompare::EXACT, ScanValue_t::of(int64_t(0))) != 0x4000 / 8) return false;
+            sim.unmapMemory(BASE + 0x1000, 0x1000);
+            sim.unmapMemory(BASE + 0x3000, 0x1000);
+            const std::vector<ValueHit_t> left = scanner.nextScan(ScanCompare::UNCHANGED) == 0x2000 / 8 ? scanner.results(0, SIZE_MAX)
+                                                                                                   : std::vector<ValueHit_t>{};
+            const bool dense = left.size() == 0x2000 / 8 && left.front().address == BASE && left.back().address == BASE + 0x2FF8
+                && std::none_of(left.begin(), left.end(), [](const ValueHit_t& h) { return h.address >= BASE + 0x1000 && h.address < BASE + 0x2000; });
+
+            // Sparse block with a hole: a few values on each page, the second page unmapped
+            sim.mapMemory(BASE + 0x1000, 0x1000, PAGE_READWRITE, 0);
+            sim.mapMemory(BASE + 0x3000, 0x1000, PAGE_READWRITE, 0);
+            const int64_t seven = 7;
+            for (uintptr_t a = BASE + 0x100; a < BASE + 0x4000; a += 0x400) sim.writeMemory(a, &seven, sizeof(seven));
+            ValueScanner sparse(sim, ValueType::INT64);
+            if (sparse.firstScan(ScanCompare::EXACT, ScanValue_t::of(int64_t(7))) != 16) return false;
+            sim.unmapMemory(BASE + 0x1000, 0x1000);
+            const std::vector<ValueHit_t> kept = sparse.nextScan(ScanCompare::UNCHANGED) == 12 ? sparse.results(0, 20) : std::vector<ValueHit_t>{};
+            return dense && kept.size() == 12 && kept[3].address == BASE + 0xD00 && kept[4].address == BASE + 0x2100;
+        }
+        case TestCase::badArguments: {
+            SimulatedBackend sim;
+            sim.mapMemory(BASE, 0x1000, PAGE_READWRITE, 0);
+            ValueScanner scanner(sim, ValueType::INT8);
+            bool ok = scanner.firstScan(ScanCompare::CHANGED) == 0
+                && scanner.firstScan(ScanCompare::EXACT, ScanValue_t::of(int64_t(300))) == 0
+                && scanner.firstScan(ScanCompare::RANGE, ScanValue_t::of(int64_t(5)), ScanValue_t::of(int64_t(4))) == 0
+                && scanner.firstScan(ScanCompare::RANGE, ScanValue_t::of(int64_t(-500)), ScanValue_t::of(int64_t(500))) == 0x1000;
+            ok = ok && scanner.nextScan(ScanCompare::EXACT, ScanValue_t::of(int64_t(-129))) == 0 && scanner.count() == 0;
+
+            ValueScanner real(sim, ValueType::DOUBLE);
+            ok = ok && real.firstScan(ScanCompare::EXACT, ScanValue_t::of(0.0)) == 0x1000 / 8
+                && real.firstScan(ScanCompare::RANGE, ScanValue_t::of(1.0), ScanValue_t::of(-1.0)) == 0;
+            return ok && ValueScanner::valueSize(ValueType::INT16) == 2 && real.alignment() == 8;
+        }
+        default:
+            return false;
+    }
+}
+
+int main() {
+    int totalTests = static_cast<int>(TestCase::Size);
+    int passed = 0, failed = 0;
+
+    std::cout << YELLOW << "[*] Running " << totalTests << " test cases...\n" << RESET;
+
+    for (int i = 0; i < totalTests; ++i) {
+        std::cout << "[*] Running test case: " << i << std::endl;
+        if (run(static_cast<TestCase>(i))) {
+            std::cout << GREEN << "[+] Test " << i << " successful" << RESET << "\n";
+            ++passed;
+        } else {
+            std::cout << RED << "[-] Test " << i << " failed" << RESET << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << YELLOW << "\n=== Test Summary ===\n" << RESET;
+    std::cout << GREEN << "Passed: " << passed << RESET << std::endl;
+    std::cout << RED   << "Failed: " << failed << RESET << std::endl;
+    std::cout << YELLOW << "Total:  " << totalTests << RESET << std::endl;
+
+    return (failed == 0) ? 0 : 1;
+}
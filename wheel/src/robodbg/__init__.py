@@ -6,6 +6,8 @@ from .dbg import (
     AccessType,
     BreakpointLength,
     ThreadInfo,
+    ThreadRegistry,
+    ThreadStatus,
     HardwareBreakpoint,
     MemoryRegion,
     DRReg
@@ -15,6 +17,8 @@ imports = [
     "BreakpointAction",
     "BreakpointLength",
     "ThreadInfo",
+    "ThreadRegistry",
+    "ThreadStatus",
     "MemoryRegion",
     "Debugger",
     "DRReg",